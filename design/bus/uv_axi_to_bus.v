@@ -0,0 +1,468 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_axi_to_bus
+//
+// Designer: Owen
+//
+// Description:
+//      Transform interface from AXI4 slave to bus.
+//      Up to RD_OST read & WR_OST write addresses are queued.
+//      Aligned full-width INCR & WRAP reads are issued as bus
+//      bursts of up to 16 beats, and other reads & all write
+//      beats as singles, with reads & writes taking turns.
+//      OST_NUM bus transactions are outstanding, and their
+//      responses return R beats & one B for each AXI burst in
+//      request order, which is legal for any mix of IDs.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_axi_to_bus
+#(
+    parameter ALEN                  = 32,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter AXI_IDW               = 4,
+    parameter RD_OST                = 4,
+    parameter WR_OST                = 4,
+    parameter OST_NUM               = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // AXI write address.
+    input  [AXI_IDW-1:0]            axi_awid,
+    input  [ALEN-1:0]               axi_awaddr,
+    input  [7:0]                    axi_awlen,
+    input  [2:0]                    axi_awsize,
+    input  [1:0]                    axi_awburst,
+    input                           axi_awvalid,
+    output                          axi_awready,
+
+    // AXI write data.
+    input  [DLEN-1:0]               axi_wdata,
+    input  [MLEN-1:0]               axi_wstrb,
+    input                           axi_wlast,
+    input                           axi_wvalid,
+    output                          axi_wready,
+
+    // AXI write response.
+    output [AXI_IDW-1:0]            axi_bid,
+    output [1:0]                    axi_bresp,
+    output                          axi_bvalid,
+    input                           axi_bready,
+
+    // AXI read address.
+    input  [AXI_IDW-1:0]            axi_arid,
+    input  [ALEN-1:0]               axi_araddr,
+    input  [7:0]                    axi_arlen,
+    input  [2:0]                    axi_arsize,
+    input  [1:0]                    axi_arburst,
+    input                           axi_arvalid,
+    output                          axi_arready,
+
+    // AXI read data.
+    output [AXI_IDW-1:0]            axi_rid,
+    output [DLEN-1:0]               axi_rdata,
+    output [1:0]                    axi_rresp,
+    output                          axi_rlast,
+    output                          axi_rvalid,
+    input                           axi_rready,
+
+    // Bus ports.
+    output                          bus_req_vld,
+    input                           bus_req_rdy,
+    output                          bus_req_read,
+    output [ALEN-1:0]               bus_req_addr,
+    output [3:0]                    bus_req_len,
+    output                          bus_req_wrap,
+    output [MLEN-1:0]               bus_req_mask,
+    output [DLEN-1:0]               bus_req_data,
+
+    input                           bus_rsp_vld,
+    output                          bus_rsp_rdy,
+    input  [1:0]                    bus_rsp_excp,
+    input  [DLEN-1:0]               bus_rsp_data
+);
+
+    localparam UDLY                 = 1;
+    localparam OFFSET_AW            = $clog2(MLEN);
+    localparam ADDR_DW              = AXI_IDW + ALEN + 8 + 3 + 2;
+    localparam RD_PW                = RD_OST > 1 ? $clog2(RD_OST) : 1;
+    localparam WR_PW                = WR_OST > 1 ? $clog2(WR_OST) : 1;
+    localparam TAG_PW               = OST_NUM > 1 ? $clog2(OST_NUM) : 1;
+    localparam TAG_DW               = AXI_IDW + 6 + OFFSET_AW;
+
+    localparam AXI_BURST_FIXED      = 2'b00;
+    localparam AXI_BURST_WRAP       = 2'b10;
+    localparam AXI_RESP_OKAY        = 2'b00;
+    localparam AXI_RESP_SLVERR      = 2'b10;
+
+    // Queued addresses.
+    wire                            ar_push;
+    wire                            ar_full;
+    wire                            ar_empty;
+    wire [ADDR_DW-1:0]              ar_dat;
+    wire                            aw_push;
+    wire                            aw_full;
+    wire                            aw_empty;
+    wire [ADDR_DW-1:0]              aw_dat;
+
+    wire [AXI_IDW-1:0]              ar_id;
+    wire [ALEN-1:0]                 ar_addr;
+    wire [7:0]                      ar_len;
+    wire [2:0]                      ar_size;
+    wire [1:0]                      ar_burst;
+    wire [AXI_IDW-1:0]              aw_id;
+    wire [ALEN-1:0]                 aw_addr;
+    wire [7:0]                      aw_len;
+    wire [2:0]                      aw_size;
+    wire [1:0]                      aw_burst;
+
+    // Bursts being split.
+    reg                             rd_act_r;
+    reg  [AXI_IDW-1:0]              rd_id_r;
+    reg  [ALEN-1:0]                 rd_addr_r;
+    reg  [8:0]                      rd_rem_r;
+    reg  [7:0]                      rd_len_r;
+    reg  [2:0]                      rd_size_r;
+    reg  [1:0]                      rd_burst_r;
+
+    reg                             wr_act_r;
+    reg  [AXI_IDW-1:0]              wr_id_r;
+    reg  [ALEN-1:0]                 wr_addr_r;
+    reg  [8:0]                      wr_rem_r;
+    reg  [7:0]                      wr_len_r;
+    reg  [2:0]                      wr_size_r;
+    reg  [1:0]                      wr_burst_r;
+
+    wire [OFFSET_AW-1:0]            rd_offset;
+    wire                            rd_bulk;
+    wire [3:0]                      rd_chk_len;
+    wire                            rd_chk_last;
+    wire [ALEN-1:0]                 rd_nxt_addr;
+    wire [OFFSET_AW-1:0]            wr_offset;
+    wire                            wr_chk_last;
+    wire [ALEN-1:0]                 wr_nxt_addr;
+
+    wire                            rd_load;
+    wire                            wr_load;
+    wire                            rd_end;
+    wire                            wr_end;
+
+    // Bus request arbitration.
+    reg                             wr_pri_r;
+    reg                             gnt_hld_r;
+    reg                             gnt_rd_r;
+    wire                            rd_req;
+    wire                            wr_req;
+    wire                            rd_gnt;
+    wire                            wr_gnt;
+    wire                            bus_req_fire;
+    wire                            bus_rsp_fire;
+
+    // Transactions in request order.
+    wire                            tag_push;
+    wire                            tag_pop;
+    wire [TAG_DW-1:0]               tag_wr_dat;
+    wire [TAG_DW-1:0]               tag_rd_dat;
+    wire                            tag_full;
+    wire                            tag_empty;
+    wire                            tag_read;
+    wire                            tag_last;
+    wire [AXI_IDW-1:0]              tag_id;
+    wire [3:0]                      tag_len;
+    wire [OFFSET_AW-1:0]            tag_offset;
+    reg  [3:0]                      rsp_cnt_r;
+    reg                             rsp_err_r;
+    wire                            rsp_last;
+    wire                            rsp_to_r;
+    wire                            rsp_to_b;
+
+    // Address of the next beat, for INCR from the aligned address, and for WRAP in the block.
+    function [ALEN-1:0] nxt_addr;
+        input [ALEN-1:0]            addr;
+        input [7:0]                 len;
+        input [2:0]                 size;
+        input [1:0]                 burst;
+        input [8:0]                 beats;
+        reg   [ALEN-1:0]            size_mask;
+        reg   [ALEN-1:0]            wrap_mask;
+        reg   [ALEN-1:0]            incr_addr;
+        begin
+            size_mask = ~({ALEN{1'b1}} << size);
+            wrap_mask = (({{(ALEN-8){1'b0}}, len} + 1'b1) << size) - 1'b1;
+            incr_addr = (addr & (~size_mask)) + (beats << size);
+            nxt_addr  = burst == AXI_BURST_FIXED ? addr
+                      : burst == AXI_BURST_WRAP  ? (addr & (~wrap_mask)) | (incr_addr & wrap_mask)
+                      : incr_addr;
+        end
+    endfunction
+
+    // LSB-justified mask of the size.
+    function [MLEN-1:0] size_mask;
+        input [2:0]                 size;
+        begin
+            size_mask = ~({MLEN{1'b1}} << (1 << size));
+        end
+    endfunction
+
+    assign ar_push                  = axi_arvalid & axi_arready;
+    assign aw_push                  = axi_awvalid & axi_awready;
+    assign axi_arready              = ~ar_full;
+    assign axi_awready              = ~aw_full;
+
+    assign {ar_id, ar_addr, ar_len, ar_size, ar_burst} = ar_dat;
+    assign {aw_id, aw_addr, aw_len, aw_size, aw_burst} = aw_dat;
+
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( ADDR_DW           ),
+        .PTR_WIDTH                  ( RD_PW             ),
+        .QUE_DEPTH                  ( RD_OST            ),
+        .ZERO_RDLY                  ( 1'b1              )
+    )
+    u_ar_que
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .wr_rdy                     (                   ),
+        .wr_vld                     ( ar_push           ),
+        .wr_dat                     ( {axi_arid, axi_araddr, axi_arlen, axi_arsize, axi_arburst} ),
+
+        .rd_rdy                     (                   ),
+        .rd_vld                     ( rd_load           ),
+        .rd_dat                     ( ar_dat            ),
+
+        .clr                        ( 1'b0              ),
+        .len                        (                   ),
+        .full                       ( ar_full           ),
+        .empty                      ( ar_empty          )
+    );
+
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( ADDR_DW           ),
+        .PTR_WIDTH                  ( WR_PW             ),
+        .QUE_DEPTH                  ( WR_OST            ),
+        .ZERO_RDLY                  ( 1'b1              )
+    )
+    u_aw_que
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .wr_rdy                     (                   ),
+        .wr_vld                     ( aw_push           ),
+        .wr_dat                     ( {axi_awid, axi_awaddr, axi_awlen, axi_awsize, axi_awburst} ),
+
+        .rd_rdy                     (                   ),
+        .rd_vld                     ( wr_load           ),
+        .rd_dat                     ( aw_dat            ),
+
+        .clr                        ( 1'b0              ),
+        .len                        (                   ),
+        .full                       ( aw_full           ),
+        .empty                      ( aw_empty          )
+    );
+
+    // Only aligned full-width reads keep the burst on bus.
+    assign rd_offset                = rd_addr_r[OFFSET_AW-1:0];
+    assign rd_bulk                  = (rd_size_r == OFFSET_AW) & (rd_offset == {OFFSET_AW{1'b0}})
+                                    & (rd_burst_r != AXI_BURST_FIXED);
+    assign rd_chk_len               = ~rd_bulk ? 4'd0 : rd_rem_r > 9'd16 ? 4'd15 : rd_rem_r[3:0] - 1'b1;
+    assign rd_chk_last              = rd_rem_r == {5'd0, rd_chk_len} + 1'b1;
+    assign rd_nxt_addr              = nxt_addr(rd_addr_r, rd_len_r, rd_size_r, rd_burst_r, {5'd0, rd_chk_len} + 1'b1);
+
+    assign wr_offset                = wr_addr_r[OFFSET_AW-1:0];
+    assign wr_chk_last              = wr_rem_r == 9'd1;
+    assign wr_nxt_addr              = nxt_addr(wr_addr_r, wr_len_r, wr_size_r, wr_burst_r, 9'd1);
+
+    // Reads & writes take turns on bus.
+    assign rd_req                   = rd_act_r & (~tag_full);
+    assign wr_req                   = wr_act_r & (~tag_full) & axi_wvalid;
+    assign rd_gnt                   = gnt_hld_r ? gnt_rd_r : rd_req & ((~wr_req) | (~wr_pri_r));
+    assign wr_gnt                   = wr_req & (~rd_gnt);
+
+    assign bus_req_fire             = bus_req_vld & bus_req_rdy;
+    assign bus_rsp_fire             = bus_rsp_vld & bus_rsp_rdy;
+
+    assign bus_req_vld              = rd_req | wr_req;
+    assign bus_req_read             = rd_gnt;
+    assign bus_req_addr             = rd_gnt ? rd_addr_r  : wr_addr_r;
+    assign bus_req_len              = rd_gnt ? rd_chk_len : 4'd0;
+    assign bus_req_wrap             = rd_gnt & rd_bulk & (rd_burst_r == AXI_BURST_WRAP);
+    assign bus_req_mask             = rd_gnt ? size_mask(rd_size_r) : axi_wstrb >> wr_offset;
+    assign bus_req_data             = axi_wdata >> {wr_offset, 3'b0};
+    assign axi_wready               = wr_gnt & bus_req_rdy;
+
+    // Next bursts are taken when the last ones end.
+    assign rd_end                   = bus_req_fire & rd_gnt & rd_chk_last;
+    assign wr_end                   = bus_req_fire & wr_gnt & wr_chk_last;
+    assign rd_load                  = ((~rd_act_r) | rd_end) & (~ar_empty);
+    assign wr_load                  = ((~wr_act_r) | wr_end) & (~aw_empty);
+
+    // Responses follow the oldest transaction.
+    assign tag_push                 = bus_req_fire;
+    assign tag_wr_dat               = rd_gnt ? {1'b1, rd_chk_last, rd_id_r, rd_chk_len, rd_offset}
+                                    : {1'b0, wr_chk_last, wr_id_r, 4'd0, {OFFSET_AW{1'b0}}};
+    assign {tag_read, tag_last, tag_id, tag_len, tag_offset} = tag_rd_dat;
+    assign rsp_last                 = rsp_cnt_r == tag_len;
+    assign tag_pop                  = bus_rsp_fire & rsp_last;
+
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( TAG_DW            ),
+        .PTR_WIDTH                  ( TAG_PW            ),
+        .QUE_DEPTH                  ( OST_NUM           ),
+        .ZERO_RDLY                  ( 1'b1              )
+    )
+    u_tag
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .wr_rdy                     (                   ),
+        .wr_vld                     ( tag_push          ),
+        .wr_dat                     ( tag_wr_dat        ),
+
+        .rd_rdy                     (                   ),
+        .rd_vld                     ( tag_pop           ),
+        .rd_dat                     ( tag_rd_dat        ),
+
+        .clr                        ( 1'b0              ),
+        .len                        (                   ),
+        .full                       ( tag_full          ),
+        .empty                      ( tag_empty         )
+    );
+
+    // Write beats before the last are absorbed with errors kept for B.
+    assign rsp_to_r                 = (~tag_empty) & tag_read;
+    assign rsp_to_b                 = (~tag_empty) & (~tag_read) & tag_last;
+    assign bus_rsp_rdy              = rsp_to_r ? axi_rready : rsp_to_b ? axi_bready : ~tag_empty;
+
+    assign axi_rid                  = tag_id;
+    assign axi_rdata                = bus_rsp_data << {tag_offset, 3'b0};
+    assign axi_rresp                = |bus_rsp_excp ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+    assign axi_rlast                = tag_last & rsp_last;
+    assign axi_rvalid               = rsp_to_r & bus_rsp_vld;
+
+    assign axi_bid                  = tag_id;
+    assign axi_bresp                = rsp_err_r | (|bus_rsp_excp) ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+    assign axi_bvalid               = rsp_to_b & bus_rsp_vld;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_cnt_r <= 4'd0;
+        end
+        else begin
+            if (tag_pop) begin
+                rsp_cnt_r <= #UDLY 4'd0;
+            end
+            else if (bus_rsp_fire) begin
+                rsp_cnt_r <= #UDLY rsp_cnt_r + 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_err_r <= 1'b0;
+        end
+        else begin
+            if (bus_rsp_fire & (~tag_read)) begin
+                rsp_err_r <= #UDLY tag_last ? 1'b0 : rsp_err_r | (|bus_rsp_excp);
+            end
+        end
+    end
+
+    // Turn to the other side after each request.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            wr_pri_r <= 1'b0;
+        end
+        else begin
+            if (bus_req_fire) begin
+                wr_pri_r <= #UDLY rd_gnt;
+            end
+        end
+    end
+
+    // The grant is held until the request is taken.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gnt_hld_r <= 1'b0;
+            gnt_rd_r  <= 1'b0;
+        end
+        else begin
+            gnt_hld_r <= #UDLY bus_req_vld & (~bus_req_rdy);
+            gnt_rd_r  <= #UDLY rd_gnt;
+        end
+    end
+
+    // Split read bursts.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rd_act_r   <= 1'b0;
+            rd_id_r    <= {AXI_IDW{1'b0}};
+            rd_addr_r  <= {ALEN{1'b0}};
+            rd_rem_r   <= 9'd0;
+            rd_len_r   <= 8'd0;
+            rd_size_r  <= 3'd0;
+            rd_burst_r <= 2'b0;
+        end
+        else begin
+            if (rd_load) begin
+                rd_act_r   <= #UDLY 1'b1;
+                rd_id_r    <= #UDLY ar_id;
+                rd_addr_r  <= #UDLY ar_addr;
+                rd_rem_r   <= #UDLY {1'b0, ar_len} + 1'b1;
+                rd_len_r   <= #UDLY ar_len;
+                rd_size_r  <= #UDLY ar_size;
+                rd_burst_r <= #UDLY ar_burst;
+            end
+            else if (rd_end) begin
+                rd_act_r   <= #UDLY 1'b0;
+            end
+            else if (bus_req_fire & rd_gnt) begin
+                rd_addr_r  <= #UDLY rd_nxt_addr;
+                rd_rem_r   <= #UDLY rd_rem_r - rd_chk_len - 1'b1;
+            end
+        end
+    end
+
+    // Split write bursts.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            wr_act_r   <= 1'b0;
+            wr_id_r    <= {AXI_IDW{1'b0}};
+            wr_addr_r  <= {ALEN{1'b0}};
+            wr_rem_r   <= 9'd0;
+            wr_len_r   <= 8'd0;
+            wr_size_r  <= 3'd0;
+            wr_burst_r <= 2'b0;
+        end
+        else begin
+            if (wr_load) begin
+                wr_act_r   <= #UDLY 1'b1;
+                wr_id_r    <= #UDLY aw_id;
+                wr_addr_r  <= #UDLY aw_addr;
+                wr_rem_r   <= #UDLY {1'b0, aw_len} + 1'b1;
+                wr_len_r   <= #UDLY aw_len;
+                wr_size_r  <= #UDLY aw_size;
+                wr_burst_r <= #UDLY aw_burst;
+            end
+            else if (wr_end) begin
+                wr_act_r   <= #UDLY 1'b0;
+            end
+            else if (bus_req_fire & wr_gnt) begin
+                wr_addr_r  <= #UDLY wr_nxt_addr;
+                wr_rem_r   <= #UDLY wr_rem_r - 1'b1;
+            end
+        end
+    end
+
+endmodule
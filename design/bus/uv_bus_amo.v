@@ -0,0 +1,253 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_bus_amo
+//
+// Designer: Owen
+//
+// Description:
+//      Atomic memory operations in front of a slave.
+//      Requests with nonzero AMO pass as one bus transaction
+//      to the master, which is done here as a read & a write
+//      of the slave port, and the old data is responded. The
+//      slave port is held in between, so nothing interleaves.
+//      Other requests pass through, and an AMO waits for the
+//      outstanding ones. Only the low word is operated on.
+//      AMO: 1 SWAP, 2 ADD, 3 XOR, 4 AND, 5 OR, 6 MIN, 7 MAX,
+//           8 MINU, 9 MAXU, A LR, B SC.
+//      LR is a read reserving the row for its master, one of
+//      RSV_NUM by SRC. Writes to the row clear reservations, so
+//      SC writes only with the reservation of its master, and
+//      responds 0, or 1 with nothing written.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_bus_amo
+#(
+    parameter ALEN                  = 32,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter RSV_NUM               = 1,
+    parameter RSV_IW                = RSV_NUM > 1 ? $clog2(RSV_NUM) : 1
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // From bus.
+    input                           bus_req_vld,
+    output                          bus_req_rdy,
+    input                           bus_req_read,
+    input  [ALEN-1:0]               bus_req_addr,
+    input  [3:0]                    bus_req_len,
+    input                           bus_req_wrap,
+    input  [3:0]                    bus_req_amo,
+    input  [RSV_IW-1:0]             bus_req_src,
+    input  [MLEN-1:0]               bus_req_mask,
+    input  [DLEN-1:0]               bus_req_data,
+
+    output                          bus_rsp_vld,
+    input                           bus_rsp_rdy,
+    output [1:0]                    bus_rsp_excp,
+    output [DLEN-1:0]               bus_rsp_data,
+
+    // To slave.
+    output                          slv_req_vld,
+    input                           slv_req_rdy,
+    output                          slv_req_read,
+    output [ALEN-1:0]               slv_req_addr,
+    output [3:0]                    slv_req_len,
+    output                          slv_req_wrap,
+    output [MLEN-1:0]               slv_req_mask,
+    output [DLEN-1:0]               slv_req_data,
+
+    input                           slv_rsp_vld,
+    output                          slv_rsp_rdy,
+    input  [1:0]                    slv_rsp_excp,
+    input  [DLEN-1:0]               slv_rsp_data
+);
+
+    localparam UDLY                 = 1;
+    localparam AMO_SWAP             = 4'h1;
+    localparam AMO_ADD              = 4'h2;
+    localparam AMO_XOR              = 4'h3;
+    localparam AMO_AND              = 4'h4;
+    localparam AMO_OR               = 4'h5;
+    localparam AMO_MIN              = 4'h6;
+    localparam AMO_MAX              = 4'h7;
+    localparam AMO_MINU             = 4'h8;
+    localparam AMO_MAXU             = 4'h9;
+    localparam AMO_LR               = 4'ha;
+    localparam AMO_SC               = 4'hb;
+    localparam RSV_LSB              = $clog2(MLEN);
+
+    localparam AMO_IDLE             = 3'h0;
+    localparam AMO_READ             = 3'h1;
+    localparam AMO_WAIT             = 3'h2;
+    localparam AMO_WRITE            = 3'h3;
+    localparam AMO_RESP             = 3'h4;
+    localparam AMO_DROP             = 3'h5;
+    localparam AMO_RTN              = 3'h6;
+
+    genvar i;
+
+    reg  [2:0]                      amo_sta_r;
+    reg  [5:0]                      ost_cnt_r;
+    reg  [31:0]                     old_dat_r;
+    reg  [1:0]                      old_excp_r;
+    reg  [RSV_NUM-1:0]              rsv_vld_r;
+    reg  [ALEN-RSV_LSB-1:0]         rsv_addr_r [0:RSV_NUM-1];
+
+    wire                            req_lr;
+    wire                            req_sc;
+    wire                            sc_hit;
+    wire                            bus_req_fire;
+    wire                            amo_req;
+    wire                            amo_start;
+    wire                            amo_busy;
+    wire                            slv_req_fire;
+    wire                            slv_rsp_fire;
+    wire                            bus_rsp_fire;
+    wire                            pass_req_fire;
+    wire                            pass_rsp_fire;
+
+    wire [31:0]                     amo_src;
+    wire [31:0]                     amo_res;
+    wire [DLEN-1:0]                 amo_wdat;
+    wire [DLEN-1:0]                 old_rdat;
+    wire                            amo_slt;
+    wire                            amo_sltu;
+
+    // LR passes as a read, & SC is done here like the AMOs.
+    assign req_lr                   = bus_req_amo == AMO_LR;
+    assign req_sc                   = bus_req_amo == AMO_SC;
+    assign sc_hit                   = rsv_vld_r[bus_req_src] & (rsv_addr_r[bus_req_src] == bus_req_addr[ALEN-1:RSV_LSB]);
+
+    assign amo_req                  = bus_req_vld & (|bus_req_amo) & (~req_lr);
+    assign amo_start                = amo_req & (amo_sta_r == AMO_IDLE) & (ost_cnt_r == 6'd0);
+    assign amo_busy                 = amo_req | (amo_sta_r != AMO_IDLE);
+
+    assign slv_req_fire             = slv_req_vld & slv_req_rdy;
+    assign slv_rsp_fire             = slv_rsp_vld & slv_rsp_rdy;
+    assign bus_req_fire             = bus_req_vld & bus_req_rdy;
+    assign bus_rsp_fire             = bus_rsp_vld & bus_rsp_rdy;
+    assign pass_req_fire            = slv_req_fire & (~amo_busy);
+    assign pass_rsp_fire            = slv_rsp_fire & (amo_sta_r == AMO_IDLE);
+
+    // Slave port: read in AMO_READ, write in AMO_WRITE, or pass through.
+    assign slv_req_vld              = (amo_sta_r == AMO_READ) | (amo_sta_r == AMO_WRITE)
+                                    | (bus_req_vld & (~amo_busy));
+    assign slv_req_read             = amo_sta_r == AMO_READ ? 1'b1
+                                    : amo_sta_r == AMO_WRITE ? 1'b0
+                                    : bus_req_read;
+    assign slv_req_addr             = bus_req_addr;
+    assign slv_req_len              = amo_busy ? 4'b0 : bus_req_len;
+    assign slv_req_wrap             = amo_busy ? 1'b0 : bus_req_wrap;
+    assign slv_req_mask             = bus_req_mask;
+    assign slv_req_data             = amo_sta_r == AMO_WRITE ? amo_wdat : bus_req_data;
+    assign slv_rsp_rdy              = amo_sta_r == AMO_WAIT ? 1'b1 : bus_rsp_rdy;
+
+    // The AMO is accepted when its write is, or dropped when its read
+    // faults or the SC misses, & the held data is responded then.
+    assign bus_req_rdy              = amo_sta_r == AMO_WRITE ? slv_req_rdy
+                                    : amo_sta_r == AMO_DROP ? 1'b1
+                                    : (~amo_busy) & slv_req_rdy;
+    assign bus_rsp_vld              = amo_sta_r == AMO_RTN ? 1'b1
+                                    : (amo_sta_r == AMO_WAIT) | (amo_sta_r == AMO_DROP) ? 1'b0
+                                    : slv_rsp_vld;
+    assign bus_rsp_excp             = amo_sta_r == AMO_RTN ? old_excp_r : slv_rsp_excp;
+    assign bus_rsp_data             = (amo_sta_r == AMO_RESP) | (amo_sta_r == AMO_RTN) ? old_rdat
+                                    : slv_rsp_data;
+
+    // AMO ALU.
+    assign amo_src                  = bus_req_data[31:0];
+    assign amo_slt                  = $signed(old_dat_r) < $signed(amo_src);
+    assign amo_sltu                 = old_dat_r < amo_src;
+    assign amo_res                  = bus_req_amo == AMO_SWAP ? amo_src
+                                    : bus_req_amo == AMO_ADD  ? old_dat_r + amo_src
+                                    : bus_req_amo == AMO_XOR  ? old_dat_r ^ amo_src
+                                    : bus_req_amo == AMO_AND  ? old_dat_r & amo_src
+                                    : bus_req_amo == AMO_OR   ? old_dat_r | amo_src
+                                    : bus_req_amo == AMO_MIN  ? (amo_slt  ? old_dat_r : amo_src)
+                                    : bus_req_amo == AMO_MAX  ? (amo_slt  ? amo_src : old_dat_r)
+                                    : bus_req_amo == AMO_MINU ? (amo_sltu ? old_dat_r : amo_src)
+                                    : bus_req_amo == AMO_MAXU ? (amo_sltu ? amo_src : old_dat_r)
+                                    : amo_src;
+
+    // Data are LSB-justified and zero-extended.
+    assign amo_wdat                 = amo_res;
+    assign old_rdat                 = old_dat_r;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            amo_sta_r <= AMO_IDLE;
+        end
+        else begin
+            case (amo_sta_r)
+                AMO_IDLE : if (amo_start) amo_sta_r <= #UDLY ~req_sc ? AMO_READ : sc_hit ? AMO_WRITE : AMO_DROP;
+                AMO_READ : if (slv_req_fire) amo_sta_r <= #UDLY AMO_WAIT;
+                AMO_WAIT : if (slv_rsp_fire) amo_sta_r <= #UDLY (|slv_rsp_excp) ? AMO_DROP : AMO_WRITE;
+                AMO_WRITE: if (slv_req_fire) amo_sta_r <= #UDLY AMO_RESP;
+                AMO_RESP : if (bus_rsp_fire) amo_sta_r <= #UDLY AMO_IDLE;
+                AMO_DROP : amo_sta_r <= #UDLY AMO_RTN;
+                AMO_RTN  : if (bus_rsp_fire) amo_sta_r <= #UDLY AMO_IDLE;
+                default  : amo_sta_r <= #UDLY AMO_IDLE;
+            endcase
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            old_dat_r  <= 32'b0;
+            old_excp_r <= 2'b0;
+        end
+        else begin
+            if (amo_start & req_sc) begin
+                old_dat_r  <= #UDLY {31'b0, ~sc_hit};
+                old_excp_r <= #UDLY 2'b0;
+            end
+            else if ((amo_sta_r == AMO_WAIT) & slv_rsp_fire) begin
+                old_dat_r  <= #UDLY slv_rsp_data[31:0];
+                old_excp_r <= #UDLY slv_rsp_excp;
+            end
+        end
+    end
+
+    // Reserve the row on LR, till the SC of the master or any write to the row.
+    generate
+        for (i = 0; i < RSV_NUM; i = i + 1) begin: gen_rsv
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    rsv_vld_r[i]  <= 1'b0;
+                    rsv_addr_r[i] <= {(ALEN-RSV_LSB){1'b0}};
+                end
+                else begin
+                    if (bus_req_fire & req_lr & (bus_req_src == i)) begin
+                        rsv_vld_r[i]  <= #UDLY 1'b1;
+                        rsv_addr_r[i] <= #UDLY bus_req_addr[ALEN-1:RSV_LSB];
+                    end
+                    else if ((bus_req_fire & req_sc & (bus_req_src == i))
+                            | (slv_req_fire & (~slv_req_read) & (slv_req_addr[ALEN-1:RSV_LSB] == rsv_addr_r[i]))) begin
+                        rsv_vld_r[i]  <= #UDLY 1'b0;
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    // Count responses due to passed requests, for which AMOs wait.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ost_cnt_r <= 6'd0;
+        end
+        else begin
+            if (pass_req_fire | pass_rsp_fire) begin
+                ost_cnt_r <= #UDLY ost_cnt_r
+                           + (pass_req_fire ? (bus_req_read ? {2'b0, bus_req_len} + 6'd1 : 6'd1) : 6'd0)
+                           - (pass_rsp_fire ? 6'd1 : 6'd0);
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,115 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_bus_burst
+//
+// Designer: Owen
+//
+// Description:
+//      Burst sequencer from bus to single-beat requests.
+//      A read burst of LEN+1 beats is expanded to LEN+1 reads
+//      with incrementing or wrapping addresses, which are
+//      issued back to back. Write bursts carry the address of
+//      each beat and pass through, as do atomic writes.
+//      Responses are not touched.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_bus_burst
+#(
+    parameter ALEN                  = 32,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           bst_req_vld,
+    output                          bst_req_rdy,
+    input                           bst_req_read,
+    input  [ALEN-1:0]               bst_req_addr,
+    input  [3:0]                    bst_req_len,
+    input                           bst_req_wrap,
+    input  [3:0]                    bst_req_amo,
+    input  [MLEN-1:0]               bst_req_mask,
+    input  [DLEN-1:0]               bst_req_data,
+
+    output                          sgl_req_vld,
+    input                           sgl_req_rdy,
+    output                          sgl_req_read,
+    output [ALEN-1:0]               sgl_req_addr,
+    output [3:0]                    sgl_req_amo,
+    output [MLEN-1:0]               sgl_req_mask,
+    output [DLEN-1:0]               sgl_req_data,
+
+    output                          bst_busy
+);
+
+    localparam UDLY                 = 1;
+    localparam OFFSET_AW            = $clog2(MLEN);
+
+    reg                             bst_act_r;
+    reg  [3:0]                      bst_cnt_r;
+    reg  [3:0]                      bst_len_r;
+    reg                             bst_wrap_r;
+    reg  [ALEN-1:0]                 bst_addr_r;
+
+    wire                            bst_req_fire;
+    wire                            sgl_req_fire;
+    wire                            bst_start;
+    wire [ALEN-1:0]                 nxt_addr;
+    wire [ALEN-1:0]                 nxt_base;
+    wire [ALEN-1:0]                 wrap_mask;
+    wire [ALEN-1:0]                 beat_addr;
+    wire [3:0]                      beat_len;
+    wire                            beat_wrap;
+
+    assign bst_req_fire             = bst_req_vld & bst_req_rdy;
+    assign sgl_req_fire             = sgl_req_vld & sgl_req_rdy;
+    assign bst_start                = bst_req_fire & bst_req_read & (|bst_req_len);
+
+    // Generated beats take over the port until the burst ends.
+    assign bst_req_rdy              = (~bst_act_r) & sgl_req_rdy;
+    assign sgl_req_vld              = bst_act_r | bst_req_vld;
+    assign sgl_req_read             = bst_act_r | bst_req_read;
+    assign sgl_req_addr             = bst_act_r ? bst_addr_r : bst_req_addr;
+    assign sgl_req_amo              = bst_act_r ? 4'b0 : bst_req_amo;
+    assign sgl_req_mask             = bst_act_r ? {MLEN{1'b1}} : bst_req_mask;
+    assign sgl_req_data             = bst_act_r ? {DLEN{1'b0}} : bst_req_data;
+    assign bst_busy                 = bst_act_r;
+
+    // Wrapping bursts stay in the block of (LEN+1) beats.
+    assign beat_addr                = bst_act_r ? bst_addr_r : bst_req_addr;
+    assign beat_len                 = bst_act_r ? bst_len_r  : bst_req_len;
+    assign beat_wrap                = bst_act_r ? bst_wrap_r : bst_req_wrap;
+    assign wrap_mask                = {{(ALEN-OFFSET_AW-4){1'b0}}, beat_len, {OFFSET_AW{1'b1}}};
+    assign nxt_base                 = beat_addr + MLEN;
+    assign nxt_addr                 = beat_wrap ? (beat_addr & (~wrap_mask)) | (nxt_base & wrap_mask) : nxt_base;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            bst_act_r  <= 1'b0;
+            bst_cnt_r  <= 4'b0;
+            bst_len_r  <= 4'b0;
+            bst_wrap_r <= 1'b0;
+            bst_addr_r <= {ALEN{1'b0}};
+        end
+        else begin
+            if (bst_start) begin
+                bst_act_r  <= #UDLY 1'b1;
+                bst_cnt_r  <= #UDLY bst_req_len;
+                bst_len_r  <= #UDLY bst_req_len;
+                bst_wrap_r <= #UDLY bst_req_wrap;
+                bst_addr_r <= #UDLY nxt_addr;
+            end
+            else if (bst_act_r & sgl_req_fire) begin
+                bst_act_r  <= #UDLY bst_cnt_r != 4'd1;
+                bst_cnt_r  <= #UDLY bst_cnt_r - 1'b1;
+                bst_addr_r <= #UDLY nxt_addr;
+            end
+        end
+    end
+
+endmodule
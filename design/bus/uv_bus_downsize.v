@@ -0,0 +1,47 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_bus_downsize
+//
+// Designer: Owen
+//
+// Description:
+//      Width adapter from a wide bus to a narrow slave.
+//      Bus data is LSB-justified, so the low lanes are taken
+//      for requests & responses are zero-extended. Requests
+//      are expected to fit in the narrow width, which holds
+//      for the narrow masters of the bus. Handshakes pass by.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_bus_downsize
+#(
+    parameter WID_DW                = 64,
+    parameter WID_MW                = WID_DW / 8,
+    parameter NRW_DW                = 32,
+    parameter NRW_MW                = NRW_DW / 8
+)
+(
+    input  [WID_MW-1:0]             wid_req_mask,
+    input  [WID_DW-1:0]             wid_req_data,
+    output [WID_DW-1:0]             wid_rsp_data,
+
+    output [NRW_MW-1:0]             nrw_req_mask,
+    output [NRW_DW-1:0]             nrw_req_data,
+    input  [NRW_DW-1:0]             nrw_rsp_data
+);
+
+    assign nrw_req_mask             = wid_req_mask[NRW_MW-1:0];
+    assign nrw_req_data             = wid_req_data[NRW_DW-1:0];
+
+    generate
+        if (WID_DW == NRW_DW) begin: gen_pass
+            assign wid_rsp_data     = nrw_rsp_data;
+        end
+        else begin: gen_downsize
+            assign wid_rsp_data     = {{(WID_DW-NRW_DW){1'b0}}, nrw_rsp_data};
+        end
+    endgenerate
+
+endmodule
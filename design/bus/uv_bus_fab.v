@@ -8,7 +8,22 @@
 // Description:
 //      Bus fabric with any number of master ports,
 //      and up to 16 slave ports.
-//      FIXME: Add alternate pipeline fifo.
+//      Each master may have OST_NUM transactions outstanding
+//      to one slave, and each slave takes up to OST_NUM ones
+//      whose masters are queued to return responses in order.
+//      Register slices are inserted to slave requests with
+//      PIPE_STAGE > 0, and to master responses with > 1.
+//      A burst of LEN+1 beats gets LEN+1 responses. Reads are
+//      requested once, and writes send LEN+1 beats each with
+//      its own address, during which the slave is locked.
+//      WRAP bursts have LEN+1 of 2, 4, 8 or 16. Read bursts to
+//      slaves not set in SLV_BURST are split into single reads.
+//      AMO is nonzero for atomic single writes, which the slave
+//      does as one read-modify-write returning the old data.
+//      AMOs to slaves not set in SLV_AMO get access faults.
+//      Slaves arbitrate in round-robin, or by the QoS of
+//      masters (class, weight & starvation limit) with QOS_EN.
+//      Where address ranges overlap, the lower slave port wins.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -18,7 +33,11 @@ module uv_bus_fab
     parameter ALEN                  = 32,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter PIPE_STAGE            = 0,    // TODO
+    parameter PIPE_STAGE            = 0,    // 0: none; 1: request slices; 2: request & response slices.
+    parameter OST_NUM               = 1,
+    parameter SLV_BURST             = 16'h0,
+    parameter SLV_AMO               = 16'hffff,
+    parameter QOS_EN                = 1'b0,
     parameter MST_PORT_NUM          = 4,
     parameter SLV_PORT_NUM          = 16,
     parameter SLV0_BASE_LSB         = 28,
@@ -64,6 +83,9 @@ module uv_bus_fab
     output [MST_PORT_NUM-1:0]       mst_req_rdy,
     input  [MST_PORT_NUM-1:0]       mst_req_read,
     input  [MST_PORT_NUM*ALEN-1:0]  mst_req_addr,
+    input  [MST_PORT_NUM*4-1:0]     mst_req_len,
+    input  [MST_PORT_NUM-1:0]       mst_req_wrap,
+    input  [MST_PORT_NUM*4-1:0]     mst_req_amo,
     input  [MST_PORT_NUM*MLEN-1:0]  mst_req_mask,
     input  [MST_PORT_NUM*DLEN-1:0]  mst_req_data,
     output [MST_PORT_NUM-1:0]       mst_rsp_vld,
@@ -71,12 +93,20 @@ module uv_bus_fab
     output [MST_PORT_NUM*2-1:0]     mst_rsp_excp,
     output [MST_PORT_NUM*DLEN-1:0]  mst_rsp_data,
 
+    // QoS of masters, used with QOS_EN.
+    input  [MST_PORT_NUM*2-1:0]     mst_qos_cls,
+    input  [MST_PORT_NUM*4-1:0]     mst_qos_wgt,
+    input  [7:0]                    qos_lim,
+
     // Slaves.
     input  [SLV_PORT_NUM-1:0]       slv_dev_vld,
     output [SLV_PORT_NUM-1:0]       slv_req_vld,
     input  [SLV_PORT_NUM-1:0]       slv_req_rdy,
     output [SLV_PORT_NUM-1:0]       slv_req_read,
     output [SLV_PORT_NUM*ALEN-1:0]  slv_req_addr,
+    output [SLV_PORT_NUM*4-1:0]     slv_req_len,
+    output [SLV_PORT_NUM-1:0]       slv_req_wrap,
+    output [SLV_PORT_NUM*4-1:0]     slv_req_amo,
     output [SLV_PORT_NUM*MLEN-1:0]  slv_req_mask,
     output [SLV_PORT_NUM*DLEN-1:0]  slv_req_data,
     input  [SLV_PORT_NUM-1:0]       slv_rsp_vld,
@@ -86,22 +116,31 @@ module uv_bus_fab
 );
 
     localparam UDLY = 1;
+    localparam OST_PW               = OST_NUM > 1 ? $clog2(OST_NUM) : 1;
+    localparam OST_CW               = $clog2(OST_NUM + 1);
+    localparam REQ_DW               = 1 + ALEN + 5 + 4 + MLEN + DLEN;
+    localparam RSP_DW               = 2 + DLEN;
     genvar i, j, k;
 
     // Port matrix.
     wire [ALEN-1:0]                 mst_req_addr_2d [MST_PORT_NUM-1:0];
+    wire [3:0]                      mst_req_len_2d  [MST_PORT_NUM-1:0];
+    wire [3:0]                      mst_req_amo_2d  [MST_PORT_NUM-1:0];
     wire [MLEN-1:0]                 mst_req_mask_2d [MST_PORT_NUM-1:0];
     wire [DLEN-1:0]                 mst_req_data_2d [MST_PORT_NUM-1:0];
     wire [1:0]                      mst_rsp_excp_2d [MST_PORT_NUM-1:0];
     wire [DLEN-1:0]                 mst_rsp_data_2d [MST_PORT_NUM-1:0];
 
     wire [ALEN-1:0]                 slv_req_addr_2d [SLV_PORT_NUM-1:0];
+    wire [3:0]                      slv_req_len_2d  [SLV_PORT_NUM-1:0];
+    wire [3:0]                      slv_req_amo_2d  [SLV_PORT_NUM-1:0];
     wire [MLEN-1:0]                 slv_req_mask_2d [SLV_PORT_NUM-1:0];
     wire [DLEN-1:0]                 slv_req_data_2d [SLV_PORT_NUM-1:0];
     wire [1:0]                      slv_rsp_excp_2d [SLV_PORT_NUM-1:0];
     wire [DLEN-1:0]                 slv_rsp_data_2d [SLV_PORT_NUM-1:0];
 
     // Slave selections.
+    wire [SLV_PORT_NUM-1:0]         mst_addr_hit    [MST_PORT_NUM-1:0];  // mst_addr_hit[mst][slv]
     wire [SLV_PORT_NUM-1:0]         mst_addr_match  [MST_PORT_NUM-1:0];  // mst_addr_match[mst][slv]
     wire [SLV_PORT_NUM-1:0]         mst_sel_to_slv  [MST_PORT_NUM-1:0];  // mst_sel_to_slv[mst][slv]
     wire [MST_PORT_NUM-1:0]         slv_sel_to_mst  [SLV_PORT_NUM-1:0];  // slv_sel_to_mst[slv][mst]
@@ -111,16 +150,68 @@ module uv_bus_fab
     // Arbiter ports.
     wire [MST_PORT_NUM-1:0]         slv_arb_req     [SLV_PORT_NUM-1:0];  // slv_arb_req[slv][mst]
     wire [MST_PORT_NUM-1:0]         slv_arb_grant   [SLV_PORT_NUM-1:0];  // slv_arb_grant[slv][mst]
-    wire [SLV_PORT_NUM-1:0]         mst_arb_grant   [MST_PORT_NUM-1:0];  // mst_arb_grant[mst][slv]
-    reg  [MST_PORT_NUM-1:0]         slv_arb_grant_r [SLV_PORT_NUM-1:0];  // mst_arb_grant_r[slv][mst]
-    reg  [SLV_PORT_NUM-1:0]         mst_arb_grant_r [MST_PORT_NUM-1:0];  // mst_arb_grant_r[mst][slv]
+    wire [MST_PORT_NUM-1:0]         slv_req_grant   [SLV_PORT_NUM-1:0];  // slv_req_grant[slv][mst]
+    reg  [MST_PORT_NUM-1:0]         slv_req_hold_r  [SLV_PORT_NUM-1:0];  // slv_req_hold_r[slv][mst]
+
+    // Write bursts locking slaves.
+    reg  [3:0]                      slv_wbst_cnt_r  [SLV_PORT_NUM-1:0];
+    reg  [MST_PORT_NUM-1:0]         slv_wbst_mst_r  [SLV_PORT_NUM-1:0];  // slv_wbst_mst_r[slv][mst]
+    wire [SLV_PORT_NUM-1:0]         slv_wbst_act;
+    wire [SLV_PORT_NUM-1:0]         mst_wbst_lck    [MST_PORT_NUM-1:0];  // mst_wbst_lck[mst][slv]
+    wire [MST_PORT_NUM-1:0]         mst_wbst;
+
+    // Outstanding transactions of masters, which are all to one slave.
+    reg  [OST_CW-1:0]               mst_ost_cnt_r   [MST_PORT_NUM-1:0];
+    reg  [SLV_PORT_NUM-1:0]         mst_ost_slv_r   [MST_PORT_NUM-1:0];  // mst_ost_slv_r[mst][slv]
+    wire [MST_PORT_NUM-1:0]         mst_ost_new;
+    wire [MST_PORT_NUM-1:0]         mst_ost_idle;
+    wire [MST_PORT_NUM-1:0]         mst_ost_room;
+
+    // In-order response queues of slaves, holding masters of outstanding transactions.
+    reg  [OST_NUM*MST_PORT_NUM-1:0] slv_ost_que_r   [SLV_PORT_NUM-1:0];
+    reg  [OST_PW-1:0]               slv_ost_wptr_r  [SLV_PORT_NUM-1:0];
+    reg  [OST_PW-1:0]               slv_ost_rptr_r  [SLV_PORT_NUM-1:0];
+    reg  [OST_CW-1:0]               slv_ost_cnt_r   [SLV_PORT_NUM-1:0];
+    reg  [OST_NUM*4-1:0]            slv_ost_len_r   [SLV_PORT_NUM-1:0];
+    reg  [3:0]                      slv_rsp_cnt_r   [SLV_PORT_NUM-1:0];
+    wire [MST_PORT_NUM-1:0]         slv_ost_head    [SLV_PORT_NUM-1:0];  // slv_ost_head[slv][mst]
+    wire [SLV_PORT_NUM-1:0]         slv_ost_room;
+    wire [SLV_PORT_NUM-1:0]         slv_ost_push;
+    wire [SLV_PORT_NUM-1:0]         slv_rsp_last;
+    wire [MST_PORT_NUM-1:0]         mst_rsp_last;
 
     // Master-slave locks.
-    wire [SLV_PORT_NUM-1:0]         req_lck_to_slv  [MST_PORT_NUM-1:0];  // mst_lck_to_slv[mst][slv]
+    wire [SLV_PORT_NUM-1:0]         req_lck_to_slv  [MST_PORT_NUM-1:0];  // req_lck_to_slv[mst][slv]
     wire [SLV_PORT_NUM-1:0]         mst_lck_to_slv  [MST_PORT_NUM-1:0];  // mst_lck_to_slv[mst][slv]
     wire [MST_PORT_NUM-1:0]         slv_lck_to_mst  [SLV_PORT_NUM-1:0];  // slv_lck_to_mst[slv][mst]
 
-    // Master & slave fires.
+    // Fabric side of register slices.
+    wire [SLV_PORT_NUM-1:0]         fab_slv_req_vld;
+    wire [SLV_PORT_NUM-1:0]         fab_slv_req_rdy;
+    wire [SLV_PORT_NUM-1:0]         fab_slv_req_read;
+    wire [ALEN-1:0]                 fab_slv_req_addr_2d [SLV_PORT_NUM-1:0];
+    wire [3:0]                      fab_slv_req_len_2d  [SLV_PORT_NUM-1:0];
+    wire [SLV_PORT_NUM-1:0]         fab_slv_req_wrap;
+    wire [3:0]                      fab_slv_req_amo_2d  [SLV_PORT_NUM-1:0];
+    wire [MLEN-1:0]                 fab_slv_req_mask_2d [SLV_PORT_NUM-1:0];
+    wire [DLEN-1:0]                 fab_slv_req_data_2d [SLV_PORT_NUM-1:0];
+    wire [MST_PORT_NUM-1:0]         fab_mst_rsp_vld;
+    wire [MST_PORT_NUM-1:0]         fab_mst_rsp_rdy;
+    wire [1:0]                      fab_mst_rsp_excp_2d [MST_PORT_NUM-1:0];
+    wire [DLEN-1:0]                 fab_mst_rsp_data_2d [MST_PORT_NUM-1:0];
+
+    // Slave side of register slices.
+    wire [SLV_PORT_NUM-1:0]         pipe_slv_req_vld;
+    wire [SLV_PORT_NUM-1:0]         pipe_slv_req_rdy;
+    wire [SLV_PORT_NUM-1:0]         pipe_slv_req_read;
+    wire [ALEN-1:0]                 pipe_slv_req_addr_2d [SLV_PORT_NUM-1:0];
+    wire [3:0]                      pipe_slv_req_len_2d  [SLV_PORT_NUM-1:0];
+    wire [SLV_PORT_NUM-1:0]         pipe_slv_req_wrap;
+    wire [3:0]                      pipe_slv_req_amo_2d  [SLV_PORT_NUM-1:0];
+    wire [MLEN-1:0]                 pipe_slv_req_mask_2d [SLV_PORT_NUM-1:0];
+    wire [DLEN-1:0]                 pipe_slv_req_data_2d [SLV_PORT_NUM-1:0];
+
+    // Master & slave fires on fabric side.
     wire [MST_PORT_NUM-1:0]         mst_req_fire;
     wire [MST_PORT_NUM-1:0]         mst_rsp_fire;
     wire [SLV_PORT_NUM-1:0]         slv_req_fire;
@@ -130,6 +221,8 @@ module uv_bus_fab
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_port_2d
             assign mst_req_addr_2d[i] = mst_req_addr[(i+1)*ALEN-1:i*ALEN];
+            assign mst_req_len_2d[i]  = mst_req_len[(i+1)*4-1:i*4];
+            assign mst_req_amo_2d[i]  = mst_req_amo[(i+1)*4-1:i*4];
             assign mst_req_mask_2d[i] = mst_req_mask[(i+1)*MLEN-1:i*MLEN];
             assign mst_req_data_2d[i] = mst_req_data[(i+1)*DLEN-1:i*DLEN];
             assign mst_rsp_excp[(i+1)*2-1:i*2]       = mst_rsp_excp_2d[i];
@@ -140,6 +233,8 @@ module uv_bus_fab
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_port_2d
             assign slv_req_addr[(i+1)*ALEN-1:i*ALEN] = slv_req_addr_2d[i];
+            assign slv_req_len[(i+1)*4-1:i*4]        = slv_req_len_2d[i];
+            assign slv_req_amo[(i+1)*4-1:i*4]        = slv_req_amo_2d[i];
             assign slv_req_mask[(i+1)*MLEN-1:i*MLEN] = slv_req_mask_2d[i];
             assign slv_req_data[(i+1)*DLEN-1:i*DLEN] = slv_req_data_2d[i];
             assign slv_rsp_excp_2d[i] = slv_rsp_excp[(i+1)*2-1:i*2];
@@ -151,64 +246,79 @@ module uv_bus_fab
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_addr_match
             if (SLV_PORT_NUM > 0) begin: gen_mst_addr_match_0
-                assign mst_addr_match[i][0] = mst_req_addr_2d[i][ALEN-1:SLV0_BASE_LSB] == SLV0_BASE_ADDR;
+                assign mst_addr_hit[i][0] = mst_req_addr_2d[i][ALEN-1:SLV0_BASE_LSB] == SLV0_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 1) begin: gen_mst_addr_match_1
-                assign mst_addr_match[i][1] = mst_req_addr_2d[i][ALEN-1:SLV1_BASE_LSB] == SLV1_BASE_ADDR;
+                assign mst_addr_hit[i][1] = mst_req_addr_2d[i][ALEN-1:SLV1_BASE_LSB] == SLV1_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 2) begin: gen_mst_addr_match_2
-                assign mst_addr_match[i][2] = mst_req_addr_2d[i][ALEN-1:SLV2_BASE_LSB] == SLV2_BASE_ADDR;
+                assign mst_addr_hit[i][2] = mst_req_addr_2d[i][ALEN-1:SLV2_BASE_LSB] == SLV2_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 3) begin: gen_mst_addr_match_3
-                assign mst_addr_match[i][3] = mst_req_addr_2d[i][ALEN-1:SLV3_BASE_LSB] == SLV3_BASE_ADDR;
+                assign mst_addr_hit[i][3] = mst_req_addr_2d[i][ALEN-1:SLV3_BASE_LSB] == SLV3_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 4) begin: gen_mst_addr_match_4
-                assign mst_addr_match[i][4] = mst_req_addr_2d[i][ALEN-1:SLV4_BASE_LSB] == SLV4_BASE_ADDR;
+                assign mst_addr_hit[i][4] = mst_req_addr_2d[i][ALEN-1:SLV4_BASE_LSB] == SLV4_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 5) begin: gen_mst_addr_match_5
-                assign mst_addr_match[i][5] = mst_req_addr_2d[i][ALEN-1:SLV5_BASE_LSB] == SLV5_BASE_ADDR;
+                assign mst_addr_hit[i][5] = mst_req_addr_2d[i][ALEN-1:SLV5_BASE_LSB] == SLV5_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 6) begin: gen_mst_addr_match_6
-                assign mst_addr_match[i][6] = mst_req_addr_2d[i][ALEN-1:SLV6_BASE_LSB] == SLV6_BASE_ADDR;
+                assign mst_addr_hit[i][6] = mst_req_addr_2d[i][ALEN-1:SLV6_BASE_LSB] == SLV6_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 7) begin: gen_mst_addr_match_7
-                assign mst_addr_match[i][7] = mst_req_addr_2d[i][ALEN-1:SLV7_BASE_LSB] == SLV7_BASE_ADDR;
+                assign mst_addr_hit[i][7] = mst_req_addr_2d[i][ALEN-1:SLV7_BASE_LSB] == SLV7_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 8) begin: gen_mst_addr_match_8
-                assign mst_addr_match[i][8] = mst_req_addr_2d[i][ALEN-1:SLV8_BASE_LSB] == SLV8_BASE_ADDR;
+                assign mst_addr_hit[i][8] = mst_req_addr_2d[i][ALEN-1:SLV8_BASE_LSB] == SLV8_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 9) begin: gen_mst_addr_match_9
-                assign mst_addr_match[i][9] = mst_req_addr_2d[i][ALEN-1:SLV9_BASE_LSB] == SLV9_BASE_ADDR;
+                assign mst_addr_hit[i][9] = mst_req_addr_2d[i][ALEN-1:SLV9_BASE_LSB] == SLV9_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 10) begin: gen_mst_addr_match_10
-                assign mst_addr_match[i][10] = mst_req_addr_2d[i][ALEN-1:SLVA_BASE_LSB] == SLVA_BASE_ADDR;
+                assign mst_addr_hit[i][10] = mst_req_addr_2d[i][ALEN-1:SLVA_BASE_LSB] == SLVA_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 11) begin: gen_mst_addr_match_11
-                assign mst_addr_match[i][11] = mst_req_addr_2d[i][ALEN-1:SLVB_BASE_LSB] == SLVB_BASE_ADDR;
+                assign mst_addr_hit[i][11] = mst_req_addr_2d[i][ALEN-1:SLVB_BASE_LSB] == SLVB_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 12) begin: gen_mst_addr_match_12
-                assign mst_addr_match[i][12] = mst_req_addr_2d[i][ALEN-1:SLVC_BASE_LSB] == SLVC_BASE_ADDR;
+                assign mst_addr_hit[i][12] = mst_req_addr_2d[i][ALEN-1:SLVC_BASE_LSB] == SLVC_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 13) begin: gen_mst_addr_match_13
-                assign mst_addr_match[i][13] = mst_req_addr_2d[i][ALEN-1:SLVD_BASE_LSB] == SLVD_BASE_ADDR;
+                assign mst_addr_hit[i][13] = mst_req_addr_2d[i][ALEN-1:SLVD_BASE_LSB] == SLVD_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 14) begin: gen_mst_addr_match_14
-                assign mst_addr_match[i][14] = mst_req_addr_2d[i][ALEN-1:SLVE_BASE_LSB] == SLVE_BASE_ADDR;
+                assign mst_addr_hit[i][14] = mst_req_addr_2d[i][ALEN-1:SLVE_BASE_LSB] == SLVE_BASE_ADDR;
             end
             if (SLV_PORT_NUM > 15) begin: gen_mst_addr_match_15
-                assign mst_addr_match[i][15] = mst_req_addr_2d[i][ALEN-1:SLVF_BASE_LSB] == SLVF_BASE_ADDR;
+                assign mst_addr_hit[i][15] = mst_req_addr_2d[i][ALEN-1:SLVF_BASE_LSB] == SLVF_BASE_ADDR;
             end
+
+            // Keep the lowest hit, if it takes AMOs of the request.
+            assign mst_addr_match[i] = mst_addr_hit[i] & (~(mst_addr_hit[i] - 1'b1))
+                                     & ({SLV_PORT_NUM{~(|mst_req_amo_2d[i])}} | SLV_AMO[SLV_PORT_NUM-1:0]);
+        end
+    endgenerate
+
+    // Check outstanding status of masters.
+    generate
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_ost_stat
+            assign mst_ost_idle[i] = (mst_ost_cnt_r[i] == 0) | ((mst_ost_cnt_r[i] == 1) & mst_rsp_last[i]);
+            assign mst_ost_room[i] = (mst_ost_cnt_r[i] < OST_NUM) | mst_rsp_last[i];
         end
     endgenerate
 
     // Select slave for each master.
+    // A master goes on to the same slave while it has room,
+    // or waits for all responses before switching slaves.
+    // The rest beats of write bursts are routed by the locks.
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_bus_sel_mst
             for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_bus_sel_slv
                 assign mst_sel_to_slv[i][j] = mst_dev_vld[i] & slv_dev_vld[j]
                                             & mst_req_vld[i] & mst_addr_match[i][j]
-                                            & (~mst_arb_grant_r[i][j]
-                                            | (mst_arb_grant_r[i][j] & slv_rsp_fire[j]));
+                                            & (mst_ost_idle[i] | (mst_ost_slv_r[i][j] & mst_ost_room[i]))
+                                            & slv_ost_room[j] & (~mst_wbst[i]);
             end
         end
     endgenerate
@@ -222,10 +332,11 @@ module uv_bus_fab
         end
     endgenerate
 
-    // Detect access fault.
+    // Detect access fault, which is responded in order as well.
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_acc_fault
-            assign mst_acc_fault[i] = mst_dev_vld[i] & mst_req_vld[i] & ~(|mst_addr_match[i]);
+            assign mst_acc_fault[i] = mst_dev_vld[i] & mst_req_vld[i] & ~(|mst_addr_match[i])
+                                    & mst_ost_idle[i];
         end
     endgenerate
 
@@ -248,117 +359,169 @@ module uv_bus_fab
     endgenerate
 
     // Set arbiters requests.
-    //generate
-    //    for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_arb_req
-    //        assign slv_arb_req[i] = slv_sel_to_mst[i];
-    //    end
-    //endgenerate
-
+    // The grant is held until the request is taken by slave,
+    // and the write burst keeps its master till the last beat.
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_arb_req
-            for (j = 0; j < MST_PORT_NUM; j = j + 1) begin: gen_arb_req_mst
-                assign slv_arb_req[i][j] = mst_dev_vld[j] & slv_dev_vld[i]
-                                         & mst_req_vld[j] & mst_addr_match[j][i]
-                                         & (~(|slv_arb_grant_r[i])
-                                         | (|(slv_arb_grant_r[i] & mst_rsp_fire)));
+            assign slv_arb_req[i]   = (slv_wbst_act[i] | (|slv_req_hold_r[i])) ? {MST_PORT_NUM{1'b0}}
+                                    : slv_sel_to_mst[i];
+            assign slv_req_grant[i] = slv_wbst_act[i] ? (slv_wbst_mst_r[i] & mst_req_vld & mst_dev_vld)
+                                    : (|slv_req_hold_r[i]) ? (slv_req_hold_r[i] & slv_sel_to_mst[i])
+                                    : slv_arb_grant[i];
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_hold
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    slv_req_hold_r[i] <= {MST_PORT_NUM{1'b0}};
+                end
+                else begin
+                    if (fab_slv_req_vld[i] & (~fab_slv_req_rdy[i])) begin
+                        slv_req_hold_r[i] <= #UDLY slv_req_grant[i];
+                    end
+                    else begin
+                        slv_req_hold_r[i] <= #UDLY {MST_PORT_NUM{1'b0}};
+                    end
+                end
             end
         end
     endgenerate
 
-    // Transpose arbiter grants for masters.
+    // Lock slaves for the rest beats of write bursts.
     generate
-        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_trans_arb_grant_mst
-            for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_trans_arb_grant_slv
-                assign mst_arb_grant[i][j] = slv_arb_grant[j][i];
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_wbst
+            assign slv_wbst_act[i] = |slv_wbst_cnt_r[i];
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    slv_wbst_cnt_r[i] <= 4'b0;
+                    slv_wbst_mst_r[i] <= {MST_PORT_NUM{1'b0}};
+                end
+                else begin
+                    if (slv_req_fire[i] & slv_wbst_act[i]) begin
+                        slv_wbst_cnt_r[i] <= #UDLY slv_wbst_cnt_r[i] - 1'b1;
+                    end
+                    else if (slv_req_fire[i] & (~fab_slv_req_read[i])) begin
+                        slv_wbst_cnt_r[i] <= #UDLY fab_slv_req_len_2d[i];
+                        slv_wbst_mst_r[i] <= #UDLY slv_req_grant[i];
+                    end
+                end
             end
         end
     endgenerate
 
-    // Buffer grant status for masters.
-    //generate
-    //    for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_arb_grant_buf_mst
-    //        for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_arb_grant_buf_slv
-    //            always @(posedge clk or negedge rst_n) begin
-    //                if (~rst_n) begin
-    //                    mst_arb_grant_r[i][j] <= 1'b0;
-    //                end
-    //                else begin
-    //                    if (mst_arb_grant[i][j]) begin
-    //                        mst_arb_grant_r[i][j] <= #UDLY 1'b1;
-    //                    end
-    //                    else if (mst_arb_grant_r[i][j] & slv_rsp_fire[j]) begin
-    //                        mst_arb_grant_r[i][j] <= #UDLY 1'b0;
-    //                    end
-    //                end
-    //            end
-    //        end
-    //    end
-    //endgenerate
+    generate
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_wbst
+            for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_mst_wbst_slv
+                assign mst_wbst_lck[i][j] = slv_wbst_act[j] & slv_wbst_mst_r[j][i];
+            end
+            assign mst_wbst[i] = |mst_wbst_lck[i];
+        end
+    endgenerate
 
+    // Track outstanding transactions of masters.
     generate
-        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_arb_grant_buf
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_ost
+            assign mst_ost_new[i]  = mst_req_fire[i] & (~mst_wbst[i]);
+            assign mst_rsp_last[i] = mst_rsp_fire[i] & (mst_acc_fault_r[i] | (|(mst_lck_to_slv[i] & slv_rsp_last)));
+
             always @(posedge clk or negedge rst_n) begin
                 if (~rst_n) begin
-                    mst_arb_grant_r[i] <= {SLV_PORT_NUM{1'b0}};
+                    mst_ost_cnt_r[i] <= {OST_CW{1'b0}};
+                    mst_ost_slv_r[i] <= {SLV_PORT_NUM{1'b0}};
                 end
                 else begin
-                    if (|mst_arb_grant[i]) begin
-                        mst_arb_grant_r[i] <= #UDLY mst_arb_grant[i];
+                    if (mst_ost_new[i] & (~mst_rsp_last[i])) begin
+                        mst_ost_cnt_r[i] <= #UDLY mst_ost_cnt_r[i] + 1'b1;
+                    end
+                    else if ((~mst_ost_new[i]) & mst_rsp_last[i]) begin
+                        mst_ost_cnt_r[i] <= #UDLY mst_ost_cnt_r[i] - 1'b1;
                     end
-                    else if (|(mst_arb_grant_r[i] & slv_rsp_fire)) begin
-                        mst_arb_grant_r[i] <= #UDLY {SLV_PORT_NUM{1'b0}};
+
+                    if (mst_ost_new[i]) begin
+                        mst_ost_slv_r[i] <= #UDLY req_lck_to_slv[i];
                     end
                 end
             end
         end
     endgenerate
 
-    // Transpose grant buffer for slaves.
+    // Queue masters in order of requests taken by slaves,
+    // and pop them at the last beats of responses.
     generate
-        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_trans_arb_grant_slv
-            for (j = 0; j < MST_PORT_NUM; j = j + 1) begin: gen_trans_arb_grant_mst
-                always @(*) begin
-                    slv_arb_grant_r[i][j] = mst_arb_grant_r[j][i];
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_ost
+            assign slv_ost_head[i] = {MST_PORT_NUM{slv_ost_cnt_r[i] != 0}}
+                                   & slv_ost_que_r[i][slv_ost_rptr_r[i]*MST_PORT_NUM +: MST_PORT_NUM];
+            assign slv_ost_room[i] = (slv_ost_cnt_r[i] < OST_NUM) | slv_rsp_last[i];
+            assign slv_ost_push[i] = slv_req_fire[i] & (~slv_wbst_act[i]);
+            assign slv_rsp_last[i] = slv_rsp_fire[i]
+                                   & (slv_rsp_cnt_r[i] == slv_ost_len_r[i][slv_ost_rptr_r[i]*4 +: 4]);
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    slv_ost_wptr_r[i] <= {OST_PW{1'b0}};
+                    slv_ost_rptr_r[i] <= {OST_PW{1'b0}};
+                    slv_ost_cnt_r[i]  <= {OST_CW{1'b0}};
+                end
+                else begin
+                    if (slv_ost_push[i]) begin
+                        slv_ost_wptr_r[i] <= #UDLY slv_ost_wptr_r[i] == OST_NUM - 1
+                                           ? {OST_PW{1'b0}} : slv_ost_wptr_r[i] + 1'b1;
+                    end
+
+                    if (slv_rsp_last[i]) begin
+                        slv_ost_rptr_r[i] <= #UDLY slv_ost_rptr_r[i] == OST_NUM - 1
+                                           ? {OST_PW{1'b0}} : slv_ost_rptr_r[i] + 1'b1;
+                    end
+
+                    if (slv_ost_push[i] & (~slv_rsp_last[i])) begin
+                        slv_ost_cnt_r[i] <= #UDLY slv_ost_cnt_r[i] + 1'b1;
+                    end
+                    else if ((~slv_ost_push[i]) & slv_rsp_last[i]) begin
+                        slv_ost_cnt_r[i] <= #UDLY slv_ost_cnt_r[i] - 1'b1;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    slv_rsp_cnt_r[i] <= 4'b0;
+                end
+                else begin
+                    if (slv_rsp_last[i]) begin
+                        slv_rsp_cnt_r[i] <= #UDLY 4'b0;
+                    end
+                    else if (slv_rsp_fire[i]) begin
+                        slv_rsp_cnt_r[i] <= #UDLY slv_rsp_cnt_r[i] + 1'b1;
+                    end
+                end
+            end
+
+            always @(posedge clk) begin
+                if (slv_ost_push[i]) begin
+                    slv_ost_que_r[i][slv_ost_wptr_r[i]*MST_PORT_NUM +: MST_PORT_NUM] <= #UDLY slv_req_grant[i];
+                    slv_ost_len_r[i][slv_ost_wptr_r[i]*4 +: 4] <= #UDLY fab_slv_req_len_2d[i];
                 end
             end
         end
     endgenerate
 
-    //generate
-    //    for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_arb_grant_r
-    //        always @(posedge clk or negedge rst_n) begin
-    //            if (~rst_n) begin
-    //                slv_arb_grant_r[i] <= {MST_PORT_NUM{1'b0}};
-    //            end
-    //            else begin
-    //                if (|slv_arb_grant[i]) begin
-    //                    slv_arb_grant_r[i] <= #UDLY slv_arb_grant[i];
-    //                end
-    //                else if (|(slv_arb_grant_r[i] & mst_rsp_fire)) begin
-    //                    slv_arb_grant_r[i] <= #UDLY {MST_PORT_NUM{1'b0}};
-    //                end
-    //            end
-    //        end
-    //    end
-    //endgenerate
-
     // Lock master-slave pairs.
+    // Requests follow the grants, and responses follow the queue heads.
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_lck
-            //for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_req_lck
-            //    assign req_lck_to_slv[i][j] = mst_arb_grant[i][j]
-            //       | (mst_arb_grant_r[i][j] & (~slv_rsp_fire[j]));
-            //end
-            assign req_lck_to_slv[i] = mst_arb_grant[i]
-               | (mst_arb_grant_r[i] & (~(mst_arb_grant_r[i] & slv_rsp_fire)));
-            assign mst_lck_to_slv[i] = mst_arb_grant_r[i];
+            for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_mst_lck_slv
+                assign req_lck_to_slv[i][j] = slv_req_grant[j][i];
+                assign mst_lck_to_slv[i][j] = slv_ost_head[j][i];
+            end
         end
     endgenerate
 
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_lck
-            //assign slv_lck_to_mst[i] = slv_arb_grant[i] | slv_arb_grant_r[i];
-            assign slv_lck_to_mst[i] = slv_arb_grant_r[i];
+            assign slv_lck_to_mst[i] = slv_ost_head[i];
         end
     endgenerate
 
@@ -385,7 +548,7 @@ module uv_bus_fab
 
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_vld
-            assign slv_req_vld[i] = |slv_req_vld_grt[i];
+            assign fab_slv_req_vld[i] = |slv_req_vld_grt[i];
         end
     endgenerate
 
@@ -411,7 +574,7 @@ module uv_bus_fab
 
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_read
-            assign slv_req_read[i] = |slv_req_read_grt[i];
+            assign fab_slv_req_read[i] = |slv_req_read_grt[i];
         end
     endgenerate
 
@@ -440,7 +603,93 @@ module uv_bus_fab
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_addr
             for (j = 0; j < ALEN; j = j + 1) begin: gen_slv_req_addr_bit
-                assign slv_req_addr_2d[i][j] = |slv_req_addr_grt[i][j];
+                assign fab_slv_req_addr_2d[i][j] = |slv_req_addr_grt[i][j];
+            end
+        end
+    endgenerate
+
+    // Set slv_req_len.
+    wire [3:0]                      mst_req_len_grt [MST_PORT_NUM-1:0][SLV_PORT_NUM-1:0];
+    wire [MST_PORT_NUM-1:0]         slv_req_len_grt [SLV_PORT_NUM-1:0][3:0];
+
+    generate
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_req_len_granted
+            for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_mst_req_len_granted_slv
+                assign mst_req_len_grt[i][j] = ({4{req_lck_to_slv[i][j]}} & mst_req_len_2d[i]);
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_len_granted
+            for (j = 0; j < 4; j = j + 1) begin: gen_slv_req_len_granted_bit
+                for (k = 0; k < MST_PORT_NUM; k = k + 1) begin: gen_slv_req_len_granted_mst
+                    assign slv_req_len_grt[i][j][k] = mst_req_len_grt[k][i][j];
+                end
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_len
+            for (j = 0; j < 4; j = j + 1) begin: gen_slv_req_len_bit
+                assign fab_slv_req_len_2d[i][j] = |slv_req_len_grt[i][j];
+            end
+        end
+    endgenerate
+
+    // Set slv_req_wrap.
+    wire [SLV_PORT_NUM-1:0]         mst_req_wrap_grt [MST_PORT_NUM-1:0];
+    wire [MST_PORT_NUM-1:0]         slv_req_wrap_grt [SLV_PORT_NUM-1:0];
+
+    generate
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_req_wrap_granted
+            for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_mst_req_wrap_granted_slv
+                assign mst_req_wrap_grt[i][j] = req_lck_to_slv[i][j] & mst_req_wrap[i];
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_wrap_granted
+            for (j = 0; j < MST_PORT_NUM; j = j + 1) begin: gen_slv_req_wrap_granted_mst
+                assign slv_req_wrap_grt[i][j] = mst_req_wrap_grt[j][i];
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_wrap
+            assign fab_slv_req_wrap[i] = |slv_req_wrap_grt[i];
+        end
+    endgenerate
+
+    // Set slv_req_amo.
+    wire [3:0]                      mst_req_amo_grt [MST_PORT_NUM-1:0][SLV_PORT_NUM-1:0];
+    wire [MST_PORT_NUM-1:0]         slv_req_amo_grt [SLV_PORT_NUM-1:0][3:0];
+
+    generate
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_req_amo_granted
+            for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_mst_req_amo_granted_slv
+                assign mst_req_amo_grt[i][j] = ({4{req_lck_to_slv[i][j]}} & mst_req_amo_2d[i]);
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_amo_granted
+            for (j = 0; j < 4; j = j + 1) begin: gen_slv_req_amo_granted_bit
+                for (k = 0; k < MST_PORT_NUM; k = k + 1) begin: gen_slv_req_amo_granted_mst
+                    assign slv_req_amo_grt[i][j][k] = mst_req_amo_grt[k][i][j];
+                end
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_amo
+            for (j = 0; j < 4; j = j + 1) begin: gen_slv_req_amo_bit
+                assign fab_slv_req_amo_2d[i][j] = |slv_req_amo_grt[i][j];
             end
         end
     endgenerate
@@ -470,7 +719,7 @@ module uv_bus_fab
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_mask
             for (j = 0; j < MLEN; j = j + 1) begin: gen_slv_req_mask_bit
-                assign slv_req_mask_2d[i][j] = |slv_req_mask_grt[i][j];
+                assign fab_slv_req_mask_2d[i][j] = |slv_req_mask_grt[i][j];
             end
         end
     endgenerate
@@ -500,7 +749,7 @@ module uv_bus_fab
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_data
             for (j = 0; j < DLEN; j = j + 1) begin: gen_slv_req_data_bit
-                assign slv_req_data_2d[i][j] = |slv_req_data_grt[i][j];
+                assign fab_slv_req_data_2d[i][j] = |slv_req_data_grt[i][j];
             end
         end
     endgenerate
@@ -512,7 +761,7 @@ module uv_bus_fab
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_rsp_rdy_granted
             for (j = 0; j < SLV_PORT_NUM; j = j + 1) begin: gen_mst_rsp_rdy_granted_slv
-                assign mst_rsp_rdy_grt[i][j] = slv_lck_to_mst[j][i] & mst_rsp_rdy[i];
+                assign mst_rsp_rdy_grt[i][j] = slv_lck_to_mst[j][i] & fab_mst_rsp_rdy[i];
             end
         end
     endgenerate
@@ -539,7 +788,7 @@ module uv_bus_fab
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_rdy_granted
             for (j = 0; j < MST_PORT_NUM; j = j + 1) begin: gen_slv_req_rdy_granted_mst
-                assign slv_req_rdy_grt[i][j] = req_lck_to_slv[j][i] & slv_req_rdy[i];
+                assign slv_req_rdy_grt[i][j] = req_lck_to_slv[j][i] & fab_slv_req_rdy[i];
             end
         end
     endgenerate
@@ -558,17 +807,17 @@ module uv_bus_fab
         end
     endgenerate
 
-    // Master responses.
+    // Master & slave fires.
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_fire
             assign mst_req_fire[i] = mst_req_vld[i] & mst_req_rdy[i];
-            assign mst_rsp_fire[i] = mst_rsp_vld[i] & mst_rsp_rdy[i];
+            assign mst_rsp_fire[i] = fab_mst_rsp_vld[i] & fab_mst_rsp_rdy[i];
         end
     endgenerate
-    
+
     generate
         for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_fire
-            assign slv_req_fire[i] = slv_req_vld[i] & slv_req_rdy[i];
+            assign slv_req_fire[i] = fab_slv_req_vld[i] & fab_slv_req_rdy[i];
             assign slv_rsp_fire[i] = slv_rsp_vld[i] & slv_rsp_rdy[i];
         end
     endgenerate
@@ -595,7 +844,7 @@ module uv_bus_fab
 
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_rsp_vld
-            assign mst_rsp_vld[i] = mst_acc_fault_r[i] | (|mst_rsp_vld_grt[i]);
+            assign fab_mst_rsp_vld[i] = mst_acc_fault_r[i] | (|mst_rsp_vld_grt[i]);
         end
     endgenerate
 
@@ -623,8 +872,8 @@ module uv_bus_fab
 
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_rsp_excp
-            assign mst_rsp_excp_2d[i][0] = mst_acc_fault_r[i] ? 1'b1: |mst_rsp_excp_grt[i][0];
-            assign mst_rsp_excp_2d[i][1] = mst_acc_fault_r[i] ? 1'b0: |mst_rsp_excp_grt[i][1];
+            assign fab_mst_rsp_excp_2d[i][0] = mst_acc_fault_r[i] ? 1'b1: |mst_rsp_excp_grt[i][0];
+            assign fab_mst_rsp_excp_2d[i][1] = mst_acc_fault_r[i] ? 1'b0: |mst_rsp_excp_grt[i][1];
         end
     endgenerate
 
@@ -653,7 +902,130 @@ module uv_bus_fab
     generate
         for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_rsp_data
             for (j = 0; j < DLEN; j = j + 1) begin: gen_mst_rsp_data_bit
-                assign mst_rsp_data_2d[i][j] = mst_acc_fault_r[i] ? 1'b0 : |mst_rsp_data_grt[i][j];
+                assign fab_mst_rsp_data_2d[i][j] = mst_acc_fault_r[i] ? 1'b0 : |mst_rsp_data_grt[i][j];
+            end
+        end
+    endgenerate
+
+    // Register slices.
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_slice
+            if (PIPE_STAGE > 0) begin: gen_req_slice
+                uv_reg_slice
+                #(
+                    .DAT_WIDTH          ( REQ_DW            )
+                )
+                u_req_slice
+                (
+                    .clk                ( clk               ),
+                    .rst_n              ( rst_n             ),
+
+                    .in_vld             ( fab_slv_req_vld[i] ),
+                    .in_rdy             ( fab_slv_req_rdy[i] ),
+                    .in_dat             ( {fab_slv_req_read[i], fab_slv_req_addr_2d[i],
+                                           fab_slv_req_len_2d[i], fab_slv_req_wrap[i], fab_slv_req_amo_2d[i],
+                                           fab_slv_req_mask_2d[i], fab_slv_req_data_2d[i]} ),
+
+                    .out_vld            ( pipe_slv_req_vld[i] ),
+                    .out_rdy            ( pipe_slv_req_rdy[i] ),
+                    .out_dat            ( {pipe_slv_req_read[i], pipe_slv_req_addr_2d[i],
+                                           pipe_slv_req_len_2d[i], pipe_slv_req_wrap[i], pipe_slv_req_amo_2d[i],
+                                           pipe_slv_req_mask_2d[i], pipe_slv_req_data_2d[i]} )
+                );
+            end
+            else begin: gen_req_bypass
+                assign pipe_slv_req_vld[i]     = fab_slv_req_vld[i];
+                assign fab_slv_req_rdy[i]      = pipe_slv_req_rdy[i];
+                assign pipe_slv_req_read[i]    = fab_slv_req_read[i];
+                assign pipe_slv_req_addr_2d[i] = fab_slv_req_addr_2d[i];
+                assign pipe_slv_req_len_2d[i]  = fab_slv_req_len_2d[i];
+                assign pipe_slv_req_wrap[i]    = fab_slv_req_wrap[i];
+                assign pipe_slv_req_amo_2d[i]  = fab_slv_req_amo_2d[i];
+                assign pipe_slv_req_mask_2d[i] = fab_slv_req_mask_2d[i];
+                assign pipe_slv_req_data_2d[i] = fab_slv_req_data_2d[i];
+            end
+        end
+    endgenerate
+
+    // Split read bursts for slaves without burst support.
+    generate
+        for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_slv_req_burst
+            if (SLV_BURST[i]) begin: gen_burst_pass
+                assign slv_req_vld[i]      = pipe_slv_req_vld[i];
+                assign pipe_slv_req_rdy[i] = slv_req_rdy[i];
+                assign slv_req_read[i]     = pipe_slv_req_read[i];
+                assign slv_req_addr_2d[i]  = pipe_slv_req_addr_2d[i];
+                assign slv_req_len_2d[i]   = pipe_slv_req_len_2d[i];
+                assign slv_req_wrap[i]     = pipe_slv_req_wrap[i];
+                assign slv_req_amo_2d[i]   = pipe_slv_req_amo_2d[i];
+                assign slv_req_mask_2d[i]  = pipe_slv_req_mask_2d[i];
+                assign slv_req_data_2d[i]  = pipe_slv_req_data_2d[i];
+            end
+            else begin: gen_burst_split
+                uv_bus_burst
+                #(
+                    .ALEN               ( ALEN              ),
+                    .DLEN               ( DLEN              ),
+                    .MLEN               ( MLEN              )
+                )
+                u_burst
+                (
+                    .clk                ( clk               ),
+                    .rst_n              ( rst_n             ),
+
+                    .bst_req_vld        ( pipe_slv_req_vld[i] ),
+                    .bst_req_rdy        ( pipe_slv_req_rdy[i] ),
+                    .bst_req_read       ( pipe_slv_req_read[i] ),
+                    .bst_req_addr       ( pipe_slv_req_addr_2d[i] ),
+                    .bst_req_len        ( pipe_slv_req_len_2d[i] ),
+                    .bst_req_wrap       ( pipe_slv_req_wrap[i] ),
+                    .bst_req_amo        ( pipe_slv_req_amo_2d[i] ),
+                    .bst_req_mask       ( pipe_slv_req_mask_2d[i] ),
+                    .bst_req_data       ( pipe_slv_req_data_2d[i] ),
+
+                    .sgl_req_vld        ( slv_req_vld[i]    ),
+                    .sgl_req_rdy        ( slv_req_rdy[i]    ),
+                    .sgl_req_read       ( slv_req_read[i]   ),
+                    .sgl_req_addr       ( slv_req_addr_2d[i] ),
+                    .sgl_req_amo        ( slv_req_amo_2d[i] ),
+                    .sgl_req_mask       ( slv_req_mask_2d[i] ),
+                    .sgl_req_data       ( slv_req_data_2d[i] ),
+
+                    .bst_busy           (                   )
+                );
+
+                assign slv_req_len_2d[i]  = 4'b0;
+                assign slv_req_wrap[i]    = 1'b0;
+            end
+        end
+    endgenerate
+
+    generate
+        for (i = 0; i < MST_PORT_NUM; i = i + 1) begin: gen_mst_rsp_slice
+            if (PIPE_STAGE > 1) begin: gen_rsp_slice
+                uv_reg_slice
+                #(
+                    .DAT_WIDTH          ( RSP_DW            )
+                )
+                u_rsp_slice
+                (
+                    .clk                ( clk               ),
+                    .rst_n              ( rst_n             ),
+
+                    .in_vld             ( fab_mst_rsp_vld[i] ),
+                    .in_rdy             ( fab_mst_rsp_rdy[i] ),
+                    .in_dat             ( {fab_mst_rsp_excp_2d[i], fab_mst_rsp_data_2d[i]} ),
+
+                    .out_vld            ( mst_rsp_vld[i]    ),
+                    .out_rdy            ( mst_rsp_rdy[i]    ),
+                    .out_dat            ( {mst_rsp_excp_2d[i], mst_rsp_data_2d[i]} )
+                );
+            end
+            else begin: gen_rsp_bypass
+                assign mst_rsp_vld[i]     = fab_mst_rsp_vld[i];
+                assign fab_mst_rsp_rdy[i] = mst_rsp_rdy[i];
+                assign mst_rsp_excp_2d[i] = fab_mst_rsp_excp_2d[i];
+                assign mst_rsp_data_2d[i] = fab_mst_rsp_data_2d[i];
             end
         end
     endgenerate
@@ -665,6 +1037,27 @@ module uv_bus_fab
                 assign slv_arb_grant[i] = slv_arb_req[i];
             end
         end
+        else if (QOS_EN) begin: gen_arb_with_qos
+            for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_arb_inst
+                uv_arb_qos
+                #(
+                    .WIDTH              ( MST_PORT_NUM      ),
+                    .CLS_W              ( 2                 ),
+                    .WGT_W              ( 4                 ),
+                    .LIM_W              ( 8                 )
+                )
+                u_arb
+                (
+                    .clk                ( clk               ),
+                    .rst_n              ( rst_n             ),
+                    .cls                ( mst_qos_cls       ),
+                    .wgt                ( mst_qos_wgt       ),
+                    .lim                ( qos_lim           ),
+                    .req                ( slv_arb_req[i]    ),
+                    .grant              ( slv_arb_grant[i]  )
+                );
+            end
+        end
         else begin: gen_arb_with_more_ports
             for (i = 0; i < SLV_PORT_NUM; i = i + 1) begin: gen_arb_inst
                 uv_arb_rr
@@ -17,6 +17,8 @@ module uv_bus_fab_1x2
     parameter DLEN              = 32,
     parameter MLEN              = DLEN / 8,
     parameter PIPE_STAGE        = 0,
+    parameter OST_NUM           = 1,
+    parameter SLV_AMO           = 2'h3,
     parameter SLV0_BASE_LSB     = 31,
     parameter SLV0_BASE_ADDR    = 1'h0,
     parameter SLV1_BASE_LSB     = 31,
@@ -31,6 +33,7 @@ module uv_bus_fab_1x2
     output                      mst_req_rdy,
     input                       mst_req_read,
     input  [ALEN-1:0]           mst_req_addr,
+    input  [3:0]                mst_req_amo,
     input  [MLEN-1:0]           mst_req_mask,
     input  [DLEN-1:0]           mst_req_data,
 
@@ -44,6 +47,7 @@ module uv_bus_fab_1x2
     input                       slv0_req_rdy,
     output                      slv0_req_read,
     output [ALEN-1:0]           slv0_req_addr,
+    output [3:0]                slv0_req_amo,
     output [MLEN-1:0]           slv0_req_mask,
     output [DLEN-1:0]           slv0_req_data,
 
@@ -57,6 +61,7 @@ module uv_bus_fab_1x2
     input                       slv1_req_rdy,
     output                      slv1_req_read,
     output [ALEN-1:0]           slv1_req_addr,
+    output [3:0]                slv1_req_amo,
     output [MLEN-1:0]           slv1_req_mask,
     output [DLEN-1:0]           slv1_req_data,
 
@@ -74,6 +79,7 @@ module uv_bus_fab_1x2
     wire [SLV_PORT_NUM-1:0]         slv_req_rdy;
     wire [SLV_PORT_NUM-1:0]         slv_req_read;
     wire [SLV_PORT_NUM*ALEN-1:0]    slv_req_addr;
+    wire [SLV_PORT_NUM*4-1:0]       slv_req_amo;
     wire [SLV_PORT_NUM*MLEN-1:0]    slv_req_mask;
     wire [SLV_PORT_NUM*DLEN-1:0]    slv_req_data;
     wire [SLV_PORT_NUM-1:0]         slv_rsp_vld;
@@ -88,6 +94,7 @@ module uv_bus_fab_1x2
     assign {slv1_req_vld , slv0_req_vld } = slv_req_vld ;
     assign {slv1_req_read, slv0_req_read} = slv_req_read;
     assign {slv1_req_addr, slv0_req_addr} = slv_req_addr;
+    assign {slv1_req_amo , slv0_req_amo } = slv_req_amo ;
     assign {slv1_req_mask, slv0_req_mask} = slv_req_mask;
     assign {slv1_req_data, slv0_req_data} = slv_req_data;
     assign {slv1_rsp_rdy , slv0_rsp_rdy } = slv_rsp_rdy ;
@@ -98,6 +105,8 @@ module uv_bus_fab_1x2
         .DLEN                       ( DLEN              ),
         .MLEN                       ( MLEN              ),
         .PIPE_STAGE                 ( PIPE_STAGE        ),
+        .OST_NUM                    ( OST_NUM           ),
+        .SLV_AMO                    ( SLV_AMO           ),
         .MST_PORT_NUM               ( MST_PORT_NUM      ),
         .SLV_PORT_NUM               ( SLV_PORT_NUM      ),
         .SLV0_BASE_LSB              ( SLV0_BASE_LSB     ),
@@ -116,12 +125,18 @@ module uv_bus_fab_1x2
         .mst_req_rdy                ( mst_req_rdy       ),
         .mst_req_read               ( mst_req_read      ),
         .mst_req_addr               ( mst_req_addr      ),
+        .mst_req_len                ( 4'b0              ),
+        .mst_req_wrap               ( 1'b0              ),
+        .mst_req_amo                ( mst_req_amo       ),
         .mst_req_mask               ( mst_req_mask      ),
         .mst_req_data               ( mst_req_data      ),
         .mst_rsp_vld                ( mst_rsp_vld       ),
         .mst_rsp_rdy                ( mst_rsp_rdy       ),
         .mst_rsp_excp               ( mst_rsp_excp      ),
         .mst_rsp_data               ( mst_rsp_data      ),
+        .mst_qos_cls                ( {MST_PORT_NUM*2{1'b0}} ),
+        .mst_qos_wgt                ( {MST_PORT_NUM*4{1'b0}} ),
+        .qos_lim                    ( 8'h0              ),
 
         // Slaves.
         .slv_dev_vld                ( 2'b11             ),
@@ -129,6 +144,9 @@ module uv_bus_fab_1x2
         .slv_req_rdy                ( slv_req_rdy       ),
         .slv_req_read               ( slv_req_read      ),
         .slv_req_addr               ( slv_req_addr      ),
+        .slv_req_len                (                   ),
+        .slv_req_wrap               (                   ),
+        .slv_req_amo                ( slv_req_amo       ),
         .slv_req_mask               ( slv_req_mask      ),
         .slv_req_data               ( slv_req_data      ),
         .slv_rsp_vld                ( slv_rsp_vld       ),
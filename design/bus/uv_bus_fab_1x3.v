@@ -0,0 +1,176 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_bus_fab_1x3
+//
+// Designer: Owen
+//
+// Description:
+//      Bus fabric with 1 master port and 3 slave ports.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_bus_fab_1x3
+#(
+    parameter ALEN              = 32,
+    parameter DLEN              = 32,
+    parameter MLEN              = DLEN / 8,
+    parameter PIPE_STAGE        = 0,
+    parameter OST_NUM           = 1,
+    parameter SLV_AMO           = 3'h7,
+    parameter SLV0_BASE_LSB     = 31,
+    parameter SLV0_BASE_ADDR    = 1'h0,
+    parameter SLV1_BASE_LSB     = 31,
+    parameter SLV1_BASE_ADDR    = 1'h1,
+    parameter SLV2_BASE_LSB     = 31,
+    parameter SLV2_BASE_ADDR    = 1'h1
+)
+(
+    input                       clk,
+    input                       rst_n,
+
+    // Master.
+    input                       mst_req_vld,
+    output                      mst_req_rdy,
+    input                       mst_req_read,
+    input  [ALEN-1:0]           mst_req_addr,
+    input  [3:0]                mst_req_amo,
+    input  [MLEN-1:0]           mst_req_mask,
+    input  [DLEN-1:0]           mst_req_data,
+
+    output                      mst_rsp_vld,
+    input                       mst_rsp_rdy,
+    output [1:0]                mst_rsp_excp,
+    output [DLEN-1:0]           mst_rsp_data,
+
+    // Slave 0.
+    output                      slv0_req_vld,
+    input                       slv0_req_rdy,
+    output                      slv0_req_read,
+    output [ALEN-1:0]           slv0_req_addr,
+    output [3:0]                slv0_req_amo,
+    output [MLEN-1:0]           slv0_req_mask,
+    output [DLEN-1:0]           slv0_req_data,
+
+    input                       slv0_rsp_vld,
+    output                      slv0_rsp_rdy,
+    input  [1:0]                slv0_rsp_excp,
+    input  [DLEN-1:0]           slv0_rsp_data,
+
+    // Slave 1.
+    output                      slv1_req_vld,
+    input                       slv1_req_rdy,
+    output                      slv1_req_read,
+    output [ALEN-1:0]           slv1_req_addr,
+    output [3:0]                slv1_req_amo,
+    output [MLEN-1:0]           slv1_req_mask,
+    output [DLEN-1:0]           slv1_req_data,
+
+    input                       slv1_rsp_vld,
+    output                      slv1_rsp_rdy,
+    input  [1:0]                slv1_rsp_excp,
+    input  [DLEN-1:0]           slv1_rsp_data,
+
+    // Slave 2.
+    output                      slv2_req_vld,
+    input                       slv2_req_rdy,
+    output                      slv2_req_read,
+    output [ALEN-1:0]           slv2_req_addr,
+    output [3:0]                slv2_req_amo,
+    output [MLEN-1:0]           slv2_req_mask,
+    output [DLEN-1:0]           slv2_req_data,
+
+    input                       slv2_rsp_vld,
+    output                      slv2_rsp_rdy,
+    input  [1:0]                slv2_rsp_excp,
+    input  [DLEN-1:0]           slv2_rsp_data
+);
+
+    localparam MST_PORT_NUM         = 1;
+    localparam SLV_PORT_NUM         = 3;
+
+    // 1D slave ports.
+    wire [SLV_PORT_NUM-1:0]         slv_req_vld;
+    wire [SLV_PORT_NUM-1:0]         slv_req_rdy;
+    wire [SLV_PORT_NUM-1:0]         slv_req_read;
+    wire [SLV_PORT_NUM*ALEN-1:0]    slv_req_addr;
+    wire [SLV_PORT_NUM*4-1:0]       slv_req_amo;
+    wire [SLV_PORT_NUM*MLEN-1:0]    slv_req_mask;
+    wire [SLV_PORT_NUM*DLEN-1:0]    slv_req_data;
+    wire [SLV_PORT_NUM-1:0]         slv_rsp_vld;
+    wire [SLV_PORT_NUM-1:0]         slv_rsp_rdy;
+    wire [SLV_PORT_NUM*2-1:0]       slv_rsp_excp;
+    wire [SLV_PORT_NUM*DLEN-1:0]    slv_rsp_data;
+
+    assign slv_req_rdy  = {slv2_req_rdy , slv1_req_rdy , slv0_req_rdy };
+    assign slv_rsp_vld  = {slv2_rsp_vld , slv1_rsp_vld , slv0_rsp_vld };
+    assign slv_rsp_excp = {slv2_rsp_excp, slv1_rsp_excp, slv0_rsp_excp};
+    assign slv_rsp_data = {slv2_rsp_data, slv1_rsp_data, slv0_rsp_data};
+    assign {slv2_req_vld , slv1_req_vld , slv0_req_vld } = slv_req_vld ;
+    assign {slv2_req_read, slv1_req_read, slv0_req_read} = slv_req_read;
+    assign {slv2_req_addr, slv1_req_addr, slv0_req_addr} = slv_req_addr;
+    assign {slv2_req_amo , slv1_req_amo , slv0_req_amo } = slv_req_amo ;
+    assign {slv2_req_mask, slv1_req_mask, slv0_req_mask} = slv_req_mask;
+    assign {slv2_req_data, slv1_req_data, slv0_req_data} = slv_req_data;
+    assign {slv2_rsp_rdy , slv1_rsp_rdy , slv0_rsp_rdy } = slv_rsp_rdy ;
+
+    uv_bus_fab
+    #(
+        .ALEN                       ( ALEN              ),
+        .DLEN                       ( DLEN              ),
+        .MLEN                       ( MLEN              ),
+        .PIPE_STAGE                 ( PIPE_STAGE        ),
+        .OST_NUM                    ( OST_NUM           ),
+        .SLV_AMO                    ( SLV_AMO           ),
+        .MST_PORT_NUM               ( MST_PORT_NUM      ),
+        .SLV_PORT_NUM               ( SLV_PORT_NUM      ),
+        .SLV0_BASE_LSB              ( SLV0_BASE_LSB     ),
+        .SLV0_BASE_ADDR             ( SLV0_BASE_ADDR    ),
+        .SLV1_BASE_LSB              ( SLV1_BASE_LSB     ),
+        .SLV1_BASE_ADDR             ( SLV1_BASE_ADDR    ),
+        .SLV2_BASE_LSB              ( SLV2_BASE_LSB     ),
+        .SLV2_BASE_ADDR             ( SLV2_BASE_ADDR    )
+    )
+    u_bus_fab_gnrl
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        // Masters.
+        .mst_dev_vld                ( 1'b1              ),
+        .mst_req_vld                ( mst_req_vld       ),
+        .mst_req_rdy                ( mst_req_rdy       ),
+        .mst_req_read               ( mst_req_read      ),
+        .mst_req_addr               ( mst_req_addr      ),
+        .mst_req_len                ( 4'b0              ),
+        .mst_req_wrap               ( 1'b0              ),
+        .mst_req_amo                ( mst_req_amo       ),
+        .mst_req_mask               ( mst_req_mask      ),
+        .mst_req_data               ( mst_req_data      ),
+        .mst_rsp_vld                ( mst_rsp_vld       ),
+        .mst_rsp_rdy                ( mst_rsp_rdy       ),
+        .mst_rsp_excp               ( mst_rsp_excp      ),
+        .mst_rsp_data               ( mst_rsp_data      ),
+        .mst_qos_cls                ( {MST_PORT_NUM*2{1'b0}} ),
+        .mst_qos_wgt                ( {MST_PORT_NUM*4{1'b0}} ),
+        .qos_lim                    ( 8'h0              ),
+
+        // Slaves.
+        .slv_dev_vld                ( 3'b111            ),
+        .slv_req_vld                ( slv_req_vld       ),
+        .slv_req_rdy                ( slv_req_rdy       ),
+        .slv_req_read               ( slv_req_read      ),
+        .slv_req_addr               ( slv_req_addr      ),
+        .slv_req_len                (                   ),
+        .slv_req_wrap               (                   ),
+        .slv_req_amo                ( slv_req_amo       ),
+        .slv_req_mask               ( slv_req_mask      ),
+        .slv_req_data               ( slv_req_data      ),
+        .slv_rsp_vld                ( slv_rsp_vld       ),
+        .slv_rsp_rdy                ( slv_rsp_rdy       ),
+        .slv_rsp_excp               ( slv_rsp_excp      ),
+        .slv_rsp_data               ( slv_rsp_data      )
+    );
+
+endmodule
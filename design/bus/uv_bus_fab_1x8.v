@@ -18,6 +18,8 @@ module uv_bus_fab_1x8
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
     parameter PIPE_STAGE            = 0,
+    parameter OST_NUM               = 1,
+    parameter SLV_AMO               = 8'hff,
     parameter SLV0_BASE_LSB         = 28,
     parameter SLV0_BASE_ADDR        = 4'h0,
     parameter SLV1_BASE_LSB         = 28,
@@ -180,6 +182,8 @@ module uv_bus_fab_1x8
         .DLEN                       ( DLEN              ),
         .MLEN                       ( MLEN              ),
         .PIPE_STAGE                 ( PIPE_STAGE        ),
+        .OST_NUM                    ( OST_NUM           ),
+        .SLV_AMO                    ( SLV_AMO           ),
         .MST_PORT_NUM               ( MST_PORT_NUM      ),
         .SLV_PORT_NUM               ( SLV_PORT_NUM      ),
         .SLV0_BASE_LSB              ( SLV0_BASE_LSB     ),
@@ -210,12 +214,18 @@ module uv_bus_fab_1x8
         .mst_req_rdy                ( mst_req_rdy       ),
         .mst_req_read               ( mst_req_read      ),
         .mst_req_addr               ( mst_req_addr      ),
+        .mst_req_len                ( 4'b0              ),
+        .mst_req_wrap               ( 1'b0              ),
+        .mst_req_amo                ( 4'b0              ),
         .mst_req_mask               ( mst_req_mask      ),
         .mst_req_data               ( mst_req_data      ),
         .mst_rsp_vld                ( mst_rsp_vld       ),
         .mst_rsp_rdy                ( mst_rsp_rdy       ),
         .mst_rsp_excp               ( mst_rsp_excp      ),
         .mst_rsp_data               ( mst_rsp_data      ),
+        .mst_qos_cls                ( {MST_PORT_NUM*2{1'b0}} ),
+        .mst_qos_wgt                ( {MST_PORT_NUM*4{1'b0}} ),
+        .qos_lim                    ( 8'h0              ),
 
         // Slaves.
         .slv_dev_vld                ( slv_dev_vld       ),
@@ -223,6 +233,9 @@ module uv_bus_fab_1x8
         .slv_req_rdy                ( slv_req_rdy       ),
         .slv_req_read               ( slv_req_read      ),
         .slv_req_addr               ( slv_req_addr      ),
+        .slv_req_len                (                   ),
+        .slv_req_wrap               (                   ),
+        .slv_req_amo                (                   ),
         .slv_req_mask               ( slv_req_mask      ),
         .slv_req_data               ( slv_req_data      ),
         .slv_rsp_vld                ( slv_rsp_vld       ),
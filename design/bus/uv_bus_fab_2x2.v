@@ -18,6 +18,9 @@ module uv_bus_fab_2x2
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
     parameter PIPE_STAGE            = 0,
+    parameter OST_NUM               = 1,
+    parameter SLV_BURST             = 2'h0,
+    parameter SLV_AMO               = 2'h3,
     parameter SLV0_BASE_LSB         = 28,
     parameter SLV0_BASE_ADDR        = 4'h0,
     parameter SLV1_BASE_LSB         = 28,
@@ -36,6 +39,9 @@ module uv_bus_fab_2x2
     output                          mst0_req_rdy,
     input                           mst0_req_read,
     input  [ALEN-1:0]               mst0_req_addr,
+    input  [3:0]                    mst0_req_len,
+    input                           mst0_req_wrap,
+    input  [3:0]                    mst0_req_amo,
     input  [MLEN-1:0]               mst0_req_mask,
     input  [DLEN-1:0]               mst0_req_data,
     output                          mst0_rsp_vld,
@@ -47,6 +53,9 @@ module uv_bus_fab_2x2
     output                          mst1_req_rdy,
     input                           mst1_req_read,
     input  [ALEN-1:0]               mst1_req_addr,
+    input  [3:0]                    mst1_req_len,
+    input                           mst1_req_wrap,
+    input  [3:0]                    mst1_req_amo,
     input  [MLEN-1:0]               mst1_req_mask,
     input  [DLEN-1:0]               mst1_req_data,
     output                          mst1_rsp_vld,
@@ -59,6 +68,9 @@ module uv_bus_fab_2x2
     input                           slv0_req_rdy,
     output                          slv0_req_read,
     output [ALEN-1:0]               slv0_req_addr,
+    output [3:0]                    slv0_req_len,
+    output                          slv0_req_wrap,
+    output [3:0]                    slv0_req_amo,
     output [MLEN-1:0]               slv0_req_mask,
     output [DLEN-1:0]               slv0_req_data,
     input                           slv0_rsp_vld,
@@ -70,6 +82,9 @@ module uv_bus_fab_2x2
     input                           slv1_req_rdy,
     output                          slv1_req_read,
     output [ALEN-1:0]               slv1_req_addr,
+    output [3:0]                    slv1_req_len,
+    output                          slv1_req_wrap,
+    output [3:0]                    slv1_req_amo,
     output [MLEN-1:0]               slv1_req_mask,
     output [DLEN-1:0]               slv1_req_data,
     input                           slv1_rsp_vld,
@@ -86,6 +101,9 @@ module uv_bus_fab_2x2
     wire [MST_PORT_NUM-1:0]         mst_req_rdy;
     wire [MST_PORT_NUM-1:0]         mst_req_read;
     wire [MST_PORT_NUM*ALEN-1:0]    mst_req_addr;
+    wire [MST_PORT_NUM*4-1:0]       mst_req_len;
+    wire [MST_PORT_NUM-1:0]         mst_req_wrap;
+    wire [MST_PORT_NUM*4-1:0]       mst_req_amo;
     wire [MST_PORT_NUM*MLEN-1:0]    mst_req_mask;
     wire [MST_PORT_NUM*DLEN-1:0]    mst_req_data;
     wire [MST_PORT_NUM-1:0]         mst_rsp_vld;
@@ -98,6 +116,9 @@ module uv_bus_fab_2x2
     wire [SLV_PORT_NUM-1:0]         slv_req_rdy;
     wire [SLV_PORT_NUM-1:0]         slv_req_read;
     wire [SLV_PORT_NUM*ALEN-1:0]    slv_req_addr;
+    wire [SLV_PORT_NUM*4-1:0]       slv_req_len;
+    wire [SLV_PORT_NUM-1:0]         slv_req_wrap;
+    wire [SLV_PORT_NUM*4-1:0]       slv_req_amo;
     wire [SLV_PORT_NUM*MLEN-1:0]    slv_req_mask;
     wire [SLV_PORT_NUM*DLEN-1:0]    slv_req_data;
     wire [SLV_PORT_NUM-1:0]         slv_rsp_vld;
@@ -108,6 +129,9 @@ module uv_bus_fab_2x2
     assign mst_req_vld  = {mst1_req_vld , mst0_req_vld };
     assign mst_req_read = {mst1_req_read, mst0_req_read};
     assign mst_req_addr = {mst1_req_addr, mst0_req_addr};
+    assign mst_req_len  = {mst1_req_len , mst0_req_len };
+    assign mst_req_amo  = {mst1_req_amo , mst0_req_amo };
+    assign mst_req_wrap = {mst1_req_wrap, mst0_req_wrap};
     assign mst_req_mask = {mst1_req_mask, mst0_req_mask};
     assign mst_req_data = {mst1_req_data, mst0_req_data};
     assign mst_rsp_rdy  = {mst1_rsp_rdy , mst0_rsp_rdy };
@@ -123,6 +147,9 @@ module uv_bus_fab_2x2
     assign {slv1_req_vld , slv0_req_vld } = slv_req_vld ;
     assign {slv1_req_read, slv0_req_read} = slv_req_read;
     assign {slv1_req_addr, slv0_req_addr} = slv_req_addr;
+    assign {slv1_req_len , slv0_req_len } = slv_req_len ;
+    assign {slv1_req_amo , slv0_req_amo } = slv_req_amo ;
+    assign {slv1_req_wrap, slv0_req_wrap} = slv_req_wrap;
     assign {slv1_req_mask, slv0_req_mask} = slv_req_mask;
     assign {slv1_req_data, slv0_req_data} = slv_req_data;
     assign {slv1_rsp_rdy , slv0_rsp_rdy } = slv_rsp_rdy ;
@@ -133,6 +160,9 @@ module uv_bus_fab_2x2
         .DLEN                       ( DLEN              ),
         .MLEN                       ( MLEN              ),
         .PIPE_STAGE                 ( PIPE_STAGE        ),
+        .OST_NUM                    ( OST_NUM           ),
+        .SLV_BURST                  ( SLV_BURST         ),
+        .SLV_AMO                    ( SLV_AMO           ),
         .MST_PORT_NUM               ( MST_PORT_NUM      ),
         .SLV_PORT_NUM               ( SLV_PORT_NUM      ),
         .SLV0_BASE_LSB              ( SLV0_BASE_LSB     ),
@@ -151,12 +181,18 @@ module uv_bus_fab_2x2
         .mst_req_rdy                ( mst_req_rdy       ),
         .mst_req_read               ( mst_req_read      ),
         .mst_req_addr               ( mst_req_addr      ),
+        .mst_req_len                ( mst_req_len       ),
+        .mst_req_wrap               ( mst_req_wrap      ),
+        .mst_req_amo                ( mst_req_amo       ),
         .mst_req_mask               ( mst_req_mask      ),
         .mst_req_data               ( mst_req_data      ),
         .mst_rsp_vld                ( mst_rsp_vld       ),
         .mst_rsp_rdy                ( mst_rsp_rdy       ),
         .mst_rsp_excp               ( mst_rsp_excp      ),
         .mst_rsp_data               ( mst_rsp_data      ),
+        .mst_qos_cls                ( {MST_PORT_NUM*2{1'b0}} ),
+        .mst_qos_wgt                ( {MST_PORT_NUM*4{1'b0}} ),
+        .qos_lim                    ( 8'h0              ),
 
         // Slaves.
         .slv_dev_vld                ( slv_dev_vld       ),
@@ -164,6 +200,9 @@ module uv_bus_fab_2x2
         .slv_req_rdy                ( slv_req_rdy       ),
         .slv_req_read               ( slv_req_read      ),
         .slv_req_addr               ( slv_req_addr      ),
+        .slv_req_len                ( slv_req_len       ),
+        .slv_req_wrap               ( slv_req_wrap      ),
+        .slv_req_amo                ( slv_req_amo       ),
         .slv_req_mask               ( slv_req_mask      ),
         .slv_req_data               ( slv_req_data      ),
         .slv_rsp_vld                ( slv_rsp_vld       ),
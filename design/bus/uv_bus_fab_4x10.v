@@ -1,23 +1,28 @@
 //************************************************************
 // See LICENSE for license details.
 //
-// Module: uv_bus_fab_4x8
+// Module: uv_bus_fab_4x10
 //
 // Designer: Owen
 //
 // Description:
-//      Bus fabric with 4 master ports and 8 slave ports.
+//      Bus fabric with 4 master ports and 10 slave ports.
 //      Generated by general bus fabric.
+//      Slaves arbitrate by the QoS of masters with QOS_EN.
 //************************************************************
 
 `timescale 1ns / 1ps
 
-module uv_bus_fab_4x8
+module uv_bus_fab_4x10
 #(
     parameter ALEN                  = 32,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
     parameter PIPE_STAGE            = 0,
+    parameter OST_NUM               = 1,
+    parameter SLV_BURST             = 10'h0,
+    parameter SLV_AMO               = 10'h3ff,
+    parameter QOS_EN                = 1'b0,
     parameter SLV0_BASE_LSB         = 28,
     parameter SLV0_BASE_ADDR        = 4'h0,
     parameter SLV1_BASE_LSB         = 28,
@@ -33,7 +38,11 @@ module uv_bus_fab_4x8
     parameter SLV6_BASE_LSB         = 28,
     parameter SLV6_BASE_ADDR        = 4'h6,
     parameter SLV7_BASE_LSB         = 28,
-    parameter SLV7_BASE_ADDR        = 4'h7
+    parameter SLV7_BASE_ADDR        = 4'h7,
+    parameter SLV8_BASE_LSB         = 28,
+    parameter SLV8_BASE_ADDR        = 4'h8,
+    parameter SLV9_BASE_LSB         = 28,
+    parameter SLV9_BASE_ADDR        = 4'h9
 )
 (
     input                           clk,
@@ -41,13 +50,21 @@ module uv_bus_fab_4x8
 
     // Device enabling.
     input  [3:0]                    mst_dev_vld,
-    input  [7:0]                    slv_dev_vld,
+    input  [9:0]                    slv_dev_vld,
+
+    // QoS of masters: 2-bit class & 4-bit weight of each, and starvation limit.
+    input  [7:0]                    mst_qos_cls,
+    input  [15:0]                   mst_qos_wgt,
+    input  [7:0]                    qos_lim,
 
     // Masters.
     input                           mst0_req_vld,
     output                          mst0_req_rdy,
     input                           mst0_req_read,
     input  [ALEN-1:0]               mst0_req_addr,
+    input  [3:0]                    mst0_req_len,
+    input                           mst0_req_wrap,
+    input  [3:0]                    mst0_req_amo,
     input  [MLEN-1:0]               mst0_req_mask,
     input  [DLEN-1:0]               mst0_req_data,
     output                          mst0_rsp_vld,
@@ -59,6 +76,9 @@ module uv_bus_fab_4x8
     output                          mst1_req_rdy,
     input                           mst1_req_read,
     input  [ALEN-1:0]               mst1_req_addr,
+    input  [3:0]                    mst1_req_len,
+    input                           mst1_req_wrap,
+    input  [3:0]                    mst1_req_amo,
     input  [MLEN-1:0]               mst1_req_mask,
     input  [DLEN-1:0]               mst1_req_data,
     output                          mst1_rsp_vld,
@@ -70,6 +90,9 @@ module uv_bus_fab_4x8
     output                          mst2_req_rdy,
     input                           mst2_req_read,
     input  [ALEN-1:0]               mst2_req_addr,
+    input  [3:0]                    mst2_req_len,
+    input                           mst2_req_wrap,
+    input  [3:0]                    mst2_req_amo,
     input  [MLEN-1:0]               mst2_req_mask,
     input  [DLEN-1:0]               mst2_req_data,
     output                          mst2_rsp_vld,
@@ -81,6 +104,9 @@ module uv_bus_fab_4x8
     output                          mst3_req_rdy,
     input                           mst3_req_read,
     input  [ALEN-1:0]               mst3_req_addr,
+    input  [3:0]                    mst3_req_len,
+    input                           mst3_req_wrap,
+    input  [3:0]                    mst3_req_amo,
     input  [MLEN-1:0]               mst3_req_mask,
     input  [DLEN-1:0]               mst3_req_data,
     output                          mst3_rsp_vld,
@@ -93,6 +119,9 @@ module uv_bus_fab_4x8
     input                           slv0_req_rdy,
     output                          slv0_req_read,
     output [ALEN-1:0]               slv0_req_addr,
+    output [3:0]                    slv0_req_len,
+    output                          slv0_req_wrap,
+    output [3:0]                    slv0_req_amo,
     output [MLEN-1:0]               slv0_req_mask,
     output [DLEN-1:0]               slv0_req_data,
     input                           slv0_rsp_vld,
@@ -104,6 +133,9 @@ module uv_bus_fab_4x8
     input                           slv1_req_rdy,
     output                          slv1_req_read,
     output [ALEN-1:0]               slv1_req_addr,
+    output [3:0]                    slv1_req_len,
+    output                          slv1_req_wrap,
+    output [3:0]                    slv1_req_amo,
     output [MLEN-1:0]               slv1_req_mask,
     output [DLEN-1:0]               slv1_req_data,
     input                           slv1_rsp_vld,
@@ -115,6 +147,9 @@ module uv_bus_fab_4x8
     input                           slv2_req_rdy,
     output                          slv2_req_read,
     output [ALEN-1:0]               slv2_req_addr,
+    output [3:0]                    slv2_req_len,
+    output                          slv2_req_wrap,
+    output [3:0]                    slv2_req_amo,
     output [MLEN-1:0]               slv2_req_mask,
     output [DLEN-1:0]               slv2_req_data,
     input                           slv2_rsp_vld,
@@ -126,6 +161,9 @@ module uv_bus_fab_4x8
     input                           slv3_req_rdy,
     output                          slv3_req_read,
     output [ALEN-1:0]               slv3_req_addr,
+    output [3:0]                    slv3_req_len,
+    output                          slv3_req_wrap,
+    output [3:0]                    slv3_req_amo,
     output [MLEN-1:0]               slv3_req_mask,
     output [DLEN-1:0]               slv3_req_data,
     input                           slv3_rsp_vld,
@@ -137,6 +175,9 @@ module uv_bus_fab_4x8
     input                           slv4_req_rdy,
     output                          slv4_req_read,
     output [ALEN-1:0]               slv4_req_addr,
+    output [3:0]                    slv4_req_len,
+    output                          slv4_req_wrap,
+    output [3:0]                    slv4_req_amo,
     output [MLEN-1:0]               slv4_req_mask,
     output [DLEN-1:0]               slv4_req_data,
     input                           slv4_rsp_vld,
@@ -148,6 +189,9 @@ module uv_bus_fab_4x8
     input                           slv5_req_rdy,
     output                          slv5_req_read,
     output [ALEN-1:0]               slv5_req_addr,
+    output [3:0]                    slv5_req_len,
+    output                          slv5_req_wrap,
+    output [3:0]                    slv5_req_amo,
     output [MLEN-1:0]               slv5_req_mask,
     output [DLEN-1:0]               slv5_req_data,
     input                           slv5_rsp_vld,
@@ -159,6 +203,9 @@ module uv_bus_fab_4x8
     input                           slv6_req_rdy,
     output                          slv6_req_read,
     output [ALEN-1:0]               slv6_req_addr,
+    output [3:0]                    slv6_req_len,
+    output                          slv6_req_wrap,
+    output [3:0]                    slv6_req_amo,
     output [MLEN-1:0]               slv6_req_mask,
     output [DLEN-1:0]               slv6_req_data,
     input                           slv6_rsp_vld,
@@ -170,22 +217,56 @@ module uv_bus_fab_4x8
     input                           slv7_req_rdy,
     output                          slv7_req_read,
     output [ALEN-1:0]               slv7_req_addr,
+    output [3:0]                    slv7_req_len,
+    output                          slv7_req_wrap,
+    output [3:0]                    slv7_req_amo,
     output [MLEN-1:0]               slv7_req_mask,
     output [DLEN-1:0]               slv7_req_data,
     input                           slv7_rsp_vld,
     output                          slv7_rsp_rdy,
     input  [1:0]                    slv7_rsp_excp,
-    input  [DLEN-1:0]               slv7_rsp_data
+    input  [DLEN-1:0]               slv7_rsp_data,
+
+    output                          slv8_req_vld,
+    input                           slv8_req_rdy,
+    output                          slv8_req_read,
+    output [ALEN-1:0]               slv8_req_addr,
+    output [3:0]                    slv8_req_len,
+    output                          slv8_req_wrap,
+    output [3:0]                    slv8_req_amo,
+    output [MLEN-1:0]               slv8_req_mask,
+    output [DLEN-1:0]               slv8_req_data,
+    input                           slv8_rsp_vld,
+    output                          slv8_rsp_rdy,
+    input  [1:0]                    slv8_rsp_excp,
+    input  [DLEN-1:0]               slv8_rsp_data,
+
+    output                          slv9_req_vld,
+    input                           slv9_req_rdy,
+    output                          slv9_req_read,
+    output [ALEN-1:0]               slv9_req_addr,
+    output [3:0]                    slv9_req_len,
+    output                          slv9_req_wrap,
+    output [3:0]                    slv9_req_amo,
+    output [MLEN-1:0]               slv9_req_mask,
+    output [DLEN-1:0]               slv9_req_data,
+    input                           slv9_rsp_vld,
+    output                          slv9_rsp_rdy,
+    input  [1:0]                    slv9_rsp_excp,
+    input  [DLEN-1:0]               slv9_rsp_data
 );
 
     localparam MST_PORT_NUM         = 4;
-    localparam SLV_PORT_NUM         = 8;
+    localparam SLV_PORT_NUM         = 10;
 
     // 1D master ports.
     wire [MST_PORT_NUM-1:0]         mst_req_vld;
     wire [MST_PORT_NUM-1:0]         mst_req_rdy;
     wire [MST_PORT_NUM-1:0]         mst_req_read;
     wire [MST_PORT_NUM*ALEN-1:0]    mst_req_addr;
+    wire [MST_PORT_NUM*4-1:0]       mst_req_len;
+    wire [MST_PORT_NUM-1:0]         mst_req_wrap;
+    wire [MST_PORT_NUM*4-1:0]       mst_req_amo;
     wire [MST_PORT_NUM*MLEN-1:0]    mst_req_mask;
     wire [MST_PORT_NUM*DLEN-1:0]    mst_req_data;
     wire [MST_PORT_NUM-1:0]         mst_rsp_vld;
@@ -198,6 +279,9 @@ module uv_bus_fab_4x8
     wire [SLV_PORT_NUM-1:0]         slv_req_rdy;
     wire [SLV_PORT_NUM-1:0]         slv_req_read;
     wire [SLV_PORT_NUM*ALEN-1:0]    slv_req_addr;
+    wire [SLV_PORT_NUM*4-1:0]       slv_req_len;
+    wire [SLV_PORT_NUM-1:0]         slv_req_wrap;
+    wire [SLV_PORT_NUM*4-1:0]       slv_req_amo;
     wire [SLV_PORT_NUM*MLEN-1:0]    slv_req_mask;
     wire [SLV_PORT_NUM*DLEN-1:0]    slv_req_data;
     wire [SLV_PORT_NUM-1:0]         slv_rsp_vld;
@@ -208,6 +292,9 @@ module uv_bus_fab_4x8
     assign mst_req_vld  = {mst3_req_vld , mst2_req_vld , mst1_req_vld , mst0_req_vld };
     assign mst_req_read = {mst3_req_read, mst2_req_read, mst1_req_read, mst0_req_read};
     assign mst_req_addr = {mst3_req_addr, mst2_req_addr, mst1_req_addr, mst0_req_addr};
+    assign mst_req_len  = {mst3_req_len , mst2_req_len , mst1_req_len , mst0_req_len };
+    assign mst_req_amo  = {mst3_req_amo , mst2_req_amo , mst1_req_amo , mst0_req_amo };
+    assign mst_req_wrap = {mst3_req_wrap, mst2_req_wrap, mst1_req_wrap, mst0_req_wrap};
     assign mst_req_mask = {mst3_req_mask, mst2_req_mask, mst1_req_mask, mst0_req_mask};
     assign mst_req_data = {mst3_req_data, mst2_req_data, mst1_req_data, mst0_req_data};
     assign mst_rsp_rdy  = {mst3_rsp_rdy , mst2_rsp_rdy , mst1_rsp_rdy , mst0_rsp_rdy };
@@ -216,16 +303,19 @@ module uv_bus_fab_4x8
     assign {mst3_rsp_excp, mst2_rsp_excp, mst1_rsp_excp, mst0_rsp_excp} = mst_rsp_excp;
     assign {mst3_rsp_data, mst2_rsp_data, mst1_rsp_data, mst0_rsp_data} = mst_rsp_data;
 
-    assign slv_req_rdy  = {slv7_req_rdy , slv6_req_rdy , slv5_req_rdy , slv4_req_rdy , slv3_req_rdy , slv2_req_rdy , slv1_req_rdy , slv0_req_rdy };
-    assign slv_rsp_vld  = {slv7_rsp_vld , slv6_rsp_vld , slv5_rsp_vld , slv4_rsp_vld , slv3_rsp_vld , slv2_rsp_vld , slv1_rsp_vld , slv0_rsp_vld };
-    assign slv_rsp_excp = {slv7_rsp_excp, slv6_rsp_excp, slv5_rsp_excp, slv4_rsp_excp, slv3_rsp_excp, slv2_rsp_excp, slv1_rsp_excp, slv0_rsp_excp};
-    assign slv_rsp_data = {slv7_rsp_data, slv6_rsp_data, slv5_rsp_data, slv4_rsp_data, slv3_rsp_data, slv2_rsp_data, slv1_rsp_data, slv0_rsp_data};
-    assign {slv7_req_vld , slv6_req_vld , slv5_req_vld , slv4_req_vld , slv3_req_vld , slv2_req_vld , slv1_req_vld , slv0_req_vld } = slv_req_vld ;
-    assign {slv7_req_read, slv6_req_read, slv5_req_read, slv4_req_read, slv3_req_read, slv2_req_read, slv1_req_read, slv0_req_read} = slv_req_read;
-    assign {slv7_req_addr, slv6_req_addr, slv5_req_addr, slv4_req_addr, slv3_req_addr, slv2_req_addr, slv1_req_addr, slv0_req_addr} = slv_req_addr;
-    assign {slv7_req_mask, slv6_req_mask, slv5_req_mask, slv4_req_mask, slv3_req_mask, slv2_req_mask, slv1_req_mask, slv0_req_mask} = slv_req_mask;
-    assign {slv7_req_data, slv6_req_data, slv5_req_data, slv4_req_data, slv3_req_data, slv2_req_data, slv1_req_data, slv0_req_data} = slv_req_data;
-    assign {slv7_rsp_rdy , slv6_rsp_rdy , slv5_rsp_rdy , slv4_rsp_rdy , slv3_rsp_rdy , slv2_rsp_rdy , slv1_rsp_rdy , slv0_rsp_rdy } = slv_rsp_rdy ;
+    assign slv_req_rdy  = {slv9_req_rdy , slv8_req_rdy , slv7_req_rdy , slv6_req_rdy , slv5_req_rdy , slv4_req_rdy , slv3_req_rdy , slv2_req_rdy , slv1_req_rdy , slv0_req_rdy };
+    assign slv_rsp_vld  = {slv9_rsp_vld , slv8_rsp_vld , slv7_rsp_vld , slv6_rsp_vld , slv5_rsp_vld , slv4_rsp_vld , slv3_rsp_vld , slv2_rsp_vld , slv1_rsp_vld , slv0_rsp_vld };
+    assign slv_rsp_excp = {slv9_rsp_excp, slv8_rsp_excp, slv7_rsp_excp, slv6_rsp_excp, slv5_rsp_excp, slv4_rsp_excp, slv3_rsp_excp, slv2_rsp_excp, slv1_rsp_excp, slv0_rsp_excp};
+    assign slv_rsp_data = {slv9_rsp_data, slv8_rsp_data, slv7_rsp_data, slv6_rsp_data, slv5_rsp_data, slv4_rsp_data, slv3_rsp_data, slv2_rsp_data, slv1_rsp_data, slv0_rsp_data};
+    assign {slv9_req_vld , slv8_req_vld , slv7_req_vld , slv6_req_vld , slv5_req_vld , slv4_req_vld , slv3_req_vld , slv2_req_vld , slv1_req_vld , slv0_req_vld } = slv_req_vld ;
+    assign {slv9_req_read, slv8_req_read, slv7_req_read, slv6_req_read, slv5_req_read, slv4_req_read, slv3_req_read, slv2_req_read, slv1_req_read, slv0_req_read} = slv_req_read;
+    assign {slv9_req_addr, slv8_req_addr, slv7_req_addr, slv6_req_addr, slv5_req_addr, slv4_req_addr, slv3_req_addr, slv2_req_addr, slv1_req_addr, slv0_req_addr} = slv_req_addr;
+    assign {slv9_req_len , slv8_req_len , slv7_req_len , slv6_req_len , slv5_req_len , slv4_req_len , slv3_req_len , slv2_req_len , slv1_req_len , slv0_req_len } = slv_req_len ;
+    assign {slv9_req_amo , slv8_req_amo , slv7_req_amo , slv6_req_amo , slv5_req_amo , slv4_req_amo , slv3_req_amo , slv2_req_amo , slv1_req_amo , slv0_req_amo } = slv_req_amo ;
+    assign {slv9_req_wrap, slv8_req_wrap, slv7_req_wrap, slv6_req_wrap, slv5_req_wrap, slv4_req_wrap, slv3_req_wrap, slv2_req_wrap, slv1_req_wrap, slv0_req_wrap} = slv_req_wrap;
+    assign {slv9_req_mask, slv8_req_mask, slv7_req_mask, slv6_req_mask, slv5_req_mask, slv4_req_mask, slv3_req_mask, slv2_req_mask, slv1_req_mask, slv0_req_mask} = slv_req_mask;
+    assign {slv9_req_data, slv8_req_data, slv7_req_data, slv6_req_data, slv5_req_data, slv4_req_data, slv3_req_data, slv2_req_data, slv1_req_data, slv0_req_data} = slv_req_data;
+    assign {slv9_rsp_rdy , slv8_rsp_rdy , slv7_rsp_rdy , slv6_rsp_rdy , slv5_rsp_rdy , slv4_rsp_rdy , slv3_rsp_rdy , slv2_rsp_rdy , slv1_rsp_rdy , slv0_rsp_rdy } = slv_rsp_rdy ;
 
     uv_bus_fab
     #(
@@ -233,6 +323,10 @@ module uv_bus_fab_4x8
         .DLEN                       ( DLEN              ),
         .MLEN                       ( MLEN              ),
         .PIPE_STAGE                 ( PIPE_STAGE        ),
+        .OST_NUM                    ( OST_NUM           ),
+        .SLV_BURST                  ( SLV_BURST         ),
+        .SLV_AMO                    ( SLV_AMO           ),
+        .QOS_EN                     ( QOS_EN            ),
         .MST_PORT_NUM               ( MST_PORT_NUM      ),
         .SLV_PORT_NUM               ( SLV_PORT_NUM      ),
         .SLV0_BASE_LSB              ( SLV0_BASE_LSB     ),
@@ -250,7 +344,11 @@ module uv_bus_fab_4x8
         .SLV6_BASE_LSB              ( SLV6_BASE_LSB     ),
         .SLV6_BASE_ADDR             ( SLV6_BASE_ADDR    ),
         .SLV7_BASE_LSB              ( SLV7_BASE_LSB     ),
-        .SLV7_BASE_ADDR             ( SLV7_BASE_ADDR    )
+        .SLV7_BASE_ADDR             ( SLV7_BASE_ADDR    ),
+        .SLV8_BASE_LSB              ( SLV8_BASE_LSB     ),
+        .SLV8_BASE_ADDR             ( SLV8_BASE_ADDR    ),
+        .SLV9_BASE_LSB              ( SLV9_BASE_LSB     ),
+        .SLV9_BASE_ADDR             ( SLV9_BASE_ADDR    )
     )
     u_bus_fab_gnrl
     (
@@ -263,12 +361,18 @@ module uv_bus_fab_4x8
         .mst_req_rdy                ( mst_req_rdy       ),
         .mst_req_read               ( mst_req_read      ),
         .mst_req_addr               ( mst_req_addr      ),
+        .mst_req_len                ( mst_req_len       ),
+        .mst_req_wrap               ( mst_req_wrap      ),
+        .mst_req_amo                ( mst_req_amo       ),
         .mst_req_mask               ( mst_req_mask      ),
         .mst_req_data               ( mst_req_data      ),
         .mst_rsp_vld                ( mst_rsp_vld       ),
         .mst_rsp_rdy                ( mst_rsp_rdy       ),
         .mst_rsp_excp               ( mst_rsp_excp      ),
         .mst_rsp_data               ( mst_rsp_data      ),
+        .mst_qos_cls                ( mst_qos_cls       ),
+        .mst_qos_wgt                ( mst_qos_wgt       ),
+        .qos_lim                    ( qos_lim           ),
 
         // Slaves.
         .slv_dev_vld                ( slv_dev_vld       ),
@@ -276,6 +380,9 @@ module uv_bus_fab_4x8
         .slv_req_rdy                ( slv_req_rdy       ),
         .slv_req_read               ( slv_req_read      ),
         .slv_req_addr               ( slv_req_addr      ),
+        .slv_req_len                ( slv_req_len       ),
+        .slv_req_wrap               ( slv_req_wrap      ),
+        .slv_req_amo                ( slv_req_amo       ),
         .slv_req_mask               ( slv_req_mask      ),
         .slv_req_data               ( slv_req_data      ),
         .slv_rsp_vld                ( slv_rsp_vld       ),
@@ -7,6 +7,10 @@
 //
 // Description:
 //      Transform interface from bus to AHB.
+//      Bursts of 4, 8 or 16 beats are issued as INCRx/WRAPx,
+//      other INCR bursts as undefined-length INCR, and WRAP
+//      bursts of 2 beats as singles. Read bursts are expanded
+//      to beats here, while write beats come from the bus.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -27,6 +31,8 @@ module uv_bus_to_ahb
     output                          bus_req_rdy,
     input                           bus_req_read,
     input  [ALEN-1:0]               bus_req_addr,
+    input  [3:0]                    bus_req_len,
+    input                           bus_req_wrap,
     input  [MLEN-1:0]               bus_req_mask,
     input  [DLEN-1:0]               bus_req_data,
 
@@ -51,8 +57,31 @@ module uv_bus_to_ahb
 );
 
     localparam UDLY = 1;
-    
+
+    localparam HTRANS_IDLE          = 2'b00;
+    localparam HTRANS_NONSEQ        = 2'b10;
+    localparam HTRANS_SEQ           = 2'b11;
+
+    // Beats after expanding.
+    wire                            sgl_req_vld;
+    wire                            sgl_req_rdy;
+    wire                            sgl_req_read;
+    wire [ALEN-1:0]                 sgl_req_addr;
+    wire [MLEN-1:0]                 sgl_req_mask;
+    wire [DLEN-1:0]                 sgl_req_data;
+    wire                            sgl_req_fire;
+
+    reg  [3:0]                      bst_rem_r;
+    reg  [2:0]                      bst_hburst_r;
+    reg                             bst_seq_r;
+    reg  [2:0]                      bst_hburst;
+    wire                            bst_first;
+    wire                            sgl_req_seq;
+    wire [2:0]                      sgl_req_hburst;
+
     reg                             req_vld_r;
+    reg                             req_seq_r;
+    reg  [2:0]                      req_hburst_r;
     reg                             req_read_r;
     reg  [ALEN-1:0]                 req_addr_r;
     reg  [MLEN-1:0]                 req_mask_r;
@@ -69,8 +98,78 @@ module uv_bus_to_ahb
 
     assign ahb_okay                 = ahb_busy_r & ahb_hreadyout;
 
+    uv_bus_burst
+    #(
+        .ALEN                       ( ALEN              ),
+        .DLEN                       ( DLEN              ),
+        .MLEN                       ( MLEN              )
+    )
+    u_burst
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .bst_req_vld                ( bus_req_vld       ),
+        .bst_req_rdy                ( bus_req_rdy       ),
+        .bst_req_read               ( bus_req_read      ),
+        .bst_req_addr               ( bus_req_addr      ),
+        .bst_req_len                ( bus_req_len       ),
+        .bst_req_wrap               ( bus_req_wrap      ),
+        .bst_req_amo                ( 4'b0              ),
+        .bst_req_mask               ( bus_req_mask      ),
+        .bst_req_data               ( bus_req_data      ),
+
+        .sgl_req_vld                ( sgl_req_vld       ),
+        .sgl_req_rdy                ( sgl_req_rdy       ),
+        .sgl_req_read               ( sgl_req_read      ),
+        .sgl_req_addr               ( sgl_req_addr      ),
+        .sgl_req_amo                (                   ),
+        .sgl_req_mask               ( sgl_req_mask      ),
+        .sgl_req_data               ( sgl_req_data      ),
+
+        .bst_busy                   (                   )
+    );
+
+    assign sgl_req_rdy              = ~(ahb_busy_r & (~ahb_hreadyout));
+    assign sgl_req_fire             = sgl_req_vld & sgl_req_rdy;
+
+    // The first beat carries the burst attributes.
+    assign bst_first                = bst_rem_r == 4'd0;
+    assign sgl_req_seq              = (~bst_first) & bst_seq_r;
+    assign sgl_req_hburst           = bst_first ? bst_hburst : bst_hburst_r;
+
+    always @(*) begin
+        case (bus_req_len)
+            4'd0   : bst_hburst = 3'b000;
+            4'd1   : bst_hburst = bus_req_wrap ? 3'b000 : 3'b001;
+            4'd3   : bst_hburst = bus_req_wrap ? 3'b010 : 3'b011;
+            4'd7   : bst_hburst = bus_req_wrap ? 3'b100 : 3'b101;
+            4'd15  : bst_hburst = bus_req_wrap ? 3'b110 : 3'b111;
+            default: bst_hburst = 3'b001;
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            bst_rem_r    <= 4'd0;
+            bst_hburst_r <= 3'b000;
+            bst_seq_r    <= 1'b0;
+        end
+        else begin
+            if (sgl_req_fire) begin
+                if (bst_first) begin
+                    bst_rem_r    <= #UDLY bus_req_len;
+                    bst_hburst_r <= #UDLY bst_hburst;
+                    bst_seq_r    <= #UDLY bst_hburst != 3'b000;
+                end
+                else begin
+                    bst_rem_r    <= #UDLY bst_rem_r - 1'b1;
+                end
+            end
+        end
+    end
+
     // Bus output.
-    assign bus_req_rdy              = ~(ahb_busy_r & (~ahb_hreadyout));
     assign bus_rsp_vld              = ahb_okay | rsp_vld_r;
     assign bus_rsp_excp             = ahb_okay ? {1'b0, ahb_hresp} : {1'b0, rsp_excp_r};
     assign bus_rsp_data             = ahb_okay ? ahb_hrdata : rsp_data_r;
@@ -78,8 +177,10 @@ module uv_bus_to_ahb
     // AHB output.
     assign ahb_hsel                 = req_vld_r;
     assign ahb_haddr                = req_addr_r;
-    assign ahb_hburst               = 3'b000;
-    assign ahb_htrans               = req_vld_r ? 2'b10 : 2'b00;
+    assign ahb_hburst               = req_hburst_r;
+    assign ahb_htrans               = ~req_vld_r ? HTRANS_IDLE
+                                    : req_seq_r  ? HTRANS_SEQ
+                                    : HTRANS_NONSEQ;
     assign ahb_hsize                = ahb_hsize_t;
     assign ahb_hprot                = 4'b0011;
     assign ahb_hmastlock            = 1'b0;
@@ -94,12 +195,12 @@ module uv_bus_to_ahb
         end
         else begin
             if (ahb_okay & (~bus_rsp_rdy)) begin
-                rsp_vld_r  <= #ULDY 1'b1;
-                rsp_excp_r <= #ULDY ahb_hresp;
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY ahb_hresp;
             end
             else if (bus_rsp_vld & bus_rsp_rdy) begin
-                rsp_vld_r  <= #ULDY 1'b0;
-                rsp_excp_r <= #ULDY 1'b0;
+                rsp_vld_r  <= #UDLY 1'b0;
+                rsp_excp_r <= #UDLY 1'b0;
             end
         end
     end
@@ -110,7 +211,7 @@ module uv_bus_to_ahb
         end
         else begin
             if (ahb_okay) begin
-                rsp_data_r <= #ULDY ahb_hrdata;
+                rsp_data_r <= #UDLY ahb_hrdata;
             end
         end
     end
@@ -120,28 +221,34 @@ module uv_bus_to_ahb
         if (PIPE) begin: gen_bus_req_pipe
             always @(posedge clk or negedge rst_n) begin
                 if (~rst_n) begin
-                    req_vld_r  <= 1'b0;
-                    req_read_r <= 1'b0;
-                    req_addr_r <= {ALEN{1'b0}};
-                    req_mask_r <= {MLEN{1'b0}};
-                    req_data_r <= {DLEN{1'b0}};
+                    req_vld_r    <= 1'b0;
+                    req_seq_r    <= 1'b0;
+                    req_hburst_r <= 3'b000;
+                    req_read_r   <= 1'b0;
+                    req_addr_r   <= {ALEN{1'b0}};
+                    req_mask_r   <= {MLEN{1'b0}};
+                    req_data_r   <= {DLEN{1'b0}};
                 end
                 else begin
-                    req_vld_r  <= #UDLY bus_req_vld;
-                    req_read_r <= #UDLY bus_req_read;
-                    req_addr_r <= #UDLY bus_req_addr;
-                    req_mask_r <= #UDLY bus_req_mask;
-                    req_data_r <= #UDLY bus_req_data;
+                    req_vld_r    <= #UDLY sgl_req_vld;
+                    req_seq_r    <= #UDLY sgl_req_seq;
+                    req_hburst_r <= #UDLY sgl_req_hburst;
+                    req_read_r   <= #UDLY sgl_req_read;
+                    req_addr_r   <= #UDLY sgl_req_addr;
+                    req_mask_r   <= #UDLY sgl_req_mask;
+                    req_data_r   <= #UDLY sgl_req_data;
                 end
             end
         end
         else begin: gen_bus_req_imm
             always @(*) begin
-                req_vld_r  = bus_req_vld;
-                req_read_r = bus_req_read;
-                req_addr_r = bus_req_addr;
-                req_mask_r = bus_req_mask;
-                req_data_r = bus_req_data;
+                req_vld_r    = sgl_req_vld;
+                req_seq_r    = sgl_req_seq;
+                req_hburst_r = sgl_req_hburst;
+                req_read_r   = sgl_req_read;
+                req_addr_r   = sgl_req_addr;
+                req_mask_r   = sgl_req_mask;
+                req_data_r   = sgl_req_data;
             end
         end
     endgenerate
@@ -176,7 +283,7 @@ module uv_bus_to_ahb
         end
         else begin
             if (req_vld_r) begin
-                ahb_hwdata_r <= #ULDY req_data_r;
+                ahb_hwdata_r <= #UDLY req_data_r;
             end
         end
     end
@@ -191,7 +298,7 @@ module uv_bus_to_ahb
                 ahb_busy_r <= #UDLY 1'b1;
             end
             else if (ahb_okay) begin
-                ahb_busy_r <= #ULDY 1'b0;
+                ahb_busy_r <= #UDLY 1'b0;
             end
         end
     end
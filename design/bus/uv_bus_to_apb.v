@@ -7,6 +7,13 @@
 //
 // Description:
 //      Transform interface from bus to APB.
+//      Requests are queued in a buffer of WBUF_DP entries, and
+//      the SETUP of the next transfer follows the ACCESS of the
+//      last one, so back-to-back transfers take 2 cycles each.
+//      With POST_WR, writes are acknowledged once queued & their
+//      errors are dropped. Reads & non-posted writes wait in the
+//      queue behind posted writes, and block new requests until
+//      they are responded.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,7 +23,9 @@ module uv_bus_to_apb
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter PIPE                  = 1'b1
+    parameter PIPE                  = 1'b1,
+    parameter POST_WR               = 1'b0,
+    parameter WBUF_DP               = 4
 )
 (
     input                           clk,
@@ -49,139 +58,186 @@ module uv_bus_to_apb
 );
 
     localparam UDLY = 1;
-    
-    reg                             req_rdy_r;
-    reg                             req_vld_r;
-    reg                             req_read_r;
-    reg  [ALEN-1:0]                 req_addr_r;
-    reg  [MLEN-1:0]                 req_mask_r;
-    reg  [DLEN-1:0]                 req_data_r;
+    localparam WBUF_AW              = WBUF_DP > 1 ? $clog2(WBUF_DP) : 1;
+`ifdef APB_NO_POST
+    localparam POST_EN              = 1'b0;
+`else
+    localparam POST_EN              = POST_WR;
+`endif
+
+    // Write buffer.
+    reg                             que_read_r  [WBUF_DP-1:0];
+    reg  [ALEN-1:0]                 que_addr_r  [WBUF_DP-1:0];
+    reg  [MLEN-1:0]                 que_mask_r  [WBUF_DP-1:0];
+    reg  [DLEN-1:0]                 que_data_r  [WBUF_DP-1:0];
+    reg  [WBUF_AW-1:0]              que_wptr_r;
+    reg  [WBUF_AW-1:0]              que_rptr_r;
+    reg  [WBUF_AW:0]                que_cnt_r;
+
+    // Current transfer.
+    reg                             cur_vld_r;
+    reg                             cur_read_r;
+    reg  [ALEN-1:0]                 cur_addr_r;
+    reg  [MLEN-1:0]                 cur_mask_r;
+    reg  [DLEN-1:0]                 cur_data_r;
+    reg                             apb_penable_r;
 
+    reg                             blk_r;
     reg                             rsp_vld_r;
     reg                             rsp_excp_r;
     reg  [DLEN-1:0]                 rsp_data_r;
 
-    reg                             apb_penable_r;
-    reg  [ALEN-1:0]                 apb_paddr_r;
-    reg  [MLEN-1:0]                 apb_pstrb_r;
-    reg                             apb_pwrite_r;
-    reg  [DLEN-1:0]                 apb_pwdata_r;
-
-    wire                            apb_busy;
+    wire                            bus_req_fire;
+    wire                            bus_rsp_fire;
+    wire                            req_post;
+    wire                            cur_post;
+    wire                            cur_free;
+    wire                            que_empty;
+    wire                            que_push;
+    wire                            que_pop;
+    wire                            bus_to_cur;
+    wire                            bus_byp;
     wire                            apb_okay;
+    wire                            apb_rsp;
+
+    assign bus_req_fire             = bus_req_vld & bus_req_rdy;
+    assign bus_rsp_fire             = bus_rsp_vld & bus_rsp_rdy;
+    assign req_post                 = POST_EN & (~bus_req_read);
+    assign cur_post                 = POST_EN & (~cur_read_r);
 
-    assign apb_busy                 = req_vld_r | apb_penable_r;
     assign apb_okay                 = apb_penable & apb_pready;
+    assign apb_rsp                  = apb_okay & (~cur_post);
+
+    // The next transfer is taken from the buffer, or from the bus if the buffer is empty.
+    assign cur_free                 = (~cur_vld_r) | apb_okay;
+    assign que_empty                = que_cnt_r == {(WBUF_AW+1){1'b0}};
+    assign que_pop                  = cur_free & (~que_empty);
+    assign bus_to_cur               = cur_free & que_empty & bus_req_fire;
+    assign que_push                 = bus_req_fire & (~bus_to_cur);
+
+    // Without PIPE, an idle bridge starts SETUP with the bus request.
+    assign bus_byp                  = (~PIPE) & (~cur_vld_r) & bus_to_cur;
 
     // Bus output.
-    assign bus_req_rdy              = (~bus_req_vld | req_vld_r) & req_rdy_r;
-    assign bus_rsp_vld              = apb_okay | rsp_vld_r;
-    assign bus_rsp_excp             = apb_okay ? {1'b0, apb_pslverr} : {1'b0, rsp_excp_r};
-    assign bus_rsp_data             = apb_okay ? apb_prdata : rsp_data_r;
+    assign bus_req_rdy              = (~blk_r) & (que_cnt_r < WBUF_DP) & ((~rsp_vld_r) | bus_rsp_rdy);
+    assign bus_rsp_vld              = apb_rsp | rsp_vld_r;
+    assign bus_rsp_excp             = apb_rsp ? {1'b0, apb_pslverr} : {1'b0, rsp_excp_r};
+    assign bus_rsp_data             = apb_rsp ? apb_prdata : rsp_data_r;
 
     // APB output.
-    assign apb_psel                 = apb_busy;
+    assign apb_psel                 = cur_vld_r | bus_byp;
     assign apb_penable              = apb_penable_r;
     assign apb_pprot                = 3'b0;
-    assign apb_paddr                = req_vld_r ? req_addr_r  : apb_paddr_r;
-    assign apb_pstrb                = req_vld_r ? req_mask_r  : apb_pstrb_r;
-    assign apb_pwrite               = req_vld_r ? ~req_read_r : apb_pwrite_r;
-    assign apb_pwdata               = req_vld_r ? req_data_r  : apb_pwdata_r;
+    assign apb_paddr                = bus_byp ? bus_req_addr   : cur_addr_r;
+    assign apb_pstrb                = bus_byp ? bus_req_mask   : cur_mask_r;
+    assign apb_pwrite               = bus_byp ? ~bus_req_read  : ~cur_read_r;
+    assign apb_pwdata               = bus_byp ? bus_req_data   : cur_data_r;
 
-    // Bus back pressure.
+    // New requests wait until the response of reads & non-posted writes.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            req_rdy_r <= 1'b1;
+            blk_r <= 1'b0;
         end
         else begin
-            if (apb_okay) begin
-                req_rdy_r <= #UDLY 1'b1;
+            if (bus_req_fire & (~req_post)) begin
+                blk_r <= #UDLY 1'b1;
             end
-            else if (req_vld_r) begin
-                req_rdy_r <= #UDLY 1'b0;
+            else if (apb_rsp) begin
+                blk_r <= #UDLY 1'b0;
             end
         end
     end
 
-    // Buffer bus output.
+    // Posted writes are acknowledged the next cycle.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             rsp_vld_r  <= 1'b0;
             rsp_excp_r <= 1'b0;
+            rsp_data_r <= {DLEN{1'b0}};
         end
         else begin
-            if (apb_okay & (~bus_rsp_rdy)) begin
+            if (bus_req_fire & req_post) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY 1'b0;
+                rsp_data_r <= #UDLY {DLEN{1'b0}};
+            end
+            else if (apb_rsp & (~bus_rsp_rdy)) begin
                 rsp_vld_r  <= #UDLY 1'b1;
                 rsp_excp_r <= #UDLY apb_pslverr;
+                rsp_data_r <= #UDLY apb_prdata;
             end
-            else if (bus_rsp_vld & bus_rsp_rdy) begin
+            else if (bus_rsp_fire) begin
                 rsp_vld_r  <= #UDLY 1'b0;
                 rsp_excp_r <= #UDLY 1'b0;
             end
         end
     end
 
+    // Buffer bus input.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            rsp_data_r <= {DLEN{1'b0}};
+            que_wptr_r <= {WBUF_AW{1'b0}};
+            que_rptr_r <= {WBUF_AW{1'b0}};
+            que_cnt_r  <= {(WBUF_AW+1){1'b0}};
         end
         else begin
-            if (apb_okay) begin
-                rsp_data_r <= #UDLY apb_prdata;
+            if (que_push) begin
+                que_wptr_r <= #UDLY que_wptr_r == WBUF_DP - 1 ? {WBUF_AW{1'b0}} : que_wptr_r + 1'b1;
+            end
+            if (que_pop) begin
+                que_rptr_r <= #UDLY que_rptr_r == WBUF_DP - 1 ? {WBUF_AW{1'b0}} : que_rptr_r + 1'b1;
+            end
+            if (que_push & (~que_pop)) begin
+                que_cnt_r  <= #UDLY que_cnt_r + 1'b1;
+            end
+            else if (que_pop & (~que_push)) begin
+                que_cnt_r  <= #UDLY que_cnt_r - 1'b1;
             end
         end
     end
 
-    // Buffer bus input.
-    generate
-        if (PIPE) begin: gen_bus_req_pipe
-            always @(posedge clk or negedge rst_n) begin
-                if (~rst_n) begin
-                    req_vld_r  <= 1'b0;
-                    req_read_r <= 1'b0;
-                    req_addr_r <= {ALEN{1'b0}};
-                    req_mask_r <= {MLEN{1'b0}};
-                    req_data_r <= {DLEN{1'b0}};
-                end
-                else begin
-                    req_vld_r  <= #UDLY bus_req_vld;
-                    req_read_r <= #UDLY bus_req_read;
-                    req_addr_r <= #UDLY bus_req_addr;
-                    req_mask_r <= #UDLY bus_req_mask;
-                    req_data_r <= #UDLY bus_req_data;
-                end
-            end
+    always @(posedge clk) begin
+        if (que_push) begin
+            que_read_r[que_wptr_r] <= #UDLY bus_req_read;
+            que_addr_r[que_wptr_r] <= #UDLY bus_req_addr;
+            que_mask_r[que_wptr_r] <= #UDLY bus_req_mask;
+            que_data_r[que_wptr_r] <= #UDLY bus_req_data;
         end
-        else begin: gen_bus_req_imm
-            always @(*) begin
-                req_vld_r  = bus_req_vld;
-                req_read_r = bus_req_read;
-                req_addr_r = bus_req_addr;
-                req_mask_r = bus_req_mask;
-                req_data_r = bus_req_data;
-            end
-        end
-    endgenerate
+    end
 
-    // Buffer APB output.
+    // SETUP of the next transfer right after ACCESS.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
+            cur_vld_r     <= 1'b0;
             apb_penable_r <= 1'b0;
-            apb_paddr_r   <= {ALEN{1'b0}};
-            apb_pstrb_r   <= {MLEN{1'b0}};
-            apb_pwrite_r  <= 1'b0;
-            apb_pwdata_r  <= {DLEN{1'b0}};
+            cur_read_r    <= 1'b0;
+            cur_addr_r    <= {ALEN{1'b0}};
+            cur_mask_r    <= {MLEN{1'b0}};
+            cur_data_r    <= {DLEN{1'b0}};
         end
         else begin
-            if (apb_okay) begin
+            if (que_pop) begin
+                cur_vld_r     <= #UDLY 1'b1;
+                apb_penable_r <= #UDLY 1'b0;
+                cur_read_r    <= #UDLY que_read_r[que_rptr_r];
+                cur_addr_r    <= #UDLY que_addr_r[que_rptr_r];
+                cur_mask_r    <= #UDLY que_mask_r[que_rptr_r];
+                cur_data_r    <= #UDLY que_data_r[que_rptr_r];
+            end
+            else if (bus_to_cur) begin
+                cur_vld_r     <= #UDLY 1'b1;
+                apb_penable_r <= #UDLY bus_byp;
+                cur_read_r    <= #UDLY bus_req_read;
+                cur_addr_r    <= #UDLY bus_req_addr;
+                cur_mask_r    <= #UDLY bus_req_mask;
+                cur_data_r    <= #UDLY bus_req_data;
+            end
+            else if (apb_okay) begin
+                cur_vld_r     <= #UDLY 1'b0;
                 apb_penable_r <= #UDLY 1'b0;
             end
-            else if (req_vld_r) begin
+            else if (cur_vld_r) begin
                 apb_penable_r <= #UDLY 1'b1;
-                apb_paddr_r   <= #UDLY req_addr_r;
-                apb_pstrb_r   <= #UDLY req_mask_r;
-                apb_pwrite_r  <= #UDLY ~req_read_r;
-                apb_pwdata_r  <= #UDLY req_data_r;
             end
         end
     end
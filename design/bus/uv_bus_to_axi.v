@@ -0,0 +1,429 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_bus_to_axi
+//
+// Designer: Owen
+//
+// Description:
+//      Transform interface from bus to AXI4 master.
+//      Read bursts are issued as one AR, and write bursts as
+//      one AW with the beats on W. Up to RD_OST reads & WR_OST
+//      writes are outstanding with the same ID. The bus takes
+//      responses in request order, so R beats are accepted
+//      only when the read is the oldest, while B responses are
+//      always accepted & each returns LEN+1 bus responses.
+//      Bus data is LSB-justified & steered to byte lanes, and
+//      an access must not cross the DLEN boundary.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_bus_to_axi
+#(
+    parameter ALEN                  = 32,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter AXI_IDW               = 4,
+    parameter AXI_ID                = 0,
+    parameter RD_OST                = 4,
+    parameter WR_OST                = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Bus ports.
+    input                           bus_req_vld,
+    output                          bus_req_rdy,
+    input                           bus_req_read,
+    input  [ALEN-1:0]               bus_req_addr,
+    input  [3:0]                    bus_req_len,
+    input                           bus_req_wrap,
+    input  [MLEN-1:0]               bus_req_mask,
+    input  [DLEN-1:0]               bus_req_data,
+
+    output                          bus_rsp_vld,
+    input                           bus_rsp_rdy,
+    output [1:0]                    bus_rsp_excp,
+    output [DLEN-1:0]               bus_rsp_data,
+
+    // AXI write address.
+    output [AXI_IDW-1:0]            axi_awid,
+    output [ALEN-1:0]               axi_awaddr,
+    output [7:0]                    axi_awlen,
+    output [2:0]                    axi_awsize,
+    output [1:0]                    axi_awburst,
+    output                          axi_awlock,
+    output [3:0]                    axi_awcache,
+    output [2:0]                    axi_awprot,
+    output                          axi_awvalid,
+    input                           axi_awready,
+
+    // AXI write data.
+    output [DLEN-1:0]               axi_wdata,
+    output [MLEN-1:0]               axi_wstrb,
+    output                          axi_wlast,
+    output                          axi_wvalid,
+    input                           axi_wready,
+
+    // AXI write response.
+    input  [AXI_IDW-1:0]            axi_bid,
+    input  [1:0]                    axi_bresp,
+    input                           axi_bvalid,
+    output                          axi_bready,
+
+    // AXI read address.
+    output [AXI_IDW-1:0]            axi_arid,
+    output [ALEN-1:0]               axi_araddr,
+    output [7:0]                    axi_arlen,
+    output [2:0]                    axi_arsize,
+    output [1:0]                    axi_arburst,
+    output                          axi_arlock,
+    output [3:0]                    axi_arcache,
+    output [2:0]                    axi_arprot,
+    output                          axi_arvalid,
+    input                           axi_arready,
+
+    // AXI read data.
+    input  [AXI_IDW-1:0]            axi_rid,
+    input  [DLEN-1:0]               axi_rdata,
+    input  [1:0]                    axi_rresp,
+    input                           axi_rlast,
+    input                           axi_rvalid,
+    output                          axi_rready
+);
+
+    localparam UDLY                 = 1;
+    localparam OFFSET_AW            = $clog2(MLEN);
+    localparam TAG_DP               = RD_OST + WR_OST;
+    localparam TAG_PW               = $clog2(TAG_DP);
+    localparam TAG_DW               = 5 + OFFSET_AW;
+    localparam BRSP_PW              = WR_OST > 1 ? $clog2(WR_OST) : 1;
+    localparam RD_CW                = $clog2(RD_OST + 1);
+    localparam WR_CW                = $clog2(WR_OST + 1);
+
+    localparam AXI_BURST_INCR       = 2'b01;
+    localparam AXI_BURST_WRAP       = 2'b10;
+
+    wire                            bus_req_fire;
+    wire                            bus_rsp_fire;
+    wire                            req_first;
+    wire                            req_last;
+    wire [OFFSET_AW-1:0]            req_offset;
+    reg  [2:0]                      req_size;
+    integer                         k;
+
+    // Write bursts on bus.
+    reg                             wbst_act_r;
+    reg  [3:0]                      wbst_rem_r;
+
+    // Outstanding transactions.
+    reg  [RD_CW-1:0]                rd_ost_cnt_r;
+    reg  [WR_CW-1:0]                wr_ost_cnt_r;
+    wire                            rd_ost_full;
+    wire                            wr_ost_full;
+    wire                            rd_issue;
+    wire                            wr_issue;
+    wire                            rd_done;
+    wire                            wr_done;
+
+    // AXI channel buffers.
+    reg                             ar_vld_r;
+    reg  [ALEN-1:0]                 ar_addr_r;
+    reg  [3:0]                      ar_len_r;
+    reg  [2:0]                      ar_size_r;
+    reg                             ar_wrap_r;
+
+    reg                             aw_vld_r;
+    reg  [ALEN-1:0]                 aw_addr_r;
+    reg  [3:0]                      aw_len_r;
+    reg  [2:0]                      aw_size_r;
+    reg                             aw_wrap_r;
+
+    reg                             w_vld_r;
+    reg  [DLEN-1:0]                 w_data_r;
+    reg  [MLEN-1:0]                 w_strb_r;
+    reg                             w_last_r;
+
+    wire                            ar_free;
+    wire                            aw_free;
+    wire                            w_free;
+
+    // Transactions in request order.
+    wire                            tag_push;
+    wire                            tag_pop;
+    wire [TAG_DW-1:0]               tag_wr_dat;
+    wire [TAG_DW-1:0]               tag_rd_dat;
+    wire                            tag_full;
+    wire                            tag_empty;
+    wire                            tag_read;
+    wire [3:0]                      tag_len;
+    wire [OFFSET_AW-1:0]            tag_offset;
+    reg  [3:0]                      rsp_cnt_r;
+    wire                            rsp_sel_rd;
+    wire                            rsp_last;
+
+    // Write responses.
+    wire                            brsp_push;
+    wire                            brsp_pop;
+    wire                            brsp_err;
+    wire                            brsp_full;
+    wire                            brsp_empty;
+
+    assign bus_req_fire             = bus_req_vld & bus_req_rdy;
+    assign bus_rsp_fire             = bus_rsp_vld & bus_rsp_rdy;
+
+    // Reads are requested once, and writes in LEN+1 beats.
+    assign req_first                = bus_req_read | (~wbst_act_r);
+    assign req_last                 = wbst_act_r ? (wbst_rem_r == 4'd1) : (bus_req_len == 4'd0);
+    assign req_offset               = bus_req_addr[OFFSET_AW-1:0];
+
+    // Size from LSB-justified mask.
+    always @(*) begin
+        req_size = 3'd0;
+        for (k = 1; k < MLEN; k = k * 2) begin
+            if (bus_req_mask[k]) begin
+                req_size = req_size + 1'b1;
+            end
+        end
+    end
+
+    assign ar_free                  = (~ar_vld_r) | axi_arready;
+    assign aw_free                  = (~aw_vld_r) | axi_awready;
+    assign w_free                   = (~w_vld_r) | axi_wready;
+
+    assign rd_ost_full              = rd_ost_cnt_r == RD_OST;
+    assign wr_ost_full              = wr_ost_cnt_r == WR_OST;
+
+    assign bus_req_rdy              = bus_req_read ? (~rd_ost_full) & (~tag_full) & ar_free
+                                    : req_first    ? (~wr_ost_full) & (~tag_full) & aw_free & w_free
+                                    : w_free;
+
+    assign rd_issue                 = bus_req_fire & bus_req_read;
+    assign wr_issue                 = bus_req_fire & (~bus_req_read) & req_first;
+
+    // AXI output.
+    assign axi_awid                 = AXI_ID;
+    assign axi_awaddr               = aw_addr_r;
+    assign axi_awlen                = {4'b0, aw_len_r};
+    assign axi_awsize               = aw_size_r;
+    assign axi_awburst              = aw_wrap_r ? AXI_BURST_WRAP : AXI_BURST_INCR;
+    assign axi_awlock               = 1'b0;
+    assign axi_awcache              = 4'b0011;
+    assign axi_awprot               = 3'b001;
+    assign axi_awvalid              = aw_vld_r;
+
+    assign axi_wdata                = w_data_r;
+    assign axi_wstrb                = w_strb_r;
+    assign axi_wlast                = w_last_r;
+    assign axi_wvalid               = w_vld_r;
+
+    assign axi_arid                 = AXI_ID;
+    assign axi_araddr               = ar_addr_r;
+    assign axi_arlen                = {4'b0, ar_len_r};
+    assign axi_arsize               = ar_size_r;
+    assign axi_arburst              = ar_wrap_r ? AXI_BURST_WRAP : AXI_BURST_INCR;
+    assign axi_arlock               = 1'b0;
+    assign axi_arcache              = 4'b0011;
+    assign axi_arprot               = 3'b001;
+    assign axi_arvalid              = ar_vld_r;
+
+    // Responses follow the oldest transaction.
+    assign tag_push                 = rd_issue | wr_issue;
+    assign tag_wr_dat               = {bus_req_read, bus_req_len, req_offset};
+    assign {tag_read, tag_len, tag_offset} = tag_rd_dat;
+    assign rsp_sel_rd               = (~tag_empty) & tag_read;
+    assign rsp_last                 = rsp_cnt_r == tag_len;
+    assign tag_pop                  = bus_rsp_fire & rsp_last;
+
+    assign rd_done                  = tag_pop & tag_read;
+    assign wr_done                  = tag_pop & (~tag_read);
+
+    assign bus_rsp_vld              = rsp_sel_rd ? axi_rvalid : (~tag_empty) & (~brsp_empty);
+    assign bus_rsp_excp             = rsp_sel_rd ? {1'b0, axi_rresp[1]} : {1'b0, brsp_err};
+    assign bus_rsp_data             = rsp_sel_rd ? axi_rdata >> {tag_offset, 3'b0} : {DLEN{1'b0}};
+    assign axi_rready               = rsp_sel_rd & bus_rsp_rdy;
+
+    // B is kept until all beats of the write are responded.
+    assign axi_bready               = ~brsp_full;
+    assign brsp_push                = axi_bvalid & axi_bready;
+    assign brsp_pop                 = wr_done;
+
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( TAG_DW            ),
+        .PTR_WIDTH                  ( TAG_PW            ),
+        .QUE_DEPTH                  ( TAG_DP            ),
+        .ZERO_RDLY                  ( 1'b1              )
+    )
+    u_tag
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .wr_rdy                     (                   ),
+        .wr_vld                     ( tag_push          ),
+        .wr_dat                     ( tag_wr_dat        ),
+
+        .rd_rdy                     (                   ),
+        .rd_vld                     ( tag_pop           ),
+        .rd_dat                     ( tag_rd_dat        ),
+
+        .clr                        ( 1'b0              ),
+        .len                        (                   ),
+        .full                       ( tag_full          ),
+        .empty                      ( tag_empty         )
+    );
+
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( 1                 ),
+        .PTR_WIDTH                  ( BRSP_PW           ),
+        .QUE_DEPTH                  ( WR_OST            ),
+        .ZERO_RDLY                  ( 1'b1              )
+    )
+    u_brsp
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .wr_rdy                     (                   ),
+        .wr_vld                     ( brsp_push         ),
+        .wr_dat                     ( axi_bresp[1]      ),
+
+        .rd_rdy                     (                   ),
+        .rd_vld                     ( brsp_pop          ),
+        .rd_dat                     ( brsp_err          ),
+
+        .clr                        ( 1'b0              ),
+        .len                        (                   ),
+        .full                       ( brsp_full         ),
+        .empty                      ( brsp_empty        )
+    );
+
+    // Count beats of the oldest transaction.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_cnt_r <= 4'd0;
+        end
+        else begin
+            if (tag_pop) begin
+                rsp_cnt_r <= #UDLY 4'd0;
+            end
+            else if (bus_rsp_fire) begin
+                rsp_cnt_r <= #UDLY rsp_cnt_r + 1'b1;
+            end
+        end
+    end
+
+    // Track beats of write bursts.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            wbst_act_r <= 1'b0;
+            wbst_rem_r <= 4'd0;
+        end
+        else begin
+            if (bus_req_fire & (~bus_req_read)) begin
+                if (req_first) begin
+                    wbst_act_r <= #UDLY |bus_req_len;
+                    wbst_rem_r <= #UDLY bus_req_len;
+                end
+                else begin
+                    wbst_act_r <= #UDLY wbst_rem_r != 4'd1;
+                    wbst_rem_r <= #UDLY wbst_rem_r - 1'b1;
+                end
+            end
+        end
+    end
+
+    // Count outstanding reads & writes.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rd_ost_cnt_r <= {RD_CW{1'b0}};
+            wr_ost_cnt_r <= {WR_CW{1'b0}};
+        end
+        else begin
+            if (rd_issue & (~rd_done)) begin
+                rd_ost_cnt_r <= #UDLY rd_ost_cnt_r + 1'b1;
+            end
+            else if (rd_done & (~rd_issue)) begin
+                rd_ost_cnt_r <= #UDLY rd_ost_cnt_r - 1'b1;
+            end
+
+            if (wr_issue & (~wr_done)) begin
+                wr_ost_cnt_r <= #UDLY wr_ost_cnt_r + 1'b1;
+            end
+            else if (wr_done & (~wr_issue)) begin
+                wr_ost_cnt_r <= #UDLY wr_ost_cnt_r - 1'b1;
+            end
+        end
+    end
+
+    // Buffer AXI addresses.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ar_vld_r  <= 1'b0;
+            ar_addr_r <= {ALEN{1'b0}};
+            ar_len_r  <= 4'd0;
+            ar_size_r <= 3'd0;
+            ar_wrap_r <= 1'b0;
+        end
+        else begin
+            if (rd_issue) begin
+                ar_vld_r  <= #UDLY 1'b1;
+                ar_addr_r <= #UDLY bus_req_addr;
+                ar_len_r  <= #UDLY bus_req_len;
+                ar_size_r <= #UDLY req_size;
+                ar_wrap_r <= #UDLY bus_req_wrap;
+            end
+            else if (axi_arready) begin
+                ar_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            aw_vld_r  <= 1'b0;
+            aw_addr_r <= {ALEN{1'b0}};
+            aw_len_r  <= 4'd0;
+            aw_size_r <= 3'd0;
+            aw_wrap_r <= 1'b0;
+        end
+        else begin
+            if (wr_issue) begin
+                aw_vld_r  <= #UDLY 1'b1;
+                aw_addr_r <= #UDLY bus_req_addr;
+                aw_len_r  <= #UDLY bus_req_len;
+                aw_size_r <= #UDLY req_size;
+                aw_wrap_r <= #UDLY bus_req_wrap;
+            end
+            else if (axi_awready) begin
+                aw_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    // Buffer AXI write data, steered to byte lanes.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            w_vld_r  <= 1'b0;
+            w_data_r <= {DLEN{1'b0}};
+            w_strb_r <= {MLEN{1'b0}};
+            w_last_r <= 1'b0;
+        end
+        else begin
+            if (bus_req_fire & (~bus_req_read)) begin
+                w_vld_r  <= #UDLY 1'b1;
+                w_data_r <= #UDLY bus_req_data << {req_offset, 3'b0};
+                w_strb_r <= #UDLY bus_req_mask << req_offset;
+                w_last_r <= #UDLY req_last;
+            end
+            else if (axi_wready) begin
+                w_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,123 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_bus_upsize
+//
+// Designer: Owen
+//
+// Description:
+//      Width adapter from a narrow master to a wide bus.
+//      Bus data is LSB-justified with the byte offset in the
+//      address, so slaves steer bytes to their lanes, and the
+//      data & mask are only zero-extended here. Read bursts
+//      step by the narrow width & are expanded to singles.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_bus_upsize
+#(
+    parameter ALEN                  = 32,
+    parameter NRW_DW                = 32,
+    parameter NRW_MW                = NRW_DW / 8,
+    parameter WID_DW                = 64,
+    parameter WID_MW                = WID_DW / 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Narrow master.
+    input                           nrw_req_vld,
+    output                          nrw_req_rdy,
+    input                           nrw_req_read,
+    input  [ALEN-1:0]               nrw_req_addr,
+    input  [3:0]                    nrw_req_len,
+    input                           nrw_req_wrap,
+    input  [3:0]                    nrw_req_amo,
+    input  [NRW_MW-1:0]             nrw_req_mask,
+    input  [NRW_DW-1:0]             nrw_req_data,
+
+    output                          nrw_rsp_vld,
+    input                           nrw_rsp_rdy,
+    output [1:0]                    nrw_rsp_excp,
+    output [NRW_DW-1:0]             nrw_rsp_data,
+
+    // Wide bus.
+    output                          wid_req_vld,
+    input                           wid_req_rdy,
+    output                          wid_req_read,
+    output [ALEN-1:0]               wid_req_addr,
+    output [3:0]                    wid_req_len,
+    output                          wid_req_wrap,
+    output [3:0]                    wid_req_amo,
+    output [WID_MW-1:0]             wid_req_mask,
+    output [WID_DW-1:0]             wid_req_data,
+
+    input                           wid_rsp_vld,
+    output                          wid_rsp_rdy,
+    input  [1:0]                    wid_rsp_excp,
+    input  [WID_DW-1:0]             wid_rsp_data
+);
+
+    assign nrw_rsp_vld              = wid_rsp_vld;
+    assign nrw_rsp_excp             = wid_rsp_excp;
+    assign nrw_rsp_data             = wid_rsp_data[NRW_DW-1:0];
+    assign wid_rsp_rdy              = nrw_rsp_rdy;
+
+    generate
+        if (WID_DW == NRW_DW) begin: gen_pass
+            assign nrw_req_rdy      = wid_req_rdy;
+            assign wid_req_vld      = nrw_req_vld;
+            assign wid_req_read     = nrw_req_read;
+            assign wid_req_addr     = nrw_req_addr;
+            assign wid_req_len      = nrw_req_len;
+            assign wid_req_wrap     = nrw_req_wrap;
+            assign wid_req_amo      = nrw_req_amo;
+            assign wid_req_mask     = nrw_req_mask;
+            assign wid_req_data     = nrw_req_data;
+        end
+        else begin: gen_upsize
+            wire [NRW_MW-1:0]       sgl_req_mask;
+            wire [NRW_DW-1:0]       sgl_req_data;
+
+            assign wid_req_len      = 4'b0;
+            assign wid_req_wrap     = 1'b0;
+            assign wid_req_mask     = {{(WID_MW-NRW_MW){1'b0}}, sgl_req_mask};
+            assign wid_req_data     = {{(WID_DW-NRW_DW){1'b0}}, sgl_req_data};
+
+            uv_bus_burst
+            #(
+                .ALEN               ( ALEN                  ),
+                .DLEN               ( NRW_DW                ),
+                .MLEN               ( NRW_MW                )
+            )
+            u_burst
+            (
+                .clk                ( clk                   ),
+                .rst_n              ( rst_n                 ),
+
+                .bst_req_vld        ( nrw_req_vld           ),
+                .bst_req_rdy        ( nrw_req_rdy           ),
+                .bst_req_read       ( nrw_req_read          ),
+                .bst_req_addr       ( nrw_req_addr          ),
+                .bst_req_len        ( nrw_req_len           ),
+                .bst_req_wrap       ( nrw_req_wrap          ),
+                .bst_req_amo        ( nrw_req_amo           ),
+                .bst_req_mask       ( nrw_req_mask          ),
+                .bst_req_data       ( nrw_req_data          ),
+
+                .sgl_req_vld        ( wid_req_vld           ),
+                .sgl_req_rdy        ( wid_req_rdy           ),
+                .sgl_req_read       ( wid_req_read          ),
+                .sgl_req_addr       ( wid_req_addr          ),
+                .sgl_req_amo        ( wid_req_amo           ),
+                .sgl_req_mask       ( sgl_req_mask          ),
+                .sgl_req_data       ( sgl_req_data          ),
+
+                .bst_busy           (                       )
+            );
+        end
+    endgenerate
+
+endmodule
@@ -7,6 +7,8 @@
 //
 // Description:
 //      Bus Interface Unit.
+//      Loads & stores in the core-local window (LCL_BASE) go
+//      straight to SLC rather than through the device bus.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,10 +18,13 @@ module uv_biu
     parameter ALEN              = 32,
     parameter DLEN              = 32,
     parameter MLEN              = DLEN / 8,
+    parameter IFLEN             = DLEN,
     parameter MEM_BASE_LSB      = 31,
     parameter MEM_BASE_ADDR     = 1'h1,
     parameter DEV_BASE_LSB      = 31,
-    parameter DEV_BASE_ADDR     = 1'h0
+    parameter DEV_BASE_ADDR     = 1'h0,
+    parameter LCL_BASE_LSB      = 16,
+    parameter LCL_BASE_ADDR     = 16'h0200
 )
 (
     input                       clk,
@@ -33,13 +38,14 @@ module uv_biu
     output                      if_rsp_vld,
     input                       if_rsp_rdy,
     output [1:0]                if_rsp_excp,
-    output [DLEN-1:0]           if_rsp_data,
+    output [IFLEN-1:0]          if_rsp_data,
 
     // Load-store from ucore.
     input                       ls_req_vld,
     output                      ls_req_rdy,
     input                       ls_req_read,
     input  [ALEN-1:0]           ls_req_addr,
+    input  [3:0]                ls_req_amo,
     input  [MLEN-1:0]           ls_req_mask,
     input  [DLEN-1:0]           ls_req_data,
 
@@ -56,13 +62,14 @@ module uv_biu
     input                       mem_i_rsp_vld,
     output                      mem_i_rsp_rdy,
     input  [1:0]                mem_i_rsp_excp,
-    input  [DLEN-1:0]           mem_i_rsp_data,
+    input  [IFLEN-1:0]          mem_i_rsp_data,
 
     // Access to data memory.
     output                      mem_d_req_vld,
     input                       mem_d_req_rdy,
     output                      mem_d_req_read,
     output [ALEN-1:0]           mem_d_req_addr,
+    output [3:0]                mem_d_req_amo,
     output [MLEN-1:0]           mem_d_req_mask,
     output [DLEN-1:0]           mem_d_req_data,
 
@@ -86,16 +93,33 @@ module uv_biu
     input                       dev_d_req_rdy,
     output                      dev_d_req_read,
     output [ALEN-1:0]           dev_d_req_addr,
+    output [3:0]                dev_d_req_amo,
     output [MLEN-1:0]           dev_d_req_mask,
     output [DLEN-1:0]           dev_d_req_data,
 
     input                       dev_d_rsp_vld,
     output                      dev_d_rsp_rdy,
     input  [1:0]                dev_d_rsp_excp,
-    input  [DLEN-1:0]           dev_d_rsp_data
+    input  [DLEN-1:0]           dev_d_rsp_data,
+
+    // Access to core-local registers.
+    output                      lcl_req_vld,
+    input                       lcl_req_rdy,
+    output                      lcl_req_read,
+    output [ALEN-1:0]           lcl_req_addr,
+    output [MLEN-1:0]           lcl_req_mask,
+    output [DLEN-1:0]           lcl_req_data,
+
+    input                       lcl_rsp_vld,
+    output                      lcl_rsp_rdy,
+    input  [1:0]                lcl_rsp_excp,
+    input  [DLEN-1:0]           lcl_rsp_data
 );
 
     localparam UDLY             = 1;
+    localparam IMLEN            = IFLEN / 8;
+
+    wire [IFLEN-1:0]            dev_i_rsp_line;
 
     reg                         if_rsp_rdy_r;
     reg                         if_req_vld_r;
@@ -140,11 +164,14 @@ module uv_biu
         end
     end
 
+    // Device bus returns one instruction, which is replicated to fill the line.
+    assign dev_i_rsp_line       = {(IFLEN/DLEN){dev_i_rsp_data}};
+
     uv_bus_fab_1x2
     #(
         .ALEN                   ( ALEN              ),
-        .DLEN                   ( DLEN              ),
-        .MLEN                   ( MLEN              ),
+        .DLEN                   ( IFLEN             ),
+        .MLEN                   ( IMLEN             ),
         .SLV0_BASE_LSB          ( MEM_BASE_LSB      ),
         .SLV0_BASE_ADDR         ( MEM_BASE_ADDR     ),
         .SLV1_BASE_LSB          ( DEV_BASE_LSB      ),
@@ -160,8 +187,9 @@ module uv_biu
         .mst_req_rdy            ( if_req_rdy        ),
         .mst_req_read           ( 1'b1              ),
         .mst_req_addr           ( if_req_addr       ),
-        .mst_req_mask           ( {MLEN{1'b1}}      ),
-        .mst_req_data           ( {DLEN{1'b0}}      ),
+        .mst_req_amo            ( 4'b0              ),
+        .mst_req_mask           ( {IMLEN{1'b1}}     ),
+        .mst_req_data           ( {IFLEN{1'b0}}     ),
 
         .mst_rsp_vld            ( if_rsp_vld        ),
         .mst_rsp_rdy            ( if_rsp_rdy        ),
@@ -173,6 +201,7 @@ module uv_biu
         .slv0_req_rdy           ( mem_i_req_rdy     ),
         .slv0_req_read          (                   ),
         .slv0_req_addr          ( mem_i_req_addr    ),
+        .slv0_req_amo           (                   ),
         .slv0_req_mask          (                   ),
         .slv0_req_data          (                   ),
 
@@ -186,24 +215,31 @@ module uv_biu
         .slv1_req_rdy           ( dev_i_req_rdy     ),
         .slv1_req_read          (                   ),
         .slv1_req_addr          ( dev_i_req_addr    ),
+        .slv1_req_amo           (                   ),
         .slv1_req_mask          (                   ),
         .slv1_req_data          (                   ),
 
         .slv1_rsp_vld           ( dev_i_rsp_vld     ),
         .slv1_rsp_rdy           ( dev_i_rsp_rdy     ),
         .slv1_rsp_excp          ( dev_i_rsp_excp    ),
-        .slv1_rsp_data          ( dev_i_rsp_data    )
+        .slv1_rsp_data          ( dev_i_rsp_line    )
     );
 
-    uv_bus_fab_1x2
+    // PIPE_STAGE must stay 0, so LR & SC are accepted from LSU when
+    // the memory is, in the order of stores of other masters there.
+    uv_bus_fab_1x3
     #(
         .ALEN                   ( ALEN              ),
         .DLEN                   ( DLEN              ),
         .MLEN                   ( MLEN              ),
+        .PIPE_STAGE             ( 0                 ),
+        .SLV_AMO                ( 3'b101            ),
         .SLV0_BASE_LSB          ( MEM_BASE_LSB      ),
         .SLV0_BASE_ADDR         ( MEM_BASE_ADDR     ),
-        .SLV1_BASE_LSB          ( DEV_BASE_LSB      ),
-        .SLV1_BASE_ADDR         ( DEV_BASE_ADDR     )
+        .SLV1_BASE_LSB          ( LCL_BASE_LSB      ),
+        .SLV1_BASE_ADDR         ( LCL_BASE_ADDR     ),
+        .SLV2_BASE_LSB          ( DEV_BASE_LSB      ),
+        .SLV2_BASE_ADDR         ( DEV_BASE_ADDR     )
     )
     u_dbus_fab
     (
@@ -215,6 +251,7 @@ module uv_biu
         .mst_req_rdy            ( ls_req_rdy        ),
         .mst_req_read           ( ls_req_read       ),
         .mst_req_addr           ( ls_req_addr       ),
+        .mst_req_amo            ( ls_req_amo        ),
         .mst_req_mask           ( ls_req_mask       ),
         .mst_req_data           ( ls_req_data       ),
 
@@ -228,6 +265,7 @@ module uv_biu
         .slv0_req_rdy           ( mem_d_req_rdy     ),
         .slv0_req_read          ( mem_d_req_read    ),
         .slv0_req_addr          ( mem_d_req_addr    ),
+        .slv0_req_amo           ( mem_d_req_amo     ),
         .slv0_req_mask          ( mem_d_req_mask    ),
         .slv0_req_data          ( mem_d_req_data    ),
 
@@ -236,18 +274,33 @@ module uv_biu
         .slv0_rsp_excp          ( mem_d_rsp_excp    ),
         .slv0_rsp_data          ( mem_d_rsp_data    ),
 
-        // Slave 1.
-        .slv1_req_vld           ( dev_d_req_vld     ),
-        .slv1_req_rdy           ( dev_d_req_rdy     ),
-        .slv1_req_read          ( dev_d_req_read    ),
-        .slv1_req_addr          ( dev_d_req_addr    ),
-        .slv1_req_mask          ( dev_d_req_mask    ),
-        .slv1_req_data          ( dev_d_req_data    ),
-
-        .slv1_rsp_vld           ( dev_d_rsp_vld     ),
-        .slv1_rsp_rdy           ( dev_d_rsp_rdy     ),
-        .slv1_rsp_excp          ( dev_d_rsp_excp    ),
-        .slv1_rsp_data          ( dev_d_rsp_data    )
+        // Slave 1, which takes precedence over slave 2.
+        .slv1_req_vld           ( lcl_req_vld       ),
+        .slv1_req_rdy           ( lcl_req_rdy       ),
+        .slv1_req_read          ( lcl_req_read      ),
+        .slv1_req_addr          ( lcl_req_addr      ),
+        .slv1_req_amo           (                   ),
+        .slv1_req_mask          ( lcl_req_mask      ),
+        .slv1_req_data          ( lcl_req_data      ),
+
+        .slv1_rsp_vld           ( lcl_rsp_vld       ),
+        .slv1_rsp_rdy           ( lcl_rsp_rdy       ),
+        .slv1_rsp_excp          ( lcl_rsp_excp      ),
+        .slv1_rsp_data          ( lcl_rsp_data      ),
+
+        // Slave 2.
+        .slv2_req_vld           ( dev_d_req_vld     ),
+        .slv2_req_rdy           ( dev_d_req_rdy     ),
+        .slv2_req_read          ( dev_d_req_read    ),
+        .slv2_req_addr          ( dev_d_req_addr    ),
+        .slv2_req_amo           ( dev_d_req_amo     ),
+        .slv2_req_mask          ( dev_d_req_mask    ),
+        .slv2_req_data          ( dev_d_req_data    ),
+
+        .slv2_rsp_vld           ( dev_d_rsp_vld     ),
+        .slv2_rsp_rdy           ( dev_d_rsp_rdy     ),
+        .slv2_rsp_excp          ( dev_d_rsp_excp    ),
+        .slv2_rsp_data          ( dev_d_rsp_data    )
     );
 
 endmodule
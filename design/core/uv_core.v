@@ -25,12 +25,15 @@ module uv_core
     parameter MEM_BASE_ADDR         = 1'h1,     // 32'h80000000~32'hffffffff for memory in default.
     parameter DEV_BASE_LSB          = 31,       // LSB of base address for device bus access. 
     parameter DEV_BASE_ADDR         = 1'h0,     // 32'h00000000~32'h7fffffff for device in default.
+    parameter LCL_BASE_LSB          = 16,       // LSB of base address for core-local access.
+    parameter LCL_BASE_ADDR         = 16'h0200, // 32'h02000000~32'h0200ffff for core-local in default.
     parameter USE_INST_DAM          = 1'b1,     // Use Direct Accessed Memory for instruction rather than icache.
     parameter USE_DATA_DAM          = 1'b1,     // Use Direct Accessed Memory for data rather than dcache.
-    parameter INST_MEM_DW           = ILEN,     // IDAM data width or icache line size.
+    parameter INST_MEM_DW           = ILEN,     // IDAM fetching width or icache line size.
     parameter INST_MEM_MW           = MLEN,     // Unused now.
     parameter DATA_MEM_DW           = XLEN,     // DDAM data width or dcache line size.
-    parameter DATA_MEM_MW           = MLEN      // Byte strobe (mask) width for DDAM or dcache.
+    parameter DATA_MEM_MW           = MLEN,     // Byte strobe (mask) width for DDAM or dcache.
+    parameter RSV_INV_NUM           = 1         // Number of other masters storing to shared memory.
 )
 (
     input                           clk,
@@ -54,6 +57,7 @@ module uv_core
     input                           mem_d_req_rdy,
     output                          mem_d_req_read,
     output [ALEN-1:0]               mem_d_req_addr,
+    output [3:0]                    mem_d_req_amo,
     output [DATA_MEM_MW-1:0]        mem_d_req_mask,
     output [DATA_MEM_DW-1:0]        mem_d_req_data,
 
@@ -77,6 +81,7 @@ module uv_core
     input                           dev_d_req_rdy,
     output                          dev_d_req_read,
     output [ALEN-1:0]               dev_d_req_addr,
+    output [3:0]                    dev_d_req_amo,
     output [MLEN-1:0]               dev_d_req_mask,
     output [XLEN-1:0]               dev_d_req_data,
 
@@ -85,6 +90,19 @@ module uv_core
     input  [1:0]                    dev_d_rsp_excp,
     input  [XLEN-1:0]               dev_d_rsp_data,
 
+    // Core-local access.
+    output                          lcl_req_vld,
+    input                           lcl_req_rdy,
+    output                          lcl_req_read,
+    output [ALEN-1:0]               lcl_req_addr,
+    output [MLEN-1:0]               lcl_req_mask,
+    output [XLEN-1:0]               lcl_req_data,
+
+    input                           lcl_rsp_vld,
+    output                          lcl_rsp_rdy,
+    input  [1:0]                    lcl_rsp_excp,
+    input  [XLEN-1:0]               lcl_rsp_data,
+
     // Control & status to SOC.
     output                          tmr_irq_clr,
     output                          core_lp_mode,
@@ -94,10 +112,15 @@ module uv_core
     input                           irq_from_ext,
     input                           irq_from_sft,
     input                           irq_from_tmr,
-    input  [63:0]                   cnt_from_tmr
+    input  [63:0]                   cnt_from_tmr,
+
+    // Stores of other masters to invalidate the LR reservation.
+    input  [RSV_INV_NUM-1:0]        rsv_inv_vld,
+    input  [RSV_INV_NUM*ALEN-1:0]   rsv_inv_addr
 );
 
     localparam UDLY                 = 1;
+    localparam IFLEN                = USE_INST_DAM ? INST_MEM_DW : ILEN;
 
     wire                            if_req_vld;
     wire                            if_req_rdy;
@@ -106,12 +129,13 @@ module uv_core
     wire                            if_rsp_vld;
     wire                            if_rsp_rdy;
     wire [1:0]                      if_rsp_excp;
-    wire [ILEN-1:0]                 if_rsp_data;
+    wire [IFLEN-1:0]                if_rsp_data;
 
     wire                            ls_req_vld;
     wire                            ls_req_rdy;
     wire                            ls_req_read;
     wire [ALEN-1:0]                 ls_req_addr;
+    wire [3:0]                      ls_req_amo;
     wire [MLEN-1:0]                 ls_req_mask;
     wire [XLEN-1:0]                 ls_req_data;
 
@@ -127,12 +151,13 @@ module uv_core
     wire                            inst_mem_rsp_vld;
     wire                            inst_mem_rsp_rdy;
     wire [1:0]                      inst_mem_rsp_excp;
-    wire [ILEN-1:0]                 inst_mem_rsp_data;
+    wire [IFLEN-1:0]                inst_mem_rsp_data;
 
     wire                            data_mem_req_vld;
     wire                            data_mem_req_rdy;
     wire                            data_mem_req_read;
     wire [ALEN-1:0]                 data_mem_req_addr;
+    wire [3:0]                      data_mem_req_amo;
     wire [MLEN-1:0]                 data_mem_req_mask;
     wire [XLEN-1:0]                 data_mem_req_data;
 
@@ -159,7 +184,11 @@ module uv_core
         .ALEN                       ( ALEN                  ),
         .ILEN                       ( ILEN                  ),
         .XLEN                       ( XLEN                  ),
-        .MLEN                       ( MLEN                  )
+        .MLEN                       ( MLEN                  ),
+        .IFLEN                      ( IFLEN                 ),
+        .MEM_BASE_LSB               ( MEM_BASE_LSB          ),
+        .MEM_BASE_ADDR              ( MEM_BASE_ADDR         ),
+        .RSV_INV_NUM                ( RSV_INV_NUM           )
     )
     u_ucore
     (
@@ -184,6 +213,7 @@ module uv_core
         .ls_req_rdy                 ( ls_req_rdy            ),
         .ls_req_read                ( ls_req_read           ),
         .ls_req_addr                ( ls_req_addr           ),
+        .ls_req_amo                 ( ls_req_amo            ),
         .ls_req_mask                ( ls_req_mask           ),
         .ls_req_data                ( ls_req_data           ),
 
@@ -199,6 +229,10 @@ module uv_core
         .irq_from_sft               ( irq_from_sft          ),
         .irq_from_tmr               ( irq_from_tmr          ),
         .cnt_from_tmr               ( cnt_from_tmr          ),
+
+        // Stores of other masters.
+        .rsv_inv_vld                ( rsv_inv_vld           ),
+        .rsv_inv_addr               ( rsv_inv_addr          ),
         
         // To flush instruction channel.
         .fence_inst                 ( fence_inst            ),
@@ -216,10 +250,13 @@ module uv_core
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( XLEN                  ),
         .MLEN                       ( MLEN                  ),
+        .IFLEN                      ( IFLEN                 ),
         .MEM_BASE_LSB               ( MEM_BASE_LSB          ),
         .MEM_BASE_ADDR              ( MEM_BASE_ADDR         ),
         .DEV_BASE_LSB               ( DEV_BASE_LSB          ),
-        .DEV_BASE_ADDR              ( DEV_BASE_ADDR         )
+        .DEV_BASE_ADDR              ( DEV_BASE_ADDR         ),
+        .LCL_BASE_LSB               ( LCL_BASE_LSB          ),
+        .LCL_BASE_ADDR              ( LCL_BASE_ADDR         )
     )
     u_biu
     (
@@ -241,6 +278,7 @@ module uv_core
         .ls_req_rdy                 ( ls_req_rdy            ),
         .ls_req_read                ( ls_req_read           ),
         .ls_req_addr                ( ls_req_addr           ),
+        .ls_req_amo                 ( ls_req_amo            ),
         .ls_req_mask                ( ls_req_mask           ),
         .ls_req_data                ( ls_req_data           ),
 
@@ -264,6 +302,7 @@ module uv_core
         .mem_d_req_rdy              ( data_mem_req_rdy      ),
         .mem_d_req_read             ( data_mem_req_read     ),
         .mem_d_req_addr             ( data_mem_req_addr     ),
+        .mem_d_req_amo              ( data_mem_req_amo      ),
         .mem_d_req_mask             ( data_mem_req_mask     ),
         .mem_d_req_data             ( data_mem_req_data     ),
 
@@ -287,13 +326,27 @@ module uv_core
         .dev_d_req_rdy              ( dev_d_req_rdy         ),
         .dev_d_req_read             ( dev_d_req_read        ),
         .dev_d_req_addr             ( dev_d_req_addr        ),
+        .dev_d_req_amo              ( dev_d_req_amo         ),
         .dev_d_req_mask             ( dev_d_req_mask        ),
         .dev_d_req_data             ( dev_d_req_data        ),
 
         .dev_d_rsp_vld              ( dev_d_rsp_vld         ),
         .dev_d_rsp_rdy              ( dev_d_rsp_rdy         ),
         .dev_d_rsp_excp             ( dev_d_rsp_excp        ),
-        .dev_d_rsp_data             ( dev_d_rsp_data        )
+        .dev_d_rsp_data             ( dev_d_rsp_data        ),
+
+        // Access to core-local registers.
+        .lcl_req_vld                ( lcl_req_vld           ),
+        .lcl_req_rdy                ( lcl_req_rdy           ),
+        .lcl_req_read               ( lcl_req_read          ),
+        .lcl_req_addr               ( lcl_req_addr          ),
+        .lcl_req_mask               ( lcl_req_mask          ),
+        .lcl_req_data               ( lcl_req_data          ),
+
+        .lcl_rsp_vld                ( lcl_rsp_vld           ),
+        .lcl_rsp_rdy                ( lcl_rsp_rdy           ),
+        .lcl_rsp_excp               ( lcl_rsp_excp          ),
+        .lcl_rsp_data               ( lcl_rsp_data          )
     );
 
     generate
@@ -353,6 +406,7 @@ module uv_core
             assign mem_d_req_vld            = data_mem_req_vld;
             assign mem_d_req_read           = data_mem_req_read;
             assign mem_d_req_addr           = data_mem_req_addr;
+            assign mem_d_req_amo            = data_mem_req_amo;
             assign mem_d_req_data           = data_mem_req_data;
             assign mem_d_req_mask           = data_mem_req_mask;
             assign mem_d_rsp_rdy            = data_mem_rsp_rdy;
@@ -363,6 +417,9 @@ module uv_core
             assign data_mem_rsp_data        = mem_d_rsp_data;
         end
         else begin: gen_dcache
+            // AMOs are not done in the cache.
+            assign mem_d_req_amo            = 4'b0;
+
             uv_dcache
             #(
                 .ALEN                       ( ALEN                  ),
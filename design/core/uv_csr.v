@@ -537,7 +537,7 @@ module uv_csr
         if (~rst_n) begin
             misa[MXLEN-1:MXLEN-2] <= 2'b01;
             misa[MXLEN-3:26]      <= {(MXLEN-28){1'b0}};
-            misa[25:0]            <= 26'b000000_000000_0100010_0000000;
+            misa[25:0]            <= 26'b000000_000000_0100010_0000001;
         end
         else begin
             if (csr_wr_vld & op_misa) begin
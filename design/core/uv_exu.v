@@ -58,6 +58,9 @@ module uv_exu
     input                   id2ex_op_load,
     input                   id2ex_op_loadu,
     input                   id2ex_op_store,
+    input                   id2ex_op_lr,
+    input                   id2ex_op_sc,
+    input  [3:0]            id2ex_ls_amo,
     input  [MLEN-1:0]       id2ex_ls_mask,
     input  [XLEN-1:0]       id2ex_st_data,
     
@@ -104,6 +107,9 @@ module uv_exu
     output                  ex2ls_op_load,
     output                  ex2ls_op_loadu,
     output                  ex2ls_op_store,
+    output                  ex2ls_op_lr,
+    output                  ex2ls_op_sc,
+    output [3:0]            ex2ls_ls_amo,
     output [MLEN-1:0]       ex2ls_ls_mask,
     output [ALEN-1:0]       ex2ls_ld_addr,
     output [ALEN-1:0]       ex2ls_st_addr,
@@ -248,6 +254,9 @@ module uv_exu
     reg                     id2ex_op_load_r;
     reg                     id2ex_op_loadu_r;
     reg                     id2ex_op_store_r;
+    reg                     id2ex_op_lr_r;
+    reg                     id2ex_op_sc_r;
+    reg  [3:0]              id2ex_ls_amo_r;
     reg  [MLEN-1:0]         id2ex_ls_mask_r;
     reg  [XLEN-1:0]         id2ex_st_data_r;
     reg                     id2ex_op_bjp_r;
@@ -323,6 +332,9 @@ module uv_exu
     wire                    pipe_op_load;
     wire                    pipe_op_loadu;
     wire                    pipe_op_store;
+    wire                    pipe_op_lr;
+    wire                    pipe_op_sc;
+    wire [3:0]              pipe_ls_amo;
     wire [MLEN-1:0]         pipe_ls_mask;
     wire [XLEN-1:0]         pipe_st_data;
     wire                    pipe_op_bjp;
@@ -444,6 +456,9 @@ module uv_exu
     reg                     op_load_r;
     reg                     op_loadu_r;
     reg                     op_store_r;
+    reg                     op_lr_r;
+    reg                     op_sc_r;
+    reg  [3:0]              ls_amo_r;
     reg  [MLEN-1:0]         ls_mask_r;
     reg  [ALEN-1:0]         ld_addr_r;
     reg  [ALEN-1:0]         st_addr_r;
@@ -490,7 +505,7 @@ module uv_exu
     assign ex_stall_vld     = 1'b0;
     assign cs_stall_vld     = ex2ls_vld && csr_wr_vld_r && pipe_csr_rd &&
                               (csr_wr_idx_r == pipe_csr_idx);
-    assign ls_stall_vld     = ex2ls_vld && op_load_r && wb_act_r && (
+    assign ls_stall_vld     = ex2ls_vld && (op_load_r || op_store_r) && wb_act_r && (
                               ((wb_idx_r == pipe_rs1_idx) && pipe_rs1_vld) ||
                               ((wb_idx_r == pipe_rs2_idx) && pipe_rs2_vld));
 
@@ -560,6 +575,9 @@ module uv_exu
     assign pipe_op_load     = id2ex_real ? id2ex_op_load    : id2ex_op_load_r;
     assign pipe_op_loadu    = id2ex_real ? id2ex_op_loadu   : id2ex_op_loadu_r;
     assign pipe_op_store    = id2ex_real ? id2ex_op_store   : id2ex_op_store_r;
+    assign pipe_op_lr       = id2ex_real ? id2ex_op_lr      : id2ex_op_lr_r;
+    assign pipe_op_sc       = id2ex_real ? id2ex_op_sc      : id2ex_op_sc_r;
+    assign pipe_ls_amo      = id2ex_real ? id2ex_ls_amo     : id2ex_ls_amo_r;
     assign pipe_ls_mask     = id2ex_real ? id2ex_ls_mask    : id2ex_ls_mask_r;
     assign pipe_st_data     = id2ex_real ? id2ex_st_data    : id2ex_st_data_r;
     assign pipe_op_bjp      = id2ex_real ? id2ex_op_bjp     : id2ex_op_bjp_r;
@@ -825,6 +843,9 @@ module uv_exu
             id2ex_op_load_r   <= 1'b0;
             id2ex_op_loadu_r  <= 1'b0;
             id2ex_op_store_r  <= 1'b0;
+            id2ex_op_lr_r     <= 1'b0;
+            id2ex_op_sc_r     <= 1'b0;
+            id2ex_ls_amo_r    <= 4'b0;
             id2ex_ls_mask_r   <= {MLEN{1'b0}};
             id2ex_st_data_r   <= {XLEN{1'b0}};
             id2ex_op_bjp_r    <= 1'b0;
@@ -885,6 +906,9 @@ module uv_exu
                 id2ex_op_load_r   <= #UDLY id2ex_op_load;
                 id2ex_op_loadu_r  <= #UDLY id2ex_op_loadu;
                 id2ex_op_store_r  <= #UDLY id2ex_op_store;
+                id2ex_op_lr_r     <= #UDLY id2ex_op_lr;
+                id2ex_op_sc_r     <= #UDLY id2ex_op_sc;
+                id2ex_ls_amo_r    <= #UDLY id2ex_ls_amo;
                 id2ex_ls_mask_r   <= #UDLY id2ex_ls_mask;
                 id2ex_st_data_r   <= #UDLY id2ex_st_data;
                 id2ex_op_bjp_r    <= #UDLY id2ex_op_bjp;
@@ -985,6 +1009,9 @@ module uv_exu
             op_load_r  <= 1'b0;
             op_loadu_r <= 1'b0;
             op_store_r <= 1'b0;
+            op_lr_r    <= 1'b0;
+            op_sc_r    <= 1'b0;
+            ls_amo_r   <= 4'b0;
             ls_mask_r  <= {MLEN{1'b0}};
             ld_addr_r  <= {XLEN{1'b0}};
             st_addr_r  <= {XLEN{1'b0}};
@@ -995,6 +1022,9 @@ module uv_exu
                 op_load_r  <= #UDLY pipe_op_load;
                 op_loadu_r <= #UDLY pipe_op_loadu;
                 op_store_r <= #UDLY pipe_op_store;
+                op_lr_r    <= #UDLY pipe_op_lr;
+                op_sc_r    <= #UDLY pipe_op_sc;
+                ls_amo_r   <= #UDLY pipe_ls_amo;
                 ls_mask_r  <= #UDLY pipe_ls_mask;
                 if (pipe_op_load) begin
                     ld_addr_r <= #UDLY alu_res;
@@ -1010,6 +1040,9 @@ module uv_exu
     assign ex2ls_op_load  = op_load_r;
     assign ex2ls_op_loadu = op_loadu_r;
     assign ex2ls_op_store = op_store_r;
+    assign ex2ls_op_lr    = op_lr_r;
+    assign ex2ls_op_sc    = op_sc_r;
+    assign ex2ls_ls_amo   = ls_amo_r;
     assign ex2ls_ls_mask  = ls_mask_r;
     assign ex2ls_ld_addr  = ld_addr_r;
     assign ex2ls_st_addr  = st_addr_r;
@@ -76,6 +76,9 @@ module uv_idu
     output                  id2ex_op_load,
     output                  id2ex_op_loadu,
     output                  id2ex_op_store,
+    output                  id2ex_op_lr,
+    output                  id2ex_op_sc,
+    output [3:0]            id2ex_ls_amo,
     output [MLEN-1:0]       id2ex_ls_mask,
     output [XLEN-1:0]       id2ex_st_data,
     
@@ -322,6 +325,12 @@ module uv_idu
     wire                    inst_op_muldiv;
     wire                    inst_op_ia;
     wire                    inst_op_ls;
+    wire                    inst_op_atom;
+    wire                    inst_op_lr;
+    wire                    inst_op_sc;
+    wire                    inst_op_amo;
+    wire [4:0]              inst_funct5;
+    wire [3:0]              inst_amo;
 
     wire                    inst_op_beq;
     wire                    inst_op_bne;
@@ -478,6 +487,9 @@ module uv_idu
     reg                     op_load_r;
     reg                     op_loadu_r;
     reg                     op_store_r;
+    reg                     op_lr_r;
+    reg                     op_sc_r;
+    reg  [3:0]              ls_amo_r;
     reg  [MLEN-1:0]         ls_mask_r;
     reg  [XLEN-1:0]         st_data_r;
     
@@ -688,8 +700,26 @@ module uv_idu
     assign inst_op_csrrc    = inst_op_csr && (inst_funct3[1:0] == 2'b11);
     assign inst_op_csrimm   = inst_op_csr & inst_funct3[2];
     assign inst_op_muldiv   = inst_op_arith & inst_funct7_1;
-    
-    assign inst_op_ls       = inst_op_load  | inst_op_store;
+
+    // Decode atomics, where aq & rl are met by the in-order LSU.
+    assign inst_funct5      = inst_funct7[6:2];
+    assign inst_op_atom     = inst_opcode_lo_3 & inst_opcode_me_3 & inst_opcode_hi_1 & inst_funct3_2;
+    assign inst_op_lr       = inst_op_atom && (inst_funct5 == 5'b00010) && (inst_rs2_idx == 5'b0);
+    assign inst_op_sc       = inst_op_atom && (inst_funct5 == 5'b00011);
+    assign inst_op_amo      = inst_op_atom & (|inst_amo);
+    assign inst_amo         = inst_funct5 == 5'b00001 ? 4'h1
+                            : inst_funct5 == 5'b00000 ? 4'h2
+                            : inst_funct5 == 5'b00100 ? 4'h3
+                            : inst_funct5 == 5'b01100 ? 4'h4
+                            : inst_funct5 == 5'b01000 ? 4'h5
+                            : inst_funct5 == 5'b10000 ? 4'h6
+                            : inst_funct5 == 5'b10100 ? 4'h7
+                            : inst_funct5 == 5'b11000 ? 4'h8
+                            : inst_funct5 == 5'b11100 ? 4'h9
+                            : 4'h0;
+
+    assign inst_op_ls       = inst_op_load  | inst_op_store
+                            | inst_op_lr    | inst_op_sc    | inst_op_amo;
     assign inst_op_ia       = inst_op_imm   | inst_op_arith;
     assign inst_f3_sft      = inst_funct3_1 | inst_funct3_5;
     assign inst_f7_sft      = inst_funct7_0 | inst_funct7_5_1;
@@ -1057,16 +1087,22 @@ module uv_idu
             op_load_r  <= 1'b0;
             op_loadu_r <= 1'b0;
             op_store_r <= 1'b0;
+            op_lr_r    <= 1'b0;
+            op_sc_r    <= 1'b0;
+            ls_amo_r   <= 4'b0;
             ls_mask_r  <= {MLEN{1'b0}};
             st_data_r  <= {XLEN{1'b0}};
         end
         else begin
             if (pipe_nxt) begin
-                op_load_r  <= #UDLY inst_op_load;
+                op_load_r  <= #UDLY inst_op_load | inst_op_lr;
                 op_loadu_r <= #UDLY inst_op_loadu;
-                op_store_r <= #UDLY inst_op_store;
+                op_store_r <= #UDLY inst_op_store | inst_op_sc | inst_op_amo;
+                op_lr_r    <= #UDLY inst_op_lr;
+                op_sc_r    <= #UDLY inst_op_sc;
+                ls_amo_r   <= #UDLY {4{inst_op_amo}} & inst_amo;
                 ls_mask_r  <= #UDLY {MLEN{inst_op_ls}} & ls_mask[MLEN-1:0];
-                if (inst_op_store) begin
+                if (inst_op_store | inst_op_sc | inst_op_amo) begin
                     //st_data_r  <= #UDLY id2rf_rb_data;
                     st_data_r  <= #UDLY rs2_data;
                 end
@@ -1077,6 +1113,9 @@ module uv_idu
     assign id2ex_op_load  = op_load_r;
     assign id2ex_op_loadu = op_loadu_r;
     assign id2ex_op_store = op_store_r;
+    assign id2ex_op_lr    = op_lr_r;
+    assign id2ex_op_sc    = op_sc_r;
+    assign id2ex_ls_amo   = ls_amo_r;
     assign id2ex_ls_mask  = ls_mask_r;
     assign id2ex_st_data  = st_data_r;
     
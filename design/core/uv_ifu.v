@@ -7,6 +7,8 @@
 //
 // Description:
 //      Instruction Fetching Unit.
+//      Fetches wider than ILEN are aligned by a line buffer,
+//      so sequential code only accesses memory once per line.
 //      FIXME: Multiple outstanding requests.
 //************************************************************
 
@@ -14,9 +16,12 @@
 
 module uv_ifu
 #(
-    parameter ALEN = 32,
-    parameter ILEN = 32,
-    parameter XLEN = 32
+    parameter ALEN          = 32,
+    parameter ILEN          = 32,
+    parameter XLEN          = 32,
+    parameter IFLEN         = ILEN,     // Fetching bit width.
+    parameter MEM_BASE_LSB  = 31,       // Only memory bus returns IFLEN-bit lines.
+    parameter MEM_BASE_ADDR = 1'h1
 )
 (
     input                   clk,
@@ -30,7 +35,7 @@ module uv_ifu
     input                   if2mem_rsp_vld,
     output                  if2mem_rsp_rdy,
     input  [1:0]            if2mem_rsp_excp,
-    input  [ILEN-1:0]       if2mem_rsp_data,
+    input  [IFLEN-1:0]      if2mem_rsp_data,
 
     // Request to BPU.
     output                  if2bp_vld,
@@ -80,6 +85,9 @@ module uv_ifu
 );
 
     localparam UDLY         = 1;
+    localparam IAB_WO       = $clog2(ILEN / 8);
+    localparam IAB_OW       = $clog2(IFLEN / 8);
+    localparam IAB_IW       = IFLEN > ILEN ? IAB_OW - IAB_WO : 1;
     
     // Pipeline control.
     wire                    pipe_flush;
@@ -132,9 +140,17 @@ module uv_ifu
     wire                    mem_req;
     reg                     mem_req_r;
 
-    wire                    if2mem_req_wait;
-    wire                    if2mem_req_fire;
-    wire                    if2mem_rsp_fire;
+    wire                    fch_req_vld;
+    wire                    fch_req_rdy;
+    wire [ALEN-1:0]         fch_req_addr;
+    wire                    fch_rsp_vld;
+    wire                    fch_rsp_rdy;
+    wire [1:0]              fch_rsp_excp;
+    wire [ILEN-1:0]         fch_rsp_data;
+
+    wire                    fch_req_wait;
+    wire                    fch_req_fire;
+    wire                    fch_rsp_fire;
 
     // Exceptions.
     reg                     acc_fault_r;
@@ -142,6 +158,30 @@ module uv_ifu
 
     reg                     acc_fault_t;
     reg                     mis_align_t;
+
+    // Instruction alignment buffer.
+    wire                    iab_line_req;
+    wire                    iab_tag_hit;
+    wire                    iab_fill_fire;
+    wire                    iab_hit;
+    wire                    iab_hit_fire;
+    wire                    iab_mem_free;
+    wire                    iab_rsp_free;
+    wire                    iab_mem_req_fire;
+    wire                    iab_mem_rsp_fire;
+    wire [IAB_IW-1:0]       iab_req_idx;
+    wire [IAB_IW-1:0]       iab_rsp_idx;
+    wire [IFLEN-1:0]        iab_rsp_line;
+    wire [IFLEN-1:0]        iab_rsp_sft;
+
+    reg                     iab_line_vld_r;
+    reg  [ALEN-IAB_OW-1:0]  iab_line_tag_r;
+    reg  [IFLEN-1:0]        iab_line_data_r;
+    reg                     iab_fill_r;
+    reg                     iab_mem_pend_r;
+    reg                     iab_hit_rsp_r;
+    reg  [IAB_IW-1:0]       iab_mem_idx_r;
+    reg  [IAB_IW-1:0]       iab_hit_idx_r;
     
     // Control pipeline.
     assign pipe_flush       = id_br_flush | ex_br_flush | trap_flush | fence_inst;
@@ -159,26 +199,26 @@ module uv_ifu
     
     // Set bpu ports.
     // assign if2bp_vld        = inst_rdy & if2id_rdy;
-    assign if2bp_vld        = (if2mem_rsp_fire | (|bp_inst_mask_r)) & if2id_rdy_r;
+    assign if2bp_vld        = (fch_rsp_fire | (|bp_inst_mask_r)) & if2id_rdy_r;
     assign if2bp_pc         = pc_r;
-    // assign if2bp_inst       = if2mem_rsp_fire ? if2mem_rsp_data : inst_t;
+    // assign if2bp_inst       = fch_rsp_fire ? fch_rsp_data : inst_t;
     assign if2bp_inst       = bp_inst_mask_r[0] ? bp_inst_t
                             : bp_inst_mask_r[1] ? bp_inst_tt
-                            : if2mem_rsp_data;
+                            : fch_rsp_data;
     assign if2bp_stall      = ~if2id_rdy_r;
     
     // Set memory request.
     //assign mem_req        = if2id_rdy & (~if_stall) & pc_vld;
     assign mem_req          = pc_vld & (~if_stall);
-    assign if2mem_req_vld   = mem_req | mem_req_r;
-    assign if2mem_req_addr  = pc_vld ? pc_nxt : pc_r;
-    assign if2mem_req_wait  = if2mem_req_vld & ~if2mem_req_rdy;
-    assign if2mem_req_fire  = if2mem_req_vld & if2mem_req_rdy;
+    assign fch_req_vld      = mem_req | mem_req_r;
+    assign fch_req_addr     = pc_vld ? pc_nxt : pc_r;
+    assign fch_req_wait     = fch_req_vld & ~fch_req_rdy;
+    assign fch_req_fire     = fch_req_vld & fch_req_rdy;
 
     // Get Instruction.
-    assign if2mem_rsp_rdy   = 1'b1;
-    assign if2mem_rsp_fire  = if2mem_rsp_vld & if2mem_rsp_rdy;
-    assign inst_rdy         = if2mem_rsp_fire | (|inst_mask_r);
+    assign fch_rsp_rdy      = 1'b1;
+    assign fch_rsp_fire     = fch_rsp_vld & fch_rsp_rdy;
+    assign inst_rdy         = fch_rsp_fire | (|inst_mask_r);
     
     // Set IDU ports.
     assign if2id_vld        = if2id_vld_r & (~pipe_flush);
@@ -482,10 +522,10 @@ module uv_ifu
         else begin
             if (inst_rdy & pipe_nxt) begin
             //if (inst_rdy) begin
-                // inst_r <= #UDLY if2mem_rsp_fire ? if2mem_rsp_data : inst_t;
+                // inst_r <= #UDLY fch_rsp_fire ? fch_rsp_data : inst_t;
                 inst_r <= #UDLY inst_mask_r[0] ? inst_t
                               : inst_mask_r[1] ? inst_tt
-                              : if2mem_rsp_data;
+                              : fch_rsp_data;
             end
         end
     end
@@ -498,25 +538,25 @@ module uv_ifu
         end
         else begin
             if (~pipe_nxt) begin
-                if (if2mem_rsp_fire & (~inst_mask_r[0])) begin
-                    inst_t  <= #UDLY if2mem_rsp_data;
+                if (fch_rsp_fire & (~inst_mask_r[0])) begin
+                    inst_t  <= #UDLY fch_rsp_data;
                 end
-                else if (if2mem_rsp_fire & inst_mask_r[0]) begin
-                    inst_tt <= #UDLY if2mem_rsp_data;
+                else if (fch_rsp_fire & inst_mask_r[0]) begin
+                    inst_tt <= #UDLY fch_rsp_data;
                 end
-                else if (if2mem_rsp_fire) begin
+                else if (fch_rsp_fire) begin
                     $display("Error!");
                 end
             end
             else begin
-                if (if2mem_rsp_fire & inst_mask_r[1]) begin
+                if (fch_rsp_fire & inst_mask_r[1]) begin
                     inst_t  <= #UDLY inst_tt;
-                    inst_tt <= #UDLY if2mem_rsp_data;
+                    inst_tt <= #UDLY fch_rsp_data;
                 end
-                else if (if2mem_rsp_fire & inst_mask_r[0]) begin
-                    inst_t  <= #UDLY if2mem_rsp_data;
+                else if (fch_rsp_fire & inst_mask_r[0]) begin
+                    inst_t  <= #UDLY fch_rsp_data;
                 end
-                else if ((~if2mem_rsp_fire) & inst_mask_r[1]) begin
+                else if ((~fch_rsp_fire) & inst_mask_r[1]) begin
                     inst_t  <= #UDLY inst_tt;
                 end
             end
@@ -532,27 +572,27 @@ module uv_ifu
                 inst_mask_r <= #UDLY 2'b00;
             end
             else if (~pipe_nxt) begin
-                if (if2mem_rsp_fire & (~inst_mask_r[0])) begin
+                if (fch_rsp_fire & (~inst_mask_r[0])) begin
                     inst_mask_r <= #UDLY 2'b01;
                 end
-                else if (if2mem_rsp_fire & inst_mask_r[0]) begin
+                else if (fch_rsp_fire & inst_mask_r[0]) begin
                     inst_mask_r <= #UDLY 2'b11;
                 end
-                else if (if2mem_rsp_fire) begin
+                else if (fch_rsp_fire) begin
                     $display("Error!");
                 end
             end
             else begin
-                if (if2mem_rsp_fire & inst_mask_r[1]) begin
+                if (fch_rsp_fire & inst_mask_r[1]) begin
                     inst_mask_r <= #UDLY 2'b11;
                 end
-                else if (if2mem_rsp_fire & inst_mask_r[0]) begin
+                else if (fch_rsp_fire & inst_mask_r[0]) begin
                     inst_mask_r <= #UDLY 2'b01;
                 end
-                else if ((~if2mem_rsp_fire) & inst_mask_r[1]) begin
+                else if ((~fch_rsp_fire) & inst_mask_r[1]) begin
                     inst_mask_r <= #UDLY 2'b01;
                 end
-                else if ((~if2mem_rsp_fire) & inst_mask_r[0]) begin
+                else if ((~fch_rsp_fire) & inst_mask_r[0]) begin
                     inst_mask_r <= #UDLY 2'b00;
                 end
             end
@@ -566,22 +606,22 @@ module uv_ifu
         end
         else begin
             if (~pc_vld) begin
-                if (if2mem_rsp_fire & (~bp_inst_mask_r[0])) begin
-                    bp_inst_t  <= #UDLY if2mem_rsp_data;
+                if (fch_rsp_fire & (~bp_inst_mask_r[0])) begin
+                    bp_inst_t  <= #UDLY fch_rsp_data;
                 end
-                else if (if2mem_rsp_fire & bp_inst_mask_r[0]) begin
-                    bp_inst_tt <= #UDLY if2mem_rsp_data;
+                else if (fch_rsp_fire & bp_inst_mask_r[0]) begin
+                    bp_inst_tt <= #UDLY fch_rsp_data;
                 end
             end
             else begin
-                if (if2mem_rsp_fire & bp_inst_mask_r[1]) begin
+                if (fch_rsp_fire & bp_inst_mask_r[1]) begin
                     bp_inst_t  <= #UDLY bp_inst_tt;
-                    bp_inst_tt <= #UDLY if2mem_rsp_data;
+                    bp_inst_tt <= #UDLY fch_rsp_data;
                 end
-                else if (if2mem_rsp_fire & bp_inst_mask_r[0]) begin
-                    bp_inst_t  <= #UDLY if2mem_rsp_data;
+                else if (fch_rsp_fire & bp_inst_mask_r[0]) begin
+                    bp_inst_t  <= #UDLY fch_rsp_data;
                 end
-                else if ((~if2mem_rsp_fire) & bp_inst_mask_r[1]) begin
+                else if ((~fch_rsp_fire) & bp_inst_mask_r[1]) begin
                     bp_inst_t  <= #UDLY bp_inst_tt;
                 end
             end
@@ -597,24 +637,24 @@ module uv_ifu
                 bp_inst_mask_r <= #UDLY 2'b00;
             end
             else if (~pc_vld) begin
-                if (if2mem_rsp_fire & (~bp_inst_mask_r[0])) begin
+                if (fch_rsp_fire & (~bp_inst_mask_r[0])) begin
                     bp_inst_mask_r <= #UDLY 2'b01;
                 end
-                else if (if2mem_rsp_fire & bp_inst_mask_r[0]) begin
+                else if (fch_rsp_fire & bp_inst_mask_r[0]) begin
                     bp_inst_mask_r <= #UDLY 2'b11;
                 end
             end
             else begin
-                if (if2mem_rsp_fire & bp_inst_mask_r[1]) begin
+                if (fch_rsp_fire & bp_inst_mask_r[1]) begin
                     bp_inst_mask_r <= #UDLY 2'b11;
                 end
-                else if (if2mem_rsp_fire & bp_inst_mask_r[0]) begin
+                else if (fch_rsp_fire & bp_inst_mask_r[0]) begin
                     bp_inst_mask_r <= #UDLY 2'b01;
                 end
-                else if ((~if2mem_rsp_fire) & bp_inst_mask_r[1]) begin
+                else if ((~fch_rsp_fire) & bp_inst_mask_r[1]) begin
                     bp_inst_mask_r <= #UDLY 2'b01;
                 end
-                else if ((~if2mem_rsp_fire) & bp_inst_mask_r[0]) begin
+                else if ((~fch_rsp_fire) & bp_inst_mask_r[0]) begin
                     bp_inst_mask_r <= #UDLY 2'b00;
                 end
             end
@@ -630,8 +670,8 @@ module uv_ifu
         else begin
             if (inst_rdy & pipe_nxt) begin
             //if (inst_rdy) begin
-                acc_fault_r <= #UDLY if2mem_rsp_fire ? if2mem_rsp_excp[0] : acc_fault_t;
-                mis_align_r <= #UDLY if2mem_rsp_fire ? if2mem_rsp_excp[1] : mis_align_t;
+                acc_fault_r <= #UDLY fch_rsp_fire ? fch_rsp_excp[0] : acc_fault_t;
+                mis_align_r <= #UDLY fch_rsp_fire ? fch_rsp_excp[1] : mis_align_t;
             end
         end
     end
@@ -643,9 +683,9 @@ module uv_ifu
             mis_align_t <= 1'b0;
         end
         else begin
-            if (if2mem_rsp_fire) begin
-                acc_fault_t <= #UDLY if2mem_rsp_excp[0];
-                mis_align_t <= #UDLY if2mem_rsp_excp[1];
+            if (fch_rsp_fire) begin
+                acc_fault_t <= #UDLY fch_rsp_excp[0];
+                mis_align_t <= #UDLY fch_rsp_excp[1];
             end
         end
     end
@@ -656,7 +696,7 @@ module uv_ifu
             inst_rdy_r <= 1'b0;
         end
         else begin
-            if (if2mem_rsp_fire & (~if2id_rdy)) begin
+            if (fch_rsp_fire & (~if2id_rdy)) begin
                 inst_rdy_r <= #UDLY 1'b1;
             end
             else if (if2id_rdy) begin
@@ -671,7 +711,7 @@ module uv_ifu
             mem_req_r <= 1'b0;
         end
         else begin
-            if (if2mem_req_fire) begin
+            if (fch_req_fire) begin
                 mem_req_r <= #UDLY 1'b0;
             end
             else if (mem_req) begin
@@ -680,4 +720,129 @@ module uv_ifu
         end
     end
 
+    // Align fetched lines to instructions.
+    generate
+        if (IFLEN > ILEN) begin: gen_inst_align_buf
+            // Only memory lines are buffered, device responses carry one instruction.
+            assign iab_line_req     = fch_req_addr[ALEN-1:MEM_BASE_LSB] == MEM_BASE_ADDR;
+            assign iab_tag_hit      = fch_req_addr[ALEN-1:IAB_OW] == iab_line_tag_r;
+            assign iab_fill_fire    = iab_fill_r & iab_mem_rsp_fire & (~(|if2mem_rsp_excp));
+            assign iab_hit          = iab_tag_hit & (iab_line_vld_r | iab_fill_fire) & (~fence_inst);
+
+            // Keep responses in order: one memory request or buffer hit in flight.
+            assign iab_mem_free     = (~iab_mem_pend_r) | iab_mem_rsp_fire;
+            assign iab_rsp_free     = (~iab_hit_rsp_r) | fch_rsp_rdy;
+            assign iab_hit_fire     = fch_req_vld & iab_hit & iab_mem_free & iab_rsp_free;
+            assign iab_mem_req_fire = if2mem_req_vld & if2mem_req_rdy;
+            assign iab_mem_rsp_fire = if2mem_rsp_vld & if2mem_rsp_rdy;
+            assign iab_req_idx      = fch_req_addr[IAB_OW-1:IAB_WO];
+
+            assign if2mem_req_vld   = fch_req_vld & (~iab_hit) & iab_mem_free & iab_rsp_free;
+            assign if2mem_req_addr  = iab_line_req ? {fch_req_addr[ALEN-1:IAB_OW], {IAB_OW{1'b0}}}
+                                    : fch_req_addr;
+            assign fch_req_rdy      = iab_hit ? iab_hit_fire
+                                    : if2mem_req_rdy & iab_mem_free & iab_rsp_free;
+
+            assign if2mem_rsp_rdy   = fch_rsp_rdy & (~iab_hit_rsp_r);
+            assign fch_rsp_vld      = iab_hit_rsp_r | if2mem_rsp_vld;
+            assign fch_rsp_excp     = iab_hit_rsp_r ? 2'b00 : if2mem_rsp_excp;
+            assign iab_rsp_line     = iab_hit_rsp_r ? iab_line_data_r : if2mem_rsp_data;
+            assign iab_rsp_idx      = iab_hit_rsp_r ? iab_hit_idx_r : iab_mem_idx_r;
+            assign iab_rsp_sft      = iab_rsp_line >> (iab_rsp_idx * ILEN);
+            assign fch_rsp_data     = iab_rsp_sft[ILEN-1:0];
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    iab_mem_pend_r <= 1'b0;
+                end
+                else begin
+                    if (iab_mem_req_fire) begin
+                        iab_mem_pend_r <= #UDLY 1'b1;
+                    end
+                    else if (iab_mem_rsp_fire) begin
+                        iab_mem_pend_r <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    iab_fill_r    <= 1'b0;
+                    iab_mem_idx_r <= {IAB_IW{1'b0}};
+                end
+                else begin
+                    if (iab_mem_req_fire) begin
+                        iab_fill_r    <= #UDLY iab_line_req;
+                        iab_mem_idx_r <= #UDLY iab_req_idx;
+                    end
+                    else if (iab_mem_rsp_fire | fence_inst) begin
+                        iab_fill_r    <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    iab_line_vld_r <= 1'b0;
+                end
+                else begin
+                    if (fence_inst | (iab_mem_req_fire & iab_line_req)) begin
+                        iab_line_vld_r <= #UDLY 1'b0;
+                    end
+                    else if (iab_fill_fire) begin
+                        iab_line_vld_r <= #UDLY 1'b1;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    iab_line_tag_r <= {(ALEN-IAB_OW){1'b0}};
+                end
+                else begin
+                    if (iab_mem_req_fire & iab_line_req) begin
+                        iab_line_tag_r <= #UDLY fch_req_addr[ALEN-1:IAB_OW];
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    iab_line_data_r <= {IFLEN{1'b0}};
+                end
+                else begin
+                    if (iab_fill_fire) begin
+                        iab_line_data_r <= #UDLY if2mem_rsp_data;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    iab_hit_rsp_r <= 1'b0;
+                    iab_hit_idx_r <= {IAB_IW{1'b0}};
+                end
+                else begin
+                    if (iab_hit_fire) begin
+                        iab_hit_rsp_r <= #UDLY 1'b1;
+                        iab_hit_idx_r <= #UDLY iab_req_idx;
+                    end
+                    else if (fch_rsp_rdy) begin
+                        iab_hit_rsp_r <= #UDLY 1'b0;
+                    end
+                end
+            end
+        end
+        else begin: gen_inst_align_bypass
+            assign if2mem_req_vld   = fch_req_vld;
+            assign if2mem_req_addr  = fch_req_addr;
+            assign fch_req_rdy      = if2mem_req_rdy;
+
+            assign if2mem_rsp_rdy   = fch_rsp_rdy;
+            assign fch_rsp_vld      = if2mem_rsp_vld;
+            assign fch_rsp_excp     = if2mem_rsp_excp;
+            assign fch_rsp_data     = if2mem_rsp_data[ILEN-1:0];
+        end
+    endgenerate
+
 endmodule
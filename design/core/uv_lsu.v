@@ -6,7 +6,13 @@
 // Designer: Owen
 //
 // Description:
-//      Load-Store Unit.
+//      Load-Store Unit. LR sets a reservation of the word,
+//      which SC, traps & MRET clear, and so do stores of other
+//      masters to the word. SC fails early if the reservation
+//      misses when it is first presented, or is sent to the
+//      memory, which keeps the reservation to check & responds
+//      the result. LR, SC & AMOs are sent with the AMO code,
+//      and AMOs respond with the old data.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,7 +22,8 @@ module uv_lsu
     parameter ALEN = 32,
     parameter ILEN = 32,
     parameter XLEN = 32,
-    parameter MLEN = XLEN / 8
+    parameter MLEN = XLEN / 8,
+    parameter RSV_INV_NUM = 1
 )
 (
     input                   clk,
@@ -30,6 +37,9 @@ module uv_lsu
     input                   ex2ls_op_load,
     input                   ex2ls_op_loadu,
     input                   ex2ls_op_store,
+    input                   ex2ls_op_lr,
+    input                   ex2ls_op_sc,
+    input  [3:0]            ex2ls_ls_amo,
     input  [MLEN-1:0]       ex2ls_ls_mask,
     input  [ALEN-1:0]       ex2ls_ld_addr,
     input  [ALEN-1:0]       ex2ls_st_addr,
@@ -64,6 +74,7 @@ module uv_lsu
     input                   ls2mem_req_rdy,
     output                  ls2mem_req_read,
     output [ALEN-1:0]       ls2mem_req_addr,
+    output [3:0]            ls2mem_req_amo,
     output [MLEN-1:0]       ls2mem_req_mask,
     output [XLEN-1:0]       ls2mem_req_data,
 
@@ -110,12 +121,18 @@ module uv_lsu
 
     // Flush control from trap.
     input                   trap_flush,
+
+    // Stores of other masters to invalidate the reservation.
+    input  [RSV_INV_NUM-1:0] rsv_inv_vld,
+    input  [RSV_INV_NUM*ALEN-1:0] rsv_inv_addr,
     
     // FW info from EXU
     input  [4:0]            ex2ls_rs2_idx
 );
 
     localparam UDLY         = 1;
+    localparam AMO_LR       = 4'ha;
+    localparam AMO_SC       = 4'hb;
     genvar i;
 
     // Pipeline flush.
@@ -132,6 +149,9 @@ module uv_lsu
     reg                     ex2ls_op_load_r;
     reg                     ex2ls_op_loadu_r;
     reg                     ex2ls_op_store_r;
+    reg                     ex2ls_op_lr_r;
+    reg                     ex2ls_op_sc_r;
+    reg  [3:0]              ex2ls_ls_amo_r;
     reg  [MLEN-1:0]         ex2ls_ls_mask_r;
     reg  [ALEN-1:0]         ex2ls_ld_addr_r;
     reg  [ALEN-1:0]         ex2ls_st_addr_r;
@@ -158,6 +178,9 @@ module uv_lsu
     wire                    pipe_op_load;
     wire                    pipe_op_loadu;
     wire                    pipe_op_store;
+    wire                    pipe_op_lr;
+    wire                    pipe_op_sc;
+    wire [3:0]              pipe_ls_amo;
     wire [MLEN-1:0]         pipe_ls_mask;
     wire [ALEN-1:0]         pipe_ld_addr;
     wire [ALEN-1:0]         pipe_st_addr;
@@ -192,6 +215,16 @@ module uv_lsu
     wire [XLEN-1:0]         mem_wb_data;
     wire                    mem_ld_wait;
     wire                    mem_st_wait;
+    wire                    mem_req_rtn;
+
+    // Reservation for LR/SC.
+    reg                     lr_vld_r;
+    reg  [ALEN-1:0]         lr_addr_r;
+    wire [RSV_INV_NUM-1:0]  rsv_inv_hit;
+    wire                    sc_miss;
+    wire                    sc_fail;
+    reg                     sc_wait_r;
+    reg                     sc_fail_r;
     
     // Forwarding at LSU ifself.
     wire                    st_rs2_frm_wb;
@@ -206,6 +239,8 @@ module uv_lsu
     reg  [MLEN-1:0]         mem_ld_mask_p;
     reg  [XLEN-1:0]         mem_ld_data_r;
     reg                     mem_ld_usgn_p;
+    reg                     mem_ld_wb_p;
+    reg                     mem_amo_p;
     reg                     mem_ld_req_r;
     reg                     mem_st_req_r;
     
@@ -254,6 +289,9 @@ module uv_lsu
     assign pipe_op_load     = ex2ls_real ? ex2ls_op_load     : ex2ls_op_load_r;
     assign pipe_op_loadu    = ex2ls_real ? ex2ls_op_loadu    : ex2ls_op_loadu_r;
     assign pipe_op_store    = ex2ls_real ? ex2ls_op_store    : ex2ls_op_store_r;
+    assign pipe_op_lr       = ex2ls_real ? ex2ls_op_lr       : ex2ls_op_lr_r;
+    assign pipe_op_sc       = ex2ls_real ? ex2ls_op_sc       : ex2ls_op_sc_r;
+    assign pipe_ls_amo      = ex2ls_real ? ex2ls_ls_amo      : ex2ls_ls_amo_r;
     assign pipe_ls_mask     = ex2ls_real ? ex2ls_ls_mask     : ex2ls_ls_mask_r;
     assign pipe_ld_addr     = ex2ls_real ? ex2ls_ld_addr     : ex2ls_ld_addr_r;
     assign pipe_st_addr     = ex2ls_real ? ex2ls_st_addr     : ex2ls_st_addr_r;
@@ -277,17 +315,47 @@ module uv_lsu
     assign pipe_env_call    = ex2ls_real ? ex2ls_env_call    : ex2ls_env_call_r;
     assign pipe_env_break   = ex2ls_real ? ex2ls_env_break   : ex2ls_env_break_r;
 
+    // Stores of other masters to the reserved word.
+    generate
+        for (i = 0; i < RSV_INV_NUM; i = i + 1) begin: gen_rsv_inv_hit
+            assign rsv_inv_hit[i] = rsv_inv_vld[i] & (rsv_inv_addr[i*ALEN+2+:ALEN-2] == lr_addr_r[ALEN-1:2]);
+        end
+    endgenerate
+
+    // SC fails without the reservation of its word, decided once when
+    // it is presented, so its request is held till accepted.
+    assign sc_miss          = pipe_op_sc & ~(lr_vld_r & (pipe_st_addr[ALEN-1:2] == lr_addr_r[ALEN-1:2]));
+    assign sc_fail          = sc_wait_r ? sc_fail_r : sc_miss;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            sc_wait_r <= 1'b0;
+            sc_fail_r <= 1'b0;
+        end
+        else begin
+            if (pipe_flush | ex2ls_fire) begin
+                sc_wait_r <= #UDLY 1'b0;
+            end
+            else if (ex2ls_vld & pipe_op_sc & (~sc_wait_r)) begin
+                sc_wait_r <= #UDLY 1'b1;
+                sc_fail_r <= #UDLY sc_miss;
+            end
+        end
+    end
+
     // Memory access.
     assign ls2mem_req_vld   = ex2ls_vld & (~pipe_has_excp)
-                            & ((pipe_wb_act & pipe_op_load) | pipe_op_store);
+                            & ((pipe_wb_act & pipe_op_load) | pipe_op_lr | (pipe_op_store & (~sc_fail)));
     assign ls2mem_req_read  = ~pipe_op_store;
     assign ls2mem_req_addr  = pipe_op_store ? pipe_st_addr : pipe_ld_addr;
+    assign ls2mem_req_amo   = pipe_op_lr ? AMO_LR : pipe_op_sc ? AMO_SC : pipe_ls_amo;
     assign ls2mem_req_mask  = pipe_ls_mask;
     assign ls2mem_req_data  = st_rs2_frm_wb ? wb_data : pipe_st_data;
     assign ls2mem_rsp_rdy   = 1'b1;
 
     assign mem_req_read     = mem_req_fire ? ls2mem_req_read : mem_ld_req_r;
     assign mem_req_fire     = ls2mem_req_vld & ls2mem_req_rdy;
+    assign mem_req_rtn      = ls2mem_req_read | pipe_op_sc | (|pipe_ls_amo);
     assign mem_rsp_fire     = ls2mem_rsp_vld & ls2mem_rsp_rdy;
     assign mem_ld_fire      = mem_ld_req_r & mem_rsp_fire;
     assign mem_ld_wait      = mem_ld_req_r & (~mem_ld_fire);
@@ -348,6 +416,9 @@ module uv_lsu
             ex2ls_op_load_r     <= 1'b0;
             ex2ls_op_loadu_r    <= 1'b0;
             ex2ls_op_store_r    <= 1'b0;
+            ex2ls_op_lr_r       <= 1'b0;
+            ex2ls_op_sc_r       <= 1'b0;
+            ex2ls_ls_amo_r      <= 4'b0;
             ex2ls_ls_mask_r     <= {MLEN{1'b0}};
             ex2ls_ld_addr_r     <= {ALEN{1'b0}};
             ex2ls_st_addr_r     <= {ALEN{1'b0}};
@@ -376,6 +447,9 @@ module uv_lsu
                 ex2ls_op_load_r     <= #UDLY ex2ls_op_load;
                 ex2ls_op_loadu_r    <= #UDLY ex2ls_op_loadu;
                 ex2ls_op_store_r    <= #UDLY ex2ls_op_store;
+                ex2ls_op_lr_r       <= #UDLY ex2ls_op_lr;
+                ex2ls_op_sc_r       <= #UDLY ex2ls_op_sc;
+                ex2ls_ls_amo_r      <= #UDLY ex2ls_ls_amo;
                 ex2ls_ls_mask_r     <= #UDLY ex2ls_ls_mask;
                 ex2ls_ld_addr_r     <= #UDLY ex2ls_ld_addr;
                 ex2ls_st_addr_r     <= #UDLY ex2ls_st_addr;
@@ -402,13 +476,13 @@ module uv_lsu
         end
     end
 
-    // Buffer load request status.
+    // Buffer load request status, with SC & AMO returning data.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             mem_ld_req_r <= 1'b0;
         end
         else begin
-            if (mem_req_fire & ls2mem_req_read) begin
+            if (mem_req_fire & mem_req_rtn) begin
                 mem_ld_req_r <= #UDLY 1'b1;
             end
             else if (mem_ld_fire) begin
@@ -423,7 +497,7 @@ module uv_lsu
             mem_st_req_r <= 1'b0;
         end
         else begin
-            if (mem_req_fire & (~ls2mem_req_read)) begin
+            if (mem_req_fire & (~mem_req_rtn)) begin
                 mem_st_req_r <= #UDLY 1'b1;
             end
             else if (mem_st_fire) begin
@@ -432,16 +506,40 @@ module uv_lsu
         end
     end
 
-    // Delay load states.
+    // Delay load states. SC writes back bit 0 of the response.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             mem_ld_mask_p <= {MLEN{1'b0}};
             mem_ld_usgn_p <= 1'b0;
+            mem_ld_wb_p   <= 1'b0;
+            mem_amo_p     <= 1'b0;
+        end
+        else begin
+            if (mem_req_fire & mem_req_rtn) begin
+                mem_ld_mask_p <= #UDLY pipe_op_sc ? {{(MLEN-1){1'b0}}, 1'b1} : pipe_ls_mask;
+                mem_ld_usgn_p <= #UDLY pipe_op_loadu | pipe_op_sc;
+                mem_ld_wb_p   <= #UDLY pipe_wb_act;
+                mem_amo_p     <= #UDLY pipe_op_store;
+            end
+        end
+    end
+
+    // Reserve the word on LR, till it is stored by others.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            lr_vld_r  <= 1'b0;
+            lr_addr_r <= {ALEN{1'b0}};
         end
         else begin
-            if (mem_req_fire & ls2mem_req_read) begin
-                mem_ld_mask_p <= #UDLY pipe_ls_mask;
-                mem_ld_usgn_p <= #UDLY pipe_op_loadu;
+            if (pipe_flush | (ex2ls_fire & (pipe_op_sc | pipe_op_mret))) begin
+                lr_vld_r  <= #UDLY 1'b0;
+            end
+            else if (mem_req_fire & pipe_op_lr) begin
+                lr_vld_r  <= #UDLY 1'b1;
+                lr_addr_r <= #UDLY pipe_ld_addr;
+            end
+            else if (|rsv_inv_hit) begin
+                lr_vld_r  <= #UDLY 1'b0;
             end
         end
     end
@@ -481,7 +579,7 @@ module uv_lsu
         end
         else begin
             if (pipe_nxt) begin
-                inst_non_ls_r <= #UDLY (~ex2ls_op_load) & (~ex2ls_op_store);
+                inst_non_ls_r <= #UDLY ((~ex2ls_op_load) & (~ex2ls_op_store)) | sc_fail;
                 trap_exit_r   <= #UDLY pipe_op_mret;
                 wfi_r         <= #UDLY pipe_op_wfi;
             end
@@ -501,8 +599,8 @@ module uv_lsu
         end
         else begin
             if (ex2ls_fire) begin
-                wb_vld_r  <= #UDLY pipe_wb_act & pipe_wb_vld;
-                wb_data_r <= #UDLY pipe_wb_data;
+                wb_vld_r  <= #UDLY pipe_wb_act & (pipe_wb_vld | sc_fail);
+                wb_data_r <= #UDLY sc_fail ? {{(XLEN-1){1'b0}}, 1'b1} : pipe_wb_data;
             end
             else begin
                 wb_vld_r  <= #UDLY 1'b0;
@@ -527,7 +625,7 @@ module uv_lsu
 
     assign wb_act               = wb_act_r;
     assign wb_idx               = wb_idx_r;
-    assign wb_vld               = (wb_vld_r | mem_ld_fire) & (~pipe_flush);
+    assign wb_vld               = (wb_vld_r | (mem_ld_fire & mem_ld_wb_p)) & (~pipe_flush);
     assign wb_data              = wb_vld_r ? wb_data_r : mem_wb_data;
 
     assign ls2cm_wb_act         = wb_act;
@@ -613,10 +711,10 @@ module uv_lsu
 
     assign ls2cm_if_acc_fault  = if_acc_fault_r;
     assign ls2cm_if_mis_align  = if_mis_align_r;
-    assign ls2cm_ld_acc_fault  = mem_ld_fire ? ls2mem_rsp_excp[0] : 1'b0;
-    assign ls2cm_ld_mis_align  = mem_ld_fire ? ls2mem_rsp_excp[1] : 1'b0;
-    assign ls2cm_st_acc_fault  = mem_st_fire ? ls2mem_rsp_excp[0] : 1'b0;
-    assign ls2cm_st_mis_align  = mem_st_fire ? ls2mem_rsp_excp[1] : 1'b0;
+    assign ls2cm_ld_acc_fault  = mem_ld_fire & (~mem_amo_p) ? ls2mem_rsp_excp[0] : 1'b0;
+    assign ls2cm_ld_mis_align  = mem_ld_fire & (~mem_amo_p) ? ls2mem_rsp_excp[1] : 1'b0;
+    assign ls2cm_st_acc_fault  = mem_st_fire | (mem_ld_fire & mem_amo_p) ? ls2mem_rsp_excp[0] : 1'b0;
+    assign ls2cm_st_mis_align  = mem_st_fire | (mem_ld_fire & mem_amo_p) ? ls2mem_rsp_excp[1] : 1'b0;
     assign ls2cm_ill_inst      = ill_inst_r;
     assign ls2cm_env_call      = env_call_r;
     assign ls2cm_env_break     = env_break_r;
@@ -20,7 +20,11 @@ module uv_ucore
     parameter ALEN              = 32,
     parameter ILEN              = 32,
     parameter XLEN              = 32,
-    parameter MLEN              = XLEN / 8
+    parameter MLEN              = XLEN / 8,
+    parameter IFLEN             = ILEN,
+    parameter MEM_BASE_LSB      = 31,
+    parameter MEM_BASE_ADDR     = 1'h1,
+    parameter RSV_INV_NUM       = 1
 )
 (
     input                       clk,
@@ -37,13 +41,14 @@ module uv_ucore
     input                       if_rsp_vld,
     output                      if_rsp_rdy,
     input  [1:0]                if_rsp_excp,
-    input  [ILEN-1:0]           if_rsp_data,
+    input  [IFLEN-1:0]          if_rsp_data,
     
     // Load & store access.
     output                      ls_req_vld,
     input                       ls_req_rdy,
     output                      ls_req_read,
     output [ALEN-1:0]           ls_req_addr,
+    output [3:0]                ls_req_amo,
     output [MLEN-1:0]           ls_req_mask,
     output [XLEN-1:0]           ls_req_data,
 
@@ -59,6 +64,10 @@ module uv_ucore
     input                       irq_from_sft,
     input                       irq_from_tmr,
     input  [63:0]               cnt_from_tmr,
+
+    // Stores of other masters to invalidate the LR reservation.
+    input  [RSV_INV_NUM-1:0]    rsv_inv_vld,
+    input  [RSV_INV_NUM*ALEN-1:0] rsv_inv_addr,
     
     // To flush instruction channel.
     output                      fence_inst,     // FIXME: flush IFU for fence.i
@@ -135,6 +144,9 @@ module uv_ucore
     wire                        id2ex_op_load;
     wire                        id2ex_op_loadu;
     wire                        id2ex_op_store;
+    wire                        id2ex_op_lr;
+    wire                        id2ex_op_sc;
+    wire [3:0]                  id2ex_ls_amo;
     wire [MLEN-1:0]             id2ex_ls_mask;
     wire [XLEN-1:0]             id2ex_st_data;
     
@@ -199,6 +211,9 @@ module uv_ucore
     wire                        ex2ls_op_load;
     wire                        ex2ls_op_loadu;
     wire                        ex2ls_op_store;
+    wire                        ex2ls_op_lr;
+    wire                        ex2ls_op_sc;
+    wire [3:0]                  ex2ls_ls_amo;
     wire [MLEN-1:0]             ex2ls_ls_mask;
     wire [ALEN-1:0]             ex2ls_ld_addr;
     wire [ALEN-1:0]             ex2ls_st_addr;
@@ -315,7 +330,10 @@ module uv_ucore
     #(
         .ALEN                   ( ALEN                  ),
         .ILEN                   ( ILEN                  ),
-        .XLEN                   ( XLEN                  )
+        .XLEN                   ( XLEN                  ),
+        .IFLEN                  ( IFLEN                 ),
+        .MEM_BASE_LSB           ( MEM_BASE_LSB          ),
+        .MEM_BASE_ADDR          ( MEM_BASE_ADDR         )
     )
     u_ifu
     (
@@ -491,6 +509,9 @@ module uv_ucore
         .id2ex_op_load          ( id2ex_op_load         ),
         .id2ex_op_loadu         ( id2ex_op_loadu        ),
         .id2ex_op_store         ( id2ex_op_store        ),
+        .id2ex_op_lr            ( id2ex_op_lr           ),
+        .id2ex_op_sc            ( id2ex_op_sc           ),
+        .id2ex_ls_amo           ( id2ex_ls_amo          ),
         .id2ex_ls_mask          ( id2ex_ls_mask         ),
         .id2ex_st_data          ( id2ex_st_data         ),
         
@@ -620,6 +641,9 @@ module uv_ucore
         .id2ex_op_load          ( id2ex_op_load         ),
         .id2ex_op_loadu         ( id2ex_op_loadu        ),
         .id2ex_op_store         ( id2ex_op_store        ),
+        .id2ex_op_lr            ( id2ex_op_lr           ),
+        .id2ex_op_sc            ( id2ex_op_sc           ),
+        .id2ex_ls_amo           ( id2ex_ls_amo          ),
         .id2ex_ls_mask          ( id2ex_ls_mask         ),
         .id2ex_st_data          ( id2ex_st_data         ),
         
@@ -666,6 +690,9 @@ module uv_ucore
         .ex2ls_op_load          ( ex2ls_op_load         ),
         .ex2ls_op_loadu         ( ex2ls_op_loadu        ),
         .ex2ls_op_store         ( ex2ls_op_store        ),
+        .ex2ls_op_lr            ( ex2ls_op_lr           ),
+        .ex2ls_op_sc            ( ex2ls_op_sc           ),
+        .ex2ls_ls_amo           ( ex2ls_ls_amo          ),
         .ex2ls_ls_mask          ( ex2ls_ls_mask         ),
         .ex2ls_ld_addr          ( ex2ls_ld_addr         ),
         .ex2ls_st_addr          ( ex2ls_st_addr         ),
@@ -735,7 +762,8 @@ module uv_ucore
     #(
         .ALEN                   ( ALEN                  ),
         .XLEN                   ( XLEN                  ),
-        .MLEN                   ( MLEN                  )
+        .MLEN                   ( MLEN                  ),
+        .RSV_INV_NUM            ( RSV_INV_NUM           )
     )
     u_lsu
     (
@@ -750,6 +778,9 @@ module uv_ucore
         .ex2ls_op_load          ( ex2ls_op_load         ),
         .ex2ls_op_loadu         ( ex2ls_op_loadu        ),
         .ex2ls_op_store         ( ex2ls_op_store        ),
+        .ex2ls_op_lr            ( ex2ls_op_lr           ),
+        .ex2ls_op_sc            ( ex2ls_op_sc           ),
+        .ex2ls_ls_amo           ( ex2ls_ls_amo          ),
         .ex2ls_ls_mask          ( ex2ls_ls_mask         ),
         .ex2ls_ld_addr          ( ex2ls_ld_addr         ),
         .ex2ls_st_addr          ( ex2ls_st_addr         ),
@@ -783,6 +814,7 @@ module uv_ucore
         .ls2mem_req_rdy         ( ls_req_rdy            ),
         .ls2mem_req_read        ( ls_req_read           ),
         .ls2mem_req_addr        ( ls_req_addr           ),
+        .ls2mem_req_amo         ( ls_req_amo            ),
         .ls2mem_req_mask        ( ls_req_mask           ),
         .ls2mem_req_data        ( ls_req_data           ),
 
@@ -829,6 +861,10 @@ module uv_ucore
 
         // Flush control from trap.
         .trap_flush             ( trap_flush            ),
+
+        // Stores of other masters.
+        .rsv_inv_vld            ( rsv_inv_vld           ),
+        .rsv_inv_addr           ( rsv_inv_addr          ),
         
         // FW info from EXU.
         .ex2ls_rs2_idx          ( ex2ls_rs2_idx         )
@@ -0,0 +1,121 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_crc
+//
+// Designer: Owen
+//
+// Description:
+//      CRC accelerator.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_crc
+#(
+    parameter ALEN                  = 12,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           crc_req_vld,
+    output                          crc_req_rdy,
+    input                           crc_req_read,
+    input  [ALEN-1:0]               crc_req_addr,
+    input  [MLEN-1:0]               crc_req_mask,
+    input  [DLEN-1:0]               crc_req_data,
+
+    output                          crc_rsp_vld,
+    input                           crc_rsp_rdy,
+    output [1:0]                    crc_rsp_excp,
+    output [DLEN-1:0]               crc_rsp_data,
+
+    output                          crc_dma_req,
+    input                           crc_dma_ack
+);
+
+    localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
+
+    wire                            crc_psel;
+    wire                            crc_penable;
+    wire [2:0]                      crc_pprot;
+    wire [ALEN-1:0]                 crc_paddr;
+    wire [MLEN-1:0]                 crc_pstrb;
+    wire                            crc_pwrite;
+    wire [DLEN-1:0]                 crc_pwdata;
+    wire [DLEN-1:0]                 crc_prdata;
+    wire                            crc_pready;
+    wire                            crc_pslverr;
+
+    uv_bus_to_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
+    )
+    u_bus_to_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Bus ports.
+        .bus_req_vld                ( crc_req_vld           ),
+        .bus_req_rdy                ( crc_req_rdy           ),
+        .bus_req_read               ( crc_req_read          ),
+        .bus_req_addr               ( crc_req_addr          ),
+        .bus_req_mask               ( crc_req_mask          ),
+        .bus_req_data               ( crc_req_data          ),
+
+        .bus_rsp_vld                ( crc_rsp_vld           ),
+        .bus_rsp_rdy                ( crc_rsp_rdy           ),
+        .bus_rsp_excp               ( crc_rsp_excp          ),
+        .bus_rsp_data               ( crc_rsp_data          ),
+
+        // APB ports.
+        .apb_psel                   ( crc_psel              ),
+        .apb_penable                ( crc_penable           ),
+        .apb_pprot                  ( crc_pprot             ),
+        .apb_paddr                  ( crc_paddr             ),
+        .apb_pstrb                  ( crc_pstrb             ),
+        .apb_pwrite                 ( crc_pwrite            ),
+        .apb_pwdata                 ( crc_pwdata            ),
+        .apb_prdata                 ( crc_prdata            ),
+        .apb_pready                 ( crc_pready            ),
+        .apb_pslverr                ( crc_pslverr           )
+    );
+
+    uv_crc_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  )
+    )
+    u_crc_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // APB ports.
+        .crc_psel                   ( crc_psel              ),
+        .crc_penable                ( crc_penable           ),
+        .crc_pprot                  ( crc_pprot             ),
+        .crc_paddr                  ( crc_paddr             ),
+        .crc_pstrb                  ( crc_pstrb             ),
+        .crc_pwrite                 ( crc_pwrite            ),
+        .crc_pwdata                 ( crc_pwdata            ),
+        .crc_prdata                 ( crc_prdata            ),
+        .crc_pready                 ( crc_pready            ),
+        .crc_pslverr                ( crc_pslverr           ),
+
+        // DMA handshake.
+        .crc_dma_req                ( crc_dma_req           ),
+        .crc_dma_ack                ( crc_dma_ack           )
+    );
+
+endmodule
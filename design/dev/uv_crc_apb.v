@@ -0,0 +1,325 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_crc_apb
+//
+// Designer: Owen
+//
+// Description:
+//      CRC engine with APB interface. Width, polynomial, init,
+//      final XOR & reflection of input & output are set up by
+//      registers, and a write to CRC_INIT restarts. Each write
+//      to CRC_DAT feeds the bytes of its strobes, low byte
+//      first, in one cycle. The state is kept MSB-aligned, so
+//      any width up to 32 bits shares the same shift chain.
+//      The DMA request is held while enabled, as data is never
+//      stalled.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_crc_apb
+#(
+    parameter ALEN                  = 12,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // APB ports.
+    input                           crc_psel,
+    input                           crc_penable,
+    input  [2:0]                    crc_pprot,
+    input  [ALEN-1:0]               crc_paddr,
+    input  [MLEN-1:0]               crc_pstrb,
+    input                           crc_pwrite,
+    input  [DLEN-1:0]               crc_pwdata,
+    output [DLEN-1:0]               crc_prdata,
+    output                          crc_pready,
+    output                          crc_pslverr,
+
+    // DMA handshake.
+    output                          crc_dma_req,
+    input                           crc_dma_ack
+);
+
+    localparam UDLY                 = 1;
+    localparam ADDR_DEC_WIDTH       = ALEN - 2;
+
+    localparam REG_CRC_CFG          = 0;
+    localparam REG_CRC_POLY         = 1;
+    localparam REG_CRC_INIT         = 2;
+    localparam REG_CRC_XOR          = 3;
+    localparam REG_CRC_DAT          = 4;
+    localparam REG_CRC_RES          = 5;
+    localparam REG_CRC_ADDR_MAX     = 5;
+
+    genvar i;
+    genvar j;
+
+    wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+
+    reg  [4:0]                      crc_msb_r;
+    reg                             crc_ref_in_r;
+    reg                             crc_ref_out_r;
+    reg                             crc_dma_en_r;
+    reg  [31:0]                     crc_poly_r;
+    reg  [31:0]                     crc_init_r;
+    reg  [31:0]                     crc_xor_r;
+    reg  [31:0]                     crc_state_r;
+    reg                             crc_load_r;
+
+    wire [4:0]                      crc_sft;
+    wire [31:0]                     crc_mask;
+    wire [31:0]                     poly_align;
+    wire [31:0]                     init_align;
+    wire [31:0]                     state_ref;
+    wire [31:0]                     state_out;
+    wire [31:0]                     crc_res;
+
+    wire [31:0]                     din_bits;
+    wire [31:0]                     lane_state [0:4];
+    wire [31:0]                     bit_in     [0:31];
+    wire [31:0]                     bit_state  [1:32];
+    wire [31:0]                     bit_fb;
+
+    wire                            crc_cfg_match;
+    wire                            crc_poly_match;
+    wire                            crc_init_match;
+    wire                            crc_xor_match;
+    wire                            crc_dat_match;
+    wire                            crc_res_match;
+    wire                            addr_mismatch;
+
+    wire                            crc_cfg_wr;
+    wire                            crc_poly_wr;
+    wire                            crc_init_wr;
+    wire                            crc_xor_wr;
+    wire                            crc_dat_wr;
+
+    wire                            crc_cfg_rd;
+    wire                            crc_poly_rd;
+    wire                            crc_init_rd;
+    wire                            crc_xor_rd;
+    wire                            crc_res_rd;
+
+    // Response.
+    reg                             rsp_vld_r;
+    reg                             rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    // Address decoding.
+    assign dec_addr                 = crc_paddr[ALEN-1:2];
+
+    assign crc_cfg_match            = dec_addr == REG_CRC_CFG [ADDR_DEC_WIDTH-1:0];
+    assign crc_poly_match           = dec_addr == REG_CRC_POLY[ADDR_DEC_WIDTH-1:0];
+    assign crc_init_match           = dec_addr == REG_CRC_INIT[ADDR_DEC_WIDTH-1:0];
+    assign crc_xor_match            = dec_addr == REG_CRC_XOR [ADDR_DEC_WIDTH-1:0];
+    assign crc_dat_match            = dec_addr == REG_CRC_DAT [ADDR_DEC_WIDTH-1:0];
+    assign crc_res_match            = dec_addr == REG_CRC_RES [ADDR_DEC_WIDTH-1:0];
+    assign addr_mismatch            = dec_addr > REG_CRC_ADDR_MAX[ADDR_DEC_WIDTH-1:0];
+
+    assign crc_cfg_wr               = crc_psel & (~crc_penable) & crc_pwrite & crc_cfg_match ;
+    assign crc_poly_wr              = crc_psel & (~crc_penable) & crc_pwrite & crc_poly_match;
+    assign crc_init_wr              = crc_psel & (~crc_penable) & crc_pwrite & crc_init_match;
+    assign crc_xor_wr               = crc_psel & (~crc_penable) & crc_pwrite & crc_xor_match ;
+    assign crc_dat_wr               = crc_psel & (~crc_penable) & crc_pwrite & crc_dat_match ;
+
+    assign crc_cfg_rd               = crc_psel & (~crc_penable) & (~crc_pwrite) & crc_cfg_match ;
+    assign crc_poly_rd              = crc_psel & (~crc_penable) & (~crc_pwrite) & crc_poly_match;
+    assign crc_init_rd              = crc_psel & (~crc_penable) & (~crc_pwrite) & crc_init_match;
+    assign crc_xor_rd               = crc_psel & (~crc_penable) & (~crc_pwrite) & crc_xor_match ;
+    assign crc_res_rd               = crc_psel & (~crc_penable) & (~crc_pwrite) & crc_res_match ;
+
+    // Polynomial & init aligned to the MSB of state.
+    assign crc_sft                  = ~crc_msb_r;
+    assign crc_mask                 = 32'hffffffff >> crc_sft;
+    assign poly_align               = crc_poly_r << crc_sft;
+    assign init_align               = crc_init_r << crc_sft;
+
+    // Input bits, in the order shifted in for each byte.
+    generate
+        for (i = 0; i < 4; i = i + 1) begin: gen_din_byte
+            for (j = 0; j < 8; j = j + 1) begin: gen_din_bit
+                assign din_bits[i*8+j] = crc_ref_in_r ? crc_pwdata[i*8+j] : crc_pwdata[i*8+7-j];
+            end
+        end
+    endgenerate
+
+    // Shift chain of 32 bits, where a byte without strobe is bypassed.
+    assign lane_state[0]            = crc_state_r;
+
+    generate
+        for (i = 0; i < 32; i = i + 1) begin: gen_crc_bit
+            if (i % 8 == 0) begin: gen_crc_lane_in
+                assign bit_in[i]    = lane_state[i/8];
+            end
+            else begin: gen_crc_bit_in
+                assign bit_in[i]    = bit_state[i];
+            end
+
+            assign bit_fb[i]        = bit_in[i][31] ^ din_bits[i];
+            assign bit_state[i+1]   = {bit_in[i][30:0], 1'b0} ^ (bit_fb[i] ? poly_align : 32'b0);
+        end
+
+        for (i = 0; i < 4; i = i + 1) begin: gen_crc_lane
+            assign lane_state[i+1]  = crc_pstrb[i] ? bit_state[i*8+8] : lane_state[i];
+        end
+    endgenerate
+
+    // Result, reflected over the whole state or shifted down to the width.
+    generate
+        for (i = 0; i < 32; i = i + 1) begin: gen_ref_out
+            assign state_ref[i]     = crc_state_r[31-i];
+        end
+    endgenerate
+
+    assign state_out                = crc_ref_out_r ? state_ref : (crc_state_r >> crc_sft);
+    assign crc_res                  = (state_out ^ crc_xor_r) & crc_mask;
+
+    assign crc_dma_req              = crc_dma_en_r;
+
+    // Bus response.
+    assign crc_prdata               = rsp_data_r;
+    assign crc_pready               = rsp_vld_r;
+    assign crc_pslverr              = rsp_excp_r;
+
+    // Write registers from bus.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            crc_msb_r     <= 5'd31;
+            crc_ref_in_r  <= 1'b0;
+            crc_ref_out_r <= 1'b0;
+            crc_dma_en_r  <= 1'b0;
+        end
+        else begin
+            if (crc_cfg_wr) begin
+                crc_msb_r     <= #UDLY crc_pstrb[0] ? crc_pwdata[4:0] : crc_msb_r;
+                crc_ref_in_r  <= #UDLY crc_pstrb[1] ? crc_pwdata[8]   : crc_ref_in_r;
+                crc_ref_out_r <= #UDLY crc_pstrb[1] ? crc_pwdata[9]   : crc_ref_out_r;
+                crc_dma_en_r  <= #UDLY crc_pstrb[2] ? crc_pwdata[16]  : crc_dma_en_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            crc_poly_r <= 32'h04c11db7;
+        end
+        else begin
+            if (crc_poly_wr) begin
+                crc_poly_r[7:0]   <= #UDLY crc_pstrb[0] ? crc_pwdata[7:0]   : crc_poly_r[7:0];
+                crc_poly_r[15:8]  <= #UDLY crc_pstrb[1] ? crc_pwdata[15:8]  : crc_poly_r[15:8];
+                crc_poly_r[23:16] <= #UDLY crc_pstrb[2] ? crc_pwdata[23:16] : crc_poly_r[23:16];
+                crc_poly_r[31:24] <= #UDLY crc_pstrb[3] ? crc_pwdata[31:24] : crc_poly_r[31:24];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            crc_init_r <= 32'hffffffff;
+        end
+        else begin
+            if (crc_init_wr) begin
+                crc_init_r[7:0]   <= #UDLY crc_pstrb[0] ? crc_pwdata[7:0]   : crc_init_r[7:0];
+                crc_init_r[15:8]  <= #UDLY crc_pstrb[1] ? crc_pwdata[15:8]  : crc_init_r[15:8];
+                crc_init_r[23:16] <= #UDLY crc_pstrb[2] ? crc_pwdata[23:16] : crc_init_r[23:16];
+                crc_init_r[31:24] <= #UDLY crc_pstrb[3] ? crc_pwdata[31:24] : crc_init_r[31:24];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            crc_xor_r <= 32'hffffffff;
+        end
+        else begin
+            if (crc_xor_wr) begin
+                crc_xor_r[7:0]   <= #UDLY crc_pstrb[0] ? crc_pwdata[7:0]   : crc_xor_r[7:0];
+                crc_xor_r[15:8]  <= #UDLY crc_pstrb[1] ? crc_pwdata[15:8]  : crc_xor_r[15:8];
+                crc_xor_r[23:16] <= #UDLY crc_pstrb[2] ? crc_pwdata[23:16] : crc_xor_r[23:16];
+                crc_xor_r[31:24] <= #UDLY crc_pstrb[3] ? crc_pwdata[31:24] : crc_xor_r[31:24];
+            end
+        end
+    end
+
+    // State restarts from init the cycle after INIT is written, & goes on by data.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            crc_load_r <= 1'b0;
+        end
+        else begin
+            crc_load_r <= #UDLY crc_init_wr;
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            crc_state_r <= 32'hffffffff;
+        end
+        else begin
+            if (crc_load_r) begin
+                crc_state_r <= #UDLY init_align;
+            end
+            else if (crc_dat_wr) begin
+                crc_state_r <= #UDLY lane_state[4];
+            end
+        end
+    end
+
+    // Response buf.
+    always @(*) begin
+        case (1'b1)
+            crc_cfg_rd : rsp_data = {{(DLEN-32){1'b0}}, 15'b0, crc_dma_en_r, 6'b0, crc_ref_out_r, crc_ref_in_r, 3'b0, crc_msb_r};
+            crc_poly_rd: rsp_data = {{(DLEN-32){1'b0}}, crc_poly_r};
+            crc_init_rd: rsp_data = {{(DLEN-32){1'b0}}, crc_init_r};
+            crc_xor_rd : rsp_data = {{(DLEN-32){1'b0}}, crc_xor_r};
+            crc_res_rd : rsp_data = {{(DLEN-32){1'b0}}, crc_res};
+            default    : rsp_data = {DLEN{1'b0}};
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (crc_psel & (~crc_penable)) begin
+                rsp_data_r <= #UDLY rsp_data;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r <= 1'b0;
+        end
+        else begin
+            if (crc_psel & (~crc_penable)) begin
+                rsp_vld_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_excp_r <= 1'b0;
+        end
+        else begin
+            if (crc_psel & (~crc_penable) & addr_mismatch) begin
+                rsp_excp_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_excp_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,602 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_dma
+//
+// Designer: Owen
+//
+// Description:
+//      Multi-channel DMA controller with one bus master port.
+//      Each channel moves LEN elements of 1/2/4 bytes from SRC
+//      to DST in bursts of up to 2^BURST elements. When LEN
+//      reaches zero, the channel loads the next descriptor
+//      {SRC, DST, CTRL, NEXT} from NEXT, or stops if NEXT is
+//      zero. Channels with handshake enabled wait for their
+//      peripheral request line before each burst & pulse the
+//      acknowledge line after it. Active channels are served
+//      burst by burst in round-robin order. Bursts of aligned
+//      words with incrementing addresses & descriptor loads are
+//      issued as INCR bursts on the bus.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_dma
+#(
+    parameter ALEN                  = 16,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter MST_ALEN              = 32,
+    parameter CH_NUM                = 4,
+    parameter HS_NUM                = 16,
+    parameter BUF_AW                = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // APB ports.
+    input                           dma_psel,
+    input                           dma_penable,
+    input  [2:0]                    dma_pprot,
+    input  [ALEN-1:0]               dma_paddr,
+    input  [MLEN-1:0]               dma_pstrb,
+    input                           dma_pwrite,
+    input  [DLEN-1:0]               dma_pwdata,
+    output [DLEN-1:0]               dma_prdata,
+    output                          dma_pready,
+    output                          dma_pslverr,
+
+    // Bus master.
+    output                          mst_req_vld,
+    input                           mst_req_rdy,
+    output                          mst_req_read,
+    output [MST_ALEN-1:0]           mst_req_addr,
+    output [3:0]                    mst_req_len,
+    output                          mst_req_wrap,
+    output [MLEN-1:0]               mst_req_mask,
+    output [DLEN-1:0]               mst_req_data,
+
+    input                           mst_rsp_vld,
+    output                          mst_rsp_rdy,
+    input  [1:0]                    mst_rsp_excp,
+    input  [DLEN-1:0]               mst_rsp_data,
+
+    // Peripheral handshakes.
+    input  [HS_NUM-1:0]             dma_hs_req,
+    output [HS_NUM-1:0]             dma_hs_ack,
+
+    output                          dma_busy,
+    output                          dma_irq
+);
+
+    localparam UDLY                 = 1;
+    localparam ADDR_DEC_WIDTH       = ALEN - 2;
+    localparam CH_AW                = CH_NUM > 1 ? $clog2(CH_NUM) : 1;
+    localparam HS_AW                = HS_NUM > 1 ? $clog2(HS_NUM) : 1;
+    localparam BUF_DP               = 2**BUF_AW;
+    localparam DSC_NUM              = 4;
+
+    // Global registers.
+    localparam REG_DMA_IP           = 0;
+    localparam REG_DMA_IE           = 1;
+    localparam REG_DMA_BUSY         = 2;
+    localparam REG_GLB_MAX          = 2;
+
+    // Channel registers, 8 words per channel from word 8.
+    localparam REG_CH_CFG           = 0;
+    localparam REG_CH_SRC           = 1;
+    localparam REG_CH_DST           = 2;
+    localparam REG_CH_CTRL          = 3;
+    localparam REG_CH_NEXT          = 4;
+    localparam REG_CH_MAX           = 4;
+
+    localparam FSM_DMA_IDLE         = 3'h0;
+    localparam FSM_DMA_DSC          = 3'h1;
+    localparam FSM_DMA_LDD          = 3'h2;
+    localparam FSM_DMA_RD           = 3'h3;
+    localparam FSM_DMA_WR           = 3'h4;
+    localparam FSM_DMA_UPD          = 3'h5;
+    localparam FSM_DMA_ERR          = 3'h6;
+
+    genvar i;
+
+    // Register access.
+    wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+    wire [ADDR_DEC_WIDTH-4:0]       dec_win;
+    wire [2:0]                      dec_ofs;
+    wire                            glb_match;
+    wire [CH_NUM-1:0]               ch_match;
+    wire                            addr_mismatch;
+
+    wire                            reg_wr;
+    wire                            reg_rd;
+    wire                            dma_ip_wr;
+    wire                            dma_ie_wr;
+    wire [CH_NUM-1:0]               ch_cfg_wr;
+    wire [CH_NUM-1:0]               ch_src_wr;
+    wire [CH_NUM-1:0]               ch_dst_wr;
+    wire [CH_NUM-1:0]               ch_ctrl_wr;
+    wire [CH_NUM-1:0]               ch_next_wr;
+
+    reg                             rsp_vld_r;
+    reg                             rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    // Channel contexts.
+    reg  [CH_NUM-1:0]               ch_en_r;
+    reg  [CH_NUM-1:0]               ch_hs_en_r;
+    reg  [HS_AW-1:0]                ch_hs_sel_r     [CH_NUM-1:0];
+    reg  [31:0]                     ch_src_r        [CH_NUM-1:0];
+    reg  [31:0]                     ch_dst_r        [CH_NUM-1:0];
+    reg  [31:0]                     ch_ctrl_r       [CH_NUM-1:0];
+    reg  [31:0]                     ch_next_r       [CH_NUM-1:0];
+    reg  [CH_NUM-1:0]               ch_done_ip_r;
+    reg  [CH_NUM-1:0]               ch_err_ip_r;
+    reg  [CH_NUM-1:0]               ch_done_ie_r;
+    reg  [CH_NUM-1:0]               ch_err_ie_r;
+
+    wire [CH_NUM-1:0]               ch_len_zero;
+    wire [CH_NUM-1:0]               ch_next_zero;
+    wire [CH_NUM-1:0]               ch_hs_rdy;
+    wire [CH_NUM-1:0]               ch_fin;
+    wire [CH_NUM-1:0]               ch_elig;
+    wire [CH_NUM-1:0]               arb_req;
+    wire [CH_NUM-1:0]               ch_grant;
+    wire [CH_NUM-1:0]               ch_act;
+    wire [CH_NUM-1:0]               ch_upd;
+    wire [CH_NUM-1:0]               ch_ldd;
+    wire [CH_NUM-1:0]               ch_err;
+    wire [CH_NUM-1:0]               ch_int;
+
+    // Engine.
+    reg  [2:0]                      cur_state;
+    reg  [2:0]                      nxt_state;
+
+    reg  [CH_AW-1:0]                grant_idx;
+    reg  [CH_AW-1:0]                act_idx_r;
+    reg  [CH_NUM-1:0]               act_oh_r;
+
+    wire [15:0]                     grt_len;
+    wire [2:0]                      grt_bst;
+    wire [16:0]                     grt_bst_len;
+    wire [BUF_AW:0]                 grt_num;
+
+    reg  [BUF_AW:0]                 bst_num_r;
+    reg  [1:0]                      size_r;
+    reg                             src_inc_r;
+    reg                             dst_inc_r;
+    reg  [31:0]                     cur_src_r;
+    reg  [31:0]                     cur_dst_r;
+    reg  [BUF_AW:0]                 iss_cnt_r;
+    reg  [BUF_AW:0]                 rcv_cnt_r;
+    reg                             ost_r;
+    reg  [1:0]                      ost_lane_r;
+    reg  [DLEN-1:0]                 buf_r           [BUF_DP-1:0];
+
+    wire [BUF_AW:0]                 phs_num;
+    wire [15:0]                     phs_len;
+    wire                            phs_bst;
+    wire                            phs_iss;
+    wire                            phs_last;
+    wire [2:0]                      elem_bytes;
+    wire [MLEN-1:0]                 elem_mask;
+    wire [1:0]                      req_lane;
+    wire [31:0]                     req_addr;
+    wire                            req_fire;
+    wire                            rsp_fire;
+    wire                            rsp_err;
+    wire [DLEN-1:0]                 rsp_elem;
+    wire [DLEN-1:0]                 wr_elem;
+
+    //-------------------------------------------------------
+    // Register access.
+    assign dec_addr                 = dma_paddr[ALEN-1:2];
+    assign dec_win                  = dec_addr[ADDR_DEC_WIDTH-1:3];
+    assign dec_ofs                  = dec_addr[2:0];
+    assign glb_match                = dec_win == {(ADDR_DEC_WIDTH-3){1'b0}};
+    assign addr_mismatch            = (glb_match & (dec_ofs > REG_GLB_MAX))
+                                    | ((~glb_match) & (dec_ofs > REG_CH_MAX))
+                                    | (dec_win > CH_NUM);
+
+    assign reg_wr                   = dma_psel & (~dma_penable) & dma_pwrite;
+    assign reg_rd                   = dma_psel & (~dma_penable) & (~dma_pwrite);
+    assign dma_ip_wr                = reg_wr & glb_match & (dec_ofs == REG_DMA_IP);
+    assign dma_ie_wr                = reg_wr & glb_match & (dec_ofs == REG_DMA_IE);
+
+    generate
+        for (i = 0; i < CH_NUM; i = i + 1) begin: gen_ch_match
+            assign ch_match[i]      = dec_win == i + 1;
+            assign ch_cfg_wr[i]     = reg_wr & ch_match[i] & (dec_ofs == REG_CH_CFG);
+            assign ch_src_wr[i]     = reg_wr & ch_match[i] & (dec_ofs == REG_CH_SRC);
+            assign ch_dst_wr[i]     = reg_wr & ch_match[i] & (dec_ofs == REG_CH_DST);
+            assign ch_ctrl_wr[i]    = reg_wr & ch_match[i] & (dec_ofs == REG_CH_CTRL);
+            assign ch_next_wr[i]    = reg_wr & ch_match[i] & (dec_ofs == REG_CH_NEXT);
+        end
+    endgenerate
+
+    // Bus response.
+    assign dma_prdata               = rsp_data_r;
+    assign dma_pready               = rsp_vld_r;
+    assign dma_pslverr              = rsp_excp_r;
+
+    always @(*) begin
+        rsp_data = {DLEN{1'b0}};
+        if (glb_match) begin
+            case (dec_ofs)
+                REG_DMA_IP  : rsp_data = {ch_err_ip_r, 16'b0} | ch_done_ip_r;
+                REG_DMA_IE  : rsp_data = {ch_err_ie_r, 16'b0} | ch_done_ie_r;
+                REG_DMA_BUSY: rsp_data = ch_en_r;
+                default     : rsp_data = {DLEN{1'b0}};
+            endcase
+        end
+        else if (dec_win <= CH_NUM) begin
+            case (dec_ofs)
+                REG_CH_CFG  : rsp_data = {ch_hs_sel_r[dec_win-1], 6'b0, ch_hs_en_r[dec_win-1], ch_en_r[dec_win-1]};
+                REG_CH_SRC  : rsp_data = ch_src_r[dec_win-1];
+                REG_CH_DST  : rsp_data = ch_dst_r[dec_win-1];
+                REG_CH_CTRL : rsp_data = ch_ctrl_r[dec_win-1];
+                REG_CH_NEXT : rsp_data = ch_next_r[dec_win-1];
+                default     : rsp_data = {DLEN{1'b0}};
+            endcase
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (reg_rd) begin
+                rsp_data_r <= #UDLY rsp_data;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r <= 1'b0;
+        end
+        else begin
+            if (dma_psel & (~dma_penable)) begin
+                rsp_vld_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_excp_r <= 1'b0;
+        end
+        else begin
+            if (dma_psel & (~dma_penable) & addr_mismatch) begin
+                rsp_excp_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_excp_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    //-------------------------------------------------------
+    // Channel contexts.
+    // CFG : [0] EN, [1] HS_EN, [HS_AW+7:8] HS_SEL.
+    // CTRL: [15:0] LEN, [17:16] SIZE, [18] SRC_INC, [19] DST_INC,
+    //       [22:20] BURST, [24] INT at the end of this descriptor.
+    generate
+        for (i = 0; i < CH_NUM; i = i + 1) begin: gen_ch
+            assign ch_len_zero[i]   = ~(|ch_ctrl_r[i][15:0]);
+            assign ch_next_zero[i]  = ~(|ch_next_r[i][31:2]);
+            assign ch_hs_rdy[i]     = (~ch_hs_en_r[i]) | dma_hs_req[ch_hs_sel_r[i]];
+            assign ch_fin[i]        = ch_en_r[i] & (~ch_act[i]) & ch_len_zero[i] & ch_next_zero[i];
+            assign ch_elig[i]       = ch_en_r[i] & (~ch_fin[i]) & (ch_len_zero[i] | ch_hs_rdy[i]);
+            assign ch_act[i]        = act_oh_r[i] & (cur_state != FSM_DMA_IDLE);
+            assign ch_upd[i]        = act_oh_r[i] & (cur_state == FSM_DMA_UPD);
+            assign ch_ldd[i]        = act_oh_r[i] & (cur_state == FSM_DMA_LDD);
+            assign ch_err[i]        = act_oh_r[i] & (cur_state == FSM_DMA_ERR);
+            assign ch_int[i]        = ch_upd[i] & ch_ctrl_r[i][24] & (ch_ctrl_r[i][15:0] == bst_num_r);
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ch_en_r[i]     <= 1'b0;
+                    ch_hs_en_r[i]  <= 1'b0;
+                    ch_hs_sel_r[i] <= {HS_AW{1'b0}};
+                end
+                else begin
+                    if (ch_cfg_wr[i] & dma_pstrb[0]) begin
+                        ch_en_r[i]     <= #UDLY dma_pwdata[0];
+                        ch_hs_en_r[i]  <= #UDLY dma_pwdata[1];
+                    end
+                    else if (ch_fin[i] | ch_err[i]) begin
+                        ch_en_r[i]     <= #UDLY 1'b0;
+                    end
+
+                    if (ch_cfg_wr[i] & dma_pstrb[1]) begin
+                        ch_hs_sel_r[i] <= #UDLY dma_pwdata[HS_AW+7:8];
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ch_src_r[i]  <= 32'b0;
+                    ch_dst_r[i]  <= 32'b0;
+                    ch_ctrl_r[i] <= 32'b0;
+                    ch_next_r[i] <= 32'b0;
+                end
+                else begin
+                    if (ch_ldd[i]) begin
+                        ch_src_r[i]  <= #UDLY buf_r[0][31:0];
+                        ch_dst_r[i]  <= #UDLY buf_r[1][31:0];
+                        ch_ctrl_r[i] <= #UDLY buf_r[2][31:0];
+                        ch_next_r[i] <= #UDLY buf_r[3][31:0];
+                    end
+                    else if (ch_upd[i]) begin
+                        ch_src_r[i]  <= #UDLY cur_src_r;
+                        ch_dst_r[i]  <= #UDLY cur_dst_r;
+                        ch_ctrl_r[i][15:0] <= #UDLY ch_ctrl_r[i][15:0] - bst_num_r;
+                    end
+                    else begin
+                        if (ch_src_wr[i]) begin
+                            ch_src_r[i]  <= #UDLY dma_pwdata[31:0];
+                        end
+                        if (ch_dst_wr[i]) begin
+                            ch_dst_r[i]  <= #UDLY dma_pwdata[31:0];
+                        end
+                        if (ch_ctrl_wr[i]) begin
+                            ch_ctrl_r[i] <= #UDLY dma_pwdata[31:0];
+                        end
+                        if (ch_next_wr[i]) begin
+                            ch_next_r[i] <= #UDLY dma_pwdata[31:0];
+                        end
+                    end
+                end
+            end
+
+            // Pending bits are set by hardware & cleared by writing 1.
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ch_done_ip_r[i] <= 1'b0;
+                    ch_err_ip_r[i]  <= 1'b0;
+                end
+                else begin
+                    if (ch_fin[i] | ch_int[i]) begin
+                        ch_done_ip_r[i] <= #UDLY 1'b1;
+                    end
+                    else if (dma_ip_wr & dma_pwdata[i]) begin
+                        ch_done_ip_r[i] <= #UDLY 1'b0;
+                    end
+
+                    if (ch_err[i]) begin
+                        ch_err_ip_r[i]  <= #UDLY 1'b1;
+                    end
+                    else if (dma_ip_wr & dma_pwdata[16+i]) begin
+                        ch_err_ip_r[i]  <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ch_done_ie_r[i] <= 1'b0;
+                    ch_err_ie_r[i]  <= 1'b0;
+                end
+                else begin
+                    if (dma_ie_wr) begin
+                        ch_done_ie_r[i] <= #UDLY dma_pwdata[i];
+                        ch_err_ie_r[i]  <= #UDLY dma_pwdata[16+i];
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    assign dma_busy                 = |ch_en_r;
+    assign dma_irq                  = |((ch_done_ip_r & ch_done_ie_r) | (ch_err_ip_r & ch_err_ie_r));
+
+    //-------------------------------------------------------
+    // Channel arbitration, one burst per grant.
+    assign arb_req                  = ch_elig & {CH_NUM{cur_state == FSM_DMA_IDLE}};
+
+    uv_arb_rr
+    #(
+        .WIDTH                      ( CH_NUM                )
+    )
+    u_arb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+        .req                        ( arb_req               ),
+        .grant                      ( ch_grant              )
+    );
+
+    integer k;
+    always @(*) begin
+        grant_idx = {CH_AW{1'b0}};
+        for (k = 0; k < CH_NUM; k = k + 1) begin
+            if (ch_grant[k]) begin
+                grant_idx = k;
+            end
+        end
+    end
+
+    assign grt_len                  = ch_ctrl_r[grant_idx][15:0];
+    assign grt_bst                  = ch_ctrl_r[grant_idx][22:20] > BUF_AW ? BUF_AW : ch_ctrl_r[grant_idx][22:20];
+    assign grt_bst_len              = 17'b1 << grt_bst;
+    assign grt_num                  = grt_len < grt_bst_len ? grt_len[BUF_AW:0] : grt_bst_len[BUF_AW:0];
+
+    //-------------------------------------------------------
+    // Transfer engine.
+    assign phs_num                  = cur_state == FSM_DMA_DSC ? DSC_NUM : bst_num_r;
+    assign phs_iss                  = (cur_state == FSM_DMA_DSC) | (cur_state == FSM_DMA_RD) | (cur_state == FSM_DMA_WR);
+    assign phs_last                 = rsp_fire & (rcv_cnt_r == phs_num - 1'b1);
+    assign phs_len                  = {{(15-BUF_AW){1'b0}}, phs_num} - 1'b1;
+
+    // Only word elements with incrementing addresses are sent in one bus burst.
+    assign phs_bst                  = (phs_len != 16'd0) & (phs_len < 16'd16)
+                                    & ((cur_state == FSM_DMA_DSC)
+                                    | ((cur_state == FSM_DMA_RD) & (size_r == 2'd2) & src_inc_r & (~(|cur_src_r[1:0])))
+                                    | ((cur_state == FSM_DMA_WR) & (size_r == 2'd2) & dst_inc_r & (~(|cur_dst_r[1:0]))));
+
+    assign elem_bytes               = cur_state == FSM_DMA_DSC ? 3'd4 : (3'd1 << size_r);
+    assign elem_mask                = cur_state == FSM_DMA_DSC ? {MLEN{1'b1}}
+                                    : size_r == 2'd0 ? 4'b0001 : size_r == 2'd1 ? 4'b0011 : 4'b1111;
+    assign req_addr                 = cur_state == FSM_DMA_WR ? cur_dst_r : cur_src_r;
+    assign req_lane                 = req_addr[1:0];
+
+    // At most one request is outstanding & the next one is issued along with the response,
+    // except that a read burst is requested once & write burst beats are sent back to back.
+    assign mst_req_vld              = phs_iss & (iss_cnt_r < phs_num)
+                                    & ((~ost_r) | (rsp_fire & (~rsp_err)) | (phs_bst & (~mst_req_read)));
+    assign mst_req_read             = cur_state != FSM_DMA_WR;
+    assign mst_req_addr             = {req_addr[31:2], 2'b0};
+    assign mst_req_len              = phs_bst ? phs_len[3:0] : 4'd0;
+    assign mst_req_wrap             = 1'b0;
+    assign mst_req_mask             = elem_mask << req_lane;
+    assign mst_req_data             = wr_elem << {req_lane, 3'b0};
+    assign mst_rsp_rdy              = 1'b1;
+
+    assign req_fire                 = mst_req_vld & mst_req_rdy;
+    assign rsp_fire                 = mst_rsp_vld & mst_rsp_rdy;
+    assign rsp_err                  = rsp_fire & (|mst_rsp_excp);
+    assign rsp_elem                 = mst_rsp_data >> {ost_lane_r, 3'b0};
+    assign wr_elem                  = buf_r[iss_cnt_r[BUF_AW-1:0]];
+
+    assign dma_hs_ack               = (cur_state == FSM_DMA_UPD) & ch_hs_en_r[act_idx_r]
+                                    ? {{(HS_NUM-1){1'b0}}, 1'b1} << ch_hs_sel_r[act_idx_r]
+                                    : {HS_NUM{1'b0}};
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_state <= FSM_DMA_IDLE;
+        end
+        else begin
+            cur_state <= #UDLY nxt_state;
+        end
+    end
+
+    always @(*) begin
+        case (cur_state)
+            FSM_DMA_IDLE: begin
+                if (|ch_grant) begin
+                    nxt_state = ch_len_zero[grant_idx] ? FSM_DMA_DSC : FSM_DMA_RD;
+                end
+                else begin
+                    nxt_state = FSM_DMA_IDLE;
+                end
+            end
+            FSM_DMA_DSC: begin
+                nxt_state = rsp_err ? FSM_DMA_ERR : phs_last ? FSM_DMA_LDD : FSM_DMA_DSC;
+            end
+            FSM_DMA_LDD: begin
+                nxt_state = FSM_DMA_IDLE;
+            end
+            FSM_DMA_RD: begin
+                nxt_state = rsp_err ? FSM_DMA_ERR : phs_last ? FSM_DMA_WR : FSM_DMA_RD;
+            end
+            FSM_DMA_WR: begin
+                nxt_state = rsp_err ? FSM_DMA_ERR : phs_last ? FSM_DMA_UPD : FSM_DMA_WR;
+            end
+            default: begin
+                nxt_state = FSM_DMA_IDLE;
+            end
+        endcase
+    end
+
+    // Latch the granted channel.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            act_idx_r <= {CH_AW{1'b0}};
+            act_oh_r  <= {CH_NUM{1'b0}};
+            bst_num_r <= {(BUF_AW+1){1'b0}};
+            size_r    <= 2'b0;
+            src_inc_r <= 1'b0;
+            dst_inc_r <= 1'b0;
+        end
+        else begin
+            if ((cur_state == FSM_DMA_IDLE) & (|ch_grant)) begin
+                act_idx_r <= #UDLY grant_idx;
+                act_oh_r  <= #UDLY ch_grant;
+                bst_num_r <= #UDLY grt_num;
+                size_r    <= #UDLY ch_ctrl_r[grant_idx][17:16] > 2'd2 ? 2'd2 : ch_ctrl_r[grant_idx][17:16];
+                src_inc_r <= #UDLY ch_ctrl_r[grant_idx][18];
+                dst_inc_r <= #UDLY ch_ctrl_r[grant_idx][19];
+            end
+        end
+    end
+
+    // Addresses go forward with issued requests.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_src_r <= 32'b0;
+            cur_dst_r <= 32'b0;
+        end
+        else begin
+            if ((cur_state == FSM_DMA_IDLE) & (|ch_grant)) begin
+                cur_src_r <= #UDLY ch_len_zero[grant_idx] ? {ch_next_r[grant_idx][31:2], 2'b0}
+                                                          : ch_src_r[grant_idx];
+                cur_dst_r <= #UDLY ch_dst_r[grant_idx];
+            end
+            else if (req_fire) begin
+                if (phs_bst & mst_req_read) begin
+                    cur_src_r <= #UDLY cur_src_r + {phs_num, 2'b0};
+                end
+                else if ((cur_state == FSM_DMA_DSC) | ((cur_state == FSM_DMA_RD) & src_inc_r)) begin
+                    cur_src_r <= #UDLY cur_src_r + elem_bytes;
+                end
+                if ((cur_state == FSM_DMA_WR) & dst_inc_r) begin
+                    cur_dst_r <= #UDLY cur_dst_r + elem_bytes;
+                end
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            iss_cnt_r <= {(BUF_AW+1){1'b0}};
+            rcv_cnt_r <= {(BUF_AW+1){1'b0}};
+        end
+        else begin
+            if (phs_last | (~phs_iss)) begin
+                iss_cnt_r <= #UDLY {(BUF_AW+1){1'b0}};
+                rcv_cnt_r <= #UDLY {(BUF_AW+1){1'b0}};
+            end
+            else begin
+                if (req_fire) begin
+                    iss_cnt_r <= #UDLY phs_bst & mst_req_read ? phs_num : iss_cnt_r + 1'b1;
+                end
+                if (rsp_fire) begin
+                    rcv_cnt_r <= #UDLY rcv_cnt_r + 1'b1;
+                end
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ost_r      <= 1'b0;
+            ost_lane_r <= 2'b0;
+        end
+        else begin
+            if (req_fire) begin
+                ost_r      <= #UDLY 1'b1;
+                ost_lane_r <= #UDLY req_lane;
+            end
+            else if (rsp_fire) begin
+                ost_r      <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    // Burst buffer without reset.
+    always @(posedge clk) begin
+        if (rsp_fire & (cur_state != FSM_DMA_WR)) begin
+            buf_r[rcv_cnt_r[BUF_AW-1:0]] <= #UDLY rsp_elem;
+        end
+    end
+
+endmodule
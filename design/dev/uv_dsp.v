@@ -0,0 +1,129 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_dsp
+//
+// Designer: Owen
+//
+// Description:
+//      Streaming FIR & biquad filter accelerator.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_dsp
+#(
+    parameter ALEN                  = 16,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter TAP_NUM               = 64,
+    parameter FIFO_AW               = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           dsp_req_vld,
+    output                          dsp_req_rdy,
+    input                           dsp_req_read,
+    input  [ALEN-1:0]               dsp_req_addr,
+    input  [MLEN-1:0]               dsp_req_mask,
+    input  [DLEN-1:0]               dsp_req_data,
+
+    output                          dsp_rsp_vld,
+    input                           dsp_rsp_rdy,
+    output [1:0]                    dsp_rsp_excp,
+    output [DLEN-1:0]               dsp_rsp_data,
+
+    output                          dsp_in_dma_req,
+    input                           dsp_in_dma_ack,
+    output                          dsp_out_dma_req,
+    input                           dsp_out_dma_ack
+);
+
+    localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
+
+    wire                            dsp_psel;
+    wire                            dsp_penable;
+    wire [2:0]                      dsp_pprot;
+    wire [ALEN-1:0]                 dsp_paddr;
+    wire [MLEN-1:0]                 dsp_pstrb;
+    wire                            dsp_pwrite;
+    wire [DLEN-1:0]                 dsp_pwdata;
+    wire [DLEN-1:0]                 dsp_prdata;
+    wire                            dsp_pready;
+    wire                            dsp_pslverr;
+
+    uv_bus_to_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
+    )
+    u_bus_to_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Bus ports.
+        .bus_req_vld                ( dsp_req_vld           ),
+        .bus_req_rdy                ( dsp_req_rdy           ),
+        .bus_req_read               ( dsp_req_read          ),
+        .bus_req_addr               ( dsp_req_addr          ),
+        .bus_req_mask               ( dsp_req_mask          ),
+        .bus_req_data               ( dsp_req_data          ),
+
+        .bus_rsp_vld                ( dsp_rsp_vld           ),
+        .bus_rsp_rdy                ( dsp_rsp_rdy           ),
+        .bus_rsp_excp               ( dsp_rsp_excp          ),
+        .bus_rsp_data               ( dsp_rsp_data          ),
+
+        // APB ports.
+        .apb_psel                   ( dsp_psel              ),
+        .apb_penable                ( dsp_penable           ),
+        .apb_pprot                  ( dsp_pprot             ),
+        .apb_paddr                  ( dsp_paddr             ),
+        .apb_pstrb                  ( dsp_pstrb             ),
+        .apb_pwrite                 ( dsp_pwrite            ),
+        .apb_pwdata                 ( dsp_pwdata            ),
+        .apb_prdata                 ( dsp_prdata            ),
+        .apb_pready                 ( dsp_pready            ),
+        .apb_pslverr                ( dsp_pslverr           )
+    );
+
+    uv_dsp_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .TAP_NUM                    ( TAP_NUM               ),
+        .FIFO_AW                    ( FIFO_AW               )
+    )
+    u_dsp_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // APB ports.
+        .dsp_psel                   ( dsp_psel              ),
+        .dsp_penable                ( dsp_penable           ),
+        .dsp_pprot                  ( dsp_pprot             ),
+        .dsp_paddr                  ( dsp_paddr             ),
+        .dsp_pstrb                  ( dsp_pstrb             ),
+        .dsp_pwrite                 ( dsp_pwrite            ),
+        .dsp_pwdata                 ( dsp_pwdata            ),
+        .dsp_prdata                 ( dsp_prdata            ),
+        .dsp_pready                 ( dsp_pready            ),
+        .dsp_pslverr                ( dsp_pslverr           ),
+
+        // DMA handshakes.
+        .dsp_in_dma_req             ( dsp_in_dma_req        ),
+        .dsp_in_dma_ack             ( dsp_in_dma_ack        ),
+        .dsp_out_dma_req            ( dsp_out_dma_req       ),
+        .dsp_out_dma_ack            ( dsp_out_dma_ack       )
+    );
+
+endmodule
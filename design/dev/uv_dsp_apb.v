@@ -0,0 +1,437 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_dsp_apb
+//
+// Designer: Owen
+//
+// Description:
+//      Streaming FIR & biquad filter with APB interface. 16-bit
+//      samples written to DSP_IN are queued to the MAC engine,
+//      & its outputs are queued to be read from DSP_OUT. While
+//      the filter is enabled, writes to a full input FIFO &
+//      reads of an empty output FIFO with samples in progress
+//      wait for the engine. Coefficients are mapped at 0x1000,
+//      2 per word. DMA requests are raised while the free space
+//      of input or the length of output reaches its threshold,
+//      & held off for a while after each acknowledge.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_dsp_apb
+#(
+    parameter ALEN                  = 16,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter TAP_NUM               = 64,
+    parameter FIFO_AW               = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // APB ports.
+    input                           dsp_psel,
+    input                           dsp_penable,
+    input  [2:0]                    dsp_pprot,
+    input  [ALEN-1:0]               dsp_paddr,
+    input  [MLEN-1:0]               dsp_pstrb,
+    input                           dsp_pwrite,
+    input  [DLEN-1:0]               dsp_pwdata,
+    output [DLEN-1:0]               dsp_prdata,
+    output                          dsp_pready,
+    output                          dsp_pslverr,
+
+    // DMA handshakes.
+    output                          dsp_in_dma_req,
+    input                           dsp_in_dma_ack,
+    output                          dsp_out_dma_req,
+    input                           dsp_out_dma_ack
+);
+
+    localparam UDLY                 = 1;
+    localparam ADDR_DEC_WIDTH       = ALEN - 2;
+    localparam TAP_AW               = $clog2(TAP_NUM);
+    localparam ROW_AW               = TAP_AW - 2;
+    localparam COEF_AW              = TAP_AW - 1;
+    localparam COEF_WIN             = 4096 >> (COEF_AW + 2);
+    localparam FIFO_DP              = 2**FIFO_AW;
+
+    localparam REG_DSP_CFG          = 0;
+    localparam REG_DSP_CTRL         = 1;
+    localparam REG_DSP_STAT         = 2;
+    localparam REG_DSP_DMA          = 3;
+    localparam REG_DSP_IN           = 4;
+    localparam REG_DSP_OUT          = 5;
+    localparam REG_DSP_ADDR_MAX     = 5;
+
+    localparam DMA_HOLD             = 4'd15;
+
+    wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+
+    reg                             dsp_en_r;
+    reg                             dsp_mode_r;
+    reg  [TAP_AW-1:0]               dsp_len_r;
+    reg  [4:0]                      dsp_shift_r;
+    reg  [23:0]                     dsp_dma_cfg_r;
+    reg  [3:0]                      in_dma_hold_r;
+    reg  [3:0]                      out_dma_hold_r;
+    reg                             coef_rd_r;
+    reg                             coef_half_r;
+    reg                             out_rd_r;
+
+    wire                            dsp_clr;
+    wire                            dsp_busy;
+    wire                            in_dma_en;
+    wire                            out_dma_en;
+    wire [7:0]                      in_dma_th;
+    wire [7:0]                      out_dma_th;
+
+    wire                            in_push;
+    wire                            in_pop;
+    wire [15:0]                     in_dat;
+    wire [FIFO_AW:0]                in_len;
+    wire [FIFO_AW:0]                in_free;
+    wire                            in_full;
+    wire                            in_empty;
+    wire                            out_push;
+    wire                            out_pop;
+    wire [15:0]                     out_wdat;
+    wire [15:0]                     out_dat;
+    wire [FIFO_AW:0]                out_len;
+    wire                            out_full;
+    wire                            out_empty;
+
+    wire                            coef_ce;
+    wire [ROW_AW-1:0]               coef_row;
+    wire [7:0]                      coef_mask;
+    wire [63:0]                     coef_bus_dat;
+    wire                            coef_rd;
+    wire [ROW_AW-1:0]               coef_addr;
+    wire [63:0]                     coef_dat;
+
+    wire                            dsp_cfg_match;
+    wire                            dsp_ctrl_match;
+    wire                            dsp_stat_match;
+    wire                            dsp_dma_match;
+    wire                            dsp_in_match;
+    wire                            dsp_out_match;
+    wire                            dsp_coef_match;
+    wire                            addr_mismatch;
+
+    wire                            dsp_cfg_wr;
+    wire                            dsp_ctrl_wr;
+    wire                            dsp_dma_wr;
+    wire                            dsp_coef_wr;
+
+    wire                            dsp_cfg_rd;
+    wire                            dsp_stat_rd;
+    wire                            dsp_dma_rd;
+    wire                            dsp_out_rd;
+    wire                            dsp_coef_rd;
+
+    wire                            in_acc;
+    wire                            out_acc;
+    wire                            fifo_wait;
+
+    // Response.
+    reg                             rsp_vld_r;
+    reg                             rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    // Address decoding.
+    assign dec_addr                 = dsp_paddr[ALEN-1:2];
+
+    assign dsp_cfg_match            = dec_addr == REG_DSP_CFG [ADDR_DEC_WIDTH-1:0];
+    assign dsp_ctrl_match           = dec_addr == REG_DSP_CTRL[ADDR_DEC_WIDTH-1:0];
+    assign dsp_stat_match           = dec_addr == REG_DSP_STAT[ADDR_DEC_WIDTH-1:0];
+    assign dsp_dma_match            = dec_addr == REG_DSP_DMA [ADDR_DEC_WIDTH-1:0];
+    assign dsp_in_match             = dec_addr == REG_DSP_IN  [ADDR_DEC_WIDTH-1:0];
+    assign dsp_out_match            = dec_addr == REG_DSP_OUT [ADDR_DEC_WIDTH-1:0];
+    assign dsp_coef_match           = dec_addr[ADDR_DEC_WIDTH-1:COEF_AW] == COEF_WIN[ADDR_DEC_WIDTH-COEF_AW-1:0];
+    assign addr_mismatch            = (dec_addr > REG_DSP_ADDR_MAX[ADDR_DEC_WIDTH-1:0]) & (~dsp_coef_match);
+
+    assign dsp_cfg_wr               = dsp_psel & (~dsp_penable) & dsp_pwrite & dsp_cfg_match ;
+    assign dsp_ctrl_wr              = dsp_psel & (~dsp_penable) & dsp_pwrite & dsp_ctrl_match;
+    assign dsp_dma_wr               = dsp_psel & (~dsp_penable) & dsp_pwrite & dsp_dma_match ;
+    assign dsp_coef_wr              = dsp_psel & (~dsp_penable) & dsp_pwrite & dsp_coef_match;
+
+    assign dsp_cfg_rd               = dsp_psel & (~dsp_penable) & (~dsp_pwrite) & dsp_cfg_match ;
+    assign dsp_stat_rd              = dsp_psel & (~dsp_penable) & (~dsp_pwrite) & dsp_stat_match;
+    assign dsp_dma_rd               = dsp_psel & (~dsp_penable) & (~dsp_pwrite) & dsp_dma_match ;
+    assign dsp_out_rd               = dsp_psel & (~dsp_penable) & (~dsp_pwrite) & dsp_out_match ;
+    assign dsp_coef_rd              = dsp_psel & (~dsp_penable) & (~dsp_pwrite) & dsp_coef_match;
+
+    // Samples are moved in the ACCESS phase, which waits on FIFOs while the filter runs.
+    assign in_acc                   = dsp_psel & dsp_penable & dsp_pwrite & dsp_in_match;
+    assign out_acc                  = dsp_psel & dsp_penable & (~dsp_pwrite) & dsp_out_match;
+    assign fifo_wait                = dsp_en_r & ((in_acc & in_full) | (out_acc & out_empty & (dsp_busy | (~in_empty))));
+
+    assign in_push                  = in_acc & (~in_full);
+    assign out_pop                  = out_acc & (~out_empty);
+    assign in_free                  = FIFO_DP[FIFO_AW:0] - in_len;
+    assign dsp_clr                  = dsp_ctrl_wr & dsp_pstrb[0] & dsp_pwdata[0];
+
+    // Coefficient rows of 4, written & read by halves.
+    assign coef_ce                  = dsp_coef_wr | dsp_coef_rd;
+    assign coef_row                 = dsp_paddr[ROW_AW+2:3];
+    assign coef_mask                = dsp_paddr[2] ? {dsp_pstrb[3:0], 4'b0} : {4'b0, dsp_pstrb[3:0]};
+
+    // DMA requests.
+    assign in_dma_en                = dsp_dma_cfg_r[0];
+    assign out_dma_en               = dsp_dma_cfg_r[1];
+    assign in_dma_th                = dsp_dma_cfg_r[15:8];
+    assign out_dma_th               = dsp_dma_cfg_r[23:16];
+    assign dsp_in_dma_req           = in_dma_en & (in_free >= in_dma_th) & (~(|in_dma_hold_r));
+    assign dsp_out_dma_req          = out_dma_en & (out_len >= out_dma_th) & (~(|out_dma_hold_r));
+
+    // Bus response.
+    assign dsp_prdata               = out_rd_r  ? {{(DLEN-16){out_dat[15] & (~out_empty)}}, out_empty ? 16'b0 : out_dat}
+                                    : coef_rd_r ? {{(DLEN-32){1'b0}}, coef_half_r ? coef_bus_dat[63:32] : coef_bus_dat[31:0]}
+                                    : rsp_data_r;
+    assign dsp_pready               = rsp_vld_r & (~fifo_wait);
+    assign dsp_pslverr              = rsp_excp_r;
+
+    // Write registers from bus.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            dsp_en_r    <= 1'b0;
+            dsp_mode_r  <= 1'b0;
+            dsp_len_r   <= {TAP_AW{1'b0}};
+            dsp_shift_r <= 5'd15;
+        end
+        else begin
+            if (dsp_cfg_wr) begin
+                dsp_mode_r  <= #UDLY dsp_pstrb[0] ? dsp_pwdata[0]          : dsp_mode_r;
+                dsp_len_r   <= #UDLY dsp_pstrb[1] ? dsp_pwdata[TAP_AW+7:8] : dsp_len_r;
+                dsp_shift_r <= #UDLY dsp_pstrb[2] ? dsp_pwdata[20:16]      : dsp_shift_r;
+                dsp_en_r    <= #UDLY dsp_pstrb[3] ? dsp_pwdata[31]         : dsp_en_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            dsp_dma_cfg_r <= 24'b0;
+        end
+        else begin
+            if (dsp_dma_wr) begin
+                dsp_dma_cfg_r[7:0]   <= #UDLY dsp_pstrb[0] ? dsp_pwdata[7:0]   : dsp_dma_cfg_r[7:0];
+                dsp_dma_cfg_r[15:8]  <= #UDLY dsp_pstrb[1] ? dsp_pwdata[15:8]  : dsp_dma_cfg_r[15:8];
+                dsp_dma_cfg_r[23:16] <= #UDLY dsp_pstrb[2] ? dsp_pwdata[23:16] : dsp_dma_cfg_r[23:16];
+            end
+        end
+    end
+
+    // Hold off requests while the writes & reads of the last burst are landing.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            in_dma_hold_r  <= 4'd0;
+            out_dma_hold_r <= 4'd0;
+        end
+        else begin
+            if (dsp_in_dma_ack) begin
+                in_dma_hold_r  <= #UDLY DMA_HOLD;
+            end
+            else if (|in_dma_hold_r) begin
+                in_dma_hold_r  <= #UDLY in_dma_hold_r - 1'b1;
+            end
+
+            if (dsp_out_dma_ack) begin
+                out_dma_hold_r <= #UDLY DMA_HOLD;
+            end
+            else if (|out_dma_hold_r) begin
+                out_dma_hold_r <= #UDLY out_dma_hold_r - 1'b1;
+            end
+        end
+    end
+
+    // Response buf.
+    always @(*) begin
+        case (1'b1)
+            dsp_cfg_rd : rsp_data = {{(DLEN-32){1'b0}}, dsp_en_r, 10'b0, dsp_shift_r,
+                                     {(8-TAP_AW){1'b0}}, dsp_len_r, 7'b0, dsp_mode_r};
+            dsp_stat_rd: rsp_data = {{(DLEN-32){1'b0}}, {(15-FIFO_AW){1'b0}}, out_len,
+                                     {(7-FIFO_AW){1'b0}}, in_len, 7'b0, dsp_busy};
+            dsp_dma_rd : rsp_data = {{(DLEN-24){1'b0}}, dsp_dma_cfg_r};
+            default    : rsp_data = {DLEN{1'b0}};
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (dsp_psel & (~dsp_penable)) begin
+                rsp_data_r <= #UDLY rsp_data;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            coef_rd_r   <= 1'b0;
+            coef_half_r <= 1'b0;
+            out_rd_r    <= 1'b0;
+        end
+        else begin
+            if (dsp_psel & (~dsp_penable)) begin
+                coef_rd_r   <= #UDLY dsp_coef_rd;
+                coef_half_r <= #UDLY dsp_paddr[2];
+                out_rd_r    <= #UDLY dsp_out_rd;
+            end
+        end
+    end
+
+    // Responses of samples are held until the FIFOs are ready.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r <= 1'b0;
+        end
+        else begin
+            if (dsp_psel & (~dsp_penable)) begin
+                rsp_vld_r <= #UDLY 1'b1;
+            end
+            else if (~fifo_wait) begin
+                rsp_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_excp_r <= 1'b0;
+        end
+        else begin
+            if (dsp_psel & (~dsp_penable) & addr_mismatch) begin
+                rsp_excp_r <= #UDLY 1'b1;
+            end
+            else if (~fifo_wait) begin
+                rsp_excp_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    // Sample FIFOs.
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( 16                    ),
+        .PTR_WIDTH                  ( FIFO_AW               ),
+        .QUE_DEPTH                  ( FIFO_DP               ),
+        .ZERO_RDLY                  ( 1'b1                  )
+    )
+    u_in_que
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Write channel.
+        .wr_rdy                     (                       ),
+        .wr_vld                     ( in_push               ),
+        .wr_dat                     ( dsp_pwdata[15:0]      ),
+
+        // Read channel.
+        .rd_rdy                     (                       ),
+        .rd_vld                     ( in_pop                ),
+        .rd_dat                     ( in_dat                ),
+
+        // Control & status.
+        .clr                        ( dsp_clr               ),
+        .len                        ( in_len                ),
+        .full                       ( in_full               ),
+        .empty                      ( in_empty              )
+    );
+
+    uv_queue
+    #(
+        .DAT_WIDTH                  ( 16                    ),
+        .PTR_WIDTH                  ( FIFO_AW               ),
+        .QUE_DEPTH                  ( FIFO_DP               ),
+        .ZERO_RDLY                  ( 1'b1                  )
+    )
+    u_out_que
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Write channel.
+        .wr_rdy                     (                       ),
+        .wr_vld                     ( out_push              ),
+        .wr_dat                     ( out_wdat              ),
+
+        // Read channel.
+        .rd_rdy                     (                       ),
+        .rd_vld                     ( out_pop               ),
+        .rd_dat                     ( out_dat               ),
+
+        // Control & status.
+        .clr                        ( dsp_clr               ),
+        .len                        ( out_len               ),
+        .full                       ( out_full              ),
+        .empty                      ( out_empty             )
+    );
+
+    // Coefficient SRAM, with bus on port A & engine on port B.
+    uv_sram_dp
+    #(
+        .RAM_AW                     ( ROW_AW                ),
+        .RAM_DP                     ( 2**ROW_AW             ),
+        .RAM_DW                     ( 64                    ),
+        .RAM_MW                     ( 8                     )
+    )
+    u_coef_ram
+    (
+        .clk                        ( clk                   ),
+
+        .cea                        ( coef_ce               ),
+        .wea                        ( dsp_coef_wr           ),
+        .aa                         ( coef_row              ),
+        .da                         ( {dsp_pwdata[31:0], dsp_pwdata[31:0]} ),
+        .ma                         ( coef_mask             ),
+        .qa                         ( coef_bus_dat          ),
+
+        .ceb                        ( coef_rd               ),
+        .web                        ( 1'b0                  ),
+        .ab                         ( coef_addr             ),
+        .db                         ( 64'b0                 ),
+        .mb                         ( 8'b0                  ),
+        .qb                         ( coef_dat              )
+    );
+
+    uv_dsp_mac
+    #(
+        .TAP_NUM                    ( TAP_NUM               ),
+        .TAP_AW                     ( TAP_AW                ),
+        .ROW_AW                     ( ROW_AW                )
+    )
+    u_dsp_mac
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Configuration.
+        .dsp_en                     ( dsp_en_r              ),
+        .dsp_mode                   ( dsp_mode_r            ),
+        .dsp_len                    ( dsp_len_r             ),
+        .dsp_shift                  ( dsp_shift_r           ),
+        .dsp_clr                    ( dsp_clr               ),
+        .dsp_busy                   ( dsp_busy              ),
+
+        // Coefficient SRAM port.
+        .coef_rd                    ( coef_rd               ),
+        .coef_addr                  ( coef_addr             ),
+        .coef_dat                   ( coef_dat              ),
+
+        // Sample input & output.
+        .in_vld                     ( ~in_empty             ),
+        .in_dat                     ( in_dat                ),
+        .in_pop                     ( in_pop                ),
+        .out_rdy                    ( ~out_full             ),
+        .out_dat                    ( out_wdat              ),
+        .out_push                   ( out_push              )
+    );
+
+endmodule
@@ -0,0 +1,272 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_dsp_mac
+//
+// Designer: Owen
+//
+// Description:
+//      Filter engine with an array of 4 16x16 MACs. Coefficient
+//      rows of 4 are read from local SRAM, one row per cycle.
+//      In FIR mode, each sample is shifted into a delay line &
+//      y = sum(h[k] * x[n-k]) over LEN+1 taps. In biquad mode,
+//      LEN+1 sections are cascaded, each in direct form I with
+//      {b0, b1, b2, -a1} in row 2s & {-a2} in row 2s+1, keeping
+//      {x1, x2, y1, y2} in delay line 4s ~ 4s+3. Sums are kept
+//      in 40 bits, & rounded, shifted right by SHIFT & saturated
+//      to 16 bits for each output.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_dsp_mac
+#(
+    parameter TAP_NUM               = 64,
+    parameter TAP_AW                = $clog2(TAP_NUM),
+    parameter ROW_AW                = TAP_AW - 2
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Configuration.
+    input                           dsp_en,
+    input                           dsp_mode,
+    input  [TAP_AW-1:0]             dsp_len,
+    input  [4:0]                    dsp_shift,
+    input                           dsp_clr,
+    output                          dsp_busy,
+
+    // Coefficient SRAM port.
+    output                          coef_rd,
+    output [ROW_AW-1:0]             coef_addr,
+    input  [63:0]                   coef_dat,
+
+    // Sample input & output.
+    input                           in_vld,
+    input  [15:0]                   in_dat,
+    output                          in_pop,
+    input                           out_rdy,
+    output [15:0]                   out_dat,
+    output                          out_push
+);
+
+    localparam UDLY                 = 1;
+    localparam MAC_NUM              = 4;
+    localparam ACC_W                = 40;
+    localparam SEC_AW               = TAP_AW - 3;
+
+    localparam FSM_DSP_IDLE         = 2'd0;
+    localparam FSM_DSP_MAC          = 2'd1;
+    localparam FSM_DSP_WAIT         = 2'd2;
+    localparam FSM_DSP_OUT          = 2'd3;
+
+    localparam MODE_FIR             = 1'b0;
+    localparam MODE_BIQ             = 1'b1;
+
+    genvar i;
+
+    reg  [1:0]                      cur_state;
+    reg  [1:0]                      nxt_state;
+
+    reg  [15:0]                     dl_r [0:TAP_NUM-1];
+    reg  [ROW_AW-1:0]               row_r;
+    reg  [SEC_AW-1:0]               sec_r;
+    reg  [15:0]                     vin_r;
+    reg  [MAC_NUM*16-1:0]           opd_r;
+    reg                             mac_vld_r;
+    reg  [ACC_W-1:0]                acc_r;
+
+    wire                            start;
+    wire                            row_last;
+    wire                            sec_last;
+    wire                            sec_next;
+    wire                            fir_shift;
+    wire                            biq_upd;
+    wire [ROW_AW-1:0]               sec_row;
+    wire [TAP_AW-1:0]               sec_dl;
+
+    wire [15:0]                     fir_nxt  [0:TAP_NUM-1];
+    wire [15:0]                     biq_nxt  [0:TAP_NUM-1];
+    wire [TAP_AW-1:0]               fir_idx  [0:MAC_NUM-1];
+    wire [MAC_NUM*16-1:0]           fir_opd;
+    wire [MAC_NUM*16-1:0]           biq_opd;
+    wire [31:0]                     mac_prod [0:MAC_NUM-1];
+    wire [ACC_W-1:0]                mac_sum;
+
+    wire [ACC_W-1:0]                acc_half;
+    wire [ACC_W-1:0]                acc_rnd;
+    wire [ACC_W-1:0]                acc_sft;
+    wire                            acc_ovf;
+    wire [15:0]                     res;
+
+    assign start                    = dsp_en & (~dsp_clr) & in_vld & out_rdy & (cur_state == FSM_DSP_IDLE);
+    assign row_last                 = dsp_mode ? row_r[0] : (row_r == dsp_len[TAP_AW-1:2]);
+    assign sec_last                 = sec_r == dsp_len[SEC_AW-1:0];
+    assign sec_next                 = (cur_state == FSM_DSP_OUT) & (dsp_mode == MODE_BIQ) & (~sec_last);
+    assign fir_shift                = start & (dsp_mode == MODE_FIR);
+    assign biq_upd                  = (cur_state == FSM_DSP_OUT) & (dsp_mode == MODE_BIQ);
+    assign sec_row                  = {sec_r, 1'b0};
+    assign sec_dl                   = {sec_r, 2'b0};
+
+    assign dsp_busy                 = cur_state != FSM_DSP_IDLE;
+    assign coef_rd                  = cur_state == FSM_DSP_MAC;
+    assign coef_addr                = row_r;
+    assign in_pop                   = start;
+    assign out_dat                  = res;
+    assign out_push                 = (cur_state == FSM_DSP_OUT) & ((dsp_mode == MODE_FIR) | sec_last) & (~dsp_clr);
+
+    // Operands of the row, where taps beyond LEN are zeroed.
+    generate
+        for (i = 0; i < MAC_NUM; i = i + 1) begin: gen_fir_opd
+            assign fir_idx[i]       = {row_r, 2'b0} + i;
+            assign fir_opd[i*16+:16] = (fir_idx[i] <= dsp_len) ? dl_r[fir_idx[i]] : 16'b0;
+        end
+    endgenerate
+
+    assign biq_opd                  = row_r[0] ? {48'b0, dl_r[sec_dl+3]}
+                                    : {dl_r[sec_dl+2], dl_r[sec_dl+1], dl_r[sec_dl], vin_r};
+
+    // MAC array.
+    generate
+        for (i = 0; i < MAC_NUM; i = i + 1) begin: gen_mac
+            assign mac_prod[i]      = $signed(coef_dat[i*16+:16]) * $signed(opd_r[i*16+:16]);
+        end
+    endgenerate
+
+    assign mac_sum                  = {{(ACC_W-32){mac_prod[0][31]}}, mac_prod[0]}
+                                    + {{(ACC_W-32){mac_prod[1][31]}}, mac_prod[1]}
+                                    + {{(ACC_W-32){mac_prod[2][31]}}, mac_prod[2]}
+                                    + {{(ACC_W-32){mac_prod[3][31]}}, mac_prod[3]};
+
+    // Round half up, shift & saturate.
+    assign acc_half                 = {{(ACC_W-1){1'b0}}, 1'b1} << dsp_shift >> 1;
+    assign acc_rnd                  = acc_r + acc_half;
+    assign acc_sft                  = $signed(acc_rnd) >>> dsp_shift;
+    assign acc_ovf                  = (|acc_sft[ACC_W-1:15]) & (~(&acc_sft[ACC_W-1:15]));
+    assign res                      = acc_ovf ? {acc_sft[ACC_W-1], {15{~acc_sft[ACC_W-1]}}} : acc_sft[15:0];
+
+    // FSM.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_state <= FSM_DSP_IDLE;
+        end
+        else begin
+            cur_state <= #UDLY nxt_state;
+        end
+    end
+
+    always @(*) begin
+        case (cur_state)
+            FSM_DSP_IDLE: nxt_state = start ? FSM_DSP_MAC : FSM_DSP_IDLE;
+            FSM_DSP_MAC : nxt_state = dsp_clr ? FSM_DSP_IDLE : row_last ? FSM_DSP_WAIT : FSM_DSP_MAC;
+            FSM_DSP_WAIT: nxt_state = dsp_clr ? FSM_DSP_IDLE : FSM_DSP_OUT;
+            FSM_DSP_OUT : nxt_state = sec_next & (~dsp_clr) ? FSM_DSP_MAC : FSM_DSP_IDLE;
+            default     : nxt_state = FSM_DSP_IDLE;
+        endcase
+    end
+
+    // Rows & sections.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            row_r <= {ROW_AW{1'b0}};
+            sec_r <= {SEC_AW{1'b0}};
+        end
+        else begin
+            if (start) begin
+                row_r <= #UDLY {ROW_AW{1'b0}};
+                sec_r <= #UDLY {SEC_AW{1'b0}};
+            end
+            else if (sec_next) begin
+                row_r <= #UDLY sec_row + 2'd2;
+                sec_r <= #UDLY sec_r + 1'b1;
+            end
+            else if (coef_rd) begin
+                row_r <= #UDLY row_r + 1'b1;
+            end
+        end
+    end
+
+    // Input of the current section.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            vin_r <= 16'b0;
+        end
+        else begin
+            if (start) begin
+                vin_r <= #UDLY in_dat;
+            end
+            else if (sec_next) begin
+                vin_r <= #UDLY res;
+            end
+        end
+    end
+
+    // Operands go with the coefficient row being read.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            opd_r     <= {(MAC_NUM*16){1'b0}};
+            mac_vld_r <= 1'b0;
+        end
+        else begin
+            if (coef_rd) begin
+                opd_r <= #UDLY dsp_mode ? biq_opd : fir_opd;
+            end
+            mac_vld_r <= #UDLY coef_rd & (~dsp_clr);
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            acc_r <= {ACC_W{1'b0}};
+        end
+        else begin
+            if (start | sec_next | dsp_clr) begin
+                acc_r <= #UDLY {ACC_W{1'b0}};
+            end
+            else if (mac_vld_r) begin
+                acc_r <= #UDLY acc_r + mac_sum;
+            end
+        end
+    end
+
+    // Delay line, shifted by FIR samples or updated by biquad sections.
+    generate
+        for (i = 0; i < TAP_NUM; i = i + 1) begin: gen_dl
+            if (i == 0) begin: gen_dl_head
+                assign fir_nxt[i]   = in_dat;
+            end
+            else begin: gen_dl_body
+                assign fir_nxt[i]   = dl_r[i-1];
+            end
+
+            if (i % 4 == 0) begin: gen_dl_x1
+                assign biq_nxt[i]   = vin_r;
+            end
+            else if (i % 4 == 2) begin: gen_dl_y1
+                assign biq_nxt[i]   = res;
+            end
+            else begin: gen_dl_x2_y2
+                assign biq_nxt[i]   = dl_r[i-1];
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    dl_r[i] <= 16'b0;
+                end
+                else begin
+                    if (dsp_clr) begin
+                        dl_r[i] <= #UDLY 16'b0;
+                    end
+                    else if (fir_shift) begin
+                        dl_r[i] <= #UDLY fir_nxt[i];
+                    end
+                    else if (biq_upd & (sec_r == i / 4)) begin
+                        dl_r[i] <= #UDLY biq_nxt[i];
+                    end
+                end
+            end
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,166 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_evt
+//
+// Designer: Owen
+//
+// Description:
+//      Event router, connecting events of peripherals to
+//      tasks of peripherals without CPU.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_evt
+#(
+    parameter ALEN                  = 12,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter CH_NUM                = 8,
+    parameter IO_NUM                = 32
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           evt_req_vld,
+    output                          evt_req_rdy,
+    input                           evt_req_read,
+    input  [ALEN-1:0]               evt_req_addr,
+    input  [MLEN-1:0]               evt_req_mask,
+    input  [DLEN-1:0]               evt_req_data,
+
+    output                          evt_rsp_vld,
+    input                           evt_rsp_rdy,
+    output [1:0]                    evt_rsp_excp,
+    output [DLEN-1:0]               evt_rsp_data,
+
+    // Events.
+    input                           tmr_lvl,
+    input                           pwm_pls,
+    input                           uart_lvl,
+    input                           spi0_pls,
+    input                           spi1_pls,
+    input                           i2c_lvl,
+    input  [IO_NUM-1:0]             gpio_in,
+
+    // Tasks.
+    output                          tmr_start,
+    output                          tmr_stop,
+    output                          pwm_start,
+    output                          pwm_stop,
+    output                          spi0_start,
+    output                          spi1_start,
+    output [IO_NUM-1:0]             gpio_set,
+    output [IO_NUM-1:0]             gpio_clr,
+    output [IO_NUM-1:0]             gpio_tgl,
+
+    output [1:0]                    dma_req,
+    input  [1:0]                    dma_ack
+);
+
+    localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
+
+    wire                            evt_psel;
+    wire                            evt_penable;
+    wire [2:0]                      evt_pprot;
+    wire [ALEN-1:0]                 evt_paddr;
+    wire [MLEN-1:0]                 evt_pstrb;
+    wire                            evt_pwrite;
+    wire [DLEN-1:0]                 evt_pwdata;
+    wire [DLEN-1:0]                 evt_prdata;
+    wire                            evt_pready;
+    wire                            evt_pslverr;
+
+    uv_bus_to_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
+    )
+    u_bus_to_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Bus ports.
+        .bus_req_vld                ( evt_req_vld           ),
+        .bus_req_rdy                ( evt_req_rdy           ),
+        .bus_req_read               ( evt_req_read          ),
+        .bus_req_addr               ( evt_req_addr          ),
+        .bus_req_mask               ( evt_req_mask          ),
+        .bus_req_data               ( evt_req_data          ),
+
+        .bus_rsp_vld                ( evt_rsp_vld           ),
+        .bus_rsp_rdy                ( evt_rsp_rdy           ),
+        .bus_rsp_excp               ( evt_rsp_excp          ),
+        .bus_rsp_data               ( evt_rsp_data          ),
+
+        // APB ports.
+        .apb_psel                   ( evt_psel              ),
+        .apb_penable                ( evt_penable           ),
+        .apb_pprot                  ( evt_pprot             ),
+        .apb_paddr                  ( evt_paddr             ),
+        .apb_pstrb                  ( evt_pstrb             ),
+        .apb_pwrite                 ( evt_pwrite            ),
+        .apb_pwdata                 ( evt_pwdata            ),
+        .apb_prdata                 ( evt_prdata            ),
+        .apb_pready                 ( evt_pready            ),
+        .apb_pslverr                ( evt_pslverr           )
+    );
+
+    uv_evt_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .CH_NUM                     ( CH_NUM                ),
+        .IO_NUM                     ( IO_NUM                )
+    )
+    u_evt_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // APB ports.
+        .evt_psel                   ( evt_psel              ),
+        .evt_penable                ( evt_penable           ),
+        .evt_pprot                  ( evt_pprot             ),
+        .evt_paddr                  ( evt_paddr             ),
+        .evt_pstrb                  ( evt_pstrb             ),
+        .evt_pwrite                 ( evt_pwrite            ),
+        .evt_pwdata                 ( evt_pwdata            ),
+        .evt_prdata                 ( evt_prdata            ),
+        .evt_pready                 ( evt_pready            ),
+        .evt_pslverr                ( evt_pslverr           ),
+
+        // Events.
+        .tmr_lvl                    ( tmr_lvl               ),
+        .pwm_pls                    ( pwm_pls               ),
+        .uart_lvl                   ( uart_lvl              ),
+        .spi0_pls                   ( spi0_pls              ),
+        .spi1_pls                   ( spi1_pls              ),
+        .i2c_lvl                    ( i2c_lvl               ),
+        .gpio_in                    ( gpio_in               ),
+
+        // Tasks.
+        .tmr_start                  ( tmr_start             ),
+        .tmr_stop                   ( tmr_stop              ),
+        .pwm_start                  ( pwm_start             ),
+        .pwm_stop                   ( pwm_stop              ),
+        .spi0_start                 ( spi0_start            ),
+        .spi1_start                 ( spi1_start            ),
+        .gpio_set                   ( gpio_set              ),
+        .gpio_clr                   ( gpio_clr              ),
+        .gpio_tgl                   ( gpio_tgl              ),
+
+        // DMA handshakes.
+        .dma_req                    ( dma_req               ),
+        .dma_ack                    ( dma_ack               )
+    );
+
+endmodule
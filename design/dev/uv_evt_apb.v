@@ -0,0 +1,411 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_evt_apb
+//
+// Designer: Owen
+//
+// Description:
+//      Event router with APB interface. Each channel connects
+//      an event of peripherals to a task of peripherals, so
+//      that the task is done some cycles after the event with
+//      no CPU in the path. An event is a rising edge of IRQ or
+//      GPIO input, a pulse from a peripheral, or a write to
+//      EVT_SW. Channels hit are recorded in EVT_HIT.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_evt_apb
+#(
+    parameter ALEN                  = 12,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter CH_NUM                = 8,    // Up to 8.
+    parameter IO_NUM                = 32    // Up to 56.
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // APB ports.
+    input                           evt_psel,
+    input                           evt_penable,
+    input  [2:0]                    evt_pprot,
+    input  [ALEN-1:0]               evt_paddr,
+    input  [MLEN-1:0]               evt_pstrb,
+    input                           evt_pwrite,
+    input  [DLEN-1:0]               evt_pwdata,
+    output [DLEN-1:0]               evt_prdata,
+    output                          evt_pready,
+    output                          evt_pslverr,
+
+    // Events, as levels of which rising edges are taken, or pulses.
+    input                           tmr_lvl,
+    input                           pwm_pls,
+    input                           uart_lvl,
+    input                           spi0_pls,
+    input                           spi1_pls,
+    input                           i2c_lvl,
+    input  [IO_NUM-1:0]             gpio_in,
+
+    // Tasks.
+    output                          tmr_start,
+    output                          tmr_stop,
+    output                          pwm_start,
+    output                          pwm_stop,
+    output                          spi0_start,
+    output                          spi1_start,
+    output [IO_NUM-1:0]             gpio_set,
+    output [IO_NUM-1:0]             gpio_clr,
+    output [IO_NUM-1:0]             gpio_tgl,
+
+    // DMA handshakes.
+    output [1:0]                    dma_req,
+    input  [1:0]                    dma_ack
+);
+
+    localparam UDLY                 = 1;
+    localparam ADDR_DEC_WIDTH       = ALEN - 2;
+    localparam INPUT_SYNC_STAGE     = 2;
+
+    localparam REG_EVT_CH_START     = 0;
+    localparam REG_EVT_CH_END       = REG_EVT_CH_START + CH_NUM - 1;
+    localparam REG_EVT_SW           = 8;
+    localparam REG_EVT_HIT          = 9;
+
+    // Events.
+    localparam EVT_NONE             = 0;
+    localparam EVT_SW               = 1;
+    localparam EVT_TMR              = 2;
+    localparam EVT_PWM              = 3;
+    localparam EVT_UART             = 4;
+    localparam EVT_SPI0             = 5;
+    localparam EVT_SPI1             = 6;
+    localparam EVT_I2C              = 7;
+    localparam EVT_GPIO             = 8;
+
+    // Tasks.
+    localparam TASK_NONE            = 4'd0;
+    localparam TASK_TMR_START       = 4'd1;
+    localparam TASK_TMR_STOP        = 4'd2;
+    localparam TASK_PWM_START       = 4'd3;
+    localparam TASK_PWM_STOP        = 4'd4;
+    localparam TASK_SPI0_START      = 4'd5;
+    localparam TASK_SPI1_START      = 4'd6;
+    localparam TASK_GPIO_SET        = 4'd7;
+    localparam TASK_GPIO_CLR        = 4'd8;
+    localparam TASK_GPIO_TGL        = 4'd9;
+    localparam TASK_DMA_REQ         = 4'd10;
+
+    localparam DMA_CNT_WIDTH        = 4;
+
+    genvar i;
+    integer n;
+
+    wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+    wire [ADDR_DEC_WIDTH-1:0]       ch_idx;
+
+    reg  [31:0]                     ch_cfg_r [0:CH_NUM-1];
+    reg                             sw_evt_r;
+    reg  [CH_NUM-1:0]               hit_r;
+    reg  [2:0]                      lvl_p;
+    reg  [IO_NUM-1:0]               gpio_p;
+    reg  [DMA_CNT_WIDTH-1:0]        dma_cnt_r [0:1];
+
+    reg                             tmr_start_r;
+    reg                             tmr_stop_r;
+    reg                             pwm_start_r;
+    reg                             pwm_stop_r;
+    reg                             spi0_start_r;
+    reg                             spi1_start_r;
+    reg  [IO_NUM-1:0]               gpio_set_r;
+    reg  [IO_NUM-1:0]               gpio_clr_r;
+    reg  [IO_NUM-1:0]               gpio_tgl_r;
+    reg  [1:0]                      dma_task_r;
+
+    wire [63:0]                     evt_vec;
+    wire [IO_NUM-1:0]               gpio_sync;
+    wire [CH_NUM-1:0]               ch_en;
+    wire [CH_NUM-1:0]               ch_fire;
+    wire [3:0]                      ch_task  [0:CH_NUM-1];
+    wire [4:0]                      ch_param [0:CH_NUM-1];
+    wire [IO_NUM-1:0]               ch_pin   [0:CH_NUM-1];
+
+    reg                             tmr_start_nxt;
+    reg                             tmr_stop_nxt;
+    reg                             pwm_start_nxt;
+    reg                             pwm_stop_nxt;
+    reg                             spi0_start_nxt;
+    reg                             spi1_start_nxt;
+    reg  [IO_NUM-1:0]               gpio_set_nxt;
+    reg  [IO_NUM-1:0]               gpio_clr_nxt;
+    reg  [IO_NUM-1:0]               gpio_tgl_nxt;
+    reg  [1:0]                      dma_task_nxt;
+
+    wire                            ch_cfg_match;
+    wire                            sw_match;
+    wire                            hit_match;
+    wire                            addr_mismatch;
+
+    wire                            ch_cfg_wr;
+    wire                            sw_wr;
+    wire                            hit_wr;
+
+    wire                            ch_cfg_rd;
+    wire                            hit_rd;
+
+    // Response.
+    reg                             rsp_vld_r;
+    reg                             rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    // Address decoding.
+    assign dec_addr                 = evt_paddr[ALEN-1:2];
+    assign ch_idx                   = dec_addr - REG_EVT_CH_START[ADDR_DEC_WIDTH-1:0];
+
+    assign ch_cfg_match             =  (dec_addr >= REG_EVT_CH_START[ADDR_DEC_WIDTH-1:0])
+                                    && (dec_addr <= REG_EVT_CH_END  [ADDR_DEC_WIDTH-1:0]);
+    assign sw_match                 = dec_addr == REG_EVT_SW [ADDR_DEC_WIDTH-1:0];
+    assign hit_match                = dec_addr == REG_EVT_HIT[ADDR_DEC_WIDTH-1:0];
+    assign addr_mismatch            = ~(ch_cfg_match | sw_match | hit_match);
+
+    assign ch_cfg_wr                = evt_psel & (~evt_penable) & evt_pwrite & ch_cfg_match;
+    assign sw_wr                    = evt_psel & (~evt_penable) & evt_pwrite & sw_match;
+    assign hit_wr                   = evt_psel & (~evt_penable) & evt_pwrite & hit_match;
+
+    assign ch_cfg_rd                = evt_psel & (~evt_penable) & (~evt_pwrite) & ch_cfg_match;
+    assign hit_rd                   = evt_psel & (~evt_penable) & (~evt_pwrite) & hit_match;
+
+    // Events by index.
+    assign evt_vec[EVT_NONE]        = 1'b0;
+    assign evt_vec[EVT_SW]          = sw_evt_r;
+    assign evt_vec[EVT_TMR]         = tmr_lvl  & (~lvl_p[0]);
+    assign evt_vec[EVT_PWM]         = pwm_pls;
+    assign evt_vec[EVT_UART]        = uart_lvl & (~lvl_p[1]);
+    assign evt_vec[EVT_SPI0]        = spi0_pls;
+    assign evt_vec[EVT_SPI1]        = spi1_pls;
+    assign evt_vec[EVT_I2C]         = i2c_lvl  & (~lvl_p[2]);
+    assign evt_vec[EVT_GPIO+IO_NUM-1:EVT_GPIO] = gpio_sync & (~gpio_p);
+    assign evt_vec[63:EVT_GPIO+IO_NUM] = {(56-IO_NUM){1'b0}};
+
+    // Channel config: event in [5:0], task in [11:8], parameter in [20:16] & enable in [31].
+    generate
+        for (i = 0; i < CH_NUM; i = i + 1) begin: gen_evt_ch
+            assign ch_en[i]         = ch_cfg_r[i][31];
+            assign ch_task[i]       = ch_cfg_r[i][11:8];
+            assign ch_param[i]      = ch_cfg_r[i][20:16];
+            assign ch_pin[i]        = {{(IO_NUM-1){1'b0}}, 1'b1} << ch_param[i];
+            assign ch_fire[i]       = ch_en[i] & evt_vec[ch_cfg_r[i][5:0]];
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ch_cfg_r[i] <= 32'b0;
+                end
+                else begin
+                    if (ch_cfg_wr & (ch_idx == i)) begin
+                        ch_cfg_r[i][7:0]   <= #UDLY evt_pstrb[0] ? {2'b0, evt_pwdata[5:0]}   : ch_cfg_r[i][7:0];
+                        ch_cfg_r[i][15:8]  <= #UDLY evt_pstrb[1] ? {4'b0, evt_pwdata[11:8]}  : ch_cfg_r[i][15:8];
+                        ch_cfg_r[i][23:16] <= #UDLY evt_pstrb[2] ? {3'b0, evt_pwdata[20:16]} : ch_cfg_r[i][23:16];
+                        ch_cfg_r[i][31:24] <= #UDLY evt_pstrb[3] ? {evt_pwdata[31], 7'b0}    : ch_cfg_r[i][31:24];
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    // Gather tasks of fired channels.
+    always @(*) begin
+        tmr_start_nxt  = 1'b0;
+        tmr_stop_nxt   = 1'b0;
+        pwm_start_nxt  = 1'b0;
+        pwm_stop_nxt   = 1'b0;
+        spi0_start_nxt = 1'b0;
+        spi1_start_nxt = 1'b0;
+        gpio_set_nxt   = {IO_NUM{1'b0}};
+        gpio_clr_nxt   = {IO_NUM{1'b0}};
+        gpio_tgl_nxt   = {IO_NUM{1'b0}};
+        dma_task_nxt   = 2'b0;
+        for (n = 0; n < CH_NUM; n = n + 1) begin
+            if (ch_fire[n]) begin
+                case (ch_task[n])
+                    TASK_TMR_START : tmr_start_nxt  = 1'b1;
+                    TASK_TMR_STOP  : tmr_stop_nxt   = 1'b1;
+                    TASK_PWM_START : pwm_start_nxt  = 1'b1;
+                    TASK_PWM_STOP  : pwm_stop_nxt   = 1'b1;
+                    TASK_SPI0_START: spi0_start_nxt = 1'b1;
+                    TASK_SPI1_START: spi1_start_nxt = 1'b1;
+                    TASK_GPIO_SET  : gpio_set_nxt   = gpio_set_nxt | ch_pin[n];
+                    TASK_GPIO_CLR  : gpio_clr_nxt   = gpio_clr_nxt | ch_pin[n];
+                    TASK_GPIO_TGL  : gpio_tgl_nxt   = gpio_tgl_nxt | ch_pin[n];
+                    TASK_DMA_REQ   : dma_task_nxt[ch_param[n][0]] = 1'b1;
+                    default        : ;
+                endcase
+            end
+        end
+    end
+
+    assign tmr_start                = tmr_start_r;
+    assign tmr_stop                 = tmr_stop_r;
+    assign pwm_start                = pwm_start_r;
+    assign pwm_stop                 = pwm_stop_r;
+    assign spi0_start               = spi0_start_r;
+    assign spi1_start               = spi1_start_r;
+    assign gpio_set                 = gpio_set_r;
+    assign gpio_clr                 = gpio_clr_r;
+    assign gpio_tgl                 = gpio_tgl_r;
+
+    // Bus response.
+    assign evt_prdata               = rsp_data_r;
+    assign evt_pready               = rsp_vld_r;
+    assign evt_pslverr              = rsp_excp_r;
+
+    // Tasks for a cycle.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            tmr_start_r  <= 1'b0;
+            tmr_stop_r   <= 1'b0;
+            pwm_start_r  <= 1'b0;
+            pwm_stop_r   <= 1'b0;
+            spi0_start_r <= 1'b0;
+            spi1_start_r <= 1'b0;
+            gpio_set_r   <= {IO_NUM{1'b0}};
+            gpio_clr_r   <= {IO_NUM{1'b0}};
+            gpio_tgl_r   <= {IO_NUM{1'b0}};
+            dma_task_r   <= 2'b0;
+        end
+        else begin
+            tmr_start_r  <= #UDLY tmr_start_nxt;
+            tmr_stop_r   <= #UDLY tmr_stop_nxt;
+            pwm_start_r  <= #UDLY pwm_start_nxt;
+            pwm_stop_r   <= #UDLY pwm_stop_nxt;
+            spi0_start_r <= #UDLY spi0_start_nxt;
+            spi1_start_r <= #UDLY spi1_start_nxt;
+            gpio_set_r   <= #UDLY gpio_set_nxt;
+            gpio_clr_r   <= #UDLY gpio_clr_nxt;
+            gpio_tgl_r   <= #UDLY gpio_tgl_nxt;
+            dma_task_r   <= #UDLY dma_task_nxt;
+        end
+    end
+
+    // DMA requests held until acknowledged, one burst per task.
+    generate
+        for (i = 0; i < 2; i = i + 1) begin: gen_dma_req
+            assign dma_req[i]       = |dma_cnt_r[i];
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    dma_cnt_r[i] <= {DMA_CNT_WIDTH{1'b0}};
+                end
+                else begin
+                    if (dma_task_r[i] & (~dma_ack[i]) & (~(&dma_cnt_r[i]))) begin
+                        dma_cnt_r[i] <= #UDLY dma_cnt_r[i] + 1'b1;
+                    end
+                    else if ((~dma_task_r[i]) & dma_ack[i] & (|dma_cnt_r[i])) begin
+                        dma_cnt_r[i] <= #UDLY dma_cnt_r[i] - 1'b1;
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    // Edges of level events.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            lvl_p  <= 3'b0;
+            gpio_p <= {IO_NUM{1'b0}};
+        end
+        else begin
+            lvl_p  <= #UDLY {i2c_lvl, uart_lvl, tmr_lvl};
+            gpio_p <= #UDLY gpio_sync;
+        end
+    end
+
+    // Software event.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            sw_evt_r <= 1'b0;
+        end
+        else begin
+            sw_evt_r <= #UDLY sw_wr;
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            hit_r <= {CH_NUM{1'b0}};
+        end
+        else begin
+            if (hit_wr & evt_pstrb[0]) begin
+                hit_r <= #UDLY (hit_r & (~evt_pwdata[CH_NUM-1:0])) | ch_fire;
+            end
+            else begin
+                hit_r <= #UDLY hit_r | ch_fire;
+            end
+        end
+    end
+
+    // Response buf.
+    always @(*) begin
+        case (1'b1)
+            ch_cfg_rd: rsp_data = {{(DLEN-32){1'b0}}, ch_cfg_r[ch_idx]};
+            hit_rd   : rsp_data = {{(DLEN-CH_NUM){1'b0}}, hit_r};
+            default  : rsp_data = {DLEN{1'b0}};
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (evt_psel & (~evt_penable)) begin
+                rsp_data_r <= #UDLY rsp_data;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r <= 1'b0;
+        end
+        else begin
+            if (evt_psel & (~evt_penable)) begin
+                rsp_vld_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_excp_r <= 1'b0;
+        end
+        else begin
+            if (evt_psel & (~evt_penable) & addr_mismatch) begin
+                rsp_excp_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_excp_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    // Synchronize GPIO input to main clock domain.
+    uv_sync
+    #(
+        .SYNC_WIDTH             ( IO_NUM            ),
+        .SYNC_STAGE             ( INPUT_SYNC_STAGE  )
+    )
+    u_gpio_in_sync
+    (
+        .clk                    ( clk               ),
+        .rst_n                  ( rst_n             ),
+        .in                     ( gpio_in           ),
+        .out                    ( gpio_sync         )
+    );
+
+endmodule
@@ -0,0 +1,121 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_gemm
+//
+// Designer: Owen
+//
+// Description:
+//      Tiled int8/int16/int32 matrix-multiply accelerator.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_gemm
+#(
+    parameter ALEN                  = 16,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter TILE_AW               = 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           gemm_req_vld,
+    output                          gemm_req_rdy,
+    input                           gemm_req_read,
+    input  [ALEN-1:0]               gemm_req_addr,
+    input  [MLEN-1:0]               gemm_req_mask,
+    input  [DLEN-1:0]               gemm_req_data,
+
+    output                          gemm_rsp_vld,
+    input                           gemm_rsp_rdy,
+    output [1:0]                    gemm_rsp_excp,
+    output [DLEN-1:0]               gemm_rsp_data,
+
+    output                          gemm_irq
+);
+
+    localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
+
+    wire                            gemm_psel;
+    wire                            gemm_penable;
+    wire [2:0]                      gemm_pprot;
+    wire [ALEN-1:0]                 gemm_paddr;
+    wire [MLEN-1:0]                 gemm_pstrb;
+    wire                            gemm_pwrite;
+    wire [DLEN-1:0]                 gemm_pwdata;
+    wire [DLEN-1:0]                 gemm_prdata;
+    wire                            gemm_pready;
+    wire                            gemm_pslverr;
+
+    uv_bus_to_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
+    )
+    u_bus_to_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Bus ports.
+        .bus_req_vld                ( gemm_req_vld          ),
+        .bus_req_rdy                ( gemm_req_rdy          ),
+        .bus_req_read               ( gemm_req_read         ),
+        .bus_req_addr               ( gemm_req_addr         ),
+        .bus_req_mask               ( gemm_req_mask         ),
+        .bus_req_data               ( gemm_req_data         ),
+
+        .bus_rsp_vld                ( gemm_rsp_vld          ),
+        .bus_rsp_rdy                ( gemm_rsp_rdy          ),
+        .bus_rsp_excp               ( gemm_rsp_excp         ),
+        .bus_rsp_data               ( gemm_rsp_data         ),
+
+        // APB ports.
+        .apb_psel                   ( gemm_psel             ),
+        .apb_penable                ( gemm_penable          ),
+        .apb_pprot                  ( gemm_pprot            ),
+        .apb_paddr                  ( gemm_paddr            ),
+        .apb_pstrb                  ( gemm_pstrb            ),
+        .apb_pwrite                 ( gemm_pwrite           ),
+        .apb_pwdata                 ( gemm_pwdata           ),
+        .apb_prdata                 ( gemm_prdata           ),
+        .apb_pready                 ( gemm_pready           ),
+        .apb_pslverr                ( gemm_pslverr          )
+    );
+
+    uv_gemm_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .TILE_AW                    ( TILE_AW               )
+    )
+    u_gemm_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // APB ports.
+        .gemm_psel                  ( gemm_psel             ),
+        .gemm_penable               ( gemm_penable          ),
+        .gemm_pprot                 ( gemm_pprot            ),
+        .gemm_paddr                 ( gemm_paddr            ),
+        .gemm_pstrb                 ( gemm_pstrb            ),
+        .gemm_pwrite                ( gemm_pwrite           ),
+        .gemm_pwdata                ( gemm_pwdata           ),
+        .gemm_prdata                ( gemm_prdata           ),
+        .gemm_pready                ( gemm_pready           ),
+        .gemm_pslverr               ( gemm_pslverr          ),
+
+        // Done interrupt.
+        .gemm_irq                   ( gemm_irq              )
+    );
+
+endmodule
@@ -0,0 +1,462 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_gemm_apb
+//
+// Designer: Owen
+//
+// Description:
+//      Matrix-multiply accelerator with APB interface. Packed
+//      A & B tiles and the int32 C tile are kept in 3 banks of
+//      128-bit SRAM, mapped at 0x4000, 0x8000 & 0xC000 for CPU
+//      or DMA, while the engine reads & writes them on another
+//      port. A run is described by the type, dimensions & row
+//      offsets of the tiles, started by GEMM_CTRL, and timed by
+//      GEMM_CYC. Descriptors are not written while busy.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_gemm_apb
+#(
+    parameter ALEN                  = 16,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter TILE_AW               = 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // APB ports.
+    input                           gemm_psel,
+    input                           gemm_penable,
+    input  [2:0]                    gemm_pprot,
+    input  [ALEN-1:0]               gemm_paddr,
+    input  [MLEN-1:0]               gemm_pstrb,
+    input                           gemm_pwrite,
+    input  [DLEN-1:0]               gemm_pwdata,
+    output [DLEN-1:0]               gemm_prdata,
+    output                          gemm_pready,
+    output                          gemm_pslverr,
+
+    // Done interrupt.
+    output                          gemm_irq
+);
+
+    localparam UDLY                 = 1;
+    localparam ADDR_DEC_WIDTH       = ALEN - 2;
+    localparam TILE_DP              = 2**TILE_AW;
+
+    localparam REG_GEMM_CTRL        = 0;
+    localparam REG_GEMM_STAT        = 1;
+    localparam REG_GEMM_CFG         = 2;
+    localparam REG_GEMM_DIM         = 3;
+    localparam REG_GEMM_A_OFS       = 4;
+    localparam REG_GEMM_B_OFS       = 5;
+    localparam REG_GEMM_C_OFS       = 6;
+    localparam REG_GEMM_CYC         = 7;
+    localparam REG_GEMM_ADDR_MAX    = 7;
+
+    localparam TILE_WIN_A           = 2'd1;
+    localparam TILE_WIN_B           = 2'd2;
+    localparam TILE_WIN_C           = 2'd3;
+
+    wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+
+    reg  [1:0]                      gemm_type_r;
+    reg                             gemm_acc_r;
+    reg                             gemm_ie_r;
+    reg  [7:0]                      gemm_m_r;
+    reg  [7:0]                      gemm_n_r;
+    reg  [11:0]                     gemm_k_r;
+    reg  [TILE_AW-1:0]              gemm_a_ofs_r;
+    reg  [TILE_AW-1:0]              gemm_b_ofs_r;
+    reg  [TILE_AW-1:0]              gemm_c_ofs_r;
+    reg  [31:0]                     gemm_cyc_r;
+    reg                             gemm_done_r;
+    reg  [1:0]                      tile_rd_r;
+    reg  [1:0]                      tile_word_r;
+
+    wire                            gemm_start;
+    wire                            gemm_busy;
+    wire                            gemm_done;
+    wire                            desc_wr;
+
+    wire [1:0]                      tile_win;
+    wire                            tile_match;
+    wire                            tile_ovf;
+    wire [TILE_AW-1:0]              tile_row;
+    wire [15:0]                     tile_mask;
+    wire [127:0]                    tile_wdat;
+    wire [127:0]                    tile_rdat;
+    wire                            a_bus_ce;
+    wire                            b_bus_ce;
+    wire                            c_bus_ce;
+    wire [127:0]                    a_bus_dat;
+    wire [127:0]                    b_bus_dat;
+    wire [127:0]                    c_bus_dat;
+
+    wire                            a_rd;
+    wire [TILE_AW-1:0]              a_addr;
+    wire [127:0]                    a_dat;
+    wire                            b_rd;
+    wire [TILE_AW-1:0]              b_addr;
+    wire [127:0]                    b_dat;
+    wire                            c_ce;
+    wire                            c_we;
+    wire [TILE_AW-1:0]              c_addr;
+    wire [127:0]                    c_wdat;
+    wire [127:0]                    c_rdat;
+
+    wire                            gemm_ctrl_match;
+    wire                            gemm_stat_match;
+    wire                            gemm_cfg_match;
+    wire                            gemm_dim_match;
+    wire                            gemm_a_ofs_match;
+    wire                            gemm_b_ofs_match;
+    wire                            gemm_c_ofs_match;
+    wire                            gemm_cyc_match;
+    wire                            addr_mismatch;
+
+    wire                            gemm_ctrl_wr;
+    wire                            gemm_stat_wr;
+    wire                            gemm_cfg_wr;
+    wire                            gemm_dim_wr;
+    wire                            gemm_a_ofs_wr;
+    wire                            gemm_b_ofs_wr;
+    wire                            gemm_c_ofs_wr;
+    wire                            gemm_tile_wr;
+
+    wire                            gemm_stat_rd;
+    wire                            gemm_cfg_rd;
+    wire                            gemm_dim_rd;
+    wire                            gemm_a_ofs_rd;
+    wire                            gemm_b_ofs_rd;
+    wire                            gemm_c_ofs_rd;
+    wire                            gemm_cyc_rd;
+    wire                            gemm_tile_rd;
+
+    // Response.
+    reg                             rsp_vld_r;
+    reg                             rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    // Address decoding.
+    assign dec_addr                 = gemm_paddr[ALEN-1:2];
+    assign tile_win                 = gemm_paddr[15:14];
+    assign tile_ovf                 = |(gemm_paddr[13:4] >> TILE_AW);
+    assign tile_match               = tile_win != 2'd0;
+
+    assign gemm_ctrl_match          = dec_addr == REG_GEMM_CTRL [ADDR_DEC_WIDTH-1:0];
+    assign gemm_stat_match          = dec_addr == REG_GEMM_STAT [ADDR_DEC_WIDTH-1:0];
+    assign gemm_cfg_match           = dec_addr == REG_GEMM_CFG  [ADDR_DEC_WIDTH-1:0];
+    assign gemm_dim_match           = dec_addr == REG_GEMM_DIM  [ADDR_DEC_WIDTH-1:0];
+    assign gemm_a_ofs_match         = dec_addr == REG_GEMM_A_OFS[ADDR_DEC_WIDTH-1:0];
+    assign gemm_b_ofs_match         = dec_addr == REG_GEMM_B_OFS[ADDR_DEC_WIDTH-1:0];
+    assign gemm_c_ofs_match         = dec_addr == REG_GEMM_C_OFS[ADDR_DEC_WIDTH-1:0];
+    assign gemm_cyc_match           = dec_addr == REG_GEMM_CYC  [ADDR_DEC_WIDTH-1:0];
+    assign addr_mismatch            = tile_match ? tile_ovf : (dec_addr > REG_GEMM_ADDR_MAX[ADDR_DEC_WIDTH-1:0]);
+
+    assign gemm_ctrl_wr             = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_ctrl_match ;
+    assign gemm_stat_wr             = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_stat_match ;
+    assign gemm_cfg_wr              = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_cfg_match  ;
+    assign gemm_dim_wr              = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_dim_match  ;
+    assign gemm_a_ofs_wr            = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_a_ofs_match;
+    assign gemm_b_ofs_wr            = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_b_ofs_match;
+    assign gemm_c_ofs_wr            = gemm_psel & (~gemm_penable) & gemm_pwrite & gemm_c_ofs_match;
+    assign gemm_tile_wr             = gemm_psel & (~gemm_penable) & gemm_pwrite & tile_match & (~tile_ovf);
+
+    assign gemm_stat_rd             = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_stat_match ;
+    assign gemm_cfg_rd              = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_cfg_match  ;
+    assign gemm_dim_rd              = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_dim_match  ;
+    assign gemm_a_ofs_rd            = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_a_ofs_match;
+    assign gemm_b_ofs_rd            = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_b_ofs_match;
+    assign gemm_c_ofs_rd            = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_c_ofs_match;
+    assign gemm_cyc_rd              = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & gemm_cyc_match  ;
+    assign gemm_tile_rd             = gemm_psel & (~gemm_penable) & (~gemm_pwrite) & tile_match & (~tile_ovf);
+
+    assign gemm_start               = gemm_ctrl_wr & gemm_pstrb[0] & gemm_pwdata[0];
+    assign desc_wr                  = ~gemm_busy;
+    assign gemm_irq                 = gemm_ie_r & gemm_done_r;
+
+    // Tile rows, written & read by words.
+    assign tile_row                 = gemm_paddr[TILE_AW+3:4];
+    assign tile_mask                = {12'b0, gemm_pstrb[3:0]} << {gemm_paddr[3:2], 2'b0};
+    assign tile_wdat                = {4{gemm_pwdata[31:0]}};
+    assign a_bus_ce                 = (gemm_tile_wr | gemm_tile_rd) & (tile_win == TILE_WIN_A);
+    assign b_bus_ce                 = (gemm_tile_wr | gemm_tile_rd) & (tile_win == TILE_WIN_B);
+    assign c_bus_ce                 = (gemm_tile_wr | gemm_tile_rd) & (tile_win == TILE_WIN_C);
+    assign tile_rdat                = tile_rd_r == TILE_WIN_A ? a_bus_dat
+                                    : tile_rd_r == TILE_WIN_B ? b_bus_dat : c_bus_dat;
+
+    // Bus response.
+    assign gemm_prdata              = (|tile_rd_r) ? {{(DLEN-32){1'b0}}, tile_rdat[{tile_word_r, 5'b0}+:32]}
+                                    : rsp_data_r;
+    assign gemm_pready              = rsp_vld_r;
+    assign gemm_pslverr             = rsp_excp_r;
+
+    // Write descriptor from bus.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gemm_type_r <= 2'd0;
+            gemm_acc_r  <= 1'b0;
+            gemm_ie_r   <= 1'b0;
+        end
+        else begin
+            if (gemm_cfg_wr & desc_wr) begin
+                gemm_type_r <= #UDLY gemm_pstrb[0] ? gemm_pwdata[1:0] : gemm_type_r;
+                gemm_acc_r  <= #UDLY gemm_pstrb[0] ? gemm_pwdata[4]   : gemm_acc_r;
+                gemm_ie_r   <= #UDLY gemm_pstrb[1] ? gemm_pwdata[8]   : gemm_ie_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gemm_m_r <= 8'd0;
+            gemm_n_r <= 8'd0;
+            gemm_k_r <= 12'd0;
+        end
+        else begin
+            if (gemm_dim_wr & desc_wr) begin
+                gemm_m_r        <= #UDLY gemm_pstrb[0] ? gemm_pwdata[7:0]   : gemm_m_r;
+                gemm_n_r        <= #UDLY gemm_pstrb[1] ? gemm_pwdata[15:8]  : gemm_n_r;
+                gemm_k_r[7:0]   <= #UDLY gemm_pstrb[2] ? gemm_pwdata[23:16] : gemm_k_r[7:0];
+                gemm_k_r[11:8]  <= #UDLY gemm_pstrb[3] ? gemm_pwdata[27:24] : gemm_k_r[11:8];
+            end
+        end
+    end
+
+    // Offsets are in bytes of 16-byte rows.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gemm_a_ofs_r <= {TILE_AW{1'b0}};
+            gemm_b_ofs_r <= {TILE_AW{1'b0}};
+            gemm_c_ofs_r <= {TILE_AW{1'b0}};
+        end
+        else begin
+            if (gemm_a_ofs_wr & desc_wr) begin
+                gemm_a_ofs_r <= #UDLY gemm_pwdata[TILE_AW+3:4];
+            end
+            if (gemm_b_ofs_wr & desc_wr) begin
+                gemm_b_ofs_r <= #UDLY gemm_pwdata[TILE_AW+3:4];
+            end
+            if (gemm_c_ofs_wr & desc_wr) begin
+                gemm_c_ofs_r <= #UDLY gemm_pwdata[TILE_AW+3:4];
+            end
+        end
+    end
+
+    // Cycles of the last run & sticky done.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gemm_cyc_r <= 32'd0;
+        end
+        else begin
+            if (gemm_start & (~gemm_busy)) begin
+                gemm_cyc_r <= #UDLY 32'd0;
+            end
+            else if (gemm_busy) begin
+                gemm_cyc_r <= #UDLY gemm_cyc_r + 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gemm_done_r <= 1'b0;
+        end
+        else begin
+            if (gemm_done) begin
+                gemm_done_r <= #UDLY 1'b1;
+            end
+            else if ((gemm_start & (~gemm_busy)) | (gemm_stat_wr & gemm_pstrb[0] & gemm_pwdata[1])) begin
+                gemm_done_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    // Response buf.
+    always @(*) begin
+        case (1'b1)
+            gemm_stat_rd : rsp_data = {{(DLEN-2){1'b0}}, gemm_done_r, gemm_busy};
+            gemm_cfg_rd  : rsp_data = {{(DLEN-9){1'b0}}, gemm_ie_r, 3'b0, gemm_acc_r, 2'b0, gemm_type_r};
+            gemm_dim_rd  : rsp_data = {{(DLEN-28){1'b0}}, gemm_k_r, gemm_n_r, gemm_m_r};
+            gemm_a_ofs_rd: rsp_data = {{(DLEN-TILE_AW-4){1'b0}}, gemm_a_ofs_r, 4'b0};
+            gemm_b_ofs_rd: rsp_data = {{(DLEN-TILE_AW-4){1'b0}}, gemm_b_ofs_r, 4'b0};
+            gemm_c_ofs_rd: rsp_data = {{(DLEN-TILE_AW-4){1'b0}}, gemm_c_ofs_r, 4'b0};
+            gemm_cyc_rd  : rsp_data = {{(DLEN-32){1'b0}}, gemm_cyc_r};
+            default      : rsp_data = {DLEN{1'b0}};
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (gemm_psel & (~gemm_penable)) begin
+                rsp_data_r <= #UDLY rsp_data;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            tile_rd_r   <= 2'd0;
+            tile_word_r <= 2'd0;
+        end
+        else begin
+            if (gemm_psel & (~gemm_penable)) begin
+                tile_rd_r   <= #UDLY gemm_tile_rd ? tile_win : 2'd0;
+                tile_word_r <= #UDLY gemm_paddr[3:2];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r <= 1'b0;
+        end
+        else begin
+            if (gemm_psel & (~gemm_penable)) begin
+                rsp_vld_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_excp_r <= 1'b0;
+        end
+        else begin
+            if (gemm_psel & (~gemm_penable) & addr_mismatch) begin
+                rsp_excp_r <= #UDLY 1'b1;
+            end
+            else begin
+                rsp_excp_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    // Tile SRAMs, with bus on port A & engine on port B.
+    uv_sram_dp
+    #(
+        .RAM_AW                     ( TILE_AW               ),
+        .RAM_DP                     ( TILE_DP               ),
+        .RAM_DW                     ( 128                   ),
+        .RAM_MW                     ( 16                    )
+    )
+    u_tile_a
+    (
+        .clk                        ( clk                   ),
+
+        .cea                        ( a_bus_ce              ),
+        .wea                        ( gemm_tile_wr          ),
+        .aa                         ( tile_row              ),
+        .da                         ( tile_wdat             ),
+        .ma                         ( tile_mask             ),
+        .qa                         ( a_bus_dat             ),
+
+        .ceb                        ( a_rd                  ),
+        .web                        ( 1'b0                  ),
+        .ab                         ( a_addr                ),
+        .db                         ( 128'b0                ),
+        .mb                         ( 16'b0                 ),
+        .qb                         ( a_dat                 )
+    );
+
+    uv_sram_dp
+    #(
+        .RAM_AW                     ( TILE_AW               ),
+        .RAM_DP                     ( TILE_DP               ),
+        .RAM_DW                     ( 128                   ),
+        .RAM_MW                     ( 16                    )
+    )
+    u_tile_b
+    (
+        .clk                        ( clk                   ),
+
+        .cea                        ( b_bus_ce              ),
+        .wea                        ( gemm_tile_wr          ),
+        .aa                         ( tile_row              ),
+        .da                         ( tile_wdat             ),
+        .ma                         ( tile_mask             ),
+        .qa                         ( b_bus_dat             ),
+
+        .ceb                        ( b_rd                  ),
+        .web                        ( 1'b0                  ),
+        .ab                         ( b_addr                ),
+        .db                         ( 128'b0                ),
+        .mb                         ( 16'b0                 ),
+        .qb                         ( b_dat                 )
+    );
+
+    uv_sram_dp
+    #(
+        .RAM_AW                     ( TILE_AW               ),
+        .RAM_DP                     ( TILE_DP               ),
+        .RAM_DW                     ( 128                   ),
+        .RAM_MW                     ( 16                    )
+    )
+    u_tile_c
+    (
+        .clk                        ( clk                   ),
+
+        .cea                        ( c_bus_ce              ),
+        .wea                        ( gemm_tile_wr          ),
+        .aa                         ( tile_row              ),
+        .da                         ( tile_wdat             ),
+        .ma                         ( tile_mask             ),
+        .qa                         ( c_bus_dat             ),
+
+        .ceb                        ( c_ce                  ),
+        .web                        ( c_we                  ),
+        .ab                         ( c_addr                ),
+        .db                         ( c_wdat                ),
+        .mb                         ( {16{c_we}}            ),
+        .qb                         ( c_rdat                )
+    );
+
+    uv_gemm_mac
+    #(
+        .TILE_AW                    ( TILE_AW               )
+    )
+    u_gemm_mac
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Descriptor.
+        .gemm_start                 ( gemm_start            ),
+        .gemm_type                  ( gemm_type_r           ),
+        .gemm_acc                   ( gemm_acc_r            ),
+        .gemm_mp                    ( gemm_m_r[7:2]         ),
+        .gemm_np                    ( gemm_n_r[7:2]         ),
+        .gemm_k                     ( gemm_k_r              ),
+        .gemm_a_ofs                 ( gemm_a_ofs_r          ),
+        .gemm_b_ofs                 ( gemm_b_ofs_r          ),
+        .gemm_c_ofs                 ( gemm_c_ofs_r          ),
+        .gemm_busy                  ( gemm_busy             ),
+        .gemm_done                  ( gemm_done             ),
+
+        // Tile SRAM ports.
+        .a_rd                       ( a_rd                  ),
+        .a_addr                     ( a_addr                ),
+        .a_dat                      ( a_dat                 ),
+        .b_rd                       ( b_rd                  ),
+        .b_addr                     ( b_addr                ),
+        .b_dat                      ( b_dat                 ),
+        .c_ce                       ( c_ce                  ),
+        .c_we                       ( c_we                  ),
+        .c_addr                     ( c_addr                ),
+        .c_wdat                     ( c_wdat                ),
+        .c_rdat                     ( c_rdat                )
+    );
+
+endmodule
@@ -0,0 +1,274 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_gemm_mac
+//
+// Designer: Owen
+//
+// Description:
+//      Output-stationary GEMM engine with a 4x4 array of MACs,
+//      computing C = A * B or C += A * B over tiles in local
+//      SRAM. A is kept in panels of 4 rows & B in panels of 4
+//      columns, each as K steps of 4 int8, int16 or int32
+//      elements, packed into 128-bit rows. Each cycle reads a
+//      step of an A panel & a B panel, & adds their outer
+//      product to 16 int32 sums. At the end of K steps, the 4x4
+//      block is written to C as 4 rows of a row-major int32
+//      matrix of N columns, read back first when accumulating.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_gemm_mac
+#(
+    parameter TILE_AW               = 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Descriptor.
+    input                           gemm_start,
+    input  [1:0]                    gemm_type,
+    input                           gemm_acc,
+    input  [5:0]                    gemm_mp,
+    input  [5:0]                    gemm_np,
+    input  [11:0]                   gemm_k,
+    input  [TILE_AW-1:0]            gemm_a_ofs,
+    input  [TILE_AW-1:0]            gemm_b_ofs,
+    input  [TILE_AW-1:0]            gemm_c_ofs,
+    output                          gemm_busy,
+    output                          gemm_done,
+
+    // Tile SRAM ports.
+    output                          a_rd,
+    output [TILE_AW-1:0]            a_addr,
+    input  [127:0]                  a_dat,
+    output                          b_rd,
+    output [TILE_AW-1:0]            b_addr,
+    input  [127:0]                  b_dat,
+    output                          c_ce,
+    output                          c_we,
+    output [TILE_AW-1:0]            c_addr,
+    output [127:0]                  c_wdat,
+    input  [127:0]                  c_rdat
+);
+
+    localparam UDLY                 = 1;
+    localparam MAC_DIM              = 4;
+
+    localparam FSM_GEMM_IDLE        = 3'd0;
+    localparam FSM_GEMM_MAC         = 3'd1;
+    localparam FSM_GEMM_WAIT        = 3'd2;
+    localparam FSM_GEMM_CRD         = 3'd3;
+    localparam FSM_GEMM_CWR         = 3'd4;
+
+    localparam TYPE_INT8            = 2'd0;
+    localparam TYPE_INT16           = 2'd1;
+
+    genvar i;
+    genvar j;
+
+    reg  [2:0]                      cur_state;
+    reg  [2:0]                      nxt_state;
+
+    reg  [11:0]                     k_r;
+    reg  [5:0]                      ip_r;
+    reg  [5:0]                      jp_r;
+    reg  [1:0]                      row_r;
+    reg  [TILE_AW-1:0]              a_pan_r;
+    reg  [TILE_AW-1:0]              b_pan_r;
+    reg  [TILE_AW-1:0]              c_pan_r;
+    reg  [1:0]                      lane_r;
+    reg                             mac_vld_r;
+    reg  [31:0]                     acc_r [0:MAC_DIM*MAC_DIM-1];
+
+    wire                            start;
+    wire                            k_last;
+    wire                            row_last;
+    wire                            ip_last;
+    wire                            jp_last;
+    wire                            tile_end;
+    wire                            tile_next;
+    wire [1:0]                      lane_sft;
+    wire [1:0]                      lane;
+    wire [11:0]                     k_step;
+    wire [TILE_AW-1:0]              k_rows;
+    wire [TILE_AW-1:0]              c_row;
+
+    wire [31:0]                     a_w8;
+    wire [63:0]                     a_w16;
+    wire [31:0]                     b_w8;
+    wire [63:0]                     b_w16;
+    wire [31:0]                     a_opd [0:MAC_DIM-1];
+    wire [31:0]                     b_opd [0:MAC_DIM-1];
+    wire [127:0]                    c_sum;
+
+    // Steps of 4 elements per 128-bit row: 4 of int8, 2 of int16 & 1 of int32.
+    assign lane_sft                 = gemm_type == TYPE_INT8  ? 2'd2
+                                    : gemm_type == TYPE_INT16 ? 2'd1 : 2'd0;
+    assign lane                     = k_r[1:0] & ((2'd1 << lane_sft) - 1'b1);
+    assign k_step                   = k_r >> lane_sft;
+    assign k_rows                   = (gemm_k + (12'd1 << lane_sft) - 1'b1) >> lane_sft;
+
+    assign start                    = gemm_start & (cur_state == FSM_GEMM_IDLE);
+    assign k_last                   = k_r == gemm_k - 1'b1;
+    assign row_last                 = &row_r;
+    assign ip_last                  = ip_r == gemm_mp - 1'b1;
+    assign jp_last                  = jp_r == gemm_np - 1'b1;
+    assign tile_end                 = (cur_state == FSM_GEMM_CWR) & row_last;
+    assign tile_next                = tile_end & (~(ip_last & jp_last));
+
+    assign gemm_busy                = cur_state != FSM_GEMM_IDLE;
+    assign gemm_done                = (tile_end & ip_last & jp_last)
+                                    | (start & ((~(|gemm_mp)) | (~(|gemm_np)) | (~(|gemm_k))));
+
+    assign a_rd                     = cur_state == FSM_GEMM_MAC;
+    assign a_addr                   = a_pan_r + k_step[TILE_AW-1:0];
+    assign b_rd                     = cur_state == FSM_GEMM_MAC;
+    assign b_addr                   = b_pan_r + k_step[TILE_AW-1:0];
+
+    // Row r of the block is at row (4 * ip + r) * NP + jp of C.
+    assign c_row                    = c_pan_r + jp_r
+                                    + (row_r[1] ? {gemm_np, 1'b0} : {TILE_AW{1'b0}})
+                                    + (row_r[0] ? gemm_np : {TILE_AW{1'b0}});
+    assign c_ce                     = (cur_state == FSM_GEMM_CRD) | (cur_state == FSM_GEMM_CWR);
+    assign c_we                     = cur_state == FSM_GEMM_CWR;
+    assign c_addr                   = c_row;
+    assign c_wdat                   = gemm_acc ? c_sum : {acc_r[{row_r, 2'd3}], acc_r[{row_r, 2'd2}],
+                                                          acc_r[{row_r, 2'd1}], acc_r[{row_r, 2'd0}]};
+
+    generate
+        for (j = 0; j < MAC_DIM; j = j + 1) begin: gen_c_sum
+            assign c_sum[j*32+:32]  = c_rdat[j*32+:32] + acc_r[{row_r, 2'b0} + j];
+        end
+    endgenerate
+
+    // Operands of the step, sign-extended to 32 bits.
+    assign a_w8                     = a_dat[{lane_r, 5'b0}+:32];
+    assign a_w16                    = a_dat[{lane_r[0], 6'b0}+:64];
+    assign b_w8                     = b_dat[{lane_r, 5'b0}+:32];
+    assign b_w16                    = b_dat[{lane_r[0], 6'b0}+:64];
+
+    generate
+        for (i = 0; i < MAC_DIM; i = i + 1) begin: gen_opd
+            assign a_opd[i]         = gemm_type == TYPE_INT8  ? {{24{a_w8[i*8+7]}}, a_w8[i*8+:8]}
+                                    : gemm_type == TYPE_INT16 ? {{16{a_w16[i*16+15]}}, a_w16[i*16+:16]}
+                                    : a_dat[i*32+:32];
+            assign b_opd[i]         = gemm_type == TYPE_INT8  ? {{24{b_w8[i*8+7]}}, b_w8[i*8+:8]}
+                                    : gemm_type == TYPE_INT16 ? {{16{b_w16[i*16+15]}}, b_w16[i*16+:16]}
+                                    : b_dat[i*32+:32];
+        end
+    endgenerate
+
+    // FSM.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_state <= FSM_GEMM_IDLE;
+        end
+        else begin
+            cur_state <= #UDLY nxt_state;
+        end
+    end
+
+    always @(*) begin
+        case (cur_state)
+            FSM_GEMM_IDLE: nxt_state = start & (~gemm_done) ? FSM_GEMM_MAC : FSM_GEMM_IDLE;
+            FSM_GEMM_MAC : nxt_state = k_last ? FSM_GEMM_WAIT : FSM_GEMM_MAC;
+            FSM_GEMM_WAIT: nxt_state = gemm_acc ? FSM_GEMM_CRD : FSM_GEMM_CWR;
+            FSM_GEMM_CRD : nxt_state = FSM_GEMM_CWR;
+            FSM_GEMM_CWR : nxt_state = ~row_last ? (gemm_acc ? FSM_GEMM_CRD : FSM_GEMM_CWR)
+                                     : tile_next ? FSM_GEMM_MAC : FSM_GEMM_IDLE;
+            default      : nxt_state = FSM_GEMM_IDLE;
+        endcase
+    end
+
+    // Steps, rows of the block & panels.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            k_r   <= 12'd0;
+            row_r <= 2'd0;
+        end
+        else begin
+            if (start | tile_next) begin
+                k_r   <= #UDLY 12'd0;
+            end
+            else if (a_rd) begin
+                k_r   <= #UDLY k_r + 1'b1;
+            end
+
+            if (start) begin
+                row_r <= #UDLY 2'd0;
+            end
+            else if (c_we) begin
+                row_r <= #UDLY row_r + 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ip_r    <= 6'd0;
+            jp_r    <= 6'd0;
+            a_pan_r <= {TILE_AW{1'b0}};
+            b_pan_r <= {TILE_AW{1'b0}};
+            c_pan_r <= {TILE_AW{1'b0}};
+        end
+        else begin
+            if (start) begin
+                ip_r    <= #UDLY 6'd0;
+                jp_r    <= #UDLY 6'd0;
+                a_pan_r <= #UDLY gemm_a_ofs;
+                b_pan_r <= #UDLY gemm_b_ofs;
+                c_pan_r <= #UDLY gemm_c_ofs;
+            end
+            else if (tile_next & jp_last) begin
+                ip_r    <= #UDLY ip_r + 1'b1;
+                jp_r    <= #UDLY 6'd0;
+                a_pan_r <= #UDLY a_pan_r + k_rows;
+                b_pan_r <= #UDLY gemm_b_ofs;
+                c_pan_r <= #UDLY c_pan_r + {gemm_np, 2'b0};
+            end
+            else if (tile_next) begin
+                jp_r    <= #UDLY jp_r + 1'b1;
+                b_pan_r <= #UDLY b_pan_r + k_rows;
+            end
+        end
+    end
+
+    // Lanes go with the rows being read.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            lane_r    <= 2'd0;
+            mac_vld_r <= 1'b0;
+        end
+        else begin
+            if (a_rd) begin
+                lane_r <= #UDLY lane;
+            end
+            mac_vld_r <= #UDLY a_rd;
+        end
+    end
+
+    // MAC array, wrapping at 32 bits.
+    generate
+        for (i = 0; i < MAC_DIM; i = i + 1) begin: gen_mac_row
+            for (j = 0; j < MAC_DIM; j = j + 1) begin: gen_mac_col
+                always @(posedge clk or negedge rst_n) begin
+                    if (~rst_n) begin
+                        acc_r[i*MAC_DIM+j] <= 32'd0;
+                    end
+                    else begin
+                        if (start | tile_next) begin
+                            acc_r[i*MAC_DIM+j] <= #UDLY 32'd0;
+                        end
+                        else if (mac_vld_r) begin
+                            acc_r[i*MAC_DIM+j] <= #UDLY acc_r[i*MAC_DIM+j] + a_opd[i] * b_opd[j];
+                        end
+                    end
+                end
+            end
+        end
+    endgenerate
+
+endmodule
@@ -43,10 +43,15 @@ module uv_gpio
     input  [IO_NUM-1:0]             gpio_in,
     output [IO_NUM-1:0]             gpio_oe,
     output [IO_NUM-1:0]             gpio_out,
-    output [IO_NUM-1:0]             gpio_irq
+    output [IO_NUM-1:0]             gpio_irq,
+
+    input  [IO_NUM-1:0]             gpio_task_set,
+    input  [IO_NUM-1:0]             gpio_task_clr,
+    input  [IO_NUM-1:0]             gpio_task_tgl
 );
 
     localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
 
     wire                            gpio_psel;
     wire                            gpio_penable;
@@ -64,7 +69,8 @@ module uv_gpio
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .PIPE                       ( BUS_PIPE              )
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
     )
     u_bus_to_apb
     (
@@ -130,7 +136,11 @@ module uv_gpio
         .gpio_in                    ( gpio_in               ),
         .gpio_oe                    ( gpio_oe               ),
         .gpio_out                   ( gpio_out              ),
-        .gpio_irq                   ( gpio_irq              )
+        .gpio_irq                   ( gpio_irq              ),
+
+        .gpio_task_set              ( gpio_task_set         ),
+        .gpio_task_clr              ( gpio_task_clr         ),
+        .gpio_task_tgl              ( gpio_task_tgl         )
     );
 
 endmodule
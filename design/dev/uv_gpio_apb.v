@@ -6,7 +6,13 @@
 // Designer: Owen
 //
 // Description:
-//      General-purpose IO with APB interface.
+//      General-purpose IO with APB interface. OUT_VALUE,
+//      OUT_ENABLE & IRQ_ENABLE have SET, CLR & TGL aliases to
+//      change bits written 1, and each bit of the first 8
+//      registers is aliased to a word from 0x400, where bit 0
+//      is read or written, so that pins are changed without
+//      read-modify-write by CPU. Tasks from the event router
+//      set, clear or toggle outputs on top of bus writes.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -43,7 +49,12 @@ module uv_gpio_apb
     input  [IO_NUM-1:0]             gpio_in,
     output [IO_NUM-1:0]             gpio_oe,
     output [IO_NUM-1:0]             gpio_out,
-    output [IO_NUM-1:0]             gpio_irq
+    output [IO_NUM-1:0]             gpio_irq,
+
+    // Output tasks from event router.
+    input  [IO_NUM-1:0]             gpio_task_set,
+    input  [IO_NUM-1:0]             gpio_task_clr,
+    input  [IO_NUM-1:0]             gpio_task_tgl
 );
 
     localparam UDLY                 = 1;
@@ -58,11 +69,33 @@ module uv_gpio_apb
     localparam REG_GPIO_OUT_ENABLE  = 5;
     localparam REG_GPIO_IRQ_PEND    = 6;
     localparam REG_GPIO_IRQ_ENABLE  = 7;
-    localparam REG_GPIO_ADDR_MAX    = 7;
+    localparam REG_GPIO_OUT_SET     = 8;
+    localparam REG_GPIO_OUT_CLR     = 9;
+    localparam REG_GPIO_OUT_TGL     = 10;
+    localparam REG_GPIO_OE_SET      = 11;
+    localparam REG_GPIO_OE_CLR      = 12;
+    localparam REG_GPIO_OE_TGL      = 13;
+    localparam REG_GPIO_IRQ_EN_SET  = 14;
+    localparam REG_GPIO_IRQ_EN_CLR  = 15;
+    localparam REG_GPIO_IRQ_EN_TGL  = 16;
+    localparam REG_GPIO_ADDR_MAX    = 16;
+
+    // Bit-band alias: word 32 * reg + bit.
+    localparam REG_GPIO_BB_START    = 256;
+    localparam REG_GPIO_BB_END      = REG_GPIO_BB_START + 8 * 32 - 1;
 
     genvar i;
 
     wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+    wire [ADDR_DEC_WIDTH-1:0]       reg_addr;
+    wire [ADDR_DEC_WIDTH-1:0]       bb_idx;
+    wire                            bb_match;
+    wire [4:0]                      bb_bit;
+    wire [31:0]                     bb_mask;
+    reg  [31:0]                     reg_val;
+    wire [31:0]                     wr_data;
+    wire [3:0]                      wr_strb;
+    wire [31:0]                     wr_bits;
 
     reg  [31:0]                     pull_up_r;
     reg  [31:0]                     pull_down_r;
@@ -72,6 +105,11 @@ module uv_gpio_apb
     reg  [31:0]                     irq_pend_r;
     reg  [31:0]                     irq_enable_r;
 
+    reg  [31:0]                     out_value_bus;
+    wire [31:0]                     task_set;
+    wire [31:0]                     task_clr;
+    wire [31:0]                     task_tgl;
+
     wire [31:0]                     in_value;
     wire [IO_NUM-1:0]               gpio_in_sync;
 
@@ -83,6 +121,15 @@ module uv_gpio_apb
     wire                            out_enable_match;
     wire                            irq_pend_match;
     wire                            irq_enable_match;
+    wire                            out_set_match;
+    wire                            out_clr_match;
+    wire                            out_tgl_match;
+    wire                            oe_set_match;
+    wire                            oe_clr_match;
+    wire                            oe_tgl_match;
+    wire                            irq_en_set_match;
+    wire                            irq_en_clr_match;
+    wire                            irq_en_tgl_match;
     wire                            addr_mismatch;
 
     wire                            pull_up_wr;
@@ -93,15 +140,15 @@ module uv_gpio_apb
     wire                            out_enable_wr;
     wire                            irq_pend_wr;
     wire                            irq_enable_wr;
-
-    wire                            pull_up_rd;
-    wire                            pull_down_rd;
-    wire                            in_value_rd;
-    wire                            in_enable_rd;
-    wire                            out_value_rd;
-    wire                            out_enable_rd;
-    wire                            irq_pend_rd;
-    wire                            irq_enable_rd;
+    wire                            out_set_wr;
+    wire                            out_clr_wr;
+    wire                            out_tgl_wr;
+    wire                            oe_set_wr;
+    wire                            oe_clr_wr;
+    wire                            oe_tgl_wr;
+    wire                            irq_en_set_wr;
+    wire                            irq_en_clr_wr;
+    wire                            irq_en_tgl_wr;
 
     // Response.
     reg                             rsp_vld_r;
@@ -109,17 +156,33 @@ module uv_gpio_apb
     reg  [DLEN-1:0]                 rsp_data;
     reg  [DLEN-1:0]                 rsp_data_r;
 
-    // Address decoding.
+    // Address decoding, with bit-band alias mapped to its register.
     assign dec_addr                 = gpio_paddr[ALEN-1:2];
-    assign pull_up_match            = dec_addr == REG_GPIO_PULL_UP   [ADDR_DEC_WIDTH-1:0];
-    assign pull_down_match          = dec_addr == REG_GPIO_PULL_DOWN [ADDR_DEC_WIDTH-1:0];
-    assign in_value_match           = dec_addr == REG_GPIO_IN_VALUE  [ADDR_DEC_WIDTH-1:0];
-    assign in_enable_match          = dec_addr == REG_GPIO_IN_ENABLE [ADDR_DEC_WIDTH-1:0];
-    assign out_value_match          = dec_addr == REG_GPIO_OUT_VALUE [ADDR_DEC_WIDTH-1:0];
-    assign out_enable_match         = dec_addr == REG_GPIO_OUT_ENABLE[ADDR_DEC_WIDTH-1:0];
-    assign irq_pend_match           = dec_addr == REG_GPIO_IRQ_PEND  [ADDR_DEC_WIDTH-1:0];
-    assign irq_enable_match         = dec_addr == REG_GPIO_IRQ_ENABLE[ADDR_DEC_WIDTH-1:0];
-    assign addr_mismatch            = dec_addr >  REG_GPIO_ADDR_MAX  [ADDR_DEC_WIDTH-1:0];
+    assign bb_match                 =  (dec_addr >= REG_GPIO_BB_START[ADDR_DEC_WIDTH-1:0])
+                                    && (dec_addr <= REG_GPIO_BB_END  [ADDR_DEC_WIDTH-1:0]);
+    assign bb_idx                   = dec_addr - REG_GPIO_BB_START[ADDR_DEC_WIDTH-1:0];
+    assign bb_bit                   = bb_idx[4:0];
+    assign bb_mask                  = 32'b1 << bb_bit;
+    assign reg_addr                 = bb_match ? {{(ADDR_DEC_WIDTH-3){1'b0}}, bb_idx[7:5]} : dec_addr;
+
+    assign pull_up_match            = reg_addr == REG_GPIO_PULL_UP   [ADDR_DEC_WIDTH-1:0];
+    assign pull_down_match          = reg_addr == REG_GPIO_PULL_DOWN [ADDR_DEC_WIDTH-1:0];
+    assign in_value_match           = reg_addr == REG_GPIO_IN_VALUE  [ADDR_DEC_WIDTH-1:0];
+    assign in_enable_match          = reg_addr == REG_GPIO_IN_ENABLE [ADDR_DEC_WIDTH-1:0];
+    assign out_value_match          = reg_addr == REG_GPIO_OUT_VALUE [ADDR_DEC_WIDTH-1:0];
+    assign out_enable_match         = reg_addr == REG_GPIO_OUT_ENABLE[ADDR_DEC_WIDTH-1:0];
+    assign irq_pend_match           = reg_addr == REG_GPIO_IRQ_PEND  [ADDR_DEC_WIDTH-1:0];
+    assign irq_enable_match         = reg_addr == REG_GPIO_IRQ_ENABLE[ADDR_DEC_WIDTH-1:0];
+    assign out_set_match            = reg_addr == REG_GPIO_OUT_SET   [ADDR_DEC_WIDTH-1:0];
+    assign out_clr_match            = reg_addr == REG_GPIO_OUT_CLR   [ADDR_DEC_WIDTH-1:0];
+    assign out_tgl_match            = reg_addr == REG_GPIO_OUT_TGL   [ADDR_DEC_WIDTH-1:0];
+    assign oe_set_match             = reg_addr == REG_GPIO_OE_SET    [ADDR_DEC_WIDTH-1:0];
+    assign oe_clr_match             = reg_addr == REG_GPIO_OE_CLR    [ADDR_DEC_WIDTH-1:0];
+    assign oe_tgl_match             = reg_addr == REG_GPIO_OE_TGL    [ADDR_DEC_WIDTH-1:0];
+    assign irq_en_set_match         = reg_addr == REG_GPIO_IRQ_EN_SET[ADDR_DEC_WIDTH-1:0];
+    assign irq_en_clr_match         = reg_addr == REG_GPIO_IRQ_EN_CLR[ADDR_DEC_WIDTH-1:0];
+    assign irq_en_tgl_match         = reg_addr == REG_GPIO_IRQ_EN_TGL[ADDR_DEC_WIDTH-1:0];
+    assign addr_mismatch            = (dec_addr > REG_GPIO_ADDR_MAX[ADDR_DEC_WIDTH-1:0]) & (~bb_match);
 
     assign pull_up_wr               = gpio_psel & (~gpio_penable) & gpio_pwrite & pull_up_match   ;
     assign pull_down_wr             = gpio_psel & (~gpio_penable) & gpio_pwrite & pull_down_match ;
@@ -129,21 +192,33 @@ module uv_gpio_apb
     assign out_enable_wr            = gpio_psel & (~gpio_penable) & gpio_pwrite & out_enable_match;
     assign irq_pend_wr              = gpio_psel & (~gpio_penable) & gpio_pwrite & irq_pend_match  ;
     assign irq_enable_wr            = gpio_psel & (~gpio_penable) & gpio_pwrite & irq_enable_match;
-
-    assign pull_up_rd               = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & pull_up_match   ;
-    assign pull_down_rd             = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & pull_down_match ;
-    assign in_value_rd              = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & in_value_match  ;
-    assign in_enable_rd             = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & in_enable_match ;
-    assign out_value_rd             = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & out_value_match ;
-    assign out_enable_rd            = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & out_enable_match;
-    assign irq_pend_rd              = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & irq_pend_match  ;
-    assign irq_enable_rd            = gpio_psel & (~gpio_penable) & (~gpio_pwrite) & irq_enable_match;
+    assign out_set_wr               = gpio_psel & (~gpio_penable) & gpio_pwrite & out_set_match   ;
+    assign out_clr_wr               = gpio_psel & (~gpio_penable) & gpio_pwrite & out_clr_match   ;
+    assign out_tgl_wr               = gpio_psel & (~gpio_penable) & gpio_pwrite & out_tgl_match   ;
+    assign oe_set_wr                = gpio_psel & (~gpio_penable) & gpio_pwrite & oe_set_match    ;
+    assign oe_clr_wr                = gpio_psel & (~gpio_penable) & gpio_pwrite & oe_clr_match    ;
+    assign oe_tgl_wr                = gpio_psel & (~gpio_penable) & gpio_pwrite & oe_tgl_match    ;
+    assign irq_en_set_wr            = gpio_psel & (~gpio_penable) & gpio_pwrite & irq_en_set_match;
+    assign irq_en_clr_wr            = gpio_psel & (~gpio_penable) & gpio_pwrite & irq_en_clr_match;
+    assign irq_en_tgl_wr            = gpio_psel & (~gpio_penable) & gpio_pwrite & irq_en_tgl_match;
+
+    // A bit-band write changes one bit of the register in place.
+    assign wr_data                  = bb_match ? ((reg_val & (~bb_mask)) | (gpio_pwdata[0] ? bb_mask : 32'b0))
+                                    : gpio_pwdata[31:0];
+    assign wr_strb                  = bb_match ? 4'hf : gpio_pstrb[3:0];
+    assign wr_bits                  = wr_data & {{8{wr_strb[3]}}, {8{wr_strb[2]}}, {8{wr_strb[1]}}, {8{wr_strb[0]}}};
 
     // Set GPIO input value.
     assign in_value[IO_NUM-1:0]     = gpio_in_sync;
+    assign task_set[IO_NUM-1:0]     = gpio_task_set;
+    assign task_clr[IO_NUM-1:0]     = gpio_task_clr;
+    assign task_tgl[IO_NUM-1:0]     = gpio_task_tgl;
     generate
         if (IO_NUM < 32) begin: gen_in_sync_pad
             assign in_value[31:IO_NUM] = {(32-IO_NUM){1'b0}};
+            assign task_set[31:IO_NUM] = {(32-IO_NUM){1'b0}};
+            assign task_clr[31:IO_NUM] = {(32-IO_NUM){1'b0}};
+            assign task_tgl[31:IO_NUM] = {(32-IO_NUM){1'b0}};
         end
     endgenerate
 
@@ -167,10 +242,10 @@ module uv_gpio_apb
         end
         else begin
             if (pull_up_wr) begin
-                pull_up_r[7:0]   <= #UDLY gpio_pstrb[0] ? gpio_pwdata[7:0]   : pull_up_r[7:0];
-                pull_up_r[15:8]  <= #UDLY gpio_pstrb[1] ? gpio_pwdata[15:8]  : pull_up_r[15:8];
-                pull_up_r[23:16] <= #UDLY gpio_pstrb[2] ? gpio_pwdata[23:16] : pull_up_r[23:16];
-                pull_up_r[31:24] <= #UDLY gpio_pstrb[3] ? gpio_pwdata[31:24] : pull_up_r[31:24];
+                pull_up_r[7:0]   <= #UDLY wr_strb[0] ? wr_data[7:0]   : pull_up_r[7:0];
+                pull_up_r[15:8]  <= #UDLY wr_strb[1] ? wr_data[15:8]  : pull_up_r[15:8];
+                pull_up_r[23:16] <= #UDLY wr_strb[2] ? wr_data[23:16] : pull_up_r[23:16];
+                pull_up_r[31:24] <= #UDLY wr_strb[3] ? wr_data[31:24] : pull_up_r[31:24];
             end
         end
     end
@@ -181,10 +256,10 @@ module uv_gpio_apb
         end
         else begin
             if (pull_down_wr) begin
-                pull_down_r[7:0]   <= #UDLY gpio_pstrb[0] ? gpio_pwdata[7:0]   : pull_down_r[7:0];
-                pull_down_r[15:8]  <= #UDLY gpio_pstrb[1] ? gpio_pwdata[15:8]  : pull_down_r[15:8];
-                pull_down_r[23:16] <= #UDLY gpio_pstrb[2] ? gpio_pwdata[23:16] : pull_down_r[23:16];
-                pull_down_r[31:24] <= #UDLY gpio_pstrb[3] ? gpio_pwdata[31:24] : pull_down_r[31:24];
+                pull_down_r[7:0]   <= #UDLY wr_strb[0] ? wr_data[7:0]   : pull_down_r[7:0];
+                pull_down_r[15:8]  <= #UDLY wr_strb[1] ? wr_data[15:8]  : pull_down_r[15:8];
+                pull_down_r[23:16] <= #UDLY wr_strb[2] ? wr_data[23:16] : pull_down_r[23:16];
+                pull_down_r[31:24] <= #UDLY wr_strb[3] ? wr_data[31:24] : pull_down_r[31:24];
             end
         end
     end
@@ -195,25 +270,42 @@ module uv_gpio_apb
         end
         else begin
             if (in_enable_wr) begin
-                in_enable_r[7:0]   <= #UDLY gpio_pstrb[0] ? gpio_pwdata[7:0]   : in_enable_r[7:0];
-                in_enable_r[15:8]  <= #UDLY gpio_pstrb[1] ? gpio_pwdata[15:8]  : in_enable_r[15:8];
-                in_enable_r[23:16] <= #UDLY gpio_pstrb[2] ? gpio_pwdata[23:16] : in_enable_r[23:16];
-                in_enable_r[31:24] <= #UDLY gpio_pstrb[3] ? gpio_pwdata[31:24] : in_enable_r[31:24];
+                in_enable_r[7:0]   <= #UDLY wr_strb[0] ? wr_data[7:0]   : in_enable_r[7:0];
+                in_enable_r[15:8]  <= #UDLY wr_strb[1] ? wr_data[15:8]  : in_enable_r[15:8];
+                in_enable_r[23:16] <= #UDLY wr_strb[2] ? wr_data[23:16] : in_enable_r[23:16];
+                in_enable_r[31:24] <= #UDLY wr_strb[3] ? wr_data[31:24] : in_enable_r[31:24];
             end
         end
     end
 
+    // Output value after bus write, with tasks applied on it so that neither is lost.
+    always @(*) begin
+        if (out_value_wr) begin
+            out_value_bus[7:0]   = wr_strb[0] ? wr_data[7:0]   : out_value_r[7:0];
+            out_value_bus[15:8]  = wr_strb[1] ? wr_data[15:8]  : out_value_r[15:8];
+            out_value_bus[23:16] = wr_strb[2] ? wr_data[23:16] : out_value_r[23:16];
+            out_value_bus[31:24] = wr_strb[3] ? wr_data[31:24] : out_value_r[31:24];
+        end
+        else if (out_set_wr) begin
+            out_value_bus = out_value_r | wr_bits;
+        end
+        else if (out_clr_wr) begin
+            out_value_bus = out_value_r & (~wr_bits);
+        end
+        else if (out_tgl_wr) begin
+            out_value_bus = out_value_r ^ wr_bits;
+        end
+        else begin
+            out_value_bus = out_value_r;
+        end
+    end
+
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             out_value_r <= 32'b0;
         end
         else begin
-            if (out_value_wr) begin
-                out_value_r[7:0]   <= #UDLY gpio_pstrb[0] ? gpio_pwdata[7:0]   : out_value_r[7:0];
-                out_value_r[15:8]  <= #UDLY gpio_pstrb[1] ? gpio_pwdata[15:8]  : out_value_r[15:8];
-                out_value_r[23:16] <= #UDLY gpio_pstrb[2] ? gpio_pwdata[23:16] : out_value_r[23:16];
-                out_value_r[31:24] <= #UDLY gpio_pstrb[3] ? gpio_pwdata[31:24] : out_value_r[31:24];
-            end
+            out_value_r <= #UDLY ((out_value_bus | task_set) & (~task_clr)) ^ task_tgl;
         end
     end
 
@@ -223,10 +315,19 @@ module uv_gpio_apb
         end
         else begin
             if (out_enable_wr) begin
-                out_enable_r[7:0]   <= #UDLY gpio_pstrb[0] ? gpio_pwdata[7:0]   : out_enable_r[7:0];
-                out_enable_r[15:8]  <= #UDLY gpio_pstrb[1] ? gpio_pwdata[15:8]  : out_enable_r[15:8];
-                out_enable_r[23:16] <= #UDLY gpio_pstrb[2] ? gpio_pwdata[23:16] : out_enable_r[23:16];
-                out_enable_r[31:24] <= #UDLY gpio_pstrb[3] ? gpio_pwdata[31:24] : out_enable_r[31:24];
+                out_enable_r[7:0]   <= #UDLY wr_strb[0] ? wr_data[7:0]   : out_enable_r[7:0];
+                out_enable_r[15:8]  <= #UDLY wr_strb[1] ? wr_data[15:8]  : out_enable_r[15:8];
+                out_enable_r[23:16] <= #UDLY wr_strb[2] ? wr_data[23:16] : out_enable_r[23:16];
+                out_enable_r[31:24] <= #UDLY wr_strb[3] ? wr_data[31:24] : out_enable_r[31:24];
+            end
+            else if (oe_set_wr) begin
+                out_enable_r <= #UDLY out_enable_r | wr_bits;
+            end
+            else if (oe_clr_wr) begin
+                out_enable_r <= #UDLY out_enable_r & (~wr_bits);
+            end
+            else if (oe_tgl_wr) begin
+                out_enable_r <= #UDLY out_enable_r ^ wr_bits;
             end
         end
     end
@@ -237,10 +338,19 @@ module uv_gpio_apb
         end
         else begin
             if (irq_enable_wr) begin
-                irq_enable_r[7:0]   <= #UDLY gpio_pstrb[0] ? gpio_pwdata[7:0]   : irq_enable_r[7:0];
-                irq_enable_r[15:8]  <= #UDLY gpio_pstrb[1] ? gpio_pwdata[15:8]  : irq_enable_r[15:8];
-                irq_enable_r[23:16] <= #UDLY gpio_pstrb[2] ? gpio_pwdata[23:16] : irq_enable_r[23:16];
-                irq_enable_r[31:24] <= #UDLY gpio_pstrb[3] ? gpio_pwdata[31:24] : irq_enable_r[31:24];
+                irq_enable_r[7:0]   <= #UDLY wr_strb[0] ? wr_data[7:0]   : irq_enable_r[7:0];
+                irq_enable_r[15:8]  <= #UDLY wr_strb[1] ? wr_data[15:8]  : irq_enable_r[15:8];
+                irq_enable_r[23:16] <= #UDLY wr_strb[2] ? wr_data[23:16] : irq_enable_r[23:16];
+                irq_enable_r[31:24] <= #UDLY wr_strb[3] ? wr_data[31:24] : irq_enable_r[31:24];
+            end
+            else if (irq_en_set_wr) begin
+                irq_enable_r <= #UDLY irq_enable_r | wr_bits;
+            end
+            else if (irq_en_clr_wr) begin
+                irq_enable_r <= #UDLY irq_enable_r & (~wr_bits);
+            end
+            else if (irq_en_tgl_wr) begin
+                irq_enable_r <= #UDLY irq_enable_r ^ wr_bits;
             end
         end
     end
@@ -291,21 +401,43 @@ module uv_gpio_apb
         end
     endgenerate
 
-    // Response buf.
+    // Register value, where aliases read the register they change.
     always @(*) begin
         case (1'b1)
-            pull_up_rd    : rsp_data = {{(DLEN-32){1'b0}}, pull_up_r};
-            pull_down_rd  : rsp_data = {{(DLEN-32){1'b0}}, pull_down_r};
-            in_value_rd   : rsp_data = {{(DLEN-32){1'b0}}, in_value};
-            in_enable_rd  : rsp_data = {{(DLEN-32){1'b0}}, in_enable_r};
-            out_value_rd  : rsp_data = {{(DLEN-32){1'b0}}, out_value_r};
-            out_enable_rd : rsp_data = {{(DLEN-32){1'b0}}, out_enable_r};
-            irq_pend_rd   : rsp_data = {{(DLEN-32){1'b0}}, irq_pend_r};
-            irq_enable_rd : rsp_data = {{(DLEN-32){1'b0}}, irq_enable_r};
-            default       : rsp_data = {DLEN{1'b0}};
+            pull_up_match    : reg_val = pull_up_r;
+            pull_down_match  : reg_val = pull_down_r;
+            in_value_match   : reg_val = in_value;
+            in_enable_match  : reg_val = in_enable_r;
+            out_value_match  : reg_val = out_value_r;
+            out_enable_match : reg_val = out_enable_r;
+            irq_pend_match   : reg_val = irq_pend_r;
+            irq_enable_match : reg_val = irq_enable_r;
+            out_set_match    : reg_val = out_value_r;
+            out_clr_match    : reg_val = out_value_r;
+            out_tgl_match    : reg_val = out_value_r;
+            oe_set_match     : reg_val = out_enable_r;
+            oe_clr_match     : reg_val = out_enable_r;
+            oe_tgl_match     : reg_val = out_enable_r;
+            irq_en_set_match : reg_val = irq_enable_r;
+            irq_en_clr_match : reg_val = irq_enable_r;
+            irq_en_tgl_match : reg_val = irq_enable_r;
+            default          : reg_val = 32'b0;
         endcase
     end
 
+    // Response buf.
+    always @(*) begin
+        if (gpio_pwrite) begin
+            rsp_data = {DLEN{1'b0}};
+        end
+        else if (bb_match) begin
+            rsp_data = {{(DLEN-1){1'b0}}, reg_val[bb_bit]};
+        end
+        else begin
+            rsp_data = {{(DLEN-32){1'b0}}, reg_val};
+        end
+    end
+
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             rsp_data_r <= {DLEN{1'b0}};
@@ -17,7 +17,7 @@ module uv_i2c
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter TXQ_AW                = 3,
+    parameter TXQ_AW                = 4,
     parameter TXQ_DP                = 2**TXQ_AW,
     parameter RXQ_AW                = 3,
     parameter RXQ_DP                = 2**RXQ_AW
@@ -49,6 +49,7 @@ module uv_i2c
 );
 
     localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
 
     wire                            i2c_psel;
     wire                            i2c_penable;
@@ -66,7 +67,8 @@ module uv_i2c
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .PIPE                       ( BUS_PIPE              )
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
     )
     u_bus_to_apb
     (
@@ -6,8 +6,8 @@
 // Designer: Owen
 //
 // Description:
-//      I2C with APB interface.
-//      FIXME: To be verificated!
+//      I2C with APB interface, where TXQ holds commands of
+//      the sequencer, and RXQ holds bytes read.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -17,7 +17,7 @@ module uv_i2c_apb
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter TXQ_AW                = 3,
+    parameter TXQ_AW                = 4,
     parameter TXQ_DP                = 2**TXQ_AW,
     parameter RXQ_AW                = 3,
     parameter RXQ_DP                = 2**RXQ_AW
@@ -52,25 +52,29 @@ module uv_i2c_apb
 
     wire                            i2c_start;
     wire                            i2c_busy;
+    wire                            i2c_hold;
     wire                            i2c_nack;
     wire                            i2c_nscl;
+    wire                            i2c_done;
+    wire                            i2c_flush;
 
-    wire   [7:0]                    nframes;
+    wire   [15:0]                   scl_lo;
     wire   [15:0]                   sda_dly;
     wire   [15:0]                   clk_div;
 
     wire                            txq_clr;
+    wire                            txq_flush;
     wire                            rxq_clr;
     wire   [TXQ_AW:0]               txq_len;
     wire   [RXQ_AW:0]               rxq_len;
 
     wire                            tx_enq_rdy;
     wire                            tx_enq_vld;
-    wire   [7:0]                    tx_enq_dat;
+    wire   [10:0]                   tx_enq_dat;
 
     wire                            tx_deq_rdy;
     wire                            tx_deq_vld;
-    wire   [7:0]                    tx_deq_dat;
+    wire   [10:0]                   tx_deq_dat;
 
     wire                            rx_enq_rdy;
     wire                            rx_enq_vld;
@@ -80,6 +84,9 @@ module uv_i2c_apb
     wire                            rx_deq_vld;
     wire   [7:0]                    rx_deq_dat;
 
+    // Commands left are dropped when the sequencer aborts.
+    assign txq_flush                = txq_clr | i2c_flush;
+
     uv_i2c_rtx u_i2c_rtx
     (
         .clk                        ( clk               ),
@@ -95,15 +102,18 @@ module uv_i2c_apb
         // Control & status.
         .i2c_start                  ( i2c_start         ),
         .i2c_busy                   ( i2c_busy          ),
+        .i2c_hold                   ( i2c_hold          ),
         .i2c_nack                   ( i2c_nack          ),
         .i2c_nscl                   ( i2c_nscl          ),
+        .i2c_done                   ( i2c_done          ),
+        .i2c_flush                  ( i2c_flush         ),
 
         // Configs.
-        .nframes                    ( nframes           ),
+        .scl_lo                     ( scl_lo            ),
         .sda_dly                    ( sda_dly           ),
         .clk_div                    ( clk_div           ),
 
-        // TX data from TXQ.
+        // Commands from TXQ.
         .tx_rdy                     ( tx_deq_rdy        ),
         .tx_vld                     ( tx_deq_vld        ),
         .tx_dat                     ( tx_deq_dat        ),
@@ -144,11 +154,13 @@ module uv_i2c_apb
         // I2C control & status.
         .i2c_start                  ( i2c_start         ),
         .i2c_busy                   ( i2c_busy          ),
+        .i2c_hold                   ( i2c_hold          ),
         .i2c_nack                   ( i2c_nack          ),
         .i2c_nscl                   ( i2c_nscl          ),
+        .i2c_done                   ( i2c_done          ),
 
         // I2C configs.
-        .nframes                    ( nframes           ),
+        .scl_lo                     ( scl_lo            ),
         .sda_dly                    ( sda_dly           ),
         .clk_div                    ( clk_div           ),
 
@@ -167,7 +179,7 @@ module uv_i2c_apb
 
     uv_queue
     #(
-        .DAT_WIDTH                  ( 8                 ),
+        .DAT_WIDTH                  ( 11                ),
         .PTR_WIDTH                  ( TXQ_AW            ),
         .QUE_DEPTH                  ( TXQ_DP            ),
         .ZERO_RDLY                  ( 1'b1              )
@@ -188,7 +200,7 @@ module uv_i2c_apb
         .rd_dat                     ( tx_deq_dat        ),
 
         // Control & status.
-        .clr                        ( txq_clr           ),
+        .clr                        ( txq_flush         ),
         .len                        ( txq_len           ),
         .full                       (                   ),
         .empty                      (                   )
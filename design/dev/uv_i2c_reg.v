@@ -16,7 +16,7 @@ module uv_i2c_reg
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter TXQ_AW                = 3,
+    parameter TXQ_AW                = 4,
     parameter TXQ_DP                = 2**TXQ_AW,
     parameter RXQ_AW                = 3,
     parameter RXQ_DP                = 2**RXQ_AW
@@ -40,17 +40,19 @@ module uv_i2c_reg
     // I2C control & status.
     output                          i2c_start,
     input                           i2c_busy,
+    input                           i2c_hold,
     input                           i2c_nack,
     input                           i2c_nscl,
+    input                           i2c_done,
 
     // I2C configs.
-    output [7:0]                    nframes,
+    output [15:0]                   scl_lo,
     output [15:0]                   sda_dly,
     output [15:0]                   clk_div,
 
     // Queue operations.
     output                          tx_enq_vld,
-    output [7:0]                    tx_enq_dat,
+    output [10:0]                   tx_enq_dat,
     output                          rx_deq_vld,
     input  [7:0]                    rx_deq_dat,
 
@@ -65,7 +67,7 @@ module uv_i2c_reg
     localparam ADDR_DEC_WIDTH       = ALEN - 2;
 
     localparam REG_I2C_GLB_CFG      = 0;
-    localparam REG_I2C_NFRAMES      = 1;
+    localparam REG_I2C_SCL_LO       = 1;
     localparam REG_I2C_START        = 2;
     localparam REG_I2C_BUSY         = 3;
     localparam REG_I2C_TXQ_CAP      = 4;
@@ -85,20 +87,22 @@ module uv_i2c_reg
     wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
 
     reg  [31:0]                     i2c_glb_cfg_r;
-    reg  [7:0]                      i2c_nframes_r;
+    reg  [15:0]                     i2c_scl_lo_r;
     reg                             i2c_tx_ie_r;
     reg                             i2c_rx_ie_r;
     reg                             i2c_nack_ie_r;
     reg                             i2c_nscl_ie_r;
+    reg                             i2c_done_ie_r;
     wire                            i2c_tx_ip;
     wire                            i2c_rx_ip;
     reg                             i2c_nack_ip_r;
     reg                             i2c_nscl_ip_r;
+    reg                             i2c_done_ip_r;
     reg  [TXQ_AW:0]                 i2c_tx_irq_th_r;
     reg  [RXQ_AW:0]                 i2c_rx_irq_th_r;
 
     wire                            i2c_glb_cfg_match;
-    wire                            i2c_nframes_match;
+    wire                            i2c_scl_lo_match;
     wire                            i2c_start_match;
     wire                            i2c_busy_match;
     wire                            i2c_txq_cap_match;
@@ -116,17 +120,18 @@ module uv_i2c_reg
     wire                            addr_mismatch;
 
     wire                            i2c_glb_cfg_wr;
-    wire                            i2c_nframes_wr;
+    wire                            i2c_scl_lo_wr;
     wire                            i2c_start_wr;
     wire                            i2c_txq_clr_wr;
     wire                            i2c_txq_dat_wr;
     wire                            i2c_rxq_clr_wr;
     wire                            i2c_ie_wr;
+    wire                            i2c_ip_wr;
     wire                            i2c_tx_irq_th_wr;
     wire                            i2c_rx_irq_th_wr;
 
     wire                            i2c_glb_cfg_rd;
-    wire                            i2c_nframes_rd;
+    wire                            i2c_scl_lo_rd;
     wire                            i2c_busy_rd;
     wire                            i2c_txq_cap_rd;
     wire                            i2c_txq_len_rd;
@@ -146,7 +151,7 @@ module uv_i2c_reg
     // Address decoding.
     assign dec_addr                 = i2c_paddr[ALEN-1:2];
     assign i2c_glb_cfg_match        = dec_addr == REG_I2C_GLB_CFG[ADDR_DEC_WIDTH-1:0];
-    assign i2c_nframes_match        = dec_addr == REG_I2C_NFRAMES[ADDR_DEC_WIDTH-1:0];
+    assign i2c_scl_lo_match         = dec_addr == REG_I2C_SCL_LO [ADDR_DEC_WIDTH-1:0];
     assign i2c_start_match          = dec_addr == REG_I2C_START  [ADDR_DEC_WIDTH-1:0];
     assign i2c_busy_match           = dec_addr == REG_I2C_BUSY   [ADDR_DEC_WIDTH-1:0];
     assign i2c_txq_cap_match        = dec_addr == REG_I2C_TXQ_CAP[ADDR_DEC_WIDTH-1:0];
@@ -164,18 +169,18 @@ module uv_i2c_reg
     assign addr_mismatch            = dec_addr >  REG_ADDR_MAX[ADDR_DEC_WIDTH-1:0];
 
     assign i2c_glb_cfg_wr           = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_glb_cfg_match;
-    assign i2c_nframes_wr           = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_nframes_match;
+    assign i2c_scl_lo_wr            = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_scl_lo_match;
     assign i2c_start_wr             = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_start_match;
     assign i2c_txq_clr_wr           = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_txq_clr_match;
     assign i2c_txq_dat_wr           = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_txq_dat_match;
-    assign i2c_rxq_clr_wr           = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_txq_clr_match;
+    assign i2c_rxq_clr_wr           = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_rxq_clr_match;
     assign i2c_ie_wr                = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_ie_match;
     assign i2c_ip_wr                = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_ip_match;
     assign i2c_tx_irq_th_wr         = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_tx_irq_th_match;
     assign i2c_rx_irq_th_wr         = i2c_psel & (~i2c_penable) & i2c_pwrite & i2c_rx_irq_th_match;
 
     assign i2c_glb_cfg_rd           = i2c_psel & (~i2c_penable) & (~i2c_pwrite) & i2c_glb_cfg_match;
-    assign i2c_nframes_rd           = i2c_psel & (~i2c_penable) & (~i2c_pwrite) & i2c_nframes_match;
+    assign i2c_scl_lo_rd            = i2c_psel & (~i2c_penable) & (~i2c_pwrite) & i2c_scl_lo_match;
     assign i2c_busy_rd              = i2c_psel & (~i2c_penable) & (~i2c_pwrite) & i2c_busy_match;
     assign i2c_txq_cap_rd           = i2c_psel & (~i2c_penable) & (~i2c_pwrite) & i2c_txq_cap_match;
     assign i2c_txq_len_rd           = i2c_psel & (~i2c_penable) & (~i2c_pwrite) & i2c_txq_len_match;
@@ -195,7 +200,7 @@ module uv_i2c_reg
     // Output configs.
     assign sda_dly                  = i2c_glb_cfg_r[15:0];
     assign clk_div                  = i2c_glb_cfg_r[31:16];
-    assign nframes                  = i2c_nframes_r;
+    assign scl_lo                   = i2c_scl_lo_r;
 
     assign i2c_start                = i2c_start_wr;
 
@@ -204,7 +209,7 @@ module uv_i2c_reg
 
     // Output data.
     assign tx_enq_vld               = i2c_txq_dat_wr;
-    assign tx_enq_dat               = i2c_pwdata[7:0];
+    assign tx_enq_dat               = i2c_pwdata[10:0];
     assign rx_deq_vld               = i2c_rxq_dat_rd;
 
     // Interrupt.
@@ -213,7 +218,8 @@ module uv_i2c_reg
     assign i2c_irq                  = (i2c_rx_ip & i2c_rx_ie_r)
                                     | (i2c_tx_ip & i2c_tx_ie_r)
                                     | (i2c_nack_ip_r & i2c_nack_ie_r)
-                                    | (i2c_nscl_ip_r & i2c_nscl_ie_r);
+                                    | (i2c_nscl_ip_r & i2c_nscl_ie_r)
+                                    | (i2c_done_ip_r & i2c_done_ie_r);
 
     // Write registers from bus.
     always @(posedge clk or negedge rst_n) begin
@@ -232,11 +238,12 @@ module uv_i2c_reg
 
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            i2c_nframes_r <= 8'b0;
+            i2c_scl_lo_r <= 16'b0;
         end
         else begin
-            if (i2c_nframes_wr) begin
-                i2c_nframes_r[7:0]  <= #UDLY i2c_pstrb[0] ? i2c_pwdata[7:0] : i2c_nframes_r[7:0];
+            if (i2c_scl_lo_wr) begin
+                i2c_scl_lo_r[7:0]  <= #UDLY i2c_pstrb[0] ? i2c_pwdata[7:0]  : i2c_scl_lo_r[7:0];
+                i2c_scl_lo_r[15:8] <= #UDLY i2c_pstrb[1] ? i2c_pwdata[15:8] : i2c_scl_lo_r[15:8];
             end
         end
     end
@@ -247,6 +254,7 @@ module uv_i2c_reg
             i2c_rx_ie_r   <= 1'b0;
             i2c_nack_ie_r <= 1'b0;
             i2c_nscl_ie_r <= 1'b0;
+            i2c_done_ie_r <= 1'b0;
         end
         else begin
             if (i2c_ie_wr) begin
@@ -254,6 +262,7 @@ module uv_i2c_reg
                 i2c_rx_ie_r   <= #UDLY i2c_pstrb[0] ? i2c_pwdata[1] : i2c_rx_ie_r;
                 i2c_nack_ie_r <= #UDLY i2c_pstrb[0] ? i2c_pwdata[2] : i2c_nack_ie_r;
                 i2c_nscl_ie_r <= #UDLY i2c_pstrb[0] ? i2c_pwdata[3] : i2c_nscl_ie_r;
+                i2c_done_ie_r <= #UDLY i2c_pstrb[0] ? i2c_pwdata[4] : i2c_done_ie_r;
             end
         end
     end
@@ -286,6 +295,20 @@ module uv_i2c_reg
         end
     end
 
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            i2c_done_ip_r <= 1'b0;
+        end
+        else begin
+            if (i2c_done) begin
+                i2c_done_ip_r <= #UDLY 1'b1;
+            end
+            else if (i2c_ip_wr) begin
+                i2c_done_ip_r <= #UDLY i2c_pstrb[0] ? i2c_pwdata[4] : i2c_done_ip_r;
+            end
+        end
+    end
+
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             i2c_tx_irq_th_r <= {(TXQ_AW+1){1'b0}};
@@ -312,17 +335,17 @@ module uv_i2c_reg
     always @(*) begin
         case (1'b1)
             i2c_glb_cfg_rd   : rsp_data = {{(DLEN-32){1'b0}}, i2c_glb_cfg_r};
-            i2c_nframes_rd   : rsp_data = {{(DLEN-8){1'b0}}, i2c_nframes_r};
-            i2c_busy_rd      : rsp_data = {{(DLEN-1){1'b0}}, i2c_busy};
+            i2c_scl_lo_rd    : rsp_data = {{(DLEN-16){1'b0}}, i2c_scl_lo_r};
+            i2c_busy_rd      : rsp_data = {{(DLEN-2){1'b0}}, i2c_hold, i2c_busy};
             i2c_txq_cap_rd   : rsp_data = TXQ_DP[DLEN-1:0];
             i2c_txq_len_rd   : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, txq_len};
             i2c_rxq_cap_rd   : rsp_data = RXQ_DP[DLEN-1:0];
             i2c_rxq_len_rd   : rsp_data = {{(DLEN-RXQ_AW-1){1'b0}}, rxq_len};
-            i2c_rxq_dat_rd   : rsp_data = {{(DLEN-32){1'b0}}, rx_deq_dat};
-            i2c_ie_rd        : rsp_data = {{(DLEN-4){1'b0}}, i2c_nscl_ie_r, i2c_nack_ie_r, i2c_rx_ie_r, i2c_tx_ie_r};
-            i2c_ip_rd        : rsp_data = {{(DLEN-4){1'b0}}, i2c_nscl_ip_r, i2c_nack_ip_r, i2c_rx_ip, i2c_tx_ip};
+            i2c_rxq_dat_rd   : rsp_data = {{(DLEN-8){1'b0}}, rx_deq_dat};
+            i2c_ie_rd        : rsp_data = {{(DLEN-5){1'b0}}, i2c_done_ie_r, i2c_nscl_ie_r, i2c_nack_ie_r, i2c_rx_ie_r, i2c_tx_ie_r};
+            i2c_ip_rd        : rsp_data = {{(DLEN-5){1'b0}}, i2c_done_ip_r, i2c_nscl_ip_r, i2c_nack_ip_r, i2c_rx_ip, i2c_tx_ip};
             i2c_tx_irq_th_rd : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, i2c_tx_irq_th_r};
-            i2c_rx_irq_th_rd : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, i2c_rx_irq_th_r};
+            i2c_rx_irq_th_rd : rsp_data = {{(DLEN-RXQ_AW-1){1'b0}}, i2c_rx_irq_th_r};
             default          : rsp_data = {DLEN{1'b0}};
         endcase
     end
@@ -6,7 +6,23 @@
 // Designer: Owen
 //
 // Description:
-//      I2C transmitter & receiver.
+//      I2C master sequencer. Commands from TXQ are run once
+//      started, till TXQ is empty with the bus released, and
+//      other commands than START are dropped on a free bus:
+//        START: (repeated) START & the address byte in CMD_DAT.
+//        WRITE: the byte in CMD_DAT.
+//        READ : CMD_DAT + 1 bytes to RXQ, with NACK at last.
+//        STOP : STOP & the bus free time.
+//      HOLD tells SCL is held for commands in a transfer.
+//      SCL is low for SCL_LO cycles (half of CLK_DIV if 0) &
+//      high for the rest of CLK_DIV from when it is seen high,
+//      so a slave can stretch the clock. SCL is held low when
+//      TXQ or RXQ stalls in a transfer. A NACK to the address
+//      or written bytes flushes TXQ & ends with STOP, and SCL
+//      held low by slave for 2^20 cycles flushes TXQ & gives
+//      up the bus, where commands pushed later wait for the
+//      next start. Lines are open-drain, with SDA changed at
+//      SDA_DLY cycles after SCL falls.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -26,18 +42,21 @@ module uv_i2c_rtx
     // Control & status.
     input                           i2c_start,
     output                          i2c_busy,
+    output                          i2c_hold,
     output                          i2c_nack,
     output                          i2c_nscl,
+    output                          i2c_done,
+    output                          i2c_flush,
 
     // Configs.
-    input  [7:0]                    nframes,
+    input  [15:0]                   scl_lo,
     input  [15:0]                   sda_dly,
     input  [15:0]                   clk_div,
 
-    // TX data from TXQ.
+    // Commands from TXQ.
     input                           tx_rdy,
     output                          tx_vld,
-    input  [7:0]                    tx_dat,
+    input  [10:0]                   tx_dat,
 
     // RX data to RXQ.
     input                           rx_rdy,
@@ -47,83 +66,128 @@ module uv_i2c_rtx
 
     localparam UDLY = 1;
     localparam FSM_I2C_IDLE         = 3'h0;
-    localparam FSM_I2C_SIZE         = 3'h1;
-    localparam FSM_I2C_START        = 3'h2;
-    localparam FSM_I2C_ADDR         = 3'h3;
-    localparam FSM_I2C_WRITE        = 3'h4;
-    localparam FSM_I2C_READ         = 3'h5;
-    localparam FSM_I2C_ACK          = 3'h6;
-    localparam FSM_I2C_STOP         = 3'h7;
+    localparam FSM_I2C_NEXT         = 3'h1;
+    localparam FSM_I2C_LOW          = 3'h2;
+    localparam FSM_I2C_RISE         = 3'h3;
+    localparam FSM_I2C_HIGH         = 3'h4;
+    localparam FSM_I2C_PUSH         = 3'h5;
+    localparam FSM_I2C_FREE         = 3'h6;
+
+    localparam CMD_START            = 3'h0;
+    localparam CMD_WRITE            = 3'h1;
+    localparam CMD_READ             = 3'h2;
+    localparam CMD_STOP             = 3'h3;
+
+    localparam NSCL_MAX             = 20'hfffff;
 
     reg    [2:0]                    cur_state;
     reg    [2:0]                    nxt_state;
 
-    reg                             i2c_scl_out_r;
-    reg                             i2c_sda_out_r;
-    reg                             i2c_sda_oen_r;
-
-    reg                             i2c_read_r;
-    reg    [6:0]                    i2c_addr_r;
-    reg    [7:0]                    i2c_size_r;
-    reg    [7:0]                    i2c_data_r;
-    reg                             i2c_ack_r;
+    reg    [1:0]                    scl_sync_r;
+    reg    [1:0]                    sda_sync_r;
+    reg                             scl_out_r;
+    reg                             sda_out_r;
 
-    reg                             i2c_nack_r;
-    reg                             i2c_nscl_r;
+    reg                             run_r;
+    reg    [2:0]                    cmd_r;
+    reg                             cond_r;
+    reg    [3:0]                    bit_cnt_r;
+    reg    [8:0]                    tx_sft_r;
+    reg    [8:0]                    rx_sft_r;
+    reg    [7:0]                    rd_left_r;
+    reg                             abort_r;
+    reg    [16:0]                   clk_cnt_r;
+    reg    [19:0]                   nscl_cnt_r;
 
     reg                             tx_vld_r;
     reg                             rx_vld_r;
     reg    [7:0]                    rx_dat_r;
-
-    reg    [15:0]                   clk_cnt_r;
-    reg    [3:0]                    bit_cnt_r;
-    reg    [7:0]                    byte_cnt_r;
-    reg    [7:0]                    frame_cnt_r;
-    reg    [7:0]                    frame_num_r;
-
-    wire   [15:0]                   clk_cnt_add;
-    wire                            clk_cnt_end;
-    wire                            clk_cnt_half;
-    wire                            clk_cnt_quar;
-    wire                            clk_cnt_2dly;
-    wire                            sda_data_pre;
-    wire                            sda_data_pst;
-
-    wire   [3:0]                    bit_cnt_add;
-    wire                            bit_cnt_end;
-
-    wire   [3:0]                    byte_cnt_add;
-    wire                            byte_cnt_end;
-
-    wire   [3:0]                    frame_cnt_add;
-    wire                            frame_cnt_end;
-
-    assign clk_cnt_add              = clk_cnt_r + 1'b1;
-    assign clk_cnt_end              = clk_cnt_add == clk_div;
-    assign clk_cnt_half             = clk_cnt_add == {1'b0, clk_div[15:1]};
-    assign clk_cnt_quar             = clk_cnt_add == {2'b0, clk_div[15:2]};
-    assign clk_cnt_2dly             = clk_cnt_r + sda_dly;
-    assign sda_data_pre             = clk_cnt_2dly == clk_div;
-    assign sda_data_pst             = clk_cnt_add == sda_dly;
-
-    assign bit_cnt_add              = bit_cnt_r + 1'b1;
-    assign bit_cnt_end              = bit_cnt_add == 4'd8;
-
-    assign byte_cnt_add             = byte_cnt_r + 1'b1;
-    assign byte_cnt_end             = byte_cnt_add == i2c_size_r;
-
-    assign frame_cnt_add            = frame_cnt_r + 1'b1;
-    assign frame_cnt_end            = frame_cnt_add == frame_num_r;
-
-    // Set IO signals.
-    assign i2c_scl_oen              = 1'b0;  // Always as master.
-    assign i2c_scl_out              = i2c_scl_out_r;
-    assign i2c_sda_oen              = i2c_sda_oen_r;
-    assign i2c_sda_out              = i2c_sda_out_r;
-
-    assign i2c_busy                 = (cur_state == FSM_I2C_IDLE) && (~tx_vld_r);
-    assign i2c_nack                 = 1'b0;
-    assign i2c_nscl                 = 1'b0;
+    reg                             nack_r;
+    reg                             nscl_r;
+    reg                             done_r;
+
+    wire                            scl_line;
+    wire                            sda_line;
+    wire   [15:0]                   lo_cyc;
+    wire   [15:0]                   hi_cyc;
+    wire   [15:0]                   dly_cyc;
+    wire   [16:0]                   high_end;
+
+    wire                            run_end;
+    wire                            cmd_take;
+    wire   [2:0]                    cmd_op;
+    wire   [7:0]                    cmd_dat;
+    wire                            cmd_start;
+    wire                            cmd_read;
+    wire                            cmd_stop;
+
+    wire                            low_sda;
+    wire                            low_end;
+    wire                            high_smp;
+    wire                            high_sda;
+    wire                            high_last;
+    wire                            byte_end;
+    wire                            byte_nack;
+    wire                            nscl_end;
+
+    // Bus timing.
+    assign scl_line                 = scl_sync_r[1];
+    assign sda_line                 = sda_sync_r[1];
+    assign lo_cyc                   = (|scl_lo) ? scl_lo : {1'b0, clk_div[15:1]};
+    assign hi_cyc                   = clk_div - lo_cyc;
+    assign dly_cyc                  = sda_dly < lo_cyc ? sda_dly : 16'd0;
+
+    // START & STOP take 2 high phases, with SDA changed between.
+    assign high_end                 = cond_r ? {hi_cyc, 1'b0} - 1'b1 : {1'b0, hi_cyc} - 1'b1;
+
+    assign low_sda                  = (cur_state == FSM_I2C_LOW) & (clk_cnt_r == {1'b0, dly_cyc});
+    assign low_end                  = (cur_state == FSM_I2C_LOW) & (clk_cnt_r == {1'b0, lo_cyc} - 1'b1);
+    assign high_smp                 = (cur_state == FSM_I2C_HIGH) & (~cond_r) & (clk_cnt_r == {2'b0, hi_cyc[15:1]});
+    assign high_sda                 = (cur_state == FSM_I2C_HIGH) & cond_r & (clk_cnt_r == {1'b0, hi_cyc});
+    assign high_last                = (cur_state == FSM_I2C_HIGH) & (clk_cnt_r == high_end);
+    assign nscl_end                 = (cur_state == FSM_I2C_RISE) & (nscl_cnt_r == NSCL_MAX);
+
+    assign byte_end                 = high_last & (~cond_r) & (bit_cnt_r == 4'd0);
+    assign byte_nack                = (cmd_r != CMD_READ) & rx_sft_r[0];
+
+    // Commands.
+    assign run_end                  = (cur_state == FSM_I2C_IDLE) & (((~tx_rdy) & (~tx_vld_r)) | abort_r);
+    assign cmd_take                 = run_r & (~abort_r) & tx_rdy & (~tx_vld_r)
+                                    & ((cur_state == FSM_I2C_IDLE) | (cur_state == FSM_I2C_NEXT));
+    assign cmd_op                   = tx_dat[10:8];
+    assign cmd_dat                  = tx_dat[7:0];
+    assign cmd_start                = cmd_op == CMD_START;
+    assign cmd_read                 = cmd_op == CMD_READ;
+    assign cmd_stop                 = cmd_op == CMD_STOP;
+
+    // Open-drain outputs.
+    assign i2c_scl_out              = 1'b0;
+    assign i2c_scl_oen              = scl_out_r;
+    assign i2c_sda_out              = 1'b0;
+    assign i2c_sda_oen              = sda_out_r;
+
+    assign i2c_busy                 = run_r | (cur_state != FSM_I2C_IDLE);
+    assign i2c_hold                 = (cur_state == FSM_I2C_NEXT) & (~tx_rdy) & (~tx_vld_r);
+    assign i2c_nack                 = nack_r;
+    assign i2c_nscl                 = nscl_r;
+    assign i2c_done                 = done_r;
+    assign i2c_flush                = (byte_end & byte_nack) | nscl_end;
+
+    assign tx_vld                   = tx_vld_r;
+    assign rx_vld                   = rx_vld_r;
+    assign rx_dat                   = rx_dat_r;
+
+    // Synchronize bus lines, which are idle high.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            scl_sync_r <= 2'b11;
+            sda_sync_r <= 2'b11;
+        end
+        else begin
+            scl_sync_r <= #UDLY {scl_sync_r[0], i2c_scl_in};
+            sda_sync_r <= #UDLY {sda_sync_r[0], i2c_sda_in};
+        end
+    end
 
     // FSM.
     always @(posedge clk or negedge rst_n) begin
@@ -138,73 +202,77 @@ module uv_i2c_rtx
     always @(*) begin
         case (cur_state)
             FSM_I2C_IDLE: begin
-                if (tx_vld_r) begin
-                    nxt_state = FSM_I2C_SIZE;
+                // Only START is taken on a free bus.
+                if (cmd_take & cmd_start) begin
+                    nxt_state = FSM_I2C_HIGH;
                 end
                 else begin
                     nxt_state = FSM_I2C_IDLE;
                 end
             end
-            FSM_I2C_SIZE: begin
-                nxt_state = FSM_I2C_START;
-            end
-            FSM_I2C_START: begin
-                if (clk_cnt_end) begin
-                    nxt_state = FSM_I2C_ADDR;
+            FSM_I2C_NEXT: begin
+                if (cmd_take) begin
+                    nxt_state = FSM_I2C_LOW;
                 end
                 else begin
-                    nxt_state = FSM_I2C_START;
+                    nxt_state = FSM_I2C_NEXT;
                 end
             end
-            FSM_I2C_ADDR: begin
-                if (bit_cnt_end & clk_cnt_end) begin
-                    nxt_state = FSM_I2C_ACK;
+            FSM_I2C_LOW: begin
+                if (low_end) begin
+                    nxt_state = FSM_I2C_RISE;
                 end
                 else begin
-                    nxt_state = FSM_I2C_ADDR;
+                    nxt_state = FSM_I2C_LOW;
                 end
             end
-            FSM_I2C_WRITE: begin
-                if (bit_cnt_end & clk_cnt_end) begin
-                    nxt_state = FSM_I2C_ACK;
-                end
-                else begin
-                    nxt_state = FSM_I2C_WRITE;
+            FSM_I2C_RISE: begin
+                if (nscl_end) begin
+                    nxt_state = FSM_I2C_IDLE;
                 end
-            end
-            FSM_I2C_READ: begin
-                if (bit_cnt_end & clk_cnt_end) begin
-                    nxt_state = FSM_I2C_ACK;
+                else if (scl_line) begin
+                    nxt_state = FSM_I2C_HIGH;
                 end
                 else begin
-                    nxt_state = FSM_I2C_READ;
+                    nxt_state = FSM_I2C_RISE;
                 end
             end
-            FSM_I2C_ACK: begin
-                if (clk_cnt_end) begin
-                    if (i2c_ack_r) begin
-                        nxt_state = FSM_I2C_STOP;
+            FSM_I2C_HIGH: begin
+                if (high_last) begin
+                    if (cond_r) begin
+                        nxt_state = cmd_r == CMD_STOP ? FSM_I2C_FREE : FSM_I2C_LOW;
                     end
-                    else if (i2c_size_r == 8'd0) begin
-                        nxt_state = FSM_I2C_IDLE;
+                    else if (bit_cnt_r != 4'd0) begin
+                        nxt_state = FSM_I2C_LOW;
                     end
-                    else if (byte_cnt_end) begin
-                        nxt_state = frame_cnt_end ? FSM_I2C_STOP : FSM_I2C_IDLE;
+                    else if (byte_nack) begin
+                        nxt_state = FSM_I2C_LOW;
+                    end
+                    else if (cmd_r == CMD_READ) begin
+                        nxt_state = FSM_I2C_PUSH;
                     end
                     else begin
-                        nxt_state = i2c_read_r ? FSM_I2C_READ : FSM_I2C_WRITE;
+                        nxt_state = FSM_I2C_NEXT;
                     end
                 end
                 else begin
-                    nxt_state = FSM_I2C_ACK;
+                    nxt_state = FSM_I2C_HIGH;
+                end
+            end
+            FSM_I2C_PUSH: begin
+                if (rx_rdy) begin
+                    nxt_state = (|rd_left_r) ? FSM_I2C_LOW : FSM_I2C_NEXT;
+                end
+                else begin
+                    nxt_state = FSM_I2C_PUSH;
                 end
             end
-            FSM_I2C_STOP: begin
-                if (clk_cnt_end) begin
+            FSM_I2C_FREE: begin
+                if (clk_cnt_r == {1'b0, lo_cyc}) begin
                     nxt_state = FSM_I2C_IDLE;
                 end
                 else begin
-                    nxt_state = FSM_I2C_STOP;
+                    nxt_state = FSM_I2C_FREE;
                 end
             end
             default: begin
@@ -213,217 +281,122 @@ module uv_i2c_rtx
         endcase
     end
 
-    // Update clock counter.
+    // Run from START till all commands are done, or aborted.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            clk_cnt_r <= 16'd0;
+            run_r <= 1'b0;
         end
         else begin
-            if (cur_state == FSM_I2C_SIZE) begin
-                clk_cnt_r <= #UDLY 16'd0;
+            if (i2c_start) begin
+                run_r <= #UDLY 1'b1;
             end
-            else if (cur_state != FSM_I2C_IDLE) begin
-                if (clk_cnt_end) begin
-                    clk_cnt_r <= #UDLY 16'd0;
-                end
-                else begin
-                    clk_cnt_r <= #UDLY clk_cnt_add;
-                end
+            else if (run_end) begin
+                run_r <= #UDLY 1'b0;
             end
         end
     end
 
-    // Update bit counter.
+    // Commands pushed after abort wait for the next START.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            bit_cnt_r <= 4'd0;
+            abort_r <= 1'b0;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_START: begin
-                    if (clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY 4'd0;
-                    end
-                end
-                FSM_I2C_ADDR: begin
-                    if (bit_cnt_end & clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY 4'd0;
-                    end
-                    else if (clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY bit_cnt_add;
-                    end
-                end
-                FSM_I2C_WRITE: begin
-                    if (bit_cnt_end & clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY 4'd0;
-                    end
-                    else if (clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY bit_cnt_add;
-                    end
-                end
-                FSM_I2C_READ: begin
-                    if (bit_cnt_end & clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY 4'd0;
-                    end
-                    else if (clk_cnt_end) begin
-                        bit_cnt_r <= #UDLY bit_cnt_add;
-                    end
-                end
-            endcase
+            if (i2c_start) begin
+                abort_r <= #UDLY 1'b0;
+            end
+            else if (i2c_flush) begin
+                abort_r <= #UDLY 1'b1;
+            end
         end
     end
 
-    // Update byte counter.
+    // Phase counter.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            byte_cnt_r <= 8'd0;
+            clk_cnt_r <= 17'd0;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_START: begin
-                    if (clk_cnt_end) begin
-                        byte_cnt_r <= #UDLY 8'd0;
-                    end
-                end
-                FSM_I2C_ACK: begin
-                    if (byte_cnt_end & clk_cnt_end) begin
-                        byte_cnt_r <= #UDLY 8'd0;
-                    end
-                    else if (clk_cnt_end) begin
-                        byte_cnt_r <= #UDLY byte_cnt_add;
-                    end
-                end
-            endcase
+            if (cur_state != nxt_state) begin
+                clk_cnt_r <= #UDLY 17'd0;
+            end
+            else if ((cur_state == FSM_I2C_LOW) | (cur_state == FSM_I2C_HIGH) | (cur_state == FSM_I2C_FREE)) begin
+                clk_cnt_r <= #UDLY clk_cnt_r + 1'b1;
+            end
         end
     end
 
-    // Update frame counter.
+    // Count cycles of SCL stretched by slave.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            frame_cnt_r <= 8'd0;
-            frame_num_r <= 8'd0;
+            nscl_cnt_r <= 20'd0;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_IDLE: begin
-                    if (i2c_start) begin
-                        frame_num_r <= #UDLY nframes;
-                    end
-                end
-                FSM_I2C_ACK: begin
-                    if (frame_cnt_end & byte_cnt_end & clk_cnt_end) begin
-                        frame_cnt_r <= #UDLY 8'd0;
-                    end
-                    else if (byte_cnt_end & clk_cnt_end) begin
-                        frame_cnt_r <= #UDLY frame_cnt_add;
-                    end
-                end
-            endcase
+            if (cur_state != FSM_I2C_RISE) begin
+                nscl_cnt_r <= #UDLY 20'd0;
+            end
+            else begin
+                nscl_cnt_r <= #UDLY nscl_cnt_r + 1'b1;
+            end
         end
     end
 
-    // Update controls.
+    // Take commands.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            i2c_read_r <= 1'b0;
-            i2c_addr_r <= 7'h0;
-            i2c_size_r <= 8'd0;
-            i2c_data_r <= 8'h0;
-            i2c_ack_r  <= 1'b0;
+            tx_vld_r <= 1'b0;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_IDLE: begin
-                    if (tx_vld_r) begin
-                        i2c_read_r <= #UDLY tx_dat[0];
-                        i2c_addr_r <= #UDLY tx_dat[7:1];
-                    end
-                end
-                FSM_I2C_SIZE: begin
-                    i2c_size_r <= #UDLY tx_dat;
-                    i2c_data_r <= #UDLY {i2c_addr_r, i2c_read_r};
-                end
-                FSM_I2C_START: begin
-                    if (sda_data_pre) begin
-                        i2c_data_r <= #UDLY {i2c_data_r[6:0], 1'b0};
-                    end
-                end
-                FSM_I2C_ADDR: begin
-                    if ((~bit_cnt_end) & sda_data_pre) begin
-                        i2c_data_r <= #UDLY {i2c_data_r[6:0], 1'b0};
-                    end
-                    else if (bit_cnt_end & sda_data_pre) begin
-                        if (i2c_read_r) begin
-                            i2c_data_r <= #UDLY 8'h0;
-                        end
-                        else if (i2c_size_r > 8'd0) begin
-                            i2c_data_r <= #UDLY tx_dat;
-                        end
-                    end
-                end
-                FSM_I2C_WRITE: begin
-                    if ((~bit_cnt_end) & sda_data_pre) begin
-                        i2c_data_r <= #UDLY {i2c_data_r[6:0], 1'b0};
-                    end
-                    else if (bit_cnt_end & sda_data_pre & (~byte_cnt_end)) begin
-                        i2c_data_r <= #UDLY tx_dat;
-                    end
-                end
-                FSM_I2C_READ: begin
-                    if (sda_data_pst) begin
-                        i2c_data_r <= #UDLY {i2c_data_r[6:0], 1'b0};
-                    end
-                    else if (bit_cnt_end & sda_data_pre) begin
-                        i2c_data_r <= #UDLY 8'h0;
-                    end
-                end
-                FSM_I2C_ACK: begin
-                    if (sda_data_pst) begin
-                        i2c_ack_r  <= #UDLY i2c_sda_in;
-                    end
-                    else if (sda_data_pre & (~i2c_ack_r) & (|i2c_size_r)) begin
-                        i2c_data_r <= #UDLY {i2c_data_r[6:0], 1'b0};
-                    end
-                end
-            endcase
+            tx_vld_r <= #UDLY cmd_take;
         end
     end
 
-    // Read from TX queue.
+    // Slot of the current command: a START/STOP condition, or bit 8~0 of a byte.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            tx_vld_r <= 1'b0;
+            cmd_r     <= CMD_STOP;
+            cond_r    <= 1'b0;
+            bit_cnt_r <= 4'd0;
+            tx_sft_r  <= 9'h1ff;
+            rd_left_r <= 8'd0;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_IDLE: begin
-                    if (i2c_start) begin
-                        tx_vld_r <= #UDLY 1'b1;
-                    end
-                end
-                FSM_I2C_SIZE: begin
-                    tx_vld_r <= #UDLY 1'b0;
-                end
-                FSM_I2C_ADDR: begin
-                    if (bit_cnt_end & sda_data_pre & (~i2c_read_r)) begin
-                        tx_vld_r <= #UDLY 1'b1;
-                    end
-                    else begin
-                        tx_vld_r <= #UDLY 1'b0;
-                    end
-                end
-                FSM_I2C_WRITE: begin
-                    if (bit_cnt_end & sda_data_pre) begin
-                        tx_vld_r <= #UDLY 1'b1;
-                    end
-                    else begin
-                        tx_vld_r <= #UDLY 1'b0;
-                    end
-                end
-                default: begin
-                    tx_vld_r <= #UDLY 1'b0;
-                end
-            endcase
+            if (cmd_take) begin
+                cmd_r     <= #UDLY cmd_op;
+                cond_r    <= #UDLY cmd_start | cmd_stop;
+                bit_cnt_r <= #UDLY 4'd8;
+                tx_sft_r  <= #UDLY cmd_read ? {8'hff, cmd_dat == 8'd0} : {cmd_dat, 1'b1};
+                rd_left_r <= #UDLY cmd_dat;
+            end
+            else if (high_last & cond_r) begin
+                cond_r    <= #UDLY 1'b0;
+            end
+            else if (byte_end & byte_nack) begin
+                // Give up the rest with STOP.
+                cmd_r     <= #UDLY CMD_STOP;
+                cond_r    <= #UDLY 1'b1;
+            end
+            else if (high_last & (bit_cnt_r != 4'd0)) begin
+                bit_cnt_r <= #UDLY bit_cnt_r - 1'b1;
+                tx_sft_r  <= #UDLY {tx_sft_r[7:0], 1'b1};
+            end
+            else if ((cur_state == FSM_I2C_PUSH) & rx_rdy & (|rd_left_r)) begin
+                bit_cnt_r <= #UDLY 4'd8;
+                tx_sft_r  <= #UDLY {8'hff, rd_left_r == 8'd1};
+                rd_left_r <= #UDLY rd_left_r - 1'b1;
+            end
+        end
+    end
+
+    // Sample SDA in the middle of SCL high.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rx_sft_r <= 9'h0;
+        end
+        else begin
+            if (high_smp) begin
+                rx_sft_r <= #UDLY {rx_sft_r[7:0], sda_line};
+            end
         end
     end
 
@@ -434,106 +407,63 @@ module uv_i2c_rtx
             rx_dat_r <= 8'h0;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_READ: begin
-                    if (clk_cnt_half) begin
-                        rx_vld_r <= #UDLY 1'b1;
-                        rx_dat_r <= #UDLY i2c_data_r;
-                    end
-                    else begin
-                        rx_vld_r <= #UDLY 1'b0;
-                    end
-                end
-                default: begin
-                    rx_vld_r <= #UDLY 1'b0;
-                end
-            endcase
+            if ((cur_state == FSM_I2C_PUSH) & rx_rdy) begin
+                rx_vld_r <= #UDLY 1'b1;
+                rx_dat_r <= #UDLY rx_sft_r[8:1];
+            end
+            else begin
+                rx_vld_r <= #UDLY 1'b0;
+            end
         end
     end
 
-    // Control I2C clock.
+    // Control I2C clock, released in idle.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            i2c_scl_out_r <= 1'b1;
+            scl_out_r <= 1'b1;
         end
         else begin
-            if (cur_state == FSM_I2C_IDLE) begin
-                i2c_scl_out_r <= #UDLY 1'b1;
+            if (nscl_end) begin
+                scl_out_r <= #UDLY 1'b1;
             end
-            else begin
-                if (clk_cnt_half) begin
-                    i2c_scl_out_r <= #UDLY 1'b0;
-                end
-                else if (clk_cnt_end) begin
-                    i2c_scl_out_r <= #UDLY 1'b1;
-                end
+            else if (high_last) begin
+                scl_out_r <= #UDLY (cond_r & (cmd_r == CMD_STOP));
+            end
+            else if (low_end) begin
+                scl_out_r <= #UDLY 1'b1;
             end
         end
     end
 
-    // Control I2C data.
+    // Control I2C data: release for START, low for STOP, bits of TX shifter otherwise.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            i2c_sda_out_r <= 1'b1;
-            i2c_sda_oen_r <= 1'b0;
+            sda_out_r <= 1'b1;
         end
         else begin
-            case (cur_state)
-                FSM_I2C_SIZE: begin
-                    i2c_sda_out_r <= #UDLY 1'b1;
-                    i2c_sda_oen_r <= #UDLY 1'b0;
-                end
-                FSM_I2C_START: begin
-                    if (sda_data_pst) begin
-                        i2c_sda_out_r <= #UDLY 1'b0;
-                        i2c_sda_oen_r <= #UDLY 1'b0;
-                    end
-                end
-                FSM_I2C_ADDR: begin
-                    if ((~bit_cnt_end) & sda_data_pre) begin
-                        i2c_sda_out_r <= #UDLY i2c_data_r[7];
-                    end
-                    else if (bit_cnt_end & sda_data_pre) begin
-                        if (i2c_read_r) begin
-                            i2c_sda_out_r <= #UDLY 1'b1;
-                            i2c_sda_oen_r <= #UDLY 1'b1;
-                        end
-                    end
-                end
-                FSM_I2C_WRITE: begin
-                    if ((~bit_cnt_end) & sda_data_pre) begin
-                        i2c_sda_out_r <= #UDLY i2c_data_r[7];
-                    end
-                    else if (bit_cnt_end & sda_data_pre) begin
-                        i2c_sda_out_r <= #UDLY 1'b1;
-                        i2c_sda_oen_r <= #UDLY 1'b1;
-                    end
-                end
-                FSM_I2C_READ: begin
-                    if (bit_cnt_end & sda_data_pre) begin
-                        i2c_sda_out_r <= #UDLY byte_cnt_end;
-                        i2c_sda_oen_r <= #UDLY 1'b0;
-                    end
-                end
-                FSM_I2C_ACK: begin
-                    if (sda_data_pre) begin
-                        if ((byte_cnt_end || (i2c_size_r == 8'd0)) && frame_cnt_end) begin
-                            i2c_sda_out_r <= #UDLY 1'b0;
-                            i2c_sda_oen_r <= #UDLY 1'b0;
-                        end
-                        else if ((~i2c_read_r) & (~byte_cnt_end)) begin
-                            i2c_sda_out_r <= #UDLY i2c_data_r[7];
-                            i2c_sda_oen_r <= #UDLY 1'b0;
-                        end
-                    end
-                end
-                FSM_I2C_STOP: begin
-                    if (sda_data_pst) begin
-                        i2c_sda_out_r <= #UDLY 1'b1;
-                        i2c_sda_oen_r <= #UDLY 1'b0;
-                    end
-                end
-            endcase
+            if (nscl_end) begin
+                sda_out_r <= #UDLY 1'b1;
+            end
+            else if (low_sda) begin
+                sda_out_r <= #UDLY cond_r ? (cmd_r != CMD_STOP) : tx_sft_r[8];
+            end
+            else if (high_sda) begin
+                sda_out_r <= #UDLY (cmd_r == CMD_STOP);
+            end
+        end
+    end
+
+    // Events.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            nack_r <= 1'b0;
+            nscl_r <= 1'b0;
+            done_r <= 1'b0;
+        end
+        else begin
+            nack_r <= #UDLY byte_end & byte_nack;
+            nscl_r <= #UDLY nscl_end;
+            done_r <= #UDLY run_r & run_end & (~i2c_start);
         end
     end
 
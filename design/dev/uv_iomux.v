@@ -7,6 +7,9 @@
 //
 // Description:
 //      IO Mux to reuse IO ports for GPIO & other perips.
+//      PWM outputs take the IOs from PWM_IO_BASE when their
+//      output enables are set, and capture inputs are taken
+//      from CAP_IO_BASE, with input forced on when enabled.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -14,7 +17,11 @@
 module uv_iomux
 #(
     parameter IO_NUM                = 32,
-    parameter MUX_IO_NUM            = 10
+    parameter MUX_IO_NUM            = 10,
+    parameter PWM_IO_BASE           = 16,
+    parameter PWM_IO_NUM            = 8,
+    parameter CAP_IO_BASE           = 24,
+    parameter CAP_IO_NUM            = 2
 )
 (
     input                           clk,
@@ -35,6 +42,11 @@ module uv_iomux
     input                           spi1_mosi,
     output                          spi1_miso,
 
+    input  [PWM_IO_NUM-1:0]         pwm_oe,
+    input  [PWM_IO_NUM-1:0]         pwm_out,
+    input  [CAP_IO_NUM-1:0]         cap_ie,
+    output [CAP_IO_NUM-1:0]         cap_in,
+
     input  [IO_NUM-1:0]             src_gpio_pu,
     input  [IO_NUM-1:0]             src_gpio_pd,
     input  [IO_NUM-1:0]             src_gpio_ie,
@@ -50,6 +62,8 @@ module uv_iomux
     output [IO_NUM-1:0]             dst_gpio_out
 );
 
+    genvar i;
+
     // Mux for UART.
     assign dst_gpio_pu [0]          = gpio_mode ? src_gpio_pu [0] : 1'b1;   // Pull-up for uart_rx.
     assign dst_gpio_pd [0]          = gpio_mode ? src_gpio_pd [0] : 1'b0;
@@ -126,15 +140,42 @@ module uv_iomux
     assign src_gpio_in [9]          = gpio_mode ? dst_gpio_in [9] : 1'b0;
     assign spi1_miso                = gpio_mode ? 1'b0 : dst_gpio_in [9];
 
-    // Pass through other GPIOs.
+    // Pass through other GPIOs, or mux them for PWM & capture.
     generate
-        if (IO_NUM > MUX_IO_NUM) begin: gen_other_gpio
-            assign dst_gpio_pu [IO_NUM-1:MUX_IO_NUM] = src_gpio_pu [IO_NUM-1:MUX_IO_NUM];
-            assign dst_gpio_pd [IO_NUM-1:MUX_IO_NUM] = src_gpio_pd [IO_NUM-1:MUX_IO_NUM];
-            assign dst_gpio_ie [IO_NUM-1:MUX_IO_NUM] = src_gpio_ie [IO_NUM-1:MUX_IO_NUM];
-            assign dst_gpio_oe [IO_NUM-1:MUX_IO_NUM] = src_gpio_oe [IO_NUM-1:MUX_IO_NUM];
-            assign dst_gpio_out[IO_NUM-1:MUX_IO_NUM] = src_gpio_out[IO_NUM-1:MUX_IO_NUM];
-            assign src_gpio_in [IO_NUM-1:MUX_IO_NUM] = dst_gpio_in [IO_NUM-1:MUX_IO_NUM];
+        for (i = MUX_IO_NUM; i < IO_NUM; i = i + 1) begin: gen_other_gpio
+            if ((i >= PWM_IO_BASE) && (i < PWM_IO_BASE + PWM_IO_NUM)) begin: gen_pwm_io
+                assign dst_gpio_pu [i] = src_gpio_pu[i];
+                assign dst_gpio_pd [i] = src_gpio_pd[i];
+                assign dst_gpio_ie [i] = src_gpio_ie[i];
+                assign dst_gpio_oe [i] = pwm_oe[i-PWM_IO_BASE] | src_gpio_oe[i];
+                assign dst_gpio_out[i] = pwm_oe[i-PWM_IO_BASE] ? pwm_out[i-PWM_IO_BASE] : src_gpio_out[i];
+                assign src_gpio_in [i] = dst_gpio_in[i];
+            end
+            else if ((i >= CAP_IO_BASE) && (i < CAP_IO_BASE + CAP_IO_NUM)) begin: gen_cap_io
+                assign dst_gpio_pu [i] = src_gpio_pu[i];
+                assign dst_gpio_pd [i] = src_gpio_pd[i];
+                assign dst_gpio_ie [i] = cap_ie[i-CAP_IO_BASE] | src_gpio_ie[i];
+                assign dst_gpio_oe [i] = src_gpio_oe[i];
+                assign dst_gpio_out[i] = src_gpio_out[i];
+                assign src_gpio_in [i] = dst_gpio_in[i];
+            end
+            else begin: gen_gpio_io
+                assign dst_gpio_pu [i] = src_gpio_pu [i];
+                assign dst_gpio_pd [i] = src_gpio_pd [i];
+                assign dst_gpio_ie [i] = src_gpio_ie [i];
+                assign dst_gpio_oe [i] = src_gpio_oe [i];
+                assign dst_gpio_out[i] = src_gpio_out[i];
+                assign src_gpio_in [i] = dst_gpio_in [i];
+            end
+        end
+
+        for (i = 0; i < CAP_IO_NUM; i = i + 1) begin: gen_cap_in
+            if (CAP_IO_BASE + i < IO_NUM) begin: gen_cap_in_vld
+                assign cap_in[i] = cap_ie[i] & dst_gpio_in[CAP_IO_BASE+i];
+            end
+            else begin: gen_cap_in_pad
+                assign cap_in[i] = 1'b0;
+            end
         end
     endgenerate
 
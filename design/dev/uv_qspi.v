@@ -6,8 +6,12 @@
 // Designer: Owen
 //
 // Description:
-//      FIXME: Quad-SPI to be implemented.
-//      Compatible with Dual-SPI and standard SPI.
+//      Quad-SPI controller for serial NOR flash.
+//      The lower registers are the same as uv_spi, which run
+//      standard SPI on IO0/IO1 in register mode. The upper
+//      registers configure the execute-in-place engine, which
+//      maps the flash to a read-only memory window & takes
+//      over the pins while enabled.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,7 +20,16 @@ module uv_qspi
 #(
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
-    parameter MLEN                  = DLEN / 8
+    parameter MLEN                  = DLEN / 8,
+    parameter XIP_ALEN              = 28,
+    parameter XIP_AW                = 24,
+    parameter LINE_DW               = 256,
+    parameter CACHE_NUM             = 16,
+    parameter PF_NUM                = 2,
+    parameter TXQ_AW                = 3,
+    parameter TXQ_DP                = 2**TXQ_AW,
+    parameter RXQ_AW                = 3,
+    parameter RXQ_DP                = 2**RXQ_AW
 )
 (
     input                           clk,
@@ -34,6 +47,18 @@ module uv_qspi
     output [1:0]                    qspi_rsp_excp,
     output [DLEN-1:0]               qspi_rsp_data,
 
+    input                           xip_req_vld,
+    output                          xip_req_rdy,
+    input                           xip_req_read,
+    input  [XIP_ALEN-1:0]           xip_req_addr,
+    input  [MLEN-1:0]               xip_req_mask,
+    input  [DLEN-1:0]               xip_req_data,
+
+    output                          xip_rsp_vld,
+    input                           xip_rsp_rdy,
+    output [1:0]                    xip_rsp_excp,
+    output [DLEN-1:0]               xip_rsp_data,
+
     output                          spi_sck,
     output                          spi_cs0,
     output                          spi_cs1,
@@ -55,42 +80,202 @@ module uv_qspi
     output                          spi_irq
 );
 
-    localparam UDLY = 1;
-
-    reg                             rsp_vld_r;
-
-    assign qspi_req_rdy             = 1'b1;
-    assign qspi_rsp_vld             = rsp_vld_r;
-    assign qspi_rsp_excp            = 2'b0;
-    assign qspi_rsp_data            = {DLEN{1'b1}};
-
-    assign spi_sck                  = 1'b1;
-    assign spi_cs0                  = 1'b1;
-    assign spi_cs1                  = 1'b1;
-    assign spi_cs2                  = 1'b1;
-    assign spi_cs3                  = 1'b1;
-    assign spi_oen0                 = 1'b1;
-    assign spi_oen1                 = 1'b1;
-    assign spi_oen2                 = 1'b1;
-    assign spi_oen3                 = 1'b1;
-    assign spi_sdo0                 = 1'b1;
-    assign spi_sdo1                 = 1'b1;
-    assign spi_sdo2                 = 1'b1;
-    assign spi_sdo3                 = 1'b1;
-    assign spi_irq                  = 1'b0;
-
-    always @(posedge clk or negedge rst_n) begin
-        if (~rst_n) begin
-            rsp_vld_r <= 1'b0;
-        end
-        else begin
-            if (qspi_req_vld & qspi_req_rdy) begin
-                rsp_vld_r <= #UDLY 1'b1;
-            end
-            else if (qspi_rsp_vld & qspi_rsp_rdy) begin
-                rsp_vld_r <= #UDLY 1'b0;
-            end
-        end
-    end
+    localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
+    localparam CS_NUM               = 4;
+
+    wire                            qspi_psel;
+    wire                            qspi_penable;
+    wire   [2:0]                    qspi_pprot;
+    wire   [ALEN-1:0]               qspi_paddr;
+    wire   [MLEN-1:0]               qspi_pstrb;
+    wire                            qspi_pwrite;
+    wire   [DLEN-1:0]               qspi_pwdata;
+    wire   [DLEN-1:0]               qspi_prdata;
+    wire                            qspi_pready;
+    wire                            qspi_pslverr;
+
+    wire                            reg_xip_sel;
+    wire                            spi_psel;
+    wire   [DLEN-1:0]               spi_prdata;
+    wire                            spi_pready;
+    wire                            spi_pslverr;
+    wire                            xip_psel;
+    wire   [DLEN-1:0]               xip_prdata;
+    wire                            xip_pready;
+    wire                            xip_pslverr;
+
+    wire   [CS_NUM-1:0]             spi_cs;
+    wire                            spi_sck_reg;
+    wire                            spi_mosi;
+    wire                            spi_miso;
+
+    wire                            xip_own;
+    wire                            xip_cs;
+    wire                            xip_sck;
+    wire   [3:0]                    xip_oen;
+    wire   [3:0]                    xip_sdo;
+    wire   [3:0]                    xip_sdi;
+
+    uv_bus_to_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
+    )
+    u_bus_to_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Bus ports.
+        .bus_req_vld                ( qspi_req_vld          ),
+        .bus_req_rdy                ( qspi_req_rdy          ),
+        .bus_req_read               ( qspi_req_read         ),
+        .bus_req_addr               ( qspi_req_addr         ),
+        .bus_req_mask               ( qspi_req_mask         ),
+        .bus_req_data               ( qspi_req_data         ),
+
+        .bus_rsp_vld                ( qspi_rsp_vld          ),
+        .bus_rsp_rdy                ( qspi_rsp_rdy          ),
+        .bus_rsp_excp               ( qspi_rsp_excp         ),
+        .bus_rsp_data               ( qspi_rsp_data         ),
+
+        // APB ports.
+        .apb_psel                   ( qspi_psel             ),
+        .apb_penable                ( qspi_penable          ),
+        .apb_pprot                  ( qspi_pprot            ),
+        .apb_paddr                  ( qspi_paddr            ),
+        .apb_pstrb                  ( qspi_pstrb            ),
+        .apb_pwrite                 ( qspi_pwrite           ),
+        .apb_pwdata                 ( qspi_pwdata           ),
+        .apb_prdata                 ( qspi_prdata           ),
+        .apb_pready                 ( qspi_pready           ),
+        .apb_pslverr                ( qspi_pslverr          )
+    );
+
+    // SPI registers are at 0x00~0x3C & XIP registers from 0x40.
+    assign reg_xip_sel              = |qspi_paddr[ALEN-1:6];
+    assign spi_psel                 = qspi_psel & (~reg_xip_sel);
+    assign xip_psel                 = qspi_psel & reg_xip_sel;
+    assign qspi_prdata              = reg_xip_sel ? xip_prdata  : spi_prdata;
+    assign qspi_pready              = reg_xip_sel ? xip_pready  : spi_pready;
+    assign qspi_pslverr             = reg_xip_sel ? xip_pslverr : spi_pslverr;
+
+    // Register mode.
+    uv_spi_apb
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .TXQ_AW                     ( TXQ_AW                ),
+        .TXQ_DP                     ( TXQ_DP                ),
+        .RXQ_AW                     ( RXQ_AW                ),
+        .RXQ_DP                     ( RXQ_DP                ),
+        .CS_NUM                     ( CS_NUM                )
+    )
+    u_spi_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // APB ports.
+        .spi_psel                   ( spi_psel              ),
+        .spi_penable                ( qspi_penable          ),
+        .spi_pprot                  ( qspi_pprot            ),
+        .spi_paddr                  ( qspi_paddr            ),
+        .spi_pstrb                  ( qspi_pstrb            ),
+        .spi_pwrite                 ( qspi_pwrite           ),
+        .spi_pwdata                 ( qspi_pwdata           ),
+        .spi_prdata                 ( spi_prdata            ),
+        .spi_pready                 ( spi_pready            ),
+        .spi_pslverr                ( spi_pslverr           ),
+
+        // Serial ports.
+        .spi_cs                     ( spi_cs                ),
+        .spi_sck                    ( spi_sck_reg           ),
+        .spi_mosi                   ( spi_mosi              ),
+        .spi_miso                   ( spi_miso              ),
+
+        // Interrupt request.
+        .spi_irq                    ( spi_irq               ),
+
+        // Descriptor registers are shadowed by XIP, so no DMA here.
+        .spi_tx_dma_req             (                       ),
+        .spi_tx_dma_ack             ( 1'b0                  ),
+        .spi_rx_dma_req             (                       ),
+        .spi_rx_dma_ack             ( 1'b0                  ),
+
+        .spi_desc_trig              ( 1'b0                  ),
+        .spi_done_evt               (                       )
+    );
+
+    // XIP mode.
+    uv_qspi_xip
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .XIP_ALEN                   ( XIP_ALEN              ),
+        .XIP_AW                     ( XIP_AW                ),
+        .LINE_DW                    ( LINE_DW               ),
+        .CACHE_NUM                  ( CACHE_NUM             ),
+        .PF_NUM                     ( PF_NUM                )
+    )
+    u_xip
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .xip_psel                   ( xip_psel              ),
+        .xip_penable                ( qspi_penable          ),
+        .xip_pprot                  ( qspi_pprot            ),
+        .xip_paddr                  ( qspi_paddr            ),
+        .xip_pstrb                  ( qspi_pstrb            ),
+        .xip_pwrite                 ( qspi_pwrite           ),
+        .xip_pwdata                 ( qspi_pwdata           ),
+        .xip_prdata                 ( xip_prdata            ),
+        .xip_pready                 ( xip_pready            ),
+        .xip_pslverr                ( xip_pslverr           ),
+
+        .xip_req_vld                ( xip_req_vld           ),
+        .xip_req_rdy                ( xip_req_rdy           ),
+        .xip_req_read               ( xip_req_read          ),
+        .xip_req_addr               ( xip_req_addr          ),
+        .xip_req_mask               ( xip_req_mask          ),
+        .xip_req_data               ( xip_req_data          ),
+
+        .xip_rsp_vld                ( xip_rsp_vld           ),
+        .xip_rsp_rdy                ( xip_rsp_rdy           ),
+        .xip_rsp_excp               ( xip_rsp_excp          ),
+        .xip_rsp_data               ( xip_rsp_data          ),
+
+        .xip_own                    ( xip_own               ),
+        .xip_cs                     ( xip_cs                ),
+        .xip_sck                    ( xip_sck               ),
+        .xip_oen                    ( xip_oen               ),
+        .xip_sdo                    ( xip_sdo               ),
+        .xip_sdi                    ( xip_sdi               )
+    );
+
+    // Pin muxing. IO2/IO3 are held high as WP#/HOLD# in register mode.
+    assign xip_sdi                  = {spi_sdi3, spi_sdi2, spi_sdi1, spi_sdi0};
+    assign spi_miso                 = spi_sdi1;
+
+    assign spi_sck                  = xip_own ? xip_sck    : spi_sck_reg;
+    assign spi_cs0                  = xip_own ? xip_cs     : spi_cs[0];
+    assign spi_cs1                  = spi_cs[1];
+    assign spi_cs2                  = spi_cs[2];
+    assign spi_cs3                  = spi_cs[3];
+    assign spi_oen0                 = xip_own ? xip_oen[0] : 1'b0;
+    assign spi_oen1                 = xip_own ? xip_oen[1] : 1'b1;
+    assign spi_oen2                 = xip_own ? xip_oen[2] : 1'b0;
+    assign spi_oen3                 = xip_own ? xip_oen[3] : 1'b0;
+    assign spi_sdo0                 = xip_own ? xip_sdo[0] : spi_mosi;
+    assign spi_sdo1                 = xip_own ? xip_sdo[1] : 1'b1;
+    assign spi_sdo2                 = xip_own ? xip_sdo[2] : 1'b1;
+    assign spi_sdo3                 = xip_own ? xip_sdo[3] : 1'b1;
 
 endmodule
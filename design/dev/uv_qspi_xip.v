@@ -0,0 +1,704 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_qspi_xip
+//
+// Designer: Owen
+//
+// Description:
+//      Execute-in-place engine of QSPI for serial NOR flash.
+//      Misses are filled by quad-I/O fast reading (0xEB) line
+//      by line into a direct-mapped read cache, and the engine
+//      keeps streaming the following lines as prefetching
+//      while chip select is held. Once the flash accepts the
+//      continuous-read mode bits, later readings skip the
+//      command phase until XIP is disabled, when a mode reset
+//      sequence is sent before releasing the pins.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_qspi_xip
+#(
+    parameter ALEN                  = 12,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter XIP_ALEN              = 28,
+    parameter XIP_AW                = 24,   // Flash address width, 24 for 3-byte addressing.
+    parameter LINE_DW               = 256,
+    parameter CACHE_NUM             = 16,   // Cache lines, must be power of 2.
+    parameter PF_NUM                = 2     // Max lines prefetched ahead of the latest access.
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // XIP control registers.
+    input                           xip_psel,
+    input                           xip_penable,
+    input  [2:0]                    xip_pprot,
+    input  [ALEN-1:0]               xip_paddr,
+    input  [MLEN-1:0]               xip_pstrb,
+    input                           xip_pwrite,
+    input  [DLEN-1:0]               xip_pwdata,
+    output [DLEN-1:0]               xip_prdata,
+    output                          xip_pready,
+    output                          xip_pslverr,
+
+    // XIP window.
+    input                           xip_req_vld,
+    output                          xip_req_rdy,
+    input                           xip_req_read,
+    input  [XIP_ALEN-1:0]           xip_req_addr,
+    input  [MLEN-1:0]               xip_req_mask,
+    input  [DLEN-1:0]               xip_req_data,
+
+    output                          xip_rsp_vld,
+    input                           xip_rsp_rdy,
+    output [1:0]                    xip_rsp_excp,
+    output [DLEN-1:0]               xip_rsp_data,
+
+    // Serial ports, which are taken by XIP while xip_own is high.
+    output                          xip_own,
+    output                          xip_cs,
+    output                          xip_sck,
+    output [3:0]                    xip_oen,
+    output [3:0]                    xip_sdo,
+    input  [3:0]                    xip_sdi
+);
+
+    localparam UDLY                 = 1;
+    localparam ADDR_DEC_WIDTH       = ALEN - 2;
+    localparam OFFSET_AW            = $clog2(MLEN);
+    localparam LINE_MW              = LINE_DW / 8;
+    localparam LINE_OW              = $clog2(LINE_MW);
+    localparam LINE_AW              = XIP_AW - LINE_OW;
+    localparam LINE_NIB             = LINE_MW * 2;
+    localparam NIB_CW               = LINE_OW + 2;
+    localparam CACHE_IW             = CACHE_NUM > 1 ? $clog2(CACHE_NUM) : 1;
+    localparam ADDR_CYC             = XIP_AW / 4;
+
+    // Registers following the SPI ones in the same APB space.
+    localparam REG_XIP_CFG          = 16;
+    localparam REG_XIP_CTRL         = 17;
+    localparam REG_XIP_STAT         = 18;
+    localparam REG_XIP_HIT_CNT      = 19;
+    localparam REG_XIP_MISS_CNT     = 20;
+    localparam REG_XIP_FILL_CNT     = 21;
+    localparam REG_ADDR_MIN         = 16;
+    localparam REG_ADDR_MAX         = 21;
+
+    // xip_en[0], cont_en[1], pf_en[2], dummy[7:4], cmd[15:8], mode[23:16], clk_div[31:24].
+    localparam XIP_CFG_DEF          = 32'h00A0EB47;
+
+    localparam FSM_XIP_IDLE         = 3'h0;
+    localparam FSM_XIP_CMD          = 3'h1;
+    localparam FSM_XIP_ADDR         = 3'h2;
+    localparam FSM_XIP_MODE         = 3'h3;
+    localparam FSM_XIP_DUMY         = 3'h4;
+    localparam FSM_XIP_DATA         = 3'h5;
+    localparam FSM_XIP_STOP         = 3'h6;
+    localparam FSM_XIP_MRST         = 3'h7;
+
+    // Registers.
+    wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
+    wire                            xip_cfg_match;
+    wire                            xip_ctrl_match;
+    wire                            xip_stat_match;
+    wire                            xip_hit_cnt_match;
+    wire                            xip_miss_cnt_match;
+    wire                            xip_fill_cnt_match;
+    wire                            addr_mismatch;
+
+    wire                            xip_cfg_wr;
+    wire                            xip_ctrl_wr;
+    wire                            xip_cfg_rd;
+    wire                            xip_stat_rd;
+    wire                            xip_hit_cnt_rd;
+    wire                            xip_miss_cnt_rd;
+    wire                            xip_fill_cnt_rd;
+
+    reg  [31:0]                     xip_cfg_r;
+    reg  [31:0]                     hit_cnt_r;
+    reg  [31:0]                     miss_cnt_r;
+    reg  [31:0]                     fill_cnt_r;
+    wire                            cache_inv;
+    wire                            cnt_clr;
+
+    reg  [DLEN-1:0]                 rsp_data;
+    reg  [DLEN-1:0]                 reg_data_r;
+    reg                             reg_vld_r;
+    reg                             reg_excp_r;
+
+    wire                            xip_en;
+    wire                            cont_en;
+    wire                            pf_en;
+    wire [3:0]                      dummy;
+    wire [7:0]                      cmd;
+    wire [7:0]                      mode;
+    wire [7:0]                      clk_div;
+    wire [7:0]                      mode_bits;
+
+    // Request decoding.
+    wire [LINE_AW-1:0]              req_line;
+    wire [LINE_OW-1:0]              req_ofs;
+    wire [LINE_MW+MLEN-1:0]         req_lsft_mask;
+    wire                            req_misalign;
+    wire                            req_fault;
+    wire                            req_pass;
+    wire                            req_fire;
+    wire                            rsp_fire;
+
+    // Lookup for new or pending request.
+    wire [LINE_AW-1:0]              lk_line;
+    wire [LINE_OW-1:0]              lk_ofs;
+    wire [CACHE_IW-1:0]             lk_idx;
+    wire [LINE_OW:0]                lk_end;
+    wire [NIB_CW-1:0]               lk_need;
+    wire                            cache_hit;
+    wire                            fill_hit;
+    wire                            lk_hit;
+    wire [LINE_DW-1:0]              hit_line;
+    wire [LINE_DW-1:0]              hit_sft_line;
+
+    reg                             miss_pend_r;
+    reg  [LINE_AW-1:0]              miss_line_r;
+    reg  [LINE_OW-1:0]              miss_ofs_r;
+    wire                            miss_done;
+    wire                            miss_drop;
+    reg  [LINE_AW-1:0]              last_line_r;
+
+    reg                             rsp_vld_r;
+    reg  [1:0]                      rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    // Cache.
+    reg  [CACHE_NUM-1:0]            cache_vld_r;
+    reg  [LINE_AW-1:0]              cache_tag_r [CACHE_NUM-1:0];
+    reg  [LINE_DW-1:0]              cache_data_r [CACHE_NUM-1:0];
+
+    // Line being filled.
+    reg                             fill_vld_r;
+    reg  [LINE_AW-1:0]              fill_tag_r;
+    reg  [NIB_CW-1:0]               fill_nib_r;
+    reg  [LINE_DW-1:0]              fill_data_r;
+    reg  [LINE_DW-1:0]              fill_data_nxt;
+
+    // Engine.
+    reg  [2:0]                      cur_state;
+    reg  [2:0]                      nxt_state;
+    wire                            state_idle;
+    wire                            state_cmd;
+    wire                            state_addr;
+    wire                            state_mode;
+    wire                            state_dumy;
+    wire                            state_data;
+    wire                            state_stop;
+    wire                            state_mrst;
+
+    reg  [LINE_AW-1:0]              eng_line_r;
+    reg                             eng_vld_r;
+    reg                             cont_act_r;
+    reg                             gap_r;
+    reg                             sck_r;
+    reg  [7:0]                      div_cnt_r;
+    reg  [4:0]                      cyc_cnt_r;
+    reg  [31:0]                     sft_r;
+
+    wire [LINE_AW-1:0]              eng_nxt;
+    wire [CACHE_IW-1:0]             nxt_idx;
+    wire                            nxt_cached;
+    wire [LINE_AW-1:0]              pf_ahead;
+    wire                            pf_want;
+    wire                            dmd_new;
+    wire                            dmd_nxt;
+    wire [LINE_AW-1:0]              start_line;
+    wire                            start;
+    wire                            start_mrst;
+
+    wire                            sck_run;
+    wire                            half_end;
+    wire                            sck_rise;
+    wire                            sck_fall;
+    wire                            cyc_last;
+    wire [4:0]                      dummy_cyc;
+    wire                            line_done;
+    wire                            line_cont;
+    wire                            data_abort;
+    wire                            data_start;
+
+    //************************************************************
+    // Control registers.
+    //************************************************************
+    assign dec_addr                 = xip_paddr[ALEN-1:2];
+    assign xip_cfg_match            = dec_addr == REG_XIP_CFG[ADDR_DEC_WIDTH-1:0];
+    assign xip_ctrl_match           = dec_addr == REG_XIP_CTRL[ADDR_DEC_WIDTH-1:0];
+    assign xip_stat_match           = dec_addr == REG_XIP_STAT[ADDR_DEC_WIDTH-1:0];
+    assign xip_hit_cnt_match        = dec_addr == REG_XIP_HIT_CNT[ADDR_DEC_WIDTH-1:0];
+    assign xip_miss_cnt_match       = dec_addr == REG_XIP_MISS_CNT[ADDR_DEC_WIDTH-1:0];
+    assign xip_fill_cnt_match       = dec_addr == REG_XIP_FILL_CNT[ADDR_DEC_WIDTH-1:0];
+    assign addr_mismatch            = (dec_addr < REG_ADDR_MIN[ADDR_DEC_WIDTH-1:0])
+                                    | (dec_addr > REG_ADDR_MAX[ADDR_DEC_WIDTH-1:0]);
+
+    assign xip_cfg_wr               = xip_psel & (~xip_penable) & xip_pwrite & xip_cfg_match;
+    assign xip_ctrl_wr              = xip_psel & (~xip_penable) & xip_pwrite & xip_ctrl_match;
+
+    assign xip_cfg_rd               = xip_psel & (~xip_penable) & (~xip_pwrite) & xip_cfg_match;
+    assign xip_stat_rd              = xip_psel & (~xip_penable) & (~xip_pwrite) & xip_stat_match;
+    assign xip_hit_cnt_rd           = xip_psel & (~xip_penable) & (~xip_pwrite) & xip_hit_cnt_match;
+    assign xip_miss_cnt_rd          = xip_psel & (~xip_penable) & (~xip_pwrite) & xip_miss_cnt_match;
+    assign xip_fill_cnt_rd          = xip_psel & (~xip_penable) & (~xip_pwrite) & xip_fill_cnt_match;
+
+    assign xip_prdata               = reg_data_r;
+    assign xip_pready               = reg_vld_r;
+    assign xip_pslverr              = reg_excp_r;
+
+    assign xip_en                   = xip_cfg_r[0];
+    assign cont_en                  = xip_cfg_r[1];
+    assign pf_en                    = xip_cfg_r[2];
+    assign dummy                    = xip_cfg_r[7:4];
+    assign cmd                      = xip_cfg_r[15:8];
+    assign mode                     = xip_cfg_r[23:16];
+    assign clk_div                  = xip_cfg_r[31:24];
+    assign mode_bits                = cont_en ? mode : 8'hff;
+
+    // Invalidate the cache after reprogramming flash with XIP disabled.
+    assign cache_inv                = xip_ctrl_wr & xip_pstrb[0] & xip_pwdata[0];
+    assign cnt_clr                  = xip_ctrl_wr & xip_pstrb[0] & xip_pwdata[1];
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            xip_cfg_r <= XIP_CFG_DEF;
+        end
+        else begin
+            if (xip_cfg_wr) begin
+                xip_cfg_r[7:0]   <= #UDLY xip_pstrb[0] ? xip_pwdata[7:0]   : xip_cfg_r[7:0];
+                xip_cfg_r[15:8]  <= #UDLY xip_pstrb[1] ? xip_pwdata[15:8]  : xip_cfg_r[15:8];
+                xip_cfg_r[23:16] <= #UDLY xip_pstrb[2] ? xip_pwdata[23:16] : xip_cfg_r[23:16];
+                xip_cfg_r[31:24] <= #UDLY xip_pstrb[3] ? xip_pwdata[31:24] : xip_cfg_r[31:24];
+            end
+        end
+    end
+
+    always @(*) begin
+        case (1'b1)
+            xip_cfg_rd      : rsp_data = {{(DLEN-32){1'b0}}, xip_cfg_r};
+            xip_stat_rd     : rsp_data = {{(DLEN-2){1'b0}}, cont_act_r, ~state_idle};
+            xip_hit_cnt_rd  : rsp_data = {{(DLEN-32){1'b0}}, hit_cnt_r};
+            xip_miss_cnt_rd : rsp_data = {{(DLEN-32){1'b0}}, miss_cnt_r};
+            xip_fill_cnt_rd : rsp_data = {{(DLEN-32){1'b0}}, fill_cnt_r};
+            default         : rsp_data = {DLEN{1'b0}};
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            reg_data_r <= {DLEN{1'b0}};
+            reg_vld_r  <= 1'b0;
+            reg_excp_r <= 1'b0;
+        end
+        else begin
+            if (xip_psel & (~xip_penable)) begin
+                reg_data_r <= #UDLY rsp_data;
+                reg_vld_r  <= #UDLY 1'b1;
+                reg_excp_r <= #UDLY addr_mismatch;
+            end
+            else begin
+                reg_vld_r  <= #UDLY 1'b0;
+                reg_excp_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    //************************************************************
+    // XIP window & read cache.
+    //************************************************************
+    assign req_line                 = xip_req_addr[XIP_AW-1:LINE_OW];
+    assign req_ofs                  = xip_req_addr[LINE_OW-1:0];
+    assign req_lsft_mask            = {{LINE_MW{1'b0}}, xip_req_mask} << req_ofs;
+    assign req_misalign             = |req_lsft_mask[LINE_MW+MLEN-1:LINE_MW];
+    // Flash is programmed in register mode, so the window is read-only.
+    assign req_fault                = (~xip_req_read) | (~xip_en) | (|xip_req_addr[XIP_ALEN-1:XIP_AW]);
+    assign req_pass                 = req_fault | req_misalign;
+
+    assign req_fire                 = xip_req_vld & xip_req_rdy;
+    assign rsp_fire                 = xip_rsp_vld & xip_rsp_rdy;
+
+    // A pending miss keeps looking up until its line arrives.
+    assign lk_line                  = miss_pend_r ? miss_line_r : req_line;
+    assign lk_ofs                   = miss_pend_r ? miss_ofs_r  : req_ofs;
+    assign lk_idx                   = lk_line[CACHE_IW-1:0];
+    assign lk_end                   = lk_ofs + MLEN;
+    assign lk_need                  = lk_end > LINE_MW ? LINE_NIB : {lk_end, 1'b0};
+
+    assign cache_hit                = cache_vld_r[lk_idx] & (cache_tag_r[lk_idx] == lk_line);
+    // The line being filled serves the bytes already received.
+    assign fill_hit                 = fill_vld_r & (fill_tag_r == lk_line) & (fill_nib_r >= lk_need);
+    assign lk_hit                   = cache_hit | fill_hit;
+    assign hit_line                 = cache_hit ? cache_data_r[lk_idx] : fill_data_r;
+    assign hit_sft_line             = hit_line >> {lk_ofs, 3'b0};
+
+    assign miss_done                = miss_pend_r & lk_hit;
+    assign miss_drop                = miss_pend_r & (~lk_hit) & (~xip_en);
+
+    assign xip_req_rdy              = ~miss_pend_r & (~rsp_vld_r | rsp_fire);
+    assign xip_rsp_vld              = rsp_vld_r;
+    assign xip_rsp_excp             = rsp_excp_r;
+    assign xip_rsp_data             = rsp_data_r;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r  <= 1'b0;
+            rsp_excp_r <= 2'b0;
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (req_fire & (req_pass | lk_hit)) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY {req_misalign & ~req_fault, req_fault};
+                rsp_data_r <= #UDLY req_pass ? {DLEN{1'b0}} : hit_sft_line[DLEN-1:0];
+            end
+            else if (miss_done) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY 2'b0;
+                rsp_data_r <= #UDLY hit_sft_line[DLEN-1:0];
+            end
+            else if (miss_drop) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY 2'b01;
+                rsp_data_r <= #UDLY {DLEN{1'b0}};
+            end
+            else if (rsp_fire) begin
+                rsp_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            miss_pend_r <= 1'b0;
+            miss_line_r <= {LINE_AW{1'b0}};
+            miss_ofs_r  <= {LINE_OW{1'b0}};
+        end
+        else begin
+            if (req_fire & (~req_pass) & (~lk_hit)) begin
+                miss_pend_r <= #UDLY 1'b1;
+                miss_line_r <= #UDLY req_line;
+                miss_ofs_r  <= #UDLY req_ofs;
+            end
+            else if (miss_done | miss_drop) begin
+                miss_pend_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            last_line_r <= {LINE_AW{1'b0}};
+        end
+        else begin
+            if (req_fire & (~req_pass)) begin
+                last_line_r <= #UDLY req_line;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            hit_cnt_r  <= 32'b0;
+            miss_cnt_r <= 32'b0;
+            fill_cnt_r <= 32'b0;
+        end
+        else begin
+            if (cnt_clr) begin
+                hit_cnt_r  <= #UDLY 32'b0;
+                miss_cnt_r <= #UDLY 32'b0;
+                fill_cnt_r <= #UDLY 32'b0;
+            end
+            else begin
+                if (req_fire & (~req_pass) & lk_hit) begin
+                    hit_cnt_r  <= #UDLY hit_cnt_r + 1'b1;
+                end
+                if (req_fire & (~req_pass) & (~lk_hit)) begin
+                    miss_cnt_r <= #UDLY miss_cnt_r + 1'b1;
+                end
+                if (line_done) begin
+                    fill_cnt_r <= #UDLY fill_cnt_r + 1'b1;
+                end
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cache_vld_r <= {CACHE_NUM{1'b0}};
+        end
+        else begin
+            if (cache_inv) begin
+                cache_vld_r <= #UDLY {CACHE_NUM{1'b0}};
+            end
+            else if (line_done) begin
+                cache_vld_r[eng_line_r[CACHE_IW-1:0]] <= #UDLY 1'b1;
+            end
+        end
+    end
+
+    // Cache data is left without reset to be mapped onto distributed RAM.
+    always @(posedge clk) begin
+        if (line_done) begin
+            cache_tag_r[eng_line_r[CACHE_IW-1:0]]  <= #UDLY eng_line_r;
+            cache_data_r[eng_line_r[CACHE_IW-1:0]] <= #UDLY fill_data_nxt;
+        end
+    end
+
+    //************************************************************
+    // Line filling.
+    //************************************************************
+    // Data nibbles arrive high nibble first with bytes in ascending address.
+    always @(*) begin
+        fill_data_nxt = fill_data_r;
+        fill_data_nxt[{fill_nib_r[LINE_OW:1], ~fill_nib_r[0], 2'b0}+:4] = xip_sdi;
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            fill_vld_r  <= 1'b0;
+            fill_tag_r  <= {LINE_AW{1'b0}};
+            fill_nib_r  <= {NIB_CW{1'b0}};
+            fill_data_r <= {LINE_DW{1'b0}};
+        end
+        else begin
+            if (cache_inv) begin
+                fill_vld_r  <= #UDLY 1'b0;
+            end
+            else if (data_start) begin
+                fill_vld_r  <= #UDLY 1'b1;
+                fill_tag_r  <= #UDLY eng_line_r;
+                fill_nib_r  <= #UDLY {NIB_CW{1'b0}};
+            end
+            else if (line_cont) begin
+                fill_tag_r  <= #UDLY eng_nxt;
+                fill_nib_r  <= #UDLY {NIB_CW{1'b0}};
+                fill_data_r <= #UDLY fill_data_nxt;
+            end
+            else if (state_data & sck_rise & (fill_nib_r < LINE_NIB)) begin
+                fill_nib_r  <= #UDLY fill_nib_r + 1'b1;
+                fill_data_r <= #UDLY fill_data_nxt;
+            end
+        end
+    end
+
+    //************************************************************
+    // Serial engine.
+    //************************************************************
+    assign state_idle               = cur_state == FSM_XIP_IDLE;
+    assign state_cmd                = cur_state == FSM_XIP_CMD;
+    assign state_addr               = cur_state == FSM_XIP_ADDR;
+    assign state_mode               = cur_state == FSM_XIP_MODE;
+    assign state_dumy               = cur_state == FSM_XIP_DUMY;
+    assign state_data               = cur_state == FSM_XIP_DATA;
+    assign state_stop               = cur_state == FSM_XIP_STOP;
+    assign state_mrst               = cur_state == FSM_XIP_MRST;
+
+    // Demand misses go first, and prefetching stays PF_NUM lines ahead at most.
+    assign dmd_new                  = xip_en & miss_pend_r & (~lk_hit)
+                                    & ~((state_cmd | state_addr | state_mode | state_dumy | state_data)
+                                    & (eng_line_r == miss_line_r));
+    assign dmd_nxt                  = dmd_new & (miss_line_r == eng_nxt);
+
+    assign eng_nxt                  = eng_line_r + 1'b1;
+    assign nxt_idx                  = eng_nxt[CACHE_IW-1:0];
+    assign nxt_cached               = cache_vld_r[nxt_idx] & (cache_tag_r[nxt_idx] == eng_nxt);
+    assign pf_ahead                 = eng_nxt - last_line_r;
+    assign pf_want                  = xip_en & pf_en & eng_vld_r & (~nxt_cached) & (|eng_nxt)
+                                    & (pf_ahead <= PF_NUM) & (~dmd_new | dmd_nxt);
+
+    assign start_line               = dmd_new ? miss_line_r : eng_nxt;
+    assign start                    = state_idle & (~gap_r) & (dmd_new | pf_want);
+    assign start_mrst               = state_idle & (~gap_r) & cont_act_r & (~xip_en);
+
+    // SCK idles low, outputs shift on falling edges & inputs are sampled on rising edges.
+    assign sck_run                  = state_cmd | state_addr | state_mode | state_dumy | state_data | state_mrst;
+    assign half_end                 = div_cnt_r == clk_div;
+    assign sck_rise                 = sck_run & half_end & (~sck_r);
+    assign sck_fall                 = (sck_run | state_stop) & half_end & sck_r;
+
+    assign dummy_cyc                = {1'b0, dummy} - 1'b1;
+    assign cyc_last                 = state_cmd  ? (cyc_cnt_r == 5'd7)
+                                    : state_addr ? (cyc_cnt_r == ADDR_CYC - 1)
+                                    : state_mode ? (cyc_cnt_r == 5'd1)
+                                    : state_dumy ? (cyc_cnt_r == dummy_cyc)
+                                    : state_mrst ? (cyc_cnt_r == 5'd7)
+                                    : 1'b0;
+
+    assign data_start               = sck_fall & cyc_last & ((state_mode & (dummy == 4'd0)) | state_dumy);
+    assign line_done                = state_data & sck_rise & (fill_nib_r == LINE_NIB - 1);
+    assign line_cont                = line_done & (dmd_nxt | pf_want);
+    assign data_abort               = state_data & sck_fall & dmd_new;
+
+    always @(*) begin
+        case (cur_state)
+            FSM_XIP_IDLE: begin
+                if (start_mrst) begin
+                    nxt_state = FSM_XIP_MRST;
+                end
+                else if (start) begin
+                    nxt_state = cont_act_r ? FSM_XIP_ADDR : FSM_XIP_CMD;
+                end
+                else begin
+                    nxt_state = FSM_XIP_IDLE;
+                end
+            end
+            FSM_XIP_CMD : nxt_state = sck_fall & cyc_last ? FSM_XIP_ADDR : FSM_XIP_CMD;
+            FSM_XIP_ADDR: nxt_state = sck_fall & cyc_last ? FSM_XIP_MODE : FSM_XIP_ADDR;
+            FSM_XIP_MODE: begin
+                if (sck_fall & cyc_last) begin
+                    nxt_state = dummy == 4'd0 ? FSM_XIP_DATA : FSM_XIP_DUMY;
+                end
+                else begin
+                    nxt_state = FSM_XIP_MODE;
+                end
+            end
+            FSM_XIP_DUMY: nxt_state = sck_fall & cyc_last ? FSM_XIP_DATA : FSM_XIP_DUMY;
+            FSM_XIP_DATA: begin
+                if ((line_done & ~line_cont) | data_abort) begin
+                    nxt_state = FSM_XIP_STOP;
+                end
+                else begin
+                    nxt_state = FSM_XIP_DATA;
+                end
+            end
+            FSM_XIP_STOP: nxt_state = half_end & (~sck_r) ? FSM_XIP_IDLE : FSM_XIP_STOP;
+            FSM_XIP_MRST: nxt_state = sck_fall & cyc_last ? FSM_XIP_STOP : FSM_XIP_MRST;
+            default     : nxt_state = FSM_XIP_IDLE;
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_state <= FSM_XIP_IDLE;
+        end
+        else begin
+            cur_state <= #UDLY nxt_state;
+        end
+    end
+
+    // Chip select is held high for one half period at least between readings.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            gap_r <= 1'b0;
+        end
+        else begin
+            if (state_stop & half_end & (~sck_r)) begin
+                gap_r <= #UDLY 1'b1;
+            end
+            else if (state_idle & half_end) begin
+                gap_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            div_cnt_r <= 8'b0;
+        end
+        else begin
+            if (half_end | (state_idle & (~gap_r))) begin
+                div_cnt_r <= #UDLY 8'b0;
+            end
+            else begin
+                div_cnt_r <= #UDLY div_cnt_r + 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            sck_r <= 1'b0;
+        end
+        else begin
+            if (sck_rise) begin
+                sck_r <= #UDLY 1'b1;
+            end
+            else if (sck_fall) begin
+                sck_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cyc_cnt_r <= 5'b0;
+            sft_r     <= 32'b0;
+        end
+        else begin
+            if (start) begin
+                cyc_cnt_r <= #UDLY 5'b0;
+                sft_r     <= #UDLY cont_act_r ? {start_line, {(32-LINE_AW){1'b0}}} : {cmd, 24'b0};
+            end
+            else if (start_mrst) begin
+                cyc_cnt_r <= #UDLY 5'b0;
+            end
+            else if (sck_fall & cyc_last) begin
+                cyc_cnt_r <= #UDLY 5'b0;
+                case (1'b1)
+                    state_cmd : sft_r <= #UDLY {eng_line_r, {(32-LINE_AW){1'b0}}};
+                    state_addr: sft_r <= #UDLY {mode_bits, 24'b0};
+                    default   : sft_r <= #UDLY sft_r;
+                endcase
+            end
+            else if (sck_fall) begin
+                cyc_cnt_r <= #UDLY cyc_cnt_r + 1'b1;
+                sft_r     <= #UDLY state_cmd ? {sft_r[30:0], 1'b0} : {sft_r[27:0], 4'b0};
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            eng_line_r <= {LINE_AW{1'b0}};
+            eng_vld_r  <= 1'b0;
+        end
+        else begin
+            if (start) begin
+                eng_line_r <= #UDLY start_line;
+            end
+            else if (line_cont) begin
+                eng_line_r <= #UDLY eng_nxt;
+            end
+
+            if (cache_inv) begin
+                eng_vld_r  <= #UDLY 1'b0;
+            end
+            else if (line_done) begin
+                eng_vld_r  <= #UDLY 1'b1;
+            end
+        end
+    end
+
+    // The flash keeps continuous reading while mode bits are 2'b10 on [5:4].
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cont_act_r <= 1'b0;
+        end
+        else begin
+            if (state_mode & sck_fall & cyc_last) begin
+                cont_act_r <= #UDLY mode_bits[5:4] == 2'b10;
+            end
+            else if (state_mrst & sck_fall & cyc_last) begin
+                cont_act_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    assign xip_own                  = xip_en | (~state_idle) | gap_r | cont_act_r;
+    assign xip_cs                   = state_idle;
+    assign xip_sck                  = sck_r;
+    assign xip_oen                  = state_cmd ? 4'b0010
+                                    : (state_addr | state_mode | state_mrst) ? 4'b0000
+                                    : 4'b1111;
+    assign xip_sdo                  = state_cmd  ? {3'b110, sft_r[31]}
+                                    : state_mrst ? 4'b1111
+                                    : sft_r[31:28];
+
+endmodule
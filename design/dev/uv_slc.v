@@ -7,6 +7,21 @@
 //
 // Description:
 //      System-level Controller.
+//      For HART_NUM harts, bit i of SFT_IRQ is the software IRQ
+//      (IPI) of hart i, and each hart has a timer comparator
+//      at HART_CMP (& HART_CMPH) + 8 * i. That of hart 0 is
+//      also TMR_CMP.
+//      BUS_QOS sets the QoS of devbus masters: 2-bit classes
+//      in [7:0], starvation limit in [15:8] & 4-bit weights
+//      in [31:16], by master index.
+//      The registers are also reached by the core-local port,
+//      which takes precedence over the bus port. Reading
+//      TMR_VAL latches the upper half for the port, and it is
+//      returned by TMR_VALS, so the 64-bit value is read in 2
+//      loads without retry.
+//      Each bit of the first 32 registers up to EXT_IE, except
+//      IRQ_CLAIM, is aliased to a word from 0x8000, where bit 0
+//      is read or written in place, by either port.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -19,7 +34,8 @@ module uv_slc
     parameter RST_VEC_LEN           = 32,
     parameter RST_VEC_DEF           = 64'h04000000,
     parameter EXT_IRQ_NUM           = 64,
-    parameter IRQ_PRI_NUM           = 8
+    parameter IRQ_PRI_NUM           = 8,
+    parameter HART_NUM              = 1
 )
 (
     input                           sys_clk,
@@ -39,17 +55,30 @@ module uv_slc
     output [1:0]                    slc_rsp_excp,
     output [DLEN-1:0]               slc_rsp_data,
 
-    input                           tmr_irq_clr,
+    input                           lcl_req_vld,
+    output                          lcl_req_rdy,
+    input                           lcl_req_read,
+    input  [ALEN-1:0]               lcl_req_addr,
+    input  [MLEN-1:0]               lcl_req_mask,
+    input  [DLEN-1:0]               lcl_req_data,
+
+    output                          lcl_rsp_vld,
+    input                           lcl_rsp_rdy,
+    output [1:0]                    lcl_rsp_excp,
+    output [DLEN-1:0]               lcl_rsp_data,
+
+    input  [HART_NUM-1:0]           tmr_irq_clr,
     input  [EXT_IRQ_NUM-1:0]        ext_irq_src,
 
     output                          slc_rst_n,
     output [31:0]                   dev_rst_n,
     output                          gpio_mode,
     output [31:0]                   sys_icg,
+    output [31:0]                   bus_qos,
     output [RST_VEC_LEN-1:0]        rst_vec,
     output                          ext_irq,
-    output                          sft_irq,
-    output                          tmr_irq,
+    output [HART_NUM-1:0]           sft_irq,
+    output [HART_NUM-1:0]           tmr_irq,
     output [63:0]                   tmr_val
 );
 
@@ -77,7 +106,9 @@ module uv_slc
     localparam REG_SYS_ICG          = 9;
     localparam REG_SCRATCH          = 10;
     localparam REG_GPIO_MODE        = 11;
-    localparam REG_CTRL_ADDR_MAX    = 11;
+    localparam REG_BUS_QOS          = 12;
+    localparam REG_TMR_VALS         = 13;
+    localparam REG_CTRL_ADDR_MAX    = 13;
 
     localparam REG_EXT_IRQ_START    = 14;
     localparam REG_IRQ_CLAIM        = 14;
@@ -96,6 +127,14 @@ module uv_slc
     localparam REG_EXT_TG_END       = REG_EXT_TG_START + REG_EXT_TG_NUM - 1;
     localparam REG_IRQ_ADDR_MAX     = REG_EXT_TG_END;
 
+    // Per-hart comparators, above the IRQ registers.
+    localparam REG_HART_CMP_START   = 256;
+    localparam REG_HART_CMP_END     = REG_HART_CMP_START + HART_NUM * 2 - 1;
+
+    // Bit-band alias: word 32 * reg + bit.
+    localparam REG_BB_START         = 8192;
+    localparam REG_BB_END           = REG_BB_START + 32 * 32 - 1;
+
     localparam IE_IDX_WIDTH         = $clog2(REG_EXT_IE_NUM);
     localparam IP_IDX_WIDTH         = $clog2(REG_EXT_IP_NUM);
     localparam PR_IDX_WIDTH         = $clog2(REG_EXT_PR_NUM);
@@ -103,21 +142,42 @@ module uv_slc
     genvar i, j, k;
 
     wire                            rst_n;
+    wire [ADDR_DEC_WIDTH-1:0]       req_dec;
     wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
 
+    // Bit-band alias.
+    wire [ADDR_DEC_WIDTH-1:0]       bb_idx;
+    wire [ADDR_DEC_WIDTH-1:0]       bb_reg;
+    wire                            bb_match;
+    wire [4:0]                      bb_bit;
+    wire [DLEN-1:0]                 bb_mask;
+
+    // Request of the bus or core-local port.
+    wire                            req_lcl;
+    wire                            req_vld;
+    wire                            req_read;
+    wire [ALEN-1:0]                 req_addr;
+    wire [MLEN-1:0]                 req_mask;
+    wire [DLEN-1:0]                 req_data;
+    wire [MLEN-1:0]                 port_mask;
+    wire [DLEN-1:0]                 port_data;
+    wire                            rsp_fire;
+
     // Control registers.
     reg  [RST_VEC_LEN-1:0]          rst_vec_r;
-    reg                             sft_irq_r;
-    reg                             tmr_irq_r;
+    reg  [HART_NUM-1:0]             sft_irq_r;
+    reg  [HART_NUM-1:0]             tmr_irq_r;
     reg                             tmr_cnt_r;
     reg                             tmr_auto_clr_r;
     reg  [15:0]                     tmr_clk_div_r;
     reg  [63:0]                     tmr_val_r;
-    reg  [63:0]                     tmr_cmp_r;
+    reg  [63:0]                     tmr_cmp_r           [HART_NUM-1:0];
     reg  [31:0]                     dev_rst_r;
     reg  [31:0]                     sys_icg_r;
     reg  [31:0]                     scratch_r;
     reg                             gpio_mode_r;
+    reg  [31:0]                     bus_qos_r;
+    reg  [31:0]                     tmr_vals_r          [1:0];
 
     reg                             dev_rst_rr;
     reg                             dev_rst_rrr;
@@ -154,7 +214,9 @@ module uv_slc
 
     // Timer operation.
     wire [63:0]                     tmr_val_add;
-    wire                            tmr_cmp_geq;
+    wire [HART_NUM-1:0]             tmr_cmp_geq;
+    wire [HART_NUM-1:0]             tmr_cmp_lo_wr;
+    wire [HART_NUM-1:0]             tmr_cmp_hi_wr;
 
     // Address decoding.
     wire                            rst_vec_match;
@@ -169,16 +231,20 @@ module uv_slc
     wire                            sys_icg_match;
     wire                            scratch_match;
     wire                            gpio_mode_match;
+    wire                            bus_qos_match;
+    wire                            tmr_vals_match;
     wire                            irq_claim_match;
     wire                            target_th_match;
     wire                            ext_ip_match;
     wire                            ext_ie_match;
     wire                            ext_pr_match;
     wire                            ext_tg_match;
+    wire                            hart_cmp_match;
     wire [ADDR_DEC_WIDTH-1:0]       ext_ip_reg_idx;
     wire [ADDR_DEC_WIDTH-1:0]       ext_ie_reg_idx;
     wire [ADDR_DEC_WIDTH-1:0]       ext_pr_reg_idx;
     wire [ADDR_DEC_WIDTH-1:0]       ext_tg_reg_idx;
+    wire [ADDR_DEC_WIDTH-1:0]       hart_cmp_reg_idx;
     wire                            addr_mismatch;
 
     wire                            rst_vec_sel;
@@ -193,12 +259,15 @@ module uv_slc
     wire                            sys_icg_sel;
     wire                            scratch_sel;
     wire                            gpio_mode_sel;
+    wire                            bus_qos_sel;
+    wire                            tmr_vals_sel;
     wire                            irq_claim_sel;
     wire                            target_th_sel;
     wire                            ext_ip_sel;
     wire                            ext_ie_sel;
     wire                            ext_pr_sel;
     wire                            ext_tg_sel;
+    wire                            hart_cmp_sel;
 
     wire                            rst_vec_wr;
     wire                            sft_irq_wr;
@@ -212,11 +281,13 @@ module uv_slc
     wire                            sys_icg_wr;
     wire                            scratch_wr;
     wire                            gpio_mode_wr;
+    wire                            bus_qos_wr;
     wire                            irq_claim_wr;
     wire                            target_th_wr;
     wire                            ext_ie_wr;
     wire                            ext_pr_wr;
     wire                            ext_tg_wr;
+    wire                            hart_cmp_wr;
 
     wire                            rst_vec_rd;
     wire                            sft_irq_rd;
@@ -228,12 +299,15 @@ module uv_slc
     wire                            sys_icg_rd;
     wire                            scratch_rd;
     wire                            gpio_mode_rd;
+    wire                            bus_qos_rd;
+    wire                            tmr_vals_rd;
     wire                            irq_claim_rd;
     wire                            target_th_rd;
     wire                            ext_ip_rd;
     wire                            ext_ie_rd;
     wire                            ext_pr_rd;
     wire                            ext_tg_rd;
+    wire                            hart_cmp_rd;
 
     // Input interrupt sources.
     reg  [EXT_IRQ_NUM-1:0]          ext_irq_src_p;
@@ -243,17 +317,41 @@ module uv_slc
 
     // Responsed ctrl & data.
     reg                             rsp_vld_r;
+    reg                             rsp_lcl_r;
     reg                             rsp_excp_r;
     reg  [DLEN-1:0]                 rsp_data;
     reg  [DLEN-1:0]                 rsp_data_r;
 
     assign rst_n                    = sys_rst_n & por_rst_n;
 
-    // Request always ready.
-    assign slc_req_rdy              = 1'b1;
+    // Core-local requests are always ready, and bus ones wait for them.
+    assign req_lcl                  = lcl_req_vld;
+    assign req_vld                  = lcl_req_vld | slc_req_vld;
+    assign req_read                 = req_lcl ? lcl_req_read : slc_req_read;
+    assign req_addr                 = req_lcl ? lcl_req_addr : slc_req_addr;
+    assign port_mask                = req_lcl ? lcl_req_mask : slc_req_mask;
+    assign port_data                = req_lcl ? lcl_req_data : slc_req_data;
+    assign lcl_req_rdy              = 1'b1;
+    assign slc_req_rdy              = ~lcl_req_vld;
+    assign rsp_fire                 = (slc_rsp_vld & slc_rsp_rdy) | (lcl_rsp_vld & lcl_rsp_rdy);
+
+    // Map a bit-band alias to its register, with one bit changed by a write.
+    assign req_dec                  = req_addr[ALEN-1:OFFSET_AW];
+    assign bb_idx                   = req_dec - REG_BB_START[ADDR_DEC_WIDTH-1:0];
+    assign bb_reg                   = bb_idx >> 5;
+    assign bb_bit                   = bb_idx[4:0];
+    assign bb_mask                  = {{(DLEN-1){1'b0}}, 1'b1} << bb_bit;
+    assign bb_match                 =  (req_dec >= REG_BB_START[ADDR_DEC_WIDTH-1:0])
+                                    && (req_dec <= REG_BB_END  [ADDR_DEC_WIDTH-1:0])
+                                    && (bb_reg  != REG_IRQ_CLAIM [ADDR_DEC_WIDTH-1:0])
+                                    && (bb_reg  <= REG_EXT_IE_END[ADDR_DEC_WIDTH-1:0]);
+
+    assign req_mask                 = bb_match ? {MLEN{1'b1}} : port_mask;
+    assign req_data                 = bb_match ? ((rsp_data & (~bb_mask)) | (port_data[0] ? bb_mask : {DLEN{1'b0}}))
+                                    : port_data;
 
     // Match request address.
-    assign dec_addr                 = slc_req_addr[ALEN-1:OFFSET_AW];
+    assign dec_addr                 = bb_match ? bb_reg : req_dec;
     assign rst_vec_match            = dec_addr == REG_RST_VEC  [ADDR_DEC_WIDTH-1:0];
     assign sft_irq_match            = dec_addr == REG_SFT_IRQ  [ADDR_DEC_WIDTH-1:0];
     assign tmr_cfg_match            = dec_addr == REG_TMR_CFG  [ADDR_DEC_WIDTH-1:0];
@@ -266,6 +364,8 @@ module uv_slc
     assign sys_icg_match            = dec_addr == REG_SYS_ICG  [ADDR_DEC_WIDTH-1:0];
     assign scratch_match            = dec_addr == REG_SCRATCH  [ADDR_DEC_WIDTH-1:0];
     assign gpio_mode_match          = dec_addr == REG_GPIO_MODE[ADDR_DEC_WIDTH-1:0];
+    assign bus_qos_match            = dec_addr == REG_BUS_QOS  [ADDR_DEC_WIDTH-1:0];
+    assign tmr_vals_match           = dec_addr == REG_TMR_VALS [ADDR_DEC_WIDTH-1:0];
     assign irq_claim_match          = dec_addr == REG_IRQ_CLAIM[ADDR_DEC_WIDTH-1:0];
     assign target_th_match          = dec_addr == REG_TARGET_TH[ADDR_DEC_WIDTH-1:0];
     assign ext_ip_match             =  (dec_addr >= REG_EXT_IP_START[ADDR_DEC_WIDTH-1:0])
@@ -279,69 +379,89 @@ module uv_slc
     assign ext_ip_reg_idx           = dec_addr - REG_EXT_IP_START[ADDR_DEC_WIDTH-1:0];
     assign ext_ie_reg_idx           = dec_addr - REG_EXT_IE_START[ADDR_DEC_WIDTH-1:0];
     assign ext_pr_reg_idx           = dec_addr - REG_EXT_PR_START[ADDR_DEC_WIDTH-1:0];
+    assign hart_cmp_match           =  (dec_addr >= REG_HART_CMP_START[ADDR_DEC_WIDTH-1:0])
+                                    && (dec_addr <= REG_HART_CMP_END  [ADDR_DEC_WIDTH-1:0]);
     assign ext_tg_reg_idx           = dec_addr - REG_EXT_TG_START[ADDR_DEC_WIDTH-1:0];
+    assign hart_cmp_reg_idx         = dec_addr - REG_HART_CMP_START[ADDR_DEC_WIDTH-1:0];
     assign addr_mismatch            = ((dec_addr > REG_CTRL_ADDR_MAX[ADDR_DEC_WIDTH-1:0])
                                     && (dec_addr < REG_EXT_IRQ_START[ADDR_DEC_WIDTH-1:0]))
-                                    || (dec_addr > REG_IRQ_ADDR_MAX[ADDR_DEC_WIDTH-1:0]);
+                                    || ((dec_addr > REG_IRQ_ADDR_MAX[ADDR_DEC_WIDTH-1:0])
+                                    && (~hart_cmp_match));
 
     // Select register.
-    assign rst_vec_sel              = slc_req_vld & rst_vec_match ;
-    assign sft_irq_sel              = slc_req_vld & sft_irq_match ;
-    assign tmr_cfg_sel              = slc_req_vld & tmr_cfg_match ;
-    assign tmr_val_sel              = slc_req_vld & tmr_val_match ;
-    assign tmr_valh_sel             = slc_req_vld & tmr_valh_match;
-    assign tmr_cmp_sel              = slc_req_vld & tmr_cmp_match ;
-    assign tmr_cmph_sel             = slc_req_vld & tmr_cmph_match;
-    assign slc_rst_sel              = slc_req_vld & slc_rst_match ;
-    assign dev_rst_sel              = slc_req_vld & dev_rst_match ;
-    assign sys_icg_sel              = slc_req_vld & sys_icg_match ;
-    assign scratch_sel              = slc_req_vld & scratch_match ;
-    assign gpio_mode_sel            = slc_req_vld & gpio_mode_match;
-    assign irq_claim_sel            = slc_req_vld & irq_claim_match;
-    assign target_th_sel            = slc_req_vld & target_th_match;
-    assign ext_ip_sel               = slc_req_vld & ext_ip_match;
-    assign ext_ie_sel               = slc_req_vld & ext_ie_match;
-    assign ext_pr_sel               = slc_req_vld & ext_pr_match;
-    assign ext_tg_sel               = slc_req_vld & ext_tg_match;
-
-    assign rst_vec_wr               = rst_vec_sel   & (~slc_req_read);
-    assign sft_irq_wr               = sft_irq_sel   & (~slc_req_read);
-    assign tmr_cfg_wr               = tmr_cfg_sel   & (~slc_req_read);
-    assign tmr_val_wr               = tmr_val_sel   & (~slc_req_read);
-    assign tmr_valh_wr              = tmr_valh_sel  & (~slc_req_read);
-    assign tmr_cmp_wr               = tmr_cmp_sel   & (~slc_req_read);
-    assign tmr_cmph_wr              = tmr_cmph_sel  & (~slc_req_read);
-    assign slc_rst_wr               = slc_rst_sel   & (~slc_req_read);
-    assign dev_rst_wr               = dev_rst_sel   & (~slc_req_read);
-    assign sys_icg_wr               = sys_icg_sel   & (~slc_req_read);
-    assign scratch_wr               = scratch_sel   & (~slc_req_read);
-    assign gpio_mode_wr             = gpio_mode_sel & (~slc_req_read);
-    assign irq_claim_wr             = irq_claim_sel & (~slc_req_read);
-    assign target_th_wr             = target_th_sel & (~slc_req_read);
-    assign ext_ie_wr                = ext_ie_sel    & (~slc_req_read);
-    assign ext_pr_wr                = ext_pr_sel    & (~slc_req_read);
-    assign ext_tg_wr                = ext_tg_sel    & (~slc_req_read);
-
-    assign rst_vec_rd               = rst_vec_sel   & slc_req_read;
-    assign sft_irq_rd               = sft_irq_sel   & slc_req_read;
-    assign tmr_cfg_rd               = tmr_cfg_sel   & slc_req_read;
-    assign tmr_val_rd               = tmr_val_sel   & slc_req_read;
-    assign tmr_valh_rd              = tmr_valh_sel  & slc_req_read;
-    assign tmr_cmp_rd               = tmr_cmp_sel   & slc_req_read;
-    assign tmr_cmph_rd              = tmr_cmph_sel  & slc_req_read;
-    assign sys_icg_rd               = sys_icg_sel   & slc_req_read;
-    assign scratch_rd               = scratch_sel   & slc_req_read;
-    assign gpio_mode_rd             = gpio_mode_sel & slc_req_read;
-    assign irq_claim_rd             = irq_claim_sel & slc_req_read;
-    assign target_th_rd             = target_th_sel & slc_req_read;
-    assign ext_ip_rd                = ext_ip_sel    & slc_req_read;
-    assign ext_ie_rd                = ext_ie_sel    & slc_req_read;
-    assign ext_pr_rd                = ext_pr_sel    & slc_req_read;
-    assign ext_tg_rd                = ext_tg_sel    & slc_req_read;
+    assign rst_vec_sel              = req_vld & rst_vec_match ;
+    assign sft_irq_sel              = req_vld & sft_irq_match ;
+    assign tmr_cfg_sel              = req_vld & tmr_cfg_match ;
+    assign tmr_val_sel              = req_vld & tmr_val_match ;
+    assign tmr_valh_sel             = req_vld & tmr_valh_match;
+    assign tmr_cmp_sel              = req_vld & tmr_cmp_match ;
+    assign tmr_cmph_sel             = req_vld & tmr_cmph_match;
+    assign slc_rst_sel              = req_vld & slc_rst_match ;
+    assign dev_rst_sel              = req_vld & dev_rst_match ;
+    assign sys_icg_sel              = req_vld & sys_icg_match ;
+    assign scratch_sel              = req_vld & scratch_match ;
+    assign gpio_mode_sel            = req_vld & gpio_mode_match;
+    assign bus_qos_sel              = req_vld & bus_qos_match ;
+    assign tmr_vals_sel             = req_vld & tmr_vals_match;
+    assign irq_claim_sel            = req_vld & irq_claim_match;
+    assign target_th_sel            = req_vld & target_th_match;
+    assign ext_ip_sel               = req_vld & ext_ip_match;
+    assign ext_ie_sel               = req_vld & ext_ie_match;
+    assign ext_pr_sel               = req_vld & ext_pr_match;
+    assign ext_tg_sel               = req_vld & ext_tg_match;
+    assign hart_cmp_sel             = req_vld & hart_cmp_match;
+
+    assign rst_vec_wr               = rst_vec_sel   & (~req_read);
+    assign sft_irq_wr               = sft_irq_sel   & (~req_read);
+    assign tmr_cfg_wr               = tmr_cfg_sel   & (~req_read);
+    assign tmr_val_wr               = tmr_val_sel   & (~req_read);
+    assign tmr_valh_wr              = tmr_valh_sel  & (~req_read);
+    assign tmr_cmp_wr               = tmr_cmp_sel   & (~req_read);
+    assign tmr_cmph_wr              = tmr_cmph_sel  & (~req_read);
+    assign slc_rst_wr               = slc_rst_sel   & (~req_read);
+    assign dev_rst_wr               = dev_rst_sel   & (~req_read);
+    assign sys_icg_wr               = sys_icg_sel   & (~req_read);
+    assign scratch_wr               = scratch_sel   & (~req_read);
+    assign gpio_mode_wr             = gpio_mode_sel & (~req_read);
+    assign bus_qos_wr               = bus_qos_sel   & (~req_read);
+    assign irq_claim_wr             = irq_claim_sel & (~req_read);
+    assign target_th_wr             = target_th_sel & (~req_read);
+    assign ext_ie_wr                = ext_ie_sel    & (~req_read);
+    assign ext_pr_wr                = ext_pr_sel    & (~req_read);
+    assign ext_tg_wr                = ext_tg_sel    & (~req_read);
+    assign hart_cmp_wr              = hart_cmp_sel  & (~req_read);
+
+    assign rst_vec_rd               = rst_vec_sel   & req_read;
+    assign sft_irq_rd               = sft_irq_sel   & req_read;
+    assign tmr_cfg_rd               = tmr_cfg_sel   & req_read;
+    assign tmr_val_rd               = tmr_val_sel   & req_read;
+    assign tmr_valh_rd              = tmr_valh_sel  & req_read;
+    assign tmr_cmp_rd               = tmr_cmp_sel   & req_read;
+    assign tmr_cmph_rd              = tmr_cmph_sel  & req_read;
+    assign sys_icg_rd               = sys_icg_sel   & req_read;
+    assign scratch_rd               = scratch_sel   & req_read;
+    assign gpio_mode_rd             = gpio_mode_sel & req_read;
+    assign bus_qos_rd               = bus_qos_sel   & req_read;
+    assign tmr_vals_rd              = tmr_vals_sel  & req_read;
+    assign irq_claim_rd             = irq_claim_sel & req_read;
+    assign target_th_rd             = target_th_sel & req_read;
+    assign ext_ip_rd                = ext_ip_sel    & req_read;
+    assign ext_ie_rd                = ext_ie_sel    & req_read;
+    assign ext_pr_rd                = ext_pr_sel    & req_read;
+    assign ext_tg_rd                = ext_tg_sel    & req_read;
+    assign hart_cmp_rd              = hart_cmp_sel  & req_read;
 
     // For timer IRQ.
     assign tmr_val_add              = tmr_val_r + 1'b1;
-    assign tmr_cmp_geq              = tmr_val_add >= tmr_cmp_r;
+    generate
+        for (i = 0; i < HART_NUM; i = i + 1) begin: gen_tmr_cmp_geq
+            assign tmr_cmp_geq[i]   = tmr_val_add >= tmr_cmp_r[i];
+            assign tmr_cmp_lo_wr[i] = (i == 0 ? tmr_cmp_wr  : 1'b0)
+                                    | (hart_cmp_wr & (hart_cmp_reg_idx == i * 2));
+            assign tmr_cmp_hi_wr[i] = (i == 0 ? tmr_cmph_wr : 1'b0)
+                                    | (hart_cmp_wr & (hart_cmp_reg_idx == i * 2 + 1));
+        end
+    endgenerate
 
     // For external IRQ.
     assign ext_irq_rise             = ext_irq_src & (~ext_irq_src_p);
@@ -368,11 +488,15 @@ module uv_slc
     assign dev_rst_n                = ~(dev_rst_r | dev_rst_rr | dev_rst_rrr);
     assign gpio_mode                = gpio_mode_r;
     assign sys_icg                  = sys_icg_r;
+    assign bus_qos                  = bus_qos_r;
 
     // Bus response.
-    assign slc_rsp_vld              = rsp_vld_r;
+    assign slc_rsp_vld              = rsp_vld_r & (~rsp_lcl_r);
     assign slc_rsp_excp             = {1'b0, rsp_excp_r};
     assign slc_rsp_data             = rsp_data_r;
+    assign lcl_rsp_vld              = rsp_vld_r & rsp_lcl_r;
+    assign lcl_rsp_excp             = {1'b0, rsp_excp_r};
+    assign lcl_rsp_data             = rsp_data_r;
 
     // Set rst_vec_r.
     generate
@@ -383,8 +507,8 @@ module uv_slc
                         rst_vec_r[(i+1)*8-1:i*8] <= RST_VEC_DEF[(i+1)*8-1:i*8];
                     end
                     else begin
-                        if (rst_vec_wr & slc_req_mask[i]) begin
-                            rst_vec_r[(i+1)*8-1:i*8] <= #UDLY slc_req_data[(i+1)*8-1:i*8];
+                        if (rst_vec_wr & req_mask[i]) begin
+                            rst_vec_r[(i+1)*8-1:i*8] <= #UDLY req_data[(i+1)*8-1:i*8];
                         end
                     end
                 end
@@ -395,29 +519,33 @@ module uv_slc
     // Set sft_irq_r.
     always @(posedge sys_clk or negedge rst_n) begin
         if (~rst_n) begin
-            sft_irq_r <= 1'b0;
+            sft_irq_r <= {HART_NUM{1'b0}};
         end
         else begin
-            if (sft_irq_wr & slc_req_mask[0]) begin
-                sft_irq_r <= #UDLY slc_req_data[0];
+            if (sft_irq_wr & req_mask[0]) begin
+                sft_irq_r <= #UDLY req_data[HART_NUM-1:0];
             end
         end
     end
 
     // Set tmr_irq_r.
-    always @(posedge aon_clk or negedge rst_n) begin
-        if (~rst_n) begin
-            tmr_irq_r <= 1'b0;
-        end
-        else begin
-            if (tmr_cmp_geq) begin
-                tmr_irq_r <= #UDLY 1'b1;
-            end
-            else if (tmr_irq_clr) begin
-                tmr_irq_r <= #UDLY 1'b0;
+    generate
+        for (i = 0; i < HART_NUM; i = i + 1) begin: gen_tmr_irq
+            always @(posedge aon_clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    tmr_irq_r[i] <= 1'b0;
+                end
+                else begin
+                    if (tmr_cmp_geq[i]) begin
+                        tmr_irq_r[i] <= #UDLY 1'b1;
+                    end
+                    else if (tmr_irq_clr[i]) begin
+                        tmr_irq_r[i] <= #UDLY 1'b0;
+                    end
+                end
             end
         end
-    end
+    endgenerate
 
     // Set timer config.
     always @(posedge sys_clk or negedge rst_n) begin
@@ -428,10 +556,10 @@ module uv_slc
         end
         else begin
             if (tmr_cfg_wr) begin
-                tmr_cnt_r           <= #UDLY slc_req_mask[0] ? slc_req_data[0] : tmr_cnt_r;
-                tmr_auto_clr_r      <= #UDLY slc_req_mask[0] ? slc_req_data[1] : tmr_auto_clr_r;
-                tmr_clk_div_r[7:0]  <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_clk_div_r[7:0];
-                tmr_clk_div_r[15:8] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_clk_div_r[15:8];
+                tmr_cnt_r           <= #UDLY req_mask[0] ? req_data[0] : tmr_cnt_r;
+                tmr_auto_clr_r      <= #UDLY req_mask[0] ? req_data[1] : tmr_auto_clr_r;
+                tmr_clk_div_r[7:0]  <= #UDLY req_mask[2] ? req_data[23:16] : tmr_clk_div_r[7:0];
+                tmr_clk_div_r[15:8] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_clk_div_r[15:8];
             end
         end
     end
@@ -445,18 +573,18 @@ module uv_slc
                 end
                 else begin
                     if (tmr_val_wr) begin
-                        tmr_val_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : tmr_val_r[7:0]  ;
-                        tmr_val_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : tmr_val_r[15:8] ;
-                        tmr_val_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_val_r[23:16];
-                        tmr_val_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_val_r[31:24];
+                        tmr_val_r[7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : tmr_val_r[7:0]  ;
+                        tmr_val_r[15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : tmr_val_r[15:8] ;
+                        tmr_val_r[23:16] <= #UDLY req_mask[2] ? req_data[23:16] : tmr_val_r[23:16];
+                        tmr_val_r[31:24] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_val_r[31:24];
                     end
                     else if (tmr_valh_wr) begin
-                        tmr_val_r[39:32] <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : tmr_val_r[39:32];
-                        tmr_val_r[47:40] <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : tmr_val_r[47:40];
-                        tmr_val_r[55:48] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_val_r[55:48];
-                        tmr_val_r[63:56] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_val_r[63:56];
+                        tmr_val_r[39:32] <= #UDLY req_mask[0] ? req_data[7:0]   : tmr_val_r[39:32];
+                        tmr_val_r[47:40] <= #UDLY req_mask[1] ? req_data[15:8]  : tmr_val_r[47:40];
+                        tmr_val_r[55:48] <= #UDLY req_mask[2] ? req_data[23:16] : tmr_val_r[55:48];
+                        tmr_val_r[63:56] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_val_r[63:56];
                     end
-                    else if (tmr_cmp_geq & tmr_auto_clr_r) begin
+                    else if (tmr_cmp_geq[0] & tmr_auto_clr_r) begin
                         tmr_val_r <= #UDLY 64'b0;
                     end
                     else if (tmr_cnt_r) begin
@@ -472,16 +600,16 @@ module uv_slc
                 end
                 else begin
                     if (tmr_val_wr) begin
-                        tmr_val_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : tmr_val_r[7:0]  ;
-                        tmr_val_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : tmr_val_r[15:8] ;
-                        tmr_val_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_val_r[23:16];
-                        tmr_val_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_val_r[31:24];
-                        tmr_val_r[39:32] <= #UDLY slc_req_mask[4] ? slc_req_data[39:32] : tmr_val_r[39:32];
-                        tmr_val_r[47:40] <= #UDLY slc_req_mask[5] ? slc_req_data[47:40] : tmr_val_r[47:40];
-                        tmr_val_r[55:48] <= #UDLY slc_req_mask[6] ? slc_req_data[55:48] : tmr_val_r[55:48];
-                        tmr_val_r[63:56] <= #UDLY slc_req_mask[7] ? slc_req_data[63:56] : tmr_val_r[63:56];
+                        tmr_val_r[7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : tmr_val_r[7:0]  ;
+                        tmr_val_r[15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : tmr_val_r[15:8] ;
+                        tmr_val_r[23:16] <= #UDLY req_mask[2] ? req_data[23:16] : tmr_val_r[23:16];
+                        tmr_val_r[31:24] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_val_r[31:24];
+                        tmr_val_r[39:32] <= #UDLY req_mask[4] ? req_data[39:32] : tmr_val_r[39:32];
+                        tmr_val_r[47:40] <= #UDLY req_mask[5] ? req_data[47:40] : tmr_val_r[47:40];
+                        tmr_val_r[55:48] <= #UDLY req_mask[6] ? req_data[55:48] : tmr_val_r[55:48];
+                        tmr_val_r[63:56] <= #UDLY req_mask[7] ? req_data[63:56] : tmr_val_r[63:56];
                     end
-                    else if (tmr_cmp_geq & tmr_auto_clr_r) begin
+                    else if (tmr_cmp_geq[0] & tmr_auto_clr_r) begin
                         tmr_val_r <= #UDLY 64'b0;
                     end
                     else if (tmr_cnt_r) begin
@@ -494,42 +622,44 @@ module uv_slc
 
     // Set tmr_cmp_r.
     generate
-        if (DLEN == 32) begin: gen_tmr_cmp_wr_32b
-            always @(posedge sys_clk or negedge rst_n) begin
-                if (~rst_n) begin
-                    tmr_cmp_r <= {64{1'b1}};
-                end
-                else begin
-                    if (tmr_cmp_wr) begin
-                        tmr_cmp_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : tmr_cmp_r[7:0]  ;
-                        tmr_cmp_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : tmr_cmp_r[15:8] ;
-                        tmr_cmp_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_cmp_r[23:16];
-                        tmr_cmp_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_cmp_r[31:24];
+        for (i = 0; i < HART_NUM; i = i + 1) begin: gen_tmr_cmp
+            if (DLEN == 32) begin: gen_tmr_cmp_wr_32b
+                always @(posedge sys_clk or negedge rst_n) begin
+                    if (~rst_n) begin
+                        tmr_cmp_r[i] <= {64{1'b1}};
                     end
-                    else if (tmr_cmph_wr) begin
-                        tmr_cmp_r[39:32] <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : tmr_cmp_r[39:32];
-                        tmr_cmp_r[47:40] <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : tmr_cmp_r[47:40];
-                        tmr_cmp_r[55:48] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_cmp_r[55:48];
-                        tmr_cmp_r[63:56] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_cmp_r[63:56];
+                    else begin
+                        if (tmr_cmp_lo_wr[i]) begin
+                            tmr_cmp_r[i][7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : tmr_cmp_r[i][7:0]  ;
+                            tmr_cmp_r[i][15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : tmr_cmp_r[i][15:8] ;
+                            tmr_cmp_r[i][23:16] <= #UDLY req_mask[2] ? req_data[23:16] : tmr_cmp_r[i][23:16];
+                            tmr_cmp_r[i][31:24] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_cmp_r[i][31:24];
+                        end
+                        else if (tmr_cmp_hi_wr[i]) begin
+                            tmr_cmp_r[i][39:32] <= #UDLY req_mask[0] ? req_data[7:0]   : tmr_cmp_r[i][39:32];
+                            tmr_cmp_r[i][47:40] <= #UDLY req_mask[1] ? req_data[15:8]  : tmr_cmp_r[i][47:40];
+                            tmr_cmp_r[i][55:48] <= #UDLY req_mask[2] ? req_data[23:16] : tmr_cmp_r[i][55:48];
+                            tmr_cmp_r[i][63:56] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_cmp_r[i][63:56];
+                        end
                     end
                 end
             end
-        end
-        else begin: gen_tmr_cmp_wr_64b
-            always @(posedge sys_clk or negedge rst_n) begin
-                if (~rst_n) begin
-                    tmr_cmp_r <= 64'b0;
-                end
-                else begin
-                    if (tmr_cmp_wr) begin
-                        tmr_cmp_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : tmr_cmp_r[7:0]  ;
-                        tmr_cmp_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : tmr_cmp_r[15:8] ;
-                        tmr_cmp_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : tmr_cmp_r[23:16];
-                        tmr_cmp_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : tmr_cmp_r[31:24];
-                        tmr_cmp_r[39:32] <= #UDLY slc_req_mask[4] ? slc_req_data[39:32] : tmr_cmp_r[39:32];
-                        tmr_cmp_r[47:40] <= #UDLY slc_req_mask[5] ? slc_req_data[47:40] : tmr_cmp_r[47:40];
-                        tmr_cmp_r[55:48] <= #UDLY slc_req_mask[6] ? slc_req_data[55:48] : tmr_cmp_r[55:48];
-                        tmr_cmp_r[63:56] <= #UDLY slc_req_mask[7] ? slc_req_data[63:56] : tmr_cmp_r[63:56];
+            else begin: gen_tmr_cmp_wr_64b
+                always @(posedge sys_clk or negedge rst_n) begin
+                    if (~rst_n) begin
+                        tmr_cmp_r[i] <= 64'b0;
+                    end
+                    else begin
+                        if (tmr_cmp_lo_wr[i]) begin
+                            tmr_cmp_r[i][7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : tmr_cmp_r[i][7:0]  ;
+                            tmr_cmp_r[i][15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : tmr_cmp_r[i][15:8] ;
+                            tmr_cmp_r[i][23:16] <= #UDLY req_mask[2] ? req_data[23:16] : tmr_cmp_r[i][23:16];
+                            tmr_cmp_r[i][31:24] <= #UDLY req_mask[3] ? req_data[31:24] : tmr_cmp_r[i][31:24];
+                            tmr_cmp_r[i][39:32] <= #UDLY req_mask[4] ? req_data[39:32] : tmr_cmp_r[i][39:32];
+                            tmr_cmp_r[i][47:40] <= #UDLY req_mask[5] ? req_data[47:40] : tmr_cmp_r[i][47:40];
+                            tmr_cmp_r[i][55:48] <= #UDLY req_mask[6] ? req_data[55:48] : tmr_cmp_r[i][55:48];
+                            tmr_cmp_r[i][63:56] <= #UDLY req_mask[7] ? req_data[63:56] : tmr_cmp_r[i][63:56];
+                        end
                     end
                 end
             end
@@ -543,10 +673,10 @@ module uv_slc
         end
         else begin
             if (dev_rst_wr) begin
-                dev_rst_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : dev_rst_r[7:0];
-                dev_rst_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : dev_rst_r[15:8];
-                dev_rst_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : dev_rst_r[23:16];
-                dev_rst_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : dev_rst_r[31:24];
+                dev_rst_r[7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : dev_rst_r[7:0];
+                dev_rst_r[15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : dev_rst_r[15:8];
+                dev_rst_r[23:16] <= #UDLY req_mask[2] ? req_data[23:16] : dev_rst_r[23:16];
+                dev_rst_r[31:24] <= #UDLY req_mask[3] ? req_data[31:24] : dev_rst_r[31:24];
             end
         end
     end
@@ -569,10 +699,10 @@ module uv_slc
         end
         else begin
             if (sys_icg_wr) begin
-                sys_icg_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : sys_icg_r[7:0];
-                sys_icg_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : sys_icg_r[15:8];
-                sys_icg_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : sys_icg_r[23:16];
-                sys_icg_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : sys_icg_r[31:24];
+                sys_icg_r[7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : sys_icg_r[7:0];
+                sys_icg_r[15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : sys_icg_r[15:8];
+                sys_icg_r[23:16] <= #UDLY req_mask[2] ? req_data[23:16] : sys_icg_r[23:16];
+                sys_icg_r[31:24] <= #UDLY req_mask[3] ? req_data[31:24] : sys_icg_r[31:24];
             end
         end
     end
@@ -584,10 +714,10 @@ module uv_slc
         end
         else begin
             if (scratch_wr) begin
-                scratch_r[7:0]   <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : scratch_r[7:0];
-                scratch_r[15:8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : scratch_r[15:8];
-                scratch_r[23:16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : scratch_r[23:16];
-                scratch_r[31:24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : scratch_r[31:24];
+                scratch_r[7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : scratch_r[7:0];
+                scratch_r[15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : scratch_r[15:8];
+                scratch_r[23:16] <= #UDLY req_mask[2] ? req_data[23:16] : scratch_r[23:16];
+                scratch_r[31:24] <= #UDLY req_mask[3] ? req_data[31:24] : scratch_r[31:24];
             end
         end
     end
@@ -599,7 +729,35 @@ module uv_slc
         end
         else begin
             if (gpio_mode_wr) begin
-                gpio_mode_r <= #UDLY slc_req_mask[0] ? slc_req_data[0] : gpio_mode_r;
+                gpio_mode_r <= #UDLY req_mask[0] ? req_data[0] : gpio_mode_r;
+            end
+        end
+    end
+
+    // Set bus_qos_r.
+    always @(posedge sys_clk or negedge rst_n) begin
+        if (~rst_n) begin
+            bus_qos_r <= 32'b0;
+        end
+        else begin
+            if (bus_qos_wr) begin
+                bus_qos_r[7:0]   <= #UDLY req_mask[0] ? req_data[7:0]   : bus_qos_r[7:0];
+                bus_qos_r[15:8]  <= #UDLY req_mask[1] ? req_data[15:8]  : bus_qos_r[15:8];
+                bus_qos_r[23:16] <= #UDLY req_mask[2] ? req_data[23:16] : bus_qos_r[23:16];
+                bus_qos_r[31:24] <= #UDLY req_mask[3] ? req_data[31:24] : bus_qos_r[31:24];
+            end
+        end
+    end
+
+    // Latch upper half of timer for each port.
+    always @(posedge sys_clk or negedge rst_n) begin
+        if (~rst_n) begin
+            tmr_vals_r[0] <= 32'b0;
+            tmr_vals_r[1] <= 32'b0;
+        end
+        else begin
+            if (tmr_val_rd) begin
+                tmr_vals_r[req_lcl] <= #UDLY tmr_val_r[63:32];
             end
         end
     end
@@ -622,7 +780,7 @@ module uv_slc
                     if (ext_irq_trig[i]) begin
                         irq_gate_lock_r[i] <= #UDLY 1'b1;
                     end
-                    else if (irq_claim_wr && (slc_req_data[IRQ_ID_WIDTH-1:0] == i[IRQ_ID_WIDTH-1:0])) begin
+                    else if (irq_claim_wr && (req_data[IRQ_ID_WIDTH-1:0] == i[IRQ_ID_WIDTH-1:0])) begin
                         irq_gate_lock_r[i] <= #UDLY 1'b0;
                     end
                 end
@@ -728,7 +886,7 @@ module uv_slc
             ext_irq_r <= 1'b0;
         end
         else begin
-            if (irq_claim_wr && (slc_req_data[IRQ_ID_WIDTH-1:0] == sel_irq_id_r)) begin
+            if (irq_claim_wr && (req_data[IRQ_ID_WIDTH-1:0] == sel_irq_id_r)) begin
                 ext_irq_r <= #UDLY 1'b0;
             end
             else if (sel_irq_okay) begin
@@ -744,7 +902,7 @@ module uv_slc
         end
         else begin
             if (target_th_wr) begin
-                target_th_r <= #UDLY slc_req_mask[0] ? slc_req_data[IRQ_PR_WIDTH-1:0] : target_th_r;
+                target_th_r <= #UDLY req_mask[0] ? req_data[IRQ_PR_WIDTH-1:0] : target_th_r;
             end
         end
     end
@@ -778,10 +936,10 @@ module uv_slc
                     end
                     else begin
                         if (ext_ie_wr && (ext_ie_reg_idx == i[ADDR_DEC_WIDTH-1:0])) begin
-                            irq_ie_r[i*DLEN+7:i*DLEN]     <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : irq_ie_r[i*DLEN+7:i*DLEN];
-                            irq_ie_r[i*DLEN+15:i*DLEN+8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : irq_ie_r[i*DLEN+15:i*DLEN+8];
-                            irq_ie_r[i*DLEN+23:i*DLEN+16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : irq_ie_r[i*DLEN+23:i*DLEN+16];
-                            irq_ie_r[i*DLEN+31:i*DLEN+24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : irq_ie_r[i*DLEN+31:i*DLEN+24];
+                            irq_ie_r[i*DLEN+7:i*DLEN]     <= #UDLY req_mask[0] ? req_data[7:0]   : irq_ie_r[i*DLEN+7:i*DLEN];
+                            irq_ie_r[i*DLEN+15:i*DLEN+8]  <= #UDLY req_mask[1] ? req_data[15:8]  : irq_ie_r[i*DLEN+15:i*DLEN+8];
+                            irq_ie_r[i*DLEN+23:i*DLEN+16] <= #UDLY req_mask[2] ? req_data[23:16] : irq_ie_r[i*DLEN+23:i*DLEN+16];
+                            irq_ie_r[i*DLEN+31:i*DLEN+24] <= #UDLY req_mask[3] ? req_data[31:24] : irq_ie_r[i*DLEN+31:i*DLEN+24];
                         end
                     end
                 end
@@ -795,14 +953,14 @@ module uv_slc
                     end
                     else begin
                         if (ext_ie_wr && (ext_ie_reg_idx == i[ADDR_DEC_WIDTH-1:0])) begin
-                            irq_ie_r[i*DLEN+7:i*DLEN]     <= #UDLY slc_req_mask[0] ? slc_req_data[7:0]   : irq_ie_r[i*DLEN+7:i*DLEN];
-                            irq_ie_r[i*DLEN+15:i*DLEN+8]  <= #UDLY slc_req_mask[1] ? slc_req_data[15:8]  : irq_ie_r[i*DLEN+15:i*DLEN+8];
-                            irq_ie_r[i*DLEN+23:i*DLEN+16] <= #UDLY slc_req_mask[2] ? slc_req_data[23:16] : irq_ie_r[i*DLEN+23:i*DLEN+16];
-                            irq_ie_r[i*DLEN+31:i*DLEN+24] <= #UDLY slc_req_mask[3] ? slc_req_data[31:24] : irq_ie_r[i*DLEN+31:i*DLEN+24];
-                            irq_ie_r[i*DLEN+39:i*DLEN+32] <= #UDLY slc_req_mask[4] ? slc_req_data[39:32] : irq_ie_r[i*DLEN+39:i*DLEN+32];
-                            irq_ie_r[i*DLEN+47:i*DLEN+40] <= #UDLY slc_req_mask[5] ? slc_req_data[47:40] : irq_ie_r[i*DLEN+47:i*DLEN+40];
-                            irq_ie_r[i*DLEN+55:i*DLEN+48] <= #UDLY slc_req_mask[6] ? slc_req_data[55:48] : irq_ie_r[i*DLEN+55:i*DLEN+48];
-                            irq_ie_r[i*DLEN+63:i*DLEN+56] <= #UDLY slc_req_mask[7] ? slc_req_data[63:56] : irq_ie_r[i*DLEN+63:i*DLEN+56];
+                            irq_ie_r[i*DLEN+7:i*DLEN]     <= #UDLY req_mask[0] ? req_data[7:0]   : irq_ie_r[i*DLEN+7:i*DLEN];
+                            irq_ie_r[i*DLEN+15:i*DLEN+8]  <= #UDLY req_mask[1] ? req_data[15:8]  : irq_ie_r[i*DLEN+15:i*DLEN+8];
+                            irq_ie_r[i*DLEN+23:i*DLEN+16] <= #UDLY req_mask[2] ? req_data[23:16] : irq_ie_r[i*DLEN+23:i*DLEN+16];
+                            irq_ie_r[i*DLEN+31:i*DLEN+24] <= #UDLY req_mask[3] ? req_data[31:24] : irq_ie_r[i*DLEN+31:i*DLEN+24];
+                            irq_ie_r[i*DLEN+39:i*DLEN+32] <= #UDLY req_mask[4] ? req_data[39:32] : irq_ie_r[i*DLEN+39:i*DLEN+32];
+                            irq_ie_r[i*DLEN+47:i*DLEN+40] <= #UDLY req_mask[5] ? req_data[47:40] : irq_ie_r[i*DLEN+47:i*DLEN+40];
+                            irq_ie_r[i*DLEN+55:i*DLEN+48] <= #UDLY req_mask[6] ? req_data[55:48] : irq_ie_r[i*DLEN+55:i*DLEN+48];
+                            irq_ie_r[i*DLEN+63:i*DLEN+56] <= #UDLY req_mask[7] ? req_data[63:56] : irq_ie_r[i*DLEN+63:i*DLEN+56];
                         end
                     end
                 end
@@ -819,7 +977,7 @@ module uv_slc
                 end
                 else begin
                     if (ext_pr_wr && (ext_pr_reg_idx == i[ADDR_DEC_WIDTH-1:0])) begin
-                        irq_pr_r[i] <= #UDLY slc_req_mask[0] ? slc_req_data[IRQ_PR_WIDTH-1:0] : irq_pr_r[i];
+                        irq_pr_r[i] <= #UDLY req_mask[0] ? req_data[IRQ_PR_WIDTH-1:0] : irq_pr_r[i];
                     end
                 end
             end
@@ -835,7 +993,7 @@ module uv_slc
                 end
                 else begin
                     if (ext_tg_wr && (ext_tg_reg_idx == i[ADDR_DEC_WIDTH-1:0])) begin
-                        irq_tg_r[i] <= #UDLY slc_req_mask[0] ? slc_req_data[1:0] : irq_tg_r[i];
+                        irq_tg_r[i] <= #UDLY req_mask[0] ? req_data[1:0] : irq_tg_r[i];
                     end
                 end
             end
@@ -869,25 +1027,28 @@ module uv_slc
         end
     endgenerate
 
-    // Response buf.
+    // Value of the selected register, also read by bit-band writes.
     always @(*) begin
         case (1'b1)
-            rst_vec_rd   : rsp_data = {{(DLEN-ALEN){1'b0}}, rst_vec_r};
-            sft_irq_rd   : rsp_data = {{(DLEN-1){1'b0}}, sft_irq_r};
-            tmr_cfg_rd   : rsp_data = {{(DLEN-32){1'b0}}, tmr_clk_div_r, 14'b0, tmr_auto_clr_r, tmr_cnt_r};
-            tmr_val_rd   : rsp_data = tmr_val_r;
-            tmr_valh_rd  : rsp_data = tmr_val_r >> 32;
-            tmr_cmp_rd   : rsp_data = tmr_cmp_r;
-            tmr_cmph_rd  : rsp_data = tmr_cmp_r >> 32;
-            sys_icg_rd   : rsp_data = {{(DLEN-32){1'b0}}, sys_icg_r};
-            scratch_rd   : rsp_data = {{(DLEN-32){1'b0}}, scratch_r};
-            gpio_mode_rd : rsp_data = {{(DLEN-1){1'b0}}, gpio_mode_r};
-            irq_claim_rd : rsp_data = {{(DLEN-IRQ_ID_WIDTH){1'b0}}, sel_irq_id_r};
-            target_th_rd : rsp_data = {{(DLEN-IRQ_PR_WIDTH){1'b0}}, target_th_r};
-            ext_ip_rd    : rsp_data = irq_ip_2d[ext_ip_reg_idx];
-            ext_ie_rd    : rsp_data = irq_ie_2d[ext_ie_reg_idx];
-            ext_pr_rd    : rsp_data = {{(DLEN-IRQ_PR_WIDTH){1'b0}}, irq_pr_r[ext_pr_reg_idx]};
-            ext_tg_rd    : rsp_data = {{(DLEN-2){1'b0}}, irq_tg_r[ext_tg_reg_idx]};
+            rst_vec_sel  : rsp_data = {{(DLEN-ALEN){1'b0}}, rst_vec_r};
+            sft_irq_sel  : rsp_data = {{(DLEN-HART_NUM){1'b0}}, sft_irq_r};
+            tmr_cfg_sel  : rsp_data = {{(DLEN-32){1'b0}}, tmr_clk_div_r, 14'b0, tmr_auto_clr_r, tmr_cnt_r};
+            tmr_val_sel  : rsp_data = tmr_val_r;
+            tmr_valh_sel : rsp_data = tmr_val_r >> 32;
+            tmr_cmp_sel  : rsp_data = tmr_cmp_r[0];
+            tmr_cmph_sel : rsp_data = tmr_cmp_r[0] >> 32;
+            sys_icg_sel  : rsp_data = {{(DLEN-32){1'b0}}, sys_icg_r};
+            scratch_sel  : rsp_data = {{(DLEN-32){1'b0}}, scratch_r};
+            gpio_mode_sel: rsp_data = {{(DLEN-1){1'b0}}, gpio_mode_r};
+            bus_qos_sel  : rsp_data = {{(DLEN-32){1'b0}}, bus_qos_r};
+            tmr_vals_sel : rsp_data = {{(DLEN-32){1'b0}}, tmr_vals_r[req_lcl]};
+            irq_claim_sel: rsp_data = {{(DLEN-IRQ_ID_WIDTH){1'b0}}, sel_irq_id_r};
+            target_th_sel: rsp_data = {{(DLEN-IRQ_PR_WIDTH){1'b0}}, target_th_r};
+            ext_ip_sel   : rsp_data = irq_ip_2d[ext_ip_reg_idx];
+            ext_ie_sel   : rsp_data = irq_ie_2d[ext_ie_reg_idx];
+            ext_pr_sel   : rsp_data = {{(DLEN-IRQ_PR_WIDTH){1'b0}}, irq_pr_r[ext_pr_reg_idx]};
+            ext_tg_sel   : rsp_data = {{(DLEN-2){1'b0}}, irq_tg_r[ext_tg_reg_idx]};
+            hart_cmp_sel : rsp_data = tmr_cmp_r[hart_cmp_reg_idx >> 1] >> (hart_cmp_reg_idx[0] ? 32 : 0);
             default      : rsp_data = {DLEN{1'b0}};
         endcase
     end
@@ -897,8 +1058,8 @@ module uv_slc
             rsp_data_r <= {DLEN{1'b0}};
         end
         else begin
-            if (slc_req_vld & slc_req_read) begin
-                rsp_data_r <= #UDLY rsp_data;
+            if (req_vld & req_read) begin
+                rsp_data_r <= #UDLY bb_match ? {{(DLEN-1){1'b0}}, rsp_data[bb_bit]} : rsp_data;
             end
         end
     end
@@ -906,12 +1067,14 @@ module uv_slc
     always @(posedge sys_clk or negedge rst_n) begin
         if (~rst_n) begin
             rsp_vld_r <= 1'b0;
+            rsp_lcl_r <= 1'b0;
         end
         else begin
-            if (slc_req_vld & slc_req_rdy) begin
+            if (req_vld) begin
                 rsp_vld_r <= #UDLY 1'b1;
+                rsp_lcl_r <= #UDLY req_lcl;
             end
-            else if (slc_rsp_vld & slc_rsp_rdy) begin
+            else if (rsp_fire) begin
                 rsp_vld_r <= #UDLY 1'b0;
             end
         end
@@ -922,10 +1085,10 @@ module uv_slc
             rsp_excp_r <= 1'b0;
         end
         else begin
-            if (slc_req_vld & slc_req_rdy & addr_mismatch) begin
+            if (req_vld & addr_mismatch) begin
                 rsp_excp_r <= #UDLY 1'b1;
             end
-            else if (slc_rsp_vld & slc_rsp_rdy) begin
+            else if (rsp_fire) begin
                 rsp_excp_r <= #UDLY 1'b0;
             end
         end
@@ -45,10 +45,19 @@ module uv_spi
     output                          spi_mosi,
     input                           spi_miso,
 
-    output                          spi_irq
+    output                          spi_irq,
+
+    output                          spi_tx_dma_req,
+    input                           spi_tx_dma_ack,
+    output                          spi_rx_dma_req,
+    input                           spi_rx_dma_ack,
+
+    input                           spi_desc_trig,
+    output                          spi_done_evt
 );
 
     localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
 
     wire                            spi_psel;
     wire                            spi_penable;
@@ -66,7 +75,8 @@ module uv_spi
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .PIPE                       ( BUS_PIPE              )
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
     )
     u_bus_to_apb
     (
@@ -136,7 +146,16 @@ module uv_spi
         .spi_miso                   ( spi_miso              ),
 
         // Interrupt request.
-        .spi_irq                    ( spi_irq               )
+        .spi_irq                    ( spi_irq               ),
+
+        // DMA handshakes.
+        .spi_tx_dma_req             ( spi_tx_dma_req        ),
+        .spi_tx_dma_ack             ( spi_tx_dma_ack        ),
+        .spi_rx_dma_req             ( spi_rx_dma_req        ),
+        .spi_rx_dma_ack             ( spi_rx_dma_ack        ),
+
+        .spi_desc_trig              ( spi_desc_trig         ),
+        .spi_done_evt               ( spi_done_evt          )
     );
 
 endmodule
@@ -6,7 +6,8 @@
 // Designer: Owen
 //
 // Description:
-//      SPI master with APB interface.
+//      SPI master with APB interface. Queues go through the
+//      descriptor sequencer to the serial engine.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -47,7 +48,17 @@ module uv_spi_apb
     input                           spi_miso,
 
     // Interrupt request.
-    output                          spi_irq
+    output                          spi_irq,
+
+    // DMA handshakes.
+    output                          spi_tx_dma_req,
+    input                           spi_tx_dma_ack,
+    output                          spi_rx_dma_req,
+    input                           spi_rx_dma_ack,
+
+    // Task & event of event router.
+    input                           spi_desc_trig,
+    output                          spi_done_evt
 );
 
     wire   [CS_NUM-1:0]             def_idle;
@@ -60,6 +71,31 @@ module uv_spi_apb
     wire   [15:0]                   clk_div;
     wire                            endian;
 
+    wire                            desc_start;
+    wire   [7:0]                    desc_cmd;
+    wire                            desc_cmd_en;
+    wire   [2:0]                    desc_addr_nb;
+    wire   [31:0]                   desc_addr;
+    wire   [5:0]                    desc_dmy_nc;
+    wire                            desc_rx;
+    wire   [23:0]                   desc_len;
+    wire                            desc_busy;
+    wire                            desc_done;
+    wire   [23:0]                   desc_left;
+
+    wire                            tran_idle;
+    wire                            tran_hold;
+    wire   [4:0]                    tran_unit;
+    wire                            tran_rxen;
+
+    wire                            tx_tran_rdy;
+    wire                            tx_tran_vld;
+    wire   [31:0]                   tx_tran_dat;
+
+    wire                            rx_tran_rdy;
+    wire                            rx_tran_vld;
+    wire   [31:0]                   rx_tran_dat;
+
     wire                            txq_clr;
     wire                            rxq_clr;
     wire   [TXQ_AW:0]               txq_len;
@@ -81,6 +117,8 @@ module uv_spi_apb
     wire                            rx_deq_vld;
     wire   [31:0]                   rx_deq_dat;
 
+    assign spi_done_evt             = desc_done;
+
     uv_spi_rtx
     #(
         .CS_NUM                     ( CS_NUM            )
@@ -101,21 +139,72 @@ module uv_spi_apb
         .spi_mask                   ( spi_mask          ),
         .spi_cpol                   ( spi_cpol          ),
         .spi_cpha                   ( spi_cpha          ),
-        .spi_rxen                   ( spi_rxen          ),
-        .spi_unit                   ( spi_unit          ),
+        .spi_rxen                   ( tran_rxen         ),
+        .spi_unit                   ( tran_unit         ),
         .sck_dly                    ( sck_dly           ),
         .clk_div                    ( clk_div           ),
         .endian                     ( endian            ),
 
-        // TX data from TXQ.
-        .tx_rdy                     ( tx_deq_rdy        ),
-        .tx_vld                     ( tx_deq_vld        ),
-        .tx_dat                     ( tx_deq_dat        ),
+        // Transfer control.
+        .tran_hold                  ( tran_hold         ),
+        .tran_idle                  ( tran_idle         ),
 
-        // RX data to RXQ.
-        .rx_rdy                     ( rx_enq_rdy        ),
-        .rx_vld                     ( rx_enq_vld        ),
-        .rx_dat                     ( rx_enq_dat        )
+        // TX data from sequencer.
+        .tx_rdy                     ( tx_tran_rdy       ),
+        .tx_vld                     ( tx_tran_vld       ),
+        .tx_dat                     ( tx_tran_dat       ),
+
+        // RX data to sequencer.
+        .rx_rdy                     ( rx_tran_rdy       ),
+        .rx_vld                     ( rx_tran_vld       ),
+        .rx_dat                     ( rx_tran_dat       )
+    );
+
+    uv_spi_desc u_spi_desc
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        // Descriptor.
+        .desc_start                 ( desc_start        ),
+        .desc_cmd                   ( desc_cmd          ),
+        .desc_cmd_en                ( desc_cmd_en       ),
+        .desc_addr_nb               ( desc_addr_nb      ),
+        .desc_addr                  ( desc_addr         ),
+        .desc_dmy_nc                ( desc_dmy_nc       ),
+        .desc_rx                    ( desc_rx           ),
+        .desc_len                   ( desc_len          ),
+        .desc_busy                  ( desc_busy         ),
+        .desc_done                  ( desc_done         ),
+        .desc_left                  ( desc_left         ),
+
+        // Configs of register mode.
+        .endian                     ( endian            ),
+        .spi_unit                   ( spi_unit          ),
+        .spi_rxen                   ( spi_rxen          ),
+
+        // Queues.
+        .txq_rdy                    ( tx_deq_rdy        ),
+        .txq_vld                    ( tx_deq_vld        ),
+        .txq_dat                    ( tx_deq_dat        ),
+
+        .rxq_rdy                    ( rx_enq_rdy        ),
+        .rxq_vld                    ( rx_enq_vld        ),
+        .rxq_dat                    ( rx_enq_dat        ),
+
+        // Serial engine.
+        .tran_idle                  ( tran_idle         ),
+        .tran_hold                  ( tran_hold         ),
+        .tran_unit                  ( tran_unit         ),
+        .tran_rxen                  ( tran_rxen         ),
+
+        .tx_rdy                     ( tx_tran_rdy       ),
+        .tx_vld                     ( tx_tran_vld       ),
+        .tx_dat                     ( tx_tran_dat       ),
+
+        .rx_rdy                     ( rx_tran_rdy       ),
+        .rx_vld                     ( rx_tran_vld       ),
+        .rx_dat                     ( rx_tran_dat       )
     );
 
     uv_spi_reg
@@ -158,6 +247,26 @@ module uv_spi_apb
         .spi_irq                    ( spi_irq           ),
         .endian                     ( endian            ),
 
+        // Transfer descriptor.
+        .desc_start                 ( desc_start        ),
+        .desc_cmd                   ( desc_cmd          ),
+        .desc_cmd_en                ( desc_cmd_en       ),
+        .desc_addr_nb               ( desc_addr_nb      ),
+        .desc_addr                  ( desc_addr         ),
+        .desc_dmy_nc                ( desc_dmy_nc       ),
+        .desc_rx                    ( desc_rx           ),
+        .desc_len                   ( desc_len          ),
+        .desc_busy                  ( desc_busy         ),
+        .desc_done                  ( desc_done         ),
+        .desc_left                  ( desc_left         ),
+        .desc_trig                  ( spi_desc_trig     ),
+
+        // DMA handshakes.
+        .tx_dma_req                 ( spi_tx_dma_req    ),
+        .tx_dma_ack                 ( spi_tx_dma_ack    ),
+        .rx_dma_req                 ( spi_rx_dma_req    ),
+        .rx_dma_ack                 ( spi_rx_dma_ack    ),
+
         .tx_enq_vld                 ( tx_enq_vld        ),
         .tx_enq_dat                 ( tx_enq_dat        ),
         .rx_deq_vld                 ( rx_deq_vld        ),
@@ -0,0 +1,244 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_spi_desc
+//
+// Designer: Owen
+//
+// Description:
+//      Transfer descriptor sequencer of SPI. A transfer runs
+//      the command, address, dummy & data phases under one CS
+//      assertion, where the data bytes are packed by 4 into a
+//      32-bit frame per queue word, and the rest bytes go in
+//      the last frame. The serial engine is restarted between
+//      phases with CS held. When idle, queues are connected to
+//      the engine directly as before.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_spi_desc
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Descriptor.
+    input                           desc_start,
+    input  [7:0]                    desc_cmd,
+    input                           desc_cmd_en,
+    input  [2:0]                    desc_addr_nb,
+    input  [31:0]                   desc_addr,
+    input  [5:0]                    desc_dmy_nc,
+    input                           desc_rx,
+    input  [23:0]                   desc_len,
+    output                          desc_busy,
+    output                          desc_done,
+    output [23:0]                   desc_left,
+
+    // Configs of register mode.
+    input                           endian,
+    input  [4:0]                    spi_unit,
+    input                           spi_rxen,
+
+    // Queues.
+    input                           txq_rdy,
+    output                          txq_vld,
+    input  [31:0]                   txq_dat,
+
+    input                           rxq_rdy,
+    output                          rxq_vld,
+    output [31:0]                   rxq_dat,
+
+    // Serial engine.
+    input                           tran_idle,
+    output                          tran_hold,
+    output [4:0]                    tran_unit,
+    output                          tran_rxen,
+
+    output                          tx_rdy,
+    input                           tx_vld,
+    output [31:0]                   tx_dat,
+
+    output                          rx_rdy,
+    input                           rx_vld,
+    input  [31:0]                   rx_dat
+);
+
+    localparam UDLY                 = 1;
+    localparam PH_IDLE              = 3'h0;
+    localparam PH_CMD               = 3'h1;
+    localparam PH_ADDR              = 3'h2;
+    localparam PH_DMY               = 3'h3;
+    localparam PH_DATA              = 3'h4;
+    localparam PH_TAIL              = 3'h5;
+    localparam PH_END               = 3'h6;
+
+    reg    [2:0]                    cur_ph;
+    reg    [2:0]                    nxt_ph;
+
+    reg                             ph_run_r;
+    reg    [4:0]                    ph_unit_r;
+    reg                             ph_rxen_r;
+    reg    [21:0]                   word_cnt_r;
+    reg    [1:0]                    tail_nb_r;
+    reg    [23:0]                   left_r;
+    reg                             done_r;
+
+    wire   [2:0]                    ph_first;
+    wire   [2:0]                    ph_after_cmd;
+    wire   [2:0]                    ph_after_addr;
+    wire   [2:0]                    ph_after_dmy;
+    wire   [2:0]                    ph_after_data;
+    wire   [2:0]                    addr_nb;
+    wire   [5:0]                    dmy_nc;
+    wire                            word_nz;
+    wire                            tail_nz;
+
+    wire                            ph_data;
+    wire                            ph_fire;
+    wire                            ph_last;
+    wire   [4:0]                    ph_unit;
+
+    wire   [31:0]                   txq_swap;
+    wire   [31:0]                   txq_frm;
+    wire   [4:0]                    frm_sft;
+    wire   [31:0]                   rx_sft;
+    wire   [31:0]                   rx_word;
+    reg    [31:0]                   frm_dat;
+
+    assign addr_nb                  = desc_addr_nb > 3'd4 ? 3'd4 : desc_addr_nb;
+    assign dmy_nc                   = desc_dmy_nc > 6'd32 ? 6'd32 : desc_dmy_nc;
+
+    // The phases to go, skipping empty ones. Data counters are loaded at start.
+    assign word_nz                  = cur_ph == PH_IDLE ? |desc_len[23:2] : |word_cnt_r;
+    assign tail_nz                  = cur_ph == PH_IDLE ? |desc_len[1:0]  : |tail_nb_r;
+
+    assign ph_after_data            = tail_nz ? PH_TAIL : PH_END;
+    assign ph_after_dmy             = word_nz ? PH_DATA : ph_after_data;
+    assign ph_after_addr            = (|dmy_nc) ? PH_DMY : ph_after_dmy;
+    assign ph_after_cmd             = (|addr_nb) ? PH_ADDR : ph_after_addr;
+    assign ph_first                 = desc_cmd_en ? PH_CMD : ph_after_cmd;
+
+    assign ph_data                  = (cur_ph == PH_DATA) | (cur_ph == PH_TAIL);
+    assign ph_fire                  = ph_run_r & tx_vld;
+    assign ph_last                  = (cur_ph != PH_DATA) | (word_cnt_r == 22'd1);
+
+    // Frame bits of the phase to run.
+    assign ph_unit                  = cur_ph == PH_CMD  ? 5'd7
+                                    : cur_ph == PH_ADDR ? {addr_nb[1:0] - 1'b1, 3'b111}
+                                    : cur_ph == PH_DMY  ? dmy_nc[4:0] - 1'b1
+                                    : cur_ph == PH_TAIL ? {tail_nb_r - 1'b1, 3'b111}
+                                    : 5'd31;
+
+    // Bytes go in the order of addresses, either endian.
+    assign frm_sft                  = {~ph_unit_r[4:3], 3'b0};
+    assign txq_swap                 = {txq_dat[7:0], txq_dat[15:8], txq_dat[23:16], txq_dat[31:24]};
+    assign txq_frm                  = endian ? txq_swap >> frm_sft : txq_dat;
+
+    always @(*) begin
+        case (cur_ph)
+            PH_CMD : frm_dat = {24'b0, desc_cmd};
+            PH_ADDR: frm_dat = desc_addr;
+            PH_DATA: frm_dat = desc_rx ? 32'b0 : txq_frm;
+            PH_TAIL: frm_dat = desc_rx ? 32'b0 : txq_frm;
+            default: frm_dat = 32'b0;
+        endcase
+    end
+
+    assign rx_sft                   = rx_dat << frm_sft;
+    assign rx_word                  = endian ? {rx_sft[7:0], rx_sft[15:8], rx_sft[23:16], rx_sft[31:24]} : rx_dat;
+
+    // Outputs.
+    assign desc_busy                = cur_ph != PH_IDLE;
+    assign desc_done                = done_r;
+    assign desc_left                = left_r;
+
+    assign tran_hold                = desc_busy & (cur_ph != PH_END);
+    assign tran_unit                = desc_busy ? ph_unit_r : spi_unit;
+    assign tran_rxen                = desc_busy ? ph_rxen_r : spi_rxen;
+
+    assign tx_rdy                   = ~desc_busy ? txq_rdy
+                                    : ~ph_run_r ? 1'b0
+                                    : ph_data & (~desc_rx) ? txq_rdy : 1'b1;
+    assign tx_dat                   = desc_busy ? frm_dat : txq_dat;
+    assign txq_vld                  = desc_busy ? ph_fire & ph_data & (~desc_rx) : tx_vld;
+
+    assign rx_rdy                   = desc_busy ? (~ph_rxen_r) | rxq_rdy : rxq_rdy;
+    assign rxq_vld                  = rx_vld;
+    assign rxq_dat                  = desc_busy ? rx_word : rx_dat;
+
+    // Phase.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_ph <= PH_IDLE;
+        end
+        else begin
+            cur_ph <= #UDLY nxt_ph;
+        end
+    end
+
+    always @(*) begin
+        case (cur_ph)
+            PH_IDLE: nxt_ph = desc_start ? ph_first : PH_IDLE;
+            PH_CMD : nxt_ph = ph_fire ? ph_after_cmd  : PH_CMD;
+            PH_ADDR: nxt_ph = ph_fire ? ph_after_addr : PH_ADDR;
+            PH_DMY : nxt_ph = ph_fire ? ph_after_dmy  : PH_DMY;
+            PH_DATA: nxt_ph = ph_fire & ph_last ? ph_after_data : PH_DATA;
+            PH_TAIL: nxt_ph = ph_fire ? PH_END : PH_TAIL;
+            PH_END : nxt_ph = tran_idle ? PH_IDLE : PH_END;
+            default: nxt_ph = PH_IDLE;
+        endcase
+    end
+
+    // A phase runs after the engine has finished the last one, with the frame bits fixed.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ph_run_r  <= 1'b0;
+            ph_unit_r <= 5'd0;
+            ph_rxen_r <= 1'b0;
+        end
+        else begin
+            if (nxt_ph != cur_ph) begin
+                ph_run_r  <= #UDLY 1'b0;
+            end
+            else if ((cur_ph != PH_IDLE) && (cur_ph != PH_END) && tran_idle && (~ph_run_r)) begin
+                ph_run_r  <= #UDLY 1'b1;
+                ph_unit_r <= #UDLY ph_unit;
+                ph_rxen_r <= #UDLY ph_data & desc_rx;
+            end
+        end
+    end
+
+    // Data counters.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            word_cnt_r <= 22'd0;
+            tail_nb_r  <= 2'd0;
+            left_r     <= 24'd0;
+        end
+        else begin
+            if ((cur_ph == PH_IDLE) && desc_start) begin
+                word_cnt_r <= #UDLY desc_len[23:2];
+                tail_nb_r  <= #UDLY desc_len[1:0];
+                left_r     <= #UDLY desc_len;
+            end
+            else if ((cur_ph == PH_DATA) && ph_fire) begin
+                word_cnt_r <= #UDLY word_cnt_r - 1'b1;
+                left_r     <= #UDLY left_r - 3'd4;
+            end
+            else if ((cur_ph == PH_TAIL) && ph_fire) begin
+                left_r     <= #UDLY left_r - tail_nb_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            done_r <= 1'b0;
+        end
+        else begin
+            done_r <= #UDLY (cur_ph == PH_END) & tran_idle;
+        end
+    end
+
+endmodule
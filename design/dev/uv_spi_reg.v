@@ -6,7 +6,14 @@
 // Designer: Owen
 //
 // Description:
-//      SPI register access by bus.
+//      SPI register access by bus. A write to DESC_LEN starts
+//      a transfer of DESC_CFG & DESC_ADDR if idle, and DONE of
+//      IP is set when it ends, cleared by writing 1. DMA
+//      requests are raised when TXQ has TX_DMA_TH free words,
+//      or RXQ has RX_DMA_TH words, and are held off for a while
+//      after acknowledged, so the posted writes of the last
+//      burst land before the room is checked again. A trigger
+//      from the event router restarts the last descriptor.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -50,6 +57,26 @@ module uv_spi_reg
     output                          spi_irq,
     output                          endian,
 
+    // Transfer descriptor.
+    output                          desc_start,
+    output [7:0]                    desc_cmd,
+    output                          desc_cmd_en,
+    output [2:0]                    desc_addr_nb,
+    output [31:0]                   desc_addr,
+    output [5:0]                    desc_dmy_nc,
+    output                          desc_rx,
+    output [23:0]                   desc_len,
+    input                           desc_busy,
+    input                           desc_done,
+    input  [23:0]                   desc_left,
+    input                           desc_trig,
+
+    // DMA handshakes.
+    output                          tx_dma_req,
+    input                           tx_dma_ack,
+    output                          rx_dma_req,
+    input                           rx_dma_ack,
+
     output                          tx_enq_vld,
     output [31:0]                   tx_enq_dat,
     output                          rx_deq_vld,
@@ -80,7 +107,13 @@ module uv_spi_reg
     localparam REG_SPI_IP           = 13;
     localparam REG_SPI_TX_IRQ_TH    = 14;
     localparam REG_SPI_RX_IRQ_TH    = 15;
-    localparam REG_ADDR_MAX         = 15;
+    localparam REG_SPI_DESC_CFG     = 16;
+    localparam REG_SPI_DESC_ADDR    = 17;
+    localparam REG_SPI_DESC_LEN     = 18;
+    localparam REG_SPI_DMA_CFG      = 19;
+    localparam REG_ADDR_MAX         = 19;
+
+    localparam DMA_HOLD             = 6'd63;
 
     wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
 
@@ -94,6 +127,19 @@ module uv_spi_reg
     wire                            spi_rx_ip;
     reg  [TXQ_AW:0]                 spi_tx_irq_th_r;
     reg  [RXQ_AW:0]                 spi_rx_irq_th_r;
+    reg                             spi_done_ie_r;
+    reg                             spi_done_ip_r;
+    reg  [18:0]                     spi_desc_cfg_r;
+    reg  [31:0]                     spi_desc_addr_r;
+    reg  [23:0]                     spi_desc_len_r;
+    reg  [23:0]                     spi_dma_cfg_r;
+    reg  [5:0]                      tx_dma_hold_r;
+    reg  [5:0]                      rx_dma_hold_r;
+    wire [TXQ_AW:0]                 txq_free;
+    wire                            tx_dma_en;
+    wire                            rx_dma_en;
+    wire [7:0]                      tx_dma_th;
+    wire [7:0]                      rx_dma_th;
 
     wire                            spi_glb_cfg_match;
     wire                            spi_recv_en_match;
@@ -111,6 +157,10 @@ module uv_spi_reg
     wire                            spi_ip_match;
     wire                            spi_tx_irq_th_match;
     wire                            spi_rx_irq_th_match;
+    wire                            spi_desc_cfg_match;
+    wire                            spi_desc_addr_match;
+    wire                            spi_desc_len_match;
+    wire                            spi_dma_cfg_match;
     wire                            addr_mismatch;
 
     wire                            spi_glb_cfg_wr;
@@ -121,8 +171,13 @@ module uv_spi_reg
     wire                            spi_txq_dat_wr;
     wire                            spi_rxq_clr_wr;
     wire                            spi_ie_wr;
+    wire                            spi_ip_wr;
     wire                            spi_tx_irq_th_wr;
     wire                            spi_rx_irq_th_wr;
+    wire                            spi_desc_cfg_wr;
+    wire                            spi_desc_addr_wr;
+    wire                            spi_desc_len_wr;
+    wire                            spi_dma_cfg_wr;
 
     wire                            spi_glb_cfg_rd;
     wire                            spi_recv_en_rd;
@@ -137,6 +192,10 @@ module uv_spi_reg
     wire                            spi_ip_rd;
     wire                            spi_tx_irq_th_rd;
     wire                            spi_rx_irq_th_rd;
+    wire                            spi_desc_cfg_rd;
+    wire                            spi_desc_addr_rd;
+    wire                            spi_desc_len_rd;
+    wire                            spi_dma_cfg_rd;
 
     reg                             rsp_vld_r;
     reg                             rsp_excp_r;
@@ -161,6 +220,10 @@ module uv_spi_reg
     assign spi_ip_match             = dec_addr == REG_SPI_IP[ADDR_DEC_WIDTH-1:0];
     assign spi_tx_irq_th_match      = dec_addr == REG_SPI_TX_IRQ_TH[ADDR_DEC_WIDTH-1:0];
     assign spi_rx_irq_th_match      = dec_addr == REG_SPI_RX_IRQ_TH[ADDR_DEC_WIDTH-1:0];
+    assign spi_desc_cfg_match       = dec_addr == REG_SPI_DESC_CFG[ADDR_DEC_WIDTH-1:0];
+    assign spi_desc_addr_match      = dec_addr == REG_SPI_DESC_ADDR[ADDR_DEC_WIDTH-1:0];
+    assign spi_desc_len_match       = dec_addr == REG_SPI_DESC_LEN[ADDR_DEC_WIDTH-1:0];
+    assign spi_dma_cfg_match        = dec_addr == REG_SPI_DMA_CFG[ADDR_DEC_WIDTH-1:0];
     assign addr_mismatch            = dec_addr >  REG_ADDR_MAX[ADDR_DEC_WIDTH-1:0];
 
     assign spi_glb_cfg_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_glb_cfg_match;
@@ -169,10 +232,15 @@ module uv_spi_reg
     assign spi_cs_mask_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_cs_mask_match;
     assign spi_txq_clr_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_txq_clr_match;
     assign spi_txq_dat_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_txq_dat_match;
-    assign spi_rxq_clr_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_txq_clr_match;
+    assign spi_rxq_clr_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_rxq_clr_match;
     assign spi_ie_wr                = spi_psel & (~spi_penable) & spi_pwrite & spi_ie_match;
+    assign spi_ip_wr                = spi_psel & (~spi_penable) & spi_pwrite & spi_ip_match;
     assign spi_tx_irq_th_wr         = spi_psel & (~spi_penable) & spi_pwrite & spi_tx_irq_th_match;
     assign spi_rx_irq_th_wr         = spi_psel & (~spi_penable) & spi_pwrite & spi_rx_irq_th_match;
+    assign spi_desc_cfg_wr          = spi_psel & (~spi_penable) & spi_pwrite & spi_desc_cfg_match;
+    assign spi_desc_addr_wr         = spi_psel & (~spi_penable) & spi_pwrite & spi_desc_addr_match;
+    assign spi_desc_len_wr          = spi_psel & (~spi_penable) & spi_pwrite & spi_desc_len_match;
+    assign spi_dma_cfg_wr           = spi_psel & (~spi_penable) & spi_pwrite & spi_dma_cfg_match;
 
     assign spi_glb_cfg_rd           = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_glb_cfg_match;
     assign spi_recv_en_rd           = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_recv_en_match;
@@ -187,6 +255,10 @@ module uv_spi_reg
     assign spi_ip_rd                = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_ip_match;
     assign spi_tx_irq_th_rd         = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_tx_irq_th_match;
     assign spi_rx_irq_th_rd         = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_rx_irq_th_match;
+    assign spi_desc_cfg_rd          = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_desc_cfg_match;
+    assign spi_desc_addr_rd         = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_desc_addr_match;
+    assign spi_desc_len_rd          = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_desc_len_match;
+    assign spi_dma_cfg_rd           = spi_psel & (~spi_penable) & (~spi_pwrite) & spi_dma_cfg_match;
 
     // Bus response.
     assign spi_prdata               = rsp_data_r;
@@ -208,6 +280,25 @@ module uv_spi_reg
     assign txq_clr                  = spi_txq_clr_wr;
     assign rxq_clr                  = spi_rxq_clr_wr;
 
+    // Transfer descriptor.
+    assign desc_start               = (spi_desc_len_wr | desc_trig) & (~desc_busy);
+    assign desc_cmd                 = spi_desc_cfg_r[7:0];
+    assign desc_cmd_en              = spi_desc_cfg_r[8];
+    assign desc_addr_nb             = spi_desc_cfg_r[11:9];
+    assign desc_dmy_nc              = spi_desc_cfg_r[17:12];
+    assign desc_rx                  = spi_desc_cfg_r[18];
+    assign desc_addr                = spi_desc_addr_r;
+    assign desc_len                 = spi_desc_len_wr ? spi_pwdata[23:0] : spi_desc_len_r;
+
+    // DMA requests.
+    assign txq_free                 = TXQ_DP[TXQ_AW:0] - txq_len;
+    assign tx_dma_en                = spi_dma_cfg_r[0];
+    assign rx_dma_en                = spi_dma_cfg_r[1];
+    assign tx_dma_th                = spi_dma_cfg_r[15:8];
+    assign rx_dma_th                = spi_dma_cfg_r[23:16];
+    assign tx_dma_req               = tx_dma_en & (txq_free >= tx_dma_th) & (~(|tx_dma_hold_r));
+    assign rx_dma_req               = rx_dma_en & (rxq_len >= rx_dma_th) & (~(|rx_dma_hold_r));
+
     // Output data.
     assign tx_enq_vld               = spi_txq_dat_wr;
     assign tx_enq_dat               = spi_pwdata[31:0];
@@ -216,7 +307,8 @@ module uv_spi_reg
     // Interrupt.
     assign spi_tx_ip                = txq_len <= spi_tx_irq_th_r;
     assign spi_rx_ip                = rxq_len >= spi_rx_irq_th_r;
-    assign spi_irq                  = (spi_rx_ip & spi_rx_ie_r) | (spi_tx_ip & spi_tx_ie_r);
+    assign spi_irq                  = (spi_rx_ip & spi_rx_ie_r) | (spi_tx_ip & spi_tx_ie_r)
+                                    | (spi_done_ip_r & spi_done_ie_r);
 
     // Write registers from bus.
     always @(posedge clk or negedge rst_n) begin
@@ -268,13 +360,103 @@ module uv_spi_reg
 
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            spi_tx_ie_r <= 1'b0;
-            spi_rx_ie_r <= 1'b0;
+            spi_tx_ie_r   <= 1'b0;
+            spi_rx_ie_r   <= 1'b0;
+            spi_done_ie_r <= 1'b0;
         end
         else begin
             if (spi_ie_wr) begin
-                spi_tx_ie_r <= #UDLY spi_pstrb[0] ? spi_pwdata[0] : spi_tx_ie_r;
-                spi_rx_ie_r <= #UDLY spi_pstrb[0] ? spi_pwdata[1] : spi_rx_ie_r;
+                spi_tx_ie_r   <= #UDLY spi_pstrb[0] ? spi_pwdata[0] : spi_tx_ie_r;
+                spi_rx_ie_r   <= #UDLY spi_pstrb[0] ? spi_pwdata[1] : spi_rx_ie_r;
+                spi_done_ie_r <= #UDLY spi_pstrb[0] ? spi_pwdata[2] : spi_done_ie_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            spi_done_ip_r <= 1'b0;
+        end
+        else begin
+            if (desc_done) begin
+                spi_done_ip_r <= #UDLY 1'b1;
+            end
+            else if (spi_ip_wr & spi_pstrb[0] & spi_pwdata[2]) begin
+                spi_done_ip_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            spi_desc_cfg_r <= 19'b0;
+        end
+        else begin
+            if (spi_desc_cfg_wr) begin
+                spi_desc_cfg_r[7:0]   <= #UDLY spi_pstrb[0] ? spi_pwdata[7:0]   : spi_desc_cfg_r[7:0];
+                spi_desc_cfg_r[15:8]  <= #UDLY spi_pstrb[1] ? spi_pwdata[15:8]  : spi_desc_cfg_r[15:8];
+                spi_desc_cfg_r[18:16] <= #UDLY spi_pstrb[2] ? spi_pwdata[18:16] : spi_desc_cfg_r[18:16];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            spi_desc_addr_r <= 32'b0;
+        end
+        else begin
+            if (spi_desc_addr_wr) begin
+                spi_desc_addr_r[7:0]   <= #UDLY spi_pstrb[0] ? spi_pwdata[7:0]   : spi_desc_addr_r[7:0];
+                spi_desc_addr_r[15:8]  <= #UDLY spi_pstrb[1] ? spi_pwdata[15:8]  : spi_desc_addr_r[15:8];
+                spi_desc_addr_r[23:16] <= #UDLY spi_pstrb[2] ? spi_pwdata[23:16] : spi_desc_addr_r[23:16];
+                spi_desc_addr_r[31:24] <= #UDLY spi_pstrb[3] ? spi_pwdata[31:24] : spi_desc_addr_r[31:24];
+            end
+        end
+    end
+
+    // Keep the length for transfers triggered by events.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            spi_desc_len_r <= 24'b0;
+        end
+        else begin
+            if (spi_desc_len_wr) begin
+                spi_desc_len_r <= #UDLY spi_pwdata[23:0];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            spi_dma_cfg_r <= 24'b0;
+        end
+        else begin
+            if (spi_dma_cfg_wr) begin
+                spi_dma_cfg_r[7:0]   <= #UDLY spi_pstrb[0] ? spi_pwdata[7:0]   : spi_dma_cfg_r[7:0];
+                spi_dma_cfg_r[15:8]  <= #UDLY spi_pstrb[1] ? spi_pwdata[15:8]  : spi_dma_cfg_r[15:8];
+                spi_dma_cfg_r[23:16] <= #UDLY spi_pstrb[2] ? spi_pwdata[23:16] : spi_dma_cfg_r[23:16];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            tx_dma_hold_r <= 6'd0;
+            rx_dma_hold_r <= 6'd0;
+        end
+        else begin
+            if (tx_dma_ack) begin
+                tx_dma_hold_r <= #UDLY DMA_HOLD;
+            end
+            else if (|tx_dma_hold_r) begin
+                tx_dma_hold_r <= #UDLY tx_dma_hold_r - 1'b1;
+            end
+
+            if (rx_dma_ack) begin
+                rx_dma_hold_r <= #UDLY DMA_HOLD;
+            end
+            else if (|rx_dma_hold_r) begin
+                rx_dma_hold_r <= #UDLY rx_dma_hold_r - 1'b1;
             end
         end
     end
@@ -313,10 +495,14 @@ module uv_spi_reg
             spi_rxq_cap_rd   : rsp_data = RXQ_DP[DLEN-1:0];
             spi_rxq_len_rd   : rsp_data = {{(DLEN-RXQ_AW-1){1'b0}}, rxq_len};
             spi_rxq_dat_rd   : rsp_data = {{(DLEN-32){1'b0}}, rx_deq_dat};
-            spi_ie_rd        : rsp_data = {{(DLEN-2){1'b0}}, spi_rx_ie_r, spi_tx_ie_r};
-            spi_ip_rd        : rsp_data = {{(DLEN-2){1'b0}}, spi_rx_ip, spi_tx_ip};
+            spi_ie_rd        : rsp_data = {{(DLEN-3){1'b0}}, spi_done_ie_r, spi_rx_ie_r, spi_tx_ie_r};
+            spi_ip_rd        : rsp_data = {{(DLEN-3){1'b0}}, spi_done_ip_r, spi_rx_ip, spi_tx_ip};
             spi_tx_irq_th_rd : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, spi_tx_irq_th_r};
-            spi_rx_irq_th_rd : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, spi_rx_irq_th_r};
+            spi_rx_irq_th_rd : rsp_data = {{(DLEN-RXQ_AW-1){1'b0}}, spi_rx_irq_th_r};
+            spi_desc_cfg_rd  : rsp_data = {{(DLEN-19){1'b0}}, spi_desc_cfg_r};
+            spi_desc_addr_rd : rsp_data = {{(DLEN-32){1'b0}}, spi_desc_addr_r};
+            spi_desc_len_rd  : rsp_data = {{(DLEN-32){1'b0}}, desc_busy, 7'b0, desc_left};
+            spi_dma_cfg_rd   : rsp_data = {{(DLEN-24){1'b0}}, spi_dma_cfg_r};
             default          : rsp_data = {DLEN{1'b0}};
         endcase
     end
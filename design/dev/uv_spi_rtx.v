@@ -6,7 +6,9 @@
 // Designer: Owen
 //
 // Description:
-//      RX & TX with serial SPI ports.
+//      RX & TX with serial SPI ports. CS is kept asserted
+//      over idle when TRAN_HOLD is high, so that a transfer
+//      can be restarted with other frame bits.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -36,6 +38,10 @@ module uv_spi_rtx
     input  [15:0]                   clk_div,
     input                           endian,
 
+    // Transfer control.
+    input                           tran_hold,
+    output                          tran_idle,
+
     // TX data from TXQ.
     input                           tx_rdy,
     output                          tx_vld,
@@ -104,6 +110,7 @@ module uv_spi_rtx
     assign state_cool               = cur_state == FSM_SPI_COOL;
 
     assign tran_rdy                 = tx_rdy & rx_rdy;
+    assign tran_idle                = state_idle;
     assign tran_cont                = state_tran & tran_rdy & sck_cnt_end;
 
     // Counter status.
@@ -289,10 +296,10 @@ module uv_spi_rtx
         end
         else begin
             if (state_idle) begin
-                spi_cs_r <= #UDLY tran_rdy ? ~def_idle : def_idle;
+                spi_cs_r <= #UDLY (tran_rdy | tran_hold) ? ~def_idle : def_idle;
             end
             else if (state_cool & dly_cnt_end & div_cnt_end) begin
-                spi_cs_r <= #UDLY def_idle;
+                spi_cs_r <= #UDLY tran_hold ? ~def_idle : def_idle;
             end
         end
     end
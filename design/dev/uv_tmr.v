@@ -6,7 +6,7 @@
 // Designer: Owen
 //
 // Description:
-//      General-purpose Timer.
+//      General-purpose Timer, with PWM & input capture.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -15,7 +15,10 @@ module uv_tmr
 #(
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
-    parameter MLEN                  = DLEN / 8
+    parameter MLEN                  = DLEN / 8,
+    parameter PWM_CH                = 4,
+    parameter CAP_CH                = 2,
+    parameter CAP_AW                = 3
 )
 (
     input                           clk,
@@ -37,10 +40,23 @@ module uv_tmr
     output [DLEN-1:0]               tmr_rsp_data,
 
     output                          tmr_irq,
-    output                          tmr_evt
+    output                          tmr_evt,
+
+    output [PWM_CH*2-1:0]           pwm_oe,
+    output [PWM_CH*2-1:0]           pwm_out,
+    output [CAP_CH-1:0]             cap_ie,
+    input  [CAP_CH-1:0]             cap_in,
+    output                          pwm_irq,
+
+    input                           tmr_task_start,
+    input                           tmr_task_stop,
+    input                           pwm_task_start,
+    input                           pwm_task_stop,
+    output                          pwm_evt
 );
 
     localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b0;
 
     wire                            tmr_psel;
     wire                            tmr_penable;
@@ -58,7 +74,8 @@ module uv_tmr
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .PIPE                       ( BUS_PIPE              )
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
     )
     u_bus_to_apb
     (
@@ -95,7 +112,10 @@ module uv_tmr
     #(
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
-        .MLEN                       ( MLEN                  )
+        .MLEN                       ( MLEN                  ),
+        .PWM_CH                     ( PWM_CH                ),
+        .CAP_CH                     ( CAP_CH                ),
+        .CAP_AW                     ( CAP_AW                )
     )
     u_tmr_apb
     (
@@ -119,7 +139,20 @@ module uv_tmr
 
         // TMR control & status.
         .tmr_irq                    ( tmr_irq               ),
-        .tmr_evt                    ( tmr_evt               )
+        .tmr_evt                    ( tmr_evt               ),
+
+        // PWM & capture.
+        .pwm_oe                     ( pwm_oe                ),
+        .pwm_out                    ( pwm_out               ),
+        .cap_ie                     ( cap_ie                ),
+        .cap_in                     ( cap_in                ),
+        .pwm_irq                    ( pwm_irq               ),
+
+        .tmr_task_start             ( tmr_task_start        ),
+        .tmr_task_stop              ( tmr_task_stop         ),
+        .pwm_task_start             ( pwm_task_start        ),
+        .pwm_task_stop              ( pwm_task_stop         ),
+        .pwm_evt                    ( pwm_evt               )
     );
 
 endmodule
@@ -6,7 +6,10 @@
 // Designer: Owen
 //
 // Description:
-//      General-purpose Timer with APB bus interface.
+//      General-purpose Timer with APB bus interface, with
+//      PWM channels & input capture channels at sys clock.
+//      Timer & PWM are also started or stopped by tasks from
+//      the event router.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -15,7 +18,11 @@ module uv_tmr_apb
 #(
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
-    parameter MLEN                  = DLEN / 8
+    parameter MLEN                  = DLEN / 8,
+    parameter HAS_PWM               = 1'b1, // PWM & capture registers.
+    parameter PWM_CH                = 4,    // Up to 4.
+    parameter CAP_CH                = 2,    // Up to 4.
+    parameter CAP_AW                = 3     // Up to 3.
 )
 (
     input                           clk,
@@ -38,7 +45,24 @@ module uv_tmr_apb
 
     // TMR control & status.
     output                          tmr_irq,
-    output                          tmr_evt
+    output                          tmr_evt,
+
+    // PWM outputs, with P of channel n in [2n] & N in [2n+1].
+    output [PWM_CH*2-1:0]           pwm_oe,
+    output [PWM_CH*2-1:0]           pwm_out,
+
+    // Capture inputs.
+    output [CAP_CH-1:0]             cap_ie,
+    input  [CAP_CH-1:0]             cap_in,
+
+    output                          pwm_irq,
+
+    // Tasks & events of event router.
+    input                           tmr_task_start,
+    input                           tmr_task_stop,
+    input                           pwm_task_start,
+    input                           pwm_task_stop,
+    output                          pwm_evt
 );
 
     localparam UDLY                 = 1;
@@ -50,6 +74,22 @@ module uv_tmr_apb
     localparam REG_TMR_VAL          = 1;
     localparam REG_TMR_CMP          = 2;
     localparam REG_TMR_CLR          = 3;
+    localparam REG_PWM_CFG          = 16;
+    localparam REG_PWM_PRD          = 17;
+    localparam REG_PWM_CNT          = 18;
+    localparam REG_PWM_OUT          = 19;
+    localparam REG_PWM_DUTY_START   = 20;
+    localparam REG_PWM_DUTY_END     = REG_PWM_DUTY_START + 3;
+    localparam REG_CAP_CFG          = 24;
+    localparam REG_CAP_STA          = 25;
+    localparam REG_CAP_DAT_START    = 26;
+    localparam REG_CAP_DAT_END      = REG_CAP_DAT_START + 3;
+    localparam REG_PWM_IE           = 30;
+    localparam REG_PWM_IP           = 31;
+
+    localparam PWM_CNT_WIDTH        = 16;
+    localparam CAP_LEN_WIDTH        = CAP_AW + 1;
+    genvar i;
 
     wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
 
@@ -87,21 +127,86 @@ module uv_tmr_apb
     reg                             tmr_cnt_en_p;
     wire                            tmr_cnt_en_rise;
 
+    // PWM & capture at sys clock domain.
+    reg                             pwm_en_r;
+    reg                             pwm_center_r;
+    reg                             pwm_upd_r;
+    reg  [7:0]                      pwm_dead_r;
+    reg  [15:0]                     pwm_clk_div_r;
+    reg  [15:0]                     pwm_prd_r;
+    reg  [7:0]                      pwm_oe_r;
+    reg  [7:0]                      pwm_pol_r;
+    reg  [15:0]                     pwm_duty_r [0:PWM_CH-1];
+    reg  [7:0]                      cap_edge_r;
+    reg  [7:0]                      cap_th_r;
+    reg  [2:0]                      pwm_ie_r;
+    reg                             pwm_prd_ip_r;
+
+    wire [PWM_CH*PWM_CNT_WIDTH-1:0] pwm_duty;
+    wire                            pwm_upd_ack;
+    wire [PWM_CNT_WIDTH-1:0]        pwm_cnt;
+    wire                            pwm_dir;
+    wire                            pwm_prd_end;
+    wire [PWM_CH-1:0]               pwm_p;
+    wire [PWM_CH-1:0]               pwm_n;
+    wire [7:0]                      pwm_act;
+
+    wire [CAP_CH-1:0]               cap_pop;
+    wire [CAP_CH-1:0]               cap_clr;
+    wire [CAP_CH-1:0]               cap_ovf_clr;
+    wire [CAP_CH*32-1:0]            cap_dat;
+    wire [CAP_CH*CAP_LEN_WIDTH-1:0] cap_len;
+    wire [CAP_CH-1:0]               cap_ovf;
+    wire [CAP_CH-1:0]               cap_over_th;
+    wire [31:0]                     cap_sta;
+    wire [2:0]                      pwm_ip;
+
     // Decoding.
     wire                            tmr_cfg_match;
     wire                            tmr_val_match;
     wire                            tmr_cmp_match;
     wire                            tmr_clr_match;
+    wire                            pwm_cfg_match;
+    wire                            pwm_prd_match;
+    wire                            pwm_cnt_match;
+    wire                            pwm_out_match;
+    wire                            pwm_duty_match;
+    wire                            cap_cfg_match;
+    wire                            cap_sta_match;
+    wire                            cap_dat_match;
+    wire                            pwm_ie_match;
+    wire                            pwm_ip_match;
     wire                            addr_mismatch;
 
+    wire [ADDR_DEC_WIDTH-1:0]       pwm_duty_idx;
+    wire [ADDR_DEC_WIDTH-1:0]       cap_dat_idx;
+
     wire                            tmr_cfg_wr;
     wire                            tmr_val_wr;
     wire                            tmr_cmp_wr;
     wire                            tmr_clr_wr;
+    wire                            pwm_cfg_wr;
+    wire                            pwm_prd_wr;
+    wire                            pwm_out_wr;
+    wire                            pwm_duty_wr;
+    wire                            cap_cfg_wr;
+    wire                            cap_sta_wr;
+    wire                            pwm_ie_wr;
+    wire                            pwm_ip_wr;
 
     wire                            tmr_cfg_rd;
     wire                            tmr_val_rd;
     wire                            tmr_cmp_rd;
+    wire                            pwm_cfg_rd;
+    wire                            pwm_prd_rd;
+    wire                            pwm_cnt_rd;
+    wire                            pwm_out_rd;
+    wire                            pwm_duty_rd;
+    wire                            cap_cfg_rd;
+    wire                            cap_sta_rd;
+    wire                            cap_dat_rd;
+    wire                            pwm_ie_rd;
+    wire                            pwm_ip_rd;
 
     reg                             rsp_vld_r;
     reg                             rsp_excp_r;
@@ -114,16 +219,54 @@ module uv_tmr_apb
     assign tmr_val_match            = dec_addr == REG_TMR_VAL[ADDR_DEC_WIDTH-1:0];
     assign tmr_cmp_match            = dec_addr == REG_TMR_CMP[ADDR_DEC_WIDTH-1:0];
     assign tmr_clr_match            = dec_addr == REG_TMR_CLR[ADDR_DEC_WIDTH-1:0];
-    assign addr_mismatch            = dec_addr >  REG_TMR_CLR[ADDR_DEC_WIDTH-1:0];
+    assign pwm_cfg_match            = HAS_PWM && (dec_addr == REG_PWM_CFG[ADDR_DEC_WIDTH-1:0]);
+    assign pwm_prd_match            = HAS_PWM && (dec_addr == REG_PWM_PRD[ADDR_DEC_WIDTH-1:0]);
+    assign pwm_cnt_match            = HAS_PWM && (dec_addr == REG_PWM_CNT[ADDR_DEC_WIDTH-1:0]);
+    assign pwm_out_match            = HAS_PWM && (dec_addr == REG_PWM_OUT[ADDR_DEC_WIDTH-1:0]);
+    assign pwm_duty_match           =  HAS_PWM
+                                    && (dec_addr >= REG_PWM_DUTY_START[ADDR_DEC_WIDTH-1:0])
+                                    && (dec_addr <= REG_PWM_DUTY_END  [ADDR_DEC_WIDTH-1:0]);
+    assign cap_cfg_match            = HAS_PWM && (dec_addr == REG_CAP_CFG[ADDR_DEC_WIDTH-1:0]);
+    assign cap_sta_match            = HAS_PWM && (dec_addr == REG_CAP_STA[ADDR_DEC_WIDTH-1:0]);
+    assign cap_dat_match            =  HAS_PWM
+                                    && (dec_addr >= REG_CAP_DAT_START[ADDR_DEC_WIDTH-1:0])
+                                    && (dec_addr <= REG_CAP_DAT_END  [ADDR_DEC_WIDTH-1:0]);
+    assign pwm_ie_match             = HAS_PWM && (dec_addr == REG_PWM_IE [ADDR_DEC_WIDTH-1:0]);
+    assign pwm_ip_match             = HAS_PWM && (dec_addr == REG_PWM_IP [ADDR_DEC_WIDTH-1:0]);
+    assign addr_mismatch            = HAS_PWM
+                                    ? (  ((dec_addr > REG_TMR_CLR[ADDR_DEC_WIDTH-1:0]) && (dec_addr < REG_PWM_CFG[ADDR_DEC_WIDTH-1:0]))
+                                      || (dec_addr > REG_PWM_IP[ADDR_DEC_WIDTH-1:0]))
+                                    : dec_addr > REG_TMR_CLR[ADDR_DEC_WIDTH-1:0];
+
+    assign pwm_duty_idx             = dec_addr - REG_PWM_DUTY_START[ADDR_DEC_WIDTH-1:0];
+    assign cap_dat_idx              = dec_addr - REG_CAP_DAT_START [ADDR_DEC_WIDTH-1:0];
 
     assign tmr_cfg_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & tmr_cfg_match;
     assign tmr_val_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & tmr_val_match;
     assign tmr_cmp_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & tmr_cmp_match;
     assign tmr_clr_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & tmr_clr_match;
+    assign pwm_cfg_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & pwm_cfg_match;
+    assign pwm_prd_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & pwm_prd_match;
+    assign pwm_out_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & pwm_out_match;
+    assign pwm_duty_wr              = tmr_psel & (~tmr_penable) & tmr_pwrite & pwm_duty_match;
+    assign cap_cfg_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & cap_cfg_match;
+    assign cap_sta_wr               = tmr_psel & (~tmr_penable) & tmr_pwrite & cap_sta_match;
+    assign pwm_ie_wr                = tmr_psel & (~tmr_penable) & tmr_pwrite & pwm_ie_match;
+    assign pwm_ip_wr                = tmr_psel & (~tmr_penable) & tmr_pwrite & pwm_ip_match;
 
     assign tmr_cfg_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & tmr_cfg_match;
     assign tmr_val_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & tmr_val_match;
     assign tmr_cmp_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & tmr_cmp_match;
+    assign pwm_cfg_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_cfg_match;
+    assign pwm_prd_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_prd_match;
+    assign pwm_cnt_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_cnt_match;
+    assign pwm_out_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_out_match;
+    assign pwm_duty_rd              = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_duty_match;
+    assign cap_cfg_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & cap_cfg_match;
+    assign cap_sta_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & cap_sta_match;
+    assign cap_dat_rd               = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & cap_dat_match;
+    assign pwm_ie_rd                = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_ie_match;
+    assign pwm_ip_rd                = tmr_psel & (~tmr_penable) & (~tmr_pwrite) & pwm_ip_match;
 
     assign tmr_val_add              = tmr_val_r + 1'b1;
     assign tmr_val_to_limit         = tmr_cnt_en_sync && tmr_div_to_limit && (tmr_val_add >= tmr_cmp_sync);
@@ -136,6 +279,49 @@ module uv_tmr_apb
     assign tmr_irq                  = tmr_val_at_limit_sync & (~tmr_evt_en_r);
     assign tmr_evt                  = tmr_val_at_limit_sync & tmr_evt_en_r;
 
+    // PWM outputs with polarity.
+    generate
+        for (i = 0; i < 4; i = i + 1) begin: gen_pwm_act
+            if (i < PWM_CH) begin: gen_pwm_act_vld
+                assign pwm_act[i*2]   = pwm_p[i];
+                assign pwm_act[i*2+1] = pwm_n[i];
+                assign pwm_duty[i*PWM_CNT_WIDTH+:PWM_CNT_WIDTH] = pwm_duty_r[i];
+            end
+            else begin: gen_pwm_act_pad
+                assign pwm_act[i*2+1:i*2] = 2'b0;
+            end
+        end
+    endgenerate
+
+    assign pwm_oe                   = pwm_oe_r[PWM_CH*2-1:0];
+    assign pwm_out                  = pwm_act[PWM_CH*2-1:0] ^ pwm_pol_r[PWM_CH*2-1:0];
+
+    // Capture status, with FIFO lengths in [4n+3:4n] & overflow in [16+n].
+    generate
+        for (i = 0; i < 4; i = i + 1) begin: gen_cap_sta
+            if (i < CAP_CH) begin: gen_cap_sta_vld
+                assign cap_ie[i]      = |cap_edge_r[i*2+1:i*2];
+                assign cap_pop[i]     = cap_dat_rd & (cap_dat_idx == i);
+                assign cap_clr[i]     = cap_sta_wr & tmr_pstrb[3] & tmr_pwdata[24+i];
+                assign cap_ovf_clr[i] = cap_sta_wr & tmr_pstrb[2] & tmr_pwdata[16+i];
+                assign cap_over_th[i] = cap_ie[i] & (cap_len[i*CAP_LEN_WIDTH+:CAP_LEN_WIDTH] > cap_th_r);
+                assign cap_sta[i*4+3:i*4] = {{(4-CAP_LEN_WIDTH){1'b0}}, cap_len[i*CAP_LEN_WIDTH+:CAP_LEN_WIDTH]};
+                assign cap_sta[16+i]  = cap_ovf[i];
+            end
+            else begin: gen_cap_sta_pad
+                assign cap_sta[i*4+3:i*4] = 4'b0;
+                assign cap_sta[16+i]  = 1'b0;
+            end
+        end
+    endgenerate
+
+    assign cap_sta[31:20]           = 12'b0;
+
+    // IRQ of PWM period end, capture FIFOs over threshold & capture overflow.
+    assign pwm_ip                   = {(|cap_ovf), (|cap_over_th), pwm_prd_ip_r};
+    assign pwm_irq                  = |(pwm_ip & pwm_ie_r);
+    assign pwm_evt                  = pwm_prd_end;
+
     // Bus response.
     assign tmr_prdata               = rsp_data_r;
     assign tmr_pready               = rsp_vld_r;
@@ -157,6 +343,11 @@ module uv_tmr_apb
                 tmr_clk_div_r[7:0]  <= #UDLY tmr_pstrb[2] ? tmr_pwdata[23:16] : tmr_clk_div_r[7:0];
                 tmr_clk_div_r[15:8] <= #UDLY tmr_pstrb[3] ? tmr_pwdata[31:24] : tmr_clk_div_r[15:8];
             end
+
+            // Tasks override bus write.
+            if (tmr_task_start | tmr_task_stop) begin
+                tmr_cnt_en_r        <= #UDLY tmr_task_start;
+            end
         end
     end
 
@@ -188,6 +379,124 @@ module uv_tmr_apb
         end
     end
 
+    // Write PWM registers from bus.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pwm_en_r      <= 1'b0;
+            pwm_center_r  <= 1'b0;
+            pwm_dead_r    <= 8'b0;
+            pwm_clk_div_r <= 16'b0;
+        end
+        else begin
+            if (pwm_cfg_wr) begin
+                pwm_en_r            <= #UDLY tmr_pstrb[0] ? tmr_pwdata[0]     : pwm_en_r;
+                pwm_center_r        <= #UDLY tmr_pstrb[0] ? tmr_pwdata[1]     : pwm_center_r;
+                pwm_dead_r          <= #UDLY tmr_pstrb[1] ? tmr_pwdata[15:8]  : pwm_dead_r;
+                pwm_clk_div_r[7:0]  <= #UDLY tmr_pstrb[2] ? tmr_pwdata[23:16] : pwm_clk_div_r[7:0];
+                pwm_clk_div_r[15:8] <= #UDLY tmr_pstrb[3] ? tmr_pwdata[31:24] : pwm_clk_div_r[15:8];
+            end
+
+            if (pwm_task_start | pwm_task_stop) begin
+                pwm_en_r            <= #UDLY pwm_task_start;
+            end
+        end
+    end
+
+    // Request to load shadow registers at the end of period, cleared when done.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pwm_upd_r <= 1'b0;
+        end
+        else begin
+            if (pwm_cfg_wr & tmr_pstrb[0] & tmr_pwdata[2]) begin
+                pwm_upd_r <= #UDLY 1'b1;
+            end
+            else if (pwm_upd_ack) begin
+                pwm_upd_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pwm_prd_r <= 16'b0;
+        end
+        else begin
+            if (pwm_prd_wr) begin
+                pwm_prd_r[7:0]  <= #UDLY tmr_pstrb[0] ? tmr_pwdata[7:0]  : pwm_prd_r[7:0];
+                pwm_prd_r[15:8] <= #UDLY tmr_pstrb[1] ? tmr_pwdata[15:8] : pwm_prd_r[15:8];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pwm_oe_r  <= 8'b0;
+            pwm_pol_r <= 8'b0;
+        end
+        else begin
+            if (pwm_out_wr) begin
+                pwm_oe_r  <= #UDLY tmr_pstrb[0] ? tmr_pwdata[7:0]  : pwm_oe_r;
+                pwm_pol_r <= #UDLY tmr_pstrb[1] ? tmr_pwdata[15:8] : pwm_pol_r;
+            end
+        end
+    end
+
+    generate
+        for (i = 0; i < PWM_CH; i = i + 1) begin: gen_pwm_duty
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    pwm_duty_r[i] <= 16'b0;
+                end
+                else begin
+                    if (pwm_duty_wr && (pwm_duty_idx == i)) begin
+                        pwm_duty_r[i][7:0]  <= #UDLY tmr_pstrb[0] ? tmr_pwdata[7:0]  : pwm_duty_r[i][7:0];
+                        pwm_duty_r[i][15:8] <= #UDLY tmr_pstrb[1] ? tmr_pwdata[15:8] : pwm_duty_r[i][15:8];
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cap_edge_r <= 8'b0;
+            cap_th_r   <= 8'b0;
+        end
+        else begin
+            if (cap_cfg_wr) begin
+                cap_edge_r <= #UDLY tmr_pstrb[0] ? tmr_pwdata[7:0]   : cap_edge_r;
+                cap_th_r   <= #UDLY tmr_pstrb[2] ? tmr_pwdata[23:16] : cap_th_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pwm_ie_r <= 3'b0;
+        end
+        else begin
+            if (pwm_ie_wr) begin
+                pwm_ie_r <= #UDLY tmr_pstrb[0] ? tmr_pwdata[2:0] : pwm_ie_r;
+            end
+        end
+    end
+
+    // Period IRQ is cleared by writing 1.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pwm_prd_ip_r <= 1'b0;
+        end
+        else begin
+            if (pwm_prd_end) begin
+                pwm_prd_ip_r <= #UDLY 1'b1;
+            end
+            else if (pwm_ip_wr & tmr_pstrb[0] & tmr_pwdata[0]) begin
+                pwm_prd_ip_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
     // Update timer value.
     always @(posedge low_clk or negedge rst_n) begin
         if (~rst_n) begin
@@ -248,6 +557,16 @@ module uv_tmr_apb
             tmr_cfg_rd : rsp_data = {{(DLEN-32){1'b0}}, tmr_clk_div_r, 13'b0, tmr_evt_en_r, tmr_clr_en_r, tmr_cnt_en_r};
             tmr_val_rd : rsp_data = {{(DLEN-32){1'b0}}, tmr_val_sync};
             tmr_cmp_rd : rsp_data = {{(DLEN-32){1'b0}}, tmr_cmp_r};
+            pwm_cfg_rd : rsp_data = {{(DLEN-32){1'b0}}, pwm_clk_div_r, pwm_dead_r, 5'b0, pwm_upd_r, pwm_center_r, pwm_en_r};
+            pwm_prd_rd : rsp_data = {{(DLEN-16){1'b0}}, pwm_prd_r};
+            pwm_cnt_rd : rsp_data = {{(DLEN-17){1'b0}}, pwm_dir, pwm_cnt};
+            pwm_out_rd : rsp_data = {{(DLEN-16){1'b0}}, pwm_pol_r, pwm_oe_r};
+            pwm_duty_rd: rsp_data = pwm_duty_idx < PWM_CH ? {{(DLEN-16){1'b0}}, pwm_duty_r[pwm_duty_idx]} : {DLEN{1'b0}};
+            cap_cfg_rd : rsp_data = {{(DLEN-24){1'b0}}, cap_th_r, 8'b0, cap_edge_r};
+            cap_sta_rd : rsp_data = {{(DLEN-32){1'b0}}, cap_sta};
+            cap_dat_rd : rsp_data = cap_dat_idx < CAP_CH ? {{(DLEN-32){1'b0}}, cap_dat[cap_dat_idx*32+:32]} : {DLEN{1'b0}};
+            pwm_ie_rd  : rsp_data = {{(DLEN-3){1'b0}}, pwm_ie_r};
+            pwm_ip_rd  : rsp_data = {{(DLEN-3){1'b0}}, pwm_ip};
             default    : rsp_data = {DLEN{1'b0}};
         endcase
     end
@@ -291,6 +610,56 @@ module uv_tmr_apb
         end
     end
 
+    uv_tmr_pwm
+    #(
+        .PWM_CH                 ( PWM_CH                ),
+        .CNT_WIDTH              ( PWM_CNT_WIDTH         ),
+        .DT_WIDTH               ( 8                     )
+    )
+    u_tmr_pwm
+    (
+        .clk                    ( clk                   ),
+        .rst_n                  ( rst_n                 ),
+
+        .pwm_en                 ( pwm_en_r              ),
+        .pwm_center             ( pwm_center_r          ),
+        .pwm_clk_div            ( pwm_clk_div_r         ),
+        .pwm_dead               ( pwm_dead_r            ),
+
+        .pwm_prd                ( pwm_prd_r             ),
+        .pwm_duty               ( pwm_duty              ),
+        .pwm_upd                ( pwm_upd_r             ),
+        .pwm_upd_ack            ( pwm_upd_ack           ),
+
+        .pwm_cnt                ( pwm_cnt               ),
+        .pwm_dir                ( pwm_dir               ),
+        .pwm_prd_end            ( pwm_prd_end           ),
+
+        .pwm_p                  ( pwm_p                 ),
+        .pwm_n                  ( pwm_n                 )
+    );
+
+    uv_tmr_cap
+    #(
+        .CAP_CH                 ( CAP_CH                ),
+        .CAP_AW                 ( CAP_AW                )
+    )
+    u_tmr_cap
+    (
+        .clk                    ( clk                   ),
+        .rst_n                  ( rst_n                 ),
+
+        .cap_in                 ( cap_in                ),
+        .cap_edge               ( cap_edge_r[CAP_CH*2-1:0] ),
+
+        .cap_pop                ( cap_pop               ),
+        .cap_clr                ( cap_clr               ),
+        .cap_ovf_clr            ( cap_ovf_clr           ),
+        .cap_dat                ( cap_dat               ),
+        .cap_len                ( cap_len               ),
+        .cap_ovf                ( cap_ovf               )
+    );
+
     // Synchronization cross clock domain.
     // LOW -> SYS
     uv_sync
@@ -0,0 +1,140 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_tmr_cap
+//
+// Designer: Owen
+//
+// Description:
+//      Input capture channels. Each input is synchronized, and
+//      its selected edges push the level after the edge in
+//      [31] & a free-running cycle timestamp in [30:0] to the
+//      FIFO of the channel, which is popped by bus reads. An
+//      edge to a full FIFO is dropped & flagged as overflow.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_tmr_cap
+#(
+    parameter CAP_CH                = 2,
+    parameter CAP_AW                = 3
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Inputs & edge selection, with rising in [2n] & falling in [2n+1].
+    input  [CAP_CH-1:0]             cap_in,
+    input  [CAP_CH*2-1:0]           cap_edge,
+
+    // FIFO control & status.
+    input  [CAP_CH-1:0]             cap_pop,
+    input  [CAP_CH-1:0]             cap_clr,
+    input  [CAP_CH-1:0]             cap_ovf_clr,
+    output [CAP_CH*32-1:0]          cap_dat,
+    output [CAP_CH*(CAP_AW+1)-1:0]  cap_len,
+    output [CAP_CH-1:0]             cap_ovf
+);
+
+    localparam UDLY                 = 1;
+    localparam SYNC_STAGE           = 2;
+    genvar i;
+
+    reg  [30:0]                     ts_r;
+    reg  [CAP_CH-1:0]               in_p;
+    reg  [CAP_CH-1:0]               ovf_r;
+
+    wire [CAP_CH-1:0]               in_sync;
+    wire [CAP_CH-1:0]               in_rise;
+    wire [CAP_CH-1:0]               in_fall;
+    wire [CAP_CH-1:0]               enq_vld;
+    wire [CAP_CH-1:0]               que_full;
+
+    assign in_rise                  = in_sync & (~in_p);
+    assign in_fall                  = (~in_sync) & in_p;
+    assign cap_ovf                  = ovf_r;
+
+    // Free-running timestamp.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ts_r <= 31'b0;
+        end
+        else begin
+            ts_r <= #UDLY ts_r + 1'b1;
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            in_p <= {CAP_CH{1'b0}};
+        end
+        else begin
+            in_p <= #UDLY in_sync;
+        end
+    end
+
+    generate
+        for (i = 0; i < CAP_CH; i = i + 1) begin: gen_cap_ch
+            assign enq_vld[i]       = (in_rise[i] & cap_edge[i*2]) | (in_fall[i] & cap_edge[i*2+1]);
+
+            // Flag edges dropped by full FIFO.
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ovf_r[i] <= 1'b0;
+                end
+                else begin
+                    if (enq_vld[i] & que_full[i]) begin
+                        ovf_r[i] <= #UDLY 1'b1;
+                    end
+                    else if (cap_ovf_clr[i]) begin
+                        ovf_r[i] <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            uv_queue
+            #(
+                .DAT_WIDTH                  ( 32                        ),
+                .PTR_WIDTH                  ( CAP_AW                    ),
+                .QUE_DEPTH                  ( 2**CAP_AW                 ),
+                .ZERO_RDLY                  ( 1'b1                      )
+            )
+            u_que
+            (
+                .clk                        ( clk                       ),
+                .rst_n                      ( rst_n                     ),
+
+                // Write channel.
+                .wr_rdy                     (                           ),
+                .wr_vld                     ( enq_vld[i]                ),
+                .wr_dat                     ( {in_sync[i], ts_r}        ),
+
+                // Read channel.
+                .rd_rdy                     (                           ),
+                .rd_vld                     ( cap_pop[i]                ),
+                .rd_dat                     ( cap_dat[i*32+:32]         ),
+
+                // Control & status.
+                .clr                        ( cap_clr[i]                ),
+                .len                        ( cap_len[i*(CAP_AW+1)+:CAP_AW+1] ),
+                .full                       ( que_full[i]               ),
+                .empty                      (                           )
+            );
+        end
+    endgenerate
+
+    uv_sync
+    #(
+        .SYNC_WIDTH             ( CAP_CH                ),
+        .SYNC_STAGE             ( SYNC_STAGE            )
+    )
+    u_cap_in_sync
+    (
+        .clk                    ( clk                   ),
+        .rst_n                  ( rst_n                 ),
+        .in                     ( cap_in                ),
+        .out                    ( in_sync               )
+    );
+
+endmodule
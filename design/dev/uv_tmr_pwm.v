@@ -0,0 +1,198 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_tmr_pwm
+//
+// Designer: Owen
+//
+// Description:
+//      PWM generator with complementary outputs. A counter
+//      at the prescaled clock runs 0 ~ period-1 & wraps in
+//      edge-aligned mode, or up & down in center-aligned mode,
+//      and a channel is active while the counter is below its
+//      duty. Period & duties are loaded from the shadow ones
+//      at the end of a period when an update is requested, or
+//      at any time while stopped. Both outputs of a channel
+//      are inactive for the dead time after each edge.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_tmr_pwm
+#(
+    parameter PWM_CH                = 4,
+    parameter CNT_WIDTH             = 16,
+    parameter DT_WIDTH              = 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Configuration.
+    input                           pwm_en,
+    input                           pwm_center,
+    input  [15:0]                   pwm_clk_div,
+    input  [DT_WIDTH-1:0]           pwm_dead,
+
+    // Shadow period & duties.
+    input  [CNT_WIDTH-1:0]          pwm_prd,
+    input  [PWM_CH*CNT_WIDTH-1:0]   pwm_duty,
+    input                           pwm_upd,
+    output                          pwm_upd_ack,
+
+    // Status.
+    output [CNT_WIDTH-1:0]          pwm_cnt,
+    output                          pwm_dir,
+    output                          pwm_prd_end,
+
+    // Outputs, high as active.
+    output [PWM_CH-1:0]             pwm_p,
+    output [PWM_CH-1:0]             pwm_n
+);
+
+    localparam UDLY                 = 1;
+    genvar i;
+
+    reg                             run_r;
+    reg  [15:0]                     div_r;
+    reg  [CNT_WIDTH-1:0]            cnt_r;
+    reg                             dir_r;
+    reg  [CNT_WIDTH-1:0]            prd_act_r;
+    reg  [CNT_WIDTH-1:0]            duty_act_r [0:PWM_CH-1];
+    reg  [PWM_CH-1:0]               ref_r;
+    reg  [DT_WIDTH-1:0]             dt_r [0:PWM_CH-1];
+
+    wire                            tick;
+    wire [CNT_WIDTH:0]              cnt_add;
+    wire                            cnt_top;
+    wire                            prd_end;
+    wire                            act_load;
+    wire [PWM_CH-1:0]               ref;
+
+    assign tick                     = run_r & (div_r == pwm_clk_div);
+    assign cnt_add                  = {1'b0, cnt_r} + 1'b1;
+    assign cnt_top                  = cnt_add >= {1'b0, prd_act_r};
+
+    // A period ends by wrapping in edge-aligned mode, or at the bottom in center-aligned mode.
+    assign prd_end                  = tick & (pwm_center ? (dir_r & (cnt_r == {CNT_WIDTH{1'b0}})) : cnt_top);
+    assign act_load                 = (~run_r) | (prd_end & pwm_upd);
+
+    assign pwm_upd_ack              = act_load & pwm_upd;
+    assign pwm_cnt                  = cnt_r;
+    assign pwm_dir                  = dir_r;
+    assign pwm_prd_end              = prd_end;
+
+    // Start from the bottom when enabled.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            run_r <= 1'b0;
+        end
+        else begin
+            run_r <= #UDLY pwm_en;
+        end
+    end
+
+    // Prescaler.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            div_r <= 16'b0;
+        end
+        else begin
+            if ((~run_r) | tick) begin
+                div_r <= #UDLY 16'b0;
+            end
+            else begin
+                div_r <= #UDLY div_r + 1'b1;
+            end
+        end
+    end
+
+    // Counter, holding a tick at the top & bottom in center-aligned mode.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cnt_r <= {CNT_WIDTH{1'b0}};
+            dir_r <= 1'b0;
+        end
+        else begin
+            if (~run_r) begin
+                cnt_r <= #UDLY {CNT_WIDTH{1'b0}};
+                dir_r <= #UDLY 1'b0;
+            end
+            else if (tick & pwm_center) begin
+                if (~dir_r) begin
+                    if (cnt_top) begin
+                        dir_r <= #UDLY 1'b1;
+                    end
+                    else begin
+                        cnt_r <= #UDLY cnt_add[CNT_WIDTH-1:0];
+                    end
+                end
+                else begin
+                    if (cnt_r == {CNT_WIDTH{1'b0}}) begin
+                        dir_r <= #UDLY 1'b0;
+                    end
+                    else begin
+                        cnt_r <= #UDLY cnt_r - 1'b1;
+                    end
+                end
+            end
+            else if (tick) begin
+                cnt_r <= #UDLY cnt_top ? {CNT_WIDTH{1'b0}} : cnt_add[CNT_WIDTH-1:0];
+            end
+        end
+    end
+
+    // Load period from shadow.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            prd_act_r <= {CNT_WIDTH{1'b0}};
+        end
+        else begin
+            if (act_load) begin
+                prd_act_r <= #UDLY pwm_prd;
+            end
+        end
+    end
+
+    generate
+        for (i = 0; i < PWM_CH; i = i + 1) begin: gen_pwm_ch
+            assign ref[i]           = run_r & (cnt_r < duty_act_r[i]);
+            assign pwm_p[i]         = ref_r[i] & (dt_r[i] == {DT_WIDTH{1'b0}});
+            assign pwm_n[i]         = run_r & (~ref_r[i]) & (dt_r[i] == {DT_WIDTH{1'b0}});
+
+            // Load duty from shadow.
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    duty_act_r[i] <= {CNT_WIDTH{1'b0}};
+                end
+                else begin
+                    if (act_load) begin
+                        duty_act_r[i] <= #UDLY pwm_duty[i*CNT_WIDTH+:CNT_WIDTH];
+                    end
+                end
+            end
+
+            // Insert dead time after each edge of reference.
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    ref_r[i] <= 1'b0;
+                    dt_r[i]  <= {DT_WIDTH{1'b0}};
+                end
+                else begin
+                    if (~run_r) begin
+                        ref_r[i] <= #UDLY 1'b0;
+                        dt_r[i]  <= #UDLY {DT_WIDTH{1'b0}};
+                    end
+                    else if (ref[i] ^ ref_r[i]) begin
+                        ref_r[i] <= #UDLY ref[i];
+                        dt_r[i]  <= #UDLY pwm_dead;
+                    end
+                    else if (dt_r[i] != {DT_WIDTH{1'b0}}) begin
+                        dt_r[i]  <= #UDLY dt_r[i] - 1'b1;
+                    end
+                end
+            end
+        end
+    endgenerate
+
+endmodule
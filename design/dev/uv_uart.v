@@ -16,9 +16,9 @@ module uv_uart
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter TXQ_AW                = 3,
+    parameter TXQ_AW                = 8,
     parameter TXQ_DP                = 2**TXQ_AW,
-    parameter RXQ_AW                = 3,
+    parameter RXQ_AW                = 8,
     parameter RXQ_DP                = 2**RXQ_AW
 )
 (
@@ -40,10 +40,16 @@ module uv_uart
     input                           uart_rx,
     output                          uart_tx,
 
-    output                          uart_irq
+    output                          uart_irq,
+
+    output                          uart_tx_dma_req,
+    input                           uart_tx_dma_ack,
+    output                          uart_rx_dma_req,
+    input                           uart_rx_dma_ack
 );
 
     localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
 
     wire                            uart_psel;
     wire                            uart_penable;
@@ -61,7 +67,8 @@ module uv_uart
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .PIPE                       ( BUS_PIPE              )
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
     )
     u_bus_to_apb
     (
@@ -126,7 +133,12 @@ module uv_uart
         .uart_rx                    ( uart_rx               ),
 
         // Interrupt request.
-        .uart_irq                   ( uart_irq              )
+        .uart_irq                   ( uart_irq              ),
+
+        .uart_tx_dma_req            ( uart_tx_dma_req       ),
+        .uart_tx_dma_ack            ( uart_tx_dma_ack       ),
+        .uart_rx_dma_req            ( uart_rx_dma_req       ),
+        .uart_rx_dma_ack            ( uart_rx_dma_ack       )
     );
 
 endmodule
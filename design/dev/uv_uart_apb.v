@@ -6,7 +6,7 @@
 // Designer: Owen
 //
 // Description:
-//      UART with APB interface.
+//      UART with APB interface. TXQ & RXQ are in SRAM.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,9 +16,9 @@ module uv_uart_apb
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter TXQ_AW                = 3,
+    parameter TXQ_AW                = 8,
     parameter TXQ_DP                = 2**TXQ_AW,
-    parameter RXQ_AW                = 3,
+    parameter RXQ_AW                = 8,
     parameter RXQ_DP                = 2**RXQ_AW
 )
 (
@@ -42,7 +42,13 @@ module uv_uart_apb
     input                           uart_rx,
 
     // Interrupt request.
-    output                          uart_irq
+    output                          uart_irq,
+
+    // DMA handshakes.
+    output                          uart_tx_dma_req,
+    input                           uart_tx_dma_ack,
+    output                          uart_rx_dma_req,
+    input                           uart_rx_dma_ack
 );
 
     wire                            tx_en;
@@ -51,8 +57,12 @@ module uv_uart_apb
     wire                            nstop;
     wire                            endian;
     wire   [15:0]                   clk_div;
+    wire   [7:0]                    div_frac;
+    wire   [1:0]                    osr_sel;
     wire                            parity_en;
     wire   [1:0]                    parity_type;
+    wire   [7:0]                    rx_tmo;
+    wire                            rx_tmo_evt;
 
     wire                            txq_clr;
     wire                            rxq_clr;
@@ -89,6 +99,8 @@ module uv_uart_apb
         .nstop                      ( nstop             ),
         .endian                     ( endian            ),
         .clk_div                    ( clk_div           ),
+        .div_frac                   ( div_frac          ),
+        .osr_sel                    ( osr_sel           ),
         .parity_en                  ( parity_en         ),
         .parity_type                ( parity_type       ),
 
@@ -111,13 +123,19 @@ module uv_uart_apb
         .nbits                      ( nbits             ),
         .endian                     ( endian            ),
         .clk_div                    ( clk_div           ),
+        .div_frac                   ( div_frac          ),
+        .osr_sel                    ( osr_sel           ),
         .parity_en                  ( parity_en         ),
         .parity_type                ( parity_type       ),
+        .rx_tmo                     ( rx_tmo            ),
 
         // RX data to RXQ.
         .rx_rdy                     ( rx_enq_rdy        ),
         .rx_vld                     ( rx_enq_vld        ),
-        .rx_dat                     ( rx_enq_dat        )
+        .rx_dat                     ( rx_enq_dat        ),
+
+        // Idle line timeout.
+        .rx_tmo_evt                 ( rx_tmo_evt        )
     );
 
     uv_uart_reg
@@ -154,10 +172,19 @@ module uv_uart_apb
         .nstop                      ( nstop             ),
         .endian                     ( endian            ),
         .clk_div                    ( clk_div           ),
+        .div_frac                   ( div_frac          ),
+        .osr_sel                    ( osr_sel           ),
         .parity_en                  ( parity_en         ),
         .parity_type                ( parity_type       ),
+        .rx_tmo                     ( rx_tmo            ),
+        .rx_tmo_evt                 ( rx_tmo_evt        ),
         .uart_irq                   ( uart_irq          ),
 
+        .tx_dma_req                 ( uart_tx_dma_req   ),
+        .tx_dma_ack                 ( uart_tx_dma_ack   ),
+        .rx_dma_req                 ( uart_rx_dma_req   ),
+        .rx_dma_ack                 ( uart_rx_dma_ack   ),
+
         .tx_enq_vld                 ( tx_enq_vld        ),
         .tx_enq_dat                 ( tx_enq_dat        ),
         .rx_deq_vld                 ( rx_deq_vld        ),
@@ -169,12 +196,11 @@ module uv_uart_apb
         .rxq_len                    ( rxq_len           )
     );
 
-    uv_queue
+    uv_sram_queue
     #(
         .DAT_WIDTH                  ( 8                 ),
         .PTR_WIDTH                  ( TXQ_AW            ),
-        .QUE_DEPTH                  ( TXQ_DP            ),
-        .ZERO_RDLY                  ( 1'b1              )
+        .QUE_DEPTH                  ( TXQ_DP            )
     )
     u_uart_txq
     (
@@ -198,12 +224,11 @@ module uv_uart_apb
         .empty                      (                   )
     );
 
-    uv_queue
+    uv_sram_queue
     #(
         .DAT_WIDTH                  ( 8                 ),
         .PTR_WIDTH                  ( RXQ_AW            ),
-        .QUE_DEPTH                  ( RXQ_DP            ),
-        .ZERO_RDLY                  ( 1'b1              )
+        .QUE_DEPTH                  ( RXQ_DP            )
     )
     u_uart_rxq
     (
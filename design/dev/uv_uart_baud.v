@@ -0,0 +1,95 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_uart_baud
+//
+// Designer: Owen
+//
+// Description:
+//      Fractional baud generator of UART. A bit lasts CLK_DIV
+//      + DIV_FRAC/256 cycles, and is divided into 16, 8 or 4
+//      sample ticks by OSR_SEL 0, 1 or 2. Ticks come from a
+//      phase accumulator, so the fraction is kept over bits
+//      with 1 cycle of jitter at most. The bit timing restarts
+//      when EN is low, as if SKEW cycles have passed, and a
+//      bit should last 2 cycles per tick at least.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_uart_baud
+#(
+    parameter SKEW                  = 0
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           en,
+    input  [15:0]                   clk_div,
+    input  [7:0]                    div_frac,
+    input  [1:0]                    osr_sel,
+
+    output                          smp_tick,
+    output [3:0]                    smp_idx,
+    output                          bit_mid,
+    output                          bit_end
+);
+
+    localparam UDLY                 = 1;
+
+    reg    [24:0]                   acc_r;
+    reg    [3:0]                    smp_idx_r;
+
+    wire   [24:0]                   acc_mod;
+    wire   [24:0]                   acc_inc;
+    wire   [24:0]                   acc_add;
+    wire   [24:0]                   acc_skew;
+    wire   [24:0]                   acc_init;
+    wire   [3:0]                    smp_max;
+
+    // A bit is CLK_DIV.DIV_FRAC cycles in 1/256, and a cycle adds 256 per tick of the bit.
+    assign acc_mod                  = {1'b0, clk_div, div_frac};
+    assign acc_inc                  = osr_sel == 2'd1 ? 25'd2048 : osr_sel == 2'd2 ? 25'd1024 : 25'd4096;
+    assign acc_add                  = acc_r + acc_inc;
+    assign acc_skew                 = acc_inc * SKEW;
+    assign acc_init                 = acc_skew < acc_mod ? acc_skew : acc_mod - 1'b1;
+    assign smp_max                  = osr_sel == 2'd1 ? 4'd7 : osr_sel == 2'd2 ? 4'd3 : 4'd15;
+
+    assign smp_tick                 = en & (acc_add >= acc_mod);
+    assign smp_idx                  = smp_idx_r;
+    assign bit_mid                  = smp_tick & (smp_idx_r == {1'b0, smp_max[3:1]});
+    assign bit_end                  = smp_tick & (smp_idx_r == smp_max);
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            acc_r <= 25'd0;
+        end
+        else begin
+            if (~en) begin
+                acc_r <= #UDLY acc_init;
+            end
+            else if (smp_tick) begin
+                acc_r <= #UDLY acc_add - acc_mod;
+            end
+            else begin
+                acc_r <= #UDLY acc_add;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            smp_idx_r <= 4'd0;
+        end
+        else begin
+            if (~en) begin
+                smp_idx_r <= #UDLY 4'd0;
+            end
+            else if (smp_tick) begin
+                smp_idx_r <= #UDLY bit_end ? 4'd0 : smp_idx_r + 1'b1;
+            end
+        end
+    end
+
+endmodule
@@ -6,7 +6,19 @@
 // Designer: Owen
 //
 // Description:
-//      UART register access by bus.
+//      UART register access by bus. A write to TXQ_WDAT pushes
+//      the bytes of its strobes from the low lane, and a read
+//      of RXQ_WDAT pops up to 4 bytes into the low lanes, one
+//      byte per cycle before PREADY. Pushes to a full TXQ wait
+//      for room before PREADY. TXQ_FREE is the room of TXQ.
+//      DMA requests are raised when TXQ has TX_DMA_TH free
+//      bytes, or RXQ has RX_DMA_TH bytes, besides those of the
+//      bursts acknowledged but not pushed or popped yet, so the
+//      posted writes of a burst are not requested again.
+//      BAUD_CFG has the fraction of CLK_DIV, the oversampling
+//      of RX, and the RX timeout in bit times, whose interrupt
+//      is pending since the line idles with RXQ not empty, till
+//      RXQ is drained.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,9 +28,9 @@ module uv_uart_reg
     parameter ALEN                  = 12,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter TXQ_AW                = 3,
+    parameter TXQ_AW                = 8,
     parameter TXQ_DP                = 2**TXQ_AW,
-    parameter RXQ_AW                = 3,
+    parameter RXQ_AW                = 8,
     parameter RXQ_DP                = 2**RXQ_AW
 )
 (
@@ -44,10 +56,20 @@ module uv_uart_reg
     output                          nstop,
     output                          endian,
     output [15:0]                   clk_div,
+    output [7:0]                    div_frac,
+    output [1:0]                    osr_sel,
     output                          parity_en,
     output [1:0]                    parity_type,
+    output [7:0]                    rx_tmo,
+    input                           rx_tmo_evt,
     output                          uart_irq,
 
+    // DMA handshakes.
+    output                          tx_dma_req,
+    input                           tx_dma_ack,
+    output                          rx_dma_req,
+    input                           rx_dma_ack,
+
     output                          tx_enq_vld,
     output [7:0]                    tx_enq_dat,
     output                          rx_deq_vld,
@@ -75,17 +97,54 @@ module uv_uart_reg
     localparam REG_UART_IP          = 10;
     localparam REG_UART_TX_IRQ_TH   = 11;
     localparam REG_UART_RX_IRQ_TH   = 12;
-    localparam REG_ADDR_MAX         = 12;
+    localparam REG_UART_TXQ_FREE    = 13;
+    localparam REG_UART_TXQ_WDAT    = 14;
+    localparam REG_UART_RXQ_WDAT    = 15;
+    localparam REG_UART_DMA_CFG     = 16;
+    localparam REG_UART_BAUD_CFG    = 17;
+    localparam REG_ADDR_MAX         = 17;
+
+    localparam DMA_QUE_AW           = TXQ_AW > RXQ_AW ? TXQ_AW : RXQ_AW;
+    localparam DMA_OST_W            = (DMA_QUE_AW > 8 ? DMA_QUE_AW : 8) + 2;   // Signed, for a queue & a threshold.
+    localparam DMA_OST_MIN          = {1'b1, {(DMA_OST_W-1){1'b0}}};
 
     wire [ADDR_DEC_WIDTH-1:0]       dec_addr;
 
     reg  [31:0]                     uart_glb_cfg_r;
     reg                             uart_tx_ie_r;
     reg                             uart_rx_ie_r;
+    reg                             uart_tmo_ie_r;
     wire                            uart_tx_ip;
     wire                            uart_rx_ip;
+    reg                             uart_tmo_ip_r;
     reg  [TXQ_AW:0]                 uart_tx_irq_th_r;
     reg  [RXQ_AW:0]                 uart_rx_irq_th_r;
+    reg  [23:0]                     uart_dma_cfg_r;
+    reg  [23:0]                     uart_baud_cfg_r;
+    reg  [DMA_OST_W-1:0]            tx_dma_ost_r;
+    reg  [DMA_OST_W-1:0]            rx_dma_ost_r;
+    wire [DMA_OST_W:0]              tx_dma_lvl;
+    wire [DMA_OST_W:0]              rx_dma_lvl;
+    wire [TXQ_AW:0]                 txq_free;
+    wire                            txq_full;
+    wire                            tx_dma_en;
+    wire                            rx_dma_en;
+    wire [7:0]                      tx_dma_th;
+    wire [7:0]                      rx_dma_th;
+
+    // Byte sequencer of data registers.
+    reg  [3:0]                      seq_msk_r;
+    reg                             seq_rd_r;
+    reg  [31:0]                     seq_dat_r;
+    wire [3:0]                      seq_rd_msk;
+    wire [3:0]                      seq_new_msk;
+    wire [3:0]                      seq_oh;
+    wire [3:0]                      seq_msk_nxt;
+    wire [7:0]                      seq_byte;
+    wire                            seq_start;
+    wire                            seq_act;
+    wire                            seq_stall;
+    wire                            seq_last;
 
     wire                            uart_glb_cfg_match;
     wire                            uart_txq_cap_match;
@@ -100,6 +159,11 @@ module uv_uart_reg
     wire                            uart_ip_match;
     wire                            uart_tx_irq_th_match;
     wire                            uart_rx_irq_th_match;
+    wire                            uart_txq_free_match;
+    wire                            uart_txq_wdat_match;
+    wire                            uart_rxq_wdat_match;
+    wire                            uart_dma_cfg_match;
+    wire                            uart_baud_cfg_match;
     wire                            addr_mismatch;
 
     wire                            uart_glb_cfg_wr;
@@ -109,6 +173,9 @@ module uv_uart_reg
     wire                            uart_ie_wr;
     wire                            uart_tx_irq_th_wr;
     wire                            uart_rx_irq_th_wr;
+    wire                            uart_txq_wdat_wr;
+    wire                            uart_dma_cfg_wr;
+    wire                            uart_baud_cfg_wr;
 
     wire                            uart_glb_cfg_rd;
     wire                            uart_txq_cap_rd;
@@ -120,6 +187,10 @@ module uv_uart_reg
     wire                            uart_ip_rd;
     wire                            uart_tx_irq_th_rd;
     wire                            uart_rx_irq_th_rd;
+    wire                            uart_txq_free_rd;
+    wire                            uart_rxq_wdat_rd;
+    wire                            uart_dma_cfg_rd;
+    wire                            uart_baud_cfg_rd;
 
     reg                             rsp_vld_r;
     reg                             rsp_excp_r;
@@ -141,15 +212,23 @@ module uv_uart_reg
     assign uart_ip_match            = dec_addr == REG_UART_IP[ADDR_DEC_WIDTH-1:0];
     assign uart_tx_irq_th_match     = dec_addr == REG_UART_TX_IRQ_TH[ADDR_DEC_WIDTH-1:0];
     assign uart_rx_irq_th_match     = dec_addr == REG_UART_RX_IRQ_TH[ADDR_DEC_WIDTH-1:0];
+    assign uart_txq_free_match      = dec_addr == REG_UART_TXQ_FREE[ADDR_DEC_WIDTH-1:0];
+    assign uart_txq_wdat_match      = dec_addr == REG_UART_TXQ_WDAT[ADDR_DEC_WIDTH-1:0];
+    assign uart_rxq_wdat_match      = dec_addr == REG_UART_RXQ_WDAT[ADDR_DEC_WIDTH-1:0];
+    assign uart_dma_cfg_match       = dec_addr == REG_UART_DMA_CFG[ADDR_DEC_WIDTH-1:0];
+    assign uart_baud_cfg_match      = dec_addr == REG_UART_BAUD_CFG[ADDR_DEC_WIDTH-1:0];
     assign addr_mismatch            = dec_addr >  REG_ADDR_MAX[ADDR_DEC_WIDTH-1:0];
 
     assign uart_glb_cfg_wr          = uart_psel & (~uart_penable) & uart_pwrite & uart_glb_cfg_match;
     assign uart_txq_clr_wr          = uart_psel & (~uart_penable) & uart_pwrite & uart_txq_clr_match;
     assign uart_txq_dat_wr          = uart_psel & (~uart_penable) & uart_pwrite & uart_txq_dat_match;
-    assign uart_rxq_clr_wr          = uart_psel & (~uart_penable) & uart_pwrite & uart_txq_clr_match;
+    assign uart_rxq_clr_wr          = uart_psel & (~uart_penable) & uart_pwrite & uart_rxq_clr_match;
     assign uart_ie_wr               = uart_psel & (~uart_penable) & uart_pwrite & uart_ie_match;
     assign uart_tx_irq_th_wr        = uart_psel & (~uart_penable) & uart_pwrite & uart_tx_irq_th_match;
     assign uart_rx_irq_th_wr        = uart_psel & (~uart_penable) & uart_pwrite & uart_rx_irq_th_match;
+    assign uart_txq_wdat_wr         = uart_psel & (~uart_penable) & uart_pwrite & uart_txq_wdat_match;
+    assign uart_dma_cfg_wr          = uart_psel & (~uart_penable) & uart_pwrite & uart_dma_cfg_match;
+    assign uart_baud_cfg_wr         = uart_psel & (~uart_penable) & uart_pwrite & uart_baud_cfg_match;
 
     assign uart_glb_cfg_rd          = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_glb_cfg_match;
     assign uart_txq_cap_rd          = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_txq_cap_match;
@@ -161,6 +240,10 @@ module uv_uart_reg
     assign uart_ip_rd               = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_ip_match;
     assign uart_tx_irq_th_rd        = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_tx_irq_th_match;
     assign uart_rx_irq_th_rd        = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_rx_irq_th_match;
+    assign uart_txq_free_rd         = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_txq_free_match;
+    assign uart_rxq_wdat_rd         = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_rxq_wdat_match;
+    assign uart_dma_cfg_rd          = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_dma_cfg_match;
+    assign uart_baud_cfg_rd         = uart_psel & (~uart_penable) & (~uart_pwrite) & uart_baud_cfg_match;
 
     // Bus response.
     assign uart_prdata              = rsp_data_r;
@@ -176,19 +259,54 @@ module uv_uart_reg
     assign parity_en                = uart_glb_cfg_r[7];
     assign parity_type              = uart_glb_cfg_r[9:8];
     assign clk_div                  = uart_glb_cfg_r[31:16];
+    assign div_frac                 = uart_baud_cfg_r[7:0];
+    assign osr_sel                  = uart_baud_cfg_r[9:8];
+    assign rx_tmo                   = uart_baud_cfg_r[23:16];
 
     assign txq_clr                  = uart_txq_clr_wr;
     assign rxq_clr                  = uart_rxq_clr_wr;
 
-    // Output data.
-    assign tx_enq_vld               = uart_txq_dat_wr;
-    assign tx_enq_dat               = uart_pwdata[7:0];
-    assign rx_deq_vld               = uart_rxq_dat_rd;
+    // Data registers: TXQ_DAT is pushed at SETUP unless TXQ is full, and the others
+    // go by the sequencer, which stalls on pushes to a full TXQ.
+    assign txq_full                 = txq_len == TXQ_DP[TXQ_AW:0];
+    assign seq_rd_msk               = uart_rxq_dat_rd  ? {3'b0, |rxq_len}
+                                    : ~uart_rxq_wdat_rd ? 4'h0
+                                    : rxq_len >= 4 ? 4'hf : rxq_len == 3 ? 4'h7
+                                    : rxq_len == 2 ? 4'h3 : rxq_len == 1 ? 4'h1 : 4'h0;
+    assign seq_new_msk              = uart_txq_wdat_wr ? uart_pstrb[3:0]
+                                    : uart_txq_dat_wr ? {3'b0, txq_full}
+                                    : seq_rd_msk;
+    assign seq_start                = |seq_new_msk;
+    assign seq_act                  = |seq_msk_r;
+    assign seq_stall                = seq_act & (~seq_rd_r) & txq_full;
+    assign seq_oh                   = seq_msk_r & (~(seq_msk_r - 1'b1));
+    assign seq_msk_nxt              = seq_msk_r & (~seq_oh);
+    assign seq_last                 = seq_act & (~seq_stall) & (~(|seq_msk_nxt));
+    assign seq_byte                 = ({8{seq_oh[0]}} & seq_dat_r[7:0])
+                                    | ({8{seq_oh[1]}} & seq_dat_r[15:8])
+                                    | ({8{seq_oh[2]}} & seq_dat_r[23:16])
+                                    | ({8{seq_oh[3]}} & seq_dat_r[31:24]);
+
+    assign tx_enq_vld               = (uart_txq_dat_wr | (seq_act & (~seq_rd_r))) & (~txq_full);
+    assign tx_enq_dat               = seq_act ? seq_byte : uart_pwdata[7:0];
+    assign rx_deq_vld               = seq_act & seq_rd_r;
+
+    // DMA requests.
+    assign txq_free                 = TXQ_DP[TXQ_AW:0] - txq_len;
+    assign tx_dma_en                = uart_dma_cfg_r[0];
+    assign rx_dma_en                = uart_dma_cfg_r[1];
+    assign tx_dma_th                = uart_dma_cfg_r[15:8];
+    assign rx_dma_th                = uart_dma_cfg_r[23:16];
+    assign tx_dma_lvl               = {{(DMA_OST_W-TXQ_AW){1'b0}}, txq_free} - {tx_dma_ost_r[DMA_OST_W-1], tx_dma_ost_r};
+    assign rx_dma_lvl               = {{(DMA_OST_W-RXQ_AW){1'b0}}, rxq_len} - {rx_dma_ost_r[DMA_OST_W-1], rx_dma_ost_r};
+    assign tx_dma_req               = tx_dma_en & (~tx_dma_lvl[DMA_OST_W]) & (tx_dma_lvl >= {{(DMA_OST_W-7){1'b0}}, tx_dma_th});
+    assign rx_dma_req               = rx_dma_en & (~rx_dma_lvl[DMA_OST_W]) & (rx_dma_lvl >= {{(DMA_OST_W-7){1'b0}}, rx_dma_th});
 
     // Interrupt.
     assign uart_tx_ip               = txq_len <= uart_tx_irq_th_r;
     assign uart_rx_ip               = rxq_len >= uart_rx_irq_th_r;
-    assign uart_irq                 = (uart_rx_ip & uart_rx_ie_r) | (uart_tx_ip & uart_tx_ie_r);
+    assign uart_irq                 = (uart_rx_ip & uart_rx_ie_r) | (uart_tx_ip & uart_tx_ie_r)
+                                    | (uart_tmo_ip_r & uart_tmo_ie_r);
 
     // Write registers from bus.
     always @(posedge clk or negedge rst_n) begin
@@ -207,13 +325,29 @@ module uv_uart_reg
 
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            uart_tx_ie_r <= 1'b0;
-            uart_rx_ie_r <= 1'b0;
+            uart_tx_ie_r  <= 1'b0;
+            uart_rx_ie_r  <= 1'b0;
+            uart_tmo_ie_r <= 1'b0;
         end
         else begin
             if (uart_ie_wr) begin
-                uart_tx_ie_r <= #UDLY uart_pstrb[0] ? uart_pwdata[0] : uart_tx_ie_r;
-                uart_rx_ie_r <= #UDLY uart_pstrb[0] ? uart_pwdata[1] : uart_rx_ie_r;
+                uart_tx_ie_r  <= #UDLY uart_pstrb[0] ? uart_pwdata[0] : uart_tx_ie_r;
+                uart_rx_ie_r  <= #UDLY uart_pstrb[0] ? uart_pwdata[1] : uart_rx_ie_r;
+                uart_tmo_ie_r <= #UDLY uart_pstrb[0] ? uart_pwdata[2] : uart_tmo_ie_r;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            uart_tmo_ip_r <= 1'b0;
+        end
+        else begin
+            if (rx_tmo_evt & (|rxq_len)) begin
+                uart_tmo_ip_r <= #UDLY 1'b1;
+            end
+            else if (~(|rxq_len)) begin
+                uart_tmo_ip_r <= #UDLY 1'b0;
             end
         end
     end
@@ -240,6 +374,79 @@ module uv_uart_reg
         end
     end
 
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            uart_dma_cfg_r <= 24'b0;
+        end
+        else begin
+            if (uart_dma_cfg_wr) begin
+                uart_dma_cfg_r[7:0]   <= #UDLY uart_pstrb[0] ? uart_pwdata[7:0]   : uart_dma_cfg_r[7:0];
+                uart_dma_cfg_r[15:8]  <= #UDLY uart_pstrb[1] ? uart_pwdata[15:8]  : uart_dma_cfg_r[15:8];
+                uart_dma_cfg_r[23:16] <= #UDLY uart_pstrb[2] ? uart_pwdata[23:16] : uart_dma_cfg_r[23:16];
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            uart_baud_cfg_r <= 24'b0;
+        end
+        else begin
+            if (uart_baud_cfg_wr) begin
+                uart_baud_cfg_r[7:0]   <= #UDLY uart_pstrb[0] ? uart_pwdata[7:0]   : uart_baud_cfg_r[7:0];
+                uart_baud_cfg_r[15:8]  <= #UDLY uart_pstrb[1] ? {6'b0, uart_pwdata[9:8]} : uart_baud_cfg_r[15:8];
+                uart_baud_cfg_r[23:16] <= #UDLY uart_pstrb[2] ? uart_pwdata[23:16] : uart_baud_cfg_r[23:16];
+            end
+        end
+    end
+
+    // Count the bytes of acknowledged bursts, a threshold each, till pushed or popped.
+    // Those done before the ack make it negative for a while.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            tx_dma_ost_r <= {DMA_OST_W{1'b0}};
+            rx_dma_ost_r <= {DMA_OST_W{1'b0}};
+        end
+        else begin
+            if (~tx_dma_en) begin
+                tx_dma_ost_r <= #UDLY {DMA_OST_W{1'b0}};
+            end
+            else if (tx_dma_ack | tx_enq_vld) begin
+                tx_dma_ost_r <= #UDLY tx_dma_ost_r
+                              + (tx_dma_ack ? {{(DMA_OST_W-8){1'b0}}, tx_dma_th} : {DMA_OST_W{1'b0}})
+                              - (tx_enq_vld & (tx_dma_ost_r != DMA_OST_MIN) ? 1'b1 : 1'b0);
+            end
+
+            if (~rx_dma_en) begin
+                rx_dma_ost_r <= #UDLY {DMA_OST_W{1'b0}};
+            end
+            else if (rx_dma_ack | rx_deq_vld) begin
+                rx_dma_ost_r <= #UDLY rx_dma_ost_r
+                              + (rx_dma_ack ? {{(DMA_OST_W-8){1'b0}}, rx_dma_th} : {DMA_OST_W{1'b0}})
+                              - (rx_deq_vld & (rx_dma_ost_r != DMA_OST_MIN) ? 1'b1 : 1'b0);
+            end
+        end
+    end
+
+    // Push or pop a byte per cycle in the ACCESS phase.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            seq_msk_r <= 4'b0;
+            seq_rd_r  <= 1'b0;
+            seq_dat_r <= 32'b0;
+        end
+        else begin
+            if (uart_psel & (~uart_penable) & seq_start) begin
+                seq_msk_r <= #UDLY seq_new_msk;
+                seq_rd_r  <= #UDLY ~uart_pwrite;
+                seq_dat_r <= #UDLY uart_pwdata[31:0];
+            end
+            else if (seq_act & (~seq_stall)) begin
+                seq_msk_r <= #UDLY seq_msk_nxt;
+            end
+        end
+    end
+
     // Buffer bus response.
     always @(*) begin
         case (1'b1)
@@ -248,11 +455,13 @@ module uv_uart_reg
             uart_txq_len_rd   : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, txq_len};
             uart_rxq_cap_rd   : rsp_data = RXQ_DP[DLEN-1:0];
             uart_rxq_len_rd   : rsp_data = {{(DLEN-RXQ_AW-1){1'b0}}, rxq_len};
-            uart_rxq_dat_rd   : rsp_data = {{(DLEN-8){1'b0}}, rx_deq_dat};
-            uart_ie_rd        : rsp_data = {{(DLEN-2){1'b0}}, uart_rx_ie_r, uart_tx_ie_r};
-            uart_ip_rd        : rsp_data = {{(DLEN-2){1'b0}}, uart_rx_ip, uart_tx_ip};
+            uart_ie_rd        : rsp_data = {{(DLEN-3){1'b0}}, uart_tmo_ie_r, uart_rx_ie_r, uart_tx_ie_r};
+            uart_ip_rd        : rsp_data = {{(DLEN-3){1'b0}}, uart_tmo_ip_r, uart_rx_ip, uart_tx_ip};
             uart_tx_irq_th_rd : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, uart_tx_irq_th_r};
-            uart_rx_irq_th_rd : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, uart_rx_irq_th_r};
+            uart_rx_irq_th_rd : rsp_data = {{(DLEN-RXQ_AW-1){1'b0}}, uart_rx_irq_th_r};
+            uart_txq_free_rd  : rsp_data = {{(DLEN-TXQ_AW-1){1'b0}}, txq_free};
+            uart_dma_cfg_rd   : rsp_data = {{(DLEN-24){1'b0}}, uart_dma_cfg_r};
+            uart_baud_cfg_rd  : rsp_data = {{(DLEN-24){1'b0}}, uart_baud_cfg_r};
             default           : rsp_data = {DLEN{1'b0}};
         endcase
     end
@@ -265,6 +474,12 @@ module uv_uart_reg
             if (uart_psel & (~uart_penable)) begin
                 rsp_data_r <= #UDLY rsp_data;
             end
+            else if (rx_deq_vld) begin
+                rsp_data_r[7:0]   <= #UDLY seq_oh[0] ? rx_deq_dat : rsp_data_r[7:0];
+                rsp_data_r[15:8]  <= #UDLY seq_oh[1] ? rx_deq_dat : rsp_data_r[15:8];
+                rsp_data_r[23:16] <= #UDLY seq_oh[2] ? rx_deq_dat : rsp_data_r[23:16];
+                rsp_data_r[31:24] <= #UDLY seq_oh[3] ? rx_deq_dat : rsp_data_r[31:24];
+            end
         end
     end
 
@@ -274,6 +489,9 @@ module uv_uart_reg
         end
         else begin
             if (uart_psel & (~uart_penable)) begin
+                rsp_vld_r <= #UDLY ~seq_start;
+            end
+            else if (seq_last) begin
                 rsp_vld_r <= #UDLY 1'b1;
             end
             else begin
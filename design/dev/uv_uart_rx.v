@@ -6,7 +6,12 @@
 // Designer: Owen
 //
 // Description:
-//      UART receiver.
+//      UART receiver. The line is synchronized & sampled by
+//      16x, 8x or 4x ticks, and a bit is the majority of the
+//      3 samples around its middle. A start bit sampled high
+//      is dropped as noise. When RX_TMO is not 0, an event is
+//      raised after the line idles for RX_TMO bit times since
+//      the last frame.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -24,13 +29,19 @@ module uv_uart_rx
     input  [1:0]                    nbits,
     input                           endian,
     input  [15:0]                   clk_div,
+    input  [7:0]                    div_frac,
+    input  [1:0]                    osr_sel,
     input                           parity_en,
     input  [1:0]                    parity_type,
+    input  [7:0]                    rx_tmo,
 
     // Data.
     input                           rx_rdy,
     output                          rx_vld,
-    output [7:0]                    rx_dat
+    output [7:0]                    rx_dat,
+
+    // Idle line timeout.
+    output                          rx_tmo_evt
 );
 
     localparam UDLY = 1;
@@ -39,28 +50,40 @@ module uv_uart_rx
     localparam FSM_UART_RX_DATA     = 3'h2;
     localparam FSM_UART_RX_PARITY   = 3'h3;
     localparam FSM_UART_RX_STOP     = 3'h4;
-    
+
     genvar i;
 
     reg    [2:0]                    cur_state;
     reg    [2:0]                    nxt_state;
 
+    reg    [1:0]                    rx_sync_r;
     reg                             rx_vld_r;
     reg    [7:0]                    rx_dat_r;
     reg                             parity_res_r;
     reg                             parity_bit_r;
     reg                             parity_pass;
 
-    reg                             baud_en_r;
-    reg    [15:0]                   clk_cnt_r;
+    reg    [1:0]                    vote_r;
     reg    [3:0]                    bit_cnt_r;
+    reg                             idle_run_r;
+    reg    [7:0]                    idle_cnt_r;
+    reg                             rx_tmo_evt_r;
 
-    wire   [15:0]                   clk_cnt_add;
-    wire                            clk_cnt_end;
-    wire                            clk_cnt_half;
+    wire                            rx_line;
+    wire                            rx_start;
+    wire                            baud_en;
+    wire                            smp_tick;
+    wire   [3:0]                    smp_idx;
+    wire                            bit_mid;
+    wire                            bit_end;
+    wire   [2:0]                    smp_mid;
+    wire                            smp_vote;
+    wire                            smp_done;
+    wire                            bit_val;
 
     wire   [3:0]                    bit_cnt_add;
     wire                            bit_cnt_end;
+    wire   [7:0]                    idle_cnt_add;
 
     wire   [3:0]                    data_nbits;
     wire   [7:0]                    rx_dat_bit_rev;
@@ -68,21 +91,31 @@ module uv_uart_rx
     wire   [3:0]                    rx_dat_bit_sft;
     wire   [7:0]                    rx_dat_tran;
 
-    assign clk_cnt_add              = clk_cnt_r + 1'b1;
-    assign clk_cnt_end              = clk_cnt_add == clk_div;
-    assign clk_cnt_half             = clk_cnt_add == {1'b0, clk_div[15:1]};
+    assign rx_line                  = rx_sync_r[1];
+    assign rx_start                 = (cur_state == FSM_UART_RX_IDLE) & rx_en & (~rx_line);
+
+    // Keep the bit timing over the idle line for timeout, and restart it at a start bit.
+    assign baud_en                  = (cur_state != FSM_UART_RX_IDLE) | (idle_run_r & (~rx_start));
+
+    // Vote with the samples before & after the middle one.
+    assign smp_mid                  = osr_sel == 2'd1 ? 3'd3 : osr_sel == 2'd2 ? 3'd1 : 3'd7;
+    assign smp_vote                 = smp_tick & ((smp_idx + 1'b1) == {1'b0, smp_mid});
+    assign smp_done                 = smp_tick & (smp_idx == ({1'b0, smp_mid} + 1'b1));
+    assign bit_val                  = vote_r[1] | (vote_r[0] & rx_line);
 
     assign bit_cnt_add              = bit_cnt_r + 1'b1;
     assign bit_cnt_end              = bit_cnt_add == data_nbits;
+    assign idle_cnt_add             = idle_cnt_r + 1'b1;
 
     assign data_nbits               = {2'b0, nbits} + 4'd5;
 
     assign rx_vld                   = rx_vld_r;
     assign rx_dat                   = rx_dat_tran;
+    assign rx_tmo_evt               = rx_tmo_evt_r;
 
     // Handle RX endian.
     generate
-        for (i = 0; i < 8; i = i + 1) begin: gen_tx_dat_bit_rev
+        for (i = 0; i < 8; i = i + 1) begin: gen_rx_dat_bit_rev
             assign rx_dat_bit_rev[i] = rx_dat_r[7-i];
         end
     endgenerate
@@ -91,6 +124,37 @@ module uv_uart_rx
     assign rx_dat_vld_rev           = rx_dat_bit_rev >> rx_dat_bit_sft;
     assign rx_dat_tran              = endian ? rx_dat_vld_rev : rx_dat_r;
 
+    // Synchronize serial input, which is idle high.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rx_sync_r <= 2'b11;
+        end
+        else begin
+            rx_sync_r <= #UDLY {rx_sync_r[0], uart_rx};
+        end
+    end
+
+    // Baud generation, where the start edge is seen 2 cycles late.
+    uv_uart_baud
+    #(
+        .SKEW                       ( 2                 )
+    )
+    u_baud
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .en                         ( baud_en           ),
+        .clk_div                    ( clk_div           ),
+        .div_frac                   ( div_frac          ),
+        .osr_sel                    ( osr_sel           ),
+
+        .smp_tick                   ( smp_tick          ),
+        .smp_idx                    ( smp_idx           ),
+        .bit_mid                    ( bit_mid           ),
+        .bit_end                    ( bit_end           )
+    );
+
     // FSM.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
@@ -104,7 +168,7 @@ module uv_uart_rx
     always @(*) begin
         case (cur_state)
             FSM_UART_RX_IDLE  : begin
-                if (rx_en & (~uart_rx)) begin
+                if (rx_start) begin
                     nxt_state = FSM_UART_RX_START;
                 end
                 else begin
@@ -112,7 +176,10 @@ module uv_uart_rx
                 end
             end
             FSM_UART_RX_START : begin
-                if (clk_cnt_end) begin
+                if (smp_done & bit_val) begin
+                    nxt_state = FSM_UART_RX_IDLE;
+                end
+                else if (bit_end) begin
                     nxt_state = FSM_UART_RX_DATA;
                 end
                 else begin
@@ -120,7 +187,7 @@ module uv_uart_rx
                 end
             end
             FSM_UART_RX_DATA  : begin
-                if (bit_cnt_end & clk_cnt_end) begin
+                if (bit_cnt_end & bit_end) begin
                     nxt_state = parity_en ? FSM_UART_RX_PARITY : FSM_UART_RX_STOP;
                 end
                 else begin
@@ -128,7 +195,7 @@ module uv_uart_rx
                 end
             end
             FSM_UART_RX_PARITY: begin
-                if (clk_cnt_end) begin
+                if (bit_end) begin
                     nxt_state = FSM_UART_RX_STOP;
                 end
                 else begin
@@ -136,7 +203,8 @@ module uv_uart_rx
                 end
             end
             FSM_UART_RX_STOP  : begin
-                if (clk_cnt_end) begin
+                // Be ready for the next start bit from the middle of stop bit.
+                if (smp_done) begin
                     nxt_state = FSM_UART_RX_IDLE;
                 end
                 else begin
@@ -149,46 +217,17 @@ module uv_uart_rx
         endcase
     end
 
-    // Enable baud gen.
-    always @(posedge clk or negedge rst_n) begin
-        if (~rst_n) begin
-            baud_en_r <= 1'b0;
-        end
-        else begin
-            case (cur_state)
-                FSM_UART_RX_IDLE  : begin
-                    if (rx_en & (~uart_rx)) begin
-                        baud_en_r <= #UDLY 1'b1;
-                    end
-                    else begin
-                        baud_en_r <= #UDLY 1'b0;
-                    end
-                end
-                FSM_UART_RX_STOP  : begin
-                    if (clk_cnt_end) begin
-                        baud_en_r <= #UDLY 1'b0;
-                    end
-                end
-            endcase
-        end
-    end
-
-    // Baud generation.
+    // Count high samples before the middle of bit.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            clk_cnt_r <= 16'd1;
+            vote_r <= 2'd0;
         end
         else begin
-            if (baud_en_r) begin
-                if (clk_cnt_end) begin
-                    clk_cnt_r <= #UDLY 16'd0;
-                end
-                else begin
-                    clk_cnt_r <= #UDLY clk_cnt_add;
-                end
+            if (bit_end | rx_start) begin
+                vote_r <= #UDLY 2'd0;
             end
-            else begin
-                clk_cnt_r <= #UDLY 16'd1;
+            else if (smp_vote | bit_mid) begin
+                vote_r <= #UDLY vote_r + {1'b0, rx_line};
             end
         end
     end
@@ -201,12 +240,12 @@ module uv_uart_rx
         else begin
             case (cur_state)
                 FSM_UART_RX_START: begin
-                    if (clk_cnt_end) begin
+                    if (bit_end) begin
                         bit_cnt_r <= #UDLY 4'd0;
                     end
                 end
                 FSM_UART_RX_DATA: begin
-                    if (clk_cnt_end) begin
+                    if (bit_end) begin
                         bit_cnt_r <= #UDLY bit_cnt_add;
                     end
                 end
@@ -214,7 +253,7 @@ module uv_uart_rx
         end
     end
 
-    // Shift received data.
+    // Receive data bits, the first one at LSB.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             rx_dat_r <= 8'b0;
@@ -225,33 +264,26 @@ module uv_uart_rx
                     rx_dat_r <= #UDLY 8'b0;
                 end
                 FSM_UART_RX_DATA: begin
-                    if (clk_cnt_half) begin
-                        rx_dat_r <= #UDLY {rx_dat_r[6:0], uart_rx};
+                    if (smp_done) begin
+                        rx_dat_r[bit_cnt_r[2:0]] <= #UDLY bit_val;
                     end
                 end
             endcase
         end
     end
 
-    // Write received data.
+    // Write received data when stop bit is right.
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
             rx_vld_r <= 1'b0;
         end
         else begin
-            case (cur_state)
-                FSM_UART_RX_IDLE: begin
-                    rx_vld_r <= #UDLY 1'b0;
-                end
-                FSM_UART_RX_STOP: begin
-                    if (clk_cnt_end) begin
-                        rx_vld_r <= #UDLY parity_en ? parity_pass : 1'b1;
-                    end
-                end
-                default: begin
-                    rx_vld_r <= #UDLY 1'b0;
-                end
-            endcase
+            if ((cur_state == FSM_UART_RX_STOP) && smp_done) begin
+                rx_vld_r <= #UDLY bit_val & (parity_en ? parity_pass : 1'b1);
+            end
+            else begin
+                rx_vld_r <= #UDLY 1'b0;
+            end
         end
     end
 
@@ -264,8 +296,8 @@ module uv_uart_rx
             if (cur_state == FSM_UART_RX_START) begin
                 parity_res_r <= #UDLY 1'b0;
             end
-            else if ((cur_state == FSM_UART_RX_DATA) && clk_cnt_half && parity_en && parity_type[1]) begin
-                parity_res_r <= #UDLY parity_res_r ^ uart_rx;
+            else if ((cur_state == FSM_UART_RX_DATA) && smp_done && parity_en && parity_type[1]) begin
+                parity_res_r <= #UDLY parity_res_r ^ bit_val;
             end
         end
     end
@@ -279,8 +311,8 @@ module uv_uart_rx
             if (cur_state == FSM_UART_RX_START) begin
                 parity_bit_r <= #UDLY 1'b0;
             end
-            if ((cur_state == FSM_UART_RX_PARITY) && clk_cnt_half) begin
-                parity_bit_r <= #UDLY uart_rx;
+            if ((cur_state == FSM_UART_RX_PARITY) && smp_done) begin
+                parity_bit_r <= #UDLY bit_val;
             end
         end
     end
@@ -294,4 +326,34 @@ module uv_uart_rx
         endcase
     end
 
+    // Count idle bit times after a frame.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            idle_run_r <= 1'b0;
+            idle_cnt_r <= 8'd0;
+        end
+        else begin
+            if ((cur_state == FSM_UART_RX_STOP) && smp_done) begin
+                idle_run_r <= #UDLY |rx_tmo;
+                idle_cnt_r <= #UDLY 8'd0;
+            end
+            else if (rx_start | (~rx_en)) begin
+                idle_run_r <= #UDLY 1'b0;
+            end
+            else if (idle_run_r & bit_end) begin
+                idle_run_r <= #UDLY idle_cnt_add < rx_tmo;
+                idle_cnt_r <= #UDLY idle_cnt_add;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rx_tmo_evt_r <= 1'b0;
+        end
+        else begin
+            rx_tmo_evt_r <= #UDLY idle_run_r & bit_end & (idle_cnt_add >= rx_tmo);
+        end
+    end
+
 endmodule
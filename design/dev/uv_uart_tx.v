@@ -25,6 +25,8 @@ module uv_uart_tx
     input                           nstop,
     input                           endian,
     input  [15:0]                   clk_div,
+    input  [7:0]                    div_frac,
+    input  [1:0]                    osr_sel,
     input                           parity_en,
     input  [1:0]                    parity_type,
 
@@ -53,10 +55,8 @@ module uv_uart_tx
     reg                             parity_bit;
 
     reg                             baud_en_r;
-    reg    [15:0]                   clk_cnt_r;
     reg    [3:0]                    bit_cnt_r;
 
-    wire   [15:0]                   clk_cnt_add;
     wire                            clk_cnt_end;
     wire                            clk_cnt_half;
 
@@ -70,10 +70,6 @@ module uv_uart_tx
     wire   [7:0]                    tx_dat_tran;
     reg    [7:0]                    tx_dat_tran_r;
 
-    assign clk_cnt_add              = clk_cnt_r + 1'b1;
-    assign clk_cnt_end              = clk_cnt_add == clk_div;
-    assign clk_cnt_half             = clk_cnt_add == {1'b0, clk_div[15:1]};
-
     assign bit_cnt_add              = bit_cnt_r + 1'b1;
     assign bit_cnt_end              = bit_cnt_add == data_nbits;
 
@@ -190,24 +186,25 @@ module uv_uart_tx
     end
 
     // Baud generation.
-    always @(posedge clk or negedge rst_n) begin
-        if (~rst_n) begin
-            clk_cnt_r <= 16'd0;
-        end
-        else begin
-            if (baud_en_r) begin
-                if (clk_cnt_end) begin
-                    clk_cnt_r <= #UDLY 16'd0;
-                end
-                else begin
-                    clk_cnt_r <= #UDLY clk_cnt_add;
-                end
-            end
-            else begin
-                clk_cnt_r <= #UDLY 16'd0;
-            end
-        end
-    end
+    uv_uart_baud
+    #(
+        .SKEW                       ( 0                 )
+    )
+    u_baud
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .en                         ( baud_en_r         ),
+        .clk_div                    ( clk_div           ),
+        .div_frac                   ( div_frac          ),
+        .osr_sel                    ( osr_sel           ),
+
+        .smp_tick                   (                   ),
+        .smp_idx                    (                   ),
+        .bit_mid                    ( clk_cnt_half      ),
+        .bit_end                    ( clk_cnt_end       )
+    );
 
     // Update data bit counter.
     always @(posedge clk or negedge rst_n) begin
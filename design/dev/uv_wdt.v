@@ -41,6 +41,7 @@ module uv_wdt
 );
 
     localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b0;
 
     wire                            wdt_psel;
     wire                            wdt_penable;
@@ -58,7 +59,8 @@ module uv_wdt
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .PIPE                       ( BUS_PIPE              )
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
     )
     u_bus_to_apb
     (
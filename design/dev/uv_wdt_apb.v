@@ -54,7 +54,11 @@ module uv_wdt_apb
     #(
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( DLEN                  ),
-        .MLEN                       ( MLEN                  )
+        .MLEN                       ( MLEN                  ),
+        .HAS_PWM                    ( 1'b0                  ),
+        .PWM_CH                     ( 1                     ),
+        .CAP_CH                     ( 1                     ),
+        .CAP_AW                     ( 1                     )
     )
     u_tmr_apb
     (
@@ -78,7 +82,20 @@ module uv_wdt_apb
 
         // TMR control & status.
         .tmr_irq                    ( wdt_irq               ),
-        .tmr_evt                    ( tmr_evt               )
+        .tmr_evt                    ( tmr_evt               ),
+
+        // No PWM & capture.
+        .pwm_oe                     (                       ),
+        .pwm_out                    (                       ),
+        .cap_ie                     (                       ),
+        .cap_in                     ( 1'b0                  ),
+        .pwm_irq                    (                       ),
+
+        .tmr_task_start             ( 1'b0                  ),
+        .tmr_task_stop              ( 1'b0                  ),
+        .pwm_task_start             ( 1'b0                  ),
+        .pwm_task_stop              ( 1'b0                  ),
+        .pwm_evt                    (                       )
     );
 
 endmodule
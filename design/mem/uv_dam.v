@@ -7,6 +7,9 @@
 //
 // Description:
 //      Directly Accessed Memory.
+//      Banks are split on the address MSB, or interleaved on
+//      the word address so both ports rarely wait for each other.
+//      Atomic requests on port B are done as read-modify-write.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -16,7 +19,9 @@ module uv_dam
     parameter PORT_AW               = 10,
     parameter PORT_DW               = 32,
     parameter PORT_MW               = PORT_DW / 8,
-    parameter SRAM_DP               = 2**(PORT_AW - $clog2(PORT_MW))
+    parameter SRAM_DP               = 2**(PORT_AW - $clog2(PORT_MW)),
+    parameter BANK_NUM              = 2,    // 2 or 4, must be 2 without interleaving.
+    parameter BANK_ILV              = 1'b0  // Interleave banks on low word address bits.
 )
 (
     input                           clk,
@@ -37,6 +42,7 @@ module uv_dam
     output                          port_b_req_rdy,
     input                           port_b_req_read,
     input  [PORT_AW-1:0]            port_b_req_addr,
+    input  [3:0]                    port_b_req_amo,
     input  [PORT_MW-1:0]            port_b_req_mask,
     input  [PORT_DW-1:0]            port_b_req_data,
     output                          port_b_rsp_vld,
@@ -46,259 +52,682 @@ module uv_dam
 );
 
     localparam UDLY                 = 1;
-    localparam BANK_AW              = PORT_AW - $clog2(PORT_MW) - 1;
-    localparam BANK_DP              = SRAM_DP / 2;
-    localparam BANK_DW              = PORT_DW;
-    localparam BANK_MW              = PORT_MW;
-    localparam BANK_A_BASE_LSB      = PORT_AW - 1;
-    localparam BANK_A_BASE_BASE     = 1'b0;
-    localparam BANK_B_BASE_LSB      = PORT_AW - 1;
-    localparam BANK_B_BASE_BASE     = 1'b1;
-
-    // Bank bus ports.
-    wire                            bank_a_req_vld;
-    wire                            bank_a_req_rdy;
-    wire                            bank_a_req_read;
-    wire [PORT_AW-1:0]              bank_a_req_addr;
-    wire [PORT_MW-1:0]              bank_a_req_mask;
-    wire [PORT_DW-1:0]              bank_a_req_data;
-    wire                            bank_a_rsp_vld;
-    wire                            bank_a_rsp_rdy;
-    wire [1:0]                      bank_a_rsp_excp;
-    wire [PORT_DW-1:0]              bank_a_rsp_data;
-
-    wire                            bank_b_req_vld;
-    wire                            bank_b_req_rdy;
-    wire                            bank_b_req_read;
-    wire [PORT_AW-1:0]              bank_b_req_addr;
-    wire [PORT_MW-1:0]              bank_b_req_mask;
-    wire [PORT_DW-1:0]              bank_b_req_data;
-    wire                            bank_b_rsp_vld;
-    wire                            bank_b_rsp_rdy;
-    wire [1:0]                      bank_b_rsp_excp;
-    wire [PORT_DW-1:0]              bank_b_rsp_data;
-
-    // Bank ram ports.
-    wire                            bank_a_ce;
-    wire                            bank_a_we;
-    wire [BANK_AW-1:0]              bank_a_addr;
-    wire [BANK_DW-1:0]              bank_a_wdat;
-    wire [BANK_MW-1:0]              bank_a_mask;
-    wire [BANK_DW-1:0]              bank_a_rdat;
-
-    wire                            bank_b_ce;
-    wire                            bank_b_we;
-    wire [BANK_AW-1:0]              bank_b_addr;
-    wire [BANK_DW-1:0]              bank_b_wdat;
-    wire [BANK_MW-1:0]              bank_b_mask;
-    wire [BANK_DW-1:0]              bank_b_rdat;
-
-    // Matrix.
-    uv_bus_fab_2x2
+    genvar i;
+
+    // Port B after atomic operations.
+    wire                            dam_b_req_vld;
+    wire                            dam_b_req_rdy;
+    wire                            dam_b_req_read;
+    wire [PORT_AW-1:0]              dam_b_req_addr;
+    wire [PORT_MW-1:0]              dam_b_req_mask;
+    wire [PORT_DW-1:0]              dam_b_req_data;
+    wire                            dam_b_rsp_vld;
+    wire                            dam_b_rsp_rdy;
+    wire [1:0]                      dam_b_rsp_excp;
+    wire [PORT_DW-1:0]              dam_b_rsp_data;
+
+    uv_bus_amo
     #(
         .ALEN                       ( PORT_AW           ),
         .DLEN                       ( PORT_DW           ),
-        .MLEN                       ( PORT_MW           ),
-        .PIPE_STAGE                 ( 0                 ),
-        .SLV0_BASE_LSB              ( BANK_A_BASE_LSB   ),
-        .SLV0_BASE_ADDR             ( BANK_A_BASE_BASE  ),
-        .SLV1_BASE_LSB              ( BANK_B_BASE_LSB   ),
-        .SLV1_BASE_ADDR             ( BANK_B_BASE_BASE  )
+        .MLEN                       ( PORT_MW           )
     )
-    u_bus_fab
+    u_amo_b
     (
         .clk                        ( clk               ),
         .rst_n                      ( rst_n             ),
 
-        // Device enabling.
-        .mst_dev_vld                ( 2'b11             ),
-        .slv_dev_vld                ( 2'b11             ),
-
-        // Masters.
-        .mst0_req_vld               ( port_a_req_vld    ),
-        .mst0_req_rdy               ( port_a_req_rdy    ),
-        .mst0_req_read              ( port_a_req_read   ),
-        .mst0_req_addr              ( port_a_req_addr   ),
-        .mst0_req_mask              ( port_a_req_mask   ),
-        .mst0_req_data              ( port_a_req_data   ),
-        .mst0_rsp_vld               ( port_a_rsp_vld    ),
-        .mst0_rsp_rdy               ( port_a_rsp_rdy    ),
-        .mst0_rsp_excp              ( port_a_rsp_excp   ),
-        .mst0_rsp_data              ( port_a_rsp_data   ),
-
-        .mst1_req_vld               ( port_b_req_vld    ),
-        .mst1_req_rdy               ( port_b_req_rdy    ),
-        .mst1_req_read              ( port_b_req_read   ),
-        .mst1_req_addr              ( port_b_req_addr   ),
-        .mst1_req_mask              ( port_b_req_mask   ),
-        .mst1_req_data              ( port_b_req_data   ),
-        .mst1_rsp_vld               ( port_b_rsp_vld    ),
-        .mst1_rsp_rdy               ( port_b_rsp_rdy    ),
-        .mst1_rsp_excp              ( port_b_rsp_excp   ),
-        .mst1_rsp_data              ( port_b_rsp_data   ),
-
-        // Slaves.
-        .slv0_req_vld               ( bank_a_req_vld    ),
-        .slv0_req_rdy               ( bank_a_req_rdy    ),
-        .slv0_req_read              ( bank_a_req_read   ),
-        .slv0_req_addr              ( bank_a_req_addr   ),
-        .slv0_req_mask              ( bank_a_req_mask   ),
-        .slv0_req_data              ( bank_a_req_data   ),
-        .slv0_rsp_vld               ( bank_a_rsp_vld    ),
-        .slv0_rsp_rdy               ( bank_a_rsp_rdy    ),
-        .slv0_rsp_excp              ( bank_a_rsp_excp   ),
-        .slv0_rsp_data              ( bank_a_rsp_data   ),
-
-        .slv1_req_vld               ( bank_b_req_vld    ),
-        .slv1_req_rdy               ( bank_b_req_rdy    ),
-        .slv1_req_read              ( bank_b_req_read   ),
-        .slv1_req_addr              ( bank_b_req_addr   ),
-        .slv1_req_mask              ( bank_b_req_mask   ),
-        .slv1_req_data              ( bank_b_req_data   ),
-        .slv1_rsp_vld               ( bank_b_rsp_vld    ),
-        .slv1_rsp_rdy               ( bank_b_rsp_rdy    ),
-        .slv1_rsp_excp              ( bank_b_rsp_excp   ),
-        .slv1_rsp_data              ( bank_b_rsp_data   )
+        .bus_req_vld                ( port_b_req_vld    ),
+        .bus_req_rdy                ( port_b_req_rdy    ),
+        .bus_req_read               ( port_b_req_read   ),
+        .bus_req_addr               ( port_b_req_addr   ),
+        .bus_req_len                ( 4'b0              ),
+        .bus_req_wrap               ( 1'b0              ),
+        .bus_req_amo                ( port_b_req_amo    ),
+        .bus_req_src                ( 1'b0              ),
+        .bus_req_mask               ( port_b_req_mask   ),
+        .bus_req_data               ( port_b_req_data   ),
+
+        .bus_rsp_vld                ( port_b_rsp_vld    ),
+        .bus_rsp_rdy                ( port_b_rsp_rdy    ),
+        .bus_rsp_excp               ( port_b_rsp_excp   ),
+        .bus_rsp_data               ( port_b_rsp_data   ),
+
+        .slv_req_vld                ( dam_b_req_vld     ),
+        .slv_req_rdy                ( dam_b_req_rdy     ),
+        .slv_req_read               ( dam_b_req_read    ),
+        .slv_req_addr               ( dam_b_req_addr    ),
+        .slv_req_len                (                   ),
+        .slv_req_wrap               (                   ),
+        .slv_req_mask               ( dam_b_req_mask    ),
+        .slv_req_data               ( dam_b_req_data    ),
+
+        .slv_rsp_vld                ( dam_b_rsp_vld     ),
+        .slv_rsp_rdy                ( dam_b_rsp_rdy     ),
+        .slv_rsp_excp               ( dam_b_rsp_excp    ),
+        .slv_rsp_data               ( dam_b_rsp_data    )
     );
 
-    uv_sram_bus_ctrl
-    #(
-        .ALEN                       ( PORT_AW           ),
-        .DLEN                       ( PORT_DW           ),
-        .MLEN                       ( PORT_MW           ),
-        .SRAM_AW                    ( BANK_AW           ),
-        .SRAM_DP                    ( BANK_DP           )
-    )
-    u_bus_ctrl_a
-    (
-        .clk                        ( clk               ),
-        .rst_n                      ( rst_n             ),
+    generate
+        if (!BANK_ILV) begin: gen_bank_msb
+            localparam BANK_AW              = PORT_AW - $clog2(PORT_MW) - 1;
+            localparam BANK_DP              = SRAM_DP / 2;
+            localparam BANK_DW              = PORT_DW;
+            localparam BANK_MW              = PORT_MW;
+            localparam BANK_A_BASE_LSB      = PORT_AW - 1;
+            localparam BANK_A_BASE_BASE     = 1'b0;
+            localparam BANK_B_BASE_LSB      = PORT_AW - 1;
+            localparam BANK_B_BASE_BASE     = 1'b1;
+
+            // Bank bus ports.
+            wire                            bank_a_req_vld;
+            wire                            bank_a_req_rdy;
+            wire                            bank_a_req_read;
+            wire [PORT_AW-1:0]              bank_a_req_addr;
+            wire [PORT_MW-1:0]              bank_a_req_mask;
+            wire [PORT_DW-1:0]              bank_a_req_data;
+            wire                            bank_a_rsp_vld;
+            wire                            bank_a_rsp_rdy;
+            wire [1:0]                      bank_a_rsp_excp;
+            wire [PORT_DW-1:0]              bank_a_rsp_data;
+
+            wire                            bank_b_req_vld;
+            wire                            bank_b_req_rdy;
+            wire                            bank_b_req_read;
+            wire [PORT_AW-1:0]              bank_b_req_addr;
+            wire [PORT_MW-1:0]              bank_b_req_mask;
+            wire [PORT_DW-1:0]              bank_b_req_data;
+            wire                            bank_b_rsp_vld;
+            wire                            bank_b_rsp_rdy;
+            wire [1:0]                      bank_b_rsp_excp;
+            wire [PORT_DW-1:0]              bank_b_rsp_data;
+
+            // Bank ram ports.
+            wire                            bank_a_ce;
+            wire                            bank_a_we;
+            wire [BANK_AW-1:0]              bank_a_addr;
+            wire [BANK_DW-1:0]              bank_a_wdat;
+            wire [BANK_MW-1:0]              bank_a_mask;
+            wire [BANK_DW-1:0]              bank_a_rdat;
+
+            wire                            bank_b_ce;
+            wire                            bank_b_we;
+            wire [BANK_AW-1:0]              bank_b_addr;
+            wire [BANK_DW-1:0]              bank_b_wdat;
+            wire [BANK_MW-1:0]              bank_b_mask;
+            wire [BANK_DW-1:0]              bank_b_rdat;
+
+            // Matrix.
+            uv_bus_fab_2x2
+            #(
+                .ALEN                       ( PORT_AW           ),
+                .DLEN                       ( PORT_DW           ),
+                .MLEN                       ( PORT_MW           ),
+                .PIPE_STAGE                 ( 0                 ),
+                .SLV0_BASE_LSB              ( BANK_A_BASE_LSB   ),
+                .SLV0_BASE_ADDR             ( BANK_A_BASE_BASE  ),
+                .SLV1_BASE_LSB              ( BANK_B_BASE_LSB   ),
+                .SLV1_BASE_ADDR             ( BANK_B_BASE_BASE  )
+            )
+            u_bus_fab
+            (
+                .clk                        ( clk               ),
+                .rst_n                      ( rst_n             ),
+
+                // Device enabling.
+                .mst_dev_vld                ( 2'b11             ),
+                .slv_dev_vld                ( 2'b11             ),
+
+                // Masters.
+                .mst0_req_vld               ( port_a_req_vld    ),
+                .mst0_req_rdy               ( port_a_req_rdy    ),
+                .mst0_req_read              ( port_a_req_read   ),
+                .mst0_req_addr              ( port_a_req_addr   ),
+                .mst0_req_len               ( 4'b0              ),
+                .mst0_req_wrap              ( 1'b0              ),
+                .mst0_req_amo               ( 4'b0              ),
+                .mst0_req_mask              ( port_a_req_mask   ),
+                .mst0_req_data              ( port_a_req_data   ),
+                .mst0_rsp_vld               ( port_a_rsp_vld    ),
+                .mst0_rsp_rdy               ( port_a_rsp_rdy    ),
+                .mst0_rsp_excp              ( port_a_rsp_excp   ),
+                .mst0_rsp_data              ( port_a_rsp_data   ),
+
+                .mst1_req_vld               ( dam_b_req_vld     ),
+                .mst1_req_rdy               ( dam_b_req_rdy     ),
+                .mst1_req_read              ( dam_b_req_read    ),
+                .mst1_req_addr              ( dam_b_req_addr    ),
+                .mst1_req_len               ( 4'b0              ),
+                .mst1_req_wrap              ( 1'b0              ),
+                .mst1_req_amo               ( 4'b0              ),
+                .mst1_req_mask              ( dam_b_req_mask    ),
+                .mst1_req_data              ( dam_b_req_data    ),
+                .mst1_rsp_vld               ( dam_b_rsp_vld     ),
+                .mst1_rsp_rdy               ( dam_b_rsp_rdy     ),
+                .mst1_rsp_excp              ( dam_b_rsp_excp    ),
+                .mst1_rsp_data              ( dam_b_rsp_data    ),
+
+                // Slaves.
+                .slv0_req_vld               ( bank_a_req_vld    ),
+                .slv0_req_rdy               ( bank_a_req_rdy    ),
+                .slv0_req_read              ( bank_a_req_read   ),
+                .slv0_req_addr              ( bank_a_req_addr   ),
+                .slv0_req_len               (                   ),
+                .slv0_req_wrap              (                   ),
+                .slv0_req_amo               (                   ),
+                .slv0_req_mask              ( bank_a_req_mask   ),
+                .slv0_req_data              ( bank_a_req_data   ),
+                .slv0_rsp_vld               ( bank_a_rsp_vld    ),
+                .slv0_rsp_rdy               ( bank_a_rsp_rdy    ),
+                .slv0_rsp_excp              ( bank_a_rsp_excp   ),
+                .slv0_rsp_data              ( bank_a_rsp_data   ),
+
+                .slv1_req_vld               ( bank_b_req_vld    ),
+                .slv1_req_rdy               ( bank_b_req_rdy    ),
+                .slv1_req_read              ( bank_b_req_read   ),
+                .slv1_req_addr              ( bank_b_req_addr   ),
+                .slv1_req_len               (                   ),
+                .slv1_req_wrap              (                   ),
+                .slv1_req_amo               (                   ),
+                .slv1_req_mask              ( bank_b_req_mask   ),
+                .slv1_req_data              ( bank_b_req_data   ),
+                .slv1_rsp_vld               ( bank_b_rsp_vld    ),
+                .slv1_rsp_rdy               ( bank_b_rsp_rdy    ),
+                .slv1_rsp_excp              ( bank_b_rsp_excp   ),
+                .slv1_rsp_data              ( bank_b_rsp_data   )
+            );
+
+            uv_sram_bus_ctrl
+            #(
+                .ALEN                       ( PORT_AW           ),
+                .DLEN                       ( PORT_DW           ),
+                .MLEN                       ( PORT_MW           ),
+                .SRAM_AW                    ( BANK_AW           ),
+                .SRAM_DP                    ( BANK_DP           )
+            )
+            u_bus_ctrl_a
+            (
+                .clk                        ( clk               ),
+                .rst_n                      ( rst_n             ),
+
+                .sram_req_vld               ( bank_a_req_vld    ),
+                .sram_req_rdy               ( bank_a_req_rdy    ),
+                .sram_req_read              ( bank_a_req_read   ),
+                .sram_req_addr              ( bank_a_req_addr   ),
+                .sram_req_len               ( 4'b0              ),
+                .sram_req_wrap              ( 1'b0              ),
+                .sram_req_mask              ( bank_a_req_mask   ),
+                .sram_req_data              ( bank_a_req_data   ),
+                .sram_rsp_vld               ( bank_a_rsp_vld    ),
+                .sram_rsp_rdy               ( bank_a_rsp_rdy    ),
+                .sram_rsp_excp              ( bank_a_rsp_excp   ),
+                .sram_rsp_data              ( bank_a_rsp_data   ),
+
+                .sram_ce                    ( bank_a_ce         ),
+                .sram_we                    ( bank_a_we         ),
+                .sram_addr                  ( bank_a_addr       ),
+                .sram_wdat                  ( bank_a_wdat       ),
+                .sram_mask                  ( bank_a_mask       ),
+                .sram_rdat                  ( bank_a_rdat       )
+            );
+
+            uv_sram_bus_ctrl
+            #(
+                .ALEN                       ( PORT_AW           ),
+                .DLEN                       ( PORT_DW           ),
+                .MLEN                       ( PORT_MW           ),
+                .SRAM_AW                    ( BANK_AW           ),
+                .SRAM_DP                    ( BANK_DP           )
+            )
+            u_bus_ctrl_b
+            (
+                .clk                        ( clk               ),
+                .rst_n                      ( rst_n             ),
+
+                .sram_req_vld               ( bank_b_req_vld    ),
+                .sram_req_rdy               ( bank_b_req_rdy    ),
+                .sram_req_read              ( bank_b_req_read   ),
+                .sram_req_addr              ( bank_b_req_addr   ),
+                .sram_req_len               ( 4'b0              ),
+                .sram_req_wrap              ( 1'b0              ),
+                .sram_req_mask              ( bank_b_req_mask   ),
+                .sram_req_data              ( bank_b_req_data   ),
+                .sram_rsp_vld               ( bank_b_rsp_vld    ),
+                .sram_rsp_rdy               ( bank_b_rsp_rdy    ),
+                .sram_rsp_excp              ( bank_b_rsp_excp   ),
+                .sram_rsp_data              ( bank_b_rsp_data   ),
+
+                .sram_ce                    ( bank_b_ce         ),
+                .sram_we                    ( bank_b_we         ),
+                .sram_addr                  ( bank_b_addr       ),
+                .sram_wdat                  ( bank_b_wdat       ),
+                .sram_mask                  ( bank_b_mask       ),
+                .sram_rdat                  ( bank_b_rdat       )
+            );
 
-        .sram_req_vld               ( bank_a_req_vld    ),
-        .sram_req_rdy               ( bank_a_req_rdy    ),
-        .sram_req_read              ( bank_a_req_read   ),
-        .sram_req_addr              ( bank_a_req_addr   ),
-        .sram_req_mask              ( bank_a_req_mask   ),
-        .sram_req_data              ( bank_a_req_data   ),
-        .sram_rsp_vld               ( bank_a_rsp_vld    ),
-        .sram_rsp_rdy               ( bank_a_rsp_rdy    ),
-        .sram_rsp_excp              ( bank_a_rsp_excp   ),
-        .sram_rsp_data              ( bank_a_rsp_data   ),
-
-        .sram_ce                    ( bank_a_ce         ),
-        .sram_we                    ( bank_a_we         ),
-        .sram_addr                  ( bank_a_addr       ),
-        .sram_wdat                  ( bank_a_wdat       ),
-        .sram_mask                  ( bank_a_mask       ),
-        .sram_rdat                  ( bank_a_rdat       )
-    );
+`ifdef ASIC
 
-    uv_sram_bus_ctrl
-    #(
-        .ALEN                       ( PORT_AW           ),
-        .DLEN                       ( PORT_DW           ),
-        .MLEN                       ( PORT_MW           ),
-        .SRAM_AW                    ( BANK_AW           ),
-        .SRAM_DP                    ( BANK_DP           )
-    )
-    u_bus_ctrl_b
-    (
-        .clk                        ( clk               ),
-        .rst_n                      ( rst_n             ),
+            // RAM instantiation for specific process.
 
-        .sram_req_vld               ( bank_b_req_vld    ),
-        .sram_req_rdy               ( bank_b_req_rdy    ),
-        .sram_req_read              ( bank_b_req_read   ),
-        .sram_req_addr              ( bank_b_req_addr   ),
-        .sram_req_mask              ( bank_b_req_mask   ),
-        .sram_req_data              ( bank_b_req_data   ),
-        .sram_rsp_vld               ( bank_b_rsp_vld    ),
-        .sram_rsp_rdy               ( bank_b_rsp_rdy    ),
-        .sram_rsp_excp              ( bank_b_rsp_excp   ),
-        .sram_rsp_data              ( bank_b_rsp_data   ),
-
-        .sram_ce                    ( bank_b_ce         ),
-        .sram_we                    ( bank_b_we         ),
-        .sram_addr                  ( bank_b_addr       ),
-        .sram_wdat                  ( bank_b_wdat       ),
-        .sram_mask                  ( bank_b_mask       ),
-        .sram_rdat                  ( bank_b_rdat       )
-    );
+`elsif FPGA
 
-`ifdef ASIC
+            wire [7:0]                      bank_a_wea;
+            wire [7:0]                      bank_b_wea;
+
+            assign bank_a_wea               = {8{bank_a_we}} & bank_a_mask;
+            assign bank_b_wea               = {8{bank_b_we}} & bank_b_mask;
+
+            uv_fpga_bram_64x8k u_bank_a
+            (
+                .clka                       ( clk               ),  // input wire clka
+                .ena                        ( bank_a_ce         ),  // input wire ena
+                .wea                        ( bank_a_wea        ),  // input wire [7 : 0] wea
+                .addra                      ( bank_a_addr       ),  // input wire [12 : 0] addra
+                .dina                       ( bank_a_wdat       ),  // input wire [63 : 0] dina
+                .douta                      ( bank_a_rdat       )   // output wire [63 : 0] douta
+            );
+
+            uv_fpga_bram_64x8k u_bank_b
+            (
+                .clka                       ( clk               ),  // input wire clka
+                .ena                        ( bank_b_ce         ),  // input wire ena
+                .wea                        ( bank_b_wea        ),  // input wire [7 : 0] wea
+                .addra                      ( bank_b_addr       ),  // input wire [12 : 0] addra
+                .dina                       ( bank_b_wdat       ),  // input wire [63 : 0] dina
+                .douta                      ( bank_b_rdat       )   // output wire [63 : 0] douta
+            );
+
+`else // SIMULATION
 
-    // RAM instantiation for specific process.
+            // BANK A.
+            uv_sram_sp
+            #(
+                .RAM_AW                     ( BANK_AW           ),
+                .RAM_DP                     ( BANK_DP           ),
+                .RAM_DW                     ( BANK_DW           ),
+                .RAM_MW                     ( BANK_MW           ),
+                .RAM_DLY                    ( 0                 )
+            )
+            u_bank_a
+            (
+                .clk                        ( clk               ),
+                .ce                         ( bank_a_ce         ),
+                .we                         ( bank_a_we         ),
+                .a                          ( bank_a_addr       ),
+                .d                          ( bank_a_wdat       ),
+                .m                          ( bank_a_mask       ),
+                .q                          ( bank_a_rdat       )
+            );
+
+            // BANK B.
+            uv_sram_sp
+            #(
+                .RAM_AW                     ( BANK_AW           ),
+                .RAM_DP                     ( BANK_DP           ),
+                .RAM_DW                     ( BANK_DW           ),
+                .RAM_MW                     ( BANK_MW           ),
+                .RAM_DLY                    ( 0                 )
+            )
+            u_bank_b
+            (
+                .clk                        ( clk               ),
+                .ce                         ( bank_b_ce         ),
+                .we                         ( bank_b_we         ),
+                .a                          ( bank_b_addr       ),
+                .d                          ( bank_b_wdat       ),
+                .m                          ( bank_b_mask       ),
+                .q                          ( bank_b_rdat       )
+            );
 
-`elsif FPGA
+`endif
+        end
+        else begin: gen_bank_ilv
+            localparam OFFSET_AW    = $clog2(PORT_MW);
+            localparam WORD_AW      = PORT_AW - OFFSET_AW;
+            localparam BANK_BW      = $clog2(BANK_NUM);
+            localparam BANK_AW      = WORD_AW - BANK_BW;
+            localparam BANK_DP      = SRAM_DP / BANK_NUM;
+            localparam BANK_DW      = PORT_DW;
+            localparam BANK_MW      = PORT_MW;
+
+            // Request decoding. An access crossing the word boundary
+            // goes to two adjacent banks in the same cycle.
+            wire [OFFSET_AW-1:0]    a_offset;
+            wire [WORD_AW-1:0]      a_word_lo;
+            wire [WORD_AW:0]        a_word_hi;
+            wire [BANK_BW-1:0]      a_bank_lo;
+            wire [BANK_BW-1:0]      a_bank_hi;
+            wire [BANK_AW-1:0]      a_addr_lo;
+            wire [BANK_AW-1:0]      a_addr_hi;
+            wire [PORT_MW*2-1:0]    a_lsft_mask;
+            wire [PORT_DW*2-1:0]    a_lsft_wdat;
+            wire                    a_cross;
+            wire                    a_overflow;
+            wire [BANK_NUM-1:0]     a_bank_req;
+
+            wire [OFFSET_AW-1:0]    b_offset;
+            wire [WORD_AW-1:0]      b_word_lo;
+            wire [WORD_AW:0]        b_word_hi;
+            wire [BANK_BW-1:0]      b_bank_lo;
+            wire [BANK_BW-1:0]      b_bank_hi;
+            wire [BANK_AW-1:0]      b_addr_lo;
+            wire [BANK_AW-1:0]      b_addr_hi;
+            wire [PORT_MW*2-1:0]    b_lsft_mask;
+            wire [PORT_DW*2-1:0]    b_lsft_wdat;
+            wire                    b_cross;
+            wire                    b_overflow;
+            wire [BANK_NUM-1:0]     b_bank_req;
+
+            // Arbitration.
+            wire                    a_rsp_free;
+            wire                    b_rsp_free;
+            wire                    a_req_act;
+            wire                    b_req_act;
+            wire                    bank_conflict;
+            wire                    a_grant;
+            wire                    b_grant;
+            reg                     b_prior_r;
+
+            // Responses.
+            wire                    a_rsp_fire;
+            wire                    b_rsp_fire;
+            wire [PORT_DW*2-1:0]    a_comb_rdat;
+            wire [PORT_DW*2-1:0]    b_comb_rdat;
+            wire [PORT_DW-1:0]      a_rsft_rdat;
+            wire [PORT_DW-1:0]      b_rsft_rdat;
+
+            reg                     a_rsp_vld_r;
+            reg                     a_rsp_excp_r;
+            reg                     a_read_p;
+            reg                     a_cross_r;
+            reg  [OFFSET_AW-1:0]    a_offset_r;
+            reg  [BANK_BW-1:0]      a_bank_lo_r;
+            reg  [BANK_BW-1:0]      a_bank_hi_r;
+            reg  [PORT_DW-1:0]      a_rsp_data_r;
+
+            reg                     b_rsp_vld_r;
+            reg                     b_rsp_excp_r;
+            reg                     b_read_p;
+            reg                     b_cross_r;
+            reg  [OFFSET_AW-1:0]    b_offset_r;
+            reg  [BANK_BW-1:0]      b_bank_lo_r;
+            reg  [BANK_BW-1:0]      b_bank_hi_r;
+            reg  [PORT_DW-1:0]      b_rsp_data_r;
+
+            // Bank ram ports.
+            wire                    bank_ce   [BANK_NUM-1:0];
+            wire                    bank_we   [BANK_NUM-1:0];
+            wire [BANK_AW-1:0]      bank_addr [BANK_NUM-1:0];
+            wire [BANK_DW-1:0]      bank_wdat [BANK_NUM-1:0];
+            wire [BANK_MW-1:0]      bank_mask [BANK_NUM-1:0];
+            wire [BANK_DW-1:0]      bank_rdat [BANK_NUM-1:0];
+
+            assign a_offset         = port_a_req_addr[OFFSET_AW-1:0];
+            assign a_word_lo        = port_a_req_addr[PORT_AW-1:OFFSET_AW];
+            assign a_word_hi        = a_word_lo + 1'b1;
+            assign a_bank_lo        = a_word_lo[BANK_BW-1:0];
+            assign a_bank_hi        = a_word_hi[BANK_BW-1:0];
+            assign a_addr_lo        = a_word_lo[WORD_AW-1:BANK_BW];
+            assign a_addr_hi        = a_word_hi[WORD_AW-1:BANK_BW];
+            assign a_lsft_mask      = {{PORT_MW{1'b0}}, port_a_req_mask} << a_offset;
+            assign a_lsft_wdat      = {{PORT_DW{1'b0}}, port_a_req_data} << {a_offset, 3'b0};
+            assign a_cross          = |a_lsft_mask[PORT_MW*2-1:PORT_MW];
+            assign a_overflow       = (a_word_lo >= SRAM_DP) | (a_cross & (a_word_hi >= SRAM_DP));
+            assign a_bank_req       = a_overflow ? {BANK_NUM{1'b0}}
+                                    : ({{(BANK_NUM-1){1'b0}}, 1'b1} << a_bank_lo)
+                                    | ({{(BANK_NUM-1){1'b0}}, a_cross} << a_bank_hi);
+
+            assign b_offset         = dam_b_req_addr[OFFSET_AW-1:0];
+            assign b_word_lo        = dam_b_req_addr[PORT_AW-1:OFFSET_AW];
+            assign b_word_hi        = b_word_lo + 1'b1;
+            assign b_bank_lo        = b_word_lo[BANK_BW-1:0];
+            assign b_bank_hi        = b_word_hi[BANK_BW-1:0];
+            assign b_addr_lo        = b_word_lo[WORD_AW-1:BANK_BW];
+            assign b_addr_hi        = b_word_hi[WORD_AW-1:BANK_BW];
+            assign b_lsft_mask      = {{PORT_MW{1'b0}}, dam_b_req_mask} << b_offset;
+            assign b_lsft_wdat      = {{PORT_DW{1'b0}}, dam_b_req_data} << {b_offset, 3'b0};
+            assign b_cross          = |b_lsft_mask[PORT_MW*2-1:PORT_MW];
+            assign b_overflow       = (b_word_lo >= SRAM_DP) | (b_cross & (b_word_hi >= SRAM_DP));
+            assign b_bank_req       = b_overflow ? {BANK_NUM{1'b0}}
+                                    : ({{(BANK_NUM-1){1'b0}}, 1'b1} << b_bank_lo)
+                                    | ({{(BANK_NUM-1){1'b0}}, b_cross} << b_bank_hi);
+
+            // Ports only wait for each other when they hit the same bank,
+            // and the winner alternates on conflicts.
+            assign a_rsp_fire       = port_a_rsp_vld & port_a_rsp_rdy;
+            assign b_rsp_fire       = dam_b_rsp_vld & dam_b_rsp_rdy;
+            assign a_rsp_free       = ~a_rsp_vld_r | a_rsp_fire;
+            assign b_rsp_free       = ~b_rsp_vld_r | b_rsp_fire;
+            assign a_req_act        = port_a_req_vld & a_rsp_free;
+            assign b_req_act        = dam_b_req_vld & b_rsp_free;
+            assign bank_conflict    = a_req_act & b_req_act & (|(a_bank_req & b_bank_req));
+            assign a_grant          = a_req_act & ~(bank_conflict & b_prior_r);
+            assign b_grant          = b_req_act & ~(bank_conflict & ~b_prior_r);
+
+            assign port_a_req_rdy   = a_grant;
+            assign dam_b_req_rdy    = b_grant;
+
+            assign a_comb_rdat      = {(a_cross_r ? bank_rdat[a_bank_hi_r] : {BANK_DW{1'b0}}),
+                                       bank_rdat[a_bank_lo_r]} >> {a_offset_r, 3'b0};
+            assign b_comb_rdat      = {(b_cross_r ? bank_rdat[b_bank_hi_r] : {BANK_DW{1'b0}}),
+                                       bank_rdat[b_bank_lo_r]} >> {b_offset_r, 3'b0};
+            assign a_rsft_rdat      = a_comb_rdat[PORT_DW-1:0];
+            assign b_rsft_rdat      = b_comb_rdat[PORT_DW-1:0];
+
+            assign port_a_rsp_vld   = a_rsp_vld_r;
+            assign port_a_rsp_excp  = {1'b0, a_rsp_excp_r};
+            assign port_a_rsp_data  = a_read_p ? a_rsft_rdat : a_rsp_data_r;
+            assign dam_b_rsp_vld    = b_rsp_vld_r;
+            assign dam_b_rsp_excp   = {1'b0, b_rsp_excp_r};
+            assign dam_b_rsp_data   = b_read_p ? b_rsft_rdat : b_rsp_data_r;
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    b_prior_r <= 1'b0;
+                end
+                else begin
+                    if (bank_conflict) begin
+                        b_prior_r <= #UDLY ~b_prior_r;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    a_rsp_vld_r  <= 1'b0;
+                    a_rsp_excp_r <= 1'b0;
+                end
+                else begin
+                    if (a_grant) begin
+                        a_rsp_vld_r  <= #UDLY 1'b1;
+                        a_rsp_excp_r <= #UDLY a_overflow;
+                    end
+                    else if (a_rsp_fire) begin
+                        a_rsp_vld_r  <= #UDLY 1'b0;
+                        a_rsp_excp_r <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    b_rsp_vld_r  <= 1'b0;
+                    b_rsp_excp_r <= 1'b0;
+                end
+                else begin
+                    if (b_grant) begin
+                        b_rsp_vld_r  <= #UDLY 1'b1;
+                        b_rsp_excp_r <= #UDLY b_overflow;
+                    end
+                    else if (b_rsp_fire) begin
+                        b_rsp_vld_r  <= #UDLY 1'b0;
+                        b_rsp_excp_r <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    a_read_p <= 1'b0;
+                    b_read_p <= 1'b0;
+                end
+                else begin
+                    a_read_p <= #UDLY a_grant & port_a_req_read & ~a_overflow;
+                    b_read_p <= #UDLY b_grant & dam_b_req_read & ~b_overflow;
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    a_cross_r   <= 1'b0;
+                    a_offset_r  <= {OFFSET_AW{1'b0}};
+                    a_bank_lo_r <= {BANK_BW{1'b0}};
+                    a_bank_hi_r <= {BANK_BW{1'b0}};
+                end
+                else begin
+                    if (a_grant) begin
+                        a_cross_r   <= #UDLY a_cross;
+                        a_offset_r  <= #UDLY a_offset;
+                        a_bank_lo_r <= #UDLY a_bank_lo;
+                        a_bank_hi_r <= #UDLY a_bank_hi;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    b_cross_r   <= 1'b0;
+                    b_offset_r  <= {OFFSET_AW{1'b0}};
+                    b_bank_lo_r <= {BANK_BW{1'b0}};
+                    b_bank_hi_r <= {BANK_BW{1'b0}};
+                end
+                else begin
+                    if (b_grant) begin
+                        b_cross_r   <= #UDLY b_cross;
+                        b_offset_r  <= #UDLY b_offset;
+                        b_bank_lo_r <= #UDLY b_bank_lo;
+                        b_bank_hi_r <= #UDLY b_bank_hi;
+                    end
+                end
+            end
+
+            // Keep read data since banks may be reused by the other port.
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    a_rsp_data_r <= {PORT_DW{1'b0}};
+                end
+                else begin
+                    if (a_read_p) begin
+                        a_rsp_data_r <= #UDLY a_rsft_rdat;
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    b_rsp_data_r <= {PORT_DW{1'b0}};
+                end
+                else begin
+                    if (b_read_p) begin
+                        b_rsp_data_r <= #UDLY b_rsft_rdat;
+                    end
+                end
+            end
+
+            for (i = 0; i < BANK_NUM; i = i + 1) begin: gen_bank
+                wire                a_sel_lo;
+                wire                a_sel_hi;
+                wire                b_sel_lo;
+                wire                b_sel_hi;
+                wire                a_sel;
+
+                assign a_sel_lo     = a_grant & a_bank_req[i] & (a_bank_lo == i);
+                assign a_sel_hi     = a_grant & a_bank_req[i] & (a_bank_lo != i);
+                assign b_sel_lo     = b_grant & b_bank_req[i] & (b_bank_lo == i);
+                assign b_sel_hi     = b_grant & b_bank_req[i] & (b_bank_lo != i);
+                assign a_sel        = a_sel_lo | a_sel_hi;
+
+                assign bank_ce[i]   = a_sel | b_sel_lo | b_sel_hi;
+                assign bank_we[i]   = a_sel ? ~port_a_req_read : ~dam_b_req_read;
+                assign bank_addr[i] = a_sel_lo ? a_addr_lo
+                                    : a_sel_hi ? a_addr_hi
+                                    : b_sel_lo ? b_addr_lo
+                                    : b_addr_hi;
+                assign bank_wdat[i] = a_sel_lo ? a_lsft_wdat[PORT_DW-1:0]
+                                    : a_sel_hi ? a_lsft_wdat[PORT_DW*2-1:PORT_DW]
+                                    : b_sel_lo ? b_lsft_wdat[PORT_DW-1:0]
+                                    : b_lsft_wdat[PORT_DW*2-1:PORT_DW];
+                assign bank_mask[i] = a_sel_lo ? a_lsft_mask[PORT_MW-1:0]
+                                    : a_sel_hi ? a_lsft_mask[PORT_MW*2-1:PORT_MW]
+                                    : b_sel_lo ? b_lsft_mask[PORT_MW-1:0]
+                                    : b_lsft_mask[PORT_MW*2-1:PORT_MW];
 
-    wire [3:0]                      bank_a_wea;
-    wire [3:0]                      bank_b_wea;
+`ifdef ASIC
 
-    assign bank_a_wea               = {4{bank_a_we}} & bank_a_mask;
-    assign bank_b_wea               = {4{bank_b_we}} & bank_b_mask;
+                // RAM instantiation for specific process.
 
-    uv_fpga_bram_32x16k u_bank_a
-    (
-        .clka                       ( clk               ),  // input wire clka
-        .ena                        ( bank_a_ce         ),  // input wire ena
-        .wea                        ( bank_a_wea        ),  // input wire [3 : 0] wea
-        .addra                      ( bank_a_addr       ),  // input wire [13 : 0] addra
-        .dina                       ( bank_a_wdat       ),  // input wire [31 : 0] dina
-        .douta                      ( bank_a_rdat       )   // output wire [31 : 0] douta
-    );
+`elsif FPGA
 
-    uv_fpga_bram_32x16k u_bank_b
-    (
-        .clka                       ( clk               ),  // input wire clka
-        .ena                        ( bank_b_ce         ),  // input wire ena
-        .wea                        ( bank_b_wea        ),  // input wire [3 : 0] wea
-        .addra                      ( bank_b_addr       ),  // input wire [13 : 0] addra
-        .dina                       ( bank_b_wdat       ),  // input wire [31 : 0] dina
-        .douta                      ( bank_b_rdat       )   // output wire [31 : 0] douta
-    );
+                if ((BANK_DP == 8192) && (BANK_DW == 64)) begin: gen_bram
+                    wire [7:0]      bank_wea;
+
+                    assign bank_wea = {8{bank_we[i]}} & bank_mask[i];
+
+                    uv_fpga_bram_64x8k u_bank
+                    (
+                        .clka       ( clk           ),  // input wire clka
+                        .ena        ( bank_ce[i]    ),  // input wire ena
+                        .wea        ( bank_wea      ),  // input wire [7 : 0] wea
+                        .addra      ( bank_addr[i]  ),  // input wire [12 : 0] addra
+                        .dina       ( bank_wdat[i]  ),  // input wire [63 : 0] dina
+                        .douta      ( bank_rdat[i]  )   // output wire [63 : 0] douta
+                    );
+                end
+                else begin: gen_bram_infer
+                    uv_sram_sp
+                    #(
+                        .RAM_AW     ( BANK_AW       ),
+                        .RAM_DP     ( BANK_DP       ),
+                        .RAM_DW     ( BANK_DW       ),
+                        .RAM_MW     ( BANK_MW       ),
+                        .RAM_DLY    ( 0             )
+                    )
+                    u_bank
+                    (
+                        .clk        ( clk           ),
+                        .ce         ( bank_ce[i]    ),
+                        .we         ( bank_we[i]    ),
+                        .a          ( bank_addr[i]  ),
+                        .d          ( bank_wdat[i]  ),
+                        .m          ( bank_mask[i]  ),
+                        .q          ( bank_rdat[i]  )
+                    );
+                end
 
 `else // SIMULATION
 
-    // BANK A.
-    uv_sram_sp
-    #(
-        .RAM_AW                     ( BANK_AW           ),
-        .RAM_DP                     ( BANK_DP           ),
-        .RAM_DW                     ( BANK_DW           ),
-        .RAM_MW                     ( BANK_MW           ),
-        .RAM_DLY                    ( 0                 )
-    )
-    u_bank_a
-    (
-        .clk                        ( clk               ),
-        .ce                         ( bank_a_ce         ),
-        .we                         ( bank_a_we         ),
-        .a                          ( bank_a_addr       ),
-        .d                          ( bank_a_wdat       ),
-        .m                          ( bank_a_mask       ),
-        .q                          ( bank_a_rdat       )
-    );
-
-    // BANK B.
-    uv_sram_sp
-    #(
-        .RAM_AW                     ( BANK_AW           ),
-        .RAM_DP                     ( BANK_DP           ),
-        .RAM_DW                     ( BANK_DW           ),
-        .RAM_MW                     ( BANK_MW           ),
-        .RAM_DLY                    ( 0                 )
-    )
-    u_bank_b
-    (
-        .clk                        ( clk               ),
-        .ce                         ( bank_b_ce         ),
-        .we                         ( bank_b_we         ),
-        .a                          ( bank_b_addr       ),
-        .d                          ( bank_b_wdat       ),
-        .m                          ( bank_b_mask       ),
-        .q                          ( bank_b_rdat       )
-    );
+                uv_sram_sp
+                #(
+                    .RAM_AW         ( BANK_AW       ),
+                    .RAM_DP         ( BANK_DP       ),
+                    .RAM_DW         ( BANK_DW       ),
+                    .RAM_MW         ( BANK_MW       ),
+                    .RAM_DLY        ( 0             )
+                )
+                u_bank
+                (
+                    .clk            ( clk           ),
+                    .ce             ( bank_ce[i]    ),
+                    .we             ( bank_we[i]    ),
+                    .a              ( bank_addr[i]  ),
+                    .d              ( bank_wdat[i]  ),
+                    .m              ( bank_mask[i]  ),
+                    .q              ( bank_rdat[i]  )
+                );
 
 `endif
+            end
+        end
+    endgenerate
 
 endmodule
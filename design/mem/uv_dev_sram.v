@@ -6,7 +6,9 @@
 // Designer: Owen
 //
 // Description:
-//      SRAM connected to devbus.
+//      SRAM connected to devbus. Atomic requests are done as
+//      read-modify-write in front of the controller, with LR
+//      reservations for RSV_NUM masters indexed by SRC.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -17,7 +19,9 @@ module uv_dev_sram
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
     parameter SRAM_AW               = 10,
-    parameter SRAM_DP               = 2**SRAM_AW
+    parameter SRAM_DP               = 2**SRAM_AW,
+    parameter RSV_NUM               = 1,
+    parameter RSV_IW                = RSV_NUM > 1 ? $clog2(RSV_NUM) : 1
 )
 (
     input                           clk,
@@ -27,6 +31,10 @@ module uv_dev_sram
     output                          sram_req_rdy,
     input                           sram_req_read,
     input  [ALEN-1:0]               sram_req_addr,
+    input  [3:0]                    sram_req_len,
+    input                           sram_req_wrap,
+    input  [3:0]                    sram_req_amo,
+    input  [RSV_IW-1:0]             sram_req_src,
     input  [MLEN-1:0]               sram_req_mask,
     input  [DLEN-1:0]               sram_req_data,
 
@@ -36,6 +44,19 @@ module uv_dev_sram
     output [DLEN-1:0]               sram_rsp_data
 );
 
+    wire                            ctrl_req_vld;
+    wire                            ctrl_req_rdy;
+    wire                            ctrl_req_read;
+    wire [ALEN-1:0]                 ctrl_req_addr;
+    wire [3:0]                      ctrl_req_len;
+    wire                            ctrl_req_wrap;
+    wire [MLEN-1:0]                 ctrl_req_mask;
+    wire [DLEN-1:0]                 ctrl_req_data;
+    wire                            ctrl_rsp_vld;
+    wire                            ctrl_rsp_rdy;
+    wire [1:0]                      ctrl_rsp_excp;
+    wire [DLEN-1:0]                 ctrl_rsp_data;
+
     wire                            sram_ce;
     wire                            sram_we;
     wire [SRAM_AW-1:0]              sram_addr;
@@ -43,6 +64,49 @@ module uv_dev_sram
     wire [MLEN-1:0]                 sram_mask;
     wire [DLEN-1:0]                 sram_rdat;
 
+    uv_bus_amo
+    #(
+        .ALEN                       ( ALEN              ),
+        .DLEN                       ( DLEN              ),
+        .MLEN                       ( MLEN              ),
+        .RSV_NUM                    ( RSV_NUM           )
+    )
+    u_amo
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .bus_req_vld                ( sram_req_vld      ),
+        .bus_req_rdy                ( sram_req_rdy      ),
+        .bus_req_read               ( sram_req_read     ),
+        .bus_req_addr               ( sram_req_addr     ),
+        .bus_req_len                ( sram_req_len      ),
+        .bus_req_wrap               ( sram_req_wrap     ),
+        .bus_req_amo                ( sram_req_amo      ),
+        .bus_req_src                ( sram_req_src      ),
+        .bus_req_mask               ( sram_req_mask     ),
+        .bus_req_data               ( sram_req_data     ),
+
+        .bus_rsp_vld                ( sram_rsp_vld      ),
+        .bus_rsp_rdy                ( sram_rsp_rdy      ),
+        .bus_rsp_excp               ( sram_rsp_excp     ),
+        .bus_rsp_data               ( sram_rsp_data     ),
+
+        .slv_req_vld                ( ctrl_req_vld      ),
+        .slv_req_rdy                ( ctrl_req_rdy      ),
+        .slv_req_read               ( ctrl_req_read     ),
+        .slv_req_addr               ( ctrl_req_addr     ),
+        .slv_req_len                ( ctrl_req_len      ),
+        .slv_req_wrap               ( ctrl_req_wrap     ),
+        .slv_req_mask               ( ctrl_req_mask     ),
+        .slv_req_data               ( ctrl_req_data     ),
+
+        .slv_rsp_vld                ( ctrl_rsp_vld      ),
+        .slv_rsp_rdy                ( ctrl_rsp_rdy      ),
+        .slv_rsp_excp               ( ctrl_rsp_excp     ),
+        .slv_rsp_data               ( ctrl_rsp_data     )
+    );
+
     uv_sram_bus_ctrl
     #(
         .ALEN                       ( ALEN              ),
@@ -56,17 +120,19 @@ module uv_dev_sram
         .clk                        ( clk               ),
         .rst_n                      ( rst_n             ),
 
-        .sram_req_vld               ( sram_req_vld      ),
-        .sram_req_rdy               ( sram_req_rdy      ),
-        .sram_req_read              ( sram_req_read     ),
-        .sram_req_addr              ( sram_req_addr     ),
-        .sram_req_mask              ( sram_req_mask     ),
-        .sram_req_data              ( sram_req_data     ),
+        .sram_req_vld               ( ctrl_req_vld      ),
+        .sram_req_rdy               ( ctrl_req_rdy      ),
+        .sram_req_read              ( ctrl_req_read     ),
+        .sram_req_addr              ( ctrl_req_addr     ),
+        .sram_req_len               ( ctrl_req_len      ),
+        .sram_req_wrap              ( ctrl_req_wrap     ),
+        .sram_req_mask              ( ctrl_req_mask     ),
+        .sram_req_data              ( ctrl_req_data     ),
 
-        .sram_rsp_vld               ( sram_rsp_vld      ),
-        .sram_rsp_rdy               ( sram_rsp_rdy      ),
-        .sram_rsp_excp              ( sram_rsp_excp     ),
-        .sram_rsp_data              ( sram_rsp_data     ),
+        .sram_rsp_vld               ( ctrl_rsp_vld      ),
+        .sram_rsp_rdy               ( ctrl_rsp_rdy      ),
+        .sram_rsp_excp              ( ctrl_rsp_excp     ),
+        .sram_rsp_data              ( ctrl_rsp_data     ),
 
         .sram_ce                    ( sram_ce           ),
         .sram_we                    ( sram_we           ),
@@ -82,19 +148,44 @@ module uv_dev_sram
 
 `elsif FPGA
 
-    wire [3:0]                      sram_wea;
-
-    assign sram_wea                 = {4{sram_we}} & sram_mask;
-
-    uv_fpga_bram_32x16k u_ram
-    (
-        .clka                       ( clk               ),  // input wire clka
-        .ena                        ( sram_ce           ),  // input wire ena
-        .wea                        ( sram_wea          ),  // input wire [3 : 0] wea
-        .addra                      ( sram_addr         ),  // input wire [13 : 0] addra
-        .dina                       ( sram_wdat         ),  // input wire [31 : 0] dina
-        .douta                      ( sram_rdat         )   // output wire [31 : 0] douta
-    );
+    // The generated BRAM is 32-bit, and wider rows are inferred.
+    generate
+        if (DLEN == 32) begin: gen_bram
+            wire [3:0]              sram_wea;
+
+            assign sram_wea         = {4{sram_we}} & sram_mask;
+
+            uv_fpga_bram_32x16k u_ram
+            (
+                .clka               ( clk               ),  // input wire clka
+                .ena                ( sram_ce           ),  // input wire ena
+                .wea                ( sram_wea          ),  // input wire [3 : 0] wea
+                .addra              ( sram_addr         ),  // input wire [13 : 0] addra
+                .dina               ( sram_wdat         ),  // input wire [31 : 0] dina
+                .douta              ( sram_rdat         )   // output wire [31 : 0] douta
+            );
+        end
+        else begin: gen_ram
+            uv_sram_sp
+            #(
+                .RAM_AW             ( SRAM_AW           ),
+                .RAM_DP             ( SRAM_DP           ),
+                .RAM_DW             ( DLEN              ),
+                .RAM_MW             ( MLEN              ),
+                .RAM_DLY            ( 0                 )
+            )
+            u_ram
+            (
+                .clk                ( clk               ),
+                .ce                 ( sram_ce           ),
+                .we                 ( sram_we           ),
+                .a                  ( sram_addr         ),
+                .d                  ( sram_wdat         ),
+                .m                  ( sram_mask         ),
+                .q                  ( sram_rdat         )
+            );
+        end
+    endgenerate
 
 `else // SIMULATION
 
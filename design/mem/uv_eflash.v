@@ -6,7 +6,11 @@
 // Designer: Owen
 //
 // Description:
-//      FIXME: eFlash model to be implemented.
+//      eFlash controller with read accelerator.
+//      The macro returns a whole line per reading. A line
+//      buffer & a prefetch buffer serve sequential accesses,
+//      and a small branch cache keeps the lines fetched on
+//      demand misses, so that loops run near zero-wait.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -17,7 +21,10 @@ module uv_eflash
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
     parameter EFLASH_AW             = 18,
-    parameter EFLASH_DP             = 2**EFLASH_AW
+    parameter EFLASH_DP             = 2**EFLASH_AW,
+    parameter LINE_DW               = 128,
+    parameter READ_WS               = 1,
+    parameter BC_NUM                = 4     // Branch cache lines, must be power of 2.
 )
 (
     input                           clk,
@@ -36,28 +43,323 @@ module uv_eflash
     output [DLEN-1:0]               eflash_rsp_data
 );
 
-    localparam UDLY = 1;
-    localparam OFFSET_AW = $clog2(DLEN / 8);
+    localparam UDLY                 = 1;
+    localparam OFFSET_AW            = $clog2(MLEN);
+    localparam LINE_MW              = LINE_DW / 8;
+    localparam LINE_OW              = $clog2(LINE_MW);
+    localparam LINE_AW              = EFLASH_AW + OFFSET_AW - LINE_OW;
+    localparam LINE_DP              = EFLASH_DP * MLEN / LINE_MW;
+    localparam BC_IW                = BC_NUM > 1 ? $clog2(BC_NUM) : 1;
 
-    reg                             rsp_vld_r; 
+    genvar i;
+    integer j;
 
-    assign eflash_req_rdy           = 1'b1;
+    // Request decoding.
+    wire [LINE_AW-1:0]              req_line;
+    wire [LINE_AW-1:0]              req_line_nxt;
+    wire [LINE_OW-1:0]              req_ofs;
+    wire [LINE_MW+MLEN-1:0]         req_lsft_mask;
+    wire                            req_misalign;
+    wire                            req_fault;
+    wire                            req_pass;
+    wire                            req_fire;
+    wire                            rsp_fire;
+
+    // Buffer hits.
+    wire                            cur_hit;
+    wire                            pf_hit;
+    wire                            mac_hit;
+    wire [BC_NUM-1:0]               bc_hit;
+    wire                            req_hit;
+    wire                            req_miss;
+    wire                            pf_use;
+    wire                            mac_use;
+    wire                            bc_use;
+    reg  [LINE_DW-1:0]              hit_line;
+    wire [LINE_DW-1:0]              hit_sft_line;
+    wire [LINE_DW-1:0]              fill_sft_line;
+
+    // Line buffer.
+    reg                             cur_vld_r;
+    reg  [LINE_AW-1:0]              cur_tag_r;
+    reg  [LINE_DW-1:0]              cur_data_r;
+
+    // Prefetch buffer.
+    reg                             pf_vld_r;
+    reg  [LINE_AW-1:0]              pf_tag_r;
+    reg  [LINE_DW-1:0]              pf_data_r;
+    reg                             pf_want_r;
+    reg  [LINE_AW-1:0]              pf_next_r;
+    wire                            pf_trig;
+    wire [LINE_AW-1:0]              pf_trig_line;
+
+    // Branch cache.
+    reg  [BC_NUM-1:0]               bc_vld_r;
+    reg  [LINE_AW-1:0]              bc_tag_r [BC_NUM-1:0];
+    reg  [LINE_DW-1:0]              bc_data_r [BC_NUM-1:0];
+    reg  [BC_IW-1:0]                bc_ptr_r;
+    wire                            bc_ins;
+
+    // Demand miss.
+    reg                             miss_pend_r;
+    reg  [LINE_AW-1:0]              miss_tag_r;
+    reg  [LINE_OW-1:0]              miss_ofs_r;
+    wire                            miss_fill;
+    wire                            dmd_vld;
+    wire [LINE_AW-1:0]              dmd_tag;
+
+    // Macro ports.
+    wire                            mac_rd;
+    wire                            mac_rd_dmd;
+    wire                            mac_rd_pf;
+    wire [LINE_AW-1:0]              mac_addr;
+    wire                            mac_busy;
+    wire                            mac_vld;
+    wire [LINE_DW-1:0]              mac_data;
+    reg  [LINE_AW-1:0]              mac_tag_r;
+    reg                             mac_pf_r;
+
+    // Responses.
+    reg                             rsp_vld_r;
+    reg  [1:0]                      rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    assign req_line                 = eflash_req_addr[LINE_AW+LINE_OW-1:LINE_OW];
+    assign req_line_nxt             = req_line + 1'b1;
+    assign req_ofs                  = eflash_req_addr[LINE_OW-1:0];
+    assign req_lsft_mask            = {{LINE_MW{1'b0}}, eflash_req_mask} << req_ofs;
+    assign req_misalign             = |req_lsft_mask[LINE_MW+MLEN-1:LINE_MW];
+    // eFlash can only be programmed by its own controller, not by the bus.
+    assign req_fault                = (~eflash_req_read) | (eflash_req_addr[ALEN-1:LINE_OW] >= LINE_DP);
+    assign req_pass                 = req_fault | req_misalign;
+
+    assign req_fire                 = eflash_req_vld & eflash_req_rdy;
+    assign rsp_fire                 = eflash_rsp_vld & eflash_rsp_rdy;
+
+    // Hit checking.
+    assign cur_hit                  = cur_vld_r & (cur_tag_r == req_line);
+    assign pf_hit                   = pf_vld_r  & (pf_tag_r  == req_line);
+    assign mac_hit                  = mac_vld   & (mac_tag_r == req_line) & mac_pf_r;
+
+    generate
+        for (i = 0; i < BC_NUM; i = i + 1) begin: gen_bc_hit
+            assign bc_hit[i]        = bc_vld_r[i] & (bc_tag_r[i] == req_line);
+        end
+    endgenerate
+
+    assign req_hit                  = cur_hit | pf_hit | mac_hit | (|bc_hit);
+    assign req_miss                 = ~req_pass & ~req_hit;
+    assign pf_use                   = req_fire & ~req_pass & ~cur_hit & pf_hit;
+    assign mac_use                  = req_fire & ~req_pass & ~cur_hit & ~pf_hit & mac_hit;
+    assign bc_use                   = req_fire & ~req_pass & ~cur_hit & ~pf_hit & ~mac_hit & (|bc_hit);
+
+    always @(*) begin
+        hit_line = {LINE_DW{1'b0}};
+        for (j = 0; j < BC_NUM; j = j + 1) begin
+            hit_line = hit_line | ({LINE_DW{bc_hit[j]}} & bc_data_r[j]);
+        end
+        if (cur_hit) begin
+            hit_line = cur_data_r;
+        end
+        else if (pf_hit) begin
+            hit_line = pf_data_r;
+        end
+        else if (mac_hit) begin
+            hit_line = mac_data;
+        end
+    end
+
+    assign hit_sft_line             = hit_line >> {req_ofs, 3'b0};
+    assign fill_sft_line            = mac_data >> {miss_ofs_r, 3'b0};
+
+    // Demand reading has priority over prefetching.
+    assign miss_fill                = miss_pend_r & mac_vld & (mac_tag_r == miss_tag_r);
+    assign dmd_vld                  = (miss_pend_r & ~miss_fill) | (req_fire & req_miss);
+    assign dmd_tag                  = miss_pend_r ? miss_tag_r : req_line;
+
+    assign mac_rd_dmd               = dmd_vld & ~mac_busy;
+    assign mac_rd_pf                = pf_want_r & ~mac_busy & ~dmd_vld;
+    assign mac_rd                   = mac_rd_dmd | mac_rd_pf;
+    assign mac_addr                 = mac_rd_dmd ? dmd_tag : pf_next_r;
+
+    // Prefetch the next line once a line is taken into use.
+    assign pf_trig_line             = miss_fill ? miss_tag_r + 1'b1 : req_line_nxt;
+    assign pf_trig                  = (pf_use | mac_use | bc_use | miss_fill)
+                                    & (pf_trig_line < LINE_DP)
+                                    & ~(pf_vld_r & (pf_tag_r == pf_trig_line))
+                                    & ~((mac_busy | mac_vld) & (mac_tag_r == pf_trig_line))
+                                    & ~(mac_rd & (mac_addr == pf_trig_line));
+
+    assign bc_ins                   = miss_fill & ~mac_pf_r;
+
+    assign eflash_req_rdy           = ~miss_pend_r & (~rsp_vld_r | rsp_fire);
     assign eflash_rsp_vld           = rsp_vld_r;
-    assign eflash_rsp_excp          = 2'b0;
-    assign eflash_rsp_data          = {DLEN{1'b1}};
+    assign eflash_rsp_excp          = rsp_excp_r;
+    assign eflash_rsp_data          = rsp_data_r;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r  <= 1'b0;
+            rsp_excp_r <= 2'b0;
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (req_fire & ~req_miss) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY {req_misalign & ~req_fault, req_fault};
+                rsp_data_r <= #UDLY req_pass ? {DLEN{1'b0}} : hit_sft_line[DLEN-1:0];
+            end
+            else if (miss_fill) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY 2'b0;
+                rsp_data_r <= #UDLY fill_sft_line[DLEN-1:0];
+            end
+            else if (rsp_fire) begin
+                rsp_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
 
     always @(posedge clk or negedge rst_n) begin
         if (~rst_n) begin
-            rsp_vld_r <= 1'b0;
+            miss_pend_r <= 1'b0;
+            miss_tag_r  <= {LINE_AW{1'b0}};
+            miss_ofs_r  <= {LINE_OW{1'b0}};
         end
         else begin
-            if (eflash_req_vld & eflash_req_rdy) begin
-                rsp_vld_r <= #UDLY 1'b1;
+            if (req_fire & req_miss) begin
+                miss_pend_r <= #UDLY 1'b1;
+                miss_tag_r  <= #UDLY req_line;
+                miss_ofs_r  <= #UDLY req_ofs;
             end
-            else if (eflash_rsp_vld & eflash_rsp_rdy) begin
-                rsp_vld_r <= #UDLY 1'b0;
+            else if (miss_fill) begin
+                miss_pend_r <= #UDLY 1'b0;
             end
         end
     end
 
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            mac_tag_r <= {LINE_AW{1'b0}};
+            mac_pf_r  <= 1'b0;
+        end
+        else begin
+            if (mac_rd) begin
+                mac_tag_r <= #UDLY mac_addr;
+                mac_pf_r  <= #UDLY ~mac_rd_dmd;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_vld_r  <= 1'b0;
+            cur_tag_r  <= {LINE_AW{1'b0}};
+            cur_data_r <= {LINE_DW{1'b0}};
+        end
+        else begin
+            if (pf_use) begin
+                cur_vld_r  <= #UDLY 1'b1;
+                cur_tag_r  <= #UDLY pf_tag_r;
+                cur_data_r <= #UDLY pf_data_r;
+            end
+            else if (mac_use | miss_fill) begin
+                cur_vld_r  <= #UDLY 1'b1;
+                cur_tag_r  <= #UDLY mac_tag_r;
+                cur_data_r <= #UDLY mac_data;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pf_vld_r  <= 1'b0;
+            pf_tag_r  <= {LINE_AW{1'b0}};
+            pf_data_r <= {LINE_DW{1'b0}};
+        end
+        else begin
+            if (mac_vld & mac_pf_r & ~mac_use & ~miss_fill) begin
+                pf_vld_r  <= #UDLY 1'b1;
+                pf_tag_r  <= #UDLY mac_tag_r;
+                pf_data_r <= #UDLY mac_data;
+            end
+            else if (pf_use) begin
+                pf_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pf_want_r <= 1'b0;
+            pf_next_r <= {LINE_AW{1'b0}};
+        end
+        else begin
+            if (pf_trig) begin
+                pf_want_r <= #UDLY 1'b1;
+                pf_next_r <= #UDLY pf_trig_line;
+            end
+            else if (mac_rd_pf) begin
+                pf_want_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            bc_ptr_r <= {BC_IW{1'b0}};
+        end
+        else begin
+            if (bc_ins) begin
+                bc_ptr_r <= #UDLY bc_ptr_r + 1'b1;
+            end
+        end
+    end
+
+    generate
+        for (i = 0; i < BC_NUM; i = i + 1) begin: gen_bc_line
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    bc_vld_r[i]  <= 1'b0;
+                    bc_tag_r[i]  <= {LINE_AW{1'b0}};
+                    bc_data_r[i] <= {LINE_DW{1'b0}};
+                end
+                else begin
+                    if (bc_ins && (bc_ptr_r == i)) begin
+                        bc_vld_r[i]  <= #UDLY 1'b1;
+                        bc_tag_r[i]  <= #UDLY mac_tag_r;
+                        bc_data_r[i] <= #UDLY mac_data;
+                    end
+                end
+            end
+        end
+    endgenerate
+
+`ifdef ASIC
+
+    // eFlash macro instantiation for specific process.
+
+`else // SIMULATION & FPGA
+
+    uv_eflash_macro
+    #(
+        .LINE_AW                    ( LINE_AW               ),
+        .LINE_DP                    ( LINE_DP               ),
+        .LINE_DW                    ( LINE_DW               ),
+        .READ_WS                    ( READ_WS               )
+    )
+    u_macro
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .rd                         ( mac_rd                ),
+        .a                          ( mac_addr              ),
+        .busy                       ( mac_busy              ),
+        .vld                        ( mac_vld               ),
+        .q                          ( mac_data              )
+    );
+
+`endif
+
 endmodule
@@ -0,0 +1,94 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_eflash_macro
+//
+// Designer: Owen
+//
+// Description:
+//      Simulation model of eFlash macro with line reading.
+//      Each reading takes READ_WS wait states, which can be
+//      overridden by +EFLASH_WS=<n>. The content is loaded
+//      from +EFLASH_FILE=<hex> with one byte per entry.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_eflash_macro
+#(
+    parameter LINE_AW               = 16,
+    parameter LINE_DP               = 2**LINE_AW,
+    parameter LINE_DW               = 128,
+    parameter READ_WS               = 1
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           rd,
+    input  [LINE_AW-1:0]            a,
+    output                          busy,
+    output                          vld,
+    output [LINE_DW-1:0]            q
+);
+
+    localparam UDLY                 = 1;
+    localparam LINE_BYTES           = LINE_DW / 8;
+    localparam MAX_STRING_LEN       = 256;
+
+    reg  [LINE_DW-1:0]              mem [LINE_DP-1:0];
+    reg  [7:0]                      mem_buf [LINE_DP*LINE_BYTES-1:0];
+    reg  [MAX_STRING_LEN*8-1:0]     mem_file;
+    integer                         read_ws;
+    integer                         line_idx;
+    integer                         byte_idx;
+
+    reg                             rd_pend_r;
+    reg  [LINE_AW-1:0]              rd_addr_r;
+    integer                         ws_cnt_r;
+
+    initial begin
+        if (!$value$plusargs("EFLASH_WS=%d", read_ws)) begin
+            read_ws = READ_WS;
+        end
+
+        for (line_idx = 0; line_idx < LINE_DP * LINE_BYTES; line_idx = line_idx + 1) begin
+            mem_buf[line_idx] = 8'hff;
+        end
+        if ($value$plusargs("EFLASH_FILE=%s", mem_file)) begin
+            $display("> eFlash image: %0s, %0d wait states.", mem_file, read_ws);
+            $readmemh(mem_file, mem_buf);
+        end
+        for (line_idx = 0; line_idx < LINE_DP; line_idx = line_idx + 1) begin
+            for (byte_idx = 0; byte_idx < LINE_BYTES; byte_idx = byte_idx + 1) begin
+                mem[line_idx][byte_idx*8+:8] = mem_buf[line_idx*LINE_BYTES+byte_idx];
+            end
+        end
+    end
+
+    assign vld  = rd_pend_r & (ws_cnt_r == 0);
+    assign busy = rd_pend_r & (ws_cnt_r != 0);
+    assign q    = vld ? mem[rd_addr_r] : {LINE_DW{1'bx}};
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rd_pend_r <= 1'b0;
+            rd_addr_r <= {LINE_AW{1'b0}};
+            ws_cnt_r  <= 0;
+        end
+        else begin
+            if (rd & ~busy) begin
+                rd_pend_r <= #UDLY 1'b1;
+                rd_addr_r <= #UDLY a;
+                ws_cnt_r  <= #UDLY read_ws;
+            end
+            else if (busy) begin
+                ws_cnt_r  <= #UDLY ws_cnt_r - 1;
+            end
+            else begin
+                rd_pend_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,251 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_line_buf
+//
+// Designer: Owen
+//
+// Description:
+//      Line buffer from a narrow bus port to a line port.
+//      Reads are served from the last line filled, and the
+//      misses fetch a whole line. Writes go through to the
+//      line port with the mask in place & update the buffer
+//      on hits. The buffer is invalidated by the lines written
+//      from the other side.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_line_buf
+#(
+    parameter ALEN                  = 25,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter LINE_DW               = 128,
+    parameter LINE_MW               = LINE_DW / 8
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           bus_req_vld,
+    output                          bus_req_rdy,
+    input                           bus_req_read,
+    input  [ALEN-1:0]               bus_req_addr,
+    input  [MLEN-1:0]               bus_req_mask,
+    input  [DLEN-1:0]               bus_req_data,
+
+    output                          bus_rsp_vld,
+    input                           bus_rsp_rdy,
+    output [1:0]                    bus_rsp_excp,
+    output [DLEN-1:0]               bus_rsp_data,
+
+    output                          line_req_vld,
+    input                           line_req_rdy,
+    output                          line_req_read,
+    output [ALEN-1:0]               line_req_addr,
+    output [LINE_MW-1:0]            line_req_mask,
+    output [LINE_DW-1:0]            line_req_data,
+
+    input                           line_rsp_vld,
+    output                          line_rsp_rdy,
+    input  [1:0]                    line_rsp_excp,
+    input  [LINE_DW-1:0]            line_rsp_data,
+
+    // Lines written by this port & the other side.
+    output                          wr_vld,
+    output [ALEN-1:0]               wr_addr,
+    input                           inv_vld,
+    input  [ALEN-1:0]               inv_addr
+);
+
+    localparam UDLY                 = 1;
+    localparam OFFSET_AW            = $clog2(MLEN);
+    localparam LINE_OW              = $clog2(LINE_MW);
+    localparam LINE_AW              = ALEN - LINE_OW;
+    localparam LANE_NUM             = LINE_DW / DLEN;
+    localparam LANE_AW              = LANE_NUM > 1 ? $clog2(LANE_NUM) : 1;
+
+    localparam FSM_IDLE             = 2'h0;
+    localparam FSM_REQ              = 2'h1;
+    localparam FSM_RSP              = 2'h2;
+
+    genvar i;
+
+    reg  [1:0]                      cur_state;
+    reg  [1:0]                      nxt_state;
+
+    wire [LINE_AW-1:0]              req_tag;
+    wire [LANE_AW-1:0]              req_lane;
+    wire                            req_hit;
+    wire                            req_miss;
+    wire                            req_fire;
+    wire                            rsp_fire;
+    wire                            line_req_fire;
+    wire                            line_rsp_fire;
+
+    // Line buffer.
+    reg                             buf_vld_r;
+    reg  [LINE_AW-1:0]              buf_tag_r;
+    reg  [LINE_DW-1:0]              buf_data_r;
+    wire                            buf_fill;
+    wire                            buf_merge;
+    wire                            buf_inv;
+    wire [LINE_DW-1:0]              buf_merge_data;
+    wire [LINE_DW-1:0]              pend_bit_mask;
+
+    // Pending line access.
+    reg                             pend_read_r;
+    reg  [LINE_AW-1:0]              pend_tag_r;
+    reg  [LANE_AW-1:0]              pend_lane_r;
+    reg  [LINE_MW-1:0]              pend_mask_r;
+    reg  [LINE_DW-1:0]              pend_data_r;
+    reg                             pend_stale_r;
+    wire                            pend_inv;
+
+    // Responses.
+    reg                             rsp_vld_r;
+    reg  [1:0]                      rsp_excp_r;
+    reg  [DLEN-1:0]                 rsp_data_r;
+
+    assign req_tag                  = bus_req_addr[ALEN-1:LINE_OW];
+    assign req_lane                 = LANE_NUM > 1 ? bus_req_addr[LINE_OW-1:OFFSET_AW] : {LANE_AW{1'b0}};
+    assign req_hit                  = buf_vld_r & (buf_tag_r == req_tag) & bus_req_read;
+    assign req_miss                 = req_fire & (~req_hit);
+
+    assign req_fire                 = bus_req_vld & bus_req_rdy;
+    assign rsp_fire                 = bus_rsp_vld & bus_rsp_rdy;
+    assign line_req_fire            = line_req_vld & line_req_rdy;
+    assign line_rsp_fire            = line_rsp_vld & line_rsp_rdy;
+
+    assign bus_req_rdy              = (cur_state == FSM_IDLE) & ((~rsp_vld_r) | bus_rsp_rdy);
+    assign bus_rsp_vld              = rsp_vld_r;
+    assign bus_rsp_excp             = rsp_excp_r;
+    assign bus_rsp_data             = rsp_data_r;
+
+    assign line_req_vld             = cur_state == FSM_REQ;
+    assign line_req_read            = pend_read_r;
+    assign line_req_addr            = {pend_tag_r, {LINE_OW{1'b0}}};
+    assign line_req_mask            = pend_read_r ? {LINE_MW{1'b1}} : pend_mask_r;
+    assign line_req_data            = pend_data_r;
+    assign line_rsp_rdy             = cur_state == FSM_RSP;
+
+    assign wr_vld                   = line_rsp_fire & (~pend_read_r);
+    assign wr_addr                  = line_req_addr;
+
+    // A line written by the other side while being fetched is not kept.
+    assign pend_inv                 = inv_vld & (inv_addr[ALEN-1:LINE_OW] == pend_tag_r)
+                                    & (cur_state != FSM_IDLE);
+    assign buf_inv                  = inv_vld & (inv_addr[ALEN-1:LINE_OW] == buf_tag_r);
+    assign buf_fill                 = line_rsp_fire & pend_read_r & (~(|line_rsp_excp))
+                                    & (~pend_stale_r) & (~pend_inv);
+    assign buf_merge                = line_rsp_fire & (~pend_read_r) & (~(|line_rsp_excp))
+                                    & buf_vld_r & (buf_tag_r == pend_tag_r);
+
+    generate
+        for (i = 0; i < LINE_MW; i = i + 1) begin: gen_bit_mask
+            assign pend_bit_mask[i*8+7:i*8] = {8{pend_mask_r[i]}};
+        end
+    endgenerate
+
+    assign buf_merge_data           = (buf_data_r & (~pend_bit_mask)) | (pend_data_r & pend_bit_mask);
+
+    // FSM.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_state <= FSM_IDLE;
+        end
+        else begin
+            cur_state <= #UDLY nxt_state;
+        end
+    end
+
+    always @(*) begin
+        case (cur_state)
+            FSM_IDLE: nxt_state = req_miss      ? FSM_REQ  : FSM_IDLE;
+            FSM_REQ : nxt_state = line_req_fire ? FSM_RSP  : FSM_REQ;
+            FSM_RSP : nxt_state = line_rsp_fire ? FSM_IDLE : FSM_RSP;
+            default : nxt_state = FSM_IDLE;
+        endcase
+    end
+
+    // Pending access with data & mask in place.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            pend_read_r  <= 1'b0;
+            pend_tag_r   <= {LINE_AW{1'b0}};
+            pend_lane_r  <= {LANE_AW{1'b0}};
+            pend_mask_r  <= {LINE_MW{1'b0}};
+            pend_stale_r <= 1'b0;
+        end
+        else begin
+            if (req_miss) begin
+                pend_read_r  <= #UDLY bus_req_read;
+                pend_tag_r   <= #UDLY req_tag;
+                pend_lane_r  <= #UDLY req_lane;
+                pend_mask_r  <= #UDLY {{(LINE_MW-MLEN){1'b0}}, bus_req_mask} << (req_lane * MLEN);
+                pend_stale_r <= #UDLY 1'b0;
+            end
+            else if (pend_inv) begin
+                pend_stale_r <= #UDLY 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (req_miss) begin
+            pend_data_r <= #UDLY {{(LINE_DW-DLEN){1'b0}}, bus_req_data} << (req_lane * DLEN);
+        end
+    end
+
+    // Line buffer.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            buf_vld_r <= 1'b0;
+            buf_tag_r <= {LINE_AW{1'b0}};
+        end
+        else begin
+            if (buf_fill) begin
+                buf_vld_r <= #UDLY 1'b1;
+                buf_tag_r <= #UDLY pend_tag_r;
+            end
+            else if (buf_inv) begin
+                buf_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (buf_fill) begin
+            buf_data_r <= #UDLY line_rsp_data;
+        end
+        else if (buf_merge) begin
+            buf_data_r <= #UDLY buf_merge_data;
+        end
+    end
+
+    // Responses.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rsp_vld_r  <= 1'b0;
+            rsp_excp_r <= 2'b0;
+            rsp_data_r <= {DLEN{1'b0}};
+        end
+        else begin
+            if (req_fire & req_hit) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY 2'b0;
+                rsp_data_r <= #UDLY buf_data_r[req_lane*DLEN +: DLEN];
+            end
+            else if (line_rsp_fire) begin
+                rsp_vld_r  <= #UDLY 1'b1;
+                rsp_excp_r <= #UDLY line_rsp_excp;
+                rsp_data_r <= #UDLY line_rsp_data[pend_lane_r*DLEN +: DLEN];
+            end
+            else if (rsp_fire) begin
+                rsp_vld_r  <= #UDLY 1'b0;
+            end
+        end
+    end
+
+endmodule
@@ -7,6 +7,7 @@
 //
 // Description:
 //      Read-only Memory for Boot.
+//      Read bursts are expanded to back-to-back single reads.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -26,6 +27,8 @@ module uv_rom
     output                          rom_req_rdy,
     input                           rom_req_read,
     input  [ALEN-1:0]               rom_req_addr,
+    input  [3:0]                    rom_req_len,
+    input                           rom_req_wrap,
     input  [MLEN-1:0]               rom_req_mask,
     input  [DLEN-1:0]               rom_req_data,
 
@@ -37,6 +40,10 @@ module uv_rom
 
     localparam UDLY = 1;
 
+    wire                            req_vld;
+    wire                            req_rdy;
+    wire [ALEN-1:0]                 req_addr;
+
     wire [ROM_AW-1:0]               rom_addr;
     wire [63:0]                     rom_data;
 
@@ -46,10 +53,43 @@ module uv_rom
     reg                             rsp_vld_r;
     reg  [DLEN-1:0]                 rsp_data_r;
 
-    assign rom_addr                 = rom_req_addr[ROM_AW+1:2];
-    assign sft_data                 = rom_data >> {rom_req_addr[1:0], 3'b0};
+    uv_bus_burst
+    #(
+        .ALEN                       ( ALEN              ),
+        .DLEN                       ( DLEN              ),
+        .MLEN                       ( MLEN              )
+    )
+    u_burst
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .bst_req_vld                ( rom_req_vld       ),
+        .bst_req_rdy                ( rom_req_rdy       ),
+        .bst_req_read               ( rom_req_read      ),
+        .bst_req_addr               ( rom_req_addr      ),
+        .bst_req_len                ( rom_req_len       ),
+        .bst_req_wrap               ( rom_req_wrap      ),
+        .bst_req_amo                ( 4'b0              ),
+        .bst_req_mask               ( rom_req_mask      ),
+        .bst_req_data               ( rom_req_data      ),
+
+        .sgl_req_vld                ( req_vld           ),
+        .sgl_req_rdy                ( req_rdy           ),
+        .sgl_req_read               (                   ),
+        .sgl_req_addr               ( req_addr          ),
+        .sgl_req_amo                (                   ),
+        .sgl_req_mask               (                   ),
+        .sgl_req_data               (                   ),
+
+        .bst_busy                   (                   )
+    );
+
+    assign rom_addr                 = req_addr[ROM_AW+1:2];
+    assign sft_data                 = rom_data >> {req_addr[1:0], 3'b0};
 
-    assign rom_req_rdy              = 1'b1;
+    // Back-to-back reads are taken while the response is accepted.
+    assign req_rdy                  = (~rsp_vld_r) | rom_rsp_rdy;
     assign rom_rsp_vld              = rsp_vld_r;
     assign rom_rsp_excp             = 2'b0;
     assign rom_rsp_data             = rsp_data_r;
@@ -69,7 +109,7 @@ module uv_rom
             rsp_data_r <= {DLEN{1'b0}};
         end
         else begin
-            if (rom_req_vld & rom_req_rdy) begin
+            if (req_vld & req_rdy) begin
                 rsp_vld_r  <= #UDLY 1'b1;
                 rsp_data_r <= #UDLY rsp_data;
             end
@@ -0,0 +1,586 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_sdram_ctrl
+//
+// Designer: Owen
+//
+// Description:
+//      SDR SDRAM controller with two line ports.
+//      Each access is one burst of a whole line. Rows are
+//      left open after accesses (open-page policy), and a
+//      pending row hit is served before an older row miss,
+//      up to HIT_MAX times in a row to avoid starvation.
+//      Bank/row/column are mapped from MSB to LSB, so that
+//      sequential lines stay in the open row then move on to
+//      the next bank.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_sdram_ctrl
+#(
+    parameter DQ_DW                 = 16,
+    parameter BA_AW                 = 2,
+    parameter ROW_AW                = 13,   // Must be no less than 11 & COL_AW.
+    parameter COL_AW                = 9,
+    parameter PORT_AW               = ROW_AW + BA_AW + COL_AW + $clog2(DQ_DW / 8),
+    parameter LINE_DW               = 128,
+    parameter LINE_MW               = LINE_DW / 8,
+    // Timing in clock cycles.
+    parameter T_INIT                = 20000,    // 200us at 100MHz.
+    parameter T_RCD                 = 2,
+    parameter T_CL                  = 2,
+    parameter T_RP                  = 2,
+    parameter T_RAS                 = 5,
+    parameter T_WR                  = 2,
+    parameter T_RFC                 = 7,
+    parameter T_MRD                 = 2,
+    parameter T_REFI                = 780,      // 8192 rows per 64ms at 100MHz.
+    parameter HIT_MAX               = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           port_a_req_vld,
+    output                          port_a_req_rdy,
+    input                           port_a_req_read,
+    input  [PORT_AW-1:0]            port_a_req_addr,
+    input  [LINE_MW-1:0]            port_a_req_mask,
+    input  [LINE_DW-1:0]            port_a_req_data,
+
+    output                          port_a_rsp_vld,
+    input                           port_a_rsp_rdy,
+    output [1:0]                    port_a_rsp_excp,
+    output [LINE_DW-1:0]            port_a_rsp_data,
+
+    input                           port_b_req_vld,
+    output                          port_b_req_rdy,
+    input                           port_b_req_read,
+    input  [PORT_AW-1:0]            port_b_req_addr,
+    input  [LINE_MW-1:0]            port_b_req_mask,
+    input  [LINE_DW-1:0]            port_b_req_data,
+
+    output                          port_b_rsp_vld,
+    input                           port_b_rsp_rdy,
+    output [1:0]                    port_b_rsp_excp,
+    output [LINE_DW-1:0]            port_b_rsp_data,
+
+    output                          sdram_cke,
+    output                          sdram_cs_n,
+    output                          sdram_ras_n,
+    output                          sdram_cas_n,
+    output                          sdram_we_n,
+    output [BA_AW-1:0]              sdram_ba,
+    output [ROW_AW-1:0]             sdram_addr,
+    output [DQ_DW/8-1:0]            sdram_dqm,
+    output                          sdram_dq_oen,
+    output [DQ_DW-1:0]              sdram_dq_out,
+    input  [DQ_DW-1:0]              sdram_dq_in
+);
+
+    localparam UDLY                 = 1;
+    localparam PORT_NUM             = 2;
+    localparam DQ_MW                = DQ_DW / 8;
+    localparam DQ_OW                = $clog2(DQ_MW);
+    localparam BANK_NUM             = 2**BA_AW;
+    localparam BURST_LEN            = LINE_DW / DQ_DW;
+    localparam BURST_AW             = $clog2(BURST_LEN);
+    localparam LCOL_AW              = COL_AW - BURST_AW;
+    localparam COL_LSB              = DQ_OW + BURST_AW;
+    localparam BA_LSB               = DQ_OW + COL_AW;
+    localparam ROW_LSB              = BA_LSB + BA_AW;
+
+    localparam WAIT_W               = $clog2(T_INIT + 1);
+    localparam REFI_W               = $clog2(T_REFI + 1);
+    localparam BTMR_MAX             = T_RAS > T_WR ? T_RAS : T_WR;
+    localparam BTMR_W               = $clog2(BTMR_MAX + 1);
+    localparam BYP_W                = $clog2(HIT_MAX + 1);
+
+    // Mode register: burst write, CAS latency & sequential burst of a line.
+    localparam [2:0] MR_CL          = T_CL;
+    localparam [2:0] MR_BL          = BURST_AW;
+    localparam [ROW_AW-1:0] MODE_REG = {{(ROW_AW-9){1'b0}}, 2'b00, MR_CL, 1'b0, MR_BL};
+
+    // {CS#, RAS#, CAS#, WE#}.
+    localparam CMD_NOP              = 4'b0111;
+    localparam CMD_ACT              = 4'b0011;
+    localparam CMD_RD               = 4'b0101;
+    localparam CMD_WR               = 4'b0100;
+    localparam CMD_PRE              = 4'b0010;
+    localparam CMD_REF              = 4'b0001;
+    localparam CMD_MRS              = 4'b0000;
+
+    localparam FSM_INIT             = 4'd0;
+    localparam FSM_IPRE             = 4'd1;
+    localparam FSM_IREF             = 4'd2;
+    localparam FSM_IMRS             = 4'd3;
+    localparam FSM_IDLE             = 4'd4;
+    localparam FSM_PRE              = 4'd5;
+    localparam FSM_ACT              = 4'd6;
+    localparam FSM_RW               = 4'd7;
+    localparam FSM_WDAT             = 4'd8;
+    localparam FSM_RDAT             = 4'd9;
+    localparam FSM_PREA             = 4'd10;
+    localparam FSM_REF              = 4'd11;
+
+    genvar i;
+    integer j;
+
+    reg  [3:0]                      cur_state;
+    reg  [3:0]                      nxt_state;
+
+    // Ports.
+    wire [PORT_NUM-1:0]             req_vld;
+    wire [PORT_NUM-1:0]             req_rdy;
+    wire [PORT_NUM-1:0]             req_read;
+    wire [PORT_AW-1:0]              req_addr [PORT_NUM-1:0];
+    wire [LINE_MW-1:0]              req_mask [PORT_NUM-1:0];
+    wire [LINE_DW-1:0]              req_data [PORT_NUM-1:0];
+    wire [PORT_NUM-1:0]             rsp_rdy;
+
+    // Pending requests, one per port.
+    reg  [PORT_NUM-1:0]             slot_vld_r;
+    reg  [PORT_NUM-1:0]             slot_read_r;
+    reg  [PORT_AW-1:0]              slot_addr_r [PORT_NUM-1:0];
+    reg  [LINE_MW-1:0]              slot_mask_r [PORT_NUM-1:0];
+    reg  [LINE_DW-1:0]              slot_data_r [PORT_NUM-1:0];
+    wire [PORT_NUM-1:0]             slot_set;
+    wire [PORT_NUM-1:0]             slot_clr;
+    wire [PORT_NUM-1:0]             slot_keep;
+
+    reg  [PORT_NUM-1:0]             rsp_vld_r;
+    reg  [LINE_DW-1:0]              rsp_data_r [PORT_NUM-1:0];
+
+    // Scheduling.
+    wire [BA_AW-1:0]                slot_bank [PORT_NUM-1:0];
+    wire [ROW_AW-1:0]               slot_row  [PORT_NUM-1:0];
+    wire [PORT_NUM-1:0]             slot_elig;
+    wire [PORT_NUM-1:0]             slot_hit;
+    reg                             old_r;
+    reg  [BYP_W-1:0]                byp_cnt_r;
+    wire                            pick_both;
+    wire                            pick_yng;
+    wire                            pick_vld;
+    wire                            pick;
+    wire                            op_start;
+    wire                            op_done;
+
+    // Current operation.
+    reg                             cur_port_r;
+    reg                             cur_read_r;
+    reg  [BA_AW-1:0]                cur_bank_r;
+    reg  [ROW_AW-1:0]               cur_row_r;
+    reg  [LCOL_AW-1:0]              cur_col_r;
+    reg  [BURST_AW-1:0]             beat_r;
+    wire                            beat_last;
+    wire [DQ_DW-1:0]                beat_data;
+    wire [DQ_MW-1:0]                beat_mask;
+
+    // Banks.
+    reg  [BANK_NUM-1:0]             bank_open_r;
+    reg  [ROW_AW-1:0]               bank_row_r [BANK_NUM-1:0];
+    reg  [BTMR_W-1:0]               bank_tmr_r [BANK_NUM-1:0];
+    reg                             bank_tmr_zero;
+
+    // Timers.
+    reg  [WAIT_W-1:0]               wait_cnt_r;
+    wire                            wait_done;
+    reg  [REFI_W-1:0]               refi_cnt_r;
+    reg                             ref_due_r;
+    reg                             init_ref_r;
+
+    // Commands.
+    wire                            iss_ipre;
+    wire                            iss_iref;
+    wire                            iss_imrs;
+    wire                            iss_pre;
+    wire                            iss_act;
+    wire                            iss_rw;
+    wire                            iss_prea;
+    wire                            iss_ref;
+    wire                            dat_wr;
+    wire                            dat_rd;
+
+    reg                             cke_r;
+    reg  [3:0]                      cmd_r;
+    reg  [BA_AW-1:0]                ba_r;
+    reg  [ROW_AW-1:0]               addr_r;
+    reg  [DQ_MW-1:0]                dqm_r;
+    reg                             dq_oen_r;
+    reg  [DQ_DW-1:0]                dq_out_r;
+
+    // Flatten ports.
+    assign req_vld                  = {port_b_req_vld, port_a_req_vld};
+    assign req_read                 = {port_b_req_read, port_a_req_read};
+    assign req_addr[0]              = port_a_req_addr;
+    assign req_addr[1]              = port_b_req_addr;
+    assign req_mask[0]              = port_a_req_mask;
+    assign req_mask[1]              = port_b_req_mask;
+    assign req_data[0]              = port_a_req_data;
+    assign req_data[1]              = port_b_req_data;
+    assign rsp_rdy                  = {port_b_rsp_rdy, port_a_rsp_rdy};
+
+    assign port_a_req_rdy           = req_rdy[0];
+    assign port_b_req_rdy           = req_rdy[1];
+    assign port_a_rsp_vld           = rsp_vld_r[0];
+    assign port_b_rsp_vld           = rsp_vld_r[1];
+    assign port_a_rsp_excp          = 2'b0;
+    assign port_b_rsp_excp          = 2'b0;
+    assign port_a_rsp_data          = rsp_data_r[0];
+    assign port_b_rsp_data          = rsp_data_r[1];
+
+    assign sdram_cke                = cke_r;
+    assign sdram_cs_n               = cmd_r[3];
+    assign sdram_ras_n              = cmd_r[2];
+    assign sdram_cas_n              = cmd_r[1];
+    assign sdram_we_n               = cmd_r[0];
+    assign sdram_ba                 = ba_r;
+    assign sdram_addr               = addr_r;
+    assign sdram_dqm                = dqm_r;
+    assign sdram_dq_oen             = dq_oen_r;
+    assign sdram_dq_out             = dq_out_r;
+
+    // Request slots.
+    assign req_rdy                  = ~slot_vld_r;
+    assign slot_set                 = req_vld & req_rdy;
+    assign slot_clr                 = {PORT_NUM{op_done}} & {cur_port_r, ~cur_port_r};
+    assign slot_keep                = slot_vld_r & (~slot_clr);
+
+    generate
+        for (i = 0; i < PORT_NUM; i = i + 1) begin: gen_slot
+            assign slot_bank[i]     = slot_addr_r[i][BA_LSB+BA_AW-1:BA_LSB];
+            assign slot_row[i]      = slot_addr_r[i][ROW_LSB+ROW_AW-1:ROW_LSB];
+            // A response should be taken before the next one is ready.
+            assign slot_elig[i]     = slot_vld_r[i] & (~rsp_vld_r[i]);
+            assign slot_hit[i]      = bank_open_r[slot_bank[i]] & (bank_row_r[slot_bank[i]] == slot_row[i]);
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    slot_vld_r[i]  <= 1'b0;
+                    slot_read_r[i] <= 1'b0;
+                    slot_addr_r[i] <= {PORT_AW{1'b0}};
+                    slot_mask_r[i] <= {LINE_MW{1'b0}};
+                end
+                else begin
+                    if (slot_set[i]) begin
+                        slot_vld_r[i]  <= #UDLY 1'b1;
+                        slot_read_r[i] <= #UDLY req_read[i];
+                        slot_addr_r[i] <= #UDLY req_addr[i];
+                        slot_mask_r[i] <= #UDLY req_mask[i];
+                    end
+                    else if (slot_clr[i]) begin
+                        slot_vld_r[i]  <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            always @(posedge clk) begin
+                if (slot_set[i]) begin
+                    slot_data_r[i] <= #UDLY req_data[i];
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    rsp_vld_r[i] <= 1'b0;
+                end
+                else begin
+                    if (slot_clr[i]) begin
+                        rsp_vld_r[i] <= #UDLY 1'b1;
+                    end
+                    else if (rsp_rdy[i]) begin
+                        rsp_vld_r[i] <= #UDLY 1'b0;
+                    end
+                end
+            end
+
+            // Read beats are shifted into the response buffer of the current port.
+            always @(posedge clk) begin
+                if (dat_rd & (cur_port_r == i)) begin
+                    rsp_data_r[i] <= #UDLY {sdram_dq_in, rsp_data_r[i][LINE_DW-1:DQ_DW]};
+                end
+            end
+        end
+    endgenerate
+
+    // The request left from the last cycle is older than a new one.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            old_r <= 1'b0;
+        end
+        else begin
+            if (~(&slot_keep)) begin
+                old_r <= #UDLY (~slot_keep[0]) & slot_keep[1];
+            end
+        end
+    end
+
+    // Row hit first, then the oldest.
+    assign pick_both                = &slot_elig;
+    assign pick_yng                 = pick_both & slot_hit[~old_r] & (~slot_hit[old_r])
+                                    & (byp_cnt_r < HIT_MAX);
+    assign pick_vld                 = |slot_elig;
+    assign pick                     = pick_both ? (pick_yng ? ~old_r : old_r) : slot_elig[1];
+
+    assign op_start                 = (cur_state == FSM_IDLE) & (~ref_due_r) & pick_vld;
+    assign op_done                  = (dat_wr | dat_rd) & beat_last;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            byp_cnt_r <= {BYP_W{1'b0}};
+        end
+        else begin
+            if (op_start) begin
+                byp_cnt_r <= #UDLY pick_yng ? byp_cnt_r + 1'b1 : {BYP_W{1'b0}};
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_port_r <= 1'b0;
+            cur_read_r <= 1'b0;
+            cur_bank_r <= {BA_AW{1'b0}};
+            cur_row_r  <= {ROW_AW{1'b0}};
+            cur_col_r  <= {LCOL_AW{1'b0}};
+        end
+        else begin
+            if (op_start) begin
+                cur_port_r <= #UDLY pick;
+                cur_read_r <= #UDLY slot_read_r[pick];
+                cur_bank_r <= #UDLY slot_bank[pick];
+                cur_row_r  <= #UDLY slot_row[pick];
+                cur_col_r  <= #UDLY slot_addr_r[pick][COL_LSB+LCOL_AW-1:COL_LSB];
+            end
+        end
+    end
+
+    // FSM.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cur_state <= FSM_INIT;
+        end
+        else begin
+            cur_state <= #UDLY nxt_state;
+        end
+    end
+
+    always @(*) begin
+        case (cur_state)
+            FSM_INIT: nxt_state = wait_done ? FSM_IPRE : FSM_INIT;
+            FSM_IPRE: nxt_state = iss_ipre ? FSM_IREF : FSM_IPRE;
+            FSM_IREF: nxt_state = iss_iref & init_ref_r ? FSM_IMRS : FSM_IREF;
+            FSM_IMRS: nxt_state = iss_imrs ? FSM_IDLE : FSM_IMRS;
+            FSM_IDLE: begin
+                if (ref_due_r) begin
+                    nxt_state = (|bank_open_r) ? FSM_PREA : FSM_REF;
+                end
+                else if (pick_vld) begin
+                    nxt_state = slot_hit[pick] ? FSM_RW
+                              : bank_open_r[slot_bank[pick]] ? FSM_PRE : FSM_ACT;
+                end
+                else begin
+                    nxt_state = FSM_IDLE;
+                end
+            end
+            FSM_PRE : nxt_state = iss_pre ? FSM_ACT : FSM_PRE;
+            FSM_ACT : nxt_state = iss_act ? FSM_RW  : FSM_ACT;
+            FSM_RW  : nxt_state = iss_rw  ? (cur_read_r ? FSM_RDAT : FSM_WDAT) : FSM_RW;
+            FSM_WDAT: nxt_state = beat_last ? FSM_IDLE : FSM_WDAT;
+            FSM_RDAT: nxt_state = dat_rd & beat_last ? FSM_IDLE : FSM_RDAT;
+            FSM_PREA: nxt_state = iss_prea ? FSM_REF  : FSM_PREA;
+            FSM_REF : nxt_state = iss_ref  ? FSM_IDLE : FSM_REF;
+            default : nxt_state = FSM_IDLE;
+        endcase
+    end
+
+    // Command issuing. Commands are registered, so a wait of N cycles is loaded as N - 1.
+    assign wait_done                = ~(|wait_cnt_r);
+
+    assign iss_ipre                 = (cur_state == FSM_IPRE) & wait_done;
+    assign iss_iref                 = (cur_state == FSM_IREF) & wait_done;
+    assign iss_imrs                 = (cur_state == FSM_IMRS) & wait_done;
+    assign iss_pre                  = (cur_state == FSM_PRE)  & wait_done & (~(|bank_tmr_r[cur_bank_r]));
+    assign iss_act                  = (cur_state == FSM_ACT)  & wait_done;
+    assign iss_rw                   = (cur_state == FSM_RW)   & wait_done;
+    assign iss_ref                  = (cur_state == FSM_REF)  & wait_done;
+
+    always @(*) begin
+        bank_tmr_zero = 1'b1;
+        for (j = 0; j < BANK_NUM; j = j + 1) begin
+            bank_tmr_zero = bank_tmr_zero & (~(|bank_tmr_r[j]));
+        end
+    end
+    assign iss_prea                 = (cur_state == FSM_PREA) & wait_done & bank_tmr_zero;
+
+    // Data beats.
+    assign dat_wr                   = (iss_rw & (~cur_read_r)) | (cur_state == FSM_WDAT);
+    assign dat_rd                   = (cur_state == FSM_RDAT) & wait_done;
+    assign beat_last                = &beat_r;
+    assign beat_data                = slot_data_r[cur_port_r][beat_r*DQ_DW +: DQ_DW];
+    assign beat_mask                = slot_mask_r[cur_port_r][beat_r*DQ_MW +: DQ_MW];
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            beat_r <= {BURST_AW{1'b0}};
+        end
+        else begin
+            if (dat_wr | dat_rd) begin
+                beat_r <= #UDLY beat_r + 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            wait_cnt_r <= T_INIT - 1;
+        end
+        else begin
+            if (iss_ipre | iss_pre | iss_prea) begin
+                wait_cnt_r <= #UDLY T_RP - 1;
+            end
+            else if (iss_iref | iss_ref) begin
+                wait_cnt_r <= #UDLY T_RFC - 1;
+            end
+            else if (iss_imrs) begin
+                wait_cnt_r <= #UDLY T_MRD - 1;
+            end
+            else if (iss_act) begin
+                wait_cnt_r <= #UDLY T_RCD - 1;
+            end
+            else if (iss_rw & cur_read_r) begin
+                // The first beat is sampled T_CL cycles after the command is on the bus.
+                wait_cnt_r <= #UDLY T_CL;
+            end
+            else if (~wait_done) begin
+                wait_cnt_r <= #UDLY wait_cnt_r - 1'b1;
+            end
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            init_ref_r <= 1'b0;
+        end
+        else begin
+            if (iss_iref) begin
+                init_ref_r <= #UDLY 1'b1;
+            end
+        end
+    end
+
+    // Refresh.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            refi_cnt_r <= T_REFI - 1;
+            ref_due_r  <= 1'b0;
+        end
+        else begin
+            if (~(|refi_cnt_r)) begin
+                refi_cnt_r <= #UDLY T_REFI - 1;
+                ref_due_r  <= #UDLY 1'b1;
+            end
+            else begin
+                refi_cnt_r <= #UDLY refi_cnt_r - 1'b1;
+                if (iss_ref) begin
+                    ref_due_r <= #UDLY 1'b0;
+                end
+            end
+        end
+    end
+
+    // Banks.
+    generate
+        for (i = 0; i < BANK_NUM; i = i + 1) begin: gen_bank
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    bank_open_r[i] <= 1'b0;
+                    bank_row_r[i]  <= {ROW_AW{1'b0}};
+                end
+                else begin
+                    if (iss_prea | (iss_pre & (cur_bank_r == i))) begin
+                        bank_open_r[i] <= #UDLY 1'b0;
+                    end
+                    else if (iss_act & (cur_bank_r == i)) begin
+                        bank_open_r[i] <= #UDLY 1'b1;
+                        bank_row_r[i]  <= #UDLY cur_row_r;
+                    end
+                end
+            end
+
+            // Cycles left before precharging (tRAS after activating & tWR after writing).
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    bank_tmr_r[i] <= {BTMR_W{1'b0}};
+                end
+                else begin
+                    if (iss_act & (cur_bank_r == i)) begin
+                        bank_tmr_r[i] <= #UDLY T_RAS - 1;
+                    end
+                    else if (dat_wr & beat_last & (cur_bank_r == i) & (bank_tmr_r[i] < T_WR)) begin
+                        bank_tmr_r[i] <= #UDLY T_WR - 1;
+                    end
+                    else if (|bank_tmr_r[i]) begin
+                        bank_tmr_r[i] <= #UDLY bank_tmr_r[i] - 1'b1;
+                    end
+                end
+            end
+        end
+    endgenerate
+
+    // Command & data bus.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            cke_r    <= 1'b0;
+            cmd_r    <= CMD_NOP;
+            ba_r     <= {BA_AW{1'b0}};
+            addr_r   <= {ROW_AW{1'b0}};
+            dqm_r    <= {DQ_MW{1'b1}};
+            dq_oen_r <= 1'b1;
+            dq_out_r <= {DQ_DW{1'b0}};
+        end
+        else begin
+            cke_r    <= #UDLY 1'b1;
+            cmd_r    <= #UDLY CMD_NOP;
+            dqm_r    <= #UDLY {DQ_MW{1'b0}};
+            dq_oen_r <= #UDLY 1'b1;
+
+            if (iss_ipre | iss_prea) begin
+                cmd_r      <= #UDLY CMD_PRE;
+                addr_r[10] <= #UDLY 1'b1;
+            end
+            else if (iss_iref | iss_ref) begin
+                cmd_r      <= #UDLY CMD_REF;
+            end
+            else if (iss_imrs) begin
+                cmd_r      <= #UDLY CMD_MRS;
+                ba_r       <= #UDLY {BA_AW{1'b0}};
+                addr_r     <= #UDLY MODE_REG;
+            end
+            else if (iss_pre) begin
+                cmd_r      <= #UDLY CMD_PRE;
+                ba_r       <= #UDLY cur_bank_r;
+                addr_r[10] <= #UDLY 1'b0;
+            end
+            else if (iss_act) begin
+                cmd_r      <= #UDLY CMD_ACT;
+                ba_r       <= #UDLY cur_bank_r;
+                addr_r     <= #UDLY cur_row_r;
+            end
+            else if (iss_rw) begin
+                cmd_r      <= #UDLY cur_read_r ? CMD_RD : CMD_WR;
+                ba_r       <= #UDLY cur_bank_r;
+                addr_r     <= #UDLY {{(ROW_AW-COL_AW){1'b0}}, cur_col_r, {BURST_AW{1'b0}}};
+            end
+
+            if (dat_wr) begin
+                dqm_r      <= #UDLY ~beat_mask;
+                dq_oen_r   <= #UDLY 1'b0;
+                dq_out_r   <= #UDLY beat_data;
+            end
+        end
+    end
+
+endmodule
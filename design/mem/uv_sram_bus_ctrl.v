@@ -7,6 +7,7 @@
 //
 // Description:
 //      Controller from bus to ram.
+//      Read bursts are expanded to back-to-back single reads.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -27,6 +28,8 @@ module uv_sram_bus_ctrl
     output                          sram_req_rdy,
     input                           sram_req_read,
     input  [ALEN-1:0]               sram_req_addr,
+    input  [3:0]                    sram_req_len,
+    input                           sram_req_wrap,
     input  [MLEN-1:0]               sram_req_mask,
     input  [DLEN-1:0]               sram_req_data,
 
@@ -46,6 +49,14 @@ module uv_sram_bus_ctrl
     localparam UDLY = 1;
     localparam OFFSET_AW = $clog2(DLEN / 8);
 
+    wire                            req_vld;
+    wire                            req_rdy;
+    wire                            req_read;
+    wire [ALEN-1:0]                 req_addr;
+    wire [MLEN-1:0]                 req_mask;
+    wire [DLEN-1:0]                 req_data;
+    wire                            req_fire;
+
     wire                            addr_overflow;
     wire                            addr_misalign;
     reg                             addr_misalign_r;
@@ -77,31 +88,63 @@ module uv_sram_bus_ctrl
     reg  [DLEN-1:0]                 rsft_rdat_r;
     reg  [DLEN-1:0]                 rsp_data_r;
 
-    wire                            sram_req_fire;
     wire                            sram_rsp_fire;
 
     reg                             sram_rsp_vld_r;
     reg                             sram_rsp_excp_r;
     reg  [DLEN-1:0]                 sram_rsp_data_r;
 
-    assign byte_offset              = sram_req_addr[OFFSET_AW-1:0];
+    uv_bus_burst
+    #(
+        .ALEN                       ( ALEN              ),
+        .DLEN                       ( DLEN              ),
+        .MLEN                       ( MLEN              )
+    )
+    u_burst
+    (
+        .clk                        ( clk               ),
+        .rst_n                      ( rst_n             ),
+
+        .bst_req_vld                ( sram_req_vld      ),
+        .bst_req_rdy                ( sram_req_rdy      ),
+        .bst_req_read               ( sram_req_read     ),
+        .bst_req_addr               ( sram_req_addr     ),
+        .bst_req_len                ( sram_req_len      ),
+        .bst_req_wrap               ( sram_req_wrap     ),
+        .bst_req_amo                ( 4'b0              ),
+        .bst_req_mask               ( sram_req_mask     ),
+        .bst_req_data               ( sram_req_data     ),
+
+        .sgl_req_vld                ( req_vld           ),
+        .sgl_req_rdy                ( req_rdy           ),
+        .sgl_req_read               ( req_read          ),
+        .sgl_req_addr               ( req_addr          ),
+        .sgl_req_amo                (                   ),
+        .sgl_req_mask               ( req_mask          ),
+        .sgl_req_data               ( req_data          ),
+
+        .bst_busy                   (                   )
+    );
+
+    assign byte_offset              = req_addr[OFFSET_AW-1:0];
     assign diff_offset              = {1'b1, {OFFSET_AW{1'b0}}} - byte_offset;
-    assign base_addr                = sram_req_addr[SRAM_AW+OFFSET_AW-1:OFFSET_AW];
+    assign base_addr                = req_addr[SRAM_AW+OFFSET_AW-1:OFFSET_AW];
     assign base_addr_add            = base_addr + 1'b1;
 
-    assign addr_misalign            = sram_req_vld & (|byte_offset);
-    assign addr_overflow            = (sram_req_vld && (base_addr >= SRAM_DP))
+    // Only accesses crossing the word boundary need a second cycle.
+    assign addr_misalign            = req_vld & (|byte_offset) & (|rsft_mask);
+    assign addr_overflow            = (req_vld && (base_addr >= SRAM_DP))
                                     | (addr_misalign_r && (base_addr_r >= SRAM_DP));
 
     assign misalign_hit             = addr_misalign & addr_misalign_r;
 
-    assign lsft_wdat                = sram_req_data << {byte_offset, 3'b0};
-    assign lsft_mask                = sram_req_mask << byte_offset;
-    assign rsft_wdat                = sram_req_data >> {diff_offset, 3'b0};
-    assign rsft_mask                = sram_req_mask >> diff_offset;
+    assign lsft_wdat                = req_data << {byte_offset, 3'b0};
+    assign lsft_mask                = req_mask << byte_offset;
+    assign rsft_wdat                = req_data >> {diff_offset, 3'b0};
+    assign rsft_mask                = req_mask >> diff_offset;
 
-    assign sram_ce                  = (sram_req_vld | misalign_hit) & (~addr_overflow);
-    assign sram_we                  = misalign_hit ? ~req_read_r : ~sram_req_read;
+    assign sram_ce                  = (req_vld | misalign_hit) & (~addr_overflow);
+    assign sram_we                  = misalign_hit ? ~req_read_r : ~req_read;
     assign sram_addr                = misalign_hit ? base_addr_r : base_addr;
     assign sram_wdat                = misalign_hit ? req_data_r  : lsft_wdat;
     assign sram_mask                = misalign_hit ? req_mask_r  : lsft_mask;
@@ -110,14 +153,14 @@ module uv_sram_bus_ctrl
     assign lsft_rdat                = sram_rdat << {diff_offset_r, 3'b0};
     assign comb_rdat                = rsft_rdat_r | lsft_rdat;
 
-    assign sram_req_fire            = sram_req_vld & sram_req_rdy;
+    assign req_fire                 = req_vld & req_rdy;
     assign sram_rsp_fire            = sram_rsp_vld & sram_rsp_rdy;
 
-    assign sram_req_rdy             = ~addr_misalign | addr_misalign_r;
+    assign req_rdy                  = ~addr_misalign | addr_misalign_r;
     assign sram_rsp_vld             = sram_rsp_vld_r;
     assign sram_rsp_excp            = {1'b0, sram_rsp_excp_r};
     assign sram_rsp_data            = addr_misalign_rr ? comb_rdat
-                                    : ~addr_misalign_r & ram_read_p ? sram_rdat
+                                    : ~addr_misalign_r & ram_read_p ? rsft_rdat
                                     : rsp_data_r;
 
     always @(posedge clk or negedge rst_n) begin
@@ -150,7 +193,7 @@ module uv_sram_bus_ctrl
             byte_offset_r <= {OFFSET_AW{1'b0}};
         end
         else begin
-            if (sram_req_vld) begin
+            if (req_vld) begin
                 byte_offset_r <= #UDLY byte_offset;
             end
         end
@@ -184,7 +227,7 @@ module uv_sram_bus_ctrl
         end
         else begin
             if (addr_misalign) begin
-                req_read_r <= #UDLY sram_req_read;
+                req_read_r <= #UDLY req_read;
             end
         end
     end
@@ -207,7 +250,7 @@ module uv_sram_bus_ctrl
             sram_rsp_vld_r <= 1'b0;
         end
         else begin
-            if (sram_req_fire) begin
+            if (req_fire) begin
                 sram_rsp_vld_r <= #UDLY 1'b1;
             end
             else if (sram_rsp_fire) begin
@@ -221,7 +264,7 @@ module uv_sram_bus_ctrl
             sram_rsp_excp_r <= 1'b0;
         end
         else begin
-            if (sram_req_fire) begin
+            if (req_fire) begin
                 sram_rsp_excp_r <= #UDLY addr_overflow;
             end
             else if (sram_rsp_fire) begin
@@ -259,7 +302,7 @@ module uv_sram_bus_ctrl
                 rsp_data_r <= #UDLY comb_rdat;
             end
             else if (~addr_misalign_r & ram_read_p) begin
-                rsp_data_r <= #UDLY sram_rdat;
+                rsp_data_r <= #UDLY rsft_rdat;
             end
         end
     end
@@ -118,14 +118,14 @@ module uv_sram_dp
     endgenerate
     
     generate
-        if (RAM_DLY == 0) begin: gen_qa_without_dly
+        if (RAM_DLY == 0) begin: gen_qb_without_dly
             always @(posedge clk) begin
                 if (rb) begin
                     qb_r <= #UDLY ram[ab];
                 end
             end
         end
-        else begin: gen_qa_with_dly
+        else begin: gen_qb_with_dly
             always @(posedge clk) begin
                 if (rb) begin
                     repeat(RAM_DLY) @(posedge clk);
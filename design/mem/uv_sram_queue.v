@@ -0,0 +1,195 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_sram_queue
+//
+// Designer: Owen
+//
+// Description:
+//      First-In-First-Out Queue in dual-port SRAM, with the
+//      ports of uv_queue. The head element is read ahead into
+//      the SRAM output, so it is ready 2 cycles after written
+//      into an empty queue, and elements can be read back to
+//      back. RD_RDY is asserted when the head is there & will
+//      still be there after this cycle.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_sram_queue
+#(
+    parameter DAT_WIDTH         = 8,
+    parameter PTR_WIDTH         = 8,
+    parameter QUE_DEPTH         = 2**PTR_WIDTH
+)
+(
+    input                       clk,
+    input                       rst_n,
+
+    // Write channel.
+    output                      wr_rdy,
+    input                       wr_vld,
+    input  [DAT_WIDTH-1:0]      wr_dat,
+
+    // Read channel.
+    output                      rd_rdy,
+    input                       rd_vld,
+    output [DAT_WIDTH-1:0]      rd_dat,
+
+    // Control & status.
+    input                       clr,
+    output [PTR_WIDTH:0]        len,
+    output                      full,
+    output                      empty
+);
+
+    localparam UDLY             = 1;
+    localparam LEN_WIDTH        = PTR_WIDTH + 1;
+    localparam SUB_DEPTH        = QUE_DEPTH - 1;
+
+    reg  [PTR_WIDTH-1:0]        wr_ptr_r;
+    reg  [PTR_WIDTH-1:0]        rd_ptr_r;
+    reg  [LEN_WIDTH-1:0]        ram_cnt_r;
+    reg                         head_vld_r;
+
+    wire                        wr_fire;
+    wire                        rd_fire;
+    wire                        wr_only;
+    wire                        ram_rd;
+
+    wire [PTR_WIDTH-1:0]        wr_ptr_add;
+    wire [PTR_WIDTH-1:0]        rd_ptr_add;
+    wire [PTR_WIDTH-1:0]        wr_ptr_nxt;
+    wire [PTR_WIDTH-1:0]        rd_ptr_nxt;
+    wire [PTR_WIDTH-1:0]        ram_wr_addr;
+
+    // Elements are either in SRAM or at the head.
+    assign len                  = ram_cnt_r + {{PTR_WIDTH{1'b0}}, head_vld_r};
+    assign full                 = len == QUE_DEPTH[LEN_WIDTH-1:0];
+    assign empty                = len == {LEN_WIDTH{1'b0}};
+
+    // Bypass request under illegal status.
+    assign wr_fire              = wr_vld & (~full);
+    assign rd_fire              = rd_vld & head_vld_r & (~clr);
+    assign wr_only              = wr_fire & (~rd_fire);
+
+    // Read ahead when the head is empty or leaving.
+    assign ram_rd               = (~clr) & (|ram_cnt_r) & ((~head_vld_r) | rd_fire);
+
+    // Back pressure.
+    assign wr_rdy               = clr | (len < SUB_DEPTH[LEN_WIDTH-1:0])
+                                | ((len == SUB_DEPTH[LEN_WIDTH-1:0]) & (~wr_only));
+    assign rd_rdy               = (~clr) & head_vld_r & ((~rd_fire) | ram_rd);
+
+    // Calculate pointers.
+    assign wr_ptr_add           = wr_ptr_r + 1'b1;
+    assign rd_ptr_add           = rd_ptr_r + 1'b1;
+    assign wr_ptr_nxt           = wr_ptr_add < QUE_DEPTH ? wr_ptr_add : {PTR_WIDTH{1'b0}};
+    assign rd_ptr_nxt           = rd_ptr_add < QUE_DEPTH ? rd_ptr_add : {PTR_WIDTH{1'b0}};
+    assign ram_wr_addr          = clr ? {PTR_WIDTH{1'b0}} : wr_ptr_r;
+
+    // Update written pointer.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            wr_ptr_r <= {PTR_WIDTH{1'b0}};
+        end
+        else begin
+            if (clr & (~wr_fire)) begin
+                wr_ptr_r <= #UDLY {PTR_WIDTH{1'b0}};
+            end
+            else if (clr & wr_fire) begin
+                wr_ptr_r <= #UDLY {{(PTR_WIDTH-1){1'b0}}, 1'b1};
+            end
+            else if (wr_fire) begin
+                wr_ptr_r <= #UDLY wr_ptr_nxt;
+            end
+        end
+    end
+
+    // Update read pointer.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            rd_ptr_r <= {PTR_WIDTH{1'b0}};
+        end
+        else begin
+            if (clr) begin
+                rd_ptr_r <= #UDLY {PTR_WIDTH{1'b0}};
+            end
+            else if (ram_rd) begin
+                rd_ptr_r <= #UDLY rd_ptr_nxt;
+            end
+        end
+    end
+
+    // Update the number of elements in SRAM.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            ram_cnt_r <= {LEN_WIDTH{1'b0}};
+        end
+        else begin
+            if (clr) begin
+                ram_cnt_r <= #UDLY wr_fire ? {{(LEN_WIDTH-1){1'b0}}, 1'b1} : {LEN_WIDTH{1'b0}};
+            end
+            else if (wr_fire & (~ram_rd)) begin
+                ram_cnt_r <= #UDLY ram_cnt_r + 1'b1;
+            end
+            else if ((~wr_fire) & ram_rd) begin
+                ram_cnt_r <= #UDLY ram_cnt_r - 1'b1;
+            end
+        end
+    end
+
+    // Update the head status.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            head_vld_r <= 1'b0;
+        end
+        else begin
+            if (clr) begin
+                head_vld_r <= #UDLY 1'b0;
+            end
+            else if (ram_rd) begin
+                head_vld_r <= #UDLY 1'b1;
+            end
+            else if (rd_fire) begin
+                head_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+`ifdef ASIC
+
+    // RAM instantiation for specific process.
+
+`else
+
+    uv_sram_dp
+    #(
+        .RAM_AW                 ( PTR_WIDTH         ),
+        .RAM_DP                 ( QUE_DEPTH         ),
+        .RAM_DW                 ( DAT_WIDTH         ),
+        .RAM_MW                 ( 1                 ),
+        .RAM_DLY                ( 0                 )
+    )
+    u_ram
+    (
+        .clk                    ( clk               ),
+
+        .cea                    ( wr_fire           ),
+        .wea                    ( 1'b1              ),
+        .aa                     ( ram_wr_addr       ),
+        .da                     ( wr_dat            ),
+        .ma                     ( 1'b1              ),
+        .qa                     (                   ),
+
+        .ceb                    ( ram_rd            ),
+        .web                    ( 1'b0              ),
+        .ab                     ( rd_ptr_r          ),
+        .db                     ( {DAT_WIDTH{1'b0}} ),
+        .mb                     ( 1'b0              ),
+        .qb                     ( rd_dat            )
+    );
+
+`endif
+
+endmodule
@@ -0,0 +1,126 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_arb_qos
+//
+// Designer: Owen
+//
+// Description:
+//      QoS arbiter. Requests of the highest class are granted
+//      in weighted round-robin, where a master keeps its turn
+//      for WGT+1 grants in a row. A request that has lost LIM
+//      grants is granted before any class, so waiting is
+//      bounded. LIM of 0 turns the bound off.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_arb_qos
+#(
+    parameter WIDTH = 2,
+    parameter CLS_W = 2,
+    parameter WGT_W = 4,
+    parameter LIM_W = 8
+)
+(
+    input                       clk,
+    input                       rst_n,
+    input  [WIDTH*CLS_W-1:0]    cls,
+    input  [WIDTH*WGT_W-1:0]    wgt,
+    input  [LIM_W-1:0]          lim,
+    input  [WIDTH-1:0]          req,
+    output [WIDTH-1:0]          grant
+);
+
+    localparam UDLY             = 1;
+    genvar i;
+    integer k;
+
+    reg    [WIDTH-1:0]          prio_r;
+    reg    [WIDTH-1:0]          last_r;
+    reg    [WGT_W-1:0]          cred_r;
+    reg    [LIM_W-1:0]          wait_r [WIDTH-1:0];
+
+    reg    [CLS_W-1:0]          cls_max;
+    reg    [WGT_W-1:0]          grant_wgt;
+    wire   [WIDTH-1:0]          cls_top;
+    wire   [WIDTH-1:0]          starve;
+    wire   [WIDTH-1:0]          cand;
+    wire   [WIDTH*2-1:0]        cand_d;
+    wire   [WIDTH*2-1:0]        cand_sub;
+    wire   [WIDTH*2-1:0]        grant_d;
+    wire                        grant_again;
+    wire   [WGT_W-1:0]          cred_nxt;
+
+    // Highest class of requests.
+    always @(*) begin
+        cls_max = {CLS_W{1'b0}};
+        for (k = 0; k < WIDTH; k = k + 1) begin
+            if (req[k] && (cls[k*CLS_W+:CLS_W] > cls_max)) begin
+                cls_max = cls[k*CLS_W+:CLS_W];
+            end
+        end
+    end
+
+    generate
+        for (i = 0; i < WIDTH; i = i + 1) begin: gen_cand
+            assign cls_top[i] = req[i] & (cls[i*CLS_W+:CLS_W] == cls_max);
+            assign starve[i]  = req[i] & (|lim) & (wait_r[i] >= lim);
+        end
+    endgenerate
+
+    // Round-robin among starving requests, or those of the highest class.
+    assign cand                 = (|starve) ? starve : cls_top;
+    assign cand_d               = {cand, cand};
+    assign cand_sub             = cand_d - prio_r;
+    assign grant_d              = cand_d & (~cand_sub);
+    assign grant                = grant_d[WIDTH-1:0] | grant_d[2*WIDTH-1:WIDTH];
+
+    always @(*) begin
+        grant_wgt = {WGT_W{1'b0}};
+        for (k = 0; k < WIDTH; k = k + 1) begin
+            grant_wgt = grant_wgt | ({WGT_W{grant[k]}} & wgt[k*WGT_W+:WGT_W]);
+        end
+    end
+
+    // The granted master keeps the priority till its credits run out.
+    assign grant_again          = (grant == last_r) & (|cred_r);
+    assign cred_nxt             = grant_again ? cred_r - 1'b1 : grant_wgt;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            prio_r <= {{(WIDTH-1){1'b0}}, 1'b1};
+            last_r <= {WIDTH{1'b0}};
+            cred_r <= {WGT_W{1'b0}};
+        end
+        else begin
+            if (|req) begin
+                prio_r <= #UDLY (|cred_nxt) ? grant : {grant[WIDTH-2:0], grant[WIDTH-1]};
+                last_r <= #UDLY grant;
+                cred_r <= #UDLY cred_nxt;
+            end
+        end
+    end
+
+    // Count grants lost by each request.
+    generate
+        for (i = 0; i < WIDTH; i = i + 1) begin: gen_wait
+            always @(posedge clk or negedge rst_n) begin
+                if (~rst_n) begin
+                    wait_r[i] <= {LIM_W{1'b0}};
+                end
+                else begin
+                    if (|req) begin
+                        if (grant[i] | (~req[i])) begin
+                            wait_r[i] <= #UDLY {LIM_W{1'b0}};
+                        end
+                        else if (~(&wait_r[i])) begin
+                            wait_r[i] <= #UDLY wait_r[i] + 1'b1;
+                        end
+                    end
+                end
+            end
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,80 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_reg_slice
+//
+// Designer: Owen
+//
+// Description:
+//      Register slice for valid-ready handshakes.
+//      Both the forward & backward paths are registered,
+//      and a skid entry keeps full throughput.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_reg_slice
+#(
+    parameter DAT_WIDTH             = 32
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input                           in_vld,
+    output                          in_rdy,
+    input  [DAT_WIDTH-1:0]          in_dat,
+
+    output                          out_vld,
+    input                           out_rdy,
+    output [DAT_WIDTH-1:0]          out_dat
+);
+
+    localparam UDLY                 = 1;
+
+    reg                             out_vld_r;
+    reg  [DAT_WIDTH-1:0]            out_dat_r;
+    reg                             skid_vld_r;
+    reg  [DAT_WIDTH-1:0]            skid_dat_r;
+
+    wire                            in_fire;
+    wire                            out_stall;
+
+    assign in_rdy                   = ~skid_vld_r;
+    assign out_vld                  = out_vld_r;
+    assign out_dat                  = out_dat_r;
+
+    assign in_fire                  = in_vld & in_rdy;
+    assign out_stall                = out_vld_r & (~out_rdy);
+
+    // The skid entry is taken when output is stalled.
+    always @(posedge clk or negedge rst_n) begin
+        if (~rst_n) begin
+            out_vld_r  <= 1'b0;
+            skid_vld_r <= 1'b0;
+        end
+        else begin
+            if (out_stall) begin
+                if (in_fire) begin
+                    skid_vld_r <= #UDLY 1'b1;
+                end
+            end
+            else begin
+                out_vld_r  <= #UDLY skid_vld_r | in_vld;
+                skid_vld_r <= #UDLY 1'b0;
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        if (out_stall) begin
+            if (in_fire) begin
+                skid_dat_r <= #UDLY in_dat;
+            end
+        end
+        else begin
+            out_dat_r <= #UDLY skid_vld_r ? skid_dat_r : in_dat;
+        end
+    end
+
+endmodule
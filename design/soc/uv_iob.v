@@ -24,7 +24,16 @@ module uv_iob
     input                       io_btn_rst_n,
 
 `ifdef USE_EXT_MEM
-    // TODO.
+    output                      io_sdram_clk,
+    output                      io_sdram_cke,
+    output                      io_sdram_cs_n,
+    output                      io_sdram_ras_n,
+    output                      io_sdram_cas_n,
+    output                      io_sdram_we_n,
+    output [1:0]                io_sdram_ba,
+    output [12:0]               io_sdram_addr,
+    output [1:0]                io_sdram_dqm,
+    inout  [15:0]               io_sdram_dq,
 `endif
 
 `ifdef HAS_JTAG
@@ -39,6 +48,12 @@ module uv_iob
     inout                       io_i2c_sda,
 `endif
 
+`ifdef HAS_QSPI
+    output                      io_qspi_sck,
+    output [3:0]                io_qspi_cs,
+    inout  [3:0]                io_qspi_io,
+`endif
+
     inout  [IO_NUM-1:0]         io_gpio,
 
     // To Internal.
@@ -48,6 +63,21 @@ module uv_iob
 `endif
     output                      btn_rst_n,
 
+`ifdef USE_EXT_MEM
+    input                       sdram_clk,
+    input                       sdram_cke,
+    input                       sdram_cs_n,
+    input                       sdram_ras_n,
+    input                       sdram_cas_n,
+    input                       sdram_we_n,
+    input  [1:0]                sdram_ba,
+    input  [12:0]               sdram_addr,
+    input  [1:0]                sdram_dqm,
+    input                       sdram_dq_oen,
+    input  [15:0]               sdram_dq_out,
+    output [15:0]               sdram_dq_in,
+`endif
+
 `ifdef HAS_JTAG
     output                      jtag_tck,
     output                      jtag_tms,
@@ -64,6 +94,14 @@ module uv_iob
     input                       i2c_sda_oen,
 `endif
 
+`ifdef HAS_QSPI
+    input                       qspi_sck,
+    input  [3:0]                qspi_cs,
+    input  [3:0]                qspi_oen,
+    input  [3:0]                qspi_sdo,
+    output [3:0]                qspi_sdi,
+`endif
+
     input  [IO_NUM-1:0]         gpio_pu,
     input  [IO_NUM-1:0]         gpio_pd,
     input  [IO_NUM-1:0]         gpio_ie,
@@ -115,6 +153,20 @@ module uv_iob
 `endif
     assign btn_rst_n            = io_btn_rst_n;
 
+`ifdef USE_EXT_MEM
+    assign io_sdram_clk         = sdram_clk;
+    assign io_sdram_cke         = sdram_cke;
+    assign io_sdram_cs_n        = sdram_cs_n;
+    assign io_sdram_ras_n       = sdram_ras_n;
+    assign io_sdram_cas_n       = sdram_cas_n;
+    assign io_sdram_we_n        = sdram_we_n;
+    assign io_sdram_ba          = sdram_ba;
+    assign io_sdram_addr        = sdram_addr;
+    assign io_sdram_dqm         = sdram_dqm;
+    assign io_sdram_dq          = ~sdram_dq_oen ? sdram_dq_out : 16'bz;
+    assign sdram_dq_in          = io_sdram_dq;
+`endif
+
 `ifdef HAS_JTAG
     assign jtag_tck             = io_jtag_tck;
     assign jtag_tms             = io_jtag_tms;
@@ -129,6 +181,18 @@ module uv_iob
     assign io_i2c_sda           = ~i2c_sda_oen ? i2c_sda_out : 1'bz;
 `endif
 
+`ifdef HAS_QSPI
+    assign io_qspi_sck          = qspi_sck;
+    assign io_qspi_cs           = qspi_cs;
+    assign qspi_sdi             = io_qspi_io;
+
+    generate
+        for (i = 0; i < 4; i = i + 1) begin: gen_qspi_pad
+            assign io_qspi_io[i] = ~qspi_oen[i] ? qspi_sdo[i] : 1'bz;
+        end
+    endgenerate
+`endif
+
     generate
         for (i = 0; i < IO_NUM; i = i + 1) begin: gen_gpio_pad
             assign gpio_in[i]   = gpio_ie[i] ? io_gpio[i]
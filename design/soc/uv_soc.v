@@ -23,7 +23,17 @@ module uv_soc
     input                       io_btn_rst_n,
 
 `ifdef USE_EXT_MEM
-    // TODO.
+    // SDRAM.
+    output                      io_sdram_clk,
+    output                      io_sdram_cke,
+    output                      io_sdram_cs_n,
+    output                      io_sdram_ras_n,
+    output                      io_sdram_cas_n,
+    output                      io_sdram_we_n,
+    output [1:0]                io_sdram_ba,
+    output [12:0]               io_sdram_addr,
+    output [1:0]                io_sdram_dqm,
+    inout  [15:0]               io_sdram_dq,
 `endif
 
 `ifdef HAS_JTAG
@@ -40,6 +50,13 @@ module uv_soc
     inout                       io_i2c_sda,
 `endif
 
+`ifdef HAS_QSPI
+    // QSPI flash.
+    output                      io_qspi_sck,
+    output [3:0]                io_qspi_cs,
+    inout  [3:0]                io_qspi_io,
+`endif
+
     // GPIO (reused for SPI, UART, etc.)
     inout  [IO_NUM-1:0]         io_gpio
 );
@@ -73,6 +90,27 @@ module uv_soc
     wire                        i2c_sda_oen;
 `endif
 
+`ifdef USE_EXT_MEM
+    wire                        sdram_clk;
+    wire                        sdram_cke;
+    wire                        sdram_cs_n;
+    wire                        sdram_ras_n;
+    wire                        sdram_cas_n;
+    wire                        sdram_we_n;
+    wire [1:0]                  sdram_ba;
+    wire [12:0]                 sdram_addr;
+    wire [1:0]                  sdram_dqm;
+    wire                        sdram_dq_oen;
+    wire [15:0]                 sdram_dq_out;
+    wire [15:0]                 sdram_dq_in;
+`endif
+
+    wire                        qspi_sck;
+    wire [3:0]                  qspi_cs;
+    wire [3:0]                  qspi_oen;
+    wire [3:0]                  qspi_sdo;
+    wire [3:0]                  qspi_sdi;
+
     wire [IO_NUM-1:0]           gpio_pu;
     wire [IO_NUM-1:0]           gpio_pd;
     wire [IO_NUM-1:0]           gpio_ie;
@@ -94,6 +132,21 @@ module uv_soc
         .sys_rst_n              ( sys_rst_n         ),
         .por_rst_n              ( por_rst_n         ),
 
+    `ifdef USE_EXT_MEM
+        .sdram_clk              ( sdram_clk         ),
+        .sdram_cke              ( sdram_cke         ),
+        .sdram_cs_n             ( sdram_cs_n        ),
+        .sdram_ras_n            ( sdram_ras_n       ),
+        .sdram_cas_n            ( sdram_cas_n       ),
+        .sdram_we_n             ( sdram_we_n        ),
+        .sdram_ba               ( sdram_ba          ),
+        .sdram_addr             ( sdram_addr        ),
+        .sdram_dqm              ( sdram_dqm         ),
+        .sdram_dq_oen           ( sdram_dq_oen      ),
+        .sdram_dq_out           ( sdram_dq_out      ),
+        .sdram_dq_in            ( sdram_dq_in       ),
+    `endif
+
     `ifdef HAS_JTAG
         .jtag_tck               ( jtag_tck          ),
         .jtag_tms               ( jtag_tms          ),
@@ -122,6 +175,16 @@ module uv_soc
         .i2c_sda_oen            (                   ),
     `endif
 
+        .qspi_sck               ( qspi_sck          ),
+        .qspi_cs                ( qspi_cs           ),
+        .qspi_oen               ( qspi_oen          ),
+        .qspi_sdo               ( qspi_sdo          ),
+    `ifdef HAS_QSPI
+        .qspi_sdi               ( qspi_sdi          ),
+    `else
+        .qspi_sdi               ( 4'hF              ),
+    `endif
+
         .gpio_pu                ( gpio_pu           ),
         .gpio_pd                ( gpio_pd           ),
         .gpio_ie                ( gpio_ie           ),
@@ -237,7 +300,16 @@ module uv_soc
         .io_btn_rst_n           ( io_btn_rst_n      ),
 
     `ifdef USE_EXT_MEM
-        // TODO.
+        .io_sdram_clk           ( io_sdram_clk      ),
+        .io_sdram_cke           ( io_sdram_cke      ),
+        .io_sdram_cs_n          ( io_sdram_cs_n     ),
+        .io_sdram_ras_n         ( io_sdram_ras_n    ),
+        .io_sdram_cas_n         ( io_sdram_cas_n    ),
+        .io_sdram_we_n          ( io_sdram_we_n     ),
+        .io_sdram_ba            ( io_sdram_ba       ),
+        .io_sdram_addr          ( io_sdram_addr     ),
+        .io_sdram_dqm           ( io_sdram_dqm      ),
+        .io_sdram_dq            ( io_sdram_dq       ),
     `endif
 
     `ifdef HAS_JTAG
@@ -252,6 +324,12 @@ module uv_soc
         .io_i2c_sda             ( io_i2c_sda        ),
     `endif
 
+    `ifdef HAS_QSPI
+        .io_qspi_sck            ( io_qspi_sck       ),
+        .io_qspi_cs             ( io_qspi_cs        ),
+        .io_qspi_io             ( io_qspi_io        ),
+    `endif
+
         .io_gpio                ( io_gpio           ),
 
         .ext_clk                ( ext_clk           ),
@@ -260,6 +338,21 @@ module uv_soc
     `endif
         .btn_rst_n              ( asyn_btn_rst_n    ),
 
+    `ifdef USE_EXT_MEM
+        .sdram_clk              ( sdram_clk         ),
+        .sdram_cke              ( sdram_cke         ),
+        .sdram_cs_n             ( sdram_cs_n        ),
+        .sdram_ras_n            ( sdram_ras_n       ),
+        .sdram_cas_n            ( sdram_cas_n       ),
+        .sdram_we_n             ( sdram_we_n        ),
+        .sdram_ba               ( sdram_ba          ),
+        .sdram_addr             ( sdram_addr        ),
+        .sdram_dqm              ( sdram_dqm         ),
+        .sdram_dq_oen           ( sdram_dq_oen      ),
+        .sdram_dq_out           ( sdram_dq_out      ),
+        .sdram_dq_in            ( sdram_dq_in       ),
+    `endif
+
     `ifdef HAS_JTAG
         .jtag_tck               ( jtag_tck          ),
         .jtag_tms               ( jtag_tms          ),
@@ -276,6 +369,14 @@ module uv_soc
         .i2c_sda_oen            ( i2c_sda_oen       ),
     `endif
 
+    `ifdef HAS_QSPI
+        .qspi_sck               ( qspi_sck          ),
+        .qspi_cs                ( qspi_cs           ),
+        .qspi_oen               ( qspi_oen          ),
+        .qspi_sdo               ( qspi_sdo          ),
+        .qspi_sdi               ( qspi_sdi          ),
+    `endif
+
         .gpio_pu                ( gpio_pu           ),
         .gpio_pd                ( gpio_pd           ),
         .gpio_ie                ( gpio_ie           ),
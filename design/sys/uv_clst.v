@@ -0,0 +1,684 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_clst
+//
+// Designer: Owen
+//
+// Description:
+//      Cluster of 2~4 harts. Each hart fetches from its own
+//      instruction DAM, and shares data memory of 4 banks on
+//      a 4x4 bus fabric, which are interleaved on word address
+//      for harts to access in parallel. Banks keep the LR
+//      reservations of each hart, which carries its index in
+//      address bits unused by banks, and a store or AMO to the
+//      word fails the SCs of others there. Stores accepted from
+//      a hart also clear the reservations of others in their
+//      LSUs to fail SCs early. Device accesses of the harts
+//      are merged to the ports to devbus, and their core-local
+//      accesses to the one to SLC.
+//      Instructions in IDAMs are loaded by the host (or TB),
+//      as well as the image in shared memory.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_clst
+#(
+    parameter ARCH_ID               = 64'h235,
+    parameter IMPL_ID               = 1,
+    parameter VENDOR_ID             = 0,
+    parameter HART_NUM              = 2,
+    parameter ALEN                  = 32,
+    parameter ILEN                  = 32,
+    parameter XLEN                  = 32,
+    parameter MLEN                  = XLEN / 8,
+    parameter MEM_BASE_LSB          = 31,
+    parameter MEM_BASE_ADDR         = 1'h1,
+    parameter DEV_BASE_LSB          = 31,
+    parameter DEV_BASE_ADDR         = 1'h0,
+    parameter LCL_BASE_LSB          = 16,
+    parameter LCL_BASE_ADDR         = 16'h0200,
+    parameter INST_MEM_DW           = 64,
+    parameter INST_MEM_MW           = INST_MEM_DW / 8,
+    parameter IDAM_SRAM_AW          = 13,       // 8192 * 8B = 64KB for each hart.
+    parameter SMEM_BANK_AW          = 13        // 4 * 8192 * 4B = 128KB shared.
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Reset vector from system.
+    input  [ALEN-1:0]               rst_vec,
+
+    // Inst device access.
+    output                          dev_i_req_vld,
+    input                           dev_i_req_rdy,
+    output [ALEN-1:0]               dev_i_req_addr,
+
+    input                           dev_i_rsp_vld,
+    output                          dev_i_rsp_rdy,
+    input  [1:0]                    dev_i_rsp_excp,
+    input  [XLEN-1:0]               dev_i_rsp_data,
+
+    // Data device access.
+    output                          dev_d_req_vld,
+    input                           dev_d_req_rdy,
+    output                          dev_d_req_read,
+    output [ALEN-1:0]               dev_d_req_addr,
+    output [3:0]                    dev_d_req_amo,
+    output [MLEN-1:0]               dev_d_req_mask,
+    output [XLEN-1:0]               dev_d_req_data,
+
+    input                           dev_d_rsp_vld,
+    output                          dev_d_rsp_rdy,
+    input  [1:0]                    dev_d_rsp_excp,
+    input  [XLEN-1:0]               dev_d_rsp_data,
+
+    // Core-local access.
+    output                          lcl_req_vld,
+    input                           lcl_req_rdy,
+    output                          lcl_req_read,
+    output [ALEN-1:0]               lcl_req_addr,
+    output [MLEN-1:0]               lcl_req_mask,
+    output [XLEN-1:0]               lcl_req_data,
+
+    input                           lcl_rsp_vld,
+    output                          lcl_rsp_rdy,
+    input  [1:0]                    lcl_rsp_excp,
+    input  [XLEN-1:0]               lcl_rsp_data,
+
+    // Control & status to SOC.
+    output [HART_NUM-1:0]           tmr_irq_clr,
+    output                          core_lp_mode,
+
+    // Control & status from SOC.
+    input                           irq_from_nmi,
+    input                           irq_from_ext,
+    input  [HART_NUM-1:0]           irq_from_sft,
+    input  [HART_NUM-1:0]           irq_from_tmr,
+    input  [63:0]                   cnt_from_tmr
+);
+
+    localparam FAB_PORT_NUM         = 4;
+    localparam IDAM_PORT_AW         = IDAM_SRAM_AW + $clog2(INST_MEM_MW);
+    localparam SMEM_BANK_LSB        = ALEN - 2;
+    localparam SMEM_PORT_AW         = SMEM_BANK_AW + 2;
+    localparam SMEM_SRC_LSB         = ALEN - 4;
+    localparam FAB_PORT_IDX         = 8'b11_10_01_00;
+
+    genvar i;
+
+    // Inst memory access of harts.
+    wire [HART_NUM-1:0]             mem_i_req_vld;
+    wire [HART_NUM-1:0]             mem_i_req_rdy;
+    wire [HART_NUM*ALEN-1:0]        mem_i_req_addr;
+    wire [HART_NUM-1:0]             mem_i_rsp_vld;
+    wire [HART_NUM-1:0]             mem_i_rsp_rdy;
+    wire [HART_NUM*2-1:0]           mem_i_rsp_excp;
+    wire [HART_NUM*INST_MEM_DW-1:0] mem_i_rsp_data;
+
+    // Data memory access of harts, padded to the fabric ports.
+    wire [FAB_PORT_NUM-1:0]         mem_d_req_vld;
+    wire [FAB_PORT_NUM-1:0]         mem_d_req_rdy;
+    wire [FAB_PORT_NUM-1:0]         mem_d_req_read;
+    wire [FAB_PORT_NUM*ALEN-1:0]    mem_d_req_addr;
+    wire [FAB_PORT_NUM*ALEN-1:0]    mem_d_req_swz;
+    wire [FAB_PORT_NUM*4-1:0]       mem_d_req_amo;
+    wire [FAB_PORT_NUM*MLEN-1:0]    mem_d_req_mask;
+    wire [FAB_PORT_NUM*XLEN-1:0]    mem_d_req_data;
+    wire [FAB_PORT_NUM-1:0]         mem_d_rsp_vld;
+    wire [FAB_PORT_NUM-1:0]         mem_d_rsp_rdy;
+    wire [FAB_PORT_NUM*2-1:0]       mem_d_rsp_excp;
+    wire [FAB_PORT_NUM*XLEN-1:0]    mem_d_rsp_data;
+    wire [FAB_PORT_NUM-1:0]         mem_d_req_st;
+
+    // Shared memory banks.
+    wire [FAB_PORT_NUM-1:0]         smem_req_vld;
+    wire [FAB_PORT_NUM-1:0]         smem_req_rdy;
+    wire [FAB_PORT_NUM-1:0]         smem_req_read;
+    wire [FAB_PORT_NUM*ALEN-1:0]    smem_req_addr;
+    wire [FAB_PORT_NUM*4-1:0]       smem_req_len;
+    wire [FAB_PORT_NUM-1:0]         smem_req_wrap;
+    wire [FAB_PORT_NUM*4-1:0]       smem_req_amo;
+    wire [FAB_PORT_NUM*MLEN-1:0]    smem_req_mask;
+    wire [FAB_PORT_NUM*XLEN-1:0]    smem_req_data;
+    wire [FAB_PORT_NUM-1:0]         smem_rsp_vld;
+    wire [FAB_PORT_NUM-1:0]         smem_rsp_rdy;
+    wire [FAB_PORT_NUM*2-1:0]       smem_rsp_excp;
+    wire [FAB_PORT_NUM*XLEN-1:0]    smem_rsp_data;
+
+    // Device access of harts in 1D format.
+    wire [HART_NUM-1:0]             hart_i_req_vld;
+    wire [HART_NUM-1:0]             hart_i_req_rdy;
+    wire [HART_NUM*ALEN-1:0]        hart_i_req_addr;
+    wire [HART_NUM-1:0]             hart_i_rsp_vld;
+    wire [HART_NUM-1:0]             hart_i_rsp_rdy;
+    wire [HART_NUM*2-1:0]           hart_i_rsp_excp;
+    wire [HART_NUM*XLEN-1:0]        hart_i_rsp_data;
+
+    wire [HART_NUM-1:0]             hart_d_req_vld;
+    wire [HART_NUM-1:0]             hart_d_req_rdy;
+    wire [HART_NUM-1:0]             hart_d_req_read;
+    wire [HART_NUM*ALEN-1:0]        hart_d_req_addr;
+    wire [HART_NUM*4-1:0]           hart_d_req_amo;
+    wire [HART_NUM*MLEN-1:0]        hart_d_req_mask;
+    wire [HART_NUM*XLEN-1:0]        hart_d_req_data;
+    wire [HART_NUM-1:0]             hart_d_rsp_vld;
+    wire [HART_NUM-1:0]             hart_d_rsp_rdy;
+    wire [HART_NUM*2-1:0]           hart_d_rsp_excp;
+    wire [HART_NUM*XLEN-1:0]        hart_d_rsp_data;
+
+    wire [HART_NUM-1:0]             hart_l_req_vld;
+    wire [HART_NUM-1:0]             hart_l_req_rdy;
+    wire [HART_NUM-1:0]             hart_l_req_read;
+    wire [HART_NUM*ALEN-1:0]        hart_l_req_addr;
+    wire [HART_NUM*MLEN-1:0]        hart_l_req_mask;
+    wire [HART_NUM*XLEN-1:0]        hart_l_req_data;
+    wire [HART_NUM-1:0]             hart_l_rsp_vld;
+    wire [HART_NUM-1:0]             hart_l_rsp_rdy;
+    wire [HART_NUM*2-1:0]           hart_l_rsp_excp;
+    wire [HART_NUM*XLEN-1:0]        hart_l_rsp_data;
+
+    wire [HART_NUM-1:0]             hart_lp_mode;
+
+    // The cluster clock is gated only when all harts sleep.
+    assign core_lp_mode             = &hart_lp_mode;
+
+    //-------------------------------------------------------
+    // Harts & their IDAMs.
+    generate
+        for (i = 0; i < HART_NUM; i = i + 1) begin: gen_hart
+            uv_core
+            #(
+                .ARCH_ID                ( ARCH_ID               ),
+                .IMPL_ID                ( IMPL_ID               ),
+                .HART_ID                ( i                     ),
+                .VENDOR_ID              ( VENDOR_ID             ),
+                .ALEN                   ( ALEN                  ),
+                .ILEN                   ( ILEN                  ),
+                .XLEN                   ( XLEN                  ),
+                .MLEN                   ( MLEN                  ),
+                .MEM_BASE_LSB           ( MEM_BASE_LSB          ),
+                .MEM_BASE_ADDR          ( MEM_BASE_ADDR         ),
+                .DEV_BASE_LSB           ( DEV_BASE_LSB          ),
+                .DEV_BASE_ADDR          ( DEV_BASE_ADDR         ),
+                .LCL_BASE_LSB           ( LCL_BASE_LSB          ),
+                .LCL_BASE_ADDR          ( LCL_BASE_ADDR         ),
+                .USE_INST_DAM           ( 1'b1                  ),
+                .USE_DATA_DAM           ( 1'b1                  ),
+                .INST_MEM_DW            ( INST_MEM_DW           ),
+                .INST_MEM_MW            ( INST_MEM_MW           ),
+                .DATA_MEM_DW            ( XLEN                  ),
+                .DATA_MEM_MW            ( MLEN                  ),
+                .RSV_INV_NUM            ( FAB_PORT_NUM          )
+            )
+            u_core
+            (
+                .clk                    ( clk                   ),
+                .rst_n                  ( rst_n                 ),
+
+                .rst_vec                ( rst_vec               ),
+
+                .mem_i_req_vld          ( mem_i_req_vld[i]      ),
+                .mem_i_req_rdy          ( mem_i_req_rdy[i]      ),
+                .mem_i_req_addr         ( mem_i_req_addr[i*ALEN+:ALEN] ),
+                .mem_i_rsp_vld          ( mem_i_rsp_vld[i]      ),
+                .mem_i_rsp_rdy          ( mem_i_rsp_rdy[i]      ),
+                .mem_i_rsp_excp         ( mem_i_rsp_excp[i*2+:2] ),
+                .mem_i_rsp_data         ( mem_i_rsp_data[i*INST_MEM_DW+:INST_MEM_DW] ),
+
+                .mem_d_req_vld          ( mem_d_req_vld[i]      ),
+                .mem_d_req_rdy          ( mem_d_req_rdy[i]      ),
+                .mem_d_req_read         ( mem_d_req_read[i]     ),
+                .mem_d_req_addr         ( mem_d_req_addr[i*ALEN+:ALEN] ),
+                .mem_d_req_amo          ( mem_d_req_amo[i*4+:4] ),
+                .mem_d_req_mask         ( mem_d_req_mask[i*MLEN+:MLEN] ),
+                .mem_d_req_data         ( mem_d_req_data[i*XLEN+:XLEN] ),
+                .mem_d_rsp_vld          ( mem_d_rsp_vld[i]      ),
+                .mem_d_rsp_rdy          ( mem_d_rsp_rdy[i]      ),
+                .mem_d_rsp_excp         ( mem_d_rsp_excp[i*2+:2] ),
+                .mem_d_rsp_data         ( mem_d_rsp_data[i*XLEN+:XLEN] ),
+
+                .dev_i_req_vld          ( hart_i_req_vld[i]     ),
+                .dev_i_req_rdy          ( hart_i_req_rdy[i]     ),
+                .dev_i_req_addr         ( hart_i_req_addr[i*ALEN+:ALEN] ),
+                .dev_i_rsp_vld          ( hart_i_rsp_vld[i]     ),
+                .dev_i_rsp_rdy          ( hart_i_rsp_rdy[i]     ),
+                .dev_i_rsp_excp         ( hart_i_rsp_excp[i*2+:2] ),
+                .dev_i_rsp_data         ( hart_i_rsp_data[i*XLEN+:XLEN] ),
+
+                .dev_d_req_vld          ( hart_d_req_vld[i]     ),
+                .dev_d_req_rdy          ( hart_d_req_rdy[i]     ),
+                .dev_d_req_read         ( hart_d_req_read[i]    ),
+                .dev_d_req_addr         ( hart_d_req_addr[i*ALEN+:ALEN] ),
+                .dev_d_req_amo          ( hart_d_req_amo[i*4+:4] ),
+                .dev_d_req_mask         ( hart_d_req_mask[i*MLEN+:MLEN] ),
+                .dev_d_req_data         ( hart_d_req_data[i*XLEN+:XLEN] ),
+                .dev_d_rsp_vld          ( hart_d_rsp_vld[i]     ),
+                .dev_d_rsp_rdy          ( hart_d_rsp_rdy[i]     ),
+                .dev_d_rsp_excp         ( hart_d_rsp_excp[i*2+:2] ),
+                .dev_d_rsp_data         ( hart_d_rsp_data[i*XLEN+:XLEN] ),
+
+                .lcl_req_vld            ( hart_l_req_vld[i]     ),
+                .lcl_req_rdy            ( hart_l_req_rdy[i]     ),
+                .lcl_req_read           ( hart_l_req_read[i]    ),
+                .lcl_req_addr           ( hart_l_req_addr[i*ALEN+:ALEN] ),
+                .lcl_req_mask           ( hart_l_req_mask[i*MLEN+:MLEN] ),
+                .lcl_req_data           ( hart_l_req_data[i*XLEN+:XLEN] ),
+                .lcl_rsp_vld            ( hart_l_rsp_vld[i]     ),
+                .lcl_rsp_rdy            ( hart_l_rsp_rdy[i]     ),
+                .lcl_rsp_excp           ( hart_l_rsp_excp[i*2+:2] ),
+                .lcl_rsp_data           ( hart_l_rsp_data[i*XLEN+:XLEN] ),
+
+                .tmr_irq_clr            ( tmr_irq_clr[i]        ),
+                .core_lp_mode           ( hart_lp_mode[i]       ),
+
+                // External IRQ is only claimed by hart 0.
+                .irq_from_nmi           ( irq_from_nmi          ),
+                .irq_from_ext           ( i == 0 ? irq_from_ext : 1'b0 ),
+                .irq_from_sft           ( irq_from_sft[i]       ),
+                .irq_from_tmr           ( irq_from_tmr[i]       ),
+                .cnt_from_tmr           ( cnt_from_tmr          ),
+
+                // Stores of other harts to shared memory.
+                .rsv_inv_vld            ( mem_d_req_st & (~({{(FAB_PORT_NUM-1){1'b0}}, 1'b1} << i)) ),
+                .rsv_inv_addr           ( mem_d_req_addr        )
+            );
+
+            uv_dam
+            #(
+                .PORT_AW                ( IDAM_PORT_AW          ),
+                .PORT_DW                ( INST_MEM_DW           ),
+                .PORT_MW                ( INST_MEM_MW           ),
+                .SRAM_DP                ( 2**IDAM_SRAM_AW       ),
+                .BANK_NUM               ( 2                     ),
+                .BANK_ILV               ( 1'b1                  )
+            )
+            u_idam
+            (
+                .clk                    ( clk                   ),
+                .rst_n                  ( rst_n                 ),
+
+                .port_a_req_vld         ( mem_i_req_vld[i]      ),
+                .port_a_req_rdy         ( mem_i_req_rdy[i]      ),
+                .port_a_req_read        ( 1'b1                  ),
+                .port_a_req_addr        ( mem_i_req_addr[i*ALEN+:IDAM_PORT_AW] ),
+                .port_a_req_mask        ( {INST_MEM_MW{1'b1}}   ),
+                .port_a_req_data        ( {INST_MEM_DW{1'b0}}   ),
+                .port_a_rsp_vld         ( mem_i_rsp_vld[i]      ),
+                .port_a_rsp_rdy         ( mem_i_rsp_rdy[i]      ),
+                .port_a_rsp_excp        ( mem_i_rsp_excp[i*2+:2] ),
+                .port_a_rsp_data        ( mem_i_rsp_data[i*INST_MEM_DW+:INST_MEM_DW] ),
+
+                .port_b_req_vld         ( 1'b0                  ),
+                .port_b_req_rdy         (                       ),
+                .port_b_req_read        ( 1'b1                  ),
+                .port_b_req_addr        ( {IDAM_PORT_AW{1'b0}}  ),
+                .port_b_req_amo         ( 4'b0                  ),
+                .port_b_req_mask        ( {INST_MEM_MW{1'b0}}   ),
+                .port_b_req_data        ( {INST_MEM_DW{1'b0}}   ),
+                .port_b_rsp_vld         (                       ),
+                .port_b_rsp_rdy         ( 1'b1                  ),
+                .port_b_rsp_excp        (                       ),
+                .port_b_rsp_data        (                       )
+            );
+        end
+    endgenerate
+
+    //-------------------------------------------------------
+    // Shared memory.
+    generate
+        for (i = 0; i < FAB_PORT_NUM; i = i + 1) begin: gen_mem_d_port
+            if (i >= HART_NUM) begin: gen_mem_d_idle
+                assign mem_d_req_vld[i]                 = 1'b0;
+                assign mem_d_req_read[i]                = 1'b1;
+                assign mem_d_req_addr[i*ALEN+:ALEN]     = {ALEN{1'b0}};
+                assign mem_d_req_amo[i*4+:4]            = 4'b0;
+                assign mem_d_req_mask[i*MLEN+:MLEN]     = {MLEN{1'b0}};
+                assign mem_d_req_data[i*XLEN+:XLEN]     = {XLEN{1'b0}};
+                assign mem_d_rsp_rdy[i]                 = 1'b1;
+            end
+
+            // Stores are ordered by bank grants, and the SC of a hart is
+            // checked by the bank, so this only fails SCs early. LR is
+            // sent as a read with its AMO code.
+            assign mem_d_req_st[i]                  = mem_d_req_vld[i] & mem_d_req_rdy[i] & (~mem_d_req_read[i]);
+
+            // Bank bits on word address are swizzled to MSB for decoding,
+            // followed by the port index for the reservations of banks.
+            assign mem_d_req_swz[i*ALEN+:ALEN]      = {mem_d_req_addr[i*ALEN+2+:2],
+                                                       FAB_PORT_IDX[i*2+:2],
+                                                       mem_d_req_addr[i*ALEN+4+:ALEN-6],
+                                                       mem_d_req_addr[i*ALEN+:2]};
+        end
+    endgenerate
+
+    // PIPE_STAGE must stay 0, so a store is accepted from a hart
+    // port when granted by the bank, and the LSUs of the others see
+    // it in the order of the bank when failing SCs early.
+    uv_bus_fab_4x4
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( XLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE_STAGE                 ( 0                     ),
+        .OST_NUM                    ( 2                     ),
+        .SLV0_BASE_LSB              ( SMEM_BANK_LSB         ),
+        .SLV0_BASE_ADDR             ( 2'h0                  ),
+        .SLV1_BASE_LSB              ( SMEM_BANK_LSB         ),
+        .SLV1_BASE_ADDR             ( 2'h1                  ),
+        .SLV2_BASE_LSB              ( SMEM_BANK_LSB         ),
+        .SLV2_BASE_ADDR             ( 2'h2                  ),
+        .SLV3_BASE_LSB              ( SMEM_BANK_LSB         ),
+        .SLV3_BASE_ADDR             ( 2'h3                  )
+    )
+    u_smem_fab
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .mst_dev_vld                ( {{(FAB_PORT_NUM-HART_NUM){1'b0}}, {HART_NUM{1'b1}}} ),
+        .slv_dev_vld                ( 4'hf                  ),
+
+        .mst0_req_vld               ( mem_d_req_vld[0]      ),
+        .mst0_req_rdy               ( mem_d_req_rdy[0]      ),
+        .mst0_req_read              ( mem_d_req_read[0]     ),
+        .mst0_req_addr              ( mem_d_req_swz[ALEN-1:0] ),
+        .mst0_req_len               ( 4'b0                  ),
+        .mst0_req_wrap              ( 1'b0                  ),
+        .mst0_req_amo               ( mem_d_req_amo[3:0]    ),
+        .mst0_req_mask              ( mem_d_req_mask[MLEN-1:0] ),
+        .mst0_req_data              ( mem_d_req_data[XLEN-1:0] ),
+        .mst0_rsp_vld               ( mem_d_rsp_vld[0]      ),
+        .mst0_rsp_rdy               ( mem_d_rsp_rdy[0]      ),
+        .mst0_rsp_excp              ( mem_d_rsp_excp[1:0]   ),
+        .mst0_rsp_data              ( mem_d_rsp_data[XLEN-1:0] ),
+
+        .mst1_req_vld               ( mem_d_req_vld[1]      ),
+        .mst1_req_rdy               ( mem_d_req_rdy[1]      ),
+        .mst1_req_read              ( mem_d_req_read[1]     ),
+        .mst1_req_addr              ( mem_d_req_swz[ALEN*2-1:ALEN] ),
+        .mst1_req_len               ( 4'b0                  ),
+        .mst1_req_wrap              ( 1'b0                  ),
+        .mst1_req_amo               ( mem_d_req_amo[7:4]    ),
+        .mst1_req_mask              ( mem_d_req_mask[MLEN*2-1:MLEN] ),
+        .mst1_req_data              ( mem_d_req_data[XLEN*2-1:XLEN] ),
+        .mst1_rsp_vld               ( mem_d_rsp_vld[1]      ),
+        .mst1_rsp_rdy               ( mem_d_rsp_rdy[1]      ),
+        .mst1_rsp_excp              ( mem_d_rsp_excp[3:2]   ),
+        .mst1_rsp_data              ( mem_d_rsp_data[XLEN*2-1:XLEN] ),
+
+        .mst2_req_vld               ( mem_d_req_vld[2]      ),
+        .mst2_req_rdy               ( mem_d_req_rdy[2]      ),
+        .mst2_req_read              ( mem_d_req_read[2]     ),
+        .mst2_req_addr              ( mem_d_req_swz[ALEN*3-1:ALEN*2] ),
+        .mst2_req_len               ( 4'b0                  ),
+        .mst2_req_wrap              ( 1'b0                  ),
+        .mst2_req_amo               ( mem_d_req_amo[11:8]   ),
+        .mst2_req_mask              ( mem_d_req_mask[MLEN*3-1:MLEN*2] ),
+        .mst2_req_data              ( mem_d_req_data[XLEN*3-1:XLEN*2] ),
+        .mst2_rsp_vld               ( mem_d_rsp_vld[2]      ),
+        .mst2_rsp_rdy               ( mem_d_rsp_rdy[2]      ),
+        .mst2_rsp_excp              ( mem_d_rsp_excp[5:4]   ),
+        .mst2_rsp_data              ( mem_d_rsp_data[XLEN*3-1:XLEN*2] ),
+
+        .mst3_req_vld               ( mem_d_req_vld[3]      ),
+        .mst3_req_rdy               ( mem_d_req_rdy[3]      ),
+        .mst3_req_read              ( mem_d_req_read[3]     ),
+        .mst3_req_addr              ( mem_d_req_swz[ALEN*4-1:ALEN*3] ),
+        .mst3_req_len               ( 4'b0                  ),
+        .mst3_req_wrap              ( 1'b0                  ),
+        .mst3_req_amo               ( mem_d_req_amo[15:12]  ),
+        .mst3_req_mask              ( mem_d_req_mask[MLEN*4-1:MLEN*3] ),
+        .mst3_req_data              ( mem_d_req_data[XLEN*4-1:XLEN*3] ),
+        .mst3_rsp_vld               ( mem_d_rsp_vld[3]      ),
+        .mst3_rsp_rdy               ( mem_d_rsp_rdy[3]      ),
+        .mst3_rsp_excp              ( mem_d_rsp_excp[7:6]   ),
+        .mst3_rsp_data              ( mem_d_rsp_data[XLEN*4-1:XLEN*3] ),
+
+        .slv0_req_vld               ( smem_req_vld[0]       ),
+        .slv0_req_rdy               ( smem_req_rdy[0]       ),
+        .slv0_req_read              ( smem_req_read[0]      ),
+        .slv0_req_addr              ( smem_req_addr[ALEN-1:0] ),
+        .slv0_req_len               ( smem_req_len[3:0]     ),
+        .slv0_req_wrap              ( smem_req_wrap[0]      ),
+        .slv0_req_amo               ( smem_req_amo[3:0]     ),
+        .slv0_req_mask              ( smem_req_mask[MLEN-1:0] ),
+        .slv0_req_data              ( smem_req_data[XLEN-1:0] ),
+        .slv0_rsp_vld               ( smem_rsp_vld[0]       ),
+        .slv0_rsp_rdy               ( smem_rsp_rdy[0]       ),
+        .slv0_rsp_excp              ( smem_rsp_excp[1:0]    ),
+        .slv0_rsp_data              ( smem_rsp_data[XLEN-1:0] ),
+
+        .slv1_req_vld               ( smem_req_vld[1]       ),
+        .slv1_req_rdy               ( smem_req_rdy[1]       ),
+        .slv1_req_read              ( smem_req_read[1]      ),
+        .slv1_req_addr              ( smem_req_addr[ALEN*2-1:ALEN] ),
+        .slv1_req_len               ( smem_req_len[7:4]     ),
+        .slv1_req_wrap              ( smem_req_wrap[1]      ),
+        .slv1_req_amo               ( smem_req_amo[7:4]     ),
+        .slv1_req_mask              ( smem_req_mask[MLEN*2-1:MLEN] ),
+        .slv1_req_data              ( smem_req_data[XLEN*2-1:XLEN] ),
+        .slv1_rsp_vld               ( smem_rsp_vld[1]       ),
+        .slv1_rsp_rdy               ( smem_rsp_rdy[1]       ),
+        .slv1_rsp_excp              ( smem_rsp_excp[3:2]    ),
+        .slv1_rsp_data              ( smem_rsp_data[XLEN*2-1:XLEN] ),
+
+        .slv2_req_vld               ( smem_req_vld[2]       ),
+        .slv2_req_rdy               ( smem_req_rdy[2]       ),
+        .slv2_req_read              ( smem_req_read[2]      ),
+        .slv2_req_addr              ( smem_req_addr[ALEN*3-1:ALEN*2] ),
+        .slv2_req_len               ( smem_req_len[11:8]    ),
+        .slv2_req_wrap              ( smem_req_wrap[2]      ),
+        .slv2_req_amo               ( smem_req_amo[11:8]    ),
+        .slv2_req_mask              ( smem_req_mask[MLEN*3-1:MLEN*2] ),
+        .slv2_req_data              ( smem_req_data[XLEN*3-1:XLEN*2] ),
+        .slv2_rsp_vld               ( smem_rsp_vld[2]       ),
+        .slv2_rsp_rdy               ( smem_rsp_rdy[2]       ),
+        .slv2_rsp_excp              ( smem_rsp_excp[5:4]    ),
+        .slv2_rsp_data              ( smem_rsp_data[XLEN*3-1:XLEN*2] ),
+
+        .slv3_req_vld               ( smem_req_vld[3]       ),
+        .slv3_req_rdy               ( smem_req_rdy[3]       ),
+        .slv3_req_read              ( smem_req_read[3]      ),
+        .slv3_req_addr              ( smem_req_addr[ALEN*4-1:ALEN*3] ),
+        .slv3_req_len               ( smem_req_len[15:12]   ),
+        .slv3_req_wrap              ( smem_req_wrap[3]      ),
+        .slv3_req_amo               ( smem_req_amo[15:12]   ),
+        .slv3_req_mask              ( smem_req_mask[MLEN*4-1:MLEN*3] ),
+        .slv3_req_data              ( smem_req_data[XLEN*4-1:XLEN*3] ),
+        .slv3_rsp_vld               ( smem_rsp_vld[3]       ),
+        .slv3_rsp_rdy               ( smem_rsp_rdy[3]       ),
+        .slv3_rsp_excp              ( smem_rsp_excp[7:6]    ),
+        .slv3_rsp_data              ( smem_rsp_data[XLEN*4-1:XLEN*3] )
+    );
+
+    // Banks take the word address without bank bits, & atomics are done in front of them
+    // with a reservation for each hart.
+    generate
+        for (i = 0; i < FAB_PORT_NUM; i = i + 1) begin: gen_bank
+            uv_dev_sram
+            #(
+                .ALEN                   ( SMEM_PORT_AW          ),
+                .DLEN                   ( XLEN                  ),
+                .MLEN                   ( MLEN                  ),
+                .SRAM_AW                ( SMEM_BANK_AW          ),
+                .RSV_NUM                ( FAB_PORT_NUM          )
+            )
+            u_bank
+            (
+                .clk                    ( clk                   ),
+                .rst_n                  ( rst_n                 ),
+
+                .sram_req_vld           ( smem_req_vld[i]       ),
+                .sram_req_rdy           ( smem_req_rdy[i]       ),
+                .sram_req_read          ( smem_req_read[i]      ),
+                .sram_req_addr          ( smem_req_addr[i*ALEN+:SMEM_PORT_AW] ),
+                .sram_req_len           ( smem_req_len[i*4+:4]  ),
+                .sram_req_wrap          ( smem_req_wrap[i]      ),
+                .sram_req_amo           ( smem_req_amo[i*4+:4]  ),
+                .sram_req_src           ( smem_req_addr[i*ALEN+SMEM_SRC_LSB+:2] ),
+                .sram_req_mask          ( smem_req_mask[i*MLEN+:MLEN] ),
+                .sram_req_data          ( smem_req_data[i*XLEN+:XLEN] ),
+
+                .sram_rsp_vld           ( smem_rsp_vld[i]       ),
+                .sram_rsp_rdy           ( smem_rsp_rdy[i]       ),
+                .sram_rsp_excp          ( smem_rsp_excp[i*2+:2] ),
+                .sram_rsp_data          ( smem_rsp_data[i*XLEN+:XLEN] )
+            );
+        end
+    endgenerate
+
+    //-------------------------------------------------------
+    // Device access merging.
+    uv_bus_fab
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( XLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .OST_NUM                    ( 2                     ),
+        .MST_PORT_NUM               ( HART_NUM              ),
+        .SLV_PORT_NUM               ( 1                     ),
+        .SLV0_BASE_LSB              ( DEV_BASE_LSB          ),
+        .SLV0_BASE_ADDR             ( DEV_BASE_ADDR         )
+    )
+    u_dev_i_fab
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .mst_dev_vld                ( {HART_NUM{1'b1}}      ),
+        .mst_req_vld                ( hart_i_req_vld        ),
+        .mst_req_rdy                ( hart_i_req_rdy        ),
+        .mst_req_read               ( {HART_NUM{1'b1}}      ),
+        .mst_req_addr               ( hart_i_req_addr       ),
+        .mst_req_len                ( {HART_NUM*4{1'b0}}    ),
+        .mst_req_wrap               ( {HART_NUM{1'b0}}      ),
+        .mst_req_amo                ( {HART_NUM*4{1'b0}}    ),
+        .mst_req_mask               ( {HART_NUM*MLEN{1'b1}} ),
+        .mst_req_data               ( {HART_NUM*XLEN{1'b0}} ),
+        .mst_rsp_vld                ( hart_i_rsp_vld        ),
+        .mst_rsp_rdy                ( hart_i_rsp_rdy        ),
+        .mst_rsp_excp               ( hart_i_rsp_excp       ),
+        .mst_rsp_data               ( hart_i_rsp_data       ),
+        .mst_qos_cls                ( {HART_NUM*2{1'b0}}    ),
+        .mst_qos_wgt                ( {HART_NUM*4{1'b0}}    ),
+        .qos_lim                    ( 8'h0                  ),
+
+        .slv_dev_vld                ( 1'b1                  ),
+        .slv_req_vld                ( dev_i_req_vld         ),
+        .slv_req_rdy                ( dev_i_req_rdy         ),
+        .slv_req_read               (                       ),
+        .slv_req_addr               ( dev_i_req_addr        ),
+        .slv_req_len                (                       ),
+        .slv_req_wrap               (                       ),
+        .slv_req_amo                (                       ),
+        .slv_req_mask               (                       ),
+        .slv_req_data               (                       ),
+        .slv_rsp_vld                ( dev_i_rsp_vld         ),
+        .slv_rsp_rdy                ( dev_i_rsp_rdy         ),
+        .slv_rsp_excp               ( dev_i_rsp_excp        ),
+        .slv_rsp_data               ( dev_i_rsp_data        )
+    );
+
+    uv_bus_fab
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( XLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .OST_NUM                    ( 2                     ),
+        .MST_PORT_NUM               ( HART_NUM              ),
+        .SLV_PORT_NUM               ( 1                     ),
+        .SLV0_BASE_LSB              ( DEV_BASE_LSB          ),
+        .SLV0_BASE_ADDR             ( DEV_BASE_ADDR         )
+    )
+    u_dev_d_fab
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .mst_dev_vld                ( {HART_NUM{1'b1}}      ),
+        .mst_req_vld                ( hart_d_req_vld        ),
+        .mst_req_rdy                ( hart_d_req_rdy        ),
+        .mst_req_read               ( hart_d_req_read       ),
+        .mst_req_addr               ( hart_d_req_addr       ),
+        .mst_req_len                ( {HART_NUM*4{1'b0}}    ),
+        .mst_req_wrap               ( {HART_NUM{1'b0}}      ),
+        .mst_req_amo                ( hart_d_req_amo        ),
+        .mst_req_mask               ( hart_d_req_mask       ),
+        .mst_req_data               ( hart_d_req_data       ),
+        .mst_rsp_vld                ( hart_d_rsp_vld        ),
+        .mst_rsp_rdy                ( hart_d_rsp_rdy        ),
+        .mst_rsp_excp               ( hart_d_rsp_excp       ),
+        .mst_rsp_data               ( hart_d_rsp_data       ),
+        .mst_qos_cls                ( {HART_NUM*2{1'b0}}    ),
+        .mst_qos_wgt                ( {HART_NUM*4{1'b0}}    ),
+        .qos_lim                    ( 8'h0                  ),
+
+        .slv_dev_vld                ( 1'b1                  ),
+        .slv_req_vld                ( dev_d_req_vld         ),
+        .slv_req_rdy                ( dev_d_req_rdy         ),
+        .slv_req_read               ( dev_d_req_read        ),
+        .slv_req_addr               ( dev_d_req_addr        ),
+        .slv_req_len                (                       ),
+        .slv_req_wrap               (                       ),
+        .slv_req_amo                ( dev_d_req_amo         ),
+        .slv_req_mask               ( dev_d_req_mask        ),
+        .slv_req_data               ( dev_d_req_data        ),
+        .slv_rsp_vld                ( dev_d_rsp_vld         ),
+        .slv_rsp_rdy                ( dev_d_rsp_rdy         ),
+        .slv_rsp_excp               ( dev_d_rsp_excp        ),
+        .slv_rsp_data               ( dev_d_rsp_data        )
+    );
+
+    uv_bus_fab
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( XLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .MST_PORT_NUM               ( HART_NUM              ),
+        .SLV_PORT_NUM               ( 1                     ),
+        .SLV0_BASE_LSB              ( LCL_BASE_LSB          ),
+        .SLV0_BASE_ADDR             ( LCL_BASE_ADDR         )
+    )
+    u_lcl_fab
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .mst_dev_vld                ( {HART_NUM{1'b1}}      ),
+        .mst_req_vld                ( hart_l_req_vld        ),
+        .mst_req_rdy                ( hart_l_req_rdy        ),
+        .mst_req_read               ( hart_l_req_read       ),
+        .mst_req_addr               ( hart_l_req_addr       ),
+        .mst_req_len                ( {HART_NUM*4{1'b0}}    ),
+        .mst_req_wrap               ( {HART_NUM{1'b0}}      ),
+        .mst_req_amo                ( {HART_NUM*4{1'b0}}    ),
+        .mst_req_mask               ( hart_l_req_mask       ),
+        .mst_req_data               ( hart_l_req_data       ),
+        .mst_rsp_vld                ( hart_l_rsp_vld        ),
+        .mst_rsp_rdy                ( hart_l_rsp_rdy        ),
+        .mst_rsp_excp               ( hart_l_rsp_excp       ),
+        .mst_rsp_data               ( hart_l_rsp_data       ),
+        .mst_qos_cls                ( {HART_NUM*2{1'b0}}    ),
+        .mst_qos_wgt                ( {HART_NUM*4{1'b0}}    ),
+        .qos_lim                    ( 8'h0                  ),
+
+        .slv_dev_vld                ( 1'b1                  ),
+        .slv_req_vld                ( lcl_req_vld           ),
+        .slv_req_rdy                ( lcl_req_rdy           ),
+        .slv_req_read               ( lcl_req_read          ),
+        .slv_req_addr               ( lcl_req_addr          ),
+        .slv_req_len                (                       ),
+        .slv_req_wrap               (                       ),
+        .slv_req_amo                (                       ),
+        .slv_req_mask               ( lcl_req_mask          ),
+        .slv_req_data               ( lcl_req_data          ),
+        .slv_rsp_vld                ( lcl_rsp_vld           ),
+        .slv_rsp_rdy                ( lcl_rsp_rdy           ),
+        .slv_rsp_excp               ( lcl_rsp_excp          ),
+        .slv_rsp_data               ( lcl_rsp_data          )
+    );
+
+endmodule
@@ -7,7 +7,8 @@
 //
 // Description:
 //      Device subsystem with sysbus, shared memory,
-//      peripherals & system-level controller.
+//      peripherals, DSP & GEMM accelerators and system-level
+//      controller.
 //************************************************************
 
 `timescale 1ns / 1ps
@@ -17,7 +18,11 @@ module uv_dev_subsys
     parameter ALEN                  = 32,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter IO_NUM                = 32
+    parameter DEV_DW                = DLEN,
+    parameter DEV_MW                = DEV_DW / 8,
+    parameter IO_NUM                = 32,
+    parameter DMA_HS_NUM            = 16,
+    parameter HART_NUM              = 1
 )
 (
     input                           sys_clk,
@@ -40,6 +45,7 @@ module uv_dev_subsys
     output                          dev_d_req_rdy,
     input                           dev_d_req_read,
     input  [ALEN-1:0]               dev_d_req_addr,
+    input  [3:0]                    dev_d_req_amo,
     input  [MLEN-1:0]               dev_d_req_mask,
     input  [DLEN-1:0]               dev_d_req_data,
     output                          dev_d_rsp_vld,
@@ -47,11 +53,25 @@ module uv_dev_subsys
     output [1:0]                    dev_d_rsp_excp,
     output [DLEN-1:0]               dev_d_rsp_data,
 
+    // Core-local access to SLC.
+    input                           lcl_req_vld,
+    output                          lcl_req_rdy,
+    input                           lcl_req_read,
+    input  [ALEN-1:0]               lcl_req_addr,
+    input  [MLEN-1:0]               lcl_req_mask,
+    input  [DLEN-1:0]               lcl_req_data,
+    output                          lcl_rsp_vld,
+    input                           lcl_rsp_rdy,
+    output [1:0]                    lcl_rsp_excp,
+    output [DLEN-1:0]               lcl_rsp_data,
+
     // DMA device access.
     input                           dma_req_vld,
     output                          dma_req_rdy,
     input                           dma_req_read,
     input  [ALEN-1:0]               dma_req_addr,
+    input  [3:0]                    dma_req_len,
+    input                           dma_req_wrap,
     input  [MLEN-1:0]               dma_req_mask,
     input  [DLEN-1:0]               dma_req_data,
     output                          dma_rsp_vld,
@@ -59,6 +79,23 @@ module uv_dev_subsys
     output [1:0]                    dma_rsp_excp,
     output [DLEN-1:0]               dma_rsp_data,
 
+    // DMA register access.
+    output                          dma_slv_req_vld,
+    input                           dma_slv_req_rdy,
+    output                          dma_slv_req_read,
+    output [ALEN-1:0]               dma_slv_req_addr,
+    output [MLEN-1:0]               dma_slv_req_mask,
+    output [DLEN-1:0]               dma_slv_req_data,
+    input                           dma_slv_rsp_vld,
+    output                          dma_slv_rsp_rdy,
+    input  [1:0]                    dma_slv_rsp_excp,
+    input  [DLEN-1:0]               dma_slv_rsp_data,
+
+    // DMA handshakes & interrupt.
+    output [DMA_HS_NUM-1:0]         dma_hs_req,
+    input  [DMA_HS_NUM-1:0]         dma_hs_ack,
+    input                           dma_irq,
+
     // Debug device access.
     input                           dbg_req_vld,
     output                          dbg_req_rdy,
@@ -72,11 +109,11 @@ module uv_dev_subsys
     output [DLEN-1:0]               dbg_rsp_data,
 
     // Control & status with core.
-    input                           tmr_irq_clr,
+    input  [HART_NUM-1:0]           tmr_irq_clr,
     output [ALEN-1:0]               rst_vec,
     output                          ext_irq,
-    output                          sft_irq,
-    output                          tmr_irq,
+    output [HART_NUM-1:0]           sft_irq,
+    output [HART_NUM-1:0]           tmr_irq,
     output [63:0]                   tmr_val,
 
     // Control & status with SOC.
@@ -94,6 +131,12 @@ module uv_dev_subsys
     input                           i2c_sda_in,
     output                          i2c_sda_out,
     output                          i2c_sda_oen,
+
+    output                          qspi_sck,
+    output [3:0]                    qspi_cs,
+    output [3:0]                    qspi_oen,
+    output [3:0]                    qspi_sdo,
+    input  [3:0]                    qspi_sdi,
     
     output [IO_NUM-1:0]             gpio_pu,
     output [IO_NUM-1:0]             gpio_pd,
@@ -110,6 +153,7 @@ module uv_dev_subsys
     localparam ROM_BASE_ADDR        = 6'h1;
     localparam SLC_BASE_LSB         = 26;
     localparam SLC_BASE_ADDR        = 6'h2;
+    localparam LCL_BASE_LSB         = 16;   // Core-local window of SLC.
     localparam SRAM_BASE_LSB        = 28;
     localparam SRAM_BASE_ADDR       = 4'h1;
     localparam EFLASH_BASE_LSB      = 28;
@@ -118,20 +162,35 @@ module uv_dev_subsys
     localparam PERIP_BASE_ADDR      = 16'h7000;
     localparam DMA_BASE_LSB         = 16;
     localparam DMA_BASE_ADDR        = 16'h7001;
+    localparam XIP_BASE_LSB         = 28;
+    localparam XIP_BASE_ADDR        = 4'h3;
+    localparam QSPI_BASE_LSB        = 16;
+    localparam QSPI_BASE_ADDR       = 16'h7002;
+    localparam DSP_BASE_LSB         = 16;
+    localparam DSP_BASE_ADDR        = 16'h7003;
+    localparam GEMM_BASE_LSB        = 16;
+    localparam GEMM_BASE_ADDR       = 16'h7004;
     localparam ROM_START_ADDR       = {{(ALEN-ROM_BASE_LSB-1){1'b0}}, ROM_BASE_ADDR, {ROM_BASE_LSB{1'b0}}};
 
     localparam ROM_AW               = 10;
-    localparam SRAM_AW              = 14;
+    localparam SRAM_AW              = 16 - $clog2(DEV_MW);  // 64KB in rows of devbus width.
     localparam SRAM_DP              = 2**SRAM_AW;
     localparam EFLASH_AW            = 18;
-    localparam EFLASH_DP            = 2**SRAM_AW;
+    localparam EFLASH_DP            = 2**EFLASH_AW;
+    localparam EFLASH_WS            = 1;
+    localparam XIP_AW               = 24;
     localparam EXT_IRQ_NUM          = 64;
     localparam IRQ_PRI_NUM          = 8;
+    localparam DSP_TAP_NUM          = 64;
+    localparam DSP_FIFO_AW          = 4;
+    localparam DSP_DMA_HS           = 9;
+    localparam GEMM_TILE_AW         = 8;    // 4KB of each tile.
 
     localparam ROM_ICG_INDEX        = 0;
     localparam SRAM_ICG_INDEX       = 1;
     localparam EFLASH_ICG_INDEX     = 2;
     localparam DMA_ICG_INDEX        = 3;
+    localparam QSPI_ICG_INDEX       = 4;
     localparam PERIP_ICG_NUM        = 8;
 
     genvar i;
@@ -139,7 +198,89 @@ module uv_dev_subsys
     wire                            bus_clk;
     wire                            bus_rst_n;
     wire [3:0]                      bus_mst_dev_vld;
-    wire [7:0]                      bus_slv_dev_vld;
+    wire [8:0]                      bus_slv_dev_vld;
+    wire [31:0]                     bus_qos;
+
+    // Devbus side of width adapters.
+    wire                            bus_dev_i_req_vld;
+    wire                            bus_dev_i_req_rdy;
+    wire                            bus_dev_i_req_read;
+    wire [ALEN-1:0]                 bus_dev_i_req_addr;
+    wire [3:0]                      bus_dev_i_req_len;
+    wire                            bus_dev_i_req_wrap;
+    wire [3:0]                      bus_dev_i_req_amo;
+    wire [DEV_MW-1:0]               bus_dev_i_req_mask;
+    wire [DEV_DW-1:0]               bus_dev_i_req_data;
+    wire                            bus_dev_i_rsp_vld;
+    wire                            bus_dev_i_rsp_rdy;
+    wire [1:0]                      bus_dev_i_rsp_excp;
+    wire [DEV_DW-1:0]               bus_dev_i_rsp_data;
+    wire                            bus_dev_d_req_vld;
+    wire                            bus_dev_d_req_rdy;
+    wire                            bus_dev_d_req_read;
+    wire [ALEN-1:0]                 bus_dev_d_req_addr;
+    wire [3:0]                      bus_dev_d_req_len;
+    wire                            bus_dev_d_req_wrap;
+    wire [3:0]                      bus_dev_d_req_amo;
+    wire [DEV_MW-1:0]               bus_dev_d_req_mask;
+    wire [DEV_DW-1:0]               bus_dev_d_req_data;
+    wire                            bus_dev_d_rsp_vld;
+    wire                            bus_dev_d_rsp_rdy;
+    wire [1:0]                      bus_dev_d_rsp_excp;
+    wire [DEV_DW-1:0]               bus_dev_d_rsp_data;
+    wire                            bus_dma_req_vld;
+    wire                            bus_dma_req_rdy;
+    wire                            bus_dma_req_read;
+    wire [ALEN-1:0]                 bus_dma_req_addr;
+    wire [3:0]                      bus_dma_req_len;
+    wire                            bus_dma_req_wrap;
+    wire [3:0]                      bus_dma_req_amo;
+    wire [DEV_MW-1:0]               bus_dma_req_mask;
+    wire [DEV_DW-1:0]               bus_dma_req_data;
+    wire                            bus_dma_rsp_vld;
+    wire                            bus_dma_rsp_rdy;
+    wire [1:0]                      bus_dma_rsp_excp;
+    wire [DEV_DW-1:0]               bus_dma_rsp_data;
+    wire                            bus_dbg_req_vld;
+    wire                            bus_dbg_req_rdy;
+    wire                            bus_dbg_req_read;
+    wire [ALEN-1:0]                 bus_dbg_req_addr;
+    wire [3:0]                      bus_dbg_req_len;
+    wire                            bus_dbg_req_wrap;
+    wire [3:0]                      bus_dbg_req_amo;
+    wire [DEV_MW-1:0]               bus_dbg_req_mask;
+    wire [DEV_DW-1:0]               bus_dbg_req_data;
+    wire                            bus_dbg_rsp_vld;
+    wire                            bus_dbg_rsp_rdy;
+    wire [1:0]                      bus_dbg_rsp_excp;
+    wire [DEV_DW-1:0]               bus_dbg_rsp_data;
+    wire [DEV_MW-1:0]               bus_rom_req_mask;
+    wire [DEV_DW-1:0]               bus_rom_req_data;
+    wire [DEV_DW-1:0]               bus_rom_rsp_data;
+    wire [DEV_MW-1:0]               bus_slc_req_mask;
+    wire [DEV_DW-1:0]               bus_slc_req_data;
+    wire [DEV_DW-1:0]               bus_slc_rsp_data;
+    wire [DEV_MW-1:0]               bus_eflash_req_mask;
+    wire [DEV_DW-1:0]               bus_eflash_req_data;
+    wire [DEV_DW-1:0]               bus_eflash_rsp_data;
+    wire [DEV_MW-1:0]               bus_perip_req_mask;
+    wire [DEV_DW-1:0]               bus_perip_req_data;
+    wire [DEV_DW-1:0]               bus_perip_rsp_data;
+    wire [DEV_MW-1:0]               bus_dma_slv_req_mask;
+    wire [DEV_DW-1:0]               bus_dma_slv_req_data;
+    wire [DEV_DW-1:0]               bus_dma_slv_rsp_data;
+    wire [DEV_MW-1:0]               bus_xip_req_mask;
+    wire [DEV_DW-1:0]               bus_xip_req_data;
+    wire [DEV_DW-1:0]               bus_xip_rsp_data;
+    wire [DEV_MW-1:0]               bus_qspi_req_mask;
+    wire [DEV_DW-1:0]               bus_qspi_req_data;
+    wire [DEV_DW-1:0]               bus_qspi_rsp_data;
+    wire [DEV_MW-1:0]               bus_dsp_req_mask;
+    wire [DEV_DW-1:0]               bus_dsp_req_data;
+    wire [DEV_DW-1:0]               bus_dsp_rsp_data;
+    wire [DEV_MW-1:0]               bus_gemm_req_mask;
+    wire [DEV_DW-1:0]               bus_gemm_req_data;
+    wire [DEV_DW-1:0]               bus_gemm_rsp_data;
 
     wire                            rom_clk;
     wire                            rom_rst_n;
@@ -147,6 +288,8 @@ module uv_dev_subsys
     wire                            rom_req_rdy;
     wire                            rom_req_read;
     wire [ALEN-1:0]                 rom_req_addr;
+    wire [3:0]                      rom_req_len;
+    wire                            rom_req_wrap;
     wire [MLEN-1:0]                 rom_req_mask;
     wire [DLEN-1:0]                 rom_req_data;
     wire                            rom_rsp_vld;
@@ -167,6 +310,7 @@ module uv_dev_subsys
     wire [1:0]                      slc_rsp_excp;
     wire [DLEN-1:0]                 slc_rsp_data;
     wire [SLC_BASE_LSB-1:0]         slc_req_offset;
+    wire [SLC_BASE_LSB-1:0]         lcl_req_offset;
 
     wire                            sram_clk;
     wire                            sram_rst_n;
@@ -174,12 +318,15 @@ module uv_dev_subsys
     wire                            sram_req_rdy;
     wire                            sram_req_read;
     wire [ALEN-1:0]                 sram_req_addr;
-    wire [MLEN-1:0]                 sram_req_mask;
-    wire [DLEN-1:0]                 sram_req_data;
+    wire [3:0]                      sram_req_len;
+    wire                            sram_req_wrap;
+    wire [3:0]                      sram_req_amo;
+    wire [DEV_MW-1:0]               sram_req_mask;
+    wire [DEV_DW-1:0]               sram_req_data;
     wire                            sram_rsp_vld;
     wire                            sram_rsp_rdy;
     wire [1:0]                      sram_rsp_excp;
-    wire [DLEN-1:0]                 sram_rsp_data;
+    wire [DEV_DW-1:0]               sram_rsp_data;
     wire [SRAM_BASE_LSB-1:0]        sram_req_offset;
 
     wire                            eflash_clk;
@@ -210,19 +357,63 @@ module uv_dev_subsys
     wire [DLEN-1:0]                 perip_rsp_data;
     wire [PERIP_BASE_LSB-1:0]       perip_req_offset;
 
-    wire                            dma_clk;
-    wire                            dma_rst_n;
-    wire                            dma_slv_req_vld;
-    wire                            dma_slv_req_rdy;
-    wire                            dma_slv_req_read;
-    wire [ALEN-1:0]                 dma_slv_req_addr;
-    wire [MLEN-1:0]                 dma_slv_req_mask;
-    wire [DLEN-1:0]                 dma_slv_req_data;
-    wire                            dma_slv_rsp_vld;
-    wire                            dma_slv_rsp_rdy;
-    wire [1:0]                      dma_slv_rsp_excp;
-    wire [DLEN-1:0]                 dma_slv_rsp_data;
-    wire [DMA_BASE_LSB-1:0]         dma_slv_req_offset;
+    wire                            qspi_clk;
+    wire                            qspi_rst_n;
+    wire                            xip_req_vld;
+    wire                            xip_req_rdy;
+    wire                            xip_req_read;
+    wire [ALEN-1:0]                 xip_req_addr;
+    wire [MLEN-1:0]                 xip_req_mask;
+    wire [DLEN-1:0]                 xip_req_data;
+    wire                            xip_rsp_vld;
+    wire                            xip_rsp_rdy;
+    wire [1:0]                      xip_rsp_excp;
+    wire [DLEN-1:0]                 xip_rsp_data;
+    wire [XIP_BASE_LSB-1:0]         xip_req_offset;
+    wire                            qspi_req_vld;
+    wire                            qspi_req_rdy;
+    wire                            qspi_req_read;
+    wire [ALEN-1:0]                 qspi_req_addr;
+    wire [MLEN-1:0]                 qspi_req_mask;
+    wire [DLEN-1:0]                 qspi_req_data;
+    wire                            qspi_rsp_vld;
+    wire                            qspi_rsp_rdy;
+    wire [1:0]                      qspi_rsp_excp;
+    wire [DLEN-1:0]                 qspi_rsp_data;
+    wire [QSPI_BASE_LSB-1:0]        qspi_req_offset;
+    wire                            qspi_irq;
+
+    wire                            dsp_clk;
+    wire                            dsp_rst_n;
+    wire                            dsp_req_vld;
+    wire                            dsp_req_rdy;
+    wire                            dsp_req_read;
+    wire [ALEN-1:0]                 dsp_req_addr;
+    wire [MLEN-1:0]                 dsp_req_mask;
+    wire [DLEN-1:0]                 dsp_req_data;
+    wire                            dsp_rsp_vld;
+    wire                            dsp_rsp_rdy;
+    wire [1:0]                      dsp_rsp_excp;
+    wire [DLEN-1:0]                 dsp_rsp_data;
+    wire [DSP_BASE_LSB-1:0]         dsp_req_offset;
+    wire                            dsp_in_dma_req;
+    wire                            dsp_out_dma_req;
+    wire [DMA_HS_NUM-1:0]           perip_dma_req;
+
+    wire                            gemm_clk;
+    wire                            gemm_rst_n;
+    wire                            gemm_req_vld;
+    wire                            gemm_req_rdy;
+    wire                            gemm_req_read;
+    wire [ALEN-1:0]                 gemm_req_addr;
+    wire [MLEN-1:0]                 gemm_req_mask;
+    wire [DLEN-1:0]                 gemm_req_data;
+    wire                            gemm_rsp_vld;
+    wire                            gemm_rsp_rdy;
+    wire [1:0]                      gemm_rsp_excp;
+    wire [DLEN-1:0]                 gemm_rsp_data;
+    wire [GEMM_BASE_LSB-1:0]        gemm_req_offset;
+    wire                            gemm_irq;
 
     wire [EXT_IRQ_NUM-1:0]          ext_irq_src;
     wire [31:0]                     dev_rst_n;
@@ -233,13 +424,16 @@ module uv_dev_subsys
     assign bus_clk                  = sys_clk;
     assign bus_rst_n                = sys_rst_n & por_rst_n;
     assign bus_mst_dev_vld          = 4'hF;
-    assign bus_slv_dev_vld          = 8'h3F;
+    assign bus_slv_dev_vld          = 10'h3FF;
 
-    uv_bus_fab_4x8
+    uv_bus_fab_4x10
     #(
         .ALEN                       ( ALEN                  ),
-        .DLEN                       ( DLEN                  ),
-        .MLEN                       ( MLEN                  ),
+        .DLEN                       ( DEV_DW                ),
+        .MLEN                       ( DEV_MW                ),
+        .SLV_BURST                  ( 10'b00_0000_0101       ),
+        .SLV_AMO                    ( 10'b00_0000_0100       ),
+        .QOS_EN                     ( 1'b1                  ),
         .SLV0_BASE_LSB              ( ROM_BASE_LSB          ),
         .SLV0_BASE_ADDR             ( ROM_BASE_ADDR         ),
         .SLV1_BASE_LSB              ( SLC_BASE_LSB          ),
@@ -251,7 +445,15 @@ module uv_dev_subsys
         .SLV4_BASE_LSB              ( PERIP_BASE_LSB        ),
         .SLV4_BASE_ADDR             ( PERIP_BASE_ADDR       ),
         .SLV5_BASE_LSB              ( DMA_BASE_LSB          ),
-        .SLV5_BASE_ADDR             ( DMA_BASE_ADDR         )
+        .SLV5_BASE_ADDR             ( DMA_BASE_ADDR         ),
+        .SLV6_BASE_LSB              ( XIP_BASE_LSB          ),
+        .SLV6_BASE_ADDR             ( XIP_BASE_ADDR         ),
+        .SLV7_BASE_LSB              ( QSPI_BASE_LSB         ),
+        .SLV7_BASE_ADDR             ( QSPI_BASE_ADDR        ),
+        .SLV8_BASE_LSB              ( DSP_BASE_LSB          ),
+        .SLV8_BASE_ADDR             ( DSP_BASE_ADDR         ),
+        .SLV9_BASE_LSB              ( GEMM_BASE_LSB         ),
+        .SLV9_BASE_ADDR             ( GEMM_BASE_ADDR        )
     )
     u_devbus
     (
@@ -262,78 +464,104 @@ module uv_dev_subsys
         .mst_dev_vld                ( bus_mst_dev_vld       ),
         .slv_dev_vld                ( bus_slv_dev_vld       ),
 
+        // QoS of masters, set by SLC.
+        .mst_qos_cls                ( bus_qos[7:0]          ),
+        .mst_qos_wgt                ( bus_qos[31:16]        ),
+        .qos_lim                    ( bus_qos[15:8]         ),
+
         // Masters.
-        .mst0_req_vld               ( dev_i_req_vld         ),
-        .mst0_req_rdy               ( dev_i_req_rdy         ),
-        .mst0_req_read              ( 1'b1                  ),
-        .mst0_req_addr              ( dev_i_req_addr        ),
-        .mst0_req_mask              ( {MLEN{1'b1}}          ),
-        .mst0_req_data              ( {DLEN{1'b0}}          ),
-        .mst0_rsp_vld               ( dev_i_rsp_vld         ),
-        .mst0_rsp_rdy               ( dev_i_rsp_rdy         ),
-        .mst0_rsp_excp              ( dev_i_rsp_excp        ),
-        .mst0_rsp_data              ( dev_i_rsp_data        ),
-
-        .mst1_req_vld               ( dev_d_req_vld         ),
-        .mst1_req_rdy               ( dev_d_req_rdy         ),
-        .mst1_req_read              ( dev_d_req_read        ),
-        .mst1_req_addr              ( dev_d_req_addr        ),
-        .mst1_req_mask              ( dev_d_req_mask        ),
-        .mst1_req_data              ( dev_d_req_data        ),
-        .mst1_rsp_vld               ( dev_d_rsp_vld         ),
-        .mst1_rsp_rdy               ( dev_d_rsp_rdy         ),
-        .mst1_rsp_excp              ( dev_d_rsp_excp        ),
-        .mst1_rsp_data              ( dev_d_rsp_data        ),
-
-        .mst2_req_vld               ( dma_req_vld           ),
-        .mst2_req_rdy               ( dma_req_rdy           ),
-        .mst2_req_read              ( dma_req_read          ),
-        .mst2_req_addr              ( dma_req_addr          ),
-        .mst2_req_mask              ( dma_req_mask          ),
-        .mst2_req_data              ( dma_req_data          ),
-        .mst2_rsp_vld               ( dma_rsp_vld           ),
-        .mst2_rsp_rdy               ( dma_rsp_rdy           ),
-        .mst2_rsp_excp              ( dma_rsp_excp          ),
-        .mst2_rsp_data              ( dma_rsp_data          ),
-
-        .mst3_req_vld               ( dbg_req_vld           ),
-        .mst3_req_rdy               ( dbg_req_rdy           ),
-        .mst3_req_read              ( dbg_req_read          ),
-        .mst3_req_addr              ( dbg_req_addr          ),
-        .mst3_req_mask              ( dbg_req_mask          ),
-        .mst3_req_data              ( dbg_req_data          ),
-        .mst3_rsp_vld               ( dbg_rsp_vld           ),
-        .mst3_rsp_rdy               ( dbg_rsp_rdy           ),
-        .mst3_rsp_excp              ( dbg_rsp_excp          ),
-        .mst3_rsp_data              ( dbg_rsp_data          ),
+        .mst0_req_vld               ( bus_dev_i_req_vld     ),
+        .mst0_req_rdy               ( bus_dev_i_req_rdy     ),
+        .mst0_req_read              ( bus_dev_i_req_read    ),
+        .mst0_req_addr              ( bus_dev_i_req_addr    ),
+        .mst0_req_len               ( bus_dev_i_req_len     ),
+        .mst0_req_wrap              ( bus_dev_i_req_wrap    ),
+        .mst0_req_amo               ( bus_dev_i_req_amo     ),
+        .mst0_req_mask              ( bus_dev_i_req_mask    ),
+        .mst0_req_data              ( bus_dev_i_req_data    ),
+        .mst0_rsp_vld               ( bus_dev_i_rsp_vld     ),
+        .mst0_rsp_rdy               ( bus_dev_i_rsp_rdy     ),
+        .mst0_rsp_excp              ( bus_dev_i_rsp_excp    ),
+        .mst0_rsp_data              ( bus_dev_i_rsp_data    ),
+
+        .mst1_req_vld               ( bus_dev_d_req_vld     ),
+        .mst1_req_rdy               ( bus_dev_d_req_rdy     ),
+        .mst1_req_read              ( bus_dev_d_req_read    ),
+        .mst1_req_addr              ( bus_dev_d_req_addr    ),
+        .mst1_req_len               ( bus_dev_d_req_len     ),
+        .mst1_req_wrap              ( bus_dev_d_req_wrap    ),
+        .mst1_req_amo               ( bus_dev_d_req_amo     ),
+        .mst1_req_mask              ( bus_dev_d_req_mask    ),
+        .mst1_req_data              ( bus_dev_d_req_data    ),
+        .mst1_rsp_vld               ( bus_dev_d_rsp_vld     ),
+        .mst1_rsp_rdy               ( bus_dev_d_rsp_rdy     ),
+        .mst1_rsp_excp              ( bus_dev_d_rsp_excp    ),
+        .mst1_rsp_data              ( bus_dev_d_rsp_data    ),
+
+        .mst2_req_vld               ( bus_dma_req_vld       ),
+        .mst2_req_rdy               ( bus_dma_req_rdy       ),
+        .mst2_req_read              ( bus_dma_req_read      ),
+        .mst2_req_addr              ( bus_dma_req_addr      ),
+        .mst2_req_len               ( bus_dma_req_len       ),
+        .mst2_req_wrap              ( bus_dma_req_wrap      ),
+        .mst2_req_amo               ( bus_dma_req_amo       ),
+        .mst2_req_mask              ( bus_dma_req_mask      ),
+        .mst2_req_data              ( bus_dma_req_data      ),
+        .mst2_rsp_vld               ( bus_dma_rsp_vld       ),
+        .mst2_rsp_rdy               ( bus_dma_rsp_rdy       ),
+        .mst2_rsp_excp              ( bus_dma_rsp_excp      ),
+        .mst2_rsp_data              ( bus_dma_rsp_data      ),
+
+        .mst3_req_vld               ( bus_dbg_req_vld       ),
+        .mst3_req_rdy               ( bus_dbg_req_rdy       ),
+        .mst3_req_read              ( bus_dbg_req_read      ),
+        .mst3_req_addr              ( bus_dbg_req_addr      ),
+        .mst3_req_len               ( bus_dbg_req_len       ),
+        .mst3_req_wrap              ( bus_dbg_req_wrap      ),
+        .mst3_req_amo               ( bus_dbg_req_amo       ),
+        .mst3_req_mask              ( bus_dbg_req_mask      ),
+        .mst3_req_data              ( bus_dbg_req_data      ),
+        .mst3_rsp_vld               ( bus_dbg_rsp_vld       ),
+        .mst3_rsp_rdy               ( bus_dbg_rsp_rdy       ),
+        .mst3_rsp_excp              ( bus_dbg_rsp_excp      ),
+        .mst3_rsp_data              ( bus_dbg_rsp_data      ),
 
         // Slaves.
         .slv0_req_vld               ( rom_req_vld           ),
         .slv0_req_rdy               ( rom_req_rdy           ),
         .slv0_req_read              ( rom_req_read          ),
         .slv0_req_addr              ( rom_req_addr          ),
-        .slv0_req_mask              ( rom_req_mask          ),
-        .slv0_req_data              ( rom_req_data          ),
+        .slv0_req_len               ( rom_req_len           ),
+        .slv0_req_wrap              ( rom_req_wrap          ),
+        .slv0_req_amo               (                       ),
+        .slv0_req_mask              ( bus_rom_req_mask      ),
+        .slv0_req_data              ( bus_rom_req_data      ),
         .slv0_rsp_vld               ( rom_rsp_vld           ),
         .slv0_rsp_rdy               ( rom_rsp_rdy           ),
         .slv0_rsp_excp              ( rom_rsp_excp          ),
-        .slv0_rsp_data              ( rom_rsp_data          ),
+        .slv0_rsp_data              ( bus_rom_rsp_data      ),
 
         .slv1_req_vld               ( slc_req_vld           ),
         .slv1_req_rdy               ( slc_req_rdy           ),
         .slv1_req_read              ( slc_req_read          ),
         .slv1_req_addr              ( slc_req_addr          ),
-        .slv1_req_mask              ( slc_req_mask          ),
-        .slv1_req_data              ( slc_req_data          ),
+        .slv1_req_len               (                       ),
+        .slv1_req_wrap              (                       ),
+        .slv1_req_amo               (                       ),
+        .slv1_req_mask              ( bus_slc_req_mask      ),
+        .slv1_req_data              ( bus_slc_req_data      ),
         .slv1_rsp_vld               ( slc_rsp_vld           ),
         .slv1_rsp_rdy               ( slc_rsp_rdy           ),
         .slv1_rsp_excp              ( slc_rsp_excp          ),
-        .slv1_rsp_data              ( slc_rsp_data          ),
+        .slv1_rsp_data              ( bus_slc_rsp_data      ),
 
         .slv2_req_vld               ( sram_req_vld          ),
         .slv2_req_rdy               ( sram_req_rdy          ),
         .slv2_req_read              ( sram_req_read         ),
         .slv2_req_addr              ( sram_req_addr         ),
+        .slv2_req_len               ( sram_req_len          ),
+        .slv2_req_wrap              ( sram_req_wrap         ),
+        .slv2_req_amo               ( sram_req_amo          ),
         .slv2_req_mask              ( sram_req_mask         ),
         .slv2_req_data              ( sram_req_data         ),
         .slv2_rsp_vld               ( sram_rsp_vld          ),
@@ -345,56 +573,439 @@ module uv_dev_subsys
         .slv3_req_rdy               ( eflash_req_rdy        ),
         .slv3_req_read              ( eflash_req_read       ),
         .slv3_req_addr              ( eflash_req_addr       ),
-        .slv3_req_mask              ( eflash_req_mask       ),
-        .slv3_req_data              ( eflash_req_data       ),
+        .slv3_req_len               (                       ),
+        .slv3_req_wrap              (                       ),
+        .slv3_req_amo               (                       ),
+        .slv3_req_mask              ( bus_eflash_req_mask   ),
+        .slv3_req_data              ( bus_eflash_req_data   ),
         .slv3_rsp_vld               ( eflash_rsp_vld        ),
         .slv3_rsp_rdy               ( eflash_rsp_rdy        ),
         .slv3_rsp_excp              ( eflash_rsp_excp       ),
-        .slv3_rsp_data              ( eflash_rsp_data       ),
+        .slv3_rsp_data              ( bus_eflash_rsp_data   ),
 
         .slv4_req_vld               ( perip_req_vld         ),
         .slv4_req_rdy               ( perip_req_rdy         ),
         .slv4_req_read              ( perip_req_read        ),
         .slv4_req_addr              ( perip_req_addr        ),
-        .slv4_req_mask              ( perip_req_mask        ),
-        .slv4_req_data              ( perip_req_data        ),
+        .slv4_req_len               (                       ),
+        .slv4_req_wrap              (                       ),
+        .slv4_req_amo               (                       ),
+        .slv4_req_mask              ( bus_perip_req_mask    ),
+        .slv4_req_data              ( bus_perip_req_data    ),
         .slv4_rsp_vld               ( perip_rsp_vld         ),
         .slv4_rsp_rdy               ( perip_rsp_rdy         ),
         .slv4_rsp_excp              ( perip_rsp_excp        ),
-        .slv4_rsp_data              ( perip_rsp_data        ),
+        .slv4_rsp_data              ( bus_perip_rsp_data    ),
 
         .slv5_req_vld               ( dma_slv_req_vld       ),
         .slv5_req_rdy               ( dma_slv_req_rdy       ),
         .slv5_req_read              ( dma_slv_req_read      ),
         .slv5_req_addr              ( dma_slv_req_addr      ),
-        .slv5_req_mask              ( dma_slv_req_mask      ),
-        .slv5_req_data              ( dma_slv_req_data      ),
+        .slv5_req_len               (                       ),
+        .slv5_req_wrap              (                       ),
+        .slv5_req_amo               (                       ),
+        .slv5_req_mask              ( bus_dma_slv_req_mask  ),
+        .slv5_req_data              ( bus_dma_slv_req_data  ),
         .slv5_rsp_vld               ( dma_slv_rsp_vld       ),
         .slv5_rsp_rdy               ( dma_slv_rsp_rdy       ),
         .slv5_rsp_excp              ( dma_slv_rsp_excp      ),
-        .slv5_rsp_data              ( dma_slv_rsp_data      ),
-
-        .slv6_req_vld               (                       ),
-        .slv6_req_rdy               ( 1'b1                  ),
-        .slv6_req_read              (                       ),
-        .slv6_req_addr              (                       ),
-        .slv6_req_mask              (                       ),
-        .slv6_req_data              (                       ),
-        .slv6_rsp_vld               ( 1'b0                  ),
-        .slv6_rsp_rdy               (                       ),
-        .slv6_rsp_excp              ( 2'b0                  ),
-        .slv6_rsp_data              ( {DLEN{1'b0}}          ),
-
-        .slv7_req_vld               (                       ),
-        .slv7_req_rdy               ( 1'b1                  ),
-        .slv7_req_read              (                       ),
-        .slv7_req_addr              (                       ),
-        .slv7_req_mask              (                       ),
-        .slv7_req_data              (                       ),
-        .slv7_rsp_vld               ( 1'b0                  ),
-        .slv7_rsp_rdy               (                       ),
-        .slv7_rsp_excp              ( 2'b0                  ),
-        .slv7_rsp_data              ( {DLEN{1'b0}}          )
+        .slv5_rsp_data              ( bus_dma_slv_rsp_data  ),
+
+        .slv6_req_vld               ( xip_req_vld           ),
+        .slv6_req_rdy               ( xip_req_rdy           ),
+        .slv6_req_read              ( xip_req_read          ),
+        .slv6_req_addr              ( xip_req_addr          ),
+        .slv6_req_len               (                       ),
+        .slv6_req_wrap              (                       ),
+        .slv6_req_amo               (                       ),
+        .slv6_req_mask              ( bus_xip_req_mask      ),
+        .slv6_req_data              ( bus_xip_req_data      ),
+        .slv6_rsp_vld               ( xip_rsp_vld           ),
+        .slv6_rsp_rdy               ( xip_rsp_rdy           ),
+        .slv6_rsp_excp              ( xip_rsp_excp          ),
+        .slv6_rsp_data              ( bus_xip_rsp_data      ),
+
+        .slv7_req_vld               ( qspi_req_vld          ),
+        .slv7_req_rdy               ( qspi_req_rdy          ),
+        .slv7_req_read              ( qspi_req_read         ),
+        .slv7_req_addr              ( qspi_req_addr         ),
+        .slv7_req_len               (                       ),
+        .slv7_req_wrap              (                       ),
+        .slv7_req_amo               (                       ),
+        .slv7_req_mask              ( bus_qspi_req_mask     ),
+        .slv7_req_data              ( bus_qspi_req_data     ),
+        .slv7_rsp_vld               ( qspi_rsp_vld          ),
+        .slv7_rsp_rdy               ( qspi_rsp_rdy          ),
+        .slv7_rsp_excp              ( qspi_rsp_excp         ),
+        .slv7_rsp_data              ( bus_qspi_rsp_data     ),
+
+        .slv8_req_vld               ( dsp_req_vld           ),
+        .slv8_req_rdy               ( dsp_req_rdy           ),
+        .slv8_req_read              ( dsp_req_read          ),
+        .slv8_req_addr              ( dsp_req_addr          ),
+        .slv8_req_len               (                       ),
+        .slv8_req_wrap              (                       ),
+        .slv8_req_amo               (                       ),
+        .slv8_req_mask              ( bus_dsp_req_mask      ),
+        .slv8_req_data              ( bus_dsp_req_data      ),
+        .slv8_rsp_vld               ( dsp_rsp_vld           ),
+        .slv8_rsp_rdy               ( dsp_rsp_rdy           ),
+        .slv8_rsp_excp              ( dsp_rsp_excp          ),
+        .slv8_rsp_data              ( bus_dsp_rsp_data      ),
+
+        .slv9_req_vld               ( gemm_req_vld          ),
+        .slv9_req_rdy               ( gemm_req_rdy          ),
+        .slv9_req_read              ( gemm_req_read         ),
+        .slv9_req_addr              ( gemm_req_addr         ),
+        .slv9_req_len               (                       ),
+        .slv9_req_wrap              (                       ),
+        .slv9_req_amo               (                       ),
+        .slv9_req_mask              ( bus_gemm_req_mask     ),
+        .slv9_req_data              ( bus_gemm_req_data     ),
+        .slv9_rsp_vld               ( gemm_rsp_vld          ),
+        .slv9_rsp_rdy               ( gemm_rsp_rdy          ),
+        .slv9_rsp_excp              ( gemm_rsp_excp         ),
+        .slv9_rsp_data              ( bus_gemm_rsp_data     )
+    );
+
+    // Width adapters of narrow masters.
+    uv_bus_upsize
+    #(
+        .ALEN                       ( ALEN                  ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  ),
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                )
+    )
+    u_upsize_dev_i
+    (
+        .clk                        ( bus_clk               ),
+        .rst_n                      ( bus_rst_n             ),
+
+        .nrw_req_vld                ( dev_i_req_vld         ),
+        .nrw_req_rdy                ( dev_i_req_rdy         ),
+        .nrw_req_read               ( 1'b1                  ),
+        .nrw_req_addr               ( dev_i_req_addr        ),
+        .nrw_req_len                ( 4'b0                  ),
+        .nrw_req_wrap               ( 1'b0                  ),
+        .nrw_req_amo                ( 4'b0                  ),
+        .nrw_req_mask               ( {MLEN{1'b1}}          ),
+        .nrw_req_data               ( {DLEN{1'b0}}          ),
+
+        .nrw_rsp_vld                ( dev_i_rsp_vld         ),
+        .nrw_rsp_rdy                ( dev_i_rsp_rdy         ),
+        .nrw_rsp_excp               ( dev_i_rsp_excp        ),
+        .nrw_rsp_data               ( dev_i_rsp_data        ),
+
+        .wid_req_vld                ( bus_dev_i_req_vld     ),
+        .wid_req_rdy                ( bus_dev_i_req_rdy     ),
+        .wid_req_read               ( bus_dev_i_req_read    ),
+        .wid_req_addr               ( bus_dev_i_req_addr    ),
+        .wid_req_len                ( bus_dev_i_req_len     ),
+        .wid_req_wrap               ( bus_dev_i_req_wrap    ),
+        .wid_req_amo                ( bus_dev_i_req_amo     ),
+        .wid_req_mask               ( bus_dev_i_req_mask    ),
+        .wid_req_data               ( bus_dev_i_req_data    ),
+
+        .wid_rsp_vld                ( bus_dev_i_rsp_vld     ),
+        .wid_rsp_rdy                ( bus_dev_i_rsp_rdy     ),
+        .wid_rsp_excp               ( bus_dev_i_rsp_excp    ),
+        .wid_rsp_data               ( bus_dev_i_rsp_data    )
+    );
+
+    uv_bus_upsize
+    #(
+        .ALEN                       ( ALEN                  ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  ),
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                )
+    )
+    u_upsize_dev_d
+    (
+        .clk                        ( bus_clk               ),
+        .rst_n                      ( bus_rst_n             ),
+
+        .nrw_req_vld                ( dev_d_req_vld         ),
+        .nrw_req_rdy                ( dev_d_req_rdy         ),
+        .nrw_req_read               ( dev_d_req_read        ),
+        .nrw_req_addr               ( dev_d_req_addr        ),
+        .nrw_req_len                ( 4'b0                  ),
+        .nrw_req_wrap               ( 1'b0                  ),
+        .nrw_req_amo                ( dev_d_req_amo         ),
+        .nrw_req_mask               ( dev_d_req_mask        ),
+        .nrw_req_data               ( dev_d_req_data        ),
+
+        .nrw_rsp_vld                ( dev_d_rsp_vld         ),
+        .nrw_rsp_rdy                ( dev_d_rsp_rdy         ),
+        .nrw_rsp_excp               ( dev_d_rsp_excp        ),
+        .nrw_rsp_data               ( dev_d_rsp_data        ),
+
+        .wid_req_vld                ( bus_dev_d_req_vld     ),
+        .wid_req_rdy                ( bus_dev_d_req_rdy     ),
+        .wid_req_read               ( bus_dev_d_req_read    ),
+        .wid_req_addr               ( bus_dev_d_req_addr    ),
+        .wid_req_len                ( bus_dev_d_req_len     ),
+        .wid_req_wrap               ( bus_dev_d_req_wrap    ),
+        .wid_req_amo                ( bus_dev_d_req_amo     ),
+        .wid_req_mask               ( bus_dev_d_req_mask    ),
+        .wid_req_data               ( bus_dev_d_req_data    ),
+
+        .wid_rsp_vld                ( bus_dev_d_rsp_vld     ),
+        .wid_rsp_rdy                ( bus_dev_d_rsp_rdy     ),
+        .wid_rsp_excp               ( bus_dev_d_rsp_excp    ),
+        .wid_rsp_data               ( bus_dev_d_rsp_data    )
+    );
+
+    uv_bus_upsize
+    #(
+        .ALEN                       ( ALEN                  ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  ),
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                )
+    )
+    u_upsize_dma
+    (
+        .clk                        ( bus_clk               ),
+        .rst_n                      ( bus_rst_n             ),
+
+        .nrw_req_vld                ( dma_req_vld           ),
+        .nrw_req_rdy                ( dma_req_rdy           ),
+        .nrw_req_read               ( dma_req_read          ),
+        .nrw_req_addr               ( dma_req_addr          ),
+        .nrw_req_len                ( dma_req_len           ),
+        .nrw_req_wrap               ( dma_req_wrap          ),
+        .nrw_req_amo                ( 4'b0                  ),
+        .nrw_req_mask               ( dma_req_mask          ),
+        .nrw_req_data               ( dma_req_data          ),
+
+        .nrw_rsp_vld                ( dma_rsp_vld           ),
+        .nrw_rsp_rdy                ( dma_rsp_rdy           ),
+        .nrw_rsp_excp               ( dma_rsp_excp          ),
+        .nrw_rsp_data               ( dma_rsp_data          ),
+
+        .wid_req_vld                ( bus_dma_req_vld       ),
+        .wid_req_rdy                ( bus_dma_req_rdy       ),
+        .wid_req_read               ( bus_dma_req_read      ),
+        .wid_req_addr               ( bus_dma_req_addr      ),
+        .wid_req_len                ( bus_dma_req_len       ),
+        .wid_req_wrap               ( bus_dma_req_wrap      ),
+        .wid_req_amo                ( bus_dma_req_amo       ),
+        .wid_req_mask               ( bus_dma_req_mask      ),
+        .wid_req_data               ( bus_dma_req_data      ),
+
+        .wid_rsp_vld                ( bus_dma_rsp_vld       ),
+        .wid_rsp_rdy                ( bus_dma_rsp_rdy       ),
+        .wid_rsp_excp               ( bus_dma_rsp_excp      ),
+        .wid_rsp_data               ( bus_dma_rsp_data      )
+    );
+
+    uv_bus_upsize
+    #(
+        .ALEN                       ( ALEN                  ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  ),
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                )
+    )
+    u_upsize_dbg
+    (
+        .clk                        ( bus_clk               ),
+        .rst_n                      ( bus_rst_n             ),
+
+        .nrw_req_vld                ( dbg_req_vld           ),
+        .nrw_req_rdy                ( dbg_req_rdy           ),
+        .nrw_req_read               ( dbg_req_read          ),
+        .nrw_req_addr               ( dbg_req_addr          ),
+        .nrw_req_len                ( 4'b0                  ),
+        .nrw_req_wrap               ( 1'b0                  ),
+        .nrw_req_amo                ( 4'b0                  ),
+        .nrw_req_mask               ( dbg_req_mask          ),
+        .nrw_req_data               ( dbg_req_data          ),
+
+        .nrw_rsp_vld                ( dbg_rsp_vld           ),
+        .nrw_rsp_rdy                ( dbg_rsp_rdy           ),
+        .nrw_rsp_excp               ( dbg_rsp_excp          ),
+        .nrw_rsp_data               ( dbg_rsp_data          ),
+
+        .wid_req_vld                ( bus_dbg_req_vld       ),
+        .wid_req_rdy                ( bus_dbg_req_rdy       ),
+        .wid_req_read               ( bus_dbg_req_read      ),
+        .wid_req_addr               ( bus_dbg_req_addr      ),
+        .wid_req_len                ( bus_dbg_req_len       ),
+        .wid_req_wrap               ( bus_dbg_req_wrap      ),
+        .wid_req_amo                ( bus_dbg_req_amo       ),
+        .wid_req_mask               ( bus_dbg_req_mask      ),
+        .wid_req_data               ( bus_dbg_req_data      ),
+
+        .wid_rsp_vld                ( bus_dbg_rsp_vld       ),
+        .wid_rsp_rdy                ( bus_dbg_rsp_rdy       ),
+        .wid_rsp_excp               ( bus_dbg_rsp_excp      ),
+        .wid_rsp_data               ( bus_dbg_rsp_data      )
+    );
+
+    // Width adapters of narrow slaves.
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_rom
+    (
+        .wid_req_mask               ( bus_rom_req_mask      ),
+        .wid_req_data               ( bus_rom_req_data      ),
+        .wid_rsp_data               ( bus_rom_rsp_data      ),
+
+        .nrw_req_mask               ( rom_req_mask          ),
+        .nrw_req_data               ( rom_req_data          ),
+        .nrw_rsp_data               ( rom_rsp_data          )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_slc
+    (
+        .wid_req_mask               ( bus_slc_req_mask      ),
+        .wid_req_data               ( bus_slc_req_data      ),
+        .wid_rsp_data               ( bus_slc_rsp_data      ),
+
+        .nrw_req_mask               ( slc_req_mask          ),
+        .nrw_req_data               ( slc_req_data          ),
+        .nrw_rsp_data               ( slc_rsp_data          )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_eflash
+    (
+        .wid_req_mask               ( bus_eflash_req_mask   ),
+        .wid_req_data               ( bus_eflash_req_data   ),
+        .wid_rsp_data               ( bus_eflash_rsp_data   ),
+
+        .nrw_req_mask               ( eflash_req_mask       ),
+        .nrw_req_data               ( eflash_req_data       ),
+        .nrw_rsp_data               ( eflash_rsp_data       )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_perip
+    (
+        .wid_req_mask               ( bus_perip_req_mask    ),
+        .wid_req_data               ( bus_perip_req_data    ),
+        .wid_rsp_data               ( bus_perip_rsp_data    ),
+
+        .nrw_req_mask               ( perip_req_mask        ),
+        .nrw_req_data               ( perip_req_data        ),
+        .nrw_rsp_data               ( perip_rsp_data        )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_dma_slv
+    (
+        .wid_req_mask               ( bus_dma_slv_req_mask  ),
+        .wid_req_data               ( bus_dma_slv_req_data  ),
+        .wid_rsp_data               ( bus_dma_slv_rsp_data  ),
+
+        .nrw_req_mask               ( dma_slv_req_mask      ),
+        .nrw_req_data               ( dma_slv_req_data      ),
+        .nrw_rsp_data               ( dma_slv_rsp_data      )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_xip
+    (
+        .wid_req_mask               ( bus_xip_req_mask      ),
+        .wid_req_data               ( bus_xip_req_data      ),
+        .wid_rsp_data               ( bus_xip_rsp_data      ),
+
+        .nrw_req_mask               ( xip_req_mask          ),
+        .nrw_req_data               ( xip_req_data          ),
+        .nrw_rsp_data               ( xip_rsp_data          )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_qspi
+    (
+        .wid_req_mask               ( bus_qspi_req_mask     ),
+        .wid_req_data               ( bus_qspi_req_data     ),
+        .wid_rsp_data               ( bus_qspi_rsp_data     ),
+
+        .nrw_req_mask               ( qspi_req_mask         ),
+        .nrw_req_data               ( qspi_req_data         ),
+        .nrw_rsp_data               ( qspi_rsp_data         )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_dsp
+    (
+        .wid_req_mask               ( bus_dsp_req_mask      ),
+        .wid_req_data               ( bus_dsp_req_data      ),
+        .wid_rsp_data               ( bus_dsp_rsp_data      ),
+
+        .nrw_req_mask               ( dsp_req_mask          ),
+        .nrw_req_data               ( dsp_req_data          ),
+        .nrw_rsp_data               ( dsp_rsp_data          )
+    );
+
+    uv_bus_downsize
+    #(
+        .WID_DW                     ( DEV_DW                ),
+        .WID_MW                     ( DEV_MW                ),
+        .NRW_DW                     ( DLEN                  ),
+        .NRW_MW                     ( MLEN                  )
+    )
+    u_downsize_gemm
+    (
+        .wid_req_mask               ( bus_gemm_req_mask     ),
+        .wid_req_data               ( bus_gemm_req_data     ),
+        .wid_rsp_data               ( bus_gemm_rsp_data     ),
+
+        .nrw_req_mask               ( gemm_req_mask         ),
+        .nrw_req_data               ( gemm_req_data         ),
+        .nrw_rsp_data               ( gemm_rsp_data         )
     );
 
     // ROM.
@@ -418,6 +1029,8 @@ module uv_dev_subsys
         .rom_req_rdy                ( rom_req_rdy           ),
         .rom_req_read               ( rom_req_read          ),
         .rom_req_addr               ( rom_req_offset        ),
+        .rom_req_len                ( rom_req_len           ),
+        .rom_req_wrap               ( rom_req_wrap          ),
         .rom_req_mask               ( rom_req_mask          ),
         .rom_req_data               ( rom_req_data          ),
 
@@ -429,7 +1042,8 @@ module uv_dev_subsys
 
     // SLC.
     assign slc_req_offset           = slc_req_addr[SLC_BASE_LSB-1:0];
-    assign ext_irq_src              = {{(EXT_IRQ_NUM-IO_NUM-8){1'b0}}, perip_irq};
+    assign lcl_req_offset           = {{(SLC_BASE_LSB-LCL_BASE_LSB){1'b0}}, lcl_req_addr[LCL_BASE_LSB-1:0]};
+    assign ext_irq_src              = {{(EXT_IRQ_NUM-IO_NUM-11){1'b0}}, gemm_irq, dma_irq, qspi_irq, perip_irq};
 
     uv_slc
     #(
@@ -439,7 +1053,8 @@ module uv_dev_subsys
         .RST_VEC_LEN                ( ALEN                  ),
         .RST_VEC_DEF                ( ROM_START_ADDR        ),
         .EXT_IRQ_NUM                ( EXT_IRQ_NUM           ),
-        .IRQ_PRI_NUM                ( IRQ_PRI_NUM           )
+        .IRQ_PRI_NUM                ( IRQ_PRI_NUM           ),
+        .HART_NUM                   ( HART_NUM              )
     )
     u_slc
     (
@@ -460,6 +1075,18 @@ module uv_dev_subsys
         .slc_rsp_excp               ( slc_rsp_excp          ),
         .slc_rsp_data               ( slc_rsp_data          ),
 
+        .lcl_req_vld                ( lcl_req_vld           ),
+        .lcl_req_rdy                ( lcl_req_rdy           ),
+        .lcl_req_read               ( lcl_req_read          ),
+        .lcl_req_addr               ( lcl_req_offset        ),
+        .lcl_req_mask               ( lcl_req_mask          ),
+        .lcl_req_data               ( lcl_req_data          ),
+
+        .lcl_rsp_vld                ( lcl_rsp_vld           ),
+        .lcl_rsp_rdy                ( lcl_rsp_rdy           ),
+        .lcl_rsp_excp               ( lcl_rsp_excp          ),
+        .lcl_rsp_data               ( lcl_rsp_data          ),
+
         .tmr_irq_clr                ( tmr_irq_clr           ),
         .ext_irq_src                ( ext_irq_src           ),
 
@@ -467,6 +1094,7 @@ module uv_dev_subsys
         .dev_rst_n                  ( dev_rst_n             ),
         .gpio_mode                  ( gpio_mode             ),
         .sys_icg                    (                       ),
+        .bus_qos                    ( bus_qos               ),
         .rst_vec                    ( rst_vec               ),
         .ext_irq                    ( ext_irq               ),
         .sft_irq                    ( sft_irq               ),
@@ -482,8 +1110,8 @@ module uv_dev_subsys
     uv_dev_sram
     #(
         .ALEN                       ( SRAM_BASE_LSB         ),
-        .DLEN                       ( DLEN                  ),
-        .MLEN                       ( MLEN                  ),
+        .DLEN                       ( DEV_DW                ),
+        .MLEN                       ( DEV_MW                ),
         .SRAM_AW                    ( SRAM_AW               ),
         .SRAM_DP                    ( SRAM_DP               )
     )
@@ -496,6 +1124,10 @@ module uv_dev_subsys
         .sram_req_rdy               ( sram_req_rdy          ),
         .sram_req_read              ( sram_req_read         ),
         .sram_req_addr              ( sram_req_offset       ),
+        .sram_req_len               ( sram_req_len          ),
+        .sram_req_wrap              ( sram_req_wrap         ),
+        .sram_req_amo               ( sram_req_amo          ),
+        .sram_req_src               ( 1'b0                  ),
         .sram_req_mask              ( sram_req_mask         ),
         .sram_req_data              ( sram_req_data         ),
 
@@ -516,7 +1148,8 @@ module uv_dev_subsys
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
         .EFLASH_AW                  ( EFLASH_AW             ),
-        .EFLASH_DP                  ( EFLASH_DP             )
+        .EFLASH_DP                  ( EFLASH_DP             ),
+        .READ_WS                    ( EFLASH_WS             )
     )
     u_eflash
     (
@@ -540,13 +1173,15 @@ module uv_dev_subsys
     assign peirp_clk                = sys_clk;
     assign peirp_rst_n              = sys_rst_n & por_rst_n;
     assign perip_req_offset         = perip_req_addr[PERIP_BASE_LSB-1:0];
+    assign dma_hs_req               = perip_dma_req | ({{(DMA_HS_NUM-2){1'b0}}, dsp_out_dma_req, dsp_in_dma_req} << DSP_DMA_HS);
 
     uv_perip_subsys
     #(
         .ALEN                       ( PERIP_BASE_LSB        ),
         .DLEN                       ( DLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .IO_NUM                     ( IO_NUM                )
+        .IO_NUM                     ( IO_NUM                ),
+        .DMA_HS_NUM                 ( DMA_HS_NUM            )
     )
     u_perip_subsys
     (
@@ -582,6 +1217,9 @@ module uv_dev_subsys
         .perip_irq                  ( perip_irq             ),
         .wdt_rst_n                  ( wdt_rst_n             ),
 
+        .perip_dma_req              ( perip_dma_req         ),
+        .perip_dma_ack              ( dma_hs_ack            ),
+
         .gpio_pu                    ( gpio_pu               ),
         .gpio_pd                    ( gpio_pd               ),
         .gpio_ie                    ( gpio_ie               ),
@@ -590,4 +1228,136 @@ module uv_dev_subsys
         .gpio_out                   ( gpio_out              )
     );
 
+    // QSPI with XIP window.
+    assign qspi_clk                 = sys_clk;
+    assign qspi_rst_n               = sys_rst_n & por_rst_n;
+    assign xip_req_offset           = xip_req_addr[XIP_BASE_LSB-1:0];
+    assign qspi_req_offset          = qspi_req_addr[QSPI_BASE_LSB-1:0];
+
+    uv_qspi
+    #(
+        .ALEN                       ( QSPI_BASE_LSB         ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .XIP_ALEN                   ( XIP_BASE_LSB          ),
+        .XIP_AW                     ( XIP_AW                )
+    )
+    u_qspi
+    (
+        .clk                        ( qspi_clk              ),
+        .rst_n                      ( qspi_rst_n            ),
+
+        .qspi_req_vld               ( qspi_req_vld          ),
+        .qspi_req_rdy               ( qspi_req_rdy          ),
+        .qspi_req_read              ( qspi_req_read         ),
+        .qspi_req_addr              ( qspi_req_offset       ),
+        .qspi_req_mask              ( qspi_req_mask         ),
+        .qspi_req_data              ( qspi_req_data         ),
+
+        .qspi_rsp_vld               ( qspi_rsp_vld          ),
+        .qspi_rsp_rdy               ( qspi_rsp_rdy          ),
+        .qspi_rsp_excp              ( qspi_rsp_excp         ),
+        .qspi_rsp_data              ( qspi_rsp_data         ),
+
+        .xip_req_vld                ( xip_req_vld           ),
+        .xip_req_rdy                ( xip_req_rdy           ),
+        .xip_req_read               ( xip_req_read          ),
+        .xip_req_addr               ( xip_req_offset        ),
+        .xip_req_mask               ( xip_req_mask          ),
+        .xip_req_data               ( xip_req_data          ),
+
+        .xip_rsp_vld                ( xip_rsp_vld           ),
+        .xip_rsp_rdy                ( xip_rsp_rdy           ),
+        .xip_rsp_excp               ( xip_rsp_excp          ),
+        .xip_rsp_data               ( xip_rsp_data          ),
+
+        .spi_sck                    ( qspi_sck              ),
+        .spi_cs0                    ( qspi_cs[0]            ),
+        .spi_cs1                    ( qspi_cs[1]            ),
+        .spi_cs2                    ( qspi_cs[2]            ),
+        .spi_cs3                    ( qspi_cs[3]            ),
+        .spi_oen0                   ( qspi_oen[0]           ),
+        .spi_oen1                   ( qspi_oen[1]           ),
+        .spi_oen2                   ( qspi_oen[2]           ),
+        .spi_oen3                   ( qspi_oen[3]           ),
+        .spi_sdo0                   ( qspi_sdo[0]           ),
+        .spi_sdo1                   ( qspi_sdo[1]           ),
+        .spi_sdo2                   ( qspi_sdo[2]           ),
+        .spi_sdo3                   ( qspi_sdo[3]           ),
+        .spi_sdi0                   ( qspi_sdi[0]           ),
+        .spi_sdi1                   ( qspi_sdi[1]           ),
+        .spi_sdi2                   ( qspi_sdi[2]           ),
+        .spi_sdi3                   ( qspi_sdi[3]           ),
+
+        .spi_irq                    ( qspi_irq              )
+    );
+
+    // DSP accelerator, fed by CPU or DMA.
+    assign dsp_clk                  = sys_clk;
+    assign dsp_rst_n                = sys_rst_n & por_rst_n;
+    assign dsp_req_offset           = dsp_req_addr[DSP_BASE_LSB-1:0];
+
+    uv_dsp
+    #(
+        .ALEN                       ( DSP_BASE_LSB          ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .TAP_NUM                    ( DSP_TAP_NUM           ),
+        .FIFO_AW                    ( DSP_FIFO_AW           )
+    )
+    u_dsp
+    (
+        .clk                        ( dsp_clk               ),
+        .rst_n                      ( dsp_rst_n             ),
+
+        .dsp_req_vld                ( dsp_req_vld           ),
+        .dsp_req_rdy                ( dsp_req_rdy           ),
+        .dsp_req_read               ( dsp_req_read          ),
+        .dsp_req_addr               ( dsp_req_offset        ),
+        .dsp_req_mask               ( dsp_req_mask          ),
+        .dsp_req_data               ( dsp_req_data          ),
+
+        .dsp_rsp_vld                ( dsp_rsp_vld           ),
+        .dsp_rsp_rdy                ( dsp_rsp_rdy           ),
+        .dsp_rsp_excp               ( dsp_rsp_excp          ),
+        .dsp_rsp_data               ( dsp_rsp_data          ),
+
+        .dsp_in_dma_req             ( dsp_in_dma_req        ),
+        .dsp_in_dma_ack             ( dma_hs_ack[DSP_DMA_HS] ),
+        .dsp_out_dma_req            ( dsp_out_dma_req       ),
+        .dsp_out_dma_ack            ( dma_hs_ack[DSP_DMA_HS+1] )
+    );
+
+    // GEMM accelerator, with tiles loaded by CPU or DMA.
+    assign gemm_clk                 = sys_clk;
+    assign gemm_rst_n               = sys_rst_n & por_rst_n;
+    assign gemm_req_offset          = gemm_req_addr[GEMM_BASE_LSB-1:0];
+
+    uv_gemm
+    #(
+        .ALEN                       ( GEMM_BASE_LSB         ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .TILE_AW                    ( GEMM_TILE_AW          )
+    )
+    u_gemm
+    (
+        .clk                        ( gemm_clk              ),
+        .rst_n                      ( gemm_rst_n            ),
+
+        .gemm_req_vld               ( gemm_req_vld          ),
+        .gemm_req_rdy               ( gemm_req_rdy          ),
+        .gemm_req_read              ( gemm_req_read         ),
+        .gemm_req_addr              ( gemm_req_offset       ),
+        .gemm_req_mask              ( gemm_req_mask         ),
+        .gemm_req_data              ( gemm_req_data         ),
+
+        .gemm_rsp_vld               ( gemm_rsp_vld          ),
+        .gemm_rsp_rdy               ( gemm_rsp_rdy          ),
+        .gemm_rsp_excp              ( gemm_rsp_excp         ),
+        .gemm_rsp_data              ( gemm_rsp_data         ),
+
+        .gemm_irq                   ( gemm_irq              )
+    );
+
 endmodule
\ No newline at end of file
@@ -0,0 +1,168 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_dma_subsys
+//
+// Designer: Owen
+//
+// Description:
+//      DMA subsystem with a register port on device bus and
+//      a master port to both device bus & DAM.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_dma_subsys
+#(
+    parameter ALEN                  = 32,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter REG_ALEN              = 16,
+    parameter CH_NUM                = 4,
+    parameter HS_NUM                = 16,
+    parameter BUF_AW                = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Register access.
+    input                           dma_slv_req_vld,
+    output                          dma_slv_req_rdy,
+    input                           dma_slv_req_read,
+    input  [REG_ALEN-1:0]           dma_slv_req_addr,
+    input  [MLEN-1:0]               dma_slv_req_mask,
+    input  [DLEN-1:0]               dma_slv_req_data,
+
+    output                          dma_slv_rsp_vld,
+    input                           dma_slv_rsp_rdy,
+    output [1:0]                    dma_slv_rsp_excp,
+    output [DLEN-1:0]               dma_slv_rsp_data,
+
+    // Memory & device access.
+    output                          dma_mst_req_vld,
+    input                           dma_mst_req_rdy,
+    output                          dma_mst_req_read,
+    output [ALEN-1:0]               dma_mst_req_addr,
+    output [3:0]                    dma_mst_req_len,
+    output                          dma_mst_req_wrap,
+    output [MLEN-1:0]               dma_mst_req_mask,
+    output [DLEN-1:0]               dma_mst_req_data,
+
+    input                           dma_mst_rsp_vld,
+    output                          dma_mst_rsp_rdy,
+    input  [1:0]                    dma_mst_rsp_excp,
+    input  [DLEN-1:0]               dma_mst_rsp_data,
+
+    // Peripheral handshakes.
+    input  [HS_NUM-1:0]             dma_hs_req,
+    output [HS_NUM-1:0]             dma_hs_ack,
+
+    output                          dma_busy,
+    output                          dma_irq
+);
+
+    localparam BUS_PIPE             = 1'b1;
+    localparam BUS_POST             = 1'b1;
+
+    wire                            dma_psel;
+    wire                            dma_penable;
+    wire   [2:0]                    dma_pprot;
+    wire   [REG_ALEN-1:0]           dma_paddr;
+    wire   [MLEN-1:0]               dma_pstrb;
+    wire                            dma_pwrite;
+    wire   [DLEN-1:0]               dma_pwdata;
+    wire   [DLEN-1:0]               dma_prdata;
+    wire                            dma_pready;
+    wire                            dma_pslverr;
+
+    uv_bus_to_apb
+    #(
+        .ALEN                       ( REG_ALEN              ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .PIPE                       ( BUS_PIPE              ),
+        .POST_WR                    ( BUS_POST              )
+    )
+    u_bus_to_apb
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // Bus ports.
+        .bus_req_vld                ( dma_slv_req_vld       ),
+        .bus_req_rdy                ( dma_slv_req_rdy       ),
+        .bus_req_read               ( dma_slv_req_read      ),
+        .bus_req_addr               ( dma_slv_req_addr      ),
+        .bus_req_mask               ( dma_slv_req_mask      ),
+        .bus_req_data               ( dma_slv_req_data      ),
+
+        .bus_rsp_vld                ( dma_slv_rsp_vld       ),
+        .bus_rsp_rdy                ( dma_slv_rsp_rdy       ),
+        .bus_rsp_excp               ( dma_slv_rsp_excp      ),
+        .bus_rsp_data               ( dma_slv_rsp_data      ),
+
+        // APB ports.
+        .apb_psel                   ( dma_psel              ),
+        .apb_penable                ( dma_penable           ),
+        .apb_pprot                  ( dma_pprot             ),
+        .apb_paddr                  ( dma_paddr             ),
+        .apb_pstrb                  ( dma_pstrb             ),
+        .apb_pwrite                 ( dma_pwrite            ),
+        .apb_pwdata                 ( dma_pwdata            ),
+        .apb_prdata                 ( dma_prdata            ),
+        .apb_pready                 ( dma_pready            ),
+        .apb_pslverr                ( dma_pslverr           )
+    );
+
+    uv_dma
+    #(
+        .ALEN                       ( REG_ALEN              ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .MST_ALEN                   ( ALEN                  ),
+        .CH_NUM                     ( CH_NUM                ),
+        .HS_NUM                     ( HS_NUM                ),
+        .BUF_AW                     ( BUF_AW                )
+    )
+    u_dma
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        // APB ports.
+        .dma_psel                   ( dma_psel              ),
+        .dma_penable                ( dma_penable           ),
+        .dma_pprot                  ( dma_pprot             ),
+        .dma_paddr                  ( dma_paddr             ),
+        .dma_pstrb                  ( dma_pstrb             ),
+        .dma_pwrite                 ( dma_pwrite            ),
+        .dma_pwdata                 ( dma_pwdata            ),
+        .dma_prdata                 ( dma_prdata            ),
+        .dma_pready                 ( dma_pready            ),
+        .dma_pslverr                ( dma_pslverr           ),
+
+        // Bus master.
+        .mst_req_vld                ( dma_mst_req_vld       ),
+        .mst_req_rdy                ( dma_mst_req_rdy       ),
+        .mst_req_read               ( dma_mst_req_read      ),
+        .mst_req_addr               ( dma_mst_req_addr      ),
+        .mst_req_len                ( dma_mst_req_len       ),
+        .mst_req_wrap               ( dma_mst_req_wrap      ),
+        .mst_req_mask               ( dma_mst_req_mask      ),
+        .mst_req_data               ( dma_mst_req_data      ),
+
+        .mst_rsp_vld                ( dma_mst_rsp_vld       ),
+        .mst_rsp_rdy                ( dma_mst_rsp_rdy       ),
+        .mst_rsp_excp               ( dma_mst_rsp_excp      ),
+        .mst_rsp_data               ( dma_mst_rsp_data      ),
+
+        // Peripheral handshakes.
+        .dma_hs_req                 ( dma_hs_req            ),
+        .dma_hs_ack                 ( dma_hs_ack            ),
+
+        .dma_busy                   ( dma_busy              ),
+        .dma_irq                    ( dma_irq               )
+    );
+
+endmodule
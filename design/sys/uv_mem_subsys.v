@@ -0,0 +1,242 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: uv_mem_subsys
+//
+// Designer: Owen
+//
+// Description:
+//      External memory subsystem.
+//      Inst fetching & data accesses are widened to lines by
+//      line buffers, and the 128-bit line bus is served by an
+//      SDRAM controller with one port for each side.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module uv_mem_subsys
+#(
+    parameter ALEN                  = 32,
+    parameter INST_DW               = 64,
+    parameter DATA_DW               = 32,
+    parameter DATA_MW               = DATA_DW / 8,
+    parameter LINE_DW               = 128,
+    parameter SDRAM_DQ_DW           = 16,
+    parameter SDRAM_BA_AW           = 2,
+    parameter SDRAM_ROW_AW          = 13,
+    parameter SDRAM_COL_AW          = 9
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    // Inst fetching.
+    input                           ext_i_req_vld,
+    output                          ext_i_req_rdy,
+    input  [ALEN-1:0]               ext_i_req_addr,
+
+    output                          ext_i_rsp_vld,
+    input                           ext_i_rsp_rdy,
+    output [1:0]                    ext_i_rsp_excp,
+    output [INST_DW-1:0]            ext_i_rsp_data,
+
+    // Data access.
+    input                           ext_d_req_vld,
+    output                          ext_d_req_rdy,
+    input                           ext_d_req_read,
+    input  [ALEN-1:0]               ext_d_req_addr,
+    input  [DATA_MW-1:0]            ext_d_req_mask,
+    input  [DATA_DW-1:0]            ext_d_req_data,
+
+    output                          ext_d_rsp_vld,
+    input                           ext_d_rsp_rdy,
+    output [1:0]                    ext_d_rsp_excp,
+    output [DATA_DW-1:0]            ext_d_rsp_data,
+
+    // SDRAM.
+    output                          sdram_cke,
+    output                          sdram_cs_n,
+    output                          sdram_ras_n,
+    output                          sdram_cas_n,
+    output                          sdram_we_n,
+    output [SDRAM_BA_AW-1:0]        sdram_ba,
+    output [SDRAM_ROW_AW-1:0]       sdram_addr,
+    output [SDRAM_DQ_DW/8-1:0]      sdram_dqm,
+    output                          sdram_dq_oen,
+    output [SDRAM_DQ_DW-1:0]        sdram_dq_out,
+    input  [SDRAM_DQ_DW-1:0]        sdram_dq_in
+);
+
+    // The window is aliased beyond the SDRAM size.
+    localparam PORT_AW              = SDRAM_ROW_AW + SDRAM_BA_AW + SDRAM_COL_AW + $clog2(SDRAM_DQ_DW / 8);
+    localparam LINE_MW              = LINE_DW / 8;
+    localparam INST_MW              = INST_DW / 8;
+
+    // Line bus.
+    wire                            line_i_req_vld;
+    wire                            line_i_req_rdy;
+    wire                            line_i_req_read;
+    wire [PORT_AW-1:0]              line_i_req_addr;
+    wire [LINE_MW-1:0]              line_i_req_mask;
+    wire [LINE_DW-1:0]              line_i_req_data;
+
+    wire                            line_i_rsp_vld;
+    wire                            line_i_rsp_rdy;
+    wire [1:0]                      line_i_rsp_excp;
+    wire [LINE_DW-1:0]              line_i_rsp_data;
+
+    wire                            line_d_req_vld;
+    wire                            line_d_req_rdy;
+    wire                            line_d_req_read;
+    wire [PORT_AW-1:0]              line_d_req_addr;
+    wire [LINE_MW-1:0]              line_d_req_mask;
+    wire [LINE_DW-1:0]              line_d_req_data;
+
+    wire                            line_d_rsp_vld;
+    wire                            line_d_rsp_rdy;
+    wire [1:0]                      line_d_rsp_excp;
+    wire [LINE_DW-1:0]              line_d_rsp_data;
+
+    // Lines written by data side are dropped from inst side.
+    wire                            line_d_wr_vld;
+    wire [PORT_AW-1:0]              line_d_wr_addr;
+
+    uv_line_buf
+    #(
+        .ALEN                       ( PORT_AW               ),
+        .DLEN                       ( INST_DW               ),
+        .MLEN                       ( INST_MW               ),
+        .LINE_DW                    ( LINE_DW               ),
+        .LINE_MW                    ( LINE_MW               )
+    )
+    u_line_buf_i
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .bus_req_vld                ( ext_i_req_vld         ),
+        .bus_req_rdy                ( ext_i_req_rdy         ),
+        .bus_req_read               ( 1'b1                  ),
+        .bus_req_addr               ( ext_i_req_addr[PORT_AW-1:0] ),
+        .bus_req_mask               ( {INST_MW{1'b1}}       ),
+        .bus_req_data               ( {INST_DW{1'b0}}       ),
+
+        .bus_rsp_vld                ( ext_i_rsp_vld         ),
+        .bus_rsp_rdy                ( ext_i_rsp_rdy         ),
+        .bus_rsp_excp               ( ext_i_rsp_excp        ),
+        .bus_rsp_data               ( ext_i_rsp_data        ),
+
+        .line_req_vld               ( line_i_req_vld        ),
+        .line_req_rdy               ( line_i_req_rdy        ),
+        .line_req_read              ( line_i_req_read       ),
+        .line_req_addr              ( line_i_req_addr       ),
+        .line_req_mask              ( line_i_req_mask       ),
+        .line_req_data              ( line_i_req_data       ),
+
+        .line_rsp_vld               ( line_i_rsp_vld        ),
+        .line_rsp_rdy               ( line_i_rsp_rdy        ),
+        .line_rsp_excp              ( line_i_rsp_excp       ),
+        .line_rsp_data              ( line_i_rsp_data       ),
+
+        .wr_vld                     (                       ),
+        .wr_addr                    (                       ),
+        .inv_vld                    ( line_d_wr_vld         ),
+        .inv_addr                   ( line_d_wr_addr        )
+    );
+
+    uv_line_buf
+    #(
+        .ALEN                       ( PORT_AW               ),
+        .DLEN                       ( DATA_DW               ),
+        .MLEN                       ( DATA_MW               ),
+        .LINE_DW                    ( LINE_DW               ),
+        .LINE_MW                    ( LINE_MW               )
+    )
+    u_line_buf_d
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .bus_req_vld                ( ext_d_req_vld         ),
+        .bus_req_rdy                ( ext_d_req_rdy         ),
+        .bus_req_read               ( ext_d_req_read        ),
+        .bus_req_addr               ( ext_d_req_addr[PORT_AW-1:0] ),
+        .bus_req_mask               ( ext_d_req_mask        ),
+        .bus_req_data               ( ext_d_req_data        ),
+
+        .bus_rsp_vld                ( ext_d_rsp_vld         ),
+        .bus_rsp_rdy                ( ext_d_rsp_rdy         ),
+        .bus_rsp_excp               ( ext_d_rsp_excp        ),
+        .bus_rsp_data               ( ext_d_rsp_data        ),
+
+        .line_req_vld               ( line_d_req_vld        ),
+        .line_req_rdy               ( line_d_req_rdy        ),
+        .line_req_read              ( line_d_req_read       ),
+        .line_req_addr              ( line_d_req_addr       ),
+        .line_req_mask              ( line_d_req_mask       ),
+        .line_req_data              ( line_d_req_data       ),
+
+        .line_rsp_vld               ( line_d_rsp_vld        ),
+        .line_rsp_rdy               ( line_d_rsp_rdy        ),
+        .line_rsp_excp              ( line_d_rsp_excp       ),
+        .line_rsp_data              ( line_d_rsp_data       ),
+
+        .wr_vld                     ( line_d_wr_vld         ),
+        .wr_addr                    ( line_d_wr_addr        ),
+        .inv_vld                    ( 1'b0                  ),
+        .inv_addr                   ( {PORT_AW{1'b0}}       )
+    );
+
+    uv_sdram_ctrl
+    #(
+        .DQ_DW                      ( SDRAM_DQ_DW           ),
+        .BA_AW                      ( SDRAM_BA_AW           ),
+        .ROW_AW                     ( SDRAM_ROW_AW          ),
+        .COL_AW                     ( SDRAM_COL_AW          ),
+        .PORT_AW                    ( PORT_AW               ),
+        .LINE_DW                    ( LINE_DW               ),
+        .LINE_MW                    ( LINE_MW               )
+    )
+    u_sdram_ctrl
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .port_a_req_vld             ( line_i_req_vld        ),
+        .port_a_req_rdy             ( line_i_req_rdy        ),
+        .port_a_req_read            ( line_i_req_read       ),
+        .port_a_req_addr            ( line_i_req_addr       ),
+        .port_a_req_mask            ( line_i_req_mask       ),
+        .port_a_req_data            ( line_i_req_data       ),
+
+        .port_a_rsp_vld             ( line_i_rsp_vld        ),
+        .port_a_rsp_rdy             ( line_i_rsp_rdy        ),
+        .port_a_rsp_excp            ( line_i_rsp_excp       ),
+        .port_a_rsp_data            ( line_i_rsp_data       ),
+
+        .port_b_req_vld             ( line_d_req_vld        ),
+        .port_b_req_rdy             ( line_d_req_rdy        ),
+        .port_b_req_read            ( line_d_req_read       ),
+        .port_b_req_addr            ( line_d_req_addr       ),
+        .port_b_req_mask            ( line_d_req_mask       ),
+        .port_b_req_data            ( line_d_req_data       ),
+
+        .port_b_rsp_vld             ( line_d_rsp_vld        ),
+        .port_b_rsp_rdy             ( line_d_rsp_rdy        ),
+        .port_b_rsp_excp            ( line_d_rsp_excp       ),
+        .port_b_rsp_data            ( line_d_rsp_data       ),
+
+        .sdram_cke                  ( sdram_cke             ),
+        .sdram_cs_n                 ( sdram_cs_n            ),
+        .sdram_ras_n                ( sdram_ras_n           ),
+        .sdram_cas_n                ( sdram_cas_n           ),
+        .sdram_we_n                 ( sdram_we_n            ),
+        .sdram_ba                   ( sdram_ba              ),
+        .sdram_addr                 ( sdram_addr            ),
+        .sdram_dqm                  ( sdram_dqm             ),
+        .sdram_dq_oen               ( sdram_dq_oen          ),
+        .sdram_dq_out               ( sdram_dq_out          ),
+        .sdram_dq_in                ( sdram_dq_in           )
+    );
+
+endmodule
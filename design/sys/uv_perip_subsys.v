@@ -16,7 +16,8 @@ module uv_perip_subsys
     parameter ALEN                  = 16,
     parameter DLEN                  = 32,
     parameter MLEN                  = DLEN / 8,
-    parameter IO_NUM                = 32
+    parameter IO_NUM                = 32,
+    parameter DMA_HS_NUM            = 16
 )
 (
     input                           clk,
@@ -51,6 +52,9 @@ module uv_perip_subsys
     output [IO_NUM+7:0]             perip_irq,
     output                          wdt_rst_n,
 
+    output [DMA_HS_NUM-1:0]         perip_dma_req,
+    input  [DMA_HS_NUM-1:0]         perip_dma_ack,
+
     output [IO_NUM-1:0]             gpio_pu,
     output [IO_NUM-1:0]             gpio_pd,
     output [IO_NUM-1:0]             gpio_ie,
@@ -61,6 +65,10 @@ module uv_perip_subsys
 
     localparam UDLY                 = 1;
     localparam MUX_IO_NUM           = 10;
+    localparam PWM_CH               = 4;
+    localparam CAP_CH               = 2;
+    localparam CAP_AW               = 3;
+    localparam EVT_CH               = 8;
 
     localparam GPIO_BASE_LSB        = 12;
     localparam GPIO_BASE_ADDR       = 4'h0;
@@ -78,6 +86,14 @@ module uv_perip_subsys
     localparam WDT_BASE_ADDR        = 4'h6;
     localparam DBG_BASE_LSB         = 12;
     localparam DBG_BASE_ADDR        = 4'h7;
+
+    // Debugger, CRC & event router share the last slot.
+    localparam DBG_SUB_LSB          = 10;
+    localparam DBG_SUB_ADDR         = 2'h0;
+    localparam CRC_SUB_LSB          = 10;
+    localparam CRC_SUB_ADDR         = 2'h1;
+    localparam EVT_SUB_LSB          = 11;
+    localparam EVT_SUB_ADDR         = 1'h1;
     
     wire [7:0]                      bus_slv_dev_vld;
 
@@ -177,6 +193,41 @@ module uv_perip_subsys
     wire [DLEN-1:0]                 dbg_rsp_data;
     wire [DBG_BASE_LSB-1:0]         dbg_req_offset;
 
+    wire                            dbg_sub_req_vld;
+    wire                            dbg_sub_req_rdy;
+    wire                            dbg_sub_req_read;
+    wire [DBG_BASE_LSB-1:0]         dbg_sub_req_addr;
+    wire [MLEN-1:0]                 dbg_sub_req_mask;
+    wire [DLEN-1:0]                 dbg_sub_req_data;
+    wire                            dbg_sub_rsp_vld;
+    wire                            dbg_sub_rsp_rdy;
+    wire [1:0]                      dbg_sub_rsp_excp;
+    wire [DLEN-1:0]                 dbg_sub_rsp_data;
+
+    wire                            crc_req_vld;
+    wire                            crc_req_rdy;
+    wire                            crc_req_read;
+    wire [DBG_BASE_LSB-1:0]         crc_req_addr;
+    wire [MLEN-1:0]                 crc_req_mask;
+    wire [DLEN-1:0]                 crc_req_data;
+    wire                            crc_rsp_vld;
+    wire                            crc_rsp_rdy;
+    wire [1:0]                      crc_rsp_excp;
+    wire [DLEN-1:0]                 crc_rsp_data;
+    wire [CRC_SUB_LSB-1:0]          crc_req_offset;
+
+    wire                            evt_req_vld;
+    wire                            evt_req_rdy;
+    wire                            evt_req_read;
+    wire [DBG_BASE_LSB-1:0]         evt_req_addr;
+    wire [MLEN-1:0]                 evt_req_mask;
+    wire [DLEN-1:0]                 evt_req_data;
+    wire                            evt_rsp_vld;
+    wire                            evt_rsp_rdy;
+    wire [1:0]                      evt_rsp_excp;
+    wire [DLEN-1:0]                 evt_rsp_data;
+    wire [EVT_SUB_LSB-1:0]          evt_req_offset;
+
     wire [IO_NUM-1:0]               dev_gpio_pu;
     wire [IO_NUM-1:0]               dev_gpio_pd;
     wire [IO_NUM-1:0]               dev_gpio_ie;
@@ -205,6 +256,35 @@ module uv_perip_subsys
     wire                            tmr_irq;
     wire                            wdt_irq;
     wire                            tmr_evt;
+    wire                            pwm_irq;
+    wire                            tmr_evt_lvl;
+    wire                            pwm_evt;
+    wire                            spi0_done_evt;
+    wire                            spi1_done_evt;
+
+    wire                            tmr_task_start;
+    wire                            tmr_task_stop;
+    wire                            pwm_task_start;
+    wire                            pwm_task_stop;
+    wire                            spi0_task_start;
+    wire                            spi1_task_start;
+    wire [IO_NUM-1:0]               gpio_task_set;
+    wire [IO_NUM-1:0]               gpio_task_clr;
+    wire [IO_NUM-1:0]               gpio_task_tgl;
+
+    wire [PWM_CH*2-1:0]             pwm_oe;
+    wire [PWM_CH*2-1:0]             pwm_out;
+    wire [CAP_CH-1:0]               cap_ie;
+    wire [CAP_CH-1:0]               cap_in;
+
+    wire                            uart_tx_dma_req;
+    wire                            uart_rx_dma_req;
+    wire                            spi0_tx_dma_req;
+    wire                            spi0_rx_dma_req;
+    wire                            spi1_tx_dma_req;
+    wire                            spi1_rx_dma_req;
+    wire [1:0]                      evt_dma_req;
+    wire                            crc_dma_req;
 
     assign perip_irq[0]             = uart_irq;
     assign perip_irq[1]             = spi0_irq;
@@ -212,10 +292,19 @@ module uv_perip_subsys
     assign perip_irq[3]             = i2c_irq;
     assign perip_irq[4]             = tmr_irq;
     assign perip_irq[5]             = wdt_irq;
-    assign perip_irq[6]             = 1'b0;
+    assign perip_irq[6]             = pwm_irq;
     assign perip_irq[7]             = 1'b0;
     assign perip_irq[IO_NUM+7:8]    = gpio_irq;
 
+    // Timer events, whether IRQ is enabled or not.
+    assign tmr_evt_lvl              = tmr_irq | tmr_evt;
+
+    // DMA handshakes: 0 UART TX, 1 UART RX, 2 SPI0 TX, 3 SPI0 RX, 4 SPI1 TX, 5 SPI1 RX, 6 & 7 EVT, 8 CRC.
+    assign perip_dma_req            = {{(DMA_HS_NUM-9){1'b0}}, crc_dma_req, evt_dma_req,
+                                       spi1_rx_dma_req, spi1_tx_dma_req,
+                                       spi0_rx_dma_req, spi0_tx_dma_req,
+                                       uart_rx_dma_req, uart_tx_dma_req};
+
     assign gpio_req_offset          = gpio_req_addr[GPIO_BASE_LSB-1:0];
     assign uart_req_offset          = uart_req_addr[UART_BASE_LSB-1:0];
     assign spi0_req_offset          = spi0_req_addr[SPI0_BASE_LSB-1:0];
@@ -224,6 +313,8 @@ module uv_perip_subsys
     assign wdt_req_offset           = wdt_req_addr[WDT_BASE_LSB-1:0];
     assign i2c_req_offset           = i2c_req_addr[I2C_BASE_LSB-1:0];
     assign dbg_req_offset           = dbg_req_addr[DBG_BASE_LSB-1:0];
+    assign crc_req_offset           = crc_req_addr[CRC_SUB_LSB-1:0];
+    assign evt_req_offset           = evt_req_addr[EVT_SUB_LSB-1:0];
 
     // Bus Bridge.
     assign bus_slv_dev_vld          = 8'hFF;
@@ -360,6 +451,72 @@ module uv_perip_subsys
         .slv7_rsp_data              ( dbg_rsp_data          )
     );
 
+    uv_bus_fab_1x3
+    #(
+        .ALEN                       ( DBG_BASE_LSB          ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .SLV0_BASE_LSB              ( DBG_SUB_LSB           ),
+        .SLV0_BASE_ADDR             ( DBG_SUB_ADDR          ),
+        .SLV1_BASE_LSB              ( CRC_SUB_LSB           ),
+        .SLV1_BASE_ADDR             ( CRC_SUB_ADDR          ),
+        .SLV2_BASE_LSB              ( EVT_SUB_LSB           ),
+        .SLV2_BASE_ADDR             ( EVT_SUB_ADDR          )
+    )
+    u_dbg_fab
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .mst_req_vld                ( dbg_req_vld           ),
+        .mst_req_rdy                ( dbg_req_rdy           ),
+        .mst_req_read               ( dbg_req_read          ),
+        .mst_req_addr               ( dbg_req_offset        ),
+        .mst_req_amo                ( 4'b0                  ),
+        .mst_req_mask               ( dbg_req_mask          ),
+        .mst_req_data               ( dbg_req_data          ),
+        .mst_rsp_vld                ( dbg_rsp_vld           ),
+        .mst_rsp_rdy                ( dbg_rsp_rdy           ),
+        .mst_rsp_excp               ( dbg_rsp_excp          ),
+        .mst_rsp_data               ( dbg_rsp_data          ),
+
+        .slv0_req_vld               ( dbg_sub_req_vld       ),
+        .slv0_req_rdy               ( dbg_sub_req_rdy       ),
+        .slv0_req_read              ( dbg_sub_req_read      ),
+        .slv0_req_addr              ( dbg_sub_req_addr      ),
+        .slv0_req_amo               (                       ),
+        .slv0_req_mask              ( dbg_sub_req_mask      ),
+        .slv0_req_data              ( dbg_sub_req_data      ),
+        .slv0_rsp_vld               ( dbg_sub_rsp_vld       ),
+        .slv0_rsp_rdy               ( dbg_sub_rsp_rdy       ),
+        .slv0_rsp_excp              ( dbg_sub_rsp_excp      ),
+        .slv0_rsp_data              ( dbg_sub_rsp_data      ),
+
+        .slv1_req_vld               ( crc_req_vld           ),
+        .slv1_req_rdy               ( crc_req_rdy           ),
+        .slv1_req_read              ( crc_req_read          ),
+        .slv1_req_addr              ( crc_req_addr          ),
+        .slv1_req_amo               (                       ),
+        .slv1_req_mask              ( crc_req_mask          ),
+        .slv1_req_data              ( crc_req_data          ),
+        .slv1_rsp_vld               ( crc_rsp_vld           ),
+        .slv1_rsp_rdy               ( crc_rsp_rdy           ),
+        .slv1_rsp_excp              ( crc_rsp_excp          ),
+        .slv1_rsp_data              ( crc_rsp_data          ),
+
+        .slv2_req_vld               ( evt_req_vld           ),
+        .slv2_req_rdy               ( evt_req_rdy           ),
+        .slv2_req_read              ( evt_req_read          ),
+        .slv2_req_addr              ( evt_req_addr          ),
+        .slv2_req_amo               (                       ),
+        .slv2_req_mask              ( evt_req_mask          ),
+        .slv2_req_data              ( evt_req_data          ),
+        .slv2_rsp_vld               ( evt_rsp_vld           ),
+        .slv2_rsp_rdy               ( evt_rsp_rdy           ),
+        .slv2_rsp_excp              ( evt_rsp_excp          ),
+        .slv2_rsp_data              ( evt_rsp_data          )
+    );
+
     // GPIO.
     uv_gpio
     #(
@@ -394,7 +551,11 @@ module uv_perip_subsys
         .gpio_in                    ( dev_gpio_in           ),
         .gpio_oe                    ( dev_gpio_oe           ),
         .gpio_out                   ( dev_gpio_out          ),
-        .gpio_irq                   ( gpio_irq              )
+        .gpio_irq                   ( gpio_irq              ),
+
+        .gpio_task_set              ( gpio_task_set         ),
+        .gpio_task_clr              ( gpio_task_clr         ),
+        .gpio_task_tgl              ( gpio_task_tgl         )
     );
 
     // UART.
@@ -424,7 +585,12 @@ module uv_perip_subsys
         .uart_rx                    ( uart_rx               ),
         .uart_tx                    ( uart_tx               ),
 
-        .uart_irq                   ( uart_irq              )
+        .uart_irq                   ( uart_irq              ),
+
+        .uart_tx_dma_req            ( uart_tx_dma_req       ),
+        .uart_tx_dma_ack            ( perip_dma_ack[0]      ),
+        .uart_rx_dma_req            ( uart_rx_dma_req       ),
+        .uart_rx_dma_ack            ( perip_dma_ack[1]      )
     );
 
     // I2C.
@@ -491,7 +657,15 @@ module uv_perip_subsys
         .spi_mosi                   ( spi0_mosi             ),
         .spi_miso                   ( spi0_miso             ),
 
-        .spi_irq                    ( spi0_irq              )
+        .spi_irq                    ( spi0_irq              ),
+
+        .spi_tx_dma_req             ( spi0_tx_dma_req       ),
+        .spi_tx_dma_ack             ( perip_dma_ack[2]      ),
+        .spi_rx_dma_req             ( spi0_rx_dma_req       ),
+        .spi_rx_dma_ack             ( perip_dma_ack[3]      ),
+
+        .spi_desc_trig              ( spi0_task_start       ),
+        .spi_done_evt               ( spi0_done_evt         )
     );
 
     uv_spi
@@ -523,7 +697,15 @@ module uv_perip_subsys
         .spi_mosi                   ( spi1_mosi             ),
         .spi_miso                   ( spi1_miso             ),
 
-        .spi_irq                    ( spi1_irq              )
+        .spi_irq                    ( spi1_irq              ),
+
+        .spi_tx_dma_req             ( spi1_tx_dma_req       ),
+        .spi_tx_dma_ack             ( perip_dma_ack[4]      ),
+        .spi_rx_dma_req             ( spi1_rx_dma_req       ),
+        .spi_rx_dma_ack             ( perip_dma_ack[5]      ),
+
+        .spi_desc_trig              ( spi1_task_start       ),
+        .spi_done_evt               ( spi1_done_evt         )
     );
 
     // Multi-channel Timer.
@@ -531,7 +713,10 @@ module uv_perip_subsys
     #(
         .ALEN                       ( TMR_BASE_LSB          ),
         .DLEN                       ( DLEN                  ),
-        .MLEN                       ( MLEN                  )
+        .MLEN                       ( MLEN                  ),
+        .PWM_CH                     ( PWM_CH                ),
+        .CAP_CH                     ( CAP_CH                ),
+        .CAP_AW                     ( CAP_AW                )
     )
     u_tmr
     (
@@ -554,7 +739,19 @@ module uv_perip_subsys
         .tmr_rsp_data               ( tmr_rsp_data          ),
 
         .tmr_irq                    ( tmr_irq               ),
-        .tmr_evt                    ( tmr_evt               )
+        .tmr_evt                    ( tmr_evt               ),
+
+        .pwm_oe                     ( pwm_oe                ),
+        .pwm_out                    ( pwm_out               ),
+        .cap_ie                     ( cap_ie                ),
+        .cap_in                     ( cap_in                ),
+        .pwm_irq                    ( pwm_irq               ),
+
+        .tmr_task_start             ( tmr_task_start        ),
+        .tmr_task_stop              ( tmr_task_stop         ),
+        .pwm_task_start             ( pwm_task_start        ),
+        .pwm_task_stop              ( pwm_task_stop         ),
+        .pwm_evt                    ( pwm_evt               )
     );
 
     // Watch Dog Timer.
@@ -600,23 +797,103 @@ module uv_perip_subsys
         .clk                        ( clk                   ),
         .rst_n                      ( rst_n                 ),
 
-        .dbg_req_vld                ( dbg_req_vld           ),
-        .dbg_req_rdy                ( dbg_req_rdy           ),
-        .dbg_req_read               ( dbg_req_read          ),
-        .dbg_req_addr               ( dbg_req_offset        ),
-        .dbg_req_mask               ( dbg_req_mask          ),
-        .dbg_req_data               ( dbg_req_data          ),
-
-        .dbg_rsp_vld                ( dbg_rsp_vld           ),
-        .dbg_rsp_rdy                ( dbg_rsp_rdy           ),
-        .dbg_rsp_excp               ( dbg_rsp_excp          ),
-        .dbg_rsp_data               ( dbg_rsp_data          )
+        .dbg_req_vld                ( dbg_sub_req_vld       ),
+        .dbg_req_rdy                ( dbg_sub_req_rdy       ),
+        .dbg_req_read               ( dbg_sub_req_read      ),
+        .dbg_req_addr               ( dbg_sub_req_addr      ),
+        .dbg_req_mask               ( dbg_sub_req_mask      ),
+        .dbg_req_data               ( dbg_sub_req_data      ),
+
+        .dbg_rsp_vld                ( dbg_sub_rsp_vld       ),
+        .dbg_rsp_rdy                ( dbg_sub_rsp_rdy       ),
+        .dbg_rsp_excp               ( dbg_sub_rsp_excp      ),
+        .dbg_rsp_data               ( dbg_sub_rsp_data      )
+    );
+
+    // CRC.
+    uv_crc
+    #(
+        .ALEN                       ( CRC_SUB_LSB           ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  )
+    )
+    u_crc
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .crc_req_vld                ( crc_req_vld           ),
+        .crc_req_rdy                ( crc_req_rdy           ),
+        .crc_req_read               ( crc_req_read          ),
+        .crc_req_addr               ( crc_req_offset        ),
+        .crc_req_mask               ( crc_req_mask          ),
+        .crc_req_data               ( crc_req_data          ),
+
+        .crc_rsp_vld                ( crc_rsp_vld           ),
+        .crc_rsp_rdy                ( crc_rsp_rdy           ),
+        .crc_rsp_excp               ( crc_rsp_excp          ),
+        .crc_rsp_data               ( crc_rsp_data          ),
+
+        .crc_dma_req                ( crc_dma_req           ),
+        .crc_dma_ack                ( perip_dma_ack[8]      )
+    );
+
+    // Event Router.
+    uv_evt
+    #(
+        .ALEN                       ( EVT_SUB_LSB           ),
+        .DLEN                       ( DLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .CH_NUM                     ( EVT_CH                ),
+        .IO_NUM                     ( IO_NUM                )
+    )
+    u_evt
+    (
+        .clk                        ( clk                   ),
+        .rst_n                      ( rst_n                 ),
+
+        .evt_req_vld                ( evt_req_vld           ),
+        .evt_req_rdy                ( evt_req_rdy           ),
+        .evt_req_read               ( evt_req_read          ),
+        .evt_req_addr               ( evt_req_offset        ),
+        .evt_req_mask               ( evt_req_mask          ),
+        .evt_req_data               ( evt_req_data          ),
+
+        .evt_rsp_vld                ( evt_rsp_vld           ),
+        .evt_rsp_rdy                ( evt_rsp_rdy           ),
+        .evt_rsp_excp               ( evt_rsp_excp          ),
+        .evt_rsp_data               ( evt_rsp_data          ),
+
+        // Events.
+        .tmr_lvl                    ( tmr_evt_lvl           ),
+        .pwm_pls                    ( pwm_evt               ),
+        .uart_lvl                   ( uart_irq              ),
+        .spi0_pls                   ( spi0_done_evt         ),
+        .spi1_pls                   ( spi1_done_evt         ),
+        .i2c_lvl                    ( i2c_irq               ),
+        .gpio_in                    ( gpio_in               ),
+
+        // Tasks.
+        .tmr_start                  ( tmr_task_start        ),
+        .tmr_stop                   ( tmr_task_stop         ),
+        .pwm_start                  ( pwm_task_start        ),
+        .pwm_stop                   ( pwm_task_stop         ),
+        .spi0_start                 ( spi0_task_start       ),
+        .spi1_start                 ( spi1_task_start       ),
+        .gpio_set                   ( gpio_task_set         ),
+        .gpio_clr                   ( gpio_task_clr         ),
+        .gpio_tgl                   ( gpio_task_tgl         ),
+
+        .dma_req                    ( evt_dma_req           ),
+        .dma_ack                    ( perip_dma_ack[7:6]    )
     );
 
     // IO Mux.
     uv_iomux
     #(
-        .IO_NUM                     ( IO_NUM                )
+        .IO_NUM                     ( IO_NUM                ),
+        .PWM_IO_NUM                 ( PWM_CH * 2            ),
+        .CAP_IO_NUM                 ( CAP_CH                )
     )
     u_iomux
     (
@@ -638,6 +915,11 @@ module uv_perip_subsys
         .spi1_mosi                  ( spi1_mosi             ),
         .spi1_miso                  ( spi1_miso             ),
 
+        .pwm_oe                     ( pwm_oe                ),
+        .pwm_out                    ( pwm_out               ),
+        .cap_ie                     ( cap_ie                ),
+        .cap_in                     ( cap_in                ),
+
         .src_gpio_pu                ( dev_gpio_pu           ),
         .src_gpio_pd                ( dev_gpio_pd           ),
         .src_gpio_ie                ( dev_gpio_ie           ),
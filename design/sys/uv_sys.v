@@ -22,7 +22,18 @@ module uv_sys
     input                           por_rst_n,
 
 `ifdef USE_EXT_MEM
-    // TODO.
+    output                          sdram_clk,
+    output                          sdram_cke,
+    output                          sdram_cs_n,
+    output                          sdram_ras_n,
+    output                          sdram_cas_n,
+    output                          sdram_we_n,
+    output [1:0]                    sdram_ba,
+    output [12:0]                   sdram_addr,
+    output [1:0]                    sdram_dqm,
+    output                          sdram_dq_oen,
+    output [15:0]                   sdram_dq_out,
+    input  [15:0]                   sdram_dq_in,
 `endif
 
     input                           jtag_tck,
@@ -36,6 +47,12 @@ module uv_sys
     input                           i2c_sda_in,
     output                          i2c_sda_out,
     output                          i2c_sda_oen,
+
+    output                          qspi_sck,
+    output [3:0]                    qspi_cs,
+    output [3:0]                    qspi_oen,
+    output [3:0]                    qspi_sdo,
+    input  [3:0]                    qspi_sdi,
     
     output [IO_NUM-1:0]             gpio_pu,
     output [IO_NUM-1:0]             gpio_pd,
@@ -60,20 +77,63 @@ module uv_sys
     localparam MEM_BASE_ADDR        = 1'h1;
     localparam DEV_BASE_LSB         = 31;
     localparam DEV_BASE_ADDR        = 1'h0;
+    localparam LCL_BASE_LSB         = 16;
+    localparam LCL_BASE_ADDR        = 16'h0200;
     localparam USE_INST_DAM         = 1'b1;
     localparam USE_DATA_DAM         = 1'b1;
-    localparam INST_MEM_DW          = USE_INST_DAM ? ILEN : 128;
+    localparam INST_MEM_DW          = USE_INST_DAM ? 64 : 128;  // Two instructions per DAM fetching.
     localparam INST_MEM_MW          = INST_MEM_DW / 8;
     localparam DATA_MEM_DW          = USE_DATA_DAM ? XLEN : 128;
     localparam DATA_MEM_MW          = DATA_MEM_DW / 8;
 
-    localparam DAM_SRAM_DW          = XLEN;             // XLEN must be larger than ILEN!
+    localparam DAM_SRAM_DW          = 64;               // Must be no less than INST_MEM_DW & DATA_MEM_DW!
     localparam DAM_SRAM_MW          = DAM_SRAM_DW / 8;
-    localparam DAM_SRAM_AW          = 15;
-    localparam DAM_SRAM_DP          = 2**DAM_SRAM_AW;   // 32768 * 4B = 128KB
+    localparam DAM_SRAM_AW          = 14;
+    localparam DAM_SRAM_DP          = 2**DAM_SRAM_AW;   // 16384 * 8B = 128KB
     localparam DAM_PORT_DW          = DAM_SRAM_DW;
     localparam DAM_PORT_MW          = DAM_SRAM_MW;
     localparam DAM_PORT_AW          = DAM_SRAM_AW + $clog2(DAM_SRAM_DW / 8);
+`ifdef DAM_BANK_MSB
+    localparam DAM_BANK_NUM         = 2;
+    localparam DAM_BANK_ILV         = 1'b0;             // Split banks on address MSB.
+`elsif DAM_BANK_QUAD
+    localparam DAM_BANK_NUM         = 4;
+    localparam DAM_BANK_ILV         = 1'b1;
+`else
+    localparam DAM_BANK_NUM         = 2;
+    localparam DAM_BANK_ILV         = 1'b1;             // Interleave banks on word address.
+`endif
+
+`ifdef USE_EXT_MEM
+    localparam DAM_BASE_LSB         = 28;
+    localparam DAM_BASE_ADDR        = 4'h8;
+    localparam EXT_MEM_BASE_LSB     = 28;
+    localparam EXT_MEM_BASE_ADDR    = 4'h9;
+    localparam EXT_MEM_LINE_DW      = 128;
+    localparam SDRAM_DQ_DW          = 16;
+    localparam SDRAM_BA_AW          = 2;
+    localparam SDRAM_ROW_AW         = 13;
+    localparam SDRAM_COL_AW         = 9;                // 8192 rows * 4 banks * 512 * 2B = 32MB
+`endif
+
+    localparam DMA_REG_AW           = 16;
+    localparam DMA_CH_NUM           = 4;
+    localparam DMA_HS_NUM           = 16;
+    localparam DMA_BUF_AW           = 4;                // Up to 16 elements per burst.
+
+`ifdef DEV_DW_128
+    localparam DEV_DW               = 128;
+`elsif DEV_DW_64
+    localparam DEV_DW               = 64;
+`else
+    localparam DEV_DW               = XLEN;             // Width of devbus & dev SRAM.
+`endif
+
+`ifdef CLST_HART_NUM
+    localparam HART_NUM             = `CLST_HART_NUM;   // Harts of cluster, which replaces core & DAM.
+`else
+    localparam HART_NUM             = 1;
+`endif
 
     //-------------------------------------------------------
     // Signals.
@@ -106,6 +166,7 @@ module uv_sys
     wire                            mem_d_req_rdy;
     wire                            mem_d_req_read;
     wire [ALEN-1:0]                 mem_d_req_addr;
+    wire [3:0]                      mem_d_req_amo;
     wire [DATA_MEM_MW-1:0]          mem_d_req_mask;
     wire [DATA_MEM_DW-1:0]          mem_d_req_data;
 
@@ -129,6 +190,7 @@ module uv_sys
     wire                            dev_d_req_rdy;
     wire                            dev_d_req_read;
     wire [ALEN-1:0]                 dev_d_req_addr;
+    wire [3:0]                      dev_d_req_amo;
     wire [MLEN-1:0]                 dev_d_req_mask;
     wire [XLEN-1:0]                 dev_d_req_data;
 
@@ -137,7 +199,20 @@ module uv_sys
     wire [1:0]                      dev_d_rsp_excp;
     wire [XLEN-1:0]                 dev_d_rsp_data;
 
-    wire                            tmr_irq_clr;
+    // Core-local access.
+    wire                            lcl_req_vld;
+    wire                            lcl_req_rdy;
+    wire                            lcl_req_read;
+    wire [ALEN-1:0]                 lcl_req_addr;
+    wire [MLEN-1:0]                 lcl_req_mask;
+    wire [XLEN-1:0]                 lcl_req_data;
+
+    wire                            lcl_rsp_vld;
+    wire                            lcl_rsp_rdy;
+    wire [1:0]                      lcl_rsp_excp;
+    wire [XLEN-1:0]                 lcl_rsp_data;
+
+    wire [HART_NUM-1:0]             tmr_irq_clr;
     wire                            core_lp_mode;
 
     wire                            slc_rst_n;
@@ -145,8 +220,8 @@ module uv_sys
 
     wire                            nmi = 1'b0;
     wire                            ext_irq;
-    wire                            sft_irq;
-    wire                            tmr_irq;
+    wire [HART_NUM-1:0]             sft_irq;
+    wire [HART_NUM-1:0]             tmr_irq;
     wire [63:0]                     tmr_val;
 
     // DAM ports.
@@ -166,6 +241,7 @@ module uv_sys
     wire                            dam_d_req_rdy;
     wire                            dam_d_req_read;
     wire [DAM_PORT_AW-1:0]          dam_d_req_addr;
+    wire [3:0]                      dam_d_req_amo;
     wire [DAM_PORT_MW-1:0]          dam_d_req_mask;
     wire [DAM_PORT_DW-1:0]          dam_d_req_data;
 
@@ -174,12 +250,103 @@ module uv_sys
     wire [1:0]                      dam_d_rsp_excp;
     wire [DAM_PORT_DW-1:0]          dam_d_rsp_data;
 
+    wire [ALEN-1:0]                 dam_i_bus_req_addr;
+
+    wire [ALEN-1:0]                 dam_d_bus_req_addr;
+    wire [MLEN-1:0]                 dam_d_bus_req_mask;
+    wire [XLEN-1:0]                 dam_d_bus_req_data;
+    wire [XLEN-1:0]                 dam_d_bus_rsp_data;
+
+    // Memory region of data port shared by core & DMA.
+    wire                            mem_rgn_d_req_vld;
+    wire                            mem_rgn_d_req_rdy;
+    wire                            mem_rgn_d_req_read;
+    wire [ALEN-1:0]                 mem_rgn_d_req_addr;
+    wire [3:0]                      mem_rgn_d_req_amo;
+    wire [MLEN-1:0]                 mem_rgn_d_req_mask;
+    wire [XLEN-1:0]                 mem_rgn_d_req_data;
+
+    wire                            mem_rgn_d_rsp_vld;
+    wire                            mem_rgn_d_rsp_rdy;
+    wire [1:0]                      mem_rgn_d_rsp_excp;
+    wire [XLEN-1:0]                 mem_rgn_d_rsp_data;
+
+`ifdef USE_EXT_MEM
+    // External memory ports.
+    wire                            ext_i_req_vld;
+    wire                            ext_i_req_rdy;
+    wire [ALEN-1:0]                 ext_i_req_addr;
+
+    wire                            ext_i_rsp_vld;
+    wire                            ext_i_rsp_rdy;
+    wire [1:0]                      ext_i_rsp_excp;
+    wire [INST_MEM_DW-1:0]          ext_i_rsp_data;
+
+    wire                            ext_d_req_vld;
+    wire                            ext_d_req_rdy;
+    wire                            ext_d_req_read;
+    wire [ALEN-1:0]                 ext_d_req_addr;
+    wire [MLEN-1:0]                 ext_d_req_mask;
+    wire [XLEN-1:0]                 ext_d_req_data;
+
+    wire                            ext_d_rsp_vld;
+    wire                            ext_d_rsp_rdy;
+    wire [1:0]                      ext_d_rsp_excp;
+    wire [XLEN-1:0]                 ext_d_rsp_data;
+`endif
+
+    // DMA ports.
+    wire                            dma_mst_req_vld;
+    wire                            dma_mst_req_rdy;
+    wire                            dma_mst_req_read;
+    wire [ALEN-1:0]                 dma_mst_req_addr;
+    wire [3:0]                      dma_mst_req_len;
+    wire                            dma_mst_req_wrap;
+    wire [MLEN-1:0]                 dma_mst_req_mask;
+    wire [XLEN-1:0]                 dma_mst_req_data;
+
+    wire                            dma_mst_rsp_vld;
+    wire                            dma_mst_rsp_rdy;
+    wire [1:0]                      dma_mst_rsp_excp;
+    wire [XLEN-1:0]                 dma_mst_rsp_data;
+
+    wire                            dma_dev_req_vld;
+    wire                            dma_dev_req_rdy;
+    wire                            dma_dev_req_read;
+    wire [ALEN-1:0]                 dma_dev_req_addr;
+    wire [3:0]                      dma_dev_req_len;
+    wire                            dma_dev_req_wrap;
+    wire [MLEN-1:0]                 dma_dev_req_mask;
+    wire [XLEN-1:0]                 dma_dev_req_data;
+
+    wire                            dma_dev_rsp_vld;
+    wire                            dma_dev_rsp_rdy;
+    wire [1:0]                      dma_dev_rsp_excp;
+    wire [XLEN-1:0]                 dma_dev_rsp_data;
+
+    wire                            dma_slv_req_vld;
+    wire                            dma_slv_req_rdy;
+    wire                            dma_slv_req_read;
+    wire [ALEN-1:0]                 dma_slv_req_addr;
+    wire [MLEN-1:0]                 dma_slv_req_mask;
+    wire [XLEN-1:0]                 dma_slv_req_data;
+
+    wire                            dma_slv_rsp_vld;
+    wire                            dma_slv_rsp_rdy;
+    wire [1:0]                      dma_slv_rsp_excp;
+    wire [XLEN-1:0]                 dma_slv_rsp_data;
+
+    wire [DMA_HS_NUM-1:0]           dma_hs_req;
+    wire [DMA_HS_NUM-1:0]           dma_hs_ack;
+    wire                            dma_busy;
+    wire                            dma_irq;
+
     //-------------------------------------------------------
     // Clock & reset.
     uv_clk_gate u_sys_clk_gate
     (
         .clk_in                     ( sys_clk               ),
-        .clk_en                     ( ~core_lp_mode         ),
+        .clk_en                     ( ~core_lp_mode | dma_busy ),
         .clk_out                    ( gate_clk              )
     );
 
@@ -202,6 +369,115 @@ module uv_sys
     assign core_rst_n   = sync_rst_n;
     assign dev_rst_n    = sync_rst_n;
 
+    //-------------------------------------------------------
+    // Cluster.
+`ifdef CLST_HART_NUM
+    uv_clst
+    #(
+        .ARCH_ID                    ( ARCH_ID               ),
+        .IMPL_ID                    ( IMPL_ID               ),
+        .VENDOR_ID                  ( VENDOR_ID             ),
+        .HART_NUM                   ( HART_NUM              ),
+        .ALEN                       ( ALEN                  ),
+        .ILEN                       ( ILEN                  ),
+        .XLEN                       ( XLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .MEM_BASE_LSB               ( MEM_BASE_LSB          ),
+        .MEM_BASE_ADDR              ( MEM_BASE_ADDR         ),
+        .DEV_BASE_LSB               ( DEV_BASE_LSB          ),
+        .DEV_BASE_ADDR              ( DEV_BASE_ADDR         ),
+        .LCL_BASE_LSB               ( LCL_BASE_LSB          ),
+        .LCL_BASE_ADDR              ( LCL_BASE_ADDR         ),
+        .INST_MEM_DW                ( INST_MEM_DW           ),
+        .INST_MEM_MW                ( INST_MEM_MW           )
+    )
+    u_clst
+    (
+        .clk                        ( core_clk              ),
+        .rst_n                      ( core_rst_n            ),
+
+        // Reset vector from system.
+        .rst_vec                    ( rst_vec               ),
+
+        // Inst device access.
+        .dev_i_req_vld              ( dev_i_req_vld         ),
+        .dev_i_req_rdy              ( dev_i_req_rdy         ),
+        .dev_i_req_addr             ( dev_i_req_addr        ),
+
+        .dev_i_rsp_vld              ( dev_i_rsp_vld         ),
+        .dev_i_rsp_rdy              ( dev_i_rsp_rdy         ),
+        .dev_i_rsp_excp             ( dev_i_rsp_excp        ),
+        .dev_i_rsp_data             ( dev_i_rsp_data        ),
+
+        // Data device access.
+        .dev_d_req_vld              ( dev_d_req_vld         ),
+        .dev_d_req_rdy              ( dev_d_req_rdy         ),
+        .dev_d_req_read             ( dev_d_req_read        ),
+        .dev_d_req_addr             ( dev_d_req_addr        ),
+        .dev_d_req_amo              ( dev_d_req_amo         ),
+        .dev_d_req_mask             ( dev_d_req_mask        ),
+        .dev_d_req_data             ( dev_d_req_data        ),
+
+        .dev_d_rsp_vld              ( dev_d_rsp_vld         ),
+        .dev_d_rsp_rdy              ( dev_d_rsp_rdy         ),
+        .dev_d_rsp_excp             ( dev_d_rsp_excp        ),
+        .dev_d_rsp_data             ( dev_d_rsp_data        ),
+
+        // Core-local access.
+        .lcl_req_vld                ( lcl_req_vld           ),
+        .lcl_req_rdy                ( lcl_req_rdy           ),
+        .lcl_req_read               ( lcl_req_read          ),
+        .lcl_req_addr               ( lcl_req_addr          ),
+        .lcl_req_mask               ( lcl_req_mask          ),
+        .lcl_req_data               ( lcl_req_data          ),
+
+        .lcl_rsp_vld                ( lcl_rsp_vld           ),
+        .lcl_rsp_rdy                ( lcl_rsp_rdy           ),
+        .lcl_rsp_excp               ( lcl_rsp_excp          ),
+        .lcl_rsp_data               ( lcl_rsp_data          ),
+
+        // Control & status to SOC.
+        .tmr_irq_clr                ( tmr_irq_clr           ),
+        .core_lp_mode               ( core_lp_mode          ),
+
+        // Control & status from SOC.
+        .irq_from_nmi               ( nmi                   ),
+        .irq_from_ext               ( ext_irq               ),
+        .irq_from_sft               ( sft_irq               ),
+        .irq_from_tmr               ( tmr_irq               ),
+        .cnt_from_tmr               ( tmr_val               )
+    );
+
+    // Shared memory is private to the cluster, so DMA only reaches devices.
+    assign dma_dev_req_vld  = dma_mst_req_vld;
+    assign dma_mst_req_rdy  = dma_dev_req_rdy;
+    assign dma_dev_req_read = dma_mst_req_read;
+    assign dma_dev_req_addr = dma_mst_req_addr;
+    assign dma_dev_req_len  = dma_mst_req_len;
+    assign dma_dev_req_wrap = dma_mst_req_wrap;
+    assign dma_dev_req_mask = dma_mst_req_mask;
+    assign dma_dev_req_data = dma_mst_req_data;
+
+    assign dma_mst_rsp_vld  = dma_dev_rsp_vld;
+    assign dma_dev_rsp_rdy  = dma_mst_rsp_rdy;
+    assign dma_mst_rsp_excp = dma_dev_rsp_excp;
+    assign dma_mst_rsp_data = dma_dev_rsp_data;
+
+`ifdef USE_EXT_MEM
+    assign ext_i_req_vld    = 1'b0;
+    assign ext_i_req_addr   = {ALEN{1'b0}};
+    assign ext_i_rsp_rdy    = 1'b1;
+
+    assign ext_d_req_vld    = 1'b0;
+    assign ext_d_req_read   = 1'b1;
+    assign ext_d_req_addr   = {ALEN{1'b0}};
+    assign ext_d_req_mask   = {MLEN{1'b0}};
+    assign ext_d_req_data   = {XLEN{1'b0}};
+    assign ext_d_rsp_rdy    = 1'b1;
+`endif
+
+`else // CLST_HART_NUM
+
     //-------------------------------------------------------
     // Core.
     uv_core
@@ -218,6 +494,8 @@ module uv_sys
         .MEM_BASE_ADDR              ( MEM_BASE_ADDR         ),
         .DEV_BASE_LSB               ( DEV_BASE_LSB          ),
         .DEV_BASE_ADDR              ( DEV_BASE_ADDR         ),
+        .LCL_BASE_LSB               ( LCL_BASE_LSB          ),
+        .LCL_BASE_ADDR              ( LCL_BASE_ADDR         ),
         .USE_INST_DAM               ( USE_INST_DAM          ),
         .USE_DATA_DAM               ( USE_DATA_DAM          ),
         .INST_MEM_DW                ( INST_MEM_DW           ),
@@ -248,6 +526,7 @@ module uv_sys
         .mem_d_req_rdy              ( mem_d_req_rdy         ),
         .mem_d_req_read             ( mem_d_req_read        ),
         .mem_d_req_addr             ( mem_d_req_addr        ),
+        .mem_d_req_amo              ( mem_d_req_amo         ),
         .mem_d_req_mask             ( mem_d_req_mask        ),
         .mem_d_req_data             ( mem_d_req_data        ),
 
@@ -271,6 +550,7 @@ module uv_sys
         .dev_d_req_rdy              ( dev_d_req_rdy         ),
         .dev_d_req_read             ( dev_d_req_read        ),
         .dev_d_req_addr             ( dev_d_req_addr        ),
+        .dev_d_req_amo              ( dev_d_req_amo         ),
         .dev_d_req_mask             ( dev_d_req_mask        ),
         .dev_d_req_data             ( dev_d_req_data        ),
 
@@ -279,6 +559,19 @@ module uv_sys
         .dev_d_rsp_excp             ( dev_d_rsp_excp        ),
         .dev_d_rsp_data             ( dev_d_rsp_data        ),
 
+        // Core-local access.
+        .lcl_req_vld                ( lcl_req_vld           ),
+        .lcl_req_rdy                ( lcl_req_rdy           ),
+        .lcl_req_read               ( lcl_req_read          ),
+        .lcl_req_addr               ( lcl_req_addr          ),
+        .lcl_req_mask               ( lcl_req_mask          ),
+        .lcl_req_data               ( lcl_req_data          ),
+
+        .lcl_rsp_vld                ( lcl_rsp_vld           ),
+        .lcl_rsp_rdy                ( lcl_rsp_rdy           ),
+        .lcl_rsp_excp               ( lcl_rsp_excp          ),
+        .lcl_rsp_data               ( lcl_rsp_data          ),
+
         // Control & status to SOC.
         .tmr_irq_clr                ( tmr_irq_clr           ),
         .core_lp_mode               ( core_lp_mode          ),
@@ -288,56 +581,272 @@ module uv_sys
         .irq_from_ext               ( ext_irq               ),
         .irq_from_sft               ( sft_irq               ),
         .irq_from_tmr               ( tmr_irq               ),
-        .cnt_from_tmr               ( tmr_val               )
+        .cnt_from_tmr               ( tmr_val               ),
+
+        .rsv_inv_vld                ( dma_mst_req_vld & dma_mst_req_rdy & (~dma_mst_req_read) ),
+        .rsv_inv_addr               ( dma_mst_req_addr      )
     );
 
     //-------------------------------------------------------
     // Memory subsys.
     generate
         if (USE_INST_DAM) begin: gen_inst_dam_port
+        `ifdef USE_EXT_MEM
+            // Inst fetching is split between DAM & external memory.
+            uv_bus_fab_1x2
+            #(
+                .ALEN                           ( ALEN              ),
+                .DLEN                           ( INST_MEM_DW       ),
+                .MLEN                           ( INST_MEM_MW       ),
+                .SLV0_BASE_LSB                  ( DAM_BASE_LSB      ),
+                .SLV0_BASE_ADDR                 ( DAM_BASE_ADDR     ),
+                .SLV1_BASE_LSB                  ( EXT_MEM_BASE_LSB  ),
+                .SLV1_BASE_ADDR                 ( EXT_MEM_BASE_ADDR )
+            )
+            u_mem_i_fab
+            (
+                .clk                            ( core_clk          ),
+                .rst_n                          ( core_rst_n        ),
+
+                .mst_req_vld                    ( mem_i_req_vld     ),
+                .mst_req_rdy                    ( mem_i_req_rdy     ),
+                .mst_req_read                   ( 1'b1              ),
+                .mst_req_addr                   ( mem_i_req_addr    ),
+                .mst_req_amo                    ( 4'b0              ),
+                .mst_req_mask                   ( {INST_MEM_MW{1'b1}} ),
+                .mst_req_data                   ( {INST_MEM_DW{1'b0}} ),
+                .mst_rsp_vld                    ( mem_i_rsp_vld     ),
+                .mst_rsp_rdy                    ( mem_i_rsp_rdy     ),
+                .mst_rsp_excp                   ( mem_i_rsp_excp    ),
+                .mst_rsp_data                   ( mem_i_rsp_data    ),
+
+                .slv0_req_vld                   ( dam_i_req_vld     ),
+                .slv0_req_rdy                   ( dam_i_req_rdy     ),
+                .slv0_req_read                  (                   ),
+                .slv0_req_addr                  ( dam_i_bus_req_addr ),
+                .slv0_req_amo                   (                   ),
+                .slv0_req_mask                  (                   ),
+                .slv0_req_data                  (                   ),
+                .slv0_rsp_vld                   ( dam_i_rsp_vld     ),
+                .slv0_rsp_rdy                   ( dam_i_rsp_rdy     ),
+                .slv0_rsp_excp                  ( dam_i_rsp_excp    ),
+                .slv0_rsp_data                  ( dam_i_rsp_data    ),
+
+                .slv1_req_vld                   ( ext_i_req_vld     ),
+                .slv1_req_rdy                   ( ext_i_req_rdy     ),
+                .slv1_req_read                  (                   ),
+                .slv1_req_addr                  ( ext_i_req_addr    ),
+                .slv1_req_amo                   (                   ),
+                .slv1_req_mask                  (                   ),
+                .slv1_req_data                  (                   ),
+                .slv1_rsp_vld                   ( ext_i_rsp_vld     ),
+                .slv1_rsp_rdy                   ( ext_i_rsp_rdy     ),
+                .slv1_rsp_excp                  ( ext_i_rsp_excp    ),
+                .slv1_rsp_data                  ( ext_i_rsp_data    )
+            );
+        `else
             assign dam_i_req_vld  = mem_i_req_vld;
             assign mem_i_req_rdy  = dam_i_req_rdy;
-            assign dam_i_req_read = 1'b1;
-            assign dam_i_req_addr = mem_i_req_addr[DAM_PORT_AW-1:0];
-            assign dam_i_req_mask = {DAM_PORT_MW{1'b0}};
-            assign dam_i_req_data = {DAM_PORT_MW{1'b0}};
+            assign dam_i_bus_req_addr = mem_i_req_addr;
 
             assign mem_i_rsp_vld  = dam_i_rsp_vld;
             assign dam_i_rsp_rdy  = mem_i_rsp_rdy;
             assign mem_i_rsp_excp = dam_i_rsp_excp;
             assign mem_i_rsp_data = dam_i_rsp_data;
+        `endif
+
+            assign dam_i_req_read = 1'b1;
+            assign dam_i_req_addr = dam_i_bus_req_addr[DAM_PORT_AW-1:0];
+            assign dam_i_req_mask = {DAM_PORT_MW{1'b1}};
+            assign dam_i_req_data = {DAM_PORT_DW{1'b0}};
         end
         else begin: rmv_inst_dam_port
             assign dam_i_req_vld  = 1'b0;
             assign dam_i_req_read = 1'b0;
             assign dam_i_req_addr = {DAM_PORT_AW{1'b0}};
             assign dam_i_req_mask = {DAM_PORT_MW{1'b0}};
-            assign dam_i_req_data = {DAM_PORT_MW{1'b0}};
+            assign dam_i_req_data = {DAM_PORT_DW{1'b0}};
             assign dam_i_rsp_rdy  = 1'b0;
         end
     endgenerate
 
     generate
         if (USE_DATA_DAM) begin: gen_data_dam_port
-            assign dam_d_req_vld  = mem_d_req_vld;
-            assign mem_d_req_rdy  = dam_d_req_rdy;
-            assign dam_d_req_read = mem_d_req_read;
-            assign dam_d_req_addr = mem_d_req_addr[DAM_PORT_AW-1:0];
-            assign dam_d_req_mask = mem_d_req_mask;
-            assign dam_d_req_data = mem_d_req_data;
-
-            assign mem_d_rsp_vld  = dam_d_rsp_vld;
-            assign dam_d_rsp_rdy  = mem_d_rsp_rdy;
-            assign mem_d_rsp_excp = dam_d_rsp_excp;
-            assign mem_d_rsp_data = dam_d_rsp_data;
+            // DAM data port is shared by core & DMA, and DMA accesses to devices pass through.
+            uv_bus_fab_2x2
+            #(
+                .ALEN                           ( ALEN              ),
+                .DLEN                           ( XLEN              ),
+                .MLEN                           ( MLEN              ),
+                .SLV_BURST                      ( 2'b10             ),
+                .SLV_AMO                        ( 2'b01             ),
+                .SLV0_BASE_LSB                  ( MEM_BASE_LSB      ),
+                .SLV0_BASE_ADDR                 ( MEM_BASE_ADDR     ),
+                .SLV1_BASE_LSB                  ( DEV_BASE_LSB      ),
+                .SLV1_BASE_ADDR                 ( DEV_BASE_ADDR     )
+            )
+            u_dam_d_fab
+            (
+                .clk                            ( core_clk          ),
+                .rst_n                          ( core_rst_n        ),
+
+                .mst_dev_vld                    ( 2'b11             ),
+                .slv_dev_vld                    ( 2'b11             ),
+
+                .mst0_req_vld                   ( mem_d_req_vld     ),
+                .mst0_req_rdy                   ( mem_d_req_rdy     ),
+                .mst0_req_read                  ( mem_d_req_read    ),
+                .mst0_req_addr                  ( mem_d_req_addr    ),
+                .mst0_req_len                   ( 4'b0              ),
+                .mst0_req_wrap                  ( 1'b0              ),
+                .mst0_req_amo                   ( mem_d_req_amo     ),
+                .mst0_req_mask                  ( mem_d_req_mask    ),
+                .mst0_req_data                  ( mem_d_req_data    ),
+                .mst0_rsp_vld                   ( mem_d_rsp_vld     ),
+                .mst0_rsp_rdy                   ( mem_d_rsp_rdy     ),
+                .mst0_rsp_excp                  ( mem_d_rsp_excp    ),
+                .mst0_rsp_data                  ( mem_d_rsp_data    ),
+
+                .mst1_req_vld                   ( dma_mst_req_vld   ),
+                .mst1_req_rdy                   ( dma_mst_req_rdy   ),
+                .mst1_req_read                  ( dma_mst_req_read  ),
+                .mst1_req_addr                  ( dma_mst_req_addr  ),
+                .mst1_req_len                   ( dma_mst_req_len   ),
+                .mst1_req_wrap                  ( dma_mst_req_wrap  ),
+                .mst1_req_amo                   ( 4'b0              ),
+                .mst1_req_mask                  ( dma_mst_req_mask  ),
+                .mst1_req_data                  ( dma_mst_req_data  ),
+                .mst1_rsp_vld                   ( dma_mst_rsp_vld   ),
+                .mst1_rsp_rdy                   ( dma_mst_rsp_rdy   ),
+                .mst1_rsp_excp                  ( dma_mst_rsp_excp  ),
+                .mst1_rsp_data                  ( dma_mst_rsp_data  ),
+
+                .slv0_req_vld                   ( mem_rgn_d_req_vld ),
+                .slv0_req_rdy                   ( mem_rgn_d_req_rdy ),
+                .slv0_req_read                  ( mem_rgn_d_req_read ),
+                .slv0_req_addr                  ( mem_rgn_d_req_addr ),
+                .slv0_req_len                   (                   ),
+                .slv0_req_wrap                  (                   ),
+                .slv0_req_amo                   ( mem_rgn_d_req_amo ),
+                .slv0_req_mask                  ( mem_rgn_d_req_mask ),
+                .slv0_req_data                  ( mem_rgn_d_req_data ),
+                .slv0_rsp_vld                   ( mem_rgn_d_rsp_vld ),
+                .slv0_rsp_rdy                   ( mem_rgn_d_rsp_rdy ),
+                .slv0_rsp_excp                  ( mem_rgn_d_rsp_excp ),
+                .slv0_rsp_data                  ( mem_rgn_d_rsp_data ),
+
+                .slv1_req_vld                   ( dma_dev_req_vld   ),
+                .slv1_req_rdy                   ( dma_dev_req_rdy   ),
+                .slv1_req_read                  ( dma_dev_req_read  ),
+                .slv1_req_addr                  ( dma_dev_req_addr  ),
+                .slv1_req_len                   ( dma_dev_req_len   ),
+                .slv1_req_wrap                  ( dma_dev_req_wrap  ),
+                .slv1_req_amo                   (                   ),
+                .slv1_req_mask                  ( dma_dev_req_mask  ),
+                .slv1_req_data                  ( dma_dev_req_data  ),
+                .slv1_rsp_vld                   ( dma_dev_rsp_vld   ),
+                .slv1_rsp_rdy                   ( dma_dev_rsp_rdy   ),
+                .slv1_rsp_excp                  ( dma_dev_rsp_excp  ),
+                .slv1_rsp_data                  ( dma_dev_rsp_data  )
+            );
+
+        `ifdef USE_EXT_MEM
+            // DAM & external memory share the memory region.
+            uv_bus_fab_1x2
+            #(
+                .ALEN                           ( ALEN              ),
+                .DLEN                           ( XLEN              ),
+                .MLEN                           ( MLEN              ),
+                .SLV_AMO                        ( 2'b01             ),
+                .SLV0_BASE_LSB                  ( DAM_BASE_LSB      ),
+                .SLV0_BASE_ADDR                 ( DAM_BASE_ADDR     ),
+                .SLV1_BASE_LSB                  ( EXT_MEM_BASE_LSB  ),
+                .SLV1_BASE_ADDR                 ( EXT_MEM_BASE_ADDR )
+            )
+            u_mem_d_fab
+            (
+                .clk                            ( core_clk          ),
+                .rst_n                          ( core_rst_n        ),
+
+                .mst_req_vld                    ( mem_rgn_d_req_vld ),
+                .mst_req_rdy                    ( mem_rgn_d_req_rdy ),
+                .mst_req_read                   ( mem_rgn_d_req_read ),
+                .mst_req_addr                   ( mem_rgn_d_req_addr ),
+                .mst_req_amo                    ( mem_rgn_d_req_amo ),
+                .mst_req_mask                   ( mem_rgn_d_req_mask ),
+                .mst_req_data                   ( mem_rgn_d_req_data ),
+                .mst_rsp_vld                    ( mem_rgn_d_rsp_vld ),
+                .mst_rsp_rdy                    ( mem_rgn_d_rsp_rdy ),
+                .mst_rsp_excp                   ( mem_rgn_d_rsp_excp ),
+                .mst_rsp_data                   ( mem_rgn_d_rsp_data ),
+
+                .slv0_req_vld                   ( dam_d_req_vld     ),
+                .slv0_req_rdy                   ( dam_d_req_rdy     ),
+                .slv0_req_read                  ( dam_d_req_read    ),
+                .slv0_req_addr                  ( dam_d_bus_req_addr ),
+                .slv0_req_amo                   ( dam_d_req_amo     ),
+                .slv0_req_mask                  ( dam_d_bus_req_mask ),
+                .slv0_req_data                  ( dam_d_bus_req_data ),
+                .slv0_rsp_vld                   ( dam_d_rsp_vld     ),
+                .slv0_rsp_rdy                   ( dam_d_rsp_rdy     ),
+                .slv0_rsp_excp                  ( dam_d_rsp_excp    ),
+                .slv0_rsp_data                  ( dam_d_bus_rsp_data ),
+
+                .slv1_req_vld                   ( ext_d_req_vld     ),
+                .slv1_req_rdy                   ( ext_d_req_rdy     ),
+                .slv1_req_read                  ( ext_d_req_read    ),
+                .slv1_req_addr                  ( ext_d_req_addr    ),
+                .slv1_req_amo                   (                   ),
+                .slv1_req_mask                  ( ext_d_req_mask    ),
+                .slv1_req_data                  ( ext_d_req_data    ),
+                .slv1_rsp_vld                   ( ext_d_rsp_vld     ),
+                .slv1_rsp_rdy                   ( ext_d_rsp_rdy     ),
+                .slv1_rsp_excp                  ( ext_d_rsp_excp    ),
+                .slv1_rsp_data                  ( ext_d_rsp_data    )
+            );
+        `else
+            assign dam_d_req_vld      = mem_rgn_d_req_vld;
+            assign mem_rgn_d_req_rdy  = dam_d_req_rdy;
+            assign dam_d_req_read     = mem_rgn_d_req_read;
+            assign dam_d_bus_req_addr = mem_rgn_d_req_addr;
+            assign dam_d_req_amo      = mem_rgn_d_req_amo;
+            assign dam_d_bus_req_mask = mem_rgn_d_req_mask;
+            assign dam_d_bus_req_data = mem_rgn_d_req_data;
+
+            assign mem_rgn_d_rsp_vld  = dam_d_rsp_vld;
+            assign dam_d_rsp_rdy      = mem_rgn_d_rsp_rdy;
+            assign mem_rgn_d_rsp_excp = dam_d_rsp_excp;
+            assign mem_rgn_d_rsp_data = dam_d_bus_rsp_data;
+        `endif
+
+            assign dam_d_req_addr = dam_d_bus_req_addr[DAM_PORT_AW-1:0];
+            // Data & mask are aligned to LSB and zero-extended to the DAM width.
+            assign dam_d_req_mask = dam_d_bus_req_mask;
+            assign dam_d_req_data = dam_d_bus_req_data;
+            assign dam_d_bus_rsp_data = dam_d_rsp_data[XLEN-1:0];
         end
         else begin: rmv_data_dam_port
             assign dam_d_req_vld  = 1'b0;
             assign dam_d_req_read = 1'b0;
             assign dam_d_req_addr = {DAM_PORT_AW{1'b0}};
+            assign dam_d_req_amo  = 4'b0;
             assign dam_d_req_mask = {DAM_PORT_MW{1'b0}};
-            assign dam_d_req_data = {DAM_PORT_MW{1'b0}};
+            assign dam_d_req_data = {DAM_PORT_DW{1'b0}};
             assign dam_d_rsp_rdy  = 1'b0;
+
+            assign dma_dev_req_vld  = dma_mst_req_vld;
+            assign dma_mst_req_rdy  = dma_dev_req_rdy;
+            assign dma_dev_req_read = dma_mst_req_read;
+            assign dma_dev_req_addr = dma_mst_req_addr;
+            assign dma_dev_req_len  = dma_mst_req_len;
+            assign dma_dev_req_wrap = dma_mst_req_wrap;
+            assign dma_dev_req_mask = dma_mst_req_mask;
+            assign dma_dev_req_data = dma_mst_req_data;
+
+            assign dma_mst_rsp_vld  = dma_dev_rsp_vld;
+            assign dma_dev_rsp_rdy  = dma_mst_rsp_rdy;
+            assign dma_mst_rsp_excp = dma_dev_rsp_excp;
+            assign dma_mst_rsp_data = dma_dev_rsp_data;
         end
     endgenerate
 
@@ -348,7 +857,9 @@ module uv_sys
                 .PORT_AW                        ( DAM_PORT_AW       ),
                 .PORT_DW                        ( DAM_PORT_DW       ),
                 .PORT_MW                        ( DAM_PORT_MW       ),
-                .SRAM_DP                        ( DAM_SRAM_DP       )
+                .SRAM_DP                        ( DAM_SRAM_DP       ),
+                .BANK_NUM                       ( DAM_BANK_NUM      ),
+                .BANK_ILV                       ( DAM_BANK_ILV      )
             )
             u_dam
             (
@@ -371,6 +882,7 @@ module uv_sys
                 .port_b_req_rdy                 ( dam_d_req_rdy     ),
                 .port_b_req_read                ( dam_d_req_read    ),
                 .port_b_req_addr                ( dam_d_req_addr    ),
+                .port_b_req_amo                 ( dam_d_req_amo     ),
                 .port_b_req_mask                ( dam_d_req_mask    ),
                 .port_b_req_data                ( dam_d_req_data    ),
 
@@ -385,9 +897,112 @@ module uv_sys
         end
     endgenerate
 
+`endif // CLST_HART_NUM
+
+`ifdef USE_EXT_MEM
+    // External SDRAM at 0x90000000.
+    uv_mem_subsys
+    #(
+        .ALEN                       ( ALEN                  ),
+        .INST_DW                    ( INST_MEM_DW           ),
+        .DATA_DW                    ( XLEN                  ),
+        .DATA_MW                    ( MLEN                  ),
+        .LINE_DW                    ( EXT_MEM_LINE_DW       ),
+        .SDRAM_DQ_DW                ( SDRAM_DQ_DW           ),
+        .SDRAM_BA_AW                ( SDRAM_BA_AW           ),
+        .SDRAM_ROW_AW               ( SDRAM_ROW_AW          ),
+        .SDRAM_COL_AW               ( SDRAM_COL_AW          )
+    )
+    u_mem_subsys
+    (
+        .clk                        ( core_clk              ),
+        .rst_n                      ( core_rst_n            ),
+
+        .ext_i_req_vld              ( ext_i_req_vld         ),
+        .ext_i_req_rdy              ( ext_i_req_rdy         ),
+        .ext_i_req_addr             ( ext_i_req_addr        ),
+        .ext_i_rsp_vld              ( ext_i_rsp_vld         ),
+        .ext_i_rsp_rdy              ( ext_i_rsp_rdy         ),
+        .ext_i_rsp_excp             ( ext_i_rsp_excp        ),
+        .ext_i_rsp_data             ( ext_i_rsp_data        ),
+
+        .ext_d_req_vld              ( ext_d_req_vld         ),
+        .ext_d_req_rdy              ( ext_d_req_rdy         ),
+        .ext_d_req_read             ( ext_d_req_read        ),
+        .ext_d_req_addr             ( ext_d_req_addr        ),
+        .ext_d_req_mask             ( ext_d_req_mask        ),
+        .ext_d_req_data             ( ext_d_req_data        ),
+        .ext_d_rsp_vld              ( ext_d_rsp_vld         ),
+        .ext_d_rsp_rdy              ( ext_d_rsp_rdy         ),
+        .ext_d_rsp_excp             ( ext_d_rsp_excp        ),
+        .ext_d_rsp_data             ( ext_d_rsp_data        ),
+
+        .sdram_cke                  ( sdram_cke             ),
+        .sdram_cs_n                 ( sdram_cs_n            ),
+        .sdram_ras_n                ( sdram_ras_n           ),
+        .sdram_cas_n                ( sdram_cas_n           ),
+        .sdram_we_n                 ( sdram_we_n            ),
+        .sdram_ba                   ( sdram_ba              ),
+        .sdram_addr                 ( sdram_addr            ),
+        .sdram_dqm                  ( sdram_dqm             ),
+        .sdram_dq_oen               ( sdram_dq_oen          ),
+        .sdram_dq_out               ( sdram_dq_out          ),
+        .sdram_dq_in                ( sdram_dq_in           )
+    );
+
+    assign sdram_clk    = core_clk;
+`endif
+
     //-------------------------------------------------------
     // DMA subsys.
-    // TODO.
+    uv_dma_subsys
+    #(
+        .ALEN                       ( ALEN                  ),
+        .DLEN                       ( XLEN                  ),
+        .MLEN                       ( MLEN                  ),
+        .REG_ALEN                   ( DMA_REG_AW            ),
+        .CH_NUM                     ( DMA_CH_NUM            ),
+        .HS_NUM                     ( DMA_HS_NUM            ),
+        .BUF_AW                     ( DMA_BUF_AW            )
+    )
+    u_dma_subsys
+    (
+        .clk                        ( dev_clk               ),
+        .rst_n                      ( dev_rst_n             ),
+
+        // Register access.
+        .dma_slv_req_vld            ( dma_slv_req_vld       ),
+        .dma_slv_req_rdy            ( dma_slv_req_rdy       ),
+        .dma_slv_req_read           ( dma_slv_req_read      ),
+        .dma_slv_req_addr           ( dma_slv_req_addr[DMA_REG_AW-1:0] ),
+        .dma_slv_req_mask           ( dma_slv_req_mask      ),
+        .dma_slv_req_data           ( dma_slv_req_data      ),
+        .dma_slv_rsp_vld            ( dma_slv_rsp_vld       ),
+        .dma_slv_rsp_rdy            ( dma_slv_rsp_rdy       ),
+        .dma_slv_rsp_excp           ( dma_slv_rsp_excp      ),
+        .dma_slv_rsp_data           ( dma_slv_rsp_data      ),
+
+        // Memory & device access.
+        .dma_mst_req_vld            ( dma_mst_req_vld       ),
+        .dma_mst_req_rdy            ( dma_mst_req_rdy       ),
+        .dma_mst_req_read           ( dma_mst_req_read      ),
+        .dma_mst_req_addr           ( dma_mst_req_addr      ),
+        .dma_mst_req_len            ( dma_mst_req_len       ),
+        .dma_mst_req_wrap           ( dma_mst_req_wrap      ),
+        .dma_mst_req_mask           ( dma_mst_req_mask      ),
+        .dma_mst_req_data           ( dma_mst_req_data      ),
+        .dma_mst_rsp_vld            ( dma_mst_rsp_vld       ),
+        .dma_mst_rsp_rdy            ( dma_mst_rsp_rdy       ),
+        .dma_mst_rsp_excp           ( dma_mst_rsp_excp      ),
+        .dma_mst_rsp_data           ( dma_mst_rsp_data      ),
+
+        // Peripheral handshakes.
+        .dma_hs_req                 ( dma_hs_req            ),
+        .dma_hs_ack                 ( dma_hs_ack            ),
+
+        .dma_busy                   ( dma_busy              ),
+        .dma_irq                    ( dma_irq               )
+    );
 
     //-------------------------------------------------------
     // Device subsys.
@@ -396,7 +1011,10 @@ module uv_sys
         .ALEN                       ( ALEN                  ),
         .DLEN                       ( XLEN                  ),
         .MLEN                       ( MLEN                  ),
-        .IO_NUM                     ( IO_NUM                )
+        .DEV_DW                     ( DEV_DW                ),
+        .IO_NUM                     ( IO_NUM                ),
+        .DMA_HS_NUM                 ( DMA_HS_NUM            ),
+        .HART_NUM                   ( HART_NUM              )
     )
     u_dev_subsys
     (
@@ -420,6 +1038,7 @@ module uv_sys
         .dev_d_req_rdy              ( dev_d_req_rdy         ),
         .dev_d_req_read             ( dev_d_req_read        ),
         .dev_d_req_addr             ( dev_d_req_addr        ),
+        .dev_d_req_amo              ( dev_d_req_amo         ),
         .dev_d_req_mask             ( dev_d_req_mask        ),
         .dev_d_req_data             ( dev_d_req_data        ),
         .dev_d_rsp_vld              ( dev_d_rsp_vld         ),
@@ -427,17 +1046,48 @@ module uv_sys
         .dev_d_rsp_excp             ( dev_d_rsp_excp        ),
         .dev_d_rsp_data             ( dev_d_rsp_data        ),
 
+        // Core-local access.
+        .lcl_req_vld                ( lcl_req_vld           ),
+        .lcl_req_rdy                ( lcl_req_rdy           ),
+        .lcl_req_read               ( lcl_req_read          ),
+        .lcl_req_addr               ( lcl_req_addr          ),
+        .lcl_req_mask               ( lcl_req_mask          ),
+        .lcl_req_data               ( lcl_req_data          ),
+        .lcl_rsp_vld                ( lcl_rsp_vld           ),
+        .lcl_rsp_rdy                ( lcl_rsp_rdy           ),
+        .lcl_rsp_excp               ( lcl_rsp_excp          ),
+        .lcl_rsp_data               ( lcl_rsp_data          ),
+
         // DMA device access.
-        .dma_req_vld                ( 1'b0                  ),
-        .dma_req_rdy                (                       ),
-        .dma_req_read               ( 1'b0                  ),
-        .dma_req_addr               ( {ALEN{1'b0}}          ),
-        .dma_req_mask               ( {MLEN{1'b0}}          ),
-        .dma_req_data               ( {XLEN{1'b0}}          ),
-        .dma_rsp_vld                (                       ),
-        .dma_rsp_rdy                ( 1'b0                  ),
-        .dma_rsp_excp               (                       ),
-        .dma_rsp_data               (                       ),
+        .dma_req_vld                ( dma_dev_req_vld       ),
+        .dma_req_rdy                ( dma_dev_req_rdy       ),
+        .dma_req_read               ( dma_dev_req_read      ),
+        .dma_req_addr               ( dma_dev_req_addr      ),
+        .dma_req_len                ( dma_dev_req_len       ),
+        .dma_req_wrap               ( dma_dev_req_wrap      ),
+        .dma_req_mask               ( dma_dev_req_mask      ),
+        .dma_req_data               ( dma_dev_req_data      ),
+        .dma_rsp_vld                ( dma_dev_rsp_vld       ),
+        .dma_rsp_rdy                ( dma_dev_rsp_rdy       ),
+        .dma_rsp_excp               ( dma_dev_rsp_excp      ),
+        .dma_rsp_data               ( dma_dev_rsp_data      ),
+
+        // DMA register access.
+        .dma_slv_req_vld            ( dma_slv_req_vld       ),
+        .dma_slv_req_rdy            ( dma_slv_req_rdy       ),
+        .dma_slv_req_read           ( dma_slv_req_read      ),
+        .dma_slv_req_addr           ( dma_slv_req_addr      ),
+        .dma_slv_req_mask           ( dma_slv_req_mask      ),
+        .dma_slv_req_data           ( dma_slv_req_data      ),
+        .dma_slv_rsp_vld            ( dma_slv_rsp_vld       ),
+        .dma_slv_rsp_rdy            ( dma_slv_rsp_rdy       ),
+        .dma_slv_rsp_excp           ( dma_slv_rsp_excp      ),
+        .dma_slv_rsp_data           ( dma_slv_rsp_data      ),
+
+        // DMA handshakes & interrupt.
+        .dma_hs_req                 ( dma_hs_req            ),
+        .dma_hs_ack                 ( dma_hs_ack            ),
+        .dma_irq                    ( dma_irq               ),
 
         // Debug device access.
         .dbg_req_vld                ( 1'b0                  ),
@@ -474,6 +1124,12 @@ module uv_sys
         .i2c_sda_in                 ( i2c_sda_in            ),
         .i2c_sda_out                ( i2c_sda_out           ),
         .i2c_sda_oen                ( i2c_sda_oen           ),
+
+        .qspi_sck                   ( qspi_sck              ),
+        .qspi_cs                    ( qspi_cs               ),
+        .qspi_oen                   ( qspi_oen              ),
+        .qspi_sdo                   ( qspi_sdo              ),
+        .qspi_sdi                   ( qspi_sdi              ),
         
         .gpio_pu                    ( gpio_pu               ),
         .gpio_pd                    ( gpio_pd               ),
@@ -0,0 +1,105 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define DMA_CH      0
+#define REG_LCL_SCRATCH (REG_LCL_BASE + REG_SLC_SCRATCH - REG_SLC_BASE)
+
+static volatile uint32_t word __attribute__((aligned(4)));
+static uint32_t dma_src __attribute__((aligned(4)));
+static volatile uint32_t excp_cause;
+static volatile uint32_t excp_num;
+
+// The toolchain is built for rv32im, so the A instructions are encoded by .insn.
+static inline uint32_t amo_add(volatile uint32_t *p, uint32_t v) {
+    uint32_t old;
+    asm volatile (".insn r 0x2f, 2, 0x00, %0, %1, %2" : "=r" (old) : "r" (p), "r" (v) : "memory");
+    return old;
+}
+
+static inline uint32_t amo_swap(volatile uint32_t *p, uint32_t v) {
+    uint32_t old;
+    asm volatile (".insn r 0x2f, 2, 0x04, %0, %1, %2" : "=r" (old) : "r" (p), "r" (v) : "memory");
+    return old;
+}
+
+static inline uint32_t lr_w(volatile uint32_t *p) {
+    uint32_t val;
+    asm volatile (".insn r 0x2f, 2, 0x08, %0, %1, x0" : "=r" (val) : "r" (p) : "memory");
+    return val;
+}
+
+// Returns 0 on success.
+static inline uint32_t sc_w(volatile uint32_t *p, uint32_t v) {
+    uint32_t ret;
+    asm volatile (".insn r 0x2f, 2, 0x0c, %0, %1, %2" : "=r" (ret) : "r" (p), "r" (v) : "memory");
+    return ret;
+}
+
+// Faulting AMOs are skipped after their causes are kept.
+uintptr_t handle_excp(uintptr_t mcause, uintptr_t epc) {
+    excp_cause = mcause;
+    excp_num++;
+    return epc + 4;
+}
+
+static int check(const char *name, int ok) {
+    printf("%s: %s.\n", name, ok ? "ok" : "error");
+    return !ok;
+}
+
+// AMOs & LR/SC on DAM, which does them at its data port.
+static int test_dam() {
+    int err = 0;
+
+    word = 5;
+    err += check("AMOADD on DAM", amo_add(&word, 3) == 5 && word == 8);
+    err += check("AMOSWAP on DAM", amo_swap(&word, 0x55AA) == 8 && word == 0x55AA);
+
+    uint32_t val = lr_w(&word);
+    err += check("LR/SC on DAM", val == 0x55AA && sc_w(&word, val + 1) == 0 && word == 0x55AB);
+    err += check("SC without LR", sc_w(&word, 0) == 1 && word == 0x55AB);
+
+    // A DMA write to the reserved word fails the SC.
+    dma_src = 0x1234;
+    val = lr_w(&word);
+    int ret = uv_dma_memcpy(DMA_CH, (void *) &word, &dma_src, 4);
+    err += check("SC after DMA write", ret == 0 && sc_w(&word, val + 1) == 1 && word == 0x1234);
+
+    return err;
+}
+
+// AMOs to slaves without read-modify-write trap with access faults.
+static int test_fault(const char *name, uint32_t addr) {
+    volatile uint32_t *p = (volatile uint32_t *) addr;
+    int err = 0;
+    int ok;
+
+    *p = 0xA5A5;
+    excp_num = 0;
+    amo_add(p, 1);
+    ok = excp_num == 1 && excp_cause == CAUSE_STORE_ACCESS && *p == 0xA5A5;
+    printf("AMOADD on %s: %s.\n", name, ok ? "ok" : "error");
+    err += !ok;
+
+    excp_num = 0;
+    lr_w(p);
+    ok = excp_num == 1 && excp_cause == CAUSE_LOAD_ACCESS;
+    printf("LR on %s: %s.\n", name, ok ? "ok" : "error");
+    err += !ok;
+
+    return err;
+}
+
+int main() {
+    int err = 0;
+
+    err += test_dam();
+    err += test_fault("SLC by devbus", REG_SLC_SCRATCH);
+    err += test_fault("SLC by local port", REG_LCL_SCRATCH);
+
+    printf("AMO test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
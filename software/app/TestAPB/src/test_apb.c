@@ -0,0 +1,74 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define ROUND_NUM   4
+
+static uint32_t word_buf[64];
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t bytes) {
+    uint32_t kbps = (MAIN_CLK_FREQ / 1000) * bytes / cyc;
+    uint32_t cpw  = cyc * 100 / (bytes / 4);
+    printf("%s: %d bytes in %d cycles, %d.%02d cycles/word, %d KB/s.\n",
+           name, bytes, cyc, cpw / 100, cpw % 100, kbps);
+}
+
+// Raw word stores to TXQ, ended by a read which waits for all the writes.
+static uint32_t fill_raw(uint32_t cap) {
+    volatile uint32_t *txq_dat = &SPI0->txq_dat;
+
+    SPI0->txq_clr = 1;
+    (void) SPI0->txq_len;
+    uint32_t t0 = get_cycle();
+    for (uint32_t i = 0; i < cap; ++i) {
+        *txq_dat = i;
+    }
+    (void) SPI0->txq_len;
+    uint32_t t1 = get_cycle();
+    return t1 - t0;
+}
+
+// Driver which polls the free space of TXQ.
+static uint32_t fill_drv(uint32_t cap) {
+    SPI0->txq_clr = 1;
+    (void) SPI0->txq_len;
+    uint32_t t0 = get_cycle();
+    uv_spi_send_words(SPI0_ID, word_buf, cap);
+    (void) SPI0->txq_len;
+    uint32_t t1 = get_cycle();
+    return t1 - t0;
+}
+
+int main() {
+    // The slowest SCK, so that TXQ is hardly drained while filling.
+    spi_cfg cfg;
+    cfg.cpol = 0;
+    cfg.cpha = 0;
+    cfg.endian = SPI_LITTLE_ENDIAN;
+    cfg.unit_len = SPI_UNIT_LEN_32BITS;
+    cfg.sck_dly = 4;
+    cfg.clk_div = 0xFFFF;
+    uv_spi_init(SPI0_ID, 0x1, false, &cfg);
+
+    uint32_t cap = SPI0->txq_cap;
+    cap = cap > 64 ? 64 : cap;
+    printf("Fill SPI0 TXQ of %d words.\n", cap);
+
+    uint32_t raw_cyc = 0;
+    uint32_t drv_cyc = 0;
+    for (int i = 0; i < ROUND_NUM; ++i) {
+        raw_cyc += fill_raw(cap);
+        drv_cyc += fill_drv(cap);
+    }
+    SPI0->txq_clr = 1;
+
+    report("TXQ RAW", raw_cyc, cap * 4 * ROUND_NUM);
+    report("TXQ DRV", drv_cyc, cap * 4 * ROUND_NUM);
+
+    return 0;
+}
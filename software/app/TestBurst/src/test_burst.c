@@ -0,0 +1,79 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define COPY_BYTES  16384
+#define COPY_WORDS  (COPY_BYTES / 4)
+#define DMA_CH      0
+
+static uint32_t dam_buf[COPY_WORDS];
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void fill_bufs(uint32_t *src, uint32_t *dst, uint32_t seed) {
+    for (int i = 0; i < COPY_WORDS; ++i) {
+        src[i] = seed ^ (i * 0x9E3779B9UL);
+        dst[i] = 0;
+    }
+}
+
+static uint32_t check_bufs(uint32_t *src, uint32_t *dst) {
+    uint32_t fail_cnt = 0;
+    for (int i = 0; i < COPY_WORDS; ++i) {
+        if (dst[i] != src[i]) {
+            ++fail_cnt;
+        }
+    }
+    return fail_cnt;
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t fail_cnt) {
+    uint32_t bw = COPY_BYTES * 100 / cyc;
+    printf("%s: %d cycles, %d.%02d B/cycle, %s.\n",
+           name, cyc, bw / 100, bw % 100, fail_cnt ? "FAIL" : "PASS");
+}
+
+// Copy by CPU with single word loads & stores.
+static void bench_cpu(const char *name, uint32_t *src, uint32_t *dst) {
+    volatile uint32_t *s = src;
+    volatile uint32_t *d = dst;
+
+    fill_bufs(src, dst, 0x01234567UL);
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < COPY_WORDS; ++i) {
+        d[i] = s[i];
+    }
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, check_bufs(src, dst));
+}
+
+// Copy by DMA in 2^burst words, each of which is one bus burst for burst > 0.
+static void bench_dma(const char *name, uint32_t *src, uint32_t *dst, uint32_t burst) {
+    fill_bufs(src, dst, 0x89ABCDEFUL + burst);
+    uint32_t t0 = get_cycle();
+    uv_dma_start(DMA_CH, (uint32_t) src, (uint32_t) dst,
+                 uv_dma_ctrl(COPY_WORDS, DMA_SIZE_WORD, true, true, burst));
+    int ret = uv_dma_wait(DMA_CH);
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, ret ? 1 : check_bufs(src, dst));
+}
+
+int main() {
+    uint32_t *sram_src = (uint32_t *) SRAM_START_ADDR;
+    uint32_t *sram_dst = (uint32_t *) (SRAM_START_ADDR + COPY_BYTES);
+
+    printf("Copy %d bytes over devbus.\n", COPY_BYTES);
+    bench_cpu("CPU     SRAM -> SRAM", sram_src, sram_dst);
+    bench_dma("DMA x1  SRAM -> SRAM", sram_src, sram_dst, 0);
+    bench_dma("DMA x4  SRAM -> SRAM", sram_src, sram_dst, 2);
+    bench_dma("DMA x16 SRAM -> SRAM", sram_src, sram_dst, DMA_MAX_BURST);
+    bench_dma("DMA x1  SRAM -> DAM ", sram_src, dam_buf, 0);
+    bench_dma("DMA x16 SRAM -> DAM ", sram_src, dam_buf, DMA_MAX_BURST);
+    bench_dma("DMA x1  DAM  -> SRAM", dam_buf, sram_dst, 0);
+    bench_dma("DMA x16 DAM  -> SRAM", dam_buf, sram_dst, DMA_MAX_BURST);
+
+    return 0;
+}
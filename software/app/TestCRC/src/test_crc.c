@@ -0,0 +1,137 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define BUF_BYTES   1024
+#define DMA_CH      0
+#define DMA_BURST   4                   // 16 words per burst.
+
+static uint8_t buf[BUF_BYTES] __attribute__((aligned(4)));
+static uint32_t crc32_tab[256];
+static uint16_t crc16_tab[256];
+
+static const crc_cfg crc32_cfg = CRC32_CFG;
+static const crc_cfg crc16_cfg = CRC16_CCITT_CFG;
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t crc, uint32_t exp) {
+    printf("%s: %d cycles, %d.%02d cycles/byte, CRC %08x, %s.\n", name, cyc,
+           cyc / BUF_BYTES, cyc % BUF_BYTES * 100 / BUF_BYTES, crc, crc == exp ? "ok" : "error");
+}
+
+// Tables for byte-wise software CRC, reflected for CRC32 & MSB first for CRC16.
+static void init_tabs() {
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? (c >> 1) ^ 0xEDB88320UL : c >> 1;
+        }
+        crc32_tab[i] = c;
+
+        uint16_t h = i << 8;
+        for (int k = 0; k < 8; ++k) {
+            h = (h & 0x8000) ? (h << 1) ^ 0x1021 : h << 1;
+        }
+        crc16_tab[i] = h;
+    }
+}
+
+static uint32_t sw_crc32(const uint8_t *p, size_t len) {
+    uint32_t c = 0xFFFFFFFFUL;
+
+    while (len--) {
+        c = crc32_tab[(c ^ *p++) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFUL;
+}
+
+static uint16_t sw_crc16(const uint8_t *p, size_t len) {
+    uint16_t c = 0xFFFF;
+
+    while (len--) {
+        c = crc16_tab[((c >> 8) ^ *p++) & 0xFF] ^ (c << 8);
+    }
+    return c;
+}
+
+static uint32_t hw_crc(const crc_cfg *cfg, const uint8_t *p, size_t len) {
+    uv_crc_init(cfg);
+    uv_crc_update(p, len);
+    return uv_crc_result();
+}
+
+// Words moved by a DMA channel paced by the CRC handshake.
+static uint32_t dma_crc(const crc_cfg *cfg, const uint8_t *p, size_t len) {
+    uv_crc_init(cfg);
+    uv_crc_set_dma(true);
+    uv_dma_set_handshake(DMA_CH, true, CRC_DMA_HS);
+    uv_dma_start(DMA_CH, (uint32_t) p, REG_CRC_DAT,
+                 uv_dma_ctrl(len / 4, DMA_SIZE_WORD, true, false, DMA_BURST));
+    int ret = uv_dma_wait(DMA_CH);
+    uv_dma_set_handshake(DMA_CH, false, 0);
+    uv_crc_set_dma(false);
+    return ret ? 0 : uv_crc_result();
+}
+
+// Check values over "123456789" of both presets & of an unaligned, byte-wise tail.
+static int check_vectors() {
+    static const uint8_t chk[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    crc_cfg crc8_cfg = {8, 0x07, 0x00, 0x00, false, false};
+    int err = 0;
+
+    err += hw_crc(&crc32_cfg, chk, 9) != 0xCBF43926UL;
+    err += hw_crc(&crc16_cfg, chk, 9) != 0x29B1;
+    err += hw_crc(&crc8_cfg, chk, 9) != 0xF4;
+    err += hw_crc(&crc32_cfg, buf + 1, 13) != sw_crc32(buf + 1, 13);
+
+    printf("Check values: %d errors.\n", err);
+    return err;
+}
+
+int main() {
+    int err = 0;
+
+    for (int i = 0; i < BUF_BYTES; ++i) {
+        buf[i] = (i * 7 + 3) ^ (i >> 3);
+    }
+    init_tabs();
+    err += check_vectors();
+
+    printf("CRC of %d bytes.\n", BUF_BYTES);
+
+    uint32_t t0 = get_cycle();
+    uint32_t exp32 = sw_crc32(buf, BUF_BYTES);
+    uint32_t t1 = get_cycle();
+    report("CRC32 software table", t1 - t0, exp32, exp32);
+
+    t0 = get_cycle();
+    uint32_t crc = hw_crc(&crc32_cfg, buf, BUF_BYTES);
+    t1 = get_cycle();
+    report("CRC32 CPU to CRC    ", t1 - t0, crc, exp32);
+    err += crc != exp32;
+
+    t0 = get_cycle();
+    crc = dma_crc(&crc32_cfg, buf, BUF_BYTES);
+    t1 = get_cycle();
+    report("CRC32 DMA to CRC    ", t1 - t0, crc, exp32);
+    err += crc != exp32;
+
+    t0 = get_cycle();
+    uint32_t exp16 = sw_crc16(buf, BUF_BYTES);
+    t1 = get_cycle();
+    report("CRC16 software table", t1 - t0, exp16, exp16);
+
+    t0 = get_cycle();
+    crc = hw_crc(&crc16_cfg, buf, BUF_BYTES);
+    t1 = get_cycle();
+    report("CRC16 CPU to CRC    ", t1 - t0, crc, exp16);
+    err += crc != exp16;
+
+    printf("CRC test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define COPY_BYTES  4096
+#define COPY_WORDS  (COPY_BYTES / 4)
+#define SG_NUM      4
+#define SG_WORDS    (COPY_WORDS / SG_NUM)
+#define DMA_CH      0
+
+static uint32_t src_buf[COPY_WORDS];
+static uint32_t dst_buf[COPY_WORDS];
+static dma_desc sg_desc[SG_NUM];
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void fill_bufs(uint32_t *src, uint32_t *dst, uint32_t seed) {
+    for (int i = 0; i < COPY_WORDS; ++i) {
+        src[i] = seed + i * 0x01010101UL;
+        dst[i] = 0;
+    }
+}
+
+static uint32_t check_bufs(uint32_t *src, uint32_t *dst) {
+    uint32_t fail_cnt = 0;
+    for (int i = 0; i < COPY_WORDS; ++i) {
+        if (dst[i] != src[i]) {
+            ++fail_cnt;
+        }
+    }
+    return fail_cnt;
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t free_cyc, uint32_t fail_cnt) {
+    uint32_t bw = COPY_BYTES * 100 / cyc;
+    printf("%s: %d cycles, %d.%02d B/cycle, %d CPU-free cycles, %s.\n",
+           name, cyc, bw / 100, bw % 100, free_cyc, fail_cnt ? "FAIL" : "PASS");
+}
+
+// Copy by CPU with word loads & stores.
+static void bench_cpu(const char *name, uint32_t *src, uint32_t *dst) {
+    volatile uint32_t *s = src;
+    volatile uint32_t *d = dst;
+
+    fill_bufs(src, dst, 0x11223344UL);
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < COPY_WORDS; ++i) {
+        d[i] = s[i];
+    }
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, 0, check_bufs(src, dst));
+}
+
+// Copy by DMA, while CPU only polls the busy status.
+static void bench_dma(const char *name, uint32_t *src, uint32_t *dst) {
+    fill_bufs(src, dst, 0x55667788UL);
+    uint32_t t0 = get_cycle();
+    uv_dma_start(DMA_CH, (uint32_t) src, (uint32_t) dst,
+                 uv_dma_ctrl(COPY_WORDS, DMA_SIZE_WORD, true, true, DMA_MAX_BURST));
+    uint32_t t1 = get_cycle();
+    while (uv_dma_busy(DMA_CH)) {
+        ;
+    }
+    uint32_t t2 = get_cycle();
+    int ret = uv_dma_wait(DMA_CH);
+    report(name, t2 - t0, t2 - t1, ret ? 1 : check_bufs(src, dst));
+}
+
+// Gather strided blocks to a continuous buffer by chained descriptors.
+static void bench_sg(const char *name, uint32_t *src, uint32_t *dst) {
+    fill_bufs(src, dst, 0x99AABBCCUL);
+    for (int i = 0; i < SG_NUM; ++i) {
+        uint32_t blk = SG_NUM - 1 - i;
+        uv_dma_set_desc(&sg_desc[i], (uint32_t) (src + blk * SG_WORDS), (uint32_t) (dst + i * SG_WORDS),
+                        uv_dma_ctrl(SG_WORDS, DMA_SIZE_WORD, true, true, DMA_MAX_BURST),
+                        i == SG_NUM - 1 ? 0 : &sg_desc[i + 1]);
+    }
+
+    uint32_t t0 = get_cycle();
+    uv_dma_start_chain(DMA_CH, sg_desc);
+    uint32_t t1 = get_cycle();
+    while (uv_dma_busy(DMA_CH)) {
+        ;
+    }
+    uint32_t t2 = get_cycle();
+
+    uint32_t fail_cnt = uv_dma_wait(DMA_CH) ? 1 : 0;
+    for (int i = 0; i < SG_NUM; ++i) {
+        uint32_t blk = SG_NUM - 1 - i;
+        for (int j = 0; j < SG_WORDS; ++j) {
+            if (dst[i * SG_WORDS + j] != src[blk * SG_WORDS + j]) {
+                ++fail_cnt;
+            }
+        }
+    }
+    report(name, t2 - t0, t2 - t1, fail_cnt);
+}
+
+int main() {
+    uint32_t *sram_buf = (uint32_t *) SRAM_START_ADDR;
+
+    printf("Copy %d bytes by CPU & DMA.\n", COPY_BYTES);
+    bench_cpu("CPU DAM  -> DAM ", src_buf, dst_buf);
+    bench_dma("DMA DAM  -> DAM ", src_buf, dst_buf);
+    bench_cpu("CPU DAM  -> SRAM", src_buf, sram_buf);
+    bench_dma("DMA DAM  -> SRAM", src_buf, sram_buf);
+    bench_cpu("CPU SRAM -> DAM ", sram_buf, dst_buf);
+    bench_dma("DMA SRAM -> DAM ", sram_buf, dst_buf);
+    bench_sg ("SG  DAM  -> DAM ", src_buf, dst_buf);
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+// See LICENSE for license details.
+
+#ifndef _DSP_REF_H_
+#define _DSP_REF_H_
+
+#include <stddef.h>
+#include "uv_sys.h"
+
+// Bit-exact software model of the DSP accelerator, used as both
+// the reference of results & the software baseline of throughput.
+typedef struct {
+    uint32_t mode;
+    uint32_t len;                       // Taps or sections.
+    uint32_t shift;
+    int16_t  coef[DSP_TAP_NUM];         // FIR taps or {b0, b1, b2, -a1, -a2}.
+    int16_t  dl[DSP_TAP_NUM];           // FIR x[n-k] or biquad {x1, x2, y1, y2}.
+} dsp_ref;
+
+void dsp_ref_fir(dsp_ref *ref, const int16_t *coef, uint32_t taps, uint32_t shift);
+void dsp_ref_biquad(dsp_ref *ref, const dsp_biq *sec, uint32_t num, uint32_t shift);
+void dsp_ref_run(dsp_ref *ref, const int16_t *in, int16_t *out, size_t len);
+
+#endif
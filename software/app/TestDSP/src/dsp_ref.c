@@ -0,0 +1,71 @@
+// See LICENSE for license details.
+
+#include <string.h>
+#include "dsp_ref.h"
+
+// Round half up, shift & saturate, as the accelerator does on 40-bit sums.
+static int16_t dsp_ref_res(int64_t acc, uint32_t shift) {
+    int64_t r = (acc + ((1LL << shift) >> 1)) >> shift;
+
+    return r > 32767 ? 32767 : r < -32768 ? -32768 : (int16_t) r;
+}
+
+void dsp_ref_fir(dsp_ref *ref, const int16_t *coef, uint32_t taps, uint32_t shift) {
+    memset(ref, 0, sizeof(*ref));
+    ref->mode  = DSP_MODE_FIR;
+    ref->len   = taps;
+    ref->shift = shift;
+    memcpy(ref->coef, coef, taps * sizeof(int16_t));
+}
+
+// Feedback coefficients are negated to 16 bits, as written to the coefficient RAM.
+void dsp_ref_biquad(dsp_ref *ref, const dsp_biq *sec, uint32_t num, uint32_t shift) {
+    memset(ref, 0, sizeof(*ref));
+    ref->mode  = DSP_MODE_BIQ;
+    ref->len   = num;
+    ref->shift = shift;
+    for (uint32_t i = 0; i < num; ++i) {
+        ref->coef[i * 5]     = sec[i].b0;
+        ref->coef[i * 5 + 1] = sec[i].b1;
+        ref->coef[i * 5 + 2] = sec[i].b2;
+        ref->coef[i * 5 + 3] = (int16_t) -sec[i].a1;
+        ref->coef[i * 5 + 4] = (int16_t) -sec[i].a2;
+    }
+}
+
+static int16_t dsp_ref_fir_step(dsp_ref *ref, int16_t x) {
+    int64_t acc = 0;
+
+    for (uint32_t k = ref->len - 1; k > 0; --k) {
+        ref->dl[k] = ref->dl[k - 1];
+    }
+    ref->dl[0] = x;
+    for (uint32_t k = 0; k < ref->len; ++k) {
+        acc += (int32_t) ref->coef[k] * ref->dl[k];
+    }
+    return dsp_ref_res(acc, ref->shift);
+}
+
+static int16_t dsp_ref_biq_step(dsp_ref *ref, int16_t x) {
+    for (uint32_t s = 0; s < ref->len; ++s) {
+        const int16_t *c = &ref->coef[s * 5];
+        int16_t *d = &ref->dl[s * 4];
+        int64_t acc = (int32_t) c[0] * x + (int32_t) c[1] * d[0] + (int32_t) c[2] * d[1]
+                    + (int32_t) c[3] * d[2] + (int32_t) c[4] * d[3];
+        int16_t y = dsp_ref_res(acc, ref->shift);
+
+        d[1] = d[0];
+        d[0] = x;
+        d[3] = d[2];
+        d[2] = y;
+        x = y;
+    }
+    return x;
+}
+
+void dsp_ref_run(dsp_ref *ref, const int16_t *in, int16_t *out, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        out[i] = ref->mode == DSP_MODE_FIR ? dsp_ref_fir_step(ref, in[i])
+                                           : dsp_ref_biq_step(ref, in[i]);
+    }
+}
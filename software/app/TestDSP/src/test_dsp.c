@@ -0,0 +1,119 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include <string.h>
+#include "uv_sys.h"
+#include "dsp_ref.h"
+
+#define SMP_NUM     1024
+#define FIR_TAPS    32
+#define FIR_SHIFT   15
+#define BIQ_NUM     4
+#define BIQ_SHIFT   14
+#define DMA_IN_CH   0
+#define DMA_OUT_CH  1
+#define DMA_BURST   3                   // 8 samples per burst.
+#define DMA_TH      8
+
+static int16_t smp[SMP_NUM];
+static int16_t exp_out[SMP_NUM];
+static int16_t hw_out[SMP_NUM];
+static int16_t fir_coef[FIR_TAPS];
+static dsp_ref ref;
+
+// Low-pass sections at fs/10 in Q14, with a1 & a2 as in y = ... - a1*y1 - a2*y2.
+static const dsp_biq biq_sec[BIQ_NUM] = {
+    {1106, 2211, 1106, -18727, 6764},
+    {1106, 2211, 1106, -18727, 6764},
+    {1106, 2211, 1106, -18727, 6764},
+    {1106, 2211, 1106, -18727, 6764}
+};
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static int report(const char *name, uint32_t cyc, const int16_t *out) {
+    int err = out ? memcmp(out, exp_out, sizeof(exp_out)) != 0 : 0;
+    uint32_t ksps = (uint32_t) ((uint64_t) MAIN_CLK_FREQ * SMP_NUM / cyc / 1000);
+
+    printf("%s: %d cycles, %d.%02d cycles/sample, %d ksamples/s%s.\n", name, cyc,
+           cyc / SMP_NUM, cyc % SMP_NUM * 100 / SMP_NUM, ksps,
+           out ? (err ? ", error" : ", ok") : "");
+    return err;
+}
+
+// Samples moved by 2 DMA channels paced by the DSP handshakes, halfword by halfword.
+static int dma_dsp(const int16_t *in, int16_t *out, size_t len) {
+    uv_dsp_set_dma(true, DMA_TH, true, DMA_TH);
+    uv_dma_set_handshake(DMA_OUT_CH, true, DSP_OUT_DMA_HS);
+    uv_dma_set_handshake(DMA_IN_CH, true, DSP_IN_DMA_HS);
+    uv_dma_start(DMA_OUT_CH, REG_DSP_OUT, (uint32_t) out,
+                 uv_dma_ctrl(len, DMA_SIZE_HALF, false, true, DMA_BURST));
+    uv_dma_start(DMA_IN_CH, (uint32_t) in, REG_DSP_IN,
+                 uv_dma_ctrl(len, DMA_SIZE_HALF, true, false, DMA_BURST));
+    int ret = uv_dma_wait(DMA_IN_CH);
+    ret |= uv_dma_wait(DMA_OUT_CH);
+    uv_dma_set_handshake(DMA_IN_CH, false, 0);
+    uv_dma_set_handshake(DMA_OUT_CH, false, 0);
+    uv_dsp_set_dma(false, 0, false, 0);
+    return ret;
+}
+
+// Software model, CPU-fed & DMA-fed accelerator on the same samples.
+static int bench(const char *name) {
+    int err = 0;
+    dsp_ref run = ref;
+
+    printf("%s of %d samples.\n", name, SMP_NUM);
+
+    uint32_t t0 = get_cycle();
+    dsp_ref_run(&run, smp, exp_out, SMP_NUM);
+    uint32_t t1 = get_cycle();
+    report("Software model ", t1 - t0, NULL);
+
+    uv_dsp_clear();
+    uv_dsp_enable(true);
+    t0 = get_cycle();
+    uv_dsp_run(smp, hw_out, SMP_NUM);
+    t1 = get_cycle();
+    err += report("CPU to DSP     ", t1 - t0, hw_out);
+
+    memset(hw_out, 0, sizeof(hw_out));
+    uv_dsp_clear();
+    t0 = get_cycle();
+    int ret = dma_dsp(smp, hw_out, SMP_NUM);
+    t1 = get_cycle();
+    err += report("DMA to DSP     ", t1 - t0, hw_out) | (ret != 0);
+    uv_dsp_enable(false);
+
+    return err;
+}
+
+int main() {
+    uint32_t seed = 1;
+    int err = 0;
+
+    // Noise with a slow square wave, large enough to saturate some outputs.
+    for (int i = 0; i < SMP_NUM; ++i) {
+        seed = seed * 1103515245UL + 12345;
+        smp[i] = (int16_t) ((seed >> 16) & 0x3FFF) - 0x2000 + ((i & 0x40) ? 0x5000 : -0x5000);
+    }
+
+    // Triangular low-pass, summing to 32640 / 32768.
+    for (int k = 0; k < FIR_TAPS; ++k) {
+        fir_coef[k] = k < FIR_TAPS / 2 ? 120 * (k + 1) : 120 * (FIR_TAPS - k);
+    }
+
+    uv_dsp_set_fir(fir_coef, FIR_TAPS, FIR_SHIFT);
+    dsp_ref_fir(&ref, fir_coef, FIR_TAPS, FIR_SHIFT);
+    err += bench("FIR 32 taps");
+
+    uv_dsp_set_biquad(biq_sec, BIQ_NUM, BIQ_SHIFT);
+    dsp_ref_biquad(&ref, biq_sec, BIQ_NUM, BIQ_SHIFT);
+    err += bench("Biquad 4 sections");
+
+    printf("DSP test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define SRC_PIN     16                  // Looped back to SRC_IN_PIN, captured by channel 0.
+#define SRC_IN_PIN  24
+#define DST_PIN     13                  // Captured by channel 1.
+#define TRIG_NUM    4
+#define CHAIN_PRD   2000
+#define SPI_CLK_DIV 4
+#define DMA_CH      0
+#define CAP_TMO     100000
+
+#define TRIGGER_POSEDGE 2
+
+static const uint32_t tgl_seq[TRIG_NUM] = {
+    1UL << DST_PIN, 1UL << DST_PIN, 1UL << DST_PIN, 1UL << DST_PIN
+};
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+// The looped-back source pin raises an IRQ, and its ISR toggles the destination pin.
+void handle_ext_irq() {
+    uint32_t ext_irq = LOAD_WORD(REG_IRQ_CLAIM);
+
+    if (ext_irq == GPIO_IRQ(SRC_IN_PIN)) {
+        GPIO->out_tgl = 1UL << DST_PIN;
+    } else {
+        printf("Unexpected EXT IRQ: %d\n", ext_irq);
+    }
+    STORE_WORD(REG_IRQ_CLAIM, ext_irq);
+}
+
+// Wait for n timestamps of a channel.
+static size_t cap_wait(uint32_t ch, uint32_t *ts, size_t n) {
+    uint32_t t0 = get_cycle();
+
+    while ((uv_cap_len(ch) < n) && (get_cycle() - t0 < CAP_TMO)) {
+        ;
+    }
+    return uv_cap_read(ch, ts, n);
+}
+
+// Cycles from the rising edge of the source pin to the edge of the destination pin,
+// both taken by the capture unit, so that synchronizers on the way cancel out.
+static int bench_lat(const char *name) {
+    uint32_t ts0[TRIG_NUM];
+    uint32_t ts1[TRIG_NUM];
+    uint32_t lmin = ~0UL;
+    uint32_t lmax = 0;
+    uint32_t sum = 0;
+    int err = 0;
+
+    uv_cap_init(0, CAP_EDGE_RISE);
+    uv_cap_init(1, CAP_EDGE_BOTH);
+    for (int i = 0; i < TRIG_NUM; ++i) {
+        uint32_t lvl = GPIO->out_value & (1UL << DST_PIN);
+        GPIO->out_set = 1UL << SRC_PIN;
+        uint32_t t0 = get_cycle();
+        while (((GPIO->out_value & (1UL << DST_PIN)) == lvl) && (get_cycle() - t0 < CAP_TMO)) {
+            ;
+        }
+        GPIO->out_clr = 1UL << SRC_PIN;
+        while (GPIO->in_value & (1UL << SRC_IN_PIN)) {
+            ;
+        }
+    }
+
+    size_t n0 = cap_wait(0, ts0, TRIG_NUM);
+    size_t n1 = cap_wait(1, ts1, TRIG_NUM);
+    for (size_t i = 0; i < n0 && i < n1; ++i) {
+        uint32_t lat = (ts1[i] - ts0[i]) & CAP_TS_MASK;
+        lmin = lat < lmin ? lat : lmin;
+        lmax = lat > lmax ? lat : lmax;
+        sum += lat;
+    }
+    err += (n0 != TRIG_NUM) || (n1 != TRIG_NUM);
+
+    printf("%s: %d~%d cycles, %d on average, %d errors.\n", name, lmin, lmax, sum / TRIG_NUM, err);
+    return err;
+}
+
+// Edges of the destination pin must be a PWM period apart.
+static int check_prd(const char *name) {
+    uint32_t ts[TRIG_NUM];
+    int err = 0;
+
+    size_t n = cap_wait(1, ts, TRIG_NUM);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        err += ((ts[i + 1] - ts[i]) & CAP_TS_MASK) != CHAIN_PRD;
+    }
+    err += n != TRIG_NUM;
+
+    printf("%s: %d edges, %d errors.\n", name, n, err);
+    return err;
+}
+
+// PWM started by software event, each period starts a SPI0 command, whose end toggles the pin.
+static int bench_chain(const char *name) {
+    spi_desc desc = {0};
+    int err = 0;
+
+    desc.cmd = 0xA5;
+    desc.cmd_en = 1;
+    uv_spi_desc_start(SPI0_ID, &desc, 0, 0);
+    uv_spi_desc_wait(SPI0_ID);
+
+    uv_pwm_init(0, CHAIN_PRD, false, 0);
+    uv_cap_init(1, CAP_EDGE_BOTH);
+    uv_evt_clr_hit(0xFF);
+    uv_evt_connect(0, EVT_SW, TASK_PWM_START, 0);
+    uv_evt_connect(1, EVT_PWM_PRD, TASK_SPI0_START, 0);
+    uv_evt_connect(2, EVT_SPI0_DONE, TASK_GPIO_TGL, DST_PIN);
+    uv_evt_trigger();
+
+    err += check_prd(name);
+    uv_pwm_stop();
+    err += (uv_evt_hit() & 0x7) != 0x7;
+
+    for (int c = 0; c < 3; ++c) {
+        uv_evt_disconnect(c);
+    }
+    uv_spi_desc_wait(SPI0_ID);
+    return err;
+}
+
+// Each PWM period requests a DMA burst of a word to the toggle alias of GPIO.
+static int bench_dma(const char *name) {
+    int err = 0;
+
+    uv_pwm_init(0, CHAIN_PRD, false, 0);
+    uv_cap_init(1, CAP_EDGE_BOTH);
+    uv_dma_set_handshake(DMA_CH, true, EVT_DMA_HS(0));
+    uv_dma_start(DMA_CH, (uint32_t) tgl_seq, REG_GPIO_OUT_TGL,
+                 uv_dma_ctrl(TRIG_NUM, DMA_SIZE_WORD, true, false, 0));
+    uv_evt_connect(0, EVT_PWM_PRD, TASK_DMA_REQ, 0);
+    uv_pwm_start();
+
+    err += check_prd(name);
+    err += uv_dma_wait(DMA_CH) != 0;
+    uv_pwm_stop();
+
+    uv_evt_disconnect(0);
+    uv_dma_set_handshake(DMA_CH, false, 0);
+    return err;
+}
+
+int main() {
+    int err = 0;
+
+    // SPI0 in mode 0 for commands of the chain.
+    spi_cfg cfg;
+    cfg.cpol = 0;
+    cfg.cpha = 0;
+    cfg.endian = SPI_BIG_ENDIAN;
+    cfg.unit_len = SPI_UNIT_LEN_8BITS;
+    cfg.sck_dly = 0;
+    cfg.clk_div = SPI_CLK_DIV;
+    uv_spi_init(SPI0_ID, 0x1, false, &cfg);
+
+    // PWM outputs off, so the source pin is a plain GPIO.
+    uv_pwm_set_out(0, 0);
+    GPIO->out_clr = (1UL << SRC_PIN) | (1UL << DST_PIN);
+    GPIO->oe_set = (1UL << SRC_PIN) | (1UL << DST_PIN);
+    GPIO->in_enable |= 1UL << SRC_IN_PIN;
+
+    uv_enable_glb_irq();
+    uv_enable_ext_irq();
+    uv_config_ext_irq(GPIO_IRQ(SRC_IN_PIN), 7, TRIGGER_POSEDGE);
+    uv_set_target_threshold(0);
+
+    printf("Toggle GPIO %d on rising edges of GPIO %d.\n", DST_PIN, SRC_IN_PIN);
+
+    // CPU in the path: the GPIO IRQ is taken & its ISR writes the toggle alias.
+    GPIO->irq_en_set = 1UL << SRC_IN_PIN;
+    SET_EXT_IE(GPIO_IRQ(SRC_IN_PIN));
+    err += bench_lat("ISR    ");
+    CLR_EXT_IE(GPIO_IRQ(SRC_IN_PIN));
+    GPIO->irq_en_clr = 1UL << SRC_IN_PIN;
+
+    // No CPU in the path: the edge is routed to the toggle task.
+    uv_evt_connect(0, EVT_GPIO(SRC_IN_PIN), TASK_GPIO_TGL, DST_PIN);
+    err += bench_lat("Routed ");
+    uv_evt_disconnect(0);
+
+    err += bench_chain("PWM -> SPI0 -> GPIO");
+    err += bench_dma("PWM -> DMA -> GPIO ");
+
+    printf("Event test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
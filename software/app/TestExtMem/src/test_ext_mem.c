@@ -0,0 +1,103 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define SEQ_BYTES   16384
+#define RND_NUM     1024
+#define ROW_BYTES   1024
+#define DAM_BYTES   4096
+#define DMA_CH      0
+
+static uint32_t dam_buf[DAM_BYTES / 4];
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static inline uint32_t next_rand(uint32_t x) {
+    return x * 1664525UL + 1013904223UL;
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t num, uint32_t bytes, uint32_t fail_cnt) {
+    uint32_t lat = cyc * 100 / num;
+    uint32_t bw  = bytes * 100 / cyc;
+    printf("%s: %d cycles, %d.%02d cycles/access, %d.%02d B/cycle, %s.\n",
+           name, cyc, lat / 100, lat % 100, bw / 100, bw % 100, fail_cnt ? "FAIL" : "PASS");
+}
+
+// Sequential word stores then loads, which are merged into line reads.
+static void bench_seq(const char *wr_name, const char *rd_name, uint32_t base, uint32_t bytes) {
+    volatile uint32_t *p = (uint32_t *) base;
+    uint32_t words = bytes / 4;
+    uint32_t fail_cnt = 0;
+
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < words; ++i) {
+        p[i] = base + i;
+    }
+    uint32_t t1 = get_cycle();
+    report(wr_name, t1 - t0, words, bytes, 0);
+
+    t0 = get_cycle();
+    for (int i = 0; i < words; ++i) {
+        if (p[i] != base + i) {
+            ++fail_cnt;
+        }
+    }
+    t1 = get_cycle();
+    report(rd_name, t1 - t0, words, bytes, fail_cnt);
+}
+
+// Random word loads over the span, each of which fetches a new line.
+static void bench_rnd(const char *name, uint32_t base, uint32_t span) {
+    volatile uint32_t *p = (uint32_t *) base;
+    uint32_t x = 0x12345678UL;
+
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < RND_NUM; ++i) {
+        x = next_rand(x);
+        (void) p[(x >> 8) & (span / 4 - 1)];
+    }
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, RND_NUM, RND_NUM * 4, 0);
+}
+
+// Copy from external memory to DAM by DMA.
+static void bench_dma(const char *name, uint32_t base) {
+    uint32_t *src = (uint32_t *) base;
+    uint32_t fail_cnt = 0;
+
+    for (int i = 0; i < DAM_BYTES / 4; ++i) {
+        src[i] = ~i;
+        dam_buf[i] = 0;
+    }
+
+    uint32_t t0 = get_cycle();
+    int ret = uv_dma_memcpy(DMA_CH, dam_buf, src, DAM_BYTES);
+    uint32_t t1 = get_cycle();
+
+    for (int i = 0; i < DAM_BYTES / 4; ++i) {
+        if (dam_buf[i] != ~i) {
+            ++fail_cnt;
+        }
+    }
+    report(name, t1 - t0, DAM_BYTES / 4, DAM_BYTES, ret ? 1 : fail_cnt);
+}
+
+int main() {
+    printf("External SDRAM of %d bytes.\n", EXT_MEM_BYTE_LENGTH);
+
+    // Sequential write & read.
+    bench_seq("WR SEQ DAM", "RD SEQ DAM", (uint32_t) dam_buf, DAM_BYTES);
+    bench_seq("WR SEQ EXT", "RD SEQ EXT", EXT_MEM_START_ADDR, SEQ_BYTES);
+
+    // Random read in one row (open-page hits) & over the whole memory (row misses).
+    bench_rnd("RD RND DAM", (uint32_t) dam_buf, DAM_BYTES);
+    bench_rnd("RD RND ROW", EXT_MEM_START_ADDR, ROW_BYTES);
+    bench_rnd("RD RND EXT", EXT_MEM_START_ADDR, EXT_MEM_BYTE_LENGTH);
+
+    bench_dma("DMA TO DAM", EXT_MEM_START_ADDR + SEQ_BYTES);
+
+    return 0;
+}
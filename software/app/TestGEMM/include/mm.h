@@ -0,0 +1,18 @@
+// See LICENSE for license details.
+
+#ifndef _MM_H_
+#define _MM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// C += A * B on CPU, from the naive kernel of riscv-tests mm,
+// with int8, int16 or int32 elements summed in int32.
+void mm_i8(size_t m, size_t n, size_t p, const int8_t *a, size_t lda,
+           const int8_t *b, size_t ldb, int32_t *c, size_t ldc);
+void mm_i16(size_t m, size_t n, size_t p, const int16_t *a, size_t lda,
+            const int16_t *b, size_t ldb, int32_t *c, size_t ldc);
+void mm_i32(size_t m, size_t n, size_t p, const int32_t *a, size_t lda,
+            const int32_t *b, size_t ldb, int32_t *c, size_t ldc);
+
+#endif
@@ -0,0 +1,29 @@
+// See LICENSE for license details.
+
+#include "mm.h"
+
+// 4 partial sums over k, as mm_naive of riscv-tests mm.
+#define MM_NAIVE(name, t)                                                   \
+void name(size_t m, size_t n, size_t p, const t *a, size_t lda,             \
+          const t *b, size_t ldb, int32_t *c, size_t ldc)                   \
+{                                                                           \
+    for (size_t i = 0; i < m; i++) {                                        \
+        for (size_t j = 0; j < n; j++) {                                    \
+            int32_t s0 = c[i*ldc+j], s1 = 0, s2 = 0, s3 = 0;                \
+            for (size_t k = 0; k < p/4*4; k += 4) {                         \
+                s0 += (int32_t) a[i*lda+k+0] * b[(k+0)*ldb+j];              \
+                s1 += (int32_t) a[i*lda+k+1] * b[(k+1)*ldb+j];              \
+                s2 += (int32_t) a[i*lda+k+2] * b[(k+2)*ldb+j];              \
+                s3 += (int32_t) a[i*lda+k+3] * b[(k+3)*ldb+j];              \
+            }                                                               \
+            for (size_t k = p/4*4; k < p; k++) {                            \
+                s0 += (int32_t) a[i*lda+k] * b[k*ldb+j];                    \
+            }                                                               \
+            c[i*ldc+j] = (s0 + s1) + (s2 + s3);                             \
+        }                                                                   \
+    }                                                                       \
+}
+
+MM_NAIVE(mm_i8,  int8_t)
+MM_NAIVE(mm_i16, int16_t)
+MM_NAIVE(mm_i32, int32_t)
@@ -0,0 +1,106 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include <string.h>
+#include "uv_sys.h"
+#include "mm.h"
+
+#define MAX_M       32
+#define MAX_N       36
+#define MAX_P       72
+
+typedef struct {
+    const char *name;
+    uint32_t type;
+    uint32_t m;
+    uint32_t n;
+    uint32_t p;
+} mm_case;
+
+// Square tiles of each type, then blocks of M, N & K with tails.
+static const mm_case cases[] = {
+    {"int8  32x32x32", GEMM_INT8,  32, 32, 32},
+    {"int16 32x32x32", GEMM_INT16, 32, 32, 32},
+    {"int32 32x32x32", GEMM_INT32, 32, 32, 32},
+    {"int32 20x36x72", GEMM_INT32, 20, 36, 72},
+};
+
+static int32_t a[MAX_M * MAX_P];
+static int32_t b[MAX_P * MAX_N];
+static int32_t c_cpu[MAX_M * MAX_N];
+static int32_t c_acc[MAX_M * MAX_N];
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void print_rate(const char *name, uint32_t macs, uint32_t cyc) {
+    printf("%s: %d cycles, %d.%02d MACs/cycle.\n", name, cyc,
+           macs / cyc, macs % cyc * 100 / cyc);
+}
+
+// Elements in 12 bits, so that int32 sums never overflow.
+static void fill(void *p, size_t num, uint32_t type, uint32_t seed) {
+    for (size_t i = 0; i < num; ++i) {
+        seed = seed * 1103515245UL + 12345;
+        int32_t e = (int32_t) ((seed >> 16) & 0xFFF) - 0x800;
+        if (type == GEMM_INT8) {
+            ((int8_t *) p)[i] = (int8_t) e;
+        } else if (type == GEMM_INT16) {
+            ((int16_t *) p)[i] = (int16_t) e;
+        } else {
+            ((int32_t *) p)[i] = e;
+        }
+    }
+}
+
+static void cpu_mm(const mm_case *t) {
+    if (t->type == GEMM_INT8) {
+        mm_i8(t->m, t->n, t->p, (const int8_t *) a, t->p, (const int8_t *) b, t->n, c_cpu, t->n);
+    } else if (t->type == GEMM_INT16) {
+        mm_i16(t->m, t->n, t->p, (const int16_t *) a, t->p, (const int16_t *) b, t->n, c_cpu, t->n);
+    } else {
+        mm_i32(t->m, t->n, t->p, a, t->p, b, t->n, c_cpu, t->n);
+    }
+}
+
+static int bench(const mm_case *t) {
+    uint32_t macs = t->m * t->n * t->p;
+
+    fill(a, t->m * t->p, t->type, 1);
+    fill(b, t->p * t->n, t->type, 2);
+    memset(c_cpu, 0, sizeof(c_cpu));
+    memset(c_acc, 0, sizeof(c_acc));
+
+    printf("mm %s, %d MACs.\n", t->name, macs);
+
+    uint32_t t0 = get_cycle();
+    cpu_mm(t);
+    uint32_t t1 = get_cycle();
+    uint32_t cpu_cyc = t1 - t0;
+    print_rate("CPU mm         ", macs, cpu_cyc);
+
+    t0 = get_cycle();
+    uint32_t eng_cyc = uv_gemm_mm(t->type, t->m, t->n, t->p, a, t->p, b, t->n, c_acc, t->n);
+    t1 = get_cycle();
+    uint32_t acc_cyc = t1 - t0;
+    print_rate("GEMM with loads", macs, acc_cyc);
+    print_rate("GEMM engine    ", macs, eng_cyc);
+
+    int err = memcmp(c_cpu, c_acc, t->m * t->n * sizeof(int32_t)) != 0;
+    printf("Speedup %d.%02dx, %s.\n", cpu_cyc / acc_cyc, cpu_cyc % acc_cyc * 100 / acc_cyc,
+           err ? "error" : "ok");
+    return err;
+}
+
+int main() {
+    int err = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        err += bench(&cases[i]);
+    }
+
+    printf("GEMM test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
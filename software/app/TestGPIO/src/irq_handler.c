@@ -0,0 +1,31 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define LOOP_OUT_PIN 12
+
+extern volatile uint32_t done_cnt;
+extern volatile uint32_t done_cyc;
+extern volatile uint32_t isr_mode;
+
+// Drop the looped-back pin which raised the IRQ, by one of the 3 ways of write.
+void handle_ext_irq() {
+    uint32_t ext_irq = LOAD_WORD(REG_IRQ_CLAIM);
+
+    if (ext_irq == GPIO_IRQ(LOOP_OUT_PIN - 1)) {
+        if (isr_mode == 0) {
+            GPIO->out_value &= ~(1UL << LOOP_OUT_PIN);
+        } else if (isr_mode == 1) {
+            GPIO->out_clr = 1UL << LOOP_OUT_PIN;
+        } else {
+            GPIO_BB(REG_GPIO_OUT_VALUE, LOOP_OUT_PIN) = 0;
+        }
+        done_cyc = read_csr(mcycle);
+        done_cnt++;
+    } else {
+        printf("Unexpected EXT IRQ: %d\n", ext_irq);
+    }
+    STORE_WORD(REG_IRQ_CLAIM, ext_irq);
+}
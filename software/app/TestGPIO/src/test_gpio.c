@@ -0,0 +1,118 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define TGL_PIN      13
+#define LOOP_IN_PIN  11                 // Looped back from LOOP_OUT_PIN in testbench.
+#define LOOP_OUT_PIN 12
+#define TGL_NUM      64
+#define IRQ_NUM      8
+
+#define TRIGGER_POSEDGE 2
+
+volatile uint32_t done_cnt = 0;
+volatile uint32_t done_cyc = 0;
+volatile uint32_t isr_mode = 0;
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void report_tgl(const char *name, uint32_t cyc) {
+    uint32_t per_tgl = cyc / TGL_NUM;
+    printf("%s: %d cycles per toggle, %d kHz max square wave.\n",
+           name, per_tgl, MAIN_CLK_FREQ / 1000 / (per_tgl * 2));
+}
+
+// Read-modify-write of the whole output register.
+static void bench_rmw(const char *name) {
+    uint32_t mask = 1UL << TGL_PIN;
+
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < TGL_NUM; ++i) {
+        GPIO->out_value ^= mask;
+    }
+    uint32_t t1 = get_cycle();
+    report_tgl(name, t1 - t0);
+}
+
+// A single write to the toggle alias.
+static void bench_tgl(const char *name) {
+    uint32_t mask = 1UL << TGL_PIN;
+
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < TGL_NUM; ++i) {
+        GPIO->out_tgl = mask;
+    }
+    uint32_t t1 = get_cycle();
+    report_tgl(name, t1 - t0);
+}
+
+// A single write to the bit-band word of the pin.
+static void bench_bb(const char *name) {
+    uint32_t val = 0;
+
+    uint32_t t0 = get_cycle();
+    for (int i = 0; i < TGL_NUM; ++i) {
+        val ^= 1;
+        GPIO_BB(REG_GPIO_OUT_VALUE, TGL_PIN) = val;
+    }
+    uint32_t t1 = get_cycle();
+    report_tgl(name, t1 - t0);
+}
+
+// Cycles from raising the looped-back pin to the end of its ISR.
+static int bench_isr(const char *name, uint32_t mode) {
+    uint32_t sum = 0;
+    int err = 0;
+
+    isr_mode = mode;
+    done_cnt = 0;
+    for (int i = 0; i < IRQ_NUM; ++i) {
+        uint32_t t0 = get_cycle();
+        GPIO->out_set = 1UL << LOOP_OUT_PIN;
+        while (done_cnt == i) {
+            ;
+        }
+        sum += done_cyc - t0;
+        err += (GPIO->out_value >> LOOP_OUT_PIN) & 1;
+    }
+    printf("%s: %d cycles from pin set to ISR end, %d errors.\n", name, sum / IRQ_NUM, err);
+    return err;
+}
+
+int main() {
+    int err = 0;
+
+    GPIO->oe_set = (1UL << TGL_PIN) | (1UL << LOOP_OUT_PIN);
+    GPIO->in_enable = 1UL << LOOP_IN_PIN;
+    GPIO->irq_en_set = 1UL << LOOP_IN_PIN;
+
+    // Edge triggered, so the ISR may end before the dropped pin is synchronized.
+    uv_enable_glb_irq();
+    uv_enable_ext_irq();
+    uv_config_ext_irq(GPIO_IRQ(LOOP_IN_PIN), 7, TRIGGER_POSEDGE);
+    uv_set_target_threshold(0);
+    SET_EXT_IE(GPIO_IRQ(LOOP_IN_PIN));
+
+    printf("Toggle GPIO %d by %d writes.\n", TGL_PIN, TGL_NUM);
+    bench_rmw("Read-modify-write");
+    bench_tgl("Toggle alias     ");
+    bench_bb ("Bit-band         ");
+
+    // The pin must be back after an even number of toggles.
+    err += (GPIO->out_value >> TGL_PIN) & 1;
+
+    err += bench_isr("ISR by read-modify-write", 0);
+    err += bench_isr("ISR by clear alias      ", 1);
+    err += bench_isr("ISR by bit-band         ", 2);
+
+    CLR_EXT_IE(GPIO_IRQ(LOOP_IN_PIN));
+    GPIO->irq_en_clr = 1UL << LOOP_IN_PIN;
+
+    printf("GPIO test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
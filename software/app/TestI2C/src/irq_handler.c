@@ -0,0 +1,21 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+extern volatile uint32_t done_cnt;
+
+void handle_ext_irq() {
+    uint32_t ext_irq = LOAD_WORD(REG_IRQ_CLAIM);
+    uint32_t i2c_ip = I2C->ip;
+
+    if ((ext_irq == I2C_IRQ) && (i2c_ip & I2C_DONE_IRQ_MASK)) {
+        I2C->ip = i2c_ip & ~I2C_DONE_IRQ_MASK;
+        (void) I2C->ip;
+        done_cnt++;
+    } else {
+        printf("Unexpected EXT IRQ: %d\n", ext_irq);
+    }
+    STORE_WORD(REG_IRQ_CLAIM, ext_irq);
+}
@@ -0,0 +1,128 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define EEPROM_ADDR 0x50
+#define PAGE_SIZE   16
+#define WR_LEN      8                   // Bytes per page write, to fit a transfer in TXQ.
+
+volatile uint32_t done_cnt = 0;
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t free_cyc) {
+    uint32_t us = cyc / (MAIN_CLK_FREQ / 1000000);
+    printf("%s: %d cycles, %d us, %d CPU-free cycles.\n", name, cyc, us, free_cyc);
+}
+
+// A command at a time, waiting for SCL held before the next, as a byte-paced master.
+static void push_wait(uint32_t op, uint32_t dat) {
+    uv_i2c_push_cmd(op, dat);
+    uv_i2c_start();
+    while ((I2C->busy & (I2C_BUSY_MASK | I2C_HOLD_MASK)) == I2C_BUSY_MASK) {
+        ;
+    }
+}
+
+static void bench_cmds(const char *name, uint8_t word, uint8_t *buf) {
+    uint32_t t0 = get_cycle();
+    push_wait(I2C_CMD_START, EEPROM_ADDR << 1);
+    push_wait(I2C_CMD_WRITE, word);
+    for (int i = 0; i < WR_LEN; ++i) {
+        push_wait(I2C_CMD_WRITE, buf[i]);
+    }
+    push_wait(I2C_CMD_STOP, 0);
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, 0);
+}
+
+// The whole transfer queued at once, ended by the done IRQ.
+static void bench_queue(const char *name, uint8_t word, uint8_t *buf) {
+    done_cnt = 0;
+    uv_i2c_clr_irq();
+    uv_i2c_set_irq(true, false);
+
+    uint32_t t0 = get_cycle();
+    uv_i2c_push_cmd(I2C_CMD_START, EEPROM_ADDR << 1);
+    uv_i2c_push_cmd(I2C_CMD_WRITE, word);
+    for (int i = 0; i < WR_LEN; ++i) {
+        uv_i2c_push_cmd(I2C_CMD_WRITE, buf[i]);
+    }
+    uv_i2c_push_cmd(I2C_CMD_STOP, 0);
+    uv_i2c_start();
+    uint32_t t1 = get_cycle();
+    while (done_cnt == 0) {
+        ;
+    }
+    uint32_t t2 = get_cycle();
+
+    uv_i2c_set_irq(false, false);
+    report(name, t2 - t0, t2 - t1);
+}
+
+// Poll by the address, which is NACKed while the page is programmed.
+static int wait_write() {
+    int polls = 0;
+
+    while (uv_i2c_xfer(EEPROM_ADDR, 0, 0, 0, 0) == I2C_ERR_NACK) {
+        polls++;
+    }
+    return polls;
+}
+
+static int check(const char *name, uint8_t word, uint8_t *exp, size_t len) {
+    uint8_t buf[PAGE_SIZE];
+    int err = 0;
+
+    uint32_t t0 = get_cycle();
+    int ret = uv_i2c_xfer(EEPROM_ADDR, &word, 1, buf, len);
+    uint32_t t1 = get_cycle();
+
+    for (size_t i = 0; i < len; ++i) {
+        err += buf[i] != exp[i];
+    }
+    printf("%s: %d bytes at %02x in %d cycles, %d errors, status %d.\n", name, len, word, t1 - t0, err, ret);
+    return err + (ret != 0);
+}
+
+int main() {
+    uint8_t dat[2][WR_LEN];
+    int err = 0;
+
+    for (int i = 0; i < WR_LEN; ++i) {
+        dat[0][i] = 0xA0 + i;
+        dat[1][i] = 0x50 + i * 3;
+    }
+
+    uv_i2c_init(I2C_FMP_CLK_DIV, I2C_FMP_SCL_LO, I2C_DEFAULT_SDA_DLY);
+
+    uv_enable_glb_irq();
+    uv_enable_ext_irq();
+    uv_config_ext_irq(I2C_IRQ, 7, 0);
+    uv_set_target_threshold(0);
+    SET_EXT_IE(I2C_IRQ);
+
+    printf("Write %d bytes to EEPROM in FM+, %d bits on wire.\n", WR_LEN, (WR_LEN + 2) * 9 + 2);
+
+    bench_cmds("Command per poll", 0x00, dat[0]);
+    printf("Write polls: %d.\n", wait_write());
+    bench_queue("Command queue   ", PAGE_SIZE, dat[1]);
+    printf("Write polls: %d.\n", wait_write());
+
+    // Random reads with repeated START.
+    err += check("Read page 0", 0x00, dat[0], WR_LEN);
+    err += check("Read page 1", PAGE_SIZE, dat[1], WR_LEN);
+
+    // A device not on the bus ends the transfer by NACK.
+    int ret = uv_i2c_xfer(EEPROM_ADDR + 1, dat[0], 1, 0, 0);
+    printf("Absent device: status %d.\n", ret);
+    err += ret != I2C_ERR_NACK;
+
+    printf("I2C test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
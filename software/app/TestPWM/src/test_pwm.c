@@ -0,0 +1,167 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define PWM_PRD     1000                // 100 kHz at 100 MHz.
+#define PWM_DEAD    10
+#define SW_PIN      13                  // Captured by channel 1.
+#define WIN_CYC     50000
+#define CAP_TMO     100000
+
+static const uint32_t duty[PWM_CH_NUM] = {250, 500, 750, 100};
+
+static volatile uint32_t sw_high = 0;
+static volatile uint32_t sw_prd = 0;
+static volatile uint32_t sw_lvl = 0;
+static volatile uint64_t sw_cmp = 0;
+static volatile uint32_t irq_cnt = 0;
+static volatile uint32_t isr_cyc = 0;
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+// Loops of CPU left in a window.
+static uint32_t run_window() {
+    uint32_t n = 0;
+    uint32_t t0 = get_cycle();
+
+    while (get_cycle() - t0 < WIN_CYC) {
+        n++;
+    }
+    return n;
+}
+
+// Capture edges of a FIFO depth, and check high time & period from each rising edge.
+static int measure(const char *name, uint32_t ch, uint32_t exp_high, uint32_t exp_high_alt, uint32_t exp_prd) {
+    uint32_t ts[CAP_QUE_DEPTH];
+    uint32_t hmin = ~0UL;
+    uint32_t hmax = 0;
+    uint32_t pmin = ~0UL;
+    uint32_t pmax = 0;
+    int err = 0;
+
+    uv_cap_init(ch, CAP_EDGE_BOTH);
+    uint32_t t0 = get_cycle();
+    while ((uv_cap_len(ch) < CAP_QUE_DEPTH) && (get_cycle() - t0 < CAP_TMO)) {
+        ;
+    }
+    size_t n = uv_cap_read(ch, ts, CAP_QUE_DEPTH);
+
+    for (size_t i = 0; i + 2 < n; ++i) {
+        if (!(ts[i] & CAP_LEVEL_MASK)) {
+            continue;
+        }
+        uint32_t high = (ts[i + 1] - ts[i]) & CAP_TS_MASK;
+        uint32_t prd = (ts[i + 2] - ts[i]) & CAP_TS_MASK;
+        hmin = high < hmin ? high : hmin;
+        hmax = high > hmax ? high : hmax;
+        pmin = prd < pmin ? prd : pmin;
+        pmax = prd > pmax ? prd : pmax;
+        err += (high != exp_high) && (high != exp_high_alt);
+        err += prd != exp_prd;
+    }
+    err += n < CAP_QUE_DEPTH;
+
+    printf("%s: high %d~%d cycles, period %d~%d cycles, expected %d/%d, %d errors.\n",
+           name, hmin, hmax, pmin, pmax, exp_high, exp_prd, err);
+    return err;
+}
+
+// Software PWM: a timer IRQ per edge flips the pin.
+static void sw_pwm_start(uint32_t high, uint32_t prd) {
+    sw_high = high;
+    sw_prd = prd;
+    sw_lvl = 0;
+    irq_cnt = 0;
+    isr_cyc = 0;
+
+    GPIO->out_clr = 1UL << SW_PIN;
+    GPIO->oe_set = 1UL << SW_PIN;
+    uv_tmr_init(false, 0, ~0ULL);
+    uv_tmr_set_val(0);
+    sw_cmp = prd - high;
+    uv_tmr_set_hart_cmp(0, sw_cmp);
+    uv_tmr_start();
+    uv_enable_tmr_irq();
+}
+
+static void sw_pwm_stop() {
+    uv_disable_tmr_irq();
+    uv_tmr_stop();
+    GPIO->out_clr = 1UL << SW_PIN;
+}
+
+void handle_tmr_irq() {
+    uint32_t t0 = get_cycle();
+
+    sw_lvl = !sw_lvl;
+    GPIO->out_tgl = 1UL << SW_PIN;
+    sw_cmp += sw_lvl ? sw_high : sw_prd - sw_high;
+    uv_tmr_set_hart_cmp(0, sw_cmp);
+    irq_cnt++;
+    isr_cyc += get_cycle() - t0;
+}
+
+// Jitter of software PWM is reported, but not checked.
+static void bench_sw(const char *name, uint32_t high, uint32_t prd) {
+    sw_pwm_start(high, prd);
+    uint32_t loops = run_window();
+    uint32_t irqs = irq_cnt;
+    uint32_t cyc = isr_cyc;
+    (void) measure(name, 1, high, high, prd);
+    sw_pwm_stop();
+
+    printf("%s: %d IRQs, %d ISR cycles, %d%% CPU in ISR bodies, %d loops left in %d cycles.\n",
+           name, irqs, cyc, cyc * 100 / WIN_CYC, loops, WIN_CYC);
+}
+
+static int bench_hw(const char *name) {
+    uint32_t loops = run_window();
+
+    printf("%s: 0 IRQs, %d loops left in %d cycles.\n", name, loops, WIN_CYC);
+    return measure(name, 0, duty[0] - PWM_DEAD, duty[0] - PWM_DEAD, PWM_PRD);
+}
+
+int main() {
+    int err = 0;
+
+    uv_enable_glb_irq();
+
+    // Edge-aligned PWM on 4 complementary pairs.
+    uv_pwm_init(0, PWM_PRD, false, PWM_DEAD);
+    for (int c = 0; c < PWM_CH_NUM; ++c) {
+        uv_pwm_set_duty(c, duty[c]);
+    }
+    uv_pwm_set_out(0xFF, 0);
+    uv_pwm_start();
+
+    printf("PWM at %d kHz, dead time %d cycles.\n", MAIN_CLK_FREQ / 1000 / PWM_PRD, PWM_DEAD);
+    err += bench_hw("Hardware PWM 100 kHz");
+
+    // Duty changed by shadow registers, loaded at the end of a period without a broken one.
+    uv_pwm_set_duty(0, 600);
+    uv_pwm_update();
+    err += measure("Shadow update", 0, duty[0] - PWM_DEAD, 600 - PWM_DEAD, PWM_PRD);
+    err += uv_pwm_update_busy();
+
+    // Center-aligned, counting up & down in a period.
+    uv_pwm_stop();
+    uv_pwm_init(0, PWM_PRD / 2, true, PWM_DEAD);
+    uv_pwm_set_duty(0, duty[0] / 2);
+    uv_pwm_start();
+    err += measure("Center-aligned", 0, duty[0] - PWM_DEAD, duty[0] - PWM_DEAD, PWM_PRD);
+
+    // Software PWM with 2 IRQs per period.
+    bench_sw("Software PWM 10 kHz ", PWM_PRD * 10 / 4, PWM_PRD * 10);
+    bench_sw("Software PWM 100 kHz", PWM_PRD / 4, PWM_PRD);
+
+    uv_pwm_stop();
+    uv_pwm_set_out(0, 0);
+
+    printf("PWM test %s.\n", err ? "failed" : "passed");
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+// Loop of NOPs run from SRAM, so every fetch goes through devbus.
+#define LOOP_NOPS   14
+#define LOOP_ITERS  256
+#define LOOP_ADDR   SRAM_START_ADDR
+
+// DMA copies between SRAM buffers meanwhile.
+#define COPY_WORDS  4096
+#define COPY_SRC    (SRAM_START_ADDR + 0x1000)
+#define COPY_DST    (SRAM_START_ADDR + 0x5000)
+#define DMA_CH      0
+
+// Devbus masters.
+#define MST_FETCH   0
+#define MST_DMA     2
+
+// Written to scratch to report the worst fetch latency by testbench.
+#define QOS_MARK    0xcafe0051UL
+
+#define INSN_NOP    0x00000013UL    // addi x0, x0, 0
+#define INSN_DEC    0xfff50513UL    // addi a0, a0, -1
+#define INSN_RET    0x00008067UL    // jalr x0, 0(ra)
+
+typedef void (*loop_func)(uint32_t iters);
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+// bnez a0, off
+static uint32_t insn_bnez(int32_t off) {
+    uint32_t imm = (uint32_t) off;
+    return ((imm >> 12) & 0x1) << 31 | ((imm >> 5) & 0x3f) << 25 | 10 << 15 | 1 << 12
+         | ((imm >> 1) & 0xf) << 8 | ((imm >> 11) & 0x1) << 7 | 0x63;
+}
+
+static void build_loop() {
+    volatile uint32_t *code = (uint32_t *) LOOP_ADDR;
+    int n = 0;
+
+    for (int i = 0; i < LOOP_NOPS; ++i) {
+        code[n++] = INSN_NOP;
+    }
+    code[n++] = INSN_DEC;
+    code[n] = insn_bnez(-n * 4);
+    ++n;
+    code[n++] = INSN_RET;
+
+    // fence.i
+    asm volatile (".word 0x0000100f" ::: "memory");
+}
+
+static uint32_t run_loop() {
+    loop_func loop = (loop_func) LOOP_ADDR;
+    uint32_t t0 = get_cycle();
+    loop(LOOP_ITERS);
+    return get_cycle() - t0;
+}
+
+static void bench(const char *name, bool dma_load) {
+    uint32_t cyc;
+
+    if (dma_load) {
+        uv_dma_start(DMA_CH, COPY_SRC, COPY_DST,
+                     uv_dma_ctrl(COPY_WORDS, DMA_SIZE_WORD, true, true, DMA_MAX_BURST));
+    }
+    cyc = run_loop();
+    if (dma_load) {
+        uv_dma_wait(DMA_CH);
+    }
+
+    uint32_t ipc = LOOP_ITERS * (LOOP_NOPS + 2) * 100 / cyc;
+    printf("%s: %d cycles, IPC %d.%02d.\n", name, cyc, ipc / 100, ipc % 100);
+    STORE_WORD(REG_SLC_SCRATCH, QOS_MARK);
+}
+
+int main() {
+    build_loop();
+
+    printf("Run %d-instruction loop from SRAM under DMA load.\n", LOOP_ITERS * (LOOP_NOPS + 2));
+    bench("Idle                 ", false);
+
+    // Plain round-robin.
+    SLC->bus_qos = 0;
+    bench("Round-robin          ", true);
+
+    // DMA keeps its turn for 16 grants.
+    uv_bus_qos_set(MST_DMA, 0, 15);
+    bench("DMA weight 16        ", true);
+
+    // DMA of higher class, without & with starvation limit.
+    uv_bus_qos_set(MST_DMA, 1, 15);
+    bench("DMA class 1          ", true);
+    uv_bus_qos_set_lim(8);
+    bench("DMA class 1, limit 8 ", true);
+
+    // Fetch of the highest class.
+    uv_bus_qos_set_lim(0);
+    uv_bus_qos_set(MST_FETCH, 3, 0);
+    bench("Fetch class 3        ", true);
+
+    SLC->bus_qos = 0;
+    return 0;
+}
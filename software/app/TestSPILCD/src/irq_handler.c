@@ -0,0 +1,20 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+extern volatile uint32_t done_cnt;
+
+void handle_ext_irq() {
+    uint32_t ext_irq = LOAD_WORD(REG_IRQ_CLAIM);
+    uint32_t spi0_ip = SPI0->ip;
+
+    if ((ext_irq == SPI0_IRQ) && (spi0_ip & SPI_DONE_IRQ_MASK)) {
+        uv_spi_clr_done_irq(SPI0_ID);
+        done_cnt++;
+    } else {
+        printf("Unexpected EXT IRQ: %d\n", ext_irq);
+    }
+    STORE_WORD(REG_IRQ_CLAIM, ext_irq);
+}
@@ -0,0 +1,199 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define LCD_W       240
+#define LCD_H       240
+#define LINE_BYTES  (LCD_W * 2)         // RGB565.
+#define LINE_WORDS  (LINE_BYTES / 4)
+#define FRAME_BYTES (LINE_BYTES * LCD_H)
+#define LINE_NUM    8                   // Lines repeated down the frame.
+#define PART_ROWS   24                  // Rows sent by bytes, projected to a frame.
+#define LCD_DC_PIN  10
+
+#define CMD_CASET   0x2A
+#define CMD_RASET   0x2B
+#define CMD_RAMWR   0x2C
+
+#define SPI_CLK_DIV 0                   // sck_freq = main_freq / 2.
+#define DMA_CH      0
+#define DMA_TH      4
+#define DMA_BURST   2                   // 2^2 words per handshake.
+
+static uint32_t line_buf[LINE_NUM][LINE_WORDS];
+static uint32_t line_sum[LINE_NUM];
+static dma_desc frm_desc[LCD_H];
+volatile uint32_t done_cnt = 0;
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+// Pixels are sent high byte first, so they are stored in big endian.
+static void fill_lines() {
+    for (int l = 0; l < LINE_NUM; ++l) {
+        uint8_t *b = (uint8_t *) line_buf[l];
+        line_sum[l] = 0;
+        for (int x = 0; x < LCD_W; ++x) {
+            uint16_t pix = x * 0x0841 + l * 0x001F;
+            b[x * 2] = pix >> 8;
+            b[x * 2 + 1] = pix & 0xFF;
+            line_sum[l] += pix;
+        }
+    }
+}
+
+static uint32_t frame_sum(uint32_t rows) {
+    uint32_t sum = 0;
+    for (uint32_t y = 0; y < rows; ++y) {
+        sum += line_sum[y % LINE_NUM];
+    }
+    return sum;
+}
+
+static void lcd_dc(bool data) {
+    if (data) {
+        GPIO->out_value |= 1UL << LCD_DC_PIN;
+    } else {
+        GPIO->out_value &= ~(1UL << LCD_DC_PIN);
+    }
+    // Read back, so D/C changes before the next transfer.
+    (void) GPIO->out_value;
+}
+
+// Wait for bytes in TXQ to be sent, by an empty descriptor ending after the serial engine.
+static void lcd_fence() {
+    spi_desc desc = {0};
+
+    while (SPI0->txq_len > 0) {
+        ;
+    }
+    uv_spi_desc_start(SPI0_ID, &desc, 0, 0);
+    uv_spi_desc_wait(SPI0_ID);
+}
+
+// A command goes with D/C low, then its 4 parameter bytes in the address phase.
+static void lcd_cmd(uint8_t cmd, bool has_param, uint32_t param) {
+    spi_desc desc = {0};
+
+    lcd_fence();
+    lcd_dc(false);
+    desc.cmd = cmd;
+    desc.cmd_en = 1;
+    uv_spi_desc_start(SPI0_ID, &desc, 0, 0);
+    uv_spi_desc_wait(SPI0_ID);
+    lcd_dc(true);
+
+    if (has_param) {
+        desc.cmd_en = 0;
+        desc.addr_nb = 4;
+        uv_spi_desc_start(SPI0_ID, &desc, param, 0);
+        uv_spi_desc_wait(SPI0_ID);
+    }
+}
+
+static void lcd_window(uint32_t rows) {
+    lcd_cmd(CMD_CASET, true, LCD_W - 1);
+    lcd_cmd(CMD_RASET, true, rows - 1);
+    lcd_cmd(CMD_RAMWR, false, 0);
+}
+
+static void report(const char *name, uint32_t cyc, uint32_t free_cyc, uint32_t sum) {
+    uint32_t us = cyc / (MAIN_CLK_FREQ / 1000000);
+    printf("%s: %d cycles per frame, %d.%03d ms, %d CPU-free cycles, pixel sum %08x.\n",
+           name, cyc, us / 1000, us % 1000, free_cyc, sum);
+}
+
+// Register mode: a byte per queue word, pushed by CPU.
+static void bench_bytes(const char *name) {
+    lcd_window(PART_ROWS);
+    uint32_t t0 = get_cycle();
+    for (int y = 0; y < PART_ROWS; ++y) {
+        uv_spi_send_bytes(SPI0_ID, (uint8_t *) line_buf[y % LINE_NUM], LINE_BYTES);
+    }
+    lcd_fence();
+    uint32_t t1 = get_cycle();
+    report(name, (t1 - t0) * (LCD_H / PART_ROWS), 0, frame_sum(PART_ROWS));
+}
+
+// Descriptor mode: 4 bytes per queue word, pushed by CPU.
+static void bench_words(const char *name) {
+    spi_desc desc = {0};
+
+    lcd_window(LCD_H);
+    uint32_t t0 = get_cycle();
+    uv_spi_desc_start(SPI0_ID, &desc, 0, FRAME_BYTES);
+    for (int y = 0; y < LCD_H; ++y) {
+        uv_spi_send_words(SPI0_ID, line_buf[y % LINE_NUM], LINE_WORDS);
+    }
+    uv_spi_desc_wait(SPI0_ID);
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, 0, frame_sum(LCD_H));
+}
+
+// Descriptor mode: queue words moved by DMA on the TX handshake, ended by the done IRQ.
+static void bench_dma(const char *name) {
+    spi_desc desc = {0};
+
+    for (int y = 0; y < LCD_H; ++y) {
+        uv_dma_set_desc(&frm_desc[y], (uint32_t) line_buf[y % LINE_NUM], REG_SPI0_TXQ_DAT,
+                        uv_dma_ctrl(LINE_WORDS, DMA_SIZE_WORD, true, false, DMA_BURST),
+                        y == LCD_H - 1 ? 0 : &frm_desc[y + 1]);
+    }
+    uv_spi_set_dma(SPI0_ID, true, DMA_TH, false, 0);
+    uv_dma_set_handshake(DMA_CH, true, SPI0_TX_DMA_HS);
+
+    lcd_window(LCD_H);
+    done_cnt = 0;
+    uv_spi_set_done_irq(SPI0_ID, true);
+    uint32_t t0 = get_cycle();
+    uv_spi_desc_start(SPI0_ID, &desc, 0, FRAME_BYTES);
+    uv_dma_start_chain(DMA_CH, frm_desc);
+    uint32_t t1 = get_cycle();
+    while (done_cnt == 0) {
+        ;
+    }
+    uint32_t t2 = get_cycle();
+
+    int ret = uv_dma_wait(DMA_CH);
+    uv_spi_set_done_irq(SPI0_ID, false);
+    uv_dma_set_handshake(DMA_CH, false, 0);
+    uv_spi_set_dma(SPI0_ID, false, 0, false, 0);
+    report(name, t2 - t0, t2 - t1, frame_sum(LCD_H));
+    if (ret) {
+        printf("DMA error!\n");
+    }
+}
+
+int main() {
+    // Mode 0, MSB first, bytes in register mode.
+    spi_cfg cfg;
+    cfg.cpol = 0;
+    cfg.cpha = 0;
+    cfg.endian = SPI_BIG_ENDIAN;
+    cfg.unit_len = SPI_UNIT_LEN_8BITS;
+    cfg.sck_dly = 0;
+    cfg.clk_div = SPI_CLK_DIV;
+    uv_spi_init(SPI0_ID, 0x1, false, &cfg);
+
+    GPIO->out_enable |= 1UL << LCD_DC_PIN;
+    lcd_dc(true);
+
+    uv_enable_glb_irq();
+    uv_enable_ext_irq();
+    uv_config_ext_irq(SPI0_IRQ, 7, 0);
+    uv_set_target_threshold(0);
+    SET_EXT_IE(SPI0_IRQ);
+
+    fill_lines();
+    printf("Refresh %dx%d RGB565 by SPI at %d MHz, %d cycles on wire per frame.\n",
+           LCD_W, LCD_H, MAIN_CLK_FREQ / 2000000 / (SPI_CLK_DIV + 1), FRAME_BYTES * 16 * (SPI_CLK_DIV + 1));
+
+    bench_bytes("Register bytes ");
+    bench_words("Descriptor CPU ");
+    bench_dma  ("Descriptor DMA ");
+
+    return 0;
+}
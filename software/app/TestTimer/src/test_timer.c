@@ -6,9 +6,44 @@
 
 #define LOOP_CYC 10000
 #define LOOP_NUM 10
+#define READ_NUM 16
 
 static volatile bool tmr_irq_trig = false;
 
+// Read time through devbus, retrying on the carry of the lower half.
+static uint64_t get_val_by_bus() {
+    uint32_t low;
+    uint32_t high;
+
+    do {
+        high = SLC->tmr_valh;
+        low = SLC->tmr_val;
+    } while (high != SLC->tmr_valh);
+
+    return ((uint64_t) high << 32) | low;
+}
+
+// Cycles of reading time by devbus & core-local port.
+static void bench_get_val() {
+    uint64_t last = 0;
+    uint32_t err_cnt = 0;
+
+    uint32_t t0 = read_csr(mcycle);
+    for (int i = 0; i < READ_NUM; ++i) {
+        get_val_by_bus();
+    }
+    uint32_t t1 = read_csr(mcycle);
+    for (int i = 0; i < READ_NUM; ++i) {
+        uint64_t val = uv_tmr_get_val();
+        err_cnt += val < last;
+        last = val;
+    }
+    uint32_t t2 = read_csr(mcycle);
+
+    printf("Time read by devbus in %d cycles, by core-local port in %d cycles, %d errors.\n",
+           (t1 - t0) / READ_NUM, (t2 - t1) / READ_NUM, err_cnt);
+}
+
 int main() {
     bool auto_clr = true;
     uint32_t clk_div = 0;
@@ -33,6 +68,13 @@ int main() {
     uint64_t tmr_val = uv_tmr_get_val();
     printf("Timer stopped at %d.\n", (uint32_t) tmr_val);
 
+    // Free-running from near the carry into the upper half.
+    uv_tmr_init(false, clk_div, ~0ULL);
+    uv_tmr_set_val(0xFFFFFF00ULL);
+    uv_tmr_start();
+    bench_get_val();
+    uv_tmr_stop();
+
     return 0;
 }
 
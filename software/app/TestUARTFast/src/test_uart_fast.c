@@ -0,0 +1,157 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+
+#define TEST_BYTES  1024
+#define TEST_WORDS  (TEST_BYTES / 4)
+#define TX_DMA_CH   0
+#define RX_DMA_CH   1
+#define DMA_BURST   2   // 4 words, i.e. 16 bytes per handshake.
+#define DMA_TH      16
+#define OVR_BYTES   64  // Pushed beyond the room of TXQ.
+
+static uint32_t send_buf[TEST_WORDS];
+static uint32_t recv_buf[TEST_WORDS];
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void fill_bufs(uint32_t seed) {
+    uint8_t *s = (uint8_t *) send_buf;
+    for (int i = 0; i < TEST_BYTES; ++i) {
+        s[i] = seed + i * 7;
+    }
+    for (int i = 0; i < TEST_WORDS; ++i) {
+        recv_buf[i] = 0;
+    }
+}
+
+static uint32_t check_bufs(uint32_t words) {
+    uint32_t fail_cnt = 0;
+    for (uint32_t i = 0; i < words; ++i) {
+        if (recv_buf[i] != send_buf[i]) {
+            ++fail_cnt;
+        }
+    }
+    return fail_cnt;
+}
+
+// Bits per byte are 10 with 8 data bits & 1 stop bit.
+static void report(const char *name, uint32_t cyc, uint32_t free_cyc, uint32_t fail_cnt) {
+    uint32_t kbps = TEST_BYTES * 10 * (MAIN_CLK_FREQ / 1000) / cyc;
+    printf("%s: %d cycles, %d kbps, %d%% of line rate, %d CPU-free cycles, %s.\n",
+           name, cyc, kbps, kbps * 100 / (UART_BAUD_RATE_921600 / 1000), free_cyc,
+           fail_cnt ? "FAIL" : "PASS");
+}
+
+// The former way: TXQ_CAP & TXQ_LEN are read for the room, and a byte is moved per access.
+static uint32_t send_bytes(uint8_t *buf, uint32_t len) {
+    uint32_t room = UART->txq_cap - UART->txq_len;
+    uint32_t num = room < len ? room : len;
+    for (uint32_t i = 0; i < num; ++i) {
+        UART->txq_dat = buf[i];
+    }
+    return num;
+}
+
+static uint32_t recv_bytes(uint8_t *buf, uint32_t len) {
+    uint32_t num = UART->rxq_len;
+    num = num < len ? num : len;
+    for (uint32_t i = 0; i < num; ++i) {
+        buf[i] = UART->rxq_dat;
+    }
+    return num;
+}
+
+// TXQ_FREE for the room, and 4 bytes per access of TXQ_WDAT & RXQ_WDAT.
+static uint32_t send_words(uint8_t *buf, uint32_t len) {
+    uint32_t room = UART->txq_free;
+    uint32_t num = room < len ? room : len;
+    uv_uart_send_data(buf, num);
+    return num;
+}
+
+static uint32_t recv_words(uint8_t *buf, uint32_t len) {
+    uint32_t num = UART->rxq_len;
+    num = num < len ? num : len;
+    uv_uart_recv_data(buf, num);
+    return num;
+}
+
+// Data are looped back by the testbench, and sent & received by CPU in turn.
+static void bench_cpu(const char *name, uint32_t (*send)(uint8_t *, uint32_t),
+                      uint32_t (*recv)(uint8_t *, uint32_t)) {
+    uint8_t *s = (uint8_t *) send_buf;
+    uint8_t *r = (uint8_t *) recv_buf;
+    uint32_t tx = 0;
+    uint32_t rx = 0;
+
+    fill_bufs(0x5a);
+    uint32_t t0 = get_cycle();
+    while (rx < TEST_BYTES) {
+        if (tx < TEST_BYTES) {
+            tx += send(s + tx, TEST_BYTES - tx);
+        }
+        rx += recv(r + rx, TEST_BYTES - rx);
+    }
+    uint32_t t1 = get_cycle();
+    report(name, t1 - t0, 0, check_bufs(TEST_WORDS));
+}
+
+// TX & RX by DMA channels on the UART handshakes, while CPU only polls the busy status.
+static void bench_dma(const char *name) {
+    fill_bufs(0xa5);
+    uv_uart_set_dma(true, DMA_TH, true, DMA_TH);
+    uv_dma_set_handshake(TX_DMA_CH, true, UART_TX_DMA_HS);
+    uv_dma_set_handshake(RX_DMA_CH, true, UART_RX_DMA_HS);
+
+    uint32_t t0 = get_cycle();
+    uv_dma_start(RX_DMA_CH, REG_UART_RXQ_WDAT, (uint32_t) recv_buf,
+                 uv_dma_ctrl(TEST_WORDS, DMA_SIZE_WORD, false, true, DMA_BURST));
+    uv_dma_start(TX_DMA_CH, (uint32_t) send_buf, REG_UART_TXQ_WDAT,
+                 uv_dma_ctrl(TEST_WORDS, DMA_SIZE_WORD, true, false, DMA_BURST));
+    uint32_t t1 = get_cycle();
+    while (uv_dma_busy(RX_DMA_CH)) {
+        ;
+    }
+    uint32_t t2 = get_cycle();
+
+    int ret = uv_dma_wait(TX_DMA_CH) | uv_dma_wait(RX_DMA_CH);
+    uv_dma_set_handshake(TX_DMA_CH, false, 0);
+    uv_dma_set_handshake(RX_DMA_CH, false, 0);
+    uv_uart_set_dma(false, 0, false, 0);
+    report(name, t2 - t0, t2 - t1, ret ? 1 : check_bufs(TEST_WORDS));
+}
+
+// Words are pushed without checking the room, so those to a full TXQ wait for PREADY
+// rather than being dropped, and all of them are looped back.
+static void check_overrun(const char *name) {
+    uint32_t len = UART->txq_cap + OVR_BYTES;
+    uint8_t *r = (uint8_t *) recv_buf;
+    uint32_t rx = 0;
+
+    len = len < TEST_BYTES ? len : TEST_BYTES;
+    fill_bufs(0x3c);
+    for (uint32_t i = 0; i < len / 4; ++i) {
+        UART->txq_wdat = send_buf[i];
+    }
+    while (rx < len) {
+        rx += recv_words(r + rx, len - rx);
+    }
+    printf("%s: %d bytes, %s.\n", name, len, check_bufs(len / 4) ? "FAIL" : "PASS");
+}
+
+int main() {
+    uv_uart_init(true, true, UART_BAUD_RATE_921600);
+    printf("UART at %d baud, TXQ of %d bytes, RXQ of %d bytes.\n",
+           UART_BAUD_RATE_921600, UART->txq_cap, UART->rxq_cap);
+
+    bench_cpu("Byte registers", send_bytes, recv_bytes);
+    bench_cpu("Word registers", send_words, recv_words);
+    bench_dma("DMA handshakes");
+    check_overrun("TXQ overrun");
+
+    return 0;
+}
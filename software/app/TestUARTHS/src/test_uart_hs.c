@@ -0,0 +1,104 @@
+// See LICENSE for license details.
+
+#include <stdio.h>
+#include "uv_sys.h"
+#include "uv_irq.h"
+
+#define BAUD_MARK   0xcafe0042UL    // The next word to scratch is the baud rate of UART BFM.
+#define BAUD_NUM    3
+#define BURST_NUM   3
+#define MAX_BURST   250
+#define TMO_BITS    20              // 2 idle characters.
+
+static const uint32_t bauds[BAUD_NUM] = {
+    UART_BAUD_RATE_3000000,
+    UART_BAUD_RATE_6000000,
+    UART_BAUD_RATE_12000000
+};
+
+// Not multiples of any queue threshold.
+static const uint32_t burst_lens[BURST_NUM] = {17, 100, MAX_BURST};
+
+static uint8_t send_buf[MAX_BURST];
+static uint8_t data_buf[MAX_BURST];
+volatile uint8_t *recv_buf = data_buf;
+volatile uint32_t recv_cnt = 0;
+volatile uint32_t irq_cnt = 0;
+
+static inline uint32_t get_cycle() {
+    return read_csr(mcycle);
+}
+
+static void set_baud(uint32_t baud) {
+    uv_uart_init(true, true, baud);
+    UART->txq_clr = 1;
+    UART->rxq_clr = 1;
+    STORE_WORD(REG_SLC_SCRATCH, BAUD_MARK);
+    STORE_WORD(REG_SLC_SCRATCH, baud);
+    printf("UART at %d baud: CLK_DIV = %d, BAUD_CFG = 0x%06x.\n",
+           baud, (int) ((UART->glb_cfg & UART_CLK_DIV_MASK) >> UART_CLK_DIV_OFFSET), UART->baud_cfg);
+}
+
+// Echo a burst through UART BFM, which is drained by RX timeout IRQs.
+static uint32_t run_burst(uint32_t baud, uint32_t len, uint32_t seed) {
+    uint32_t fail_cnt = 0;
+    uint32_t cyc = 0;
+    uint32_t kbps = 0;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        send_buf[i] = seed + i * 13;
+        recv_buf[i] = 0;
+    }
+    recv_cnt = 0;
+    irq_cnt = 0;
+
+    cyc = get_cycle();
+    uv_uart_send_data(send_buf, len);
+    while (recv_cnt < len) {
+        ;
+    }
+    cyc = get_cycle() - cyc;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        if (recv_buf[i] != send_buf[i]) {
+            ++fail_cnt;
+        }
+    }
+
+    // Bits per byte are 10 with 8 data bits & 1 stop bit.
+    kbps = len * 10 * (MAIN_CLK_FREQ / 1000) / cyc;
+    printf("  %d bytes: %d cycles, %d kbps, %d%% of line rate, %d IRQs, %d errors, %s.\n",
+           len, cyc, kbps, kbps * 100 / (baud / 1000), irq_cnt, fail_cnt,
+           (fail_cnt == 0) && (irq_cnt == 1) ? "PASS" : "FAIL");
+    return fail_cnt;
+}
+
+int main() {
+    uint32_t irq_priority = 7;
+    uint32_t irq_trigger = 0;
+    uint32_t fail_cnt = 0;
+
+    // Config interrupt.
+    uv_enable_glb_irq();
+    uv_enable_ext_irq();
+    uv_config_ext_irq(UART_IRQ, irq_priority, irq_trigger);
+    uv_set_target_threshold(0);
+    SET_EXT_IE(UART_IRQ);
+
+    for (int i = 0; i < BAUD_NUM; ++i) {
+        set_baud(bauds[i]);
+        uv_uart_set_rx_tmo(true, TMO_BITS);
+        for (int j = 0; j < BURST_NUM; ++j) {
+            fail_cnt += run_burst(bauds[i], burst_lens[j], i * BURST_NUM + j);
+        }
+        uv_uart_set_rx_tmo(false, 0);
+    }
+
+    if (fail_cnt > 0) {
+        printf("Data check failed!\n");
+    } else {
+        printf("Data check passed!\n");
+    }
+
+    return 0;
+}
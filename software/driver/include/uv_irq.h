@@ -23,10 +23,11 @@
 #define REG_EXT_TG_NUM      (EXT_IRQ_NUM)
 #define REG_EXT_TG_END      (REG_EXT_TG_START + (REG_EXT_TG_NUM << 2) - 4)
 
-#define GET_EXT_IP(i)       (LOAD_WORD(REG_EXT_IP_START + i/8) >> (i%32))
-#define GET_EXT_IE(i)       (LOAD_WORD(REG_EXT_IE_START + i/8) >> (i%32))
-#define SET_EXT_IE(i)       (STORE_WORD(REG_EXT_IE_START + i/8, GET_EXT_IE(i) |  (1 << (i%32))))
-#define CLR_EXT_IE(i)       (STORE_WORD(REG_EXT_IE_START + i/8, GET_EXT_IE(i) & ~(1 << (i%32))))
+// IP & IE bits by bit-band alias, so IE is changed without read-modify-write.
+#define GET_EXT_IP(i)       (SLC_BB(REG_EXT_IP_START + ((i) / 32) * 4, (i) % 32))
+#define GET_EXT_IE(i)       (SLC_BB(REG_EXT_IE_START + ((i) / 32) * 4, (i) % 32))
+#define SET_EXT_IE(i)       (SLC_BB(REG_EXT_IE_START + ((i) / 32) * 4, (i) % 32) = 1)
+#define CLR_EXT_IE(i)       (SLC_BB(REG_EXT_IE_START + ((i) / 32) * 4, (i) % 32) = 0)
 
 #define GET_EXT_PR(i)       (LOAD_WORD(REG_EXT_PR_START + (i << 2)))
 #define GET_EXT_TG(i)       (LOAD_WORD(REG_EXT_TG_START + (i << 2)))
@@ -39,7 +40,10 @@
 #define I2C_IRQ             3
 #define TMR_IRQ             4
 #define WDT_IRQ             5
+#define PWM_IRQ             6
 #define GPIO_IRQ(g)         (8 + g)
+#define QSPI_IRQ            40
+#define DMA_IRQ             41
 
 // Core-level IRQ control.
 static inline void uv_enable_glb_irq() {
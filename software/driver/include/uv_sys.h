@@ -36,6 +36,8 @@ typedef struct {
     volatile uint32_t sys_icg;
     volatile uint32_t scratch;
     volatile uint32_t gpio_mode;
+    volatile uint32_t bus_qos;
+    volatile uint32_t tmr_vals;
 } slc_type;
 
 #define REG_SLC_BASE            0x08000000UL
@@ -51,6 +53,21 @@ typedef struct {
 #define REG_SLC_SYS_ICG         0x08000024UL
 #define REG_SLC_SCRATCH         0x08000028UL
 #define REG_SLC_GPIO_MODE       0x0800002CUL
+#define REG_SLC_BUS_QOS         0x08000030UL
+#define REG_SLC_TMR_VALS        0x08000034UL    // Upper half latched by reading TMR_VAL.
+#define REG_SLC_HART_CMP        0x08000400UL    // + 8 * hart, for harts of cluster.
+#define REG_SLC_HART_CMPH       0x08000404UL
+
+// Bit-band alias: a word per bit of registers up to EXT_IE except IRQ_CLAIM.
+#define REG_SLC_BB_BASE         0x08008000UL
+#define SLC_BB(reg, bit)        (*((volatile uint32_t *) (REG_SLC_BB_BASE + (((reg) - REG_SLC_BASE) << 5) + ((bit) << 2))))
+
+// Core-local window of SLC registers, bypassing the device bus.
+#define REG_LCL_BASE            0x02000000UL
+#define REG_LCL_BB_BASE         0x02008000UL
+#define LCL_BB(reg, bit)        (*((volatile uint32_t *) (REG_LCL_BB_BASE + (((reg) - REG_SLC_BASE) << 5) + ((bit) << 2))))
+#define REG_LCL_HART_CMP        0x02000400UL
+#define REG_LCL_HART_CMPH       0x02000404UL
 
 #define SLC_TMR_CNT_EN_MASK     0x1UL
 #define SLC_TMR_CNT_EN_OFFSET   0
@@ -59,6 +76,14 @@ typedef struct {
 #define SLC_TMR_CLK_DIV_MASK    0xFFFF0000UL
 #define SLC_TMR_CLK_DIV_OFFSET  16
 
+// Devbus masters: 0 core fetch, 1 core data, 2 DMA, 3 debugger.
+#define SLC_QOS_CLS_MASK        0x3UL           // << 2 * master
+#define SLC_QOS_CLS_OFFSET      0
+#define SLC_QOS_LIM_MASK        0xFF00UL
+#define SLC_QOS_LIM_OFFSET      8
+#define SLC_QOS_WGT_MASK        0xFUL           // << 4 * master
+#define SLC_QOS_WGT_OFFSET      16
+
 //************************************************************
 // GPIO.
 typedef struct {
@@ -70,6 +95,15 @@ typedef struct {
     volatile uint32_t out_enable;
     volatile uint32_t irq_pend;
     volatile uint32_t irq_enable;
+    volatile uint32_t out_set;
+    volatile uint32_t out_clr;
+    volatile uint32_t out_tgl;
+    volatile uint32_t oe_set;
+    volatile uint32_t oe_clr;
+    volatile uint32_t oe_tgl;
+    volatile uint32_t irq_en_set;
+    volatile uint32_t irq_en_clr;
+    volatile uint32_t irq_en_tgl;
 } gpio_type;
 
 #define REG_GPIO_BASE           0x70000000UL
@@ -81,6 +115,19 @@ typedef struct {
 #define REG_GPIO_OUT_ENABLE     0x70000014UL
 #define REG_GPIO_IRQ_PEND       0x70000018UL
 #define REG_GPIO_IRQ_ENABLE     0x7000001CUL
+#define REG_GPIO_OUT_SET        0x70000020UL    // Bits written 1 are set.
+#define REG_GPIO_OUT_CLR        0x70000024UL    // Bits written 1 are cleared.
+#define REG_GPIO_OUT_TGL        0x70000028UL    // Bits written 1 are toggled.
+#define REG_GPIO_OE_SET         0x7000002CUL
+#define REG_GPIO_OE_CLR         0x70000030UL
+#define REG_GPIO_OE_TGL         0x70000034UL
+#define REG_GPIO_IRQ_EN_SET     0x70000038UL
+#define REG_GPIO_IRQ_EN_CLR     0x7000003CUL
+#define REG_GPIO_IRQ_EN_TGL     0x70000040UL
+
+// Bit-band alias: a word per bit of the first 8 registers, bit 0 read or written.
+#define REG_GPIO_BB_BASE        0x70000400UL
+#define GPIO_BB(reg, bit)       (*((volatile uint32_t *) (REG_GPIO_BB_BASE + (((reg) - REG_GPIO_BASE) << 5) + ((bit) << 2))))
 
 //************************************************************
 // UART.
@@ -98,6 +145,11 @@ typedef struct {
     volatile uint32_t ip;
     volatile uint32_t tx_irq_th;
     volatile uint32_t rx_irq_th;
+    volatile uint32_t txq_free;
+    volatile uint32_t txq_wdat;
+    volatile uint32_t rxq_wdat;
+    volatile uint32_t dma_cfg;
+    volatile uint32_t baud_cfg;
 } uart_type;
 
 #define REG_UART_BASE           0x70001000UL
@@ -114,6 +166,11 @@ typedef struct {
 #define REG_UART_IP             0x70001028UL
 #define REG_UART_TX_IRQ_TH      0x7000102CUL
 #define REG_UART_RX_IRQ_TH      0x70001030UL
+#define REG_UART_TXQ_FREE       0x70001034UL
+#define REG_UART_TXQ_WDAT       0x70001038UL
+#define REG_UART_RXQ_WDAT       0x7000103CUL
+#define REG_UART_DMA_CFG        0x70001040UL
+#define REG_UART_BAUD_CFG       0x70001044UL
 
 #define UART_TX_EN_MASK         0x1UL
 #define UART_TX_EN_OFFSET       0
@@ -134,6 +191,29 @@ typedef struct {
 
 #define UART_TX_IRQ_MASK        0x1
 #define UART_RX_IRQ_MASK        0x2
+#define UART_RX_TMO_IRQ_MASK    0x4
+
+#define UART_TX_DMA_EN_MASK     0x1UL
+#define UART_RX_DMA_EN_MASK     0x2UL
+#define UART_TX_DMA_TH_MASK     0xFF00UL
+#define UART_TX_DMA_TH_OFFSET   8
+#define UART_RX_DMA_TH_MASK     0xFF0000UL
+#define UART_RX_DMA_TH_OFFSET   16
+
+#define UART_DIV_FRAC_MASK      0xFFUL
+#define UART_DIV_FRAC_OFFSET    0
+#define UART_OSR_MASK           0x300UL
+#define UART_OSR_OFFSET         8
+#define UART_RX_TMO_MASK        0xFF0000UL
+#define UART_RX_TMO_OFFSET      16
+
+#define UART_OSR_16X            0
+#define UART_OSR_8X             1
+#define UART_OSR_4X             2
+
+// DMA handshake lines.
+#define UART_TX_DMA_HS          0
+#define UART_RX_DMA_HS          1
 
 #define UART_BAUD_RATE_1200     1200
 #define UART_BAUD_RATE_2400     2400
@@ -146,6 +226,9 @@ typedef struct {
 #define UART_BAUD_RATE_230400   230400
 #define UART_BAUD_RATE_460800   460800
 #define UART_BAUD_RATE_921600   921600
+#define UART_BAUD_RATE_3000000  3000000
+#define UART_BAUD_RATE_6000000  6000000
+#define UART_BAUD_RATE_12000000 12000000
 
 #define UART_PARITY_TYPE_SPACE  0
 #define UART_PARITY_TYPE_MARK   1
@@ -155,7 +238,7 @@ typedef struct {
 #define UART_LITTLE_ENDIAN      0
 #define UART_BIG_ENDIAN         1
 
-#define UART_MAX_QLEN           8
+#define UART_MAX_QLEN           256
 #define UART_DEFAULT_ENDIAN     UART_LITTLE_ENDIAN
 #define UART_DEFAULT_NUM_BITS   8   // 5 ~ 8
 #define UART_DEFAULT_NUM_STOPS  1   // 1 or 2
@@ -164,7 +247,7 @@ typedef struct {
 // I2C.
 typedef struct {
     volatile uint32_t glb_cfg;
-    volatile uint32_t nframes;
+    volatile uint32_t scl_lo;
     volatile uint32_t start;
     volatile uint32_t busy;
     volatile uint32_t txq_cap;
@@ -183,7 +266,7 @@ typedef struct {
 
 #define REG_I2C_BASE        0x70002000UL
 #define REG_I2C_GLB_CFG     0x70002000UL
-#define REG_I2C_NFRAMES     0x70002004UL
+#define REG_I2C_SCL_LO      0x70002004UL
 #define REG_I2C_START       0x70002008UL
 #define REG_I2C_BUSY        0x7000200CUL
 #define REG_I2C_TXQ_CAP     0x70002010UL
@@ -204,6 +287,37 @@ typedef struct {
 #define I2C_CLK_DIV_MASK    0xFFFF0000UL
 #define I2C_CLK_DIV_OFFSET  16
 
+#define I2C_BUSY_MASK       0x1
+#define I2C_HOLD_MASK       0x2
+
+#define I2C_TX_IRQ_MASK     0x1
+#define I2C_RX_IRQ_MASK     0x2
+#define I2C_NACK_IRQ_MASK   0x4
+#define I2C_NSCL_IRQ_MASK   0x8
+#define I2C_DONE_IRQ_MASK   0x10
+
+// Commands of the sequencer in TXQ.
+#define I2C_CMD_DAT_MASK    0xFFUL
+#define I2C_CMD_OP_OFFSET   8
+#define I2C_CMD_START       0   // (Repeated) START & address byte.
+#define I2C_CMD_WRITE       1   // Byte to write.
+#define I2C_CMD_READ        2   // DAT + 1 bytes to read, NACK at last.
+#define I2C_CMD_STOP        3
+#define I2C_CMD(op, dat)    (((op) << I2C_CMD_OP_OFFSET) | ((dat) & I2C_CMD_DAT_MASK))
+#define I2C_MAX_RD_LEN      256
+
+// Timing at MAIN_CLK_FREQ of 100MHz: standard, fast & fast-mode plus.
+#define I2C_SM_CLK_DIV      1000
+#define I2C_SM_SCL_LO       0
+#define I2C_FM_CLK_DIV      250
+#define I2C_FM_SCL_LO       140
+#define I2C_FMP_CLK_DIV     100
+#define I2C_FMP_SCL_LO      52
+#define I2C_DEFAULT_SDA_DLY 10
+
+#define I2C_ERR_NACK        -1
+#define I2C_ERR_NSCL        -2
+
 //************************************************************
 // SPI.
 typedef struct {
@@ -234,6 +348,27 @@ typedef struct {
     unsigned int clk_div : 16;
 } spi_cfg;
 
+// Transfer descriptor of SPI0 & SPI1 after the common registers,
+// which are taken by XIP in QSPI. A write to LEN starts sending
+// CMD, ADDR_NB bytes of ADDR & DMY_NC dummy cycles, then LEN data
+// bytes, 4 per queue word in the order of addresses, all in one
+// CS assertion.
+typedef struct {
+    volatile uint32_t cfg;
+    volatile uint32_t addr;
+    volatile uint32_t len;
+    volatile uint32_t dma_cfg;
+} spi_desc_type;
+
+typedef struct {
+    unsigned int cmd : 8;
+    unsigned int cmd_en : 1;
+    unsigned int addr_nb : 3;
+    unsigned int dmy_nc : 6;
+    unsigned int data_rx : 1;
+    unsigned int resv : 13;
+} spi_desc;
+
 #define SPI0_ID             0
 #define SPI1_ID             1
 
@@ -254,6 +389,10 @@ typedef struct {
 #define REG_SPI0_IP         0x70003034UL
 #define REG_SPI0_TX_IRQ_TH  0x70003038UL
 #define REG_SPI0_RX_IRQ_TH  0x7000303CUL
+#define REG_SPI0_DESC_CFG   0x70003040UL
+#define REG_SPI0_DESC_ADDR  0x70003044UL
+#define REG_SPI0_DESC_LEN   0x70003048UL
+#define REG_SPI0_DMA_CFG    0x7000304CUL
 
 #define REG_SPI1_BASE       0x70004000UL
 #define REG_SPI1_GLB_CFG    0x70004000UL
@@ -272,6 +411,10 @@ typedef struct {
 #define REG_SPI1_IP         0x70004034UL
 #define REG_SPI1_TX_IRQ_TH  0x70004038UL
 #define REG_SPI1_RX_IRQ_TH  0x7000403CUL
+#define REG_SPI1_DESC_CFG   0x70004040UL
+#define REG_SPI1_DESC_ADDR  0x70004044UL
+#define REG_SPI1_DESC_LEN   0x70004048UL
+#define REG_SPI1_DMA_CFG    0x7000404CUL
 
 #define SPI_CPOL_MASK       0x1
 #define SPI_CPOL_OFFSET     0
@@ -288,6 +431,23 @@ typedef struct {
 
 #define SPI_TX_IRQ_MASK     0x1
 #define SPI_RX_IRQ_MASK     0x2
+#define SPI_DONE_IRQ_MASK   0x4
+
+#define SPI_DESC_LEN_MASK   0xFFFFFFUL
+#define SPI_DESC_BUSY_MASK  0x80000000UL
+
+#define SPI_TX_DMA_EN_MASK  0x1UL
+#define SPI_RX_DMA_EN_MASK  0x2UL
+#define SPI_TX_DMA_TH_MASK  0xFF00UL
+#define SPI_TX_DMA_TH_OFFSET 8
+#define SPI_RX_DMA_TH_MASK  0xFF0000UL
+#define SPI_RX_DMA_TH_OFFSET 16
+
+// DMA handshake lines.
+#define SPI0_TX_DMA_HS      2
+#define SPI0_RX_DMA_HS      3
+#define SPI1_TX_DMA_HS      4
+#define SPI1_RX_DMA_HS      5
 
 #define SPI_UNIT_LEN_8BITS  7
 #define SPI_UNIT_LEN_16BITS 15
@@ -298,6 +458,117 @@ typedef struct {
 
 #define SPI_DEFAULT_CS_IDLE 0xF
 
+//************************************************************
+// QSPI with XIP. The lower registers are the same as SPI,
+// which are driven in register mode while XIP is disabled.
+typedef struct {
+    spi_type          spi;
+    volatile uint32_t xip_cfg;
+    volatile uint32_t xip_ctrl;
+    volatile uint32_t xip_stat;
+    volatile uint32_t xip_hit_cnt;
+    volatile uint32_t xip_miss_cnt;
+    volatile uint32_t xip_fill_cnt;
+} qspi_type;
+
+#define QSPI_ID             2
+
+#define REG_QSPI_BASE       0x70020000UL
+#define REG_QSPI_XIP_CFG    0x70020040UL
+#define REG_QSPI_XIP_CTRL   0x70020044UL
+#define REG_QSPI_XIP_STAT   0x70020048UL
+#define REG_QSPI_HIT_CNT    0x7002004CUL
+#define REG_QSPI_MISS_CNT   0x70020050UL
+#define REG_QSPI_FILL_CNT   0x70020054UL
+
+#define XIP_EN_MASK         0x1UL
+#define XIP_EN_OFFSET       0
+#define XIP_CONT_EN_MASK    0x2UL
+#define XIP_CONT_EN_OFFSET  1
+#define XIP_PF_EN_MASK      0x4UL
+#define XIP_PF_EN_OFFSET    2
+#define XIP_DUMMY_MASK      0xF0UL
+#define XIP_DUMMY_OFFSET    4
+#define XIP_CMD_MASK        0xFF00UL
+#define XIP_CMD_OFFSET      8
+#define XIP_MODE_MASK       0xFF0000UL
+#define XIP_MODE_OFFSET     16
+#define XIP_CLK_DIV_MASK    0xFF000000UL
+#define XIP_CLK_DIV_OFFSET  24
+
+#define XIP_INV_MASK        0x1UL
+#define XIP_CNT_CLR_MASK    0x2UL
+
+#define XIP_BUSY_MASK       0x1UL
+#define XIP_CONT_ACT_MASK   0x2UL
+
+//************************************************************
+// DMA. Each channel moves LEN elements from SRC to DST, then
+// loads the next descriptor from NEXT unless it is zero.
+typedef struct {
+    volatile uint32_t cfg;
+    volatile uint32_t src;
+    volatile uint32_t dst;
+    volatile uint32_t ctrl;
+    volatile uint32_t next;
+    volatile uint32_t resv[3];
+} dma_ch_type;
+
+typedef struct {
+    volatile uint32_t ip;
+    volatile uint32_t ie;
+    volatile uint32_t busy;
+    volatile uint32_t resv[5];
+    dma_ch_type       ch[4];
+} dma_type;
+
+// Descriptor in memory, which must be word-aligned.
+typedef struct dma_desc {
+    uint32_t src;
+    uint32_t dst;
+    uint32_t ctrl;
+    struct dma_desc *next;
+} dma_desc;
+
+#define DMA_CH_NUM          4
+#define DMA_HS_NUM          16
+
+#define REG_DMA_BASE        0x70010000UL
+#define REG_DMA_IP          0x70010000UL
+#define REG_DMA_IE          0x70010004UL
+#define REG_DMA_BUSY        0x70010008UL
+#define REG_DMA_CH_BASE(c)  (0x70010020UL + ((c) << 5))
+
+#define DMA_CH_EN_MASK      0x1UL
+#define DMA_CH_EN_OFFSET    0
+#define DMA_CH_HS_EN_MASK   0x2UL
+#define DMA_CH_HS_EN_OFFSET 1
+#define DMA_CH_HS_SEL_MASK  0xF00UL
+#define DMA_CH_HS_SEL_OFFSET 8
+
+#define DMA_LEN_MASK        0xFFFFUL
+#define DMA_LEN_OFFSET      0
+#define DMA_SIZE_MASK       0x30000UL
+#define DMA_SIZE_OFFSET     16
+#define DMA_SRC_INC_MASK    0x40000UL
+#define DMA_SRC_INC_OFFSET  18
+#define DMA_DST_INC_MASK    0x80000UL
+#define DMA_DST_INC_OFFSET  19
+#define DMA_BURST_MASK      0x700000UL
+#define DMA_BURST_OFFSET    20
+#define DMA_INT_MASK        0x1000000UL
+#define DMA_INT_OFFSET      24
+
+#define DMA_DONE_IRQ_MASK(c) (0x1UL << (c))
+#define DMA_ERR_IRQ_MASK(c) (0x10000UL << (c))
+
+#define DMA_SIZE_BYTE       0
+#define DMA_SIZE_HALF       1
+#define DMA_SIZE_WORD       2
+
+#define DMA_MAX_LEN         65535
+#define DMA_MAX_BURST       4   // 2^4 elements.
+
 //************************************************************
 // General timer & watch dog.
 typedef struct {
@@ -328,6 +599,64 @@ typedef struct {
 #define TMR_CLK_DIV_MASK    0xFFFF0000UL
 #define TMR_CLK_DIV_OFFSET  16
 
+// PWM & input capture of general timer, at sys clock.
+typedef struct {
+    volatile uint32_t cfg;
+    volatile uint32_t prd;
+    volatile uint32_t cnt;
+    volatile uint32_t out;
+    volatile uint32_t duty[4];
+    volatile uint32_t cap_cfg;
+    volatile uint32_t cap_sta;
+    volatile uint32_t cap_dat[4];
+    volatile uint32_t ie;
+    volatile uint32_t ip;
+} pwm_type;
+
+#define REG_PWM_BASE        0x70005040UL
+#define REG_PWM_CFG         0x70005040UL
+#define REG_PWM_PRD         0x70005044UL
+#define REG_PWM_CNT         0x70005048UL
+#define REG_PWM_OUT         0x7000504CUL
+#define REG_PWM_DUTY0       0x70005050UL
+#define REG_CAP_CFG         0x70005060UL
+#define REG_CAP_STA         0x70005064UL
+#define REG_CAP_DAT0        0x70005068UL
+#define REG_PWM_IE          0x70005078UL
+#define REG_PWM_IP          0x7000507CUL
+
+#define PWM_CH_NUM          4   // PWM n on GPIO 16 + 2n (P) & 17 + 2n (N).
+#define CAP_CH_NUM          2   // Capture n on GPIO 24 + n.
+#define CAP_QUE_DEPTH       8
+
+#define PWM_EN_MASK         0x1UL
+#define PWM_CENTER_MASK     0x2UL
+#define PWM_UPD_MASK        0x4UL   // Load shadow period & duties at the end of period.
+#define PWM_DEAD_MASK       0xFF00UL
+#define PWM_DEAD_OFFSET     8
+#define PWM_CLK_DIV_MASK    0xFFFF0000UL
+#define PWM_CLK_DIV_OFFSET  16
+
+#define PWM_CNT_DOWN_MASK   0x10000UL
+#define PWM_OUT_P(c)        (0x1UL << ((c) * 2))
+#define PWM_OUT_N(c)        (0x2UL << ((c) * 2))
+#define PWM_POL_OFFSET      8
+
+#define CAP_EDGE_RISE       1
+#define CAP_EDGE_FALL       2
+#define CAP_EDGE_BOTH       3
+#define CAP_TH_MASK         0xFF0000UL
+#define CAP_TH_OFFSET       16
+#define CAP_LEN(sta, c)     (((sta) >> ((c) * 4)) & 0xFUL)
+#define CAP_OVF_MASK(c)     (0x10000UL << (c))
+#define CAP_CLR_MASK(c)     (0x1000000UL << (c))
+#define CAP_LEVEL_MASK      0x80000000UL
+#define CAP_TS_MASK         0x7FFFFFFFUL
+
+#define PWM_PRD_IRQ_MASK    0x1UL
+#define CAP_IRQ_MASK        0x2UL
+#define CAP_OVF_IRQ_MASK    0x4UL
+
 //************************************************************
 // Debugger.
 typedef struct {
@@ -336,6 +665,195 @@ typedef struct {
 
 #define REG_DBG_BASE        0x70007000UL
 
+//************************************************************
+// CRC, sharing the slot of debugger.
+typedef struct {
+    volatile uint32_t cfg;
+    volatile uint32_t poly;
+    volatile uint32_t init;
+    volatile uint32_t xorout;
+    volatile uint32_t dat;
+    volatile uint32_t res;
+} crc_type;
+
+#define REG_CRC_BASE        0x70007400UL
+#define REG_CRC_CFG         0x70007400UL
+#define REG_CRC_POLY        0x70007404UL
+#define REG_CRC_INIT        0x70007408UL    // A write restarts from init.
+#define REG_CRC_XOR         0x7000740CUL
+#define REG_CRC_DAT         0x70007410UL    // Bytes written are fed low byte first.
+#define REG_CRC_RES         0x70007414UL
+
+#define CRC_DMA_HS          8
+
+#define CRC_MSB_MASK        0x1FUL          // Width - 1.
+#define CRC_REF_IN_MASK     0x100UL
+#define CRC_REF_OUT_MASK    0x200UL
+#define CRC_DMA_EN_MASK     0x10000UL
+
+typedef struct {
+    uint32_t width;
+    uint32_t poly;
+    uint32_t init;
+    uint32_t xorout;
+    bool ref_in;
+    bool ref_out;
+} crc_cfg;
+
+#define CRC32_CFG           {32, 0x04C11DB7UL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, true, true}
+#define CRC16_CCITT_CFG     {16, 0x1021UL, 0xFFFFUL, 0x0UL, false, false}
+
+//************************************************************
+// Event router, sharing the slot of debugger.
+typedef struct {
+    volatile uint32_t ch[8];
+    volatile uint32_t sw;
+    volatile uint32_t hit;
+} evt_type;
+
+#define REG_EVT_BASE        0x70007800UL
+#define REG_EVT_CH0         0x70007800UL
+#define REG_EVT_SW          0x70007820UL
+#define REG_EVT_HIT         0x70007824UL
+
+#define EVT_CH_NUM          8
+
+#define EVT_SEL_MASK        0x3FUL
+#define EVT_TASK_MASK       0xF00UL
+#define EVT_TASK_OFFSET     8
+#define EVT_PARAM_MASK      0x1F0000UL
+#define EVT_PARAM_OFFSET    16
+#define EVT_EN_MASK         0x80000000UL
+
+// Events: rising edges of IRQs & GPIO inputs, or pulses.
+#define EVT_NONE            0
+#define EVT_SW              1
+#define EVT_TMR             2
+#define EVT_PWM_PRD         3
+#define EVT_UART            4
+#define EVT_SPI0_DONE       5
+#define EVT_SPI1_DONE       6
+#define EVT_I2C             7
+#define EVT_GPIO(n)         (8 + (n))
+
+// Tasks, with GPIO pin or DMA request line as parameter.
+#define TASK_NONE           0
+#define TASK_TMR_START      1
+#define TASK_TMR_STOP       2
+#define TASK_PWM_START      3
+#define TASK_PWM_STOP       4
+#define TASK_SPI0_START     5   // Restart the last descriptor.
+#define TASK_SPI1_START     6
+#define TASK_GPIO_SET       7
+#define TASK_GPIO_CLR       8
+#define TASK_GPIO_TGL       9
+#define TASK_DMA_REQ        10  // Request a burst on EVT_DMA_HS(param).
+
+#define EVT_DMA_HS(n)       (6 + (n))
+
+//************************************************************
+// DSP accelerator on devbus, filtering 16-bit samples from DSP_IN
+// to DSP_OUT by FIR of up to 64 taps or up to 8 cascaded biquads.
+typedef struct {
+    volatile uint32_t cfg;
+    volatile uint32_t ctrl;
+    volatile uint32_t stat;
+    volatile uint32_t dma;
+    volatile uint32_t in;
+    volatile uint32_t out;
+} dsp_type;
+
+#define REG_DSP_BASE        0x70030000UL
+#define REG_DSP_CFG         0x70030000UL
+#define REG_DSP_CTRL        0x70030004UL
+#define REG_DSP_STAT        0x70030008UL
+#define REG_DSP_DMA         0x7003000CUL
+#define REG_DSP_IN          0x70030010UL
+#define REG_DSP_OUT         0x70030014UL    // Sign-extended.
+#define REG_DSP_COEF        0x70031000UL    // 2 coefficients per word.
+
+#define DSP_TAP_NUM         64
+#define DSP_BIQ_NUM         8
+#define DSP_FIFO_DEPTH      16
+
+#define DSP_IN_DMA_HS       9
+#define DSP_OUT_DMA_HS      10
+
+#define DSP_MODE_MASK       0x1UL
+#define DSP_LEN_MASK        0x3F00UL        // Taps or sections - 1.
+#define DSP_LEN_OFFSET      8
+#define DSP_SHIFT_MASK      0x1F0000UL
+#define DSP_SHIFT_OFFSET    16
+#define DSP_EN_MASK         0x80000000UL
+#define DSP_CLR_MASK        0x1UL           // Clear delay line & FIFOs.
+#define DSP_BUSY_MASK       0x1UL
+#define DSP_IN_LEN_MASK     0x1F00UL
+#define DSP_IN_LEN_OFFSET   8
+#define DSP_OUT_LEN_MASK    0x1F0000UL
+#define DSP_OUT_LEN_OFFSET  16
+#define DSP_IN_DMA_EN_MASK  0x1UL
+#define DSP_OUT_DMA_EN_MASK 0x2UL
+#define DSP_IN_DMA_TH_MASK  0xFF00UL
+#define DSP_IN_DMA_TH_OFFSET  8
+#define DSP_OUT_DMA_TH_MASK 0xFF0000UL
+#define DSP_OUT_DMA_TH_OFFSET 16
+
+#define DSP_MODE_FIR        0
+#define DSP_MODE_BIQ        1
+
+// Biquad section: y = (b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2) >> shift,
+// with a1 & a2 other than -32768.
+typedef struct {
+    int16_t b0;
+    int16_t b1;
+    int16_t b2;
+    int16_t a1;
+    int16_t a2;
+} dsp_biq;
+
+//************************************************************
+// GEMM accelerator on devbus, multiplying tiles of int8, int16 or
+// int32 matrices into int32 with a 4x4 array of MACs.
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t stat;
+    volatile uint32_t cfg;
+    volatile uint32_t dim;
+    volatile uint32_t a_ofs;
+    volatile uint32_t b_ofs;
+    volatile uint32_t c_ofs;
+    volatile uint32_t cyc;
+} gemm_type;
+
+#define REG_GEMM_BASE       0x70040000UL
+#define REG_GEMM_CTRL       0x70040000UL
+#define REG_GEMM_STAT       0x70040004UL
+#define REG_GEMM_CFG        0x70040008UL
+#define REG_GEMM_DIM        0x7004000CUL
+#define REG_GEMM_A_OFS      0x70040010UL
+#define REG_GEMM_B_OFS      0x70040014UL
+#define REG_GEMM_C_OFS      0x70040018UL
+#define REG_GEMM_CYC        0x7004001CUL    // Cycles of the last run.
+#define REG_GEMM_A          0x70044000UL    // A tile in panels of 4 rows.
+#define REG_GEMM_B          0x70048000UL    // B tile in panels of 4 columns.
+#define REG_GEMM_C          0x7004C000UL    // C tile in row-major int32.
+
+#define GEMM_TILE_BYTES     4096
+
+#define GEMM_START_MASK     0x1UL
+#define GEMM_BUSY_MASK      0x1UL
+#define GEMM_DONE_MASK      0x2UL           // Sticky, cleared by writing 1.
+#define GEMM_TYPE_MASK      0x3UL
+#define GEMM_ACC_MASK       0x10UL          // C += A * B.
+#define GEMM_DONE_IE_MASK   0x100UL
+#define GEMM_M_OFFSET       0               // Multiple of 4.
+#define GEMM_N_OFFSET       8               // Multiple of 4.
+#define GEMM_K_OFFSET       16
+
+#define GEMM_INT8           0
+#define GEMM_INT16          1
+#define GEMM_INT32          2
+
 //************************************************************
 // Memories.
 #define ROM_START_ADDR      0x04000000UL
@@ -347,17 +865,37 @@ typedef struct {
 #define EFLASH_START_ADDR   0x20000000UL
 #define EFLASH_BYTE_LENGTH  1048576
 
+#define XIP_START_ADDR      0x30000000UL
+#define XIP_BYTE_LENGTH     16777216
+
+#define EXT_MEM_START_ADDR  0x90000000UL
+#define EXT_MEM_BYTE_LENGTH 33554432
+
 //************************************************************
 // Device declarations.
 #define SLC                 ((slc_type  *) REG_SLC_BASE )
+#define LCL                 ((slc_type  *) REG_LCL_BASE )
 #define GPIO                ((gpio_type *) REG_GPIO_BASE)
 #define UART                ((uart_type *) REG_UART_BASE)
 #define I2C                 ((i2c_type  *) REG_I2C_BASE )
 #define SPI0                ((spi_type  *) REG_SPI0_BASE)
 #define SPI1                ((spi_type  *) REG_SPI1_BASE)
+#define SPI0_DESC           ((spi_desc_type *) REG_SPI0_DESC_CFG)
+#define SPI1_DESC           ((spi_desc_type *) REG_SPI1_DESC_CFG)
+#define QSPI                ((qspi_type *) REG_QSPI_BASE)
+#define DMA                 ((dma_type  *) REG_DMA_BASE )
 #define TMR                 ((tmr_type  *) REG_TMR_BASE )
+#define PWM                 ((pwm_type  *) REG_PWM_BASE )
 #define WDT                 ((tmr_type  *) REG_WDT_BASE )
 #define DBG                 ((dbg_type  *) REG_DBG_BASE )
+#define CRC                 ((crc_type  *) REG_CRC_BASE )
+#define EVT                 ((evt_type  *) REG_EVT_BASE )
+#define DSP                 ((dsp_type  *) REG_DSP_BASE )
+#define DSP_COEF            ((volatile uint32_t *) REG_DSP_COEF)
+#define GEMM                ((gemm_type *) REG_GEMM_BASE)
+#define GEMM_A              ((volatile uint32_t *) REG_GEMM_A)
+#define GEMM_B              ((volatile uint32_t *) REG_GEMM_B)
+#define GEMM_C              ((volatile int32_t  *) REG_GEMM_C)
 
 //************************************************************
 // Functions.
@@ -366,6 +904,13 @@ void uv_tmr_start();
 void uv_tmr_stop();
 void uv_tmr_set_val(uint64_t val);
 uint64_t uv_tmr_get_val();
+void uv_tmr_set_hart_cmp(uint32_t hart, uint64_t cmp);
+
+void uv_send_ipi(uint32_t hart);
+void uv_clr_ipi(uint32_t hart);
+
+void uv_bus_qos_set(uint32_t mst, uint32_t cls, uint32_t wgt);
+void uv_bus_qos_set_lim(uint32_t lim);
 
 void uv_sys_tmr_init(bool auto_clr, uint32_t clk_div, uint64_t cmp);
 void uv_sys_tmr_start();
@@ -379,6 +924,8 @@ void uv_uart_set_tx_irq(bool tx_ie, uint32_t tx_th);
 void uv_uart_set_rx_irq(bool rx_ie, uint32_t rx_th);
 void uv_uart_send_data(uint8_t *buf, size_t len);
 void uv_uart_recv_data(uint8_t *buf, size_t len);
+void uv_uart_set_dma(bool tx_en, uint32_t tx_th, bool rx_en, uint32_t rx_th);
+void uv_uart_set_rx_tmo(bool tmo_ie, uint32_t tmo_bits);
 
 void uv_spi_init(uint32_t idx, uint32_t cs_mask, bool rx_en, spi_cfg *cfg);
 void uv_spi_set_tx_irq(uint32_t idx, bool tx_ie, uint32_t tx_th);
@@ -389,5 +936,82 @@ void uv_spi_send_halfs(uint32_t idx, uint16_t *buf, size_t len);
 void uv_spi_recv_halfs(uint32_t idx, uint16_t *buf, size_t len);
 void uv_spi_send_words(uint32_t idx, uint32_t *buf, size_t len);
 void uv_spi_recv_words(uint32_t idx, uint32_t *buf, size_t len);
+void uv_spi_set_done_irq(uint32_t idx, bool done_ie);
+void uv_spi_clr_done_irq(uint32_t idx);
+void uv_spi_set_dma(uint32_t idx, bool tx_en, uint32_t tx_th, bool rx_en, uint32_t rx_th);
+void uv_spi_desc_start(uint32_t idx, spi_desc *desc, uint32_t addr, uint32_t len);
+bool uv_spi_desc_busy(uint32_t idx);
+void uv_spi_desc_wait(uint32_t idx);
+
+void uv_i2c_init(uint32_t clk_div, uint32_t scl_lo, uint32_t sda_dly);
+void uv_i2c_set_irq(bool done_ie, bool nack_ie);
+void uv_i2c_clr_irq();
+void uv_i2c_push_cmd(uint32_t op, uint32_t dat);
+void uv_i2c_start();
+bool uv_i2c_busy();
+int uv_i2c_status();
+int uv_i2c_xfer(uint32_t addr, uint8_t *wbuf, size_t wlen, uint8_t *rbuf, size_t rlen);
+
+void uv_qspi_xip_enable(bool cont_en, bool pf_en, uint32_t clk_div);
+void uv_qspi_xip_disable();
+void uv_qspi_xip_invalidate();
+
+uint32_t uv_dma_ctrl(uint32_t len, uint32_t size, bool src_inc, bool dst_inc, uint32_t burst);
+void uv_dma_set_desc(dma_desc *desc, uint32_t src, uint32_t dst, uint32_t ctrl, dma_desc *next);
+void uv_dma_set_handshake(uint32_t ch, bool hs_en, uint32_t hs_sel);
+void uv_dma_set_irq(uint32_t ch, bool done_ie, bool err_ie);
+void uv_dma_clr_irq(uint32_t ch);
+void uv_dma_start(uint32_t ch, uint32_t src, uint32_t dst, uint32_t ctrl);
+void uv_dma_start_chain(uint32_t ch, dma_desc *desc);
+void uv_dma_stop(uint32_t ch);
+bool uv_dma_busy(uint32_t ch);
+int uv_dma_wait(uint32_t ch);
+int uv_dma_memcpy(uint32_t ch, void *dst, const void *src, size_t len);
+
+void uv_pwm_init(uint32_t clk_div, uint32_t prd, bool center, uint32_t dead);
+void uv_pwm_set_duty(uint32_t ch, uint32_t duty);
+void uv_pwm_set_out(uint32_t oe, uint32_t pol);
+void uv_pwm_update();
+bool uv_pwm_update_busy();
+void uv_pwm_start();
+void uv_pwm_stop();
+void uv_pwm_set_irq(bool prd_ie);
+void uv_pwm_clr_irq();
+void uv_cap_init(uint32_t ch, uint32_t edge);
+void uv_cap_set_irq(bool cap_ie, uint32_t th);
+uint32_t uv_cap_len(uint32_t ch);
+size_t uv_cap_read(uint32_t ch, uint32_t *buf, size_t len);
+
+void uv_crc_init(const crc_cfg *cfg);
+void uv_crc_restart();
+void uv_crc_update(const void *buf, size_t len);
+uint32_t uv_crc_result();
+void uv_crc_set_dma(bool dma_en);
+
+void uv_evt_connect(uint32_t ch, uint32_t evt, uint32_t task, uint32_t param);
+void uv_evt_disconnect(uint32_t ch);
+void uv_evt_trigger();
+uint32_t uv_evt_hit();
+void uv_evt_clr_hit(uint32_t mask);
+
+void uv_dsp_set_fir(const int16_t *coef, uint32_t taps, uint32_t shift);
+void uv_dsp_set_biquad(const dsp_biq *sec, uint32_t num, uint32_t shift);
+void uv_dsp_enable(bool en);
+void uv_dsp_clear();
+bool uv_dsp_busy();
+void uv_dsp_run(const int16_t *in, int16_t *out, size_t len);
+void uv_dsp_set_dma(bool in_en, uint32_t in_th, bool out_en, uint32_t out_th);
+
+uint32_t uv_gemm_pack_a(uint32_t ofs, const void *a, size_t lda, uint32_t m, uint32_t k, uint32_t type);
+uint32_t uv_gemm_pack_b(uint32_t ofs, const void *b, size_t ldb, uint32_t k, uint32_t n, uint32_t type);
+void uv_gemm_start(uint32_t type, bool acc, uint32_t m, uint32_t n, uint32_t k,
+                   uint32_t a_ofs, uint32_t b_ofs, uint32_t c_ofs);
+bool uv_gemm_busy();
+uint32_t uv_gemm_wait();
+void uv_gemm_add_c(uint32_t c_ofs, int32_t *c, size_t ldc, uint32_t m, uint32_t n);
+uint32_t uv_gemm_mm(uint32_t type, size_t m, size_t n, size_t p,
+                    const void *a, size_t lda, const void *b, size_t ldb, int32_t *c, size_t ldc);
+void uv_gemm_set_irq(bool done_ie);
+void uv_gemm_clr_irq();
 
 #endif  // __UV_SYS__
@@ -14,6 +14,14 @@ __attribute__((weak)) void handle_tmr_irq(){};
 
 __attribute__((weak)) void handle_sft_irq(){};
 
+// Returns the PC to resume from, or exits by default.
+__attribute__((weak)) uintptr_t handle_excp(uintptr_t mcause, uintptr_t epc)
+{
+  write(1, "trap\n", 5);
+  _exit(1 + mcause);
+  return epc;
+}
+
 uintptr_t handle_trap(uintptr_t mcause, uintptr_t epc)
 {
   if (mcause & 0x80000000)
@@ -33,8 +41,7 @@ uintptr_t handle_trap(uintptr_t mcause, uintptr_t epc)
   }
   else
   {
-    write(1, "trap\n", 5);
-    _exit(1 + mcause);
+    epc = handle_excp(mcause, epc);
   }
   return epc;
 }
@@ -4,7 +4,8 @@
 
 //************************************************************
 // Global variables.
-static spi_type *SPIs[2] = {SPI0, SPI1};
+static spi_type *SPIs[3] = {SPI0, SPI1, &QSPI->spi};
+static spi_desc_type *SPI_DESCs[2] = {SPI0_DESC, SPI1_DESC};
 
 //************************************************************
 // Timer operations.
@@ -45,25 +46,56 @@ void uv_tmr_set_val(uint64_t val) {
 }
 
 uint64_t uv_tmr_get_val() {
-    uint32_t low;
-    uint32_t high;
-
-    while (true) {
-        high = SLC->tmr_valh;
-        low = SLC->tmr_val;
-        if (high == SLC->tmr_valh) {
-            break;
-        }
-    }
+    // Reading the lower half latches the upper one.
+    uint32_t low = LCL->tmr_val;
+    uint32_t high = LCL->tmr_vals;
 
     return ((uint64_t) high << 32) | low;
 }
 
+void uv_tmr_set_hart_cmp(uint32_t hart, uint64_t cmp) {
+    STORE_WORD(REG_LCL_HART_CMP + hart * 8, cmp & 0xFFFFFFFFUL);
+    STORE_WORD(REG_LCL_HART_CMPH + hart * 8, cmp >> 32);
+}
+
+//************************************************************
+// Inter-processor interrupts.
+void uv_send_ipi(uint32_t hart) {
+    LCL->sft_irq |= 1UL << hart;
+}
+
+void uv_clr_ipi(uint32_t hart) {
+    LCL->sft_irq &= ~(1UL << hart);
+}
+
+//************************************************************
+// Bus QoS.
+void uv_bus_qos_set(uint32_t mst, uint32_t cls, uint32_t wgt) {
+    uint32_t qos = SLC->bus_qos;
+
+    qos &= ~(SLC_QOS_CLS_MASK << (SLC_QOS_CLS_OFFSET + mst * 2));
+    qos &= ~(SLC_QOS_WGT_MASK << (SLC_QOS_WGT_OFFSET + mst * 4));
+    qos |= (cls & SLC_QOS_CLS_MASK) << (SLC_QOS_CLS_OFFSET + mst * 2);
+    qos |= (wgt & SLC_QOS_WGT_MASK) << (SLC_QOS_WGT_OFFSET + mst * 4);
+    SLC->bus_qos = qos;
+}
+
+void uv_bus_qos_set_lim(uint32_t lim) {
+    uint32_t qos = SLC->bus_qos;
+
+    qos &= ~SLC_QOS_LIM_MASK;
+    qos |= (lim << SLC_QOS_LIM_OFFSET) & SLC_QOS_LIM_MASK;
+    SLC->bus_qos = qos;
+}
+
 //************************************************************
 // UART operations.
 void uv_uart_init(bool tx_en, bool rx_en, uint32_t baud_rate) {
     uint32_t glb_cfg = 0;
     uint32_t clk_div = 0;
+    uint32_t div_frac = 0;
+    uint32_t osr = UART_OSR_16X;
+    uint32_t baud_cfg = 0;
     uint32_t endian = UART_DEFAULT_ENDIAN;
     uint32_t nbits = UART_DEFAULT_NUM_BITS - 5;
     uint32_t nstop = UART_DEFAULT_NUM_STOPS - 1;
@@ -84,14 +116,27 @@ void uv_uart_init(bool tx_en, bool rx_en, uint32_t baud_rate) {
     glb_cfg &= ~UART_NSTOP_MASK;
     glb_cfg |= (nstop << UART_NSTOP_OFFSET) & UART_NSTOP_MASK;
 
-    // Set clock divider according to baud rate.
+    // Set clock divider according to baud rate, with the fraction in 1/256 cycles.
     clk_div = MAIN_CLK_FREQ / baud_rate;
-    if ((MAIN_CLK_FREQ % baud_rate) > (baud_rate >> 1)) {
+    div_frac = ((MAIN_CLK_FREQ % baud_rate) * 256 + (baud_rate >> 1)) / baud_rate;
+    if (div_frac > 255) {
+        div_frac = 0;
         clk_div++;
     }
     glb_cfg &= ~UART_CLK_DIV_MASK;
     glb_cfg |= (clk_div << UART_CLK_DIV_OFFSET) & UART_CLK_DIV_MASK;
 
+    // Keep 2 cycles per sample at least.
+    if (clk_div < 16) {
+        osr = UART_OSR_4X;
+    } else if (clk_div < 32) {
+        osr = UART_OSR_8X;
+    }
+    baud_cfg = UART->baud_cfg & UART_RX_TMO_MASK;
+    baud_cfg |= (div_frac << UART_DIV_FRAC_OFFSET) & UART_DIV_FRAC_MASK;
+    baud_cfg |= (osr << UART_OSR_OFFSET) & UART_OSR_MASK;
+
+    UART->baud_cfg = baud_cfg;
     UART->glb_cfg = glb_cfg;
 }
 
@@ -131,20 +176,66 @@ void uv_uart_set_rx_irq(bool rx_ie, uint32_t rx_th) {
 }
 
 void uv_uart_send_data(uint8_t *buf, size_t len) {
-    for (size_t i = 0; i < len; ++i) {
-        while (UART->txq_len == UART->txq_cap) {
-            ;
+    size_t i = 0;
+
+    // Fill the free space at once, 4 bytes per write of TXQ_WDAT, so that the writes are posted back to back.
+    while (i < len) {
+        uint32_t room = UART->txq_free;
+        if (room > len - i) {
+            room = len - i;
+        }
+        for (; room >= 4; room -= 4, i += 4) {
+            uint8_t *p = buf + i;
+            UART->txq_wdat = (((uint32_t) p & 0x3) == 0) ? *((uint32_t *) p)
+                           : p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+        }
+        for (; room > 0; --room, ++i) {
+            UART->txq_dat = buf[i];
         }
-        UART->txq_dat = buf[i];
     }
 }
 
 void uv_uart_recv_data(uint8_t *buf, size_t len) {
-    for (size_t i = 0; i < len; ++i) {
-        while (UART->rxq_len == 0) {
-            ;
+    size_t i = 0;
+
+    // Take 4 bytes per read of RXQ_WDAT while there are enough.
+    while (i < len) {
+        uint32_t num = UART->rxq_len;
+        if (num > len - i) {
+            num = len - i;
+        }
+        for (; num >= 4; num -= 4, i += 4) {
+            uint32_t word = UART->rxq_wdat;
+            buf[i]     = word;
+            buf[i + 1] = word >> 8;
+            buf[i + 2] = word >> 16;
+            buf[i + 3] = word >> 24;
         }
-        buf[i] = UART->rxq_dat;
+        for (; num > 0; --num, ++i) {
+            buf[i] = UART->rxq_dat;
+        }
+    }
+}
+
+void uv_uart_set_dma(bool tx_en, uint32_t tx_th, bool rx_en, uint32_t rx_th) {
+    uint32_t dma_cfg = 0;
+
+    dma_cfg |= tx_en ? UART_TX_DMA_EN_MASK : 0;
+    dma_cfg |= rx_en ? UART_RX_DMA_EN_MASK : 0;
+    dma_cfg |= (tx_th << UART_TX_DMA_TH_OFFSET) & UART_TX_DMA_TH_MASK;
+    dma_cfg |= (rx_th << UART_RX_DMA_TH_OFFSET) & UART_RX_DMA_TH_MASK;
+    UART->dma_cfg = dma_cfg;
+}
+
+void uv_uart_set_rx_tmo(bool tmo_ie, uint32_t tmo_bits) {
+    uint32_t baud_cfg = UART->baud_cfg & ~UART_RX_TMO_MASK;
+
+    baud_cfg |= (tmo_bits << UART_RX_TMO_OFFSET) & UART_RX_TMO_MASK;
+    UART->baud_cfg = baud_cfg;
+    if (tmo_ie) {
+        UART->ie |= UART_RX_TMO_IRQ_MASK;
+    } else {
+        UART->ie &= ~UART_RX_TMO_IRQ_MASK;
     }
 }
 
@@ -224,11 +315,15 @@ void uv_spi_recv_halfs(uint32_t id, uint16_t *buf, size_t len) {
 }
 
 void uv_spi_send_words(uint32_t id, uint32_t *buf, size_t len) {
-    for (size_t i = 0; i < len; ++i) {
-        while (SPIs[id]->txq_len == SPIs[id]->txq_cap) {
-            ;
+    uint32_t cap = SPIs[id]->txq_cap;
+    size_t i = 0;
+
+    // Fill all the free space at once, so that the writes are posted back to back.
+    while (i < len) {
+        uint32_t room = cap - SPIs[id]->txq_len;
+        for (; room > 0 && i < len; --room, ++i) {
+            SPIs[id]->txq_dat = buf[i];
         }
-        SPIs[id]->txq_dat = buf[i];
     }
 }
 
@@ -240,3 +335,618 @@ void uv_spi_recv_words(uint32_t id, uint32_t *buf, size_t len) {
         buf[i] = SPIs[id]->rxq_dat;
     }
 }
+
+void uv_spi_set_done_irq(uint32_t id, bool done_ie) {
+    if (done_ie) {
+        SPIs[id]->ie |= SPI_DONE_IRQ_MASK;
+    } else {
+        SPIs[id]->ie &= ~SPI_DONE_IRQ_MASK;
+    }
+}
+
+void uv_spi_clr_done_irq(uint32_t id) {
+    SPIs[id]->ip = SPI_DONE_IRQ_MASK;
+    // Read back, so the posted write lands before the IRQ is completed.
+    (void) SPIs[id]->ip;
+}
+
+void uv_spi_set_dma(uint32_t id, bool tx_en, uint32_t tx_th, bool rx_en, uint32_t rx_th) {
+    uint32_t dma_cfg = 0;
+
+    dma_cfg |= tx_en ? SPI_TX_DMA_EN_MASK : 0;
+    dma_cfg |= rx_en ? SPI_RX_DMA_EN_MASK : 0;
+    dma_cfg |= (tx_th << SPI_TX_DMA_TH_OFFSET) & SPI_TX_DMA_TH_MASK;
+    dma_cfg |= (rx_th << SPI_RX_DMA_TH_OFFSET) & SPI_RX_DMA_TH_MASK;
+    SPI_DESCs[id]->dma_cfg = dma_cfg;
+}
+
+void uv_spi_desc_start(uint32_t id, spi_desc *desc, uint32_t addr, uint32_t len) {
+    // A start is dropped while the last transfer is running.
+    while (uv_spi_desc_busy(id)) {
+        ;
+    }
+    SPI_DESCs[id]->cfg = *((uint32_t *) desc);
+    SPI_DESCs[id]->addr = addr;
+    SPI_DESCs[id]->len = len & SPI_DESC_LEN_MASK;
+}
+
+bool uv_spi_desc_busy(uint32_t id) {
+    return SPI_DESCs[id]->len & SPI_DESC_BUSY_MASK;
+}
+
+void uv_spi_desc_wait(uint32_t id) {
+    while (uv_spi_desc_busy(id)) {
+        ;
+    }
+    uv_spi_clr_done_irq(id);
+}
+
+//************************************************************
+// I2C operations.
+void uv_i2c_init(uint32_t clk_div, uint32_t scl_lo, uint32_t sda_dly) {
+    I2C->glb_cfg = ((clk_div << I2C_CLK_DIV_OFFSET) & I2C_CLK_DIV_MASK)
+                 | ((sda_dly << I2C_SDA_DLY_OFFSET) & I2C_SDA_DLY_MASK);
+    I2C->scl_lo = scl_lo;
+    I2C->txq_clr = 1;
+    I2C->rxq_clr = 1;
+}
+
+void uv_i2c_set_irq(bool done_ie, bool nack_ie) {
+    uint32_t ie = I2C->ie & ~(I2C_DONE_IRQ_MASK | I2C_NACK_IRQ_MASK);
+
+    ie |= done_ie ? I2C_DONE_IRQ_MASK : 0;
+    ie |= nack_ie ? I2C_NACK_IRQ_MASK : 0;
+    I2C->ie = ie;
+}
+
+void uv_i2c_clr_irq() {
+    // Sticky bits are written by value.
+    I2C->ip = 0;
+    // Read back, so the posted write lands before the IRQ is completed.
+    (void) I2C->ip;
+}
+
+void uv_i2c_push_cmd(uint32_t op, uint32_t dat) {
+    while (I2C->txq_len >= I2C->txq_cap) {
+        ;
+    }
+    I2C->txq_dat = I2C_CMD(op, dat);
+}
+
+void uv_i2c_start() {
+    I2C->start = 1;
+}
+
+bool uv_i2c_busy() {
+    return I2C->busy & I2C_BUSY_MASK;
+}
+
+int uv_i2c_status() {
+    uint32_t ip = I2C->ip;
+
+    if (ip & I2C_NSCL_IRQ_MASK) {
+        return I2C_ERR_NSCL;
+    } else if (ip & I2C_NACK_IRQ_MASK) {
+        return I2C_ERR_NACK;
+    } else {
+        return 0;
+    }
+}
+
+// Write then read a device in one transaction, with a repeated START between.
+int uv_i2c_xfer(uint32_t addr, uint8_t *wbuf, size_t wlen, uint8_t *rbuf, size_t rlen) {
+    size_t i = 0;
+
+    while (uv_i2c_busy()) {
+        ;
+    }
+    I2C->txq_clr = 1;
+    I2C->rxq_clr = 1;
+    uv_i2c_clr_irq();
+
+    // Start at the first command, so the rest can be more than TXQ holds.
+    // Commands pushed after a NACK wait in TXQ, till cleared by the next transfer.
+    if ((wlen > 0) || (rlen == 0)) {
+        uv_i2c_push_cmd(I2C_CMD_START, addr << 1);
+        uv_i2c_start();
+        for (i = 0; i < wlen; ++i) {
+            uv_i2c_push_cmd(I2C_CMD_WRITE, wbuf[i]);
+        }
+    }
+    if (rlen > 0) {
+        uv_i2c_push_cmd(I2C_CMD_START, (addr << 1) | 1);
+        if (wlen == 0) {
+            uv_i2c_start();
+        }
+        for (i = 0; i < rlen; i += I2C_MAX_RD_LEN) {
+            uv_i2c_push_cmd(I2C_CMD_READ, (rlen - i > I2C_MAX_RD_LEN ? I2C_MAX_RD_LEN : rlen - i) - 1);
+        }
+    }
+    uv_i2c_push_cmd(I2C_CMD_STOP, 0);
+
+    // Drain RXQ, which holds SCL when full.
+    i = 0;
+    while (uv_i2c_busy() || (I2C->rxq_len > 0)) {
+        if (I2C->rxq_len > 0) {
+            uint8_t dat = I2C->rxq_dat;
+            if (i < rlen) {
+                rbuf[i++] = dat;
+            }
+        }
+    }
+    return uv_i2c_status();
+}
+
+//************************************************************
+// QSPI XIP operations.
+void uv_qspi_xip_enable(bool cont_en, bool pf_en, uint32_t clk_div) {
+    uint32_t xip_cfg = QSPI->xip_cfg;
+    xip_cfg &= ~(XIP_CONT_EN_MASK | XIP_PF_EN_MASK | XIP_CLK_DIV_MASK);
+    xip_cfg |= cont_en ? XIP_CONT_EN_MASK : 0;
+    xip_cfg |= pf_en ? XIP_PF_EN_MASK : 0;
+    xip_cfg |= (clk_div << XIP_CLK_DIV_OFFSET) & XIP_CLK_DIV_MASK;
+    xip_cfg |= XIP_EN_MASK;
+    QSPI->xip_cfg = xip_cfg;
+}
+
+void uv_qspi_xip_disable() {
+    QSPI->xip_cfg &= ~XIP_EN_MASK;
+    // Wait for the mode reset sequence before driving flash by registers.
+    while (QSPI->xip_stat & (XIP_BUSY_MASK | XIP_CONT_ACT_MASK)) {
+        ;
+    }
+}
+
+void uv_qspi_xip_invalidate() {
+    QSPI->xip_ctrl = XIP_INV_MASK;
+}
+
+//************************************************************
+// DMA operations.
+uint32_t uv_dma_ctrl(uint32_t len, uint32_t size, bool src_inc, bool dst_inc, uint32_t burst) {
+    uint32_t ctrl = (len << DMA_LEN_OFFSET) & DMA_LEN_MASK;
+    ctrl |= (size << DMA_SIZE_OFFSET) & DMA_SIZE_MASK;
+    ctrl |= src_inc ? DMA_SRC_INC_MASK : 0;
+    ctrl |= dst_inc ? DMA_DST_INC_MASK : 0;
+    ctrl |= (burst << DMA_BURST_OFFSET) & DMA_BURST_MASK;
+    return ctrl;
+}
+
+void uv_dma_set_desc(dma_desc *desc, uint32_t src, uint32_t dst, uint32_t ctrl, dma_desc *next) {
+    desc->src = src;
+    desc->dst = dst;
+    desc->ctrl = ctrl;
+    desc->next = next;
+}
+
+void uv_dma_set_handshake(uint32_t ch, bool hs_en, uint32_t hs_sel) {
+    uint32_t cfg = DMA->ch[ch].cfg;
+    cfg &= ~(DMA_CH_HS_EN_MASK | DMA_CH_HS_SEL_MASK);
+    cfg |= hs_en ? DMA_CH_HS_EN_MASK : 0;
+    cfg |= (hs_sel << DMA_CH_HS_SEL_OFFSET) & DMA_CH_HS_SEL_MASK;
+    DMA->ch[ch].cfg = cfg;
+}
+
+void uv_dma_set_irq(uint32_t ch, bool done_ie, bool err_ie) {
+    uint32_t ie = DMA->ie;
+    ie &= ~(DMA_DONE_IRQ_MASK(ch) | DMA_ERR_IRQ_MASK(ch));
+    ie |= done_ie ? DMA_DONE_IRQ_MASK(ch) : 0;
+    ie |= err_ie ? DMA_ERR_IRQ_MASK(ch) : 0;
+    DMA->ie = ie;
+}
+
+void uv_dma_clr_irq(uint32_t ch) {
+    DMA->ip = DMA_DONE_IRQ_MASK(ch) | DMA_ERR_IRQ_MASK(ch);
+    // Read back, so the posted write lands before the IRQ is completed.
+    (void) DMA->ip;
+}
+
+void uv_dma_start(uint32_t ch, uint32_t src, uint32_t dst, uint32_t ctrl) {
+    DMA->ch[ch].src = src;
+    DMA->ch[ch].dst = dst;
+    DMA->ch[ch].ctrl = ctrl;
+    DMA->ch[ch].next = 0;
+    DMA->ch[ch].cfg |= DMA_CH_EN_MASK;
+}
+
+void uv_dma_start_chain(uint32_t ch, dma_desc *desc) {
+    // A channel with zero length fetches its first descriptor from NEXT.
+    DMA->ch[ch].ctrl = 0;
+    DMA->ch[ch].next = (uint32_t) desc;
+    DMA->ch[ch].cfg |= DMA_CH_EN_MASK;
+}
+
+void uv_dma_stop(uint32_t ch) {
+    DMA->ch[ch].cfg &= ~DMA_CH_EN_MASK;
+}
+
+bool uv_dma_busy(uint32_t ch) {
+    return DMA->busy & (1UL << ch);
+}
+
+int uv_dma_wait(uint32_t ch) {
+    while (uv_dma_busy(ch)) {
+        ;
+    }
+    int ret = (DMA->ip & DMA_ERR_IRQ_MASK(ch)) ? -1 : 0;
+    uv_dma_clr_irq(ch);
+    return ret;
+}
+
+int uv_dma_memcpy(uint32_t ch, void *dst, const void *src, size_t len) {
+    uint32_t d = (uint32_t) dst;
+    uint32_t s = (uint32_t) src;
+    uint32_t size = ((d | s | len) & 0x3) == 0 ? DMA_SIZE_WORD
+                  : ((d | s | len) & 0x1) == 0 ? DMA_SIZE_HALF : DMA_SIZE_BYTE;
+    size_t num = len >> size;
+
+    while (num > 0) {
+        uint32_t n = num > DMA_MAX_LEN ? DMA_MAX_LEN : num;
+        uv_dma_start(ch, s, d, uv_dma_ctrl(n, size, true, true, DMA_MAX_BURST));
+        if (uv_dma_wait(ch) != 0) {
+            return -1;
+        }
+        s += n << size;
+        d += n << size;
+        num -= n;
+    }
+    return 0;
+}
+
+//************************************************************
+// PWM & capture operations.
+void uv_pwm_init(uint32_t clk_div, uint32_t prd, bool center, uint32_t dead) {
+    PWM->cfg = ((clk_div << PWM_CLK_DIV_OFFSET) & PWM_CLK_DIV_MASK)
+             | ((dead << PWM_DEAD_OFFSET) & PWM_DEAD_MASK)
+             | (center ? PWM_CENTER_MASK : 0);
+    PWM->prd = prd;
+}
+
+// Duties go to the shadow registers, which are taken while stopped or by uv_pwm_update.
+void uv_pwm_set_duty(uint32_t ch, uint32_t duty) {
+    PWM->duty[ch] = duty;
+}
+
+void uv_pwm_set_out(uint32_t oe, uint32_t pol) {
+    PWM->out = (oe & 0xFF) | ((pol & 0xFF) << PWM_POL_OFFSET);
+}
+
+// Load the shadow period & duties together at the end of the current period.
+void uv_pwm_update() {
+    PWM->cfg |= PWM_UPD_MASK;
+}
+
+bool uv_pwm_update_busy() {
+    return PWM->cfg & PWM_UPD_MASK;
+}
+
+void uv_pwm_start() {
+    PWM->cfg |= PWM_EN_MASK;
+}
+
+void uv_pwm_stop() {
+    PWM->cfg &= ~(PWM_EN_MASK | PWM_UPD_MASK);
+}
+
+void uv_pwm_set_irq(bool prd_ie) {
+    if (prd_ie) {
+        PWM->ie |= PWM_PRD_IRQ_MASK;
+    } else {
+        PWM->ie &= ~PWM_PRD_IRQ_MASK;
+    }
+}
+
+void uv_pwm_clr_irq() {
+    PWM->ip = PWM_PRD_IRQ_MASK;
+}
+
+// Select edges of a channel, with its FIFO & overflow cleared.
+void uv_cap_init(uint32_t ch, uint32_t edge) {
+    uint32_t cap_cfg = PWM->cap_cfg;
+
+    cap_cfg &= ~(0x3UL << (ch * 2));
+    PWM->cap_cfg = cap_cfg | ((edge & 0x3) << (ch * 2));
+    PWM->cap_sta = CAP_CLR_MASK(ch) | CAP_OVF_MASK(ch);
+}
+
+// IRQ while a FIFO holds more than th timestamps.
+void uv_cap_set_irq(bool cap_ie, uint32_t th) {
+    uint32_t cap_cfg = PWM->cap_cfg;
+
+    cap_cfg &= ~CAP_TH_MASK;
+    PWM->cap_cfg = cap_cfg | ((th << CAP_TH_OFFSET) & CAP_TH_MASK);
+    if (cap_ie) {
+        PWM->ie |= CAP_IRQ_MASK | CAP_OVF_IRQ_MASK;
+    } else {
+        PWM->ie &= ~(CAP_IRQ_MASK | CAP_OVF_IRQ_MASK);
+    }
+}
+
+uint32_t uv_cap_len(uint32_t ch) {
+    return CAP_LEN(PWM->cap_sta, ch);
+}
+
+// Pop up to len timestamps, returning the number popped.
+size_t uv_cap_read(uint32_t ch, uint32_t *buf, size_t len) {
+    size_t num = uv_cap_len(ch);
+
+    num = num < len ? num : len;
+    for (size_t i = 0; i < num; ++i) {
+        buf[i] = PWM->cap_dat[ch];
+    }
+    return num;
+}
+
+//************************************************************
+// CRC operations.
+void uv_crc_init(const crc_cfg *cfg) {
+    CRC->cfg = ((cfg->width - 1) & CRC_MSB_MASK)
+             | (cfg->ref_in ? CRC_REF_IN_MASK : 0)
+             | (cfg->ref_out ? CRC_REF_OUT_MASK : 0);
+    CRC->poly = cfg->poly;
+    CRC->xorout = cfg->xorout;
+    CRC->init = cfg->init;
+}
+
+void uv_crc_restart() {
+    CRC->init = CRC->init;
+}
+
+// Words for the aligned body, bytes for the head & tail.
+void uv_crc_update(const void *buf, size_t len) {
+    const uint8_t *p = (const uint8_t *) buf;
+    volatile uint8_t *dat_b = (volatile uint8_t *) REG_CRC_DAT;
+
+    while (len > 0 && ((uint32_t) p & 0x3) != 0) {
+        *dat_b = *p++;
+        len--;
+    }
+    while (len >= 4) {
+        CRC->dat = *((const uint32_t *) p);
+        p += 4;
+        len -= 4;
+    }
+    while (len > 0) {
+        *dat_b = *p++;
+        len--;
+    }
+}
+
+uint32_t uv_crc_result() {
+    return CRC->res;
+}
+
+void uv_crc_set_dma(bool dma_en) {
+    if (dma_en) {
+        CRC->cfg |= CRC_DMA_EN_MASK;
+    } else {
+        CRC->cfg &= ~CRC_DMA_EN_MASK;
+    }
+}
+
+//************************************************************
+// Event router operations.
+void uv_evt_connect(uint32_t ch, uint32_t evt, uint32_t task, uint32_t param) {
+    EVT->ch[ch] = (evt & EVT_SEL_MASK)
+                | ((task << EVT_TASK_OFFSET) & EVT_TASK_MASK)
+                | ((param << EVT_PARAM_OFFSET) & EVT_PARAM_MASK)
+                | EVT_EN_MASK;
+}
+
+void uv_evt_disconnect(uint32_t ch) {
+    EVT->ch[ch] = 0;
+}
+
+// Raise the software event.
+void uv_evt_trigger() {
+    EVT->sw = 1;
+}
+
+uint32_t uv_evt_hit() {
+    return EVT->hit;
+}
+
+void uv_evt_clr_hit(uint32_t mask) {
+    EVT->hit = mask;
+}
+
+//************************************************************
+// DSP operations.
+// Coefficients are loaded with the filter stopped & cleared.
+void uv_dsp_set_fir(const int16_t *coef, uint32_t taps, uint32_t shift) {
+    DSP->cfg = DSP_MODE_FIR
+             | (((taps - 1) << DSP_LEN_OFFSET) & DSP_LEN_MASK)
+             | ((shift << DSP_SHIFT_OFFSET) & DSP_SHIFT_MASK);
+    DSP->ctrl = DSP_CLR_MASK;
+
+    for (uint32_t i = 0; i < taps; i += 2) {
+        uint16_t hi = i + 1 < taps ? (uint16_t) coef[i + 1] : 0;
+        DSP_COEF[i / 2] = (uint16_t) coef[i] | ((uint32_t) hi << 16);
+    }
+}
+
+// Section s takes coefficients 8s ~ 8s+4, with a1 & a2 negated.
+void uv_dsp_set_biquad(const dsp_biq *sec, uint32_t num, uint32_t shift) {
+    DSP->cfg = DSP_MODE_BIQ
+             | (((num - 1) << DSP_LEN_OFFSET) & DSP_LEN_MASK)
+             | ((shift << DSP_SHIFT_OFFSET) & DSP_SHIFT_MASK);
+    DSP->ctrl = DSP_CLR_MASK;
+
+    for (uint32_t i = 0; i < num; ++i) {
+        uint16_t na1 = (uint16_t) -sec[i].a1;
+        uint16_t na2 = (uint16_t) -sec[i].a2;
+        DSP_COEF[i * 4]     = (uint16_t) sec[i].b0 | ((uint32_t) (uint16_t) sec[i].b1 << 16);
+        DSP_COEF[i * 4 + 1] = (uint16_t) sec[i].b2 | ((uint32_t) na1 << 16);
+        DSP_COEF[i * 4 + 2] = na2;
+        DSP_COEF[i * 4 + 3] = 0;
+    }
+}
+
+void uv_dsp_enable(bool en) {
+    if (en) {
+        DSP->cfg |= DSP_EN_MASK;
+    } else {
+        DSP->cfg &= ~DSP_EN_MASK;
+    }
+}
+
+void uv_dsp_clear() {
+    DSP->ctrl = DSP_CLR_MASK;
+}
+
+bool uv_dsp_busy() {
+    return (DSP->stat & (DSP_BUSY_MASK | DSP_IN_LEN_MASK)) != 0;
+}
+
+// Filter by CPU with the filter enabled, in chunks no longer than the FIFOs,
+// so that writes to DSP_IN never wait on a full DSP_OUT.
+void uv_dsp_run(const int16_t *in, int16_t *out, size_t len) {
+    while (len > 0) {
+        size_t n = len < DSP_FIFO_DEPTH ? len : DSP_FIFO_DEPTH;
+
+        for (size_t i = 0; i < n; ++i) {
+            DSP->in = (uint16_t) in[i];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = (int16_t) DSP->out;
+        }
+        in += n;
+        out += n;
+        len -= n;
+    }
+}
+
+// Requests while DSP_IN has in_th free or DSP_OUT holds out_th samples.
+void uv_dsp_set_dma(bool in_en, uint32_t in_th, bool out_en, uint32_t out_th) {
+    DSP->dma = (in_en ? DSP_IN_DMA_EN_MASK : 0)
+             | (out_en ? DSP_OUT_DMA_EN_MASK : 0)
+             | ((in_th << DSP_IN_DMA_TH_OFFSET) & DSP_IN_DMA_TH_MASK)
+             | ((out_th << DSP_OUT_DMA_TH_OFFSET) & DSP_OUT_DMA_TH_MASK);
+}
+
+//************************************************************
+// GEMM operations.
+// Panels of 4 lines, each as steps of 4 elements packed into 16-byte rows,
+// where element r of step k in panel i is p[i * pan + r * line + k * step].
+static uint32_t uv_gemm_pack(uint32_t ofs, const void *p, size_t pan, size_t line, size_t step,
+                             uint32_t npan, uint32_t k, uint32_t type) {
+    volatile uint32_t *dst = (volatile uint32_t *) ofs;
+    uint32_t bits = 8UL << type;
+    uint32_t mask = type == GEMM_INT32 ? 0xFFFFFFFFUL : (1UL << bits) - 1;
+    uint32_t kpad = (k + (4 >> type) - 1) & ~((4UL >> type) - 1);
+
+    for (uint32_t i = 0; i < npan; ++i) {
+        for (uint32_t s = 0; s < kpad; ++s) {
+            uint32_t w = 0, sft = 0;
+
+            for (uint32_t r = 0; r < 4; ++r) {
+                size_t idx = i * pan + r * line + s * step;
+                int32_t e = s >= k ? 0
+                          : type == GEMM_INT8  ? ((const int8_t  *) p)[idx]
+                          : type == GEMM_INT16 ? ((const int16_t *) p)[idx]
+                          : ((const int32_t *) p)[idx];
+
+                w |= ((uint32_t) e & mask) << sft;
+                sft += bits;
+                if (sft == 32) {
+                    *dst++ = w;
+                    w = 0;
+                    sft = 0;
+                }
+            }
+        }
+    }
+    return (uint32_t) dst - ofs;
+}
+
+// Rows 0 ~ m-1 & steps 0 ~ k-1 of A, returning the bytes packed at ofs of A tile.
+uint32_t uv_gemm_pack_a(uint32_t ofs, const void *a, size_t lda, uint32_t m, uint32_t k, uint32_t type) {
+    return uv_gemm_pack(REG_GEMM_A + ofs, a, 4 * lda, lda, 1, m / 4, k, type);
+}
+
+// Steps 0 ~ k-1 & columns 0 ~ n-1 of B, returning the bytes packed at ofs of B tile.
+uint32_t uv_gemm_pack_b(uint32_t ofs, const void *b, size_t ldb, uint32_t k, uint32_t n, uint32_t type) {
+    return uv_gemm_pack(REG_GEMM_B + ofs, b, 4, 1, ldb, n / 4, k, type);
+}
+
+void uv_gemm_start(uint32_t type, bool acc, uint32_t m, uint32_t n, uint32_t k,
+                   uint32_t a_ofs, uint32_t b_ofs, uint32_t c_ofs) {
+    GEMM->cfg = (GEMM->cfg & GEMM_DONE_IE_MASK) | (type & GEMM_TYPE_MASK) | (acc ? GEMM_ACC_MASK : 0);
+    GEMM->dim = (m << GEMM_M_OFFSET) | (n << GEMM_N_OFFSET) | (k << GEMM_K_OFFSET);
+    GEMM->a_ofs = a_ofs;
+    GEMM->b_ofs = b_ofs;
+    GEMM->c_ofs = c_ofs;
+    GEMM->ctrl = GEMM_START_MASK;
+}
+
+bool uv_gemm_busy() {
+    return (GEMM->stat & GEMM_BUSY_MASK) != 0;
+}
+
+// Returns the cycles taken by the engine.
+uint32_t uv_gemm_wait() {
+    while (uv_gemm_busy()) {
+        ;
+    }
+    return GEMM->cyc;
+}
+
+// C += the m x n block at c_ofs of C tile, stored with N = n.
+void uv_gemm_add_c(uint32_t c_ofs, int32_t *c, size_t ldc, uint32_t m, uint32_t n) {
+    volatile int32_t *src = (volatile int32_t *) (REG_GEMM_C + c_ofs);
+
+    for (uint32_t i = 0; i < m; ++i) {
+        for (uint32_t j = 0; j < n; ++j) {
+            c[i * ldc + j] += *src++;
+        }
+    }
+}
+
+// C += A * B in blocks of up to 32 x 32, with m & n multiples of 4.
+// Blocks of K are packed into a half of A & B tiles while the other half
+// is running, & accumulated in C tile. Returns the cycles taken by the engine.
+uint32_t uv_gemm_mm(uint32_t type, size_t m, size_t n, size_t p,
+                    const void *a, size_t lda, const void *b, size_t ldb, int32_t *c, size_t ldc) {
+    const uint8_t *pa = (const uint8_t *) a;
+    const uint8_t *pb = (const uint8_t *) b;
+    size_t mb = m < 32 ? m : 32;
+    size_t nb = n < 32 ? n : 32;
+    size_t kb = ((GEMM_TILE_BYTES / 2) / ((mb > nb ? mb : nb) << type)) & ~3UL;
+    uint32_t half = 0;
+    uint32_t cyc = 0;
+
+    for (size_t i = 0; i < m; i += mb) {
+        size_t mi = m - i < mb ? m - i : mb;
+
+        for (size_t j = 0; j < n; j += nb) {
+            size_t nj = n - j < nb ? n - j : nb;
+
+            for (size_t k = 0; k < p; k += kb) {
+                size_t kk = p - k < kb ? p - k : kb;
+
+                uv_gemm_pack_a(half, pa + ((i * lda + k) << type), lda, mi, kk, type);
+                uv_gemm_pack_b(half, pb + ((k * ldb + j) << type), ldb, kk, nj, type);
+                if (k > 0) {
+                    cyc += uv_gemm_wait();
+                }
+                uv_gemm_start(type, k > 0, mi, nj, kk, half, half, 0);
+                half ^= GEMM_TILE_BYTES / 2;
+            }
+            cyc += uv_gemm_wait();
+            uv_gemm_add_c(0, c + i * ldc + j, ldc, mi, nj);
+        }
+    }
+    return cyc;
+}
+
+void uv_gemm_set_irq(bool done_ie) {
+    if (done_ie) {
+        GEMM->cfg |= GEMM_DONE_IE_MASK;
+    } else {
+        GEMM->cfg &= ~GEMM_DONE_IE_MASK;
+    }
+}
+
+void uv_gemm_clr_irq() {
+    GEMM->stat = GEMM_DONE_MASK;
+}
@@ -15,3 +15,4 @@
 ../../../design/mem/uv_dcache.v
 
 ../../../design/bus/uv_bus_fab_1x2.v
+../../../design/bus/uv_bus_fab_1x3.v
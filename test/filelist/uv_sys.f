@@ -1,6 +1,8 @@
 ../../../design/sys/uv_sys.v
+../../../design/sys/uv_clst.v
 ../../../design/sys/uv_mem_subsys.v
 ../../../design/sys/uv_dev_subsys.v
+../../../design/sys/uv_dma_subsys.v
 ../../../design/sys/uv_perip_subsys.v
 
 ../../../design/core/uv_core.v
@@ -23,19 +25,29 @@
 ../../../design/mem/uv_dam.v
 ../../../design/mem/uv_sram_bus_ctrl.v
 ../../../design/mem/uv_sram_sp.v
+../../../design/mem/uv_sram_dp.v
 ../../../design/mem/uv_dev_sram.v
 ../../../design/mem/uv_eflash.v
+../../../design/mem/uv_eflash_macro.v
+../../../design/mem/uv_sdram_ctrl.v
+../../../design/mem/uv_line_buf.v
 ../../../design/mem/uv_queue.v
+../../../design/mem/uv_sram_queue.v
 
 ../../../design/dev/uv_slc.v
 ../../../design/dev/uv_tmr.v
 ../../../design/dev/uv_tmr_apb.v
+../../../design/dev/uv_tmr_cap.v
+../../../design/dev/uv_tmr_pwm.v
 ../../../design/dev/uv_wdt.v
 ../../../design/dev/uv_wdt_apb.v
 ../../../design/dev/uv_spi.v
 ../../../design/dev/uv_spi_apb.v
 ../../../design/dev/uv_spi_reg.v
 ../../../design/dev/uv_spi_rtx.v
+../../../design/dev/uv_spi_desc.v
+../../../design/dev/uv_qspi.v
+../../../design/dev/uv_qspi_xip.v
 ../../../design/dev/uv_i2c.v
 ../../../design/dev/uv_i2c_apb.v
 ../../../design/dev/uv_i2c_reg.v
@@ -45,22 +57,43 @@
 ../../../design/dev/uv_uart_reg.v
 ../../../design/dev/uv_uart_tx.v
 ../../../design/dev/uv_uart_rx.v
+../../../design/dev/uv_uart_baud.v
 ../../../design/dev/uv_gpio.v
 ../../../design/dev/uv_gpio_apb.v
+../../../design/dev/uv_evt.v
+../../../design/dev/uv_evt_apb.v
+../../../design/dev/uv_crc.v
+../../../design/dev/uv_crc_apb.v
+../../../design/dev/uv_dsp.v
+../../../design/dev/uv_dsp_apb.v
+../../../design/dev/uv_dsp_mac.v
+../../../design/dev/uv_gemm.v
+../../../design/dev/uv_gemm_apb.v
+../../../design/dev/uv_gemm_mac.v
 ../../../design/dev/uv_iomux.v
 ../../../design/dev/uv_dbg.v
+../../../design/dev/uv_dma.v
 
 ../../../design/bus/uv_bus_fab.v
+../../../design/bus/uv_bus_burst.v
+../../../design/bus/uv_bus_amo.v
+../../../design/bus/uv_bus_upsize.v
+../../../design/bus/uv_bus_downsize.v
 ../../../design/bus/uv_bus_fab_1x2.v
+../../../design/bus/uv_bus_fab_1x3.v
 ../../../design/bus/uv_bus_fab_1x8.v
 ../../../design/bus/uv_bus_fab_2x2.v
 ../../../design/bus/uv_bus_fab_4x4.v
-../../../design/bus/uv_bus_fab_4x8.v
+../../../design/bus/uv_bus_fab_4x10.v
 ../../../design/bus/uv_bus_to_apb.v
+../../../design/bus/uv_bus_to_axi.v
+../../../design/bus/uv_axi_to_bus.v
 
 ../../../design/misc/uv_arb_rr.v
 ../../../design/misc/uv_arb_fp.v
+../../../design/misc/uv_arb_qos.v
 ../../../design/misc/uv_clk_gate.v
 ../../../design/misc/uv_rst_sync.v
 ../../../design/misc/uv_sync.v
 ../../../design/misc/uv_pipe.v
+../../../design/misc/uv_reg_slice.v
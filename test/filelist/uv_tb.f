@@ -1 +1,9 @@
 ../../testbench/tb_top.v
+../../testbench/tb_spi_flash.v
+../../testbench/tb_uart_bfm.v
+../../testbench/tb_spi_lcd.v
+../../testbench/tb_i2c_eeprom.v
+../../testbench/tb_pwm_mon.v
+../../testbench/tb_sdram.v
+../../testbench/tb_axi_mem.v
+../../testbench/tb_axi_top.v
@@ -0,0 +1,73 @@
+// See LICENSE for license details.
+
+//**************************************************************************
+// Multi-threaded LR/SC contention test
+//--------------------------------------------------------------------------
+//
+// All threads increment a shared counter by LR/SC loops on the same word.
+// An SC must fail once another thread has stored to the word after the LR,
+// or increments are lost and the final count is short.
+
+//--------------------------------------------------------------------------
+// Includes 
+
+#include <stdlib.h>
+#include <stdio.h>
+
+
+//--------------------------------------------------------------------------
+// Basic Utilities and Multi-thread Support
+
+#include "util.h"
+
+
+//--------------------------------------------------------------------------
+// Parameters
+
+#define INC_NUM 1000
+
+
+//--------------------------------------------------------------------------
+// LR/SC increment, returning the number of failed SCs
+
+static int __attribute__((noinline)) lrsc_inc(volatile int* p)
+{
+  int val, fail, retry = -1;
+
+  do {
+    asm volatile ("lr.w %0, (%2)\n\t"
+                  "addi %0, %0, 1\n\t"
+                  "sc.w %1, %0, (%2)"
+                  : "=&r"(val), "=&r"(fail) : "r"(p) : "memory");
+    retry++;
+  } while (fail);
+
+  return retry;
+}
+
+
+//--------------------------------------------------------------------------
+// Main
+//
+// all threads start executing thread_entry(). Use their "coreid" to
+// differentiate between threads (each thread is running on a separate core).
+
+void thread_entry(int cid, int nc)
+{
+   static volatile int counter;
+   static volatile int retries;
+   int retry = 0;
+   int i;
+
+   barrier(nc);
+   stats(for (i = 0; i < INC_NUM; i++) retry += lrsc_inc(&counter); barrier(nc), INC_NUM);
+
+   __sync_fetch_and_add(&retries, retry);
+   barrier(nc);
+
+   if (cid == 0)
+     printf("counter = %d of %d, %d SCs failed\n", counter, nc * INC_NUM, retries);
+
+   barrier(nc);
+   exit(counter != nc * INC_NUM);
+}
@@ -0,0 +1,300 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_axi_mem
+//
+// Designer: Owen
+//
+// Description:
+//      Behavioral model of AXI4 memory. Up to OST_NUM read &
+//      write bursts are accepted, R beats start RD_LAT cycles
+//      after AR, and B is returned WR_LAT cycles after the
+//      last W beat, both in order. The latencies can be set
+//      by +AXI_RD_LAT & +AXI_WR_LAT. Only the lower 2^MEM_AW
+//      words are modeled. Beats, WLAST errors & the busy
+//      cycles are reported at the end of simulation.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_axi_mem
+#(
+    parameter ALEN                  = 32,
+    parameter DLEN                  = 32,
+    parameter MLEN                  = DLEN / 8,
+    parameter AXI_IDW               = 4,
+    parameter MEM_AW                = 16,
+    parameter OST_NUM               = 8,
+    parameter RD_LAT                = 8,
+    parameter WR_LAT                = 4
+)
+(
+    input                           clk,
+    input                           rst_n,
+
+    input  [AXI_IDW-1:0]            axi_awid,
+    input  [ALEN-1:0]               axi_awaddr,
+    input  [7:0]                    axi_awlen,
+    input  [2:0]                    axi_awsize,
+    input  [1:0]                    axi_awburst,
+    input                           axi_awvalid,
+    output                          axi_awready,
+
+    input  [DLEN-1:0]               axi_wdata,
+    input  [MLEN-1:0]               axi_wstrb,
+    input                           axi_wlast,
+    input                           axi_wvalid,
+    output                          axi_wready,
+
+    output [AXI_IDW-1:0]            axi_bid,
+    output [1:0]                    axi_bresp,
+    output                          axi_bvalid,
+    input                           axi_bready,
+
+    input  [AXI_IDW-1:0]            axi_arid,
+    input  [ALEN-1:0]               axi_araddr,
+    input  [7:0]                    axi_arlen,
+    input  [2:0]                    axi_arsize,
+    input  [1:0]                    axi_arburst,
+    input                           axi_arvalid,
+    output                          axi_arready,
+
+    output [AXI_IDW-1:0]            axi_rid,
+    output [DLEN-1:0]               axi_rdata,
+    output [1:0]                    axi_rresp,
+    output                          axi_rlast,
+    output                          axi_rvalid,
+    input                           axi_rready
+);
+
+    localparam OFFSET_AW            = $clog2(MLEN);
+
+    reg  [DLEN-1:0]                 mem [0:2**MEM_AW-1];
+
+    // Accepted bursts.
+    reg  [AXI_IDW-1:0]              ar_id    [0:OST_NUM-1];
+    reg  [ALEN-1:0]                 ar_addr  [0:OST_NUM-1];
+    reg  [7:0]                      ar_len   [0:OST_NUM-1];
+    reg  [2:0]                      ar_size  [0:OST_NUM-1];
+    reg  [1:0]                      ar_burst [0:OST_NUM-1];
+    integer                         ar_cyc   [0:OST_NUM-1];
+    integer                         ar_cnt;
+    integer                         ar_rptr;
+    integer                         ar_wptr;
+    integer                         rd_beat;
+
+    reg  [AXI_IDW-1:0]              aw_id    [0:OST_NUM-1];
+    reg  [ALEN-1:0]                 aw_addr  [0:OST_NUM-1];
+    reg  [7:0]                      aw_len   [0:OST_NUM-1];
+    reg  [2:0]                      aw_size  [0:OST_NUM-1];
+    reg  [1:0]                      aw_burst [0:OST_NUM-1];
+    integer                         aw_cnt;
+    integer                         aw_rptr;
+    integer                         aw_wptr;
+    integer                         wr_beat;
+
+    reg  [AXI_IDW-1:0]              b_id     [0:OST_NUM-1];
+    integer                         b_cyc    [0:OST_NUM-1];
+    integer                         b_cnt;
+    integer                         b_rptr;
+    integer                         b_wptr;
+
+    integer                         rd_lat;
+    integer                         wr_lat;
+    integer                         cyc;
+    integer                         k;
+    reg  [ALEN-1:0]                 beat_addr;
+
+    // Statistics.
+    integer                         rd_beats;
+    integer                         wr_beats;
+    integer                         err_cnt;
+    integer                         first_cyc;
+    integer                         last_cyc;
+
+    wire                            rd_vld;
+    wire                            b_vld;
+
+    // Handshakes sampled at the clock edge.
+    reg                             ar_fire;
+    reg                             aw_fire;
+    reg                             r_fire;
+    reg                             w_fire;
+    reg                             b_fire;
+    reg  [AXI_IDW-1:0]              ar_id_s;
+    reg  [ALEN-1:0]                 ar_addr_s;
+    reg  [7:0]                      ar_len_s;
+    reg  [2:0]                      ar_size_s;
+    reg  [1:0]                      ar_burst_s;
+    reg  [AXI_IDW-1:0]              aw_id_s;
+    reg  [ALEN-1:0]                 aw_addr_s;
+    reg  [7:0]                      aw_len_s;
+    reg  [2:0]                      aw_size_s;
+    reg  [1:0]                      aw_burst_s;
+    reg  [DLEN-1:0]                 w_data_s;
+    reg  [MLEN-1:0]                 w_strb_s;
+    reg                             w_last_s;
+
+    initial begin
+        if (!$value$plusargs("AXI_RD_LAT=%d", rd_lat)) rd_lat = RD_LAT;
+        if (!$value$plusargs("AXI_WR_LAT=%d", wr_lat)) wr_lat = WR_LAT;
+        cyc       = 0;
+        ar_cnt    = 0;
+        ar_rptr   = 0;
+        ar_wptr   = 0;
+        rd_beat   = 0;
+        aw_cnt    = 0;
+        aw_rptr   = 0;
+        aw_wptr   = 0;
+        wr_beat   = 0;
+        b_cnt     = 0;
+        b_rptr    = 0;
+        b_wptr    = 0;
+        rd_beats  = 0;
+        wr_beats  = 0;
+        err_cnt   = 0;
+        first_cyc = 0;
+        last_cyc  = 0;
+    end
+
+    // Address of a beat in the burst.
+    function [ALEN-1:0] burst_addr;
+        input [ALEN-1:0]            addr;
+        input [7:0]                 len;
+        input [2:0]                 size;
+        input [1:0]                 burst;
+        input integer               beat;
+        reg   [ALEN-1:0]            base;
+        reg   [ALEN-1:0]            wrap_mask;
+    begin
+        base      = (addr >> size) << size;
+        wrap_mask = ((len + 1) << size) - 1;
+        case (burst)
+            2'b00  : burst_addr = addr;
+            2'b10  : burst_addr = (addr & (~wrap_mask)) | ((addr + (beat << size)) & wrap_mask);
+            default: burst_addr = beat == 0 ? addr : base + (beat << size);
+        endcase
+    end
+    endfunction
+
+    assign rd_vld                   = (ar_cnt > 0) && (cyc - ar_cyc[ar_rptr] >= rd_lat);
+    assign b_vld                    = (b_cnt > 0) && (cyc >= b_cyc[b_rptr]);
+
+    assign axi_arready              = ar_cnt < OST_NUM;
+    assign axi_awready              = aw_cnt < OST_NUM;
+    assign axi_wready               = (aw_cnt > 0) && (b_cnt < OST_NUM);
+
+    assign axi_rvalid               = rd_vld;
+    assign axi_rid                  = ar_id[ar_rptr];
+    assign axi_rdata                = mem[burst_addr(ar_addr[ar_rptr], ar_len[ar_rptr], ar_size[ar_rptr],
+                                                     ar_burst[ar_rptr], rd_beat) >> OFFSET_AW];
+    assign axi_rresp                = 2'b00;
+    assign axi_rlast                = rd_beat == ar_len[ar_rptr];
+
+    assign axi_bvalid               = b_vld;
+    assign axi_bid                  = b_id[b_rptr];
+    assign axi_bresp                = 2'b00;
+
+    // Outputs change 1 unit after the edge, as those of the design.
+    always @(posedge clk) begin
+        ar_fire    = axi_arvalid & axi_arready;
+        aw_fire    = axi_awvalid & axi_awready;
+        r_fire     = axi_rvalid & axi_rready;
+        w_fire     = axi_wvalid & axi_wready;
+        b_fire     = axi_bvalid & axi_bready;
+        ar_id_s    = axi_arid;
+        ar_addr_s  = axi_araddr;
+        ar_len_s   = axi_arlen;
+        ar_size_s  = axi_arsize;
+        ar_burst_s = axi_arburst;
+        aw_id_s    = axi_awid;
+        aw_addr_s  = axi_awaddr;
+        aw_len_s   = axi_awlen;
+        aw_size_s  = axi_awsize;
+        aw_burst_s = axi_awburst;
+        w_data_s   = axi_wdata;
+        w_strb_s   = axi_wstrb;
+        w_last_s   = axi_wlast;
+
+        #1;
+        cyc = cyc + 1;
+
+        if (ar_fire) begin
+            ar_id[ar_wptr]    = ar_id_s;
+            ar_addr[ar_wptr]  = ar_addr_s;
+            ar_len[ar_wptr]   = ar_len_s;
+            ar_size[ar_wptr]  = ar_size_s;
+            ar_burst[ar_wptr] = ar_burst_s;
+            ar_cyc[ar_wptr]   = cyc;
+            ar_wptr = (ar_wptr + 1) % OST_NUM;
+            ar_cnt  = ar_cnt + 1;
+            if (first_cyc == 0) first_cyc = cyc;
+        end
+
+        if (aw_fire) begin
+            aw_id[aw_wptr]    = aw_id_s;
+            aw_addr[aw_wptr]  = aw_addr_s;
+            aw_len[aw_wptr]   = aw_len_s;
+            aw_size[aw_wptr]  = aw_size_s;
+            aw_burst[aw_wptr] = aw_burst_s;
+            aw_wptr = (aw_wptr + 1) % OST_NUM;
+            aw_cnt  = aw_cnt + 1;
+            if (first_cyc == 0) first_cyc = cyc;
+        end
+
+        // Read beats.
+        if (r_fire) begin
+            rd_beats = rd_beats + 1;
+            last_cyc = cyc;
+            if (rd_beat == ar_len[ar_rptr]) begin
+                rd_beat = 0;
+                ar_rptr = (ar_rptr + 1) % OST_NUM;
+                ar_cnt  = ar_cnt - 1;
+            end
+            else begin
+                rd_beat = rd_beat + 1;
+            end
+        end
+
+        // Write beats.
+        if (w_fire) begin
+            beat_addr = burst_addr(aw_addr[aw_rptr], aw_len[aw_rptr], aw_size[aw_rptr], aw_burst[aw_rptr], wr_beat);
+            for (k = 0; k < MLEN; k = k + 1) begin
+                if (w_strb_s[k]) mem[beat_addr >> OFFSET_AW][k*8 +: 8] = w_data_s[k*8 +: 8];
+            end
+            wr_beats = wr_beats + 1;
+            last_cyc = cyc;
+            if (w_last_s != (wr_beat == aw_len[aw_rptr])) begin
+                err_cnt = err_cnt + 1;
+                $display("> AXI MEM ERROR: WLAST mismatched at cycle %0d!", cyc);
+            end
+            if (wr_beat == aw_len[aw_rptr]) begin
+                b_id[b_wptr]  = aw_id[aw_rptr];
+                b_cyc[b_wptr] = cyc + wr_lat;
+                b_wptr  = (b_wptr + 1) % OST_NUM;
+                b_cnt   = b_cnt + 1;
+                wr_beat = 0;
+                aw_rptr = (aw_rptr + 1) % OST_NUM;
+                aw_cnt  = aw_cnt - 1;
+            end
+            else begin
+                wr_beat = wr_beat + 1;
+            end
+        end
+
+        if (b_fire) begin
+            b_rptr = (b_rptr + 1) % OST_NUM;
+            b_cnt  = b_cnt - 1;
+        end
+    end
+
+    final begin
+        $display("> AXI MEM: %0d read beats, %0d write beats, %0d errors, RD_LAT %0d, WR_LAT %0d.",
+                 rd_beats, wr_beats, err_cnt, rd_lat, wr_lat);
+        if (last_cyc > first_cyc) begin
+            $display("> AXI MEM: %0d data beats in %0d cycles from the first access.",
+                     rd_beats + wr_beats, last_cyc - first_cyc + 1);
+        end
+    end
+
+endmodule
@@ -0,0 +1,524 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_axi_top
+//
+// Designer: Owen
+//
+// Description:
+//      Top module for testbench of AXI bridges.
+//      A bus master writes BYTES bytes in bursts of +BST_LEN
+//      beats & reads them back through uv_bus_to_axi into the
+//      AXI memory model, and prints the cycles & bandwidth of
+//      each pass. With AXI_LOOP, the AXI requests go back to
+//      bus by uv_axi_to_bus & out again before the memory.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_axi_top;
+
+localparam UDLY       = 1;
+localparam CLK_PERIOD = 10;
+localparam RST_CYCLES = 10;
+localparam ALEN       = 32;
+localparam DLEN       = 32;
+localparam MLEN       = DLEN / 8;
+localparam AXI_IDW    = 4;
+localparam OST_NUM    = 4;
+localparam BYTES      = 16384;
+
+reg  clk;
+reg  rst_n;
+
+// Bus master.
+reg                   gen_req_vld;
+wire                  gen_req_rdy;
+reg                   gen_req_read;
+reg  [ALEN-1:0]       gen_req_addr;
+reg  [3:0]            gen_req_len;
+reg                   gen_req_wrap;
+reg  [MLEN-1:0]       gen_req_mask;
+reg  [DLEN-1:0]       gen_req_data;
+wire                  gen_rsp_vld;
+wire                  gen_rsp_rdy;
+wire [1:0]            gen_rsp_excp;
+wire [DLEN-1:0]       gen_rsp_data;
+
+integer               bst_len;
+integer               rsp_cnt;
+integer               err_cnt;
+integer               cyc;
+integer               i;
+integer               j;
+integer               t0;
+integer               t1;
+
+// AXI from the bus master.
+wire [AXI_IDW-1:0]    a_awid;
+wire [ALEN-1:0]       a_awaddr;
+wire [7:0]            a_awlen;
+wire [2:0]            a_awsize;
+wire [1:0]            a_awburst;
+wire                  a_awvalid;
+wire                  a_awready;
+wire [DLEN-1:0]       a_wdata;
+wire [MLEN-1:0]       a_wstrb;
+wire                  a_wlast;
+wire                  a_wvalid;
+wire                  a_wready;
+wire [AXI_IDW-1:0]    a_bid;
+wire [1:0]            a_bresp;
+wire                  a_bvalid;
+wire                  a_bready;
+wire [AXI_IDW-1:0]    a_arid;
+wire [ALEN-1:0]       a_araddr;
+wire [7:0]            a_arlen;
+wire [2:0]            a_arsize;
+wire [1:0]            a_arburst;
+wire                  a_arvalid;
+wire                  a_arready;
+wire [AXI_IDW-1:0]    a_rid;
+wire [DLEN-1:0]       a_rdata;
+wire [1:0]            a_rresp;
+wire                  a_rlast;
+wire                  a_rvalid;
+wire                  a_rready;
+
+// AXI to the memory.
+wire [AXI_IDW-1:0]    m_awid;
+wire [ALEN-1:0]       m_awaddr;
+wire [7:0]            m_awlen;
+wire [2:0]            m_awsize;
+wire [1:0]            m_awburst;
+wire                  m_awvalid;
+wire                  m_awready;
+wire [DLEN-1:0]       m_wdata;
+wire [MLEN-1:0]       m_wstrb;
+wire                  m_wlast;
+wire                  m_wvalid;
+wire                  m_wready;
+wire [AXI_IDW-1:0]    m_bid;
+wire [1:0]            m_bresp;
+wire                  m_bvalid;
+wire                  m_bready;
+wire [AXI_IDW-1:0]    m_arid;
+wire [ALEN-1:0]       m_araddr;
+wire [7:0]            m_arlen;
+wire [2:0]            m_arsize;
+wire [1:0]            m_arburst;
+wire                  m_arvalid;
+wire                  m_arready;
+wire [AXI_IDW-1:0]    m_rid;
+wire [DLEN-1:0]       m_rdata;
+wire [1:0]            m_rresp;
+wire                  m_rlast;
+wire                  m_rvalid;
+wire                  m_rready;
+
+`ifdef AXI_LOOP
+// Bus between the bridges.
+wire                  lp_req_vld;
+wire                  lp_req_rdy;
+wire                  lp_req_read;
+wire [ALEN-1:0]       lp_req_addr;
+wire [3:0]            lp_req_len;
+wire                  lp_req_wrap;
+wire [MLEN-1:0]       lp_req_mask;
+wire [DLEN-1:0]       lp_req_data;
+wire                  lp_rsp_vld;
+wire                  lp_rsp_rdy;
+wire [1:0]            lp_rsp_excp;
+wire [DLEN-1:0]       lp_rsp_data;
+`endif
+
+function [DLEN-1:0] pattern;
+    input [ALEN-1:0] addr;
+begin
+    pattern = {addr[15:0], ~addr[15:0]};
+end
+endfunction
+
+// Clock.
+initial begin
+    clk = 1'b0;
+    forever #(CLK_PERIOD / 2.0) clk = ~clk;
+end
+
+always @(posedge clk) begin
+    cyc <= cyc + 1;
+end
+
+// Responses in request order.
+assign gen_rsp_rdy = 1'b1;
+
+always @(posedge clk) begin
+    if (gen_rsp_vld & gen_rsp_rdy) begin
+        if (gen_rsp_excp != 2'b0) begin
+            err_cnt = err_cnt + 1;
+            $display("> ERROR: response %0d with exception.", rsp_cnt);
+        end
+        if ((rsp_cnt >= BYTES / MLEN) && (gen_rsp_data != pattern((rsp_cnt - BYTES / MLEN) * MLEN))) begin
+            err_cnt = err_cnt + 1;
+            $display("> ERROR: read data mismatched at 0x%h.", (rsp_cnt - BYTES / MLEN) * MLEN);
+        end
+        rsp_cnt = rsp_cnt + 1;
+    end
+end
+
+task bus_req;
+    input            read;
+    input [ALEN-1:0] addr;
+    input [3:0]      len;
+begin
+    gen_req_vld  <= #UDLY 1'b1;
+    gen_req_read <= #UDLY read;
+    gen_req_addr <= #UDLY addr;
+    gen_req_len  <= #UDLY len;
+    gen_req_data <= #UDLY read ? {DLEN{1'b0}} : pattern(addr);
+    @(posedge clk);
+    while (~gen_req_rdy) @(posedge clk);
+end
+endtask
+
+task report;
+    input [8*8-1:0] name;
+    input integer   cycles;
+begin
+    $display("> %0s: %0d bytes in %0d cycles, %0d.%02d B/cycle.", name, BYTES, cycles,
+             BYTES / cycles, BYTES * 100 / cycles % 100);
+end
+endtask
+
+initial begin
+    if (!$value$plusargs("BST_LEN=%d", bst_len)) bst_len = 16;
+    rst_n        = 1'b0;
+    gen_req_vld  = 1'b0;
+    gen_req_read = 1'b0;
+    gen_req_addr = {ALEN{1'b0}};
+    gen_req_len  = 4'd0;
+    gen_req_wrap = 1'b0;
+    gen_req_mask = {MLEN{1'b1}};
+    gen_req_data = {DLEN{1'b0}};
+    rsp_cnt      = 0;
+    err_cnt      = 0;
+    cyc          = 0;
+    #(CLK_PERIOD * RST_CYCLES)
+    rst_n        = 1'b1;
+    @(posedge clk);
+
+    // Write bursts, each beat with its own address.
+    t0 = cyc;
+    for (i = 0; i < BYTES / MLEN; i = i + bst_len) begin
+        for (j = 0; j < bst_len; j = j + 1) begin
+            bus_req(1'b0, (i + j) * MLEN, bst_len - 1);
+        end
+    end
+    gen_req_vld <= #UDLY 1'b0;
+    while (rsp_cnt < BYTES / MLEN) @(posedge clk);
+    t1 = cyc;
+    report("WRITE", t1 - t0);
+
+    // Read bursts, each requested once.
+    t0 = cyc;
+    for (i = 0; i < BYTES / MLEN; i = i + bst_len) begin
+        bus_req(1'b1, i * MLEN, bst_len - 1);
+    end
+    gen_req_vld <= #UDLY 1'b0;
+    while (rsp_cnt < BYTES / MLEN * 2) @(posedge clk);
+    t1 = cyc;
+    report("READ", t1 - t0);
+
+    $display("> AXI %0s with bursts of %0d beats, %0d errors.", err_cnt ? "FAILED" : "PASSED", bst_len, err_cnt);
+    $finish;
+end
+
+`ifdef DUMP_VCD
+initial begin
+    $dumpfile("tb_axi_top.vcd");
+    $dumpvars(0, tb_axi_top);
+end
+`endif
+
+uv_bus_to_axi
+#(
+    .ALEN               ( ALEN              ),
+    .DLEN               ( DLEN              ),
+    .MLEN               ( MLEN              ),
+    .AXI_IDW            ( AXI_IDW           ),
+    .RD_OST             ( OST_NUM           ),
+    .WR_OST             ( OST_NUM           )
+)
+u_to_axi
+(
+    .clk                ( clk               ),
+    .rst_n              ( rst_n             ),
+
+    .bus_req_vld        ( gen_req_vld       ),
+    .bus_req_rdy        ( gen_req_rdy       ),
+    .bus_req_read       ( gen_req_read      ),
+    .bus_req_addr       ( gen_req_addr      ),
+    .bus_req_len        ( gen_req_len       ),
+    .bus_req_wrap       ( gen_req_wrap      ),
+    .bus_req_mask       ( gen_req_mask      ),
+    .bus_req_data       ( gen_req_data      ),
+
+    .bus_rsp_vld        ( gen_rsp_vld       ),
+    .bus_rsp_rdy        ( gen_rsp_rdy       ),
+    .bus_rsp_excp       ( gen_rsp_excp      ),
+    .bus_rsp_data       ( gen_rsp_data      ),
+
+    .axi_awid           ( a_awid            ),
+    .axi_awaddr         ( a_awaddr          ),
+    .axi_awlen          ( a_awlen           ),
+    .axi_awsize         ( a_awsize          ),
+    .axi_awburst        ( a_awburst         ),
+    .axi_awlock         (                   ),
+    .axi_awcache        (                   ),
+    .axi_awprot         (                   ),
+    .axi_awvalid        ( a_awvalid         ),
+    .axi_awready        ( a_awready         ),
+
+    .axi_wdata          ( a_wdata           ),
+    .axi_wstrb          ( a_wstrb           ),
+    .axi_wlast          ( a_wlast           ),
+    .axi_wvalid         ( a_wvalid          ),
+    .axi_wready         ( a_wready          ),
+
+    .axi_bid            ( a_bid             ),
+    .axi_bresp          ( a_bresp           ),
+    .axi_bvalid         ( a_bvalid          ),
+    .axi_bready         ( a_bready          ),
+
+    .axi_arid           ( a_arid            ),
+    .axi_araddr         ( a_araddr          ),
+    .axi_arlen          ( a_arlen           ),
+    .axi_arsize         ( a_arsize          ),
+    .axi_arburst        ( a_arburst         ),
+    .axi_arlock         (                   ),
+    .axi_arcache        (                   ),
+    .axi_arprot         (                   ),
+    .axi_arvalid        ( a_arvalid         ),
+    .axi_arready        ( a_arready         ),
+
+    .axi_rid            ( a_rid             ),
+    .axi_rdata          ( a_rdata           ),
+    .axi_rresp          ( a_rresp           ),
+    .axi_rlast          ( a_rlast           ),
+    .axi_rvalid         ( a_rvalid          ),
+    .axi_rready         ( a_rready          )
+);
+
+`ifdef AXI_LOOP
+uv_axi_to_bus
+#(
+    .ALEN               ( ALEN              ),
+    .DLEN               ( DLEN              ),
+    .MLEN               ( MLEN              ),
+    .AXI_IDW            ( AXI_IDW           ),
+    .RD_OST             ( OST_NUM           ),
+    .WR_OST             ( OST_NUM           ),
+    .OST_NUM            ( OST_NUM           )
+)
+u_axi_to_bus
+(
+    .clk                ( clk               ),
+    .rst_n              ( rst_n             ),
+
+    .axi_awid           ( a_awid            ),
+    .axi_awaddr         ( a_awaddr          ),
+    .axi_awlen          ( a_awlen           ),
+    .axi_awsize         ( a_awsize          ),
+    .axi_awburst        ( a_awburst         ),
+    .axi_awvalid        ( a_awvalid         ),
+    .axi_awready        ( a_awready         ),
+
+    .axi_wdata          ( a_wdata           ),
+    .axi_wstrb          ( a_wstrb           ),
+    .axi_wlast          ( a_wlast           ),
+    .axi_wvalid         ( a_wvalid          ),
+    .axi_wready         ( a_wready          ),
+
+    .axi_bid            ( a_bid             ),
+    .axi_bresp          ( a_bresp           ),
+    .axi_bvalid         ( a_bvalid          ),
+    .axi_bready         ( a_bready          ),
+
+    .axi_arid           ( a_arid            ),
+    .axi_araddr         ( a_araddr          ),
+    .axi_arlen          ( a_arlen           ),
+    .axi_arsize         ( a_arsize          ),
+    .axi_arburst        ( a_arburst         ),
+    .axi_arvalid        ( a_arvalid         ),
+    .axi_arready        ( a_arready         ),
+
+    .axi_rid            ( a_rid             ),
+    .axi_rdata          ( a_rdata           ),
+    .axi_rresp          ( a_rresp           ),
+    .axi_rlast          ( a_rlast           ),
+    .axi_rvalid         ( a_rvalid          ),
+    .axi_rready         ( a_rready          ),
+
+    .bus_req_vld        ( lp_req_vld        ),
+    .bus_req_rdy        ( lp_req_rdy        ),
+    .bus_req_read       ( lp_req_read       ),
+    .bus_req_addr       ( lp_req_addr       ),
+    .bus_req_len        ( lp_req_len        ),
+    .bus_req_wrap       ( lp_req_wrap       ),
+    .bus_req_mask       ( lp_req_mask       ),
+    .bus_req_data       ( lp_req_data       ),
+
+    .bus_rsp_vld        ( lp_rsp_vld        ),
+    .bus_rsp_rdy        ( lp_rsp_rdy        ),
+    .bus_rsp_excp       ( lp_rsp_excp       ),
+    .bus_rsp_data       ( lp_rsp_data       )
+);
+
+uv_bus_to_axi
+#(
+    .ALEN               ( ALEN              ),
+    .DLEN               ( DLEN              ),
+    .MLEN               ( MLEN              ),
+    .AXI_IDW            ( AXI_IDW           ),
+    .RD_OST             ( OST_NUM           ),
+    .WR_OST             ( OST_NUM           )
+)
+u_lp_to_axi
+(
+    .clk                ( clk               ),
+    .rst_n              ( rst_n             ),
+
+    .bus_req_vld        ( lp_req_vld        ),
+    .bus_req_rdy        ( lp_req_rdy        ),
+    .bus_req_read       ( lp_req_read       ),
+    .bus_req_addr       ( lp_req_addr       ),
+    .bus_req_len        ( lp_req_len        ),
+    .bus_req_wrap       ( lp_req_wrap       ),
+    .bus_req_mask       ( lp_req_mask       ),
+    .bus_req_data       ( lp_req_data       ),
+
+    .bus_rsp_vld        ( lp_rsp_vld        ),
+    .bus_rsp_rdy        ( lp_rsp_rdy        ),
+    .bus_rsp_excp       ( lp_rsp_excp       ),
+    .bus_rsp_data       ( lp_rsp_data       ),
+
+    .axi_awid           ( m_awid            ),
+    .axi_awaddr         ( m_awaddr          ),
+    .axi_awlen          ( m_awlen           ),
+    .axi_awsize         ( m_awsize          ),
+    .axi_awburst        ( m_awburst         ),
+    .axi_awlock         (                   ),
+    .axi_awcache        (                   ),
+    .axi_awprot         (                   ),
+    .axi_awvalid        ( m_awvalid         ),
+    .axi_awready        ( m_awready         ),
+
+    .axi_wdata          ( m_wdata           ),
+    .axi_wstrb          ( m_wstrb           ),
+    .axi_wlast          ( m_wlast           ),
+    .axi_wvalid         ( m_wvalid          ),
+    .axi_wready         ( m_wready          ),
+
+    .axi_bid            ( m_bid             ),
+    .axi_bresp          ( m_bresp           ),
+    .axi_bvalid         ( m_bvalid          ),
+    .axi_bready         ( m_bready          ),
+
+    .axi_arid           ( m_arid            ),
+    .axi_araddr         ( m_araddr          ),
+    .axi_arlen          ( m_arlen           ),
+    .axi_arsize         ( m_arsize          ),
+    .axi_arburst        ( m_arburst         ),
+    .axi_arlock         (                   ),
+    .axi_arcache        (                   ),
+    .axi_arprot         (                   ),
+    .axi_arvalid        ( m_arvalid         ),
+    .axi_arready        ( m_arready         ),
+
+    .axi_rid            ( m_rid             ),
+    .axi_rdata          ( m_rdata           ),
+    .axi_rresp          ( m_rresp           ),
+    .axi_rlast          ( m_rlast           ),
+    .axi_rvalid         ( m_rvalid          ),
+    .axi_rready         ( m_rready          )
+);
+`else
+assign m_awid = a_awid;
+assign m_awaddr = a_awaddr;
+assign m_awlen = a_awlen;
+assign m_awsize = a_awsize;
+assign m_awburst = a_awburst;
+assign m_awvalid = a_awvalid;
+assign m_wdata = a_wdata;
+assign m_wstrb = a_wstrb;
+assign m_wlast = a_wlast;
+assign m_wvalid = a_wvalid;
+assign m_bready = a_bready;
+assign m_arid = a_arid;
+assign m_araddr = a_araddr;
+assign m_arlen = a_arlen;
+assign m_arsize = a_arsize;
+assign m_arburst = a_arburst;
+assign m_arvalid = a_arvalid;
+assign m_rready = a_rready;
+assign a_awready = m_awready;
+assign a_wready = m_wready;
+assign a_bid = m_bid;
+assign a_bresp = m_bresp;
+assign a_bvalid = m_bvalid;
+assign a_arready = m_arready;
+assign a_rid = m_rid;
+assign a_rdata = m_rdata;
+assign a_rresp = m_rresp;
+assign a_rlast = m_rlast;
+assign a_rvalid = m_rvalid;
+`endif
+
+tb_axi_mem
+#(
+    .ALEN               ( ALEN              ),
+    .DLEN               ( DLEN              ),
+    .MLEN               ( MLEN              ),
+    .AXI_IDW            ( AXI_IDW           )
+)
+u_axi_mem
+(
+    .clk                ( clk               ),
+    .rst_n              ( rst_n             ),
+
+    .axi_awid           ( m_awid            ),
+    .axi_awaddr         ( m_awaddr          ),
+    .axi_awlen          ( m_awlen           ),
+    .axi_awsize         ( m_awsize          ),
+    .axi_awburst        ( m_awburst         ),
+    .axi_awvalid        ( m_awvalid         ),
+    .axi_awready        ( m_awready         ),
+
+    .axi_wdata          ( m_wdata           ),
+    .axi_wstrb          ( m_wstrb           ),
+    .axi_wlast          ( m_wlast           ),
+    .axi_wvalid         ( m_wvalid          ),
+    .axi_wready         ( m_wready          ),
+
+    .axi_bid            ( m_bid             ),
+    .axi_bresp          ( m_bresp           ),
+    .axi_bvalid         ( m_bvalid          ),
+    .axi_bready         ( m_bready          ),
+
+    .axi_arid           ( m_arid            ),
+    .axi_araddr         ( m_araddr          ),
+    .axi_arlen          ( m_arlen           ),
+    .axi_arsize         ( m_arsize          ),
+    .axi_arburst        ( m_arburst         ),
+    .axi_arvalid        ( m_arvalid         ),
+    .axi_arready        ( m_arready         ),
+
+    .axi_rid            ( m_rid             ),
+    .axi_rdata          ( m_rdata           ),
+    .axi_rresp          ( m_rresp           ),
+    .axi_rlast          ( m_rlast           ),
+    .axi_rvalid         ( m_rvalid          ),
+    .axi_rready         ( m_rready          )
+);
+
+endmodule
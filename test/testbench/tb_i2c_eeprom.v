@@ -0,0 +1,196 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_i2c_eeprom
+//
+// Designer: Owen
+//
+// Description:
+//      Behavioral model of a 24C02-like I2C EEPROM, timed in
+//      real time and independent of the DUT clock. A write
+//      sets the word address by its first byte, then fills a
+//      page buffer which wraps in the page, and is programmed
+//      at STOP. The device NACKs its address while programming,
+//      so the master can poll for the end of write. Reads go
+//      on from the word address till NACK by master. SCL is
+//      stretched at each address ACK like a slow sensor, and
+//      transfers are reported at the end of simulation.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_i2c_eeprom
+#(
+    parameter DEV_ADDR              = 7'h50,
+    parameter MEM_SIZE              = 256,
+    parameter PAGE_SIZE             = 16,
+    parameter T_WR_NS               = 100000,
+    parameter STRETCH_NS            = 2000,
+    parameter HOLD_NS               = 50
+)
+(
+    input                           i2c_scl,
+    input                           i2c_sda,
+    output reg                      scl_low,
+    output reg                      sda_low
+);
+
+    reg  [7:0]                      mem [0:MEM_SIZE-1];
+    reg  [7:0]                      page [0:PAGE_SIZE-1];
+    reg  [7:0]                      sft;
+    reg  [7:0]                      word_addr;
+    reg  [7:0]                      page_addr;
+    reg                             ack;
+    time                            wr_end;
+    integer                         page_cnt;
+    integer                         tran_cnt;
+    integer                         wr_cnt;
+    integer                         rd_cnt;
+    integer                         nack_cnt;
+    integer                         strch_cnt;
+    integer                         i;
+
+    initial begin
+        for (i = 0; i < MEM_SIZE; i = i + 1) begin
+            mem[i] = 8'hff;
+        end
+        scl_low   = 1'b0;
+        sda_low   = 1'b0;
+        word_addr = 8'h00;
+        wr_end    = 0;
+        page_cnt  = 0;
+        tran_cnt  = 0;
+        wr_cnt    = 0;
+        rd_cnt    = 0;
+        nack_cnt  = 0;
+        strch_cnt = 0;
+    end
+
+    // A (repeated) START restarts the transfer.
+    always @(negedge i2c_sda) begin
+        if (i2c_scl === 1'b1) begin
+            disable run_xfer;
+            #0;
+            sda_low = 1'b0;
+            scl_low = 1'b0;
+            fork
+                run_xfer;
+            join_none
+        end
+    end
+
+    // A STOP programs the page written.
+    always @(posedge i2c_sda) begin
+        if (i2c_scl === 1'b1) begin
+            disable run_xfer;
+            sda_low = 1'b0;
+            scl_low = 1'b0;
+            if (page_cnt > 0) begin
+                for (i = 0; i < page_cnt && i < PAGE_SIZE; i = i + 1) begin
+                    mem[(page_addr & ~(PAGE_SIZE - 1)) | ((page_addr + i) % PAGE_SIZE)] = page[i];
+                end
+                $display("> I2C EEPROM: write %0d bytes at %h.", page_cnt, page_addr);
+                page_cnt = 0;
+                wr_end   = $time + T_WR_NS;
+            end
+        end
+    end
+
+    task run_xfer;
+    begin : xfer
+        page_cnt = 0;
+
+        // Address.
+        recv_byte;
+        if ((sft[7:1] != DEV_ADDR) || ($time < wr_end)) begin
+            if (sft[7:1] == DEV_ADDR) begin
+                nack_cnt = nack_cnt + 1;
+            end
+            disable xfer;
+        end
+        tran_cnt = tran_cnt + 1;
+        send_ack(1'b1);
+
+        if (~sft[0]) begin
+            // Word address, then data.
+            recv_byte;
+            word_addr = sft;
+            page_addr = sft;
+            send_ack(1'b0);
+            forever begin
+                recv_byte;
+                page[page_cnt % PAGE_SIZE] = sft;
+                page_cnt = page_cnt + 1;
+                wr_cnt   = wr_cnt + 1;
+                send_ack(1'b0);
+            end
+        end
+        else begin
+            ack = 1'b1;
+            while (ack) begin
+                send_byte(mem[word_addr % MEM_SIZE]);
+                word_addr = word_addr + 1'b1;
+                rd_cnt    = rd_cnt + 1;
+            end
+        end
+    end
+    endtask
+
+    // Sample bits at SCL rising, and end at SCL falling after the 8th bit.
+    task recv_byte;
+        integer n;
+    begin
+        for (n = 0; n < 8; n = n + 1) begin
+            @(posedge i2c_scl);
+            sft = {sft[6:0], i2c_sda};
+        end
+        @(negedge i2c_scl);
+    end
+    endtask
+
+    // ACK in the 9th clock, with SCL stretched after the address.
+    task send_ack;
+        input strch;
+    begin
+        #(HOLD_NS);
+        sda_low = 1'b1;
+        if (strch && (STRETCH_NS > 0)) begin
+            scl_low   = 1'b1;
+            strch_cnt = strch_cnt + 1;
+            #(STRETCH_NS);
+            scl_low   = 1'b0;
+        end
+        @(posedge i2c_scl);
+        @(negedge i2c_scl);
+        #(HOLD_NS);
+        sda_low = 1'b0;
+    end
+    endtask
+
+    // Drive bits after SCL falling, then sample ACK of master.
+    task send_byte;
+        input [7:0] dat;
+        integer n;
+    begin
+        for (n = 7; n >= 0; n = n - 1) begin
+            if (n != 7) begin
+                @(negedge i2c_scl);
+            end
+            #(HOLD_NS);
+            sda_low = ~dat[n];
+        end
+        @(negedge i2c_scl);
+        #(HOLD_NS);
+        sda_low = 1'b0;
+        @(posedge i2c_scl);
+        ack = ~i2c_sda;
+        @(negedge i2c_scl);
+    end
+    endtask
+
+    final begin
+        $display("> I2C EEPROM: %0d transfers, %0d bytes written, %0d bytes read, %0d busy NACKs, %0d stretches.",
+                 tran_cnt, wr_cnt, rd_cnt, nack_cnt, strch_cnt);
+    end
+
+endmodule
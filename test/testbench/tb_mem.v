@@ -11,7 +11,83 @@
 
 reg [MAX_STRING_LEN*8-1:0] inst_file;
 reg [7:0]       inst_buf[0:INST_MEM_DEPTH*4-1];
+reg [DAM_WORD_BYTES*8-1:0] inst_word;
 integer         inst_idx;
+integer         byte_idx;
+reg [31:0]      qspi_cfg;
+reg [31:0]      qspi_cfg_hi;
+
+// Backdoor access to a DAM word, following the bank mapping of uv_dam.
+task read_dam_word;
+    input  [31:0]   widx;
+    output [DAM_WORD_BYTES*8-1:0] word;
+    integer         bank;
+    integer         idx;
+begin
+    bank = DAM_BANK_ILV ? widx % DAM_BANK_NUM : widx / DAM_BANK_WORDS;
+    idx  = DAM_BANK_ILV ? widx / DAM_BANK_NUM : widx % DAM_BANK_WORDS;
+    case (bank)
+        0: word = `DAM_BANK0[idx];
+        1: word = `DAM_BANK1[idx];
+`ifdef DAM_BANK_QUAD
+        2: word = `DAM_BANK2[idx];
+        3: word = `DAM_BANK3[idx];
+`endif
+        default: word = {DAM_WORD_BYTES*8{1'bx}};
+    endcase
+end
+endtask
+
+task write_dam_word;
+    input  [31:0]   widx;
+    input  [DAM_WORD_BYTES*8-1:0] word;
+    integer         bank;
+    integer         idx;
+begin
+    bank = DAM_BANK_ILV ? widx % DAM_BANK_NUM : widx / DAM_BANK_WORDS;
+    idx  = DAM_BANK_ILV ? widx / DAM_BANK_NUM : widx % DAM_BANK_WORDS;
+    case (bank)
+        0: `DAM_BANK0[idx] = word;
+        1: `DAM_BANK1[idx] = word;
+`ifdef DAM_BANK_QUAD
+        2: `DAM_BANK2[idx] = word;
+        3: `DAM_BANK3[idx] = word;
+`endif
+        default: ;
+    endcase
+end
+endtask
+
+`ifdef CLST_HART_NUM
+// Backdoor access to a 32-bit word of cluster shared memory, interleaved on word address.
+task read_smem_word;
+    input  [31:0]   widx;
+    output [31:0]   word;
+begin
+    case (widx % SMEM_BANK_NUM)
+        0: word = `SMEM_BANK0[widx / SMEM_BANK_NUM];
+        1: word = `SMEM_BANK1[widx / SMEM_BANK_NUM];
+        2: word = `SMEM_BANK2[widx / SMEM_BANK_NUM];
+        3: word = `SMEM_BANK3[widx / SMEM_BANK_NUM];
+        default: word = 32'bx;
+    endcase
+end
+endtask
+
+task write_smem_word;
+    input  [31:0]   widx;
+    input  [31:0]   word;
+begin
+    case (widx % SMEM_BANK_NUM)
+        0: `SMEM_BANK0[widx / SMEM_BANK_NUM] = word;
+        1: `SMEM_BANK1[widx / SMEM_BANK_NUM] = word;
+        2: `SMEM_BANK2[widx / SMEM_BANK_NUM] = word;
+        3: `SMEM_BANK3[widx / SMEM_BANK_NUM] = word;
+        default: ;
+    endcase
+end
+endtask
+`endif
 
 initial begin
     for (inst_idx = 0; inst_idx < INST_MEM_DEPTH*4; inst_idx = inst_idx + 1) begin
@@ -20,31 +96,74 @@ initial begin
 
     if ($value$plusargs("INST_FILE=%s", inst_file)) begin
         $readmemh(inst_file, inst_buf);
+        for (inst_idx = 0; inst_idx < INST_MEM_DEPTH*4 / DAM_WORD_BYTES; inst_idx = inst_idx + 1) begin
+            for (byte_idx = 0; byte_idx < DAM_WORD_BYTES; byte_idx = byte_idx + 1) begin
+                inst_word[byte_idx*8+:8] = inst_buf[inst_idx*DAM_WORD_BYTES+byte_idx];
+            end
+            write_dam_word(inst_idx, inst_word);
+        end
+`ifdef CLST_HART_NUM
+        // Data of the image are accessed in shared memory.
         for (inst_idx = 0; inst_idx < INST_MEM_DEPTH; inst_idx = inst_idx + 1) begin
-            `INST_MEM[inst_idx] = {
-                                    inst_buf[inst_idx*4+3],
-                                    inst_buf[inst_idx*4+2],
-                                    inst_buf[inst_idx*4+1],
-                                    inst_buf[inst_idx*4+0]
-                                };
+            write_smem_word(inst_idx, {inst_buf[inst_idx*4+3], inst_buf[inst_idx*4+2],
+                                       inst_buf[inst_idx*4+1], inst_buf[inst_idx*4]});
+        end
+`endif
+    end
+    else if ($test$plusargs("EFLASH_FILE")) begin
+        // Boot stub to execute in place from eFlash.
+        write_dam(32'h80000000, 32'h200002b7);  // lui  t0, 0x20000
+        write_dam(32'h80000004, 32'h00028067);  // jalr x0, 0(t0)
+    end
+    else if ($test$plusargs("QSPI_FILE")) begin
+        // Boot stub to execute in place from QSPI flash, with XIP configured by +QSPI_CFG.
+        if (!$value$plusargs("QSPI_CFG=%h", qspi_cfg)) begin
+            qspi_cfg = 32'h00A0EB47;
         end
+        qspi_cfg_hi = (qspi_cfg + 32'h800) >> 12;
+        write_dam(32'h80000000, 32'h700202b7);  // lui  t0, 0x70020
+        write_dam(32'h80000004, {qspi_cfg_hi[19:0], 12'h337});   // lui  t1, %hi(cfg)
+        write_dam(32'h80000008, {qspi_cfg[11:0], 20'h30313});    // addi t1, t1, %lo(cfg)
+        write_dam(32'h8000000c, 32'h0462a023);  // sw   t1, 0x40(t0)
+        write_dam(32'h80000010, 32'h300002b7);  // lui  t0, 0x30000
+        write_dam(32'h80000014, 32'h00028067);  // jalr x0, 0(t0)
     end
     else begin
         $display("No instruction file!");
     end
 end
 
+`ifdef CLST_HART_NUM
+// Other harts fetch the same image from their own IDAMs.
+genvar clst_hart;
+generate
+    for (clst_hart = 1; clst_hart < `CLST_HART_NUM; clst_hart = clst_hart + 1) begin: gen_clst_idam
+        integer k;
+        initial begin
+            #1;
+            for (k = 0; k < DAM_BANK_WORDS; k = k + 1) begin
+                DUT.u_clst.gen_hart[clst_hart].u_idam.gen_bank_ilv.gen_bank[0].u_bank.ram[k] = `DAM_BANK0[k];
+                DUT.u_clst.gen_hart[clst_hart].u_idam.gen_bank_ilv.gen_bank[1].u_bank.ram[k] = `DAM_BANK1[k];
+            end
+        end
+    end
+endgenerate
+`endif
+
+// Backdoor access with byte address, which must be 32-bit aligned.
+// Data memory is the shared memory in a cluster.
 task read_dam;
     input  [31:0]   addr;
     output [31:0]   data;
+    reg    [DAM_WORD_BYTES*8-1:0] word;
 begin
     if (addr & 32'h80000000) begin
-        if (addr[15:0] < 16'h8000) begin
-            data = `INST_MEM[addr[15:0]];
-        end
-        else begin
-            data = `DATA_MEM[addr[15:0] - 16'h8000];
-        end
+`ifdef CLST_HART_NUM
+        read_smem_word(addr[30:2], data);
+`else
+        read_dam_word(addr[16:DAM_WORD_AW], word);
+        data = word >> {addr[DAM_WORD_AW-1:2], 5'b0};
+`endif
     end
     else begin
         $display("Fatal: Unexpected DAM reading address 0x%08h!", addr);
@@ -56,14 +175,15 @@ endtask
 task write_dam;
     input  [31:0]   addr;
     input  [31:0]   data;
+    reg    [DAM_WORD_BYTES*8-1:0] word;
 begin
     if (addr & 32'h80000000) begin
-        if (addr[15:0] < 16'h8000) begin
-            `INST_MEM[addr[15:0]] = data;
-        end
-        else begin
-            `DATA_MEM[addr[15:0] - 16'h8000] = data;
-        end
+        read_dam_word(addr[16:DAM_WORD_AW], word);
+        word[{addr[DAM_WORD_AW-1:2], 5'b0}+:32] = data;
+        write_dam_word(addr[16:DAM_WORD_AW], word);
+`ifdef CLST_HART_NUM
+        write_smem_word(addr[30:2], data);
+`endif
     end
     else begin
         $display("Fatal: Unexpected DAM writing address 0x%08h!", addr);
@@ -71,3 +191,32 @@ begin
     end
 end
 endtask
+
+// DAM port stalls, mostly caused by bank conflicts.
+integer         dam_i_stall_cnt;
+integer         dam_d_stall_cnt;
+integer         dam_d_req_cnt;
+
+always @(posedge clk or negedge rst_n) begin
+    if (~rst_n) begin
+        dam_i_stall_cnt <= 0;
+        dam_d_stall_cnt <= 0;
+        dam_d_req_cnt   <= 0;
+    end
+    else begin
+        if (`DAM.port_a_req_vld & ~`DAM.port_a_req_rdy) begin
+            dam_i_stall_cnt <= dam_i_stall_cnt + 1;
+        end
+        if (`DAM.port_b_req_vld & ~`DAM.port_b_req_rdy) begin
+            dam_d_stall_cnt <= dam_d_stall_cnt + 1;
+        end
+        if (`DAM.port_b_req_vld & `DAM.port_b_req_rdy) begin
+            dam_d_req_cnt   <= dam_d_req_cnt + 1;
+        end
+    end
+end
+
+final begin
+    $display("> DAM stalls: %0d fetch, %0d load/store in %0d data accesses.",
+             dam_i_stall_cnt, dam_d_stall_cnt, dam_d_req_cnt);
+end
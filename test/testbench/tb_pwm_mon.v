@@ -0,0 +1,98 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_pwm_mon
+//
+// Designer: Owen
+//
+// Description:
+//      Monitor of complementary PWM outputs. The period, high
+//      time & duty of P outputs are measured from rising edge
+//      to rising edge, the dead time from a falling edge of one
+//      output to the rising edge of the other, and any overlap
+//      of P & N is counted as error. The last measures of each
+//      channel are reported at the end of simulation.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_pwm_mon
+#(
+    parameter PWM_CH                = 4
+)
+(
+    input  [PWM_CH-1:0]             pwm_p,
+    input  [PWM_CH-1:0]             pwm_n
+);
+
+    genvar i;
+
+    time                            p_rise   [0:PWM_CH-1];
+    time                            p_fall   [0:PWM_CH-1];
+    time                            n_fall   [0:PWM_CH-1];
+    time                            prd      [0:PWM_CH-1];
+    time                            high     [0:PWM_CH-1];
+    time                            dead_min [0:PWM_CH-1];
+    integer                         prd_cnt  [0:PWM_CH-1];
+    integer                         ovl_cnt  [0:PWM_CH-1];
+    integer                         n;
+
+    initial begin
+        for (n = 0; n < PWM_CH; n = n + 1) begin
+            p_rise[n]   = 0;
+            p_fall[n]   = 0;
+            n_fall[n]   = 0;
+            prd[n]      = 0;
+            high[n]     = 0;
+            dead_min[n] = 0;
+            prd_cnt[n]  = 0;
+            ovl_cnt[n]  = 0;
+        end
+    end
+
+    generate
+        for (i = 0; i < PWM_CH; i = i + 1) begin: gen_mon_ch
+            always @(posedge pwm_p[i]) begin
+                if (p_rise[i] > 0) begin
+                    prd[i]     = $time - p_rise[i];
+                    high[i]    = p_fall[i] - p_rise[i];
+                    prd_cnt[i] = prd_cnt[i] + 1;
+                end
+                if ((n_fall[i] > 0) && ((dead_min[i] == 0) || ($time - n_fall[i] < dead_min[i]))) begin
+                    dead_min[i] = $time - n_fall[i];
+                end
+                p_rise[i] = $time;
+            end
+
+            always @(negedge pwm_p[i]) begin
+                p_fall[i] = $time;
+            end
+
+            always @(posedge pwm_n[i]) begin
+                if ((p_fall[i] > 0) && ((dead_min[i] == 0) || ($time - p_fall[i] < dead_min[i]))) begin
+                    dead_min[i] = $time - p_fall[i];
+                end
+            end
+
+            always @(negedge pwm_n[i]) begin
+                n_fall[i] = $time;
+            end
+
+            always @(pwm_p[i] or pwm_n[i]) begin
+                if ((pwm_p[i] === 1'b1) && (pwm_n[i] === 1'b1)) begin
+                    ovl_cnt[i] = ovl_cnt[i] + 1;
+                end
+            end
+        end
+    endgenerate
+
+    final begin
+        for (n = 0; n < PWM_CH; n = n + 1) begin
+            if (prd_cnt[n] > 0) begin
+                $display("> PWM %0d: %0d periods of %0d ns, high %0d ns, duty %0d/1000, dead time %0d ns, %0d overlaps.",
+                         n, prd_cnt[n], prd[n], high[n], high[n] * 1000 / prd[n], dead_min[n], ovl_cnt[n]);
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,242 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_sdram
+//
+// Designer: Owen
+//
+// Description:
+//      Behavioral model of SDR SDRAM with burst length of
+//      BURST_LEN & CAS latency of T_CL. The tRCD, tRP, tRAS,
+//      tWR, tRFC & tMRD between commands are checked against
+//      the given cycles. Only the lower 2^MEM_AW words are
+//      modeled. Command counters & row hits are reported at
+//      the end of simulation.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_sdram
+#(
+    parameter DQ_DW                 = 16,
+    parameter BA_AW                 = 2,
+    parameter ROW_AW                = 13,
+    parameter COL_AW                = 9,
+    parameter MEM_AW                = 20,
+    parameter BURST_LEN             = 8,
+    parameter T_RCD                 = 2,
+    parameter T_CL                  = 2,   // No less than 2.
+    parameter T_RP                  = 2,
+    parameter T_RAS                 = 5,
+    parameter T_WR                  = 2,
+    parameter T_RFC                 = 7,
+    parameter T_MRD                 = 2
+)
+(
+    input                           clk,
+    input                           cke,
+    input                           cs_n,
+    input                           ras_n,
+    input                           cas_n,
+    input                           we_n,
+    input  [BA_AW-1:0]              ba,
+    input  [ROW_AW-1:0]             addr,
+    input  [DQ_DW/8-1:0]            dqm,
+    inout  [DQ_DW-1:0]              dq
+);
+
+    localparam DQ_MW                = DQ_DW / 8;
+    localparam BANK_NUM             = 2**BA_AW;
+    localparam NEVER                = -1000000;
+
+    reg  [DQ_DW-1:0]                mem [0:2**MEM_AW-1];
+
+    reg                             bank_open [0:BANK_NUM-1];
+    reg  [ROW_AW-1:0]               bank_row  [0:BANK_NUM-1];
+    integer                         act_cyc   [0:BANK_NUM-1];
+    integer                         pre_cyc   [0:BANK_NUM-1];
+    integer                         wr_cyc    [0:BANK_NUM-1];
+    integer                         ref_cyc;
+    integer                         mrs_cyc;
+    reg                             mode_set;
+    integer                         cyc;
+    integer                         b;
+    integer                         k;
+
+    // Bursts.
+    integer                         rd_wait;
+    integer                         rd_beats;
+    reg  [MEM_AW-1:0]               rd_addr;
+    integer                         wr_beats;
+    reg  [BA_AW-1:0]                wr_bank;
+    reg  [MEM_AW-1:0]               wr_addr;
+
+    reg                             dq_oe;
+    reg  [DQ_DW-1:0]                dq_out;
+
+    // Statistics.
+    integer                         act_cnt;
+    integer                         rd_cnt;
+    integer                         wr_cnt;
+    integer                         pre_cnt;
+    integer                         ref_cnt;
+    integer                         err_cnt;
+    integer                         first_cyc;
+    integer                         last_cyc;
+
+    assign dq = dq_oe ? dq_out : {DQ_DW{1'bz}};
+
+    initial begin
+        for (b = 0; b < BANK_NUM; b = b + 1) begin
+            bank_open[b] = 1'b0;
+            bank_row[b]  = {ROW_AW{1'b0}};
+            act_cyc[b]   = NEVER;
+            pre_cyc[b]   = NEVER;
+            wr_cyc[b]    = NEVER;
+        end
+        ref_cyc   = NEVER;
+        mrs_cyc   = NEVER;
+        mode_set  = 1'b0;
+        cyc       = 0;
+        rd_wait   = 0;
+        rd_beats  = 0;
+        wr_beats  = 0;
+        dq_oe     = 1'b0;
+        dq_out    = {DQ_DW{1'b0}};
+        act_cnt   = 0;
+        rd_cnt    = 0;
+        wr_cnt    = 0;
+        pre_cnt   = 0;
+        ref_cnt   = 0;
+        err_cnt   = 0;
+        first_cyc = 0;
+        last_cyc  = 0;
+    end
+
+    task check;
+        input       cond;
+        input [8*8-1:0] name;
+    begin
+        if (~cond) begin
+            err_cnt = err_cnt + 1;
+            $display("> SDRAM ERROR: %0s violated at cycle %0d!", name, cyc);
+        end
+    end
+    endtask
+
+    function [MEM_AW-1:0] word_addr;
+        input [ROW_AW-1:0] row;
+        input [BA_AW-1:0]  bank;
+        input [ROW_AW-1:0] col;
+    begin
+        word_addr = {row, bank, col[COL_AW-1:0]};
+    end
+    endfunction
+
+    always @(posedge clk) begin
+        cyc = cyc + 1;
+
+        // Write beats following the command.
+        if (wr_beats > 0) begin
+            for (k = 0; k < DQ_MW; k = k + 1) begin
+                if (~dqm[k]) mem[wr_addr][k*8 +: 8] = dq[k*8 +: 8];
+            end
+            wr_addr  = wr_addr + 1'b1;
+            wr_beats = wr_beats - 1;
+            wr_cyc[wr_bank] = cyc;
+        end
+
+        // Read beats are driven T_CL cycles after the command.
+        if (rd_beats > 0) begin
+            if (rd_wait > 0) rd_wait = rd_wait - 1;
+            if (rd_wait == 0) begin
+                dq_oe    <= #1 1'b1;
+                dq_out   <= #1 mem[rd_addr];
+                rd_addr  = rd_addr + 1'b1;
+                rd_beats = rd_beats - 1;
+            end
+        end
+        else begin
+            dq_oe <= #1 1'b0;
+        end
+
+        if (cke & (~cs_n)) begin
+            case ({ras_n, cas_n, we_n})
+                3'b011: begin // ACT
+                    check(mode_set, "MODE");
+                    check(~bank_open[ba], "OPEN");
+                    check(cyc - pre_cyc[ba] >= T_RP, "tRP");
+                    check(cyc - ref_cyc >= T_RFC, "tRFC");
+                    check(cyc - mrs_cyc >= T_MRD, "tMRD");
+                    bank_open[ba] = 1'b1;
+                    bank_row[ba]  = addr;
+                    act_cyc[ba]   = cyc;
+                    act_cnt       = act_cnt + 1;
+                end
+                3'b101, 3'b100: begin // READ & WRITE
+                    check(bank_open[ba], "CLOSED");
+                    check(cyc - act_cyc[ba] >= T_RCD, "tRCD");
+                    if (first_cyc == 0) first_cyc = cyc;
+                    last_cyc = cyc + BURST_LEN;
+                    if (we_n) begin
+                        rd_wait  = T_CL - 1;
+                        rd_beats = BURST_LEN;
+                        rd_addr  = word_addr(bank_row[ba], ba, addr);
+                        rd_cnt   = rd_cnt + 1;
+                    end
+                    else begin
+                        wr_bank  = ba;
+                        wr_addr  = word_addr(bank_row[ba], ba, addr);
+                        for (k = 0; k < DQ_MW; k = k + 1) begin
+                            if (~dqm[k]) mem[wr_addr][k*8 +: 8] = dq[k*8 +: 8];
+                        end
+                        wr_addr  = wr_addr + 1'b1;
+                        wr_beats = BURST_LEN - 1;
+                        wr_cyc[ba] = cyc;
+                        wr_cnt   = wr_cnt + 1;
+                    end
+                end
+                3'b010: begin // PRE
+                    for (b = 0; b < BANK_NUM; b = b + 1) begin
+                        if ((addr[10] | (ba == b)) & bank_open[b]) begin
+                            check(cyc - act_cyc[b] >= T_RAS, "tRAS");
+                            check(cyc - wr_cyc[b] >= T_WR, "tWR");
+                            bank_open[b] = 1'b0;
+                            pre_cyc[b]   = cyc;
+                        end
+                    end
+                    pre_cnt = pre_cnt + 1;
+                end
+                3'b001: begin // REF
+                    for (b = 0; b < BANK_NUM; b = b + 1) begin
+                        check(~bank_open[b], "OPEN");
+                        check(cyc - pre_cyc[b] >= T_RP, "tRP");
+                    end
+                    check(cyc - ref_cyc >= T_RFC, "tRFC");
+                    ref_cyc = cyc;
+                    ref_cnt = ref_cnt + 1;
+                end
+                3'b000: begin // MRS
+                    for (b = 0; b < BANK_NUM; b = b + 1) begin
+                        check(~bank_open[b], "OPEN");
+                    end
+                    check(addr[2:0] == $clog2(BURST_LEN), "BL");
+                    check(addr[6:4] == T_CL, "CL");
+                    mode_set = 1'b1;
+                    mrs_cyc  = cyc;
+                end
+                default: ;
+            endcase
+        end
+    end
+
+    final begin
+        $display("> SDRAM: %0d ACT, %0d RD, %0d WR, %0d PRE, %0d REF, %0d row hits, %0d timing errors.",
+                 act_cnt, rd_cnt, wr_cnt, pre_cnt, ref_cnt, rd_cnt + wr_cnt - act_cnt, err_cnt);
+        if (last_cyc > first_cyc) begin
+            $display("> SDRAM: %0d data beats in %0d cycles from the first access.",
+                     (rd_cnt + wr_cnt) * BURST_LEN, last_cyc - first_cyc);
+        end
+    end
+
+endmodule
@@ -0,0 +1,218 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_spi_flash
+//
+// Designer: Owen
+//
+// Description:
+//      Behavioral model of serial NOR flash in SPI mode 0.
+//      Supported commands: read (0x03), fast read (0x0B),
+//      quad-I/O fast read (0xEB) with continuous-read mode,
+//      read status (0x05) & read JEDEC ID (0x9F). The content
+//      is loaded from +QSPI_FILE=<hex> with one byte per entry.
+//      Transfer counters are reported at the end of simulation
+//      for throughput measurement.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_spi_flash
+#(
+    parameter MEM_AW                = 22,
+    parameter QUAD_DUMMY            = 4,
+    parameter JEDEC_ID              = 24'hEF4016
+)
+(
+    input                           sck,
+    input                           cs_n,
+    inout  [3:0]                    io
+);
+
+    localparam MAX_STRING_LEN       = 256;
+
+    localparam ST_CMD               = 4'd0;
+    localparam ST_SADDR             = 4'd1;
+    localparam ST_SDUMY             = 4'd2;
+    localparam ST_SDATA             = 4'd3;
+    localparam ST_QADDR             = 4'd4;
+    localparam ST_QMODE             = 4'd5;
+    localparam ST_QDUMY             = 4'd6;
+    localparam ST_QDATA             = 4'd7;
+    localparam ST_STAT              = 4'd8;
+    localparam ST_RDID              = 4'd9;
+    localparam ST_NONE              = 4'd10;
+
+    reg  [7:0]                      mem [0:2**MEM_AW-1];
+    reg  [MAX_STRING_LEN*8-1:0]     mem_file;
+
+    reg  [3:0]                      state;
+    reg  [7:0]                      cmd;
+    reg  [23:0]                     addr;
+    reg  [7:0]                      mode;
+    reg  [7:0]                      dout;
+    reg                             cont_mode;
+    integer                         bit_cnt;
+
+    reg  [3:0]                      io_oe;
+    reg  [3:0]                      io_out;
+
+    integer                         sel_cnt;
+    integer                         cmd_cnt;
+    integer                         byte_cnt;
+
+    assign io[0] = io_oe[0] ? io_out[0] : 1'bz;
+    assign io[1] = io_oe[1] ? io_out[1] : 1'bz;
+    assign io[2] = io_oe[2] ? io_out[2] : 1'bz;
+    assign io[3] = io_oe[3] ? io_out[3] : 1'bz;
+
+    initial begin
+        if ($value$plusargs("QSPI_FILE=%s", mem_file)) begin
+            $display("> QSPI flash image: %0s", mem_file);
+            $readmemh(mem_file, mem);
+        end
+
+        state     = ST_CMD;
+        cont_mode = 1'b0;
+        io_oe     = 4'b0;
+        io_out    = 4'b0;
+        sel_cnt   = 0;
+        cmd_cnt   = 0;
+        byte_cnt  = 0;
+    end
+
+    function [7:0] read_byte;
+        input [23:0] a;
+    begin
+        // Erased bytes are not loaded from the image.
+        read_byte = ^mem[a[MEM_AW-1:0]] === 1'bx ? 8'hff : mem[a[MEM_AW-1:0]];
+    end
+    endfunction
+
+    // A new selection starts with the command, or the address in continuous-read mode.
+    always @(negedge cs_n) begin
+        sel_cnt = sel_cnt + 1;
+        bit_cnt = 0;
+        addr    = 24'b0;
+        if (cont_mode) begin
+            cmd   = 8'hEB;
+            state = ST_QADDR;
+        end
+        else begin
+            cmd   = 8'h00;
+            state = ST_CMD;
+        end
+    end
+
+    always @(posedge cs_n) begin
+        io_oe = 4'b0;
+        state = ST_NONE;
+    end
+
+    // Inputs are sampled on rising edges.
+    always @(posedge sck) begin
+        if (~cs_n) begin
+            case (state)
+                ST_CMD: begin
+                    cmd     = {cmd[6:0], io[0]};
+                    bit_cnt = bit_cnt + 1;
+                    if (bit_cnt == 8) begin
+                        bit_cnt = 0;
+                        cmd_cnt = cmd_cnt + 1;
+                        case (cmd)
+                            8'h03, 8'h0B: state = ST_SADDR;
+                            8'hEB       : state = ST_QADDR;
+                            8'h05       : state = ST_STAT;
+                            8'h9F       : state = ST_RDID;
+                            default     : state = ST_NONE;
+                        endcase
+                    end
+                end
+                ST_SADDR: begin
+                    addr    = {addr[22:0], io[0]};
+                    bit_cnt = bit_cnt + 1;
+                    if (bit_cnt == 24) begin
+                        bit_cnt = 0;
+                        state   = cmd == 8'h0B ? ST_SDUMY : ST_SDATA;
+                    end
+                end
+                ST_SDUMY: begin
+                    bit_cnt = bit_cnt + 1;
+                    if (bit_cnt == 8) begin
+                        bit_cnt = 0;
+                        state   = ST_SDATA;
+                    end
+                end
+                ST_QADDR: begin
+                    addr    = {addr[19:0], io};
+                    bit_cnt = bit_cnt + 1;
+                    if (bit_cnt == 6) begin
+                        bit_cnt = 0;
+                        state   = ST_QMODE;
+                    end
+                end
+                ST_QMODE: begin
+                    mode    = {mode[3:0], io};
+                    bit_cnt = bit_cnt + 1;
+                    if (bit_cnt == 2) begin
+                        bit_cnt   = 0;
+                        cont_mode = mode[5:4] == 2'b10;
+                        state     = QUAD_DUMMY == 0 ? ST_QDATA : ST_QDUMY;
+                    end
+                end
+                ST_QDUMY: begin
+                    bit_cnt = bit_cnt + 1;
+                    if (bit_cnt == QUAD_DUMMY) begin
+                        bit_cnt = 0;
+                        state   = ST_QDATA;
+                    end
+                end
+                default: ;
+            endcase
+        end
+    end
+
+    // Outputs are driven on falling edges.
+    always @(negedge sck) begin
+        if (~cs_n) begin
+            case (state)
+                ST_SDATA, ST_STAT, ST_RDID: begin
+                    if (bit_cnt == 0) begin
+                        case (state)
+                            ST_STAT: dout = 8'h00;
+                            ST_RDID: dout = JEDEC_ID >> ((2 - addr % 3) * 8);
+                            default: dout = read_byte(addr);
+                        endcase
+                        addr     = addr + 1'b1;
+                        byte_cnt = byte_cnt + 1;
+                    end
+                    io_oe     = 4'b0010;
+                    io_out[1] = dout[7 - bit_cnt];
+                    bit_cnt   = bit_cnt == 7 ? 0 : bit_cnt + 1;
+                end
+                ST_QDATA: begin
+                    if (bit_cnt == 0) begin
+                        dout     = read_byte(addr);
+                        addr     = addr + 1'b1;
+                        byte_cnt = byte_cnt + 1;
+                        io_out   = dout[7:4];
+                    end
+                    else begin
+                        io_out   = dout[3:0];
+                    end
+                    io_oe   = 4'b1111;
+                    bit_cnt = bit_cnt == 1 ? 0 : 1;
+                end
+                default: begin
+                    io_oe   = 4'b0;
+                end
+            endcase
+        end
+    end
+
+    final begin
+        $display("> QSPI flash: %0d selections, %0d commands, %0d bytes read.",
+                 sel_cnt, cmd_cnt, byte_cnt);
+    end
+
+endmodule
@@ -0,0 +1,139 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_spi_lcd
+//
+// Designer: Owen
+//
+// Description:
+//      Behavioral model of a SPI display in mode 0, MSB first.
+//      A byte is a command when D/C is low at its last bit, or
+//      a parameter of the last command, and a parameter count
+//      goes on over CS deassertion. CASET & RASET set the
+//      window, and RAMWR writes RGB565 pixels in it, high byte
+//      first. A frame is logged with its time & pixel sum when
+//      the window is filled.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_spi_lcd
+(
+    input                           spi_cs,
+    input                           spi_sck,
+    input                           spi_mosi,
+    input                           spi_dc
+);
+
+    localparam CMD_CASET            = 8'h2a;
+    localparam CMD_RASET            = 8'h2b;
+    localparam CMD_RAMWR            = 8'h2c;
+
+    reg  [7:0]                      sft;
+    reg  [7:0]                      cmd;
+    reg  [15:0]                     pix;
+    reg  [15:0]                     x0;
+    reg  [15:0]                     x1;
+    reg  [15:0]                     y0;
+    reg  [15:0]                     y1;
+    integer                         bit_cnt;
+    integer                         byte_cnt;
+    integer                         pix_cnt;
+    integer                         pix_num;
+    integer                         pix_sum;
+    integer                         frm_cnt;
+    integer                         err_cnt;
+    time                            frm_start;
+
+    initial begin
+        x0       = 16'd0;
+        x1       = 16'd239;
+        y0       = 16'd0;
+        y1       = 16'd239;
+        cmd      = 8'h00;
+        bit_cnt  = 0;
+        byte_cnt = 0;
+        pix_cnt  = 0;
+        pix_sum  = 0;
+        frm_cnt  = 0;
+        err_cnt  = 0;
+    end
+
+    // A transfer ends with a partial byte.
+    always @(posedge spi_cs) begin
+        if (bit_cnt != 0) begin
+            err_cnt = err_cnt + 1;
+        end
+        bit_cnt = 0;
+    end
+
+    always @(posedge spi_sck) begin
+        if (spi_cs === 1'b0) begin
+            sft     = {sft[6:0], spi_mosi};
+            bit_cnt = bit_cnt + 1;
+            if (bit_cnt == 8) begin
+                bit_cnt = 0;
+                if (spi_dc === 1'b0) begin
+                    byte_cnt = 0;
+                end
+                recv_byte(sft);
+                byte_cnt = byte_cnt + 1;
+            end
+        end
+    end
+
+    task recv_byte;
+        input [7:0] dat;
+    begin
+        if (byte_cnt == 0) begin
+            cmd = dat;
+            if (cmd == CMD_RAMWR) begin
+                pix_num   = (x1 - x0 + 1) * (y1 - y0 + 1);
+                pix_cnt   = 0;
+                pix_sum   = 0;
+                frm_start = $time;
+            end
+        end
+        else begin
+            case (cmd)
+                CMD_CASET: begin
+                    case (byte_cnt)
+                        1: x0[15:8] = dat;
+                        2: x0[7:0]  = dat;
+                        3: x1[15:8] = dat;
+                        4: x1[7:0]  = dat;
+                    endcase
+                end
+                CMD_RASET: begin
+                    case (byte_cnt)
+                        1: y0[15:8] = dat;
+                        2: y0[7:0]  = dat;
+                        3: y1[15:8] = dat;
+                        4: y1[7:0]  = dat;
+                    endcase
+                end
+                CMD_RAMWR: begin
+                    if (byte_cnt[0]) begin
+                        pix[15:8] = dat;
+                    end
+                    else begin
+                        pix[7:0] = dat;
+                        pix_sum  = pix_sum + pix;
+                        pix_cnt  = pix_cnt + 1;
+                        if (pix_cnt == pix_num) begin
+                            frm_cnt = frm_cnt + 1;
+                            $display("> SPI LCD: frame %0d of %0dx%0d in %0d ns, pixel sum %h.",
+                                     frm_cnt, x1 - x0 + 1, y1 - y0 + 1, $time - frm_start, pix_sum);
+                        end
+                    end
+                end
+            endcase
+        end
+    end
+    endtask
+
+    final begin
+        $display("> SPI LCD: %0d frames, %0d broken bytes.", frm_cnt, err_cnt);
+    end
+
+endmodule
@@ -0,0 +1,100 @@
+//************************************************************
+// See LICENSE for license details.
+//
+// Module: tb_uart_bfm
+//
+// Designer: Owen
+//
+// Description:
+//      Behavioral model of UART in 8N1, timed in real time and
+//      independent of the DUT clock. Bytes received are echoed
+//      back at the same baud rate, which can be changed by
+//      set_baud between transfers. Received bytes and framing
+//      errors are reported at the end of simulation.
+//************************************************************
+
+`timescale 1ns / 1ps
+
+module tb_uart_bfm
+#(
+    parameter BAUD_RATE             = 115200,
+    parameter QUE_DEPTH             = 4096
+)
+(
+    input                           uart_rx,
+    output reg                      uart_tx
+);
+
+    reg  [7:0]                      que [0:QUE_DEPTH-1];
+    reg  [7:0]                      rx_byte;
+    reg  [7:0]                      tx_byte;
+    real                            bit_ns;
+    integer                         wptr;
+    integer                         rptr;
+    integer                         rx_cnt;
+    integer                         err_cnt;
+    integer                         i;
+    integer                         j;
+
+    task set_baud;
+        input integer baud;
+    begin
+        bit_ns = 1000000000.0 / baud;
+        $display("> UART BFM: %0d baud.", baud);
+    end
+    endtask
+
+    initial begin
+        bit_ns  = 1000000000.0 / BAUD_RATE;
+        uart_tx = 1'b1;
+        wptr    = 0;
+        rptr    = 0;
+        rx_cnt  = 0;
+        err_cnt = 0;
+    end
+
+    // Sample in the middle of bits, from the falling edge of start bit.
+    initial begin
+        forever begin
+            @(negedge uart_rx);
+            #(bit_ns / 2.0);
+            if (uart_rx === 1'b0) begin
+                for (i = 0; i < 8; i = i + 1) begin
+                    #(bit_ns);
+                    rx_byte[i] = uart_rx;
+                end
+                #(bit_ns);
+                if (uart_rx !== 1'b1) begin
+                    err_cnt = err_cnt + 1;
+                end
+                else begin
+                    que[wptr % QUE_DEPTH] = rx_byte;
+                    wptr   = wptr + 1;
+                    rx_cnt = rx_cnt + 1;
+                end
+            end
+        end
+    end
+
+    // Echo received bytes.
+    initial begin
+        forever begin
+            wait (rptr != wptr);
+            tx_byte = que[rptr % QUE_DEPTH];
+            rptr    = rptr + 1;
+            uart_tx = 1'b0;
+            for (j = 0; j < 8; j = j + 1) begin
+                #(bit_ns);
+                uart_tx = tx_byte[j];
+            end
+            #(bit_ns);
+            uart_tx = 1'b1;
+            #(bit_ns);
+        end
+    end
+
+    final begin
+        $display("> UART BFM: %0d bytes received, %0d framing errors.", rx_cnt, err_cnt);
+    end
+
+endmodule
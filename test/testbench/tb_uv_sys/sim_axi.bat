@@ -0,0 +1,26 @@
+@echo off
+set BST=16
+set WAVE=none
+set DEFS=
+set LATS=1 4 16 64
+
+if not "%1"=="" (
+set BST=%1)
+
+if "%2"=="wave" (
+set WAVE="-DDUMP_VCD") else (
+set WAVE="-DDUMP_NONE")
+
+if not "%3"=="" (
+set DEFS=-D%3)
+
+if not "%~4"=="" (
+set LATS=%~4)
+
+echo Start simulation at %time%, %date%.
+iverilog -g2012 -s tb_axi_top -o sim_axi.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% %DEFS% || exit /b 1
+for %%L in (%LATS%) do (
+echo AXI latency of %%L cycles.
+vvp sim_axi.vvp +BST_LEN=%BST% +AXI_RD_LAT=%%L +AXI_WR_LAT=%%L
+)
+echo End simulation at %time%, %date%.
@@ -0,0 +1,26 @@
+BST=16
+WAVE=none
+DEFS=
+LATS="1 4 16 64"
+
+if [ -n "$1" ];then
+    BST=$1
+fi
+if [ -z "$2" ];then
+    WAVE="-DDUMP_NONE";
+else
+    WAVE="-DDUMP_VCD"
+fi
+if [ -n "$3" ];then
+    DEFS="-D$3";
+fi
+if [ -n "$4" ];then
+    LATS=$4
+fi
+echo Start simulation at `date`.
+iverilog -g2012 -s tb_axi_top -o sim_axi.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTIME_UNIT=1ns -DTIME_PREC=1ps $WAVE $DEFS || exit 1
+for LAT in $LATS; do
+    echo AXI latency of $LAT cycles.
+    vvp sim_axi.vvp +BST_LEN=$BST +AXI_RD_LAT=$LAT +AXI_WR_LAT=$LAT
+done
+echo End simulation at `date`.
@@ -0,0 +1,24 @@
+@echo off
+for /f "tokens=1,2,3 delims=/- " %%a in ("%date%") do @set D=%%a%%b%%c
+for /f "tokens=1,2,3 delims=:." %%a in ("%time%") do @set T=%%a%%b%%c
+set SEED=%D%%T%
+
+set NAME=none
+set WAVE=none
+
+if "%1"=="" (
+set NAME=CoreMarkXIP) else (
+set NAME=%1)
+
+if "%2"=="wave" (
+set WAVE="-DDUMP_VCD") else (
+set WAVE="-DDUMP_NONE")
+
+set EFLASH_FILE=../../../software/build/%NAME%/%NAME%.hex
+echo Start simulation at %time%, %date%.
+echo eFlash image from %EFLASH_FILE%.
+iverilog -g2012 -s tb_top -o sim_eflash.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_SOFTWARE -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% || exit /b 1
+for %%w in (0 1 2 3 4 5) do (
+echo ^> eFlash wait states: %%w
+vvp sim_eflash.vvp +SEED=%SEED% +EFLASH_FILE=%EFLASH_FILE% +EFLASH_WS=%%w +STI_NAME=%NAME%)
+echo End simulation at %time%, %date%.
@@ -0,0 +1,23 @@
+SEED=`date +%Y%m%d%H%M%S`
+NAME=none
+WAVE=none
+
+if [ -z "$1" ];then
+    NAME=CoreMarkXIP;
+else
+    NAME=$1
+fi
+if [ -z "$2" ];then
+    WAVE="-DDUMP_NONE";
+else
+    WAVE="-DDUMP_VCD"
+fi
+EFLASH_FILE=../../../software/build/$NAME/$NAME.hex
+echo Start simulation at `date`.
+echo eFlash image from $EFLASH_FILE
+iverilog -g2012 -s tb_top -o sim_eflash.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_SOFTWARE -DTIME_UNIT=1ns -DTIME_PREC=1ps $WAVE || exit 1
+for WS in 0 1 2 3 4 5; do
+    echo "> eFlash wait states: $WS"
+    vvp sim_eflash.vvp +SEED=$SEED +EFLASH_FILE=$EFLASH_FILE +EFLASH_WS=$WS +STI_NAME=$NAME
+done
+echo End simulation at `date`.
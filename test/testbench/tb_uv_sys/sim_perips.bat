@@ -5,6 +5,7 @@ set SEED=%D%%T%
 
 set NAME=none
 set WAVE=none
+set DEFS=
 
 if "%1"=="" (
 set NAME=TestUART) else (
@@ -14,8 +15,11 @@ if "%2"=="wave" (
 set WAVE="-DDUMP_VCD") else (
 set WAVE="-DDUMP_NONE")
 
+if not "%3"=="" (
+set DEFS=-D%3)
+
 set INST_FILE=../../../software/build/%NAME%/%NAME%.hex
 echo Start simulation at %time%, %date%.
 echo Instruction from %INST_FILE%.
-iverilog -g2012 -s tb_top -o sim_perips.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_PERIPS -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% && vvp sim_perips.vvp +SEED=%SEED% +INST_FILE=%INST_FILE% +STI_NAME=%NAME%
+iverilog -g2012 -s tb_top -o sim_perips.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_PERIPS -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% %DEFS% && vvp sim_perips.vvp +SEED=%SEED% +INST_FILE=%INST_FILE% +STI_NAME=%NAME%
 echo End simulation at %time%, %date%.
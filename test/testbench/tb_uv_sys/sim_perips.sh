@@ -1,6 +1,7 @@
 SEED=`date +%Y%m%d%H%M%S`
 NAME=none
 WAVE=none
+DEFS=
 
 if [ -z "$1" ];then
     NAME=rv32ui-p-add;
@@ -12,8 +13,11 @@ if [ -z "$2" ];then
 else
     WAVE="-DDUMP_VCD"
 fi
+if [ -n "$3" ];then
+    DEFS="-D$3";
+fi
 INST_FILE=../../../software/build/$NAME/$NAME.hex
 echo Start simulation at `date`.
 echo Instruction from $INST_FILE
-iverilog -g2012 -s tb_top -o sim_perips.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_PERIPS -DTIME_UNIT=1ns -DTIME_PREC=1ps $WAVE && vvp sim_perips.vvp +SEED=$SEED +INST_FILE=$INST_FILE +STI_NAME=$NAME
+iverilog -g2012 -s tb_top -o sim_perips.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_PERIPS -DTIME_UNIT=1ns -DTIME_PREC=1ps $WAVE $DEFS && vvp sim_perips.vvp +SEED=$SEED +INST_FILE=$INST_FILE +STI_NAME=$NAME
 echo End simulation at `date`.
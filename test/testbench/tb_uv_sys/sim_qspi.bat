@@ -0,0 +1,24 @@
+@echo off
+for /f "tokens=1,2,3 delims=/- " %%a in ("%date%") do @set D=%%a%%b%%c
+for /f "tokens=1,2,3 delims=:." %%a in ("%time%") do @set T=%%a%%b%%c
+set SEED=%D%%T%
+
+set NAME=none
+set WAVE=none
+
+if "%1"=="" (
+set NAME=CoreMarkQSPI) else (
+set NAME=%1)
+
+if "%2"=="wave" (
+set WAVE="-DDUMP_VCD") else (
+set WAVE="-DDUMP_NONE")
+
+set QSPI_FILE=../../../software/build/%NAME%/%NAME%.hex
+echo Start simulation at %time%, %date%.
+echo QSPI flash image from %QSPI_FILE%.
+iverilog -g2012 -s tb_top -o sim_qspi.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_SOFTWARE -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% || exit /b 1
+for %%c in (00A0EB47 00A0EB43 00A0EB45 01A0EB47) do (
+echo ^> XIP config: 0x%%c
+vvp sim_qspi.vvp +SEED=%SEED% +QSPI_FILE=%QSPI_FILE% +QSPI_CFG=%%c +STI_NAME=%NAME%)
+echo End simulation at %time%, %date%.
@@ -0,0 +1,24 @@
+SEED=`date +%Y%m%d%H%M%S`
+NAME=none
+WAVE=none
+
+if [ -z "$1" ];then
+    NAME=CoreMarkQSPI;
+else
+    NAME=$1
+fi
+if [ -z "$2" ];then
+    WAVE="-DDUMP_NONE";
+else
+    WAVE="-DDUMP_VCD"
+fi
+QSPI_FILE=../../../software/build/$NAME/$NAME.hex
+echo Start simulation at `date`.
+echo QSPI flash image from $QSPI_FILE
+iverilog -g2012 -s tb_top -o sim_qspi.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_SOFTWARE -DTIME_UNIT=1ns -DTIME_PREC=1ps $WAVE || exit 1
+# Default, no prefetching, no continuous reading & half SCK.
+for CFG in 00A0EB47 00A0EB43 00A0EB45 01A0EB47; do
+    echo "> XIP config: 0x$CFG"
+    vvp sim_qspi.vvp +SEED=$SEED +QSPI_FILE=$QSPI_FILE +QSPI_CFG=$CFG +STI_NAME=$NAME
+done
+echo End simulation at `date`.
@@ -6,6 +6,7 @@ set SEED=%D%%T%
 set TYPE=none
 set NAME=none
 set WAVE=none
+set DEFS=
 if "%1"=="" (
 set TYPE=isa) else (
 set TYPE=%1)
@@ -18,6 +19,9 @@ if "%3"=="wave" (
 set WAVE="-DDUMP_VCD") else (
 set WAVE="-DDUMP_NONE")
 
+if not "%4"=="" (
+set DEFS=-D%4)
+
 set INST_FILE=../../stimulus/riscv-tests/%TYPE%/build/%NAME%.hex
 echo Instruction from %INST_FILE%
-iverilog -g2012 -s tb_top -o sim_riscv_tests.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_RISCV_TESTS -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% && vvp sim_riscv_tests.vvp +SEED=%SEED% +INST_FILE=%INST_FILE% +STI_NAME=%NAME%
+iverilog -g2012 -s tb_top -o sim_riscv_tests.vvp -I . -I ./testcase -I .. -I ../../../common/general -f ../../filelist/uv_sys.f -f ../../filelist/uv_tb.f -DTC_RISCV_TESTS -DTIME_UNIT=1ns -DTIME_PREC=1ps %WAVE% %DEFS% && vvp sim_riscv_tests.vvp +SEED=%SEED% +INST_FILE=%INST_FILE% +STI_NAME=%NAME%
@@ -1,6 +1,10 @@
 // See LICENSE for license details.
 
+`ifdef CLST_HART_NUM
+`define CORE                    DUT.u_clst.gen_hart[0].u_core
+`else
 `define CORE                    DUT.u_core
+`endif
 `define UCORE                   `CORE.u_ucore
 `define IFU                     `UCORE.u_ifu
 `define IDU                     `UCORE.u_idu
@@ -11,9 +15,24 @@
 `define RF                      `UCORE.u_rf
 `define ALU                     `UCORE.u_exu.u_alu
 
+`ifdef CLST_HART_NUM
+`define DAM                     DUT.u_clst.gen_hart[0].u_idam
+`define SMEM_BANK0              DUT.u_clst.gen_bank[0].u_bank.u_ram.ram
+`define SMEM_BANK1              DUT.u_clst.gen_bank[1].u_bank.u_ram.ram
+`define SMEM_BANK2              DUT.u_clst.gen_bank[2].u_bank.u_ram.ram
+`define SMEM_BANK3              DUT.u_clst.gen_bank[3].u_bank.u_ram.ram
+`else
 `define DAM                     DUT.gen_dam.u_dam
-`define INST_MEM                `DAM.u_bank_a.ram
-`define DATA_MEM                `DAM.u_bank_b.ram
+`endif
+`ifdef DAM_BANK_MSB
+`define DAM_BANK0               `DAM.gen_bank_msb.u_bank_a.ram
+`define DAM_BANK1               `DAM.gen_bank_msb.u_bank_b.ram
+`else
+`define DAM_BANK0               `DAM.gen_bank_ilv.gen_bank[0].u_bank.ram
+`define DAM_BANK1               `DAM.gen_bank_ilv.gen_bank[1].u_bank.ram
+`define DAM_BANK2               `DAM.gen_bank_ilv.gen_bank[2].u_bank.ram
+`define DAM_BANK3               `DAM.gen_bank_ilv.gen_bank[3].u_bank.ram
+`endif
 
 `define DEV                     DUT.u_dev_subsys
 `define SLC                     `DEV.u_slc
@@ -24,7 +43,26 @@
 
 localparam IO_NUM               = 32;
 localparam MAX_STRING_LEN       = 256;
-localparam INST_MEM_DEPTH       = 16384;
+localparam INST_MEM_DEPTH       = 16384;           // In 32-bit words.
+localparam DAM_WORD_BYTES       = 8;               // Bytes per DAM bank entry.
+localparam DAM_WORD_AW          = $clog2(DAM_WORD_BYTES);
+`ifdef CLST_HART_NUM
+localparam DAM_WORDS            = INST_MEM_DEPTH * 4 / DAM_WORD_BYTES;     // IDAM of each hart.
+localparam SMEM_BANK_NUM        = 4;
+`else
+localparam DAM_WORDS            = INST_MEM_DEPTH * 4 * 2 / DAM_WORD_BYTES;
+`endif
+`ifdef DAM_BANK_MSB
+localparam DAM_BANK_NUM         = 2;
+localparam DAM_BANK_ILV         = 1'b0;
+`elsif DAM_BANK_QUAD
+localparam DAM_BANK_NUM         = 4;
+localparam DAM_BANK_ILV         = 1'b1;
+`else
+localparam DAM_BANK_NUM         = 2;
+localparam DAM_BANK_ILV         = 1'b1;
+`endif
+localparam DAM_BANK_WORDS       = DAM_WORDS / DAM_BANK_NUM;
 
 reg                             i2c_scl_in;
 wire                            i2c_scl_out;
@@ -33,6 +71,27 @@ reg                             i2c_sda_in;
 wire                            i2c_sda_out;
 wire                            i2c_sda_oen;
 
+wire                            qspi_sck;
+wire [3:0]                      qspi_cs;
+wire [3:0]                      qspi_oen;
+wire [3:0]                      qspi_sdo;
+wire [3:0]                      qspi_io;
+
+`ifdef USE_EXT_MEM
+wire                            sdram_clk;
+wire                            sdram_cke;
+wire                            sdram_cs_n;
+wire                            sdram_ras_n;
+wire                            sdram_cas_n;
+wire                            sdram_we_n;
+wire [1:0]                      sdram_ba;
+wire [12:0]                     sdram_addr;
+wire [1:0]                      sdram_dqm;
+wire                            sdram_dq_oen;
+wire [15:0]                     sdram_dq_out;
+wire [15:0]                     sdram_dq;
+`endif
+
 wire [IO_NUM-1:0]               gpio_pu;
 wire [IO_NUM-1:0]               gpio_pd;
 wire [IO_NUM-1:0]               gpio_ie;
@@ -88,7 +147,18 @@ DUT
     .por_rst_n          ( rst_n             ),
 
 `ifdef USE_EXT_MEM
-    // TODO.
+    .sdram_clk          ( sdram_clk         ),
+    .sdram_cke          ( sdram_cke         ),
+    .sdram_cs_n         ( sdram_cs_n        ),
+    .sdram_ras_n        ( sdram_ras_n       ),
+    .sdram_cas_n        ( sdram_cas_n       ),
+    .sdram_we_n         ( sdram_we_n        ),
+    .sdram_ba           ( sdram_ba          ),
+    .sdram_addr         ( sdram_addr        ),
+    .sdram_dqm          ( sdram_dqm         ),
+    .sdram_dq_oen       ( sdram_dq_oen      ),
+    .sdram_dq_out       ( sdram_dq_out      ),
+    .sdram_dq_in        ( sdram_dq          ),
 `endif
 
     .jtag_tck           ( 1'b0              ),
@@ -102,6 +172,12 @@ DUT
     .i2c_sda_in         ( i2c_sda_in        ),
     .i2c_sda_out        ( i2c_sda_out       ),
     .i2c_sda_oen        ( i2c_sda_oen       ),
+
+    .qspi_sck           ( qspi_sck          ),
+    .qspi_cs            ( qspi_cs           ),
+    .qspi_oen           ( qspi_oen          ),
+    .qspi_sdo           ( qspi_sdo          ),
+    .qspi_sdi           ( qspi_io           ),
     
     .gpio_pu            ( gpio_pu           ),
     .gpio_pd            ( gpio_pd           ),
@@ -110,3 +186,44 @@ DUT
     .gpio_oe            ( gpio_oe           ),
     .gpio_out           ( gpio_out          )
 );
+
+//******************************
+// QSPI flash.
+//******************************
+assign qspi_io[0] = ~qspi_oen[0] ? qspi_sdo[0] : 1'bz;
+assign qspi_io[1] = ~qspi_oen[1] ? qspi_sdo[1] : 1'bz;
+assign qspi_io[2] = ~qspi_oen[2] ? qspi_sdo[2] : 1'bz;
+assign qspi_io[3] = ~qspi_oen[3] ? qspi_sdo[3] : 1'bz;
+
+pullup (qspi_io[0]);
+pullup (qspi_io[1]);
+pullup (qspi_io[2]);
+pullup (qspi_io[3]);
+
+tb_spi_flash u_qspi_flash
+(
+    .sck                ( qspi_sck          ),
+    .cs_n               ( qspi_cs[0]        ),
+    .io                 ( qspi_io           )
+);
+
+`ifdef USE_EXT_MEM
+//******************************
+// SDRAM.
+//******************************
+assign sdram_dq = ~sdram_dq_oen ? sdram_dq_out : 16'bz;
+
+tb_sdram u_sdram
+(
+    .clk                ( sdram_clk         ),
+    .cke                ( sdram_cke         ),
+    .cs_n               ( sdram_cs_n        ),
+    .ras_n              ( sdram_ras_n       ),
+    .cas_n              ( sdram_cas_n       ),
+    .we_n               ( sdram_we_n        ),
+    .ba                 ( sdram_ba          ),
+    .addr               ( sdram_addr        ),
+    .dqm                ( sdram_dqm         ),
+    .dq                 ( sdram_dq          )
+);
+`endif
@@ -93,32 +93,77 @@ initial begin
 end
 
 //-----------------------------------------------------------
-// UART.
+// Bus QoS: latency of core fetches through devbus, from the
+// request to its first response beat. The worst case is
+// reported & cleared when QOS_MARK is written to scratch.
+localparam QOS_MARK   = 32'hcafe0051;
+localparam QOS_OST    = 16;
+
+integer    qos_cyc;
+integer    qos_req_cyc [0:QOS_OST-1];
+reg  [3:0] qos_req_len [0:QOS_OST-1];
+integer    qos_wptr;
+integer    qos_rptr;
+integer    qos_beat;
+integer    qos_lat;
+integer    qos_max;
+integer    qos_cnt;
+
+initial begin
+    qos_cyc  = 0;
+    qos_wptr = 0;
+    qos_rptr = 0;
+    qos_beat = 0;
+    qos_max  = 0;
+    qos_cnt  = 0;
+end
+
+always @(posedge clk) begin
+    qos_cyc = qos_cyc + 1;
+    if (`DEV.bus_dev_i_rsp_vld && `DEV.bus_dev_i_rsp_rdy) begin
+        if (qos_beat == 0) begin
+            qos_lat = qos_cyc - qos_req_cyc[qos_rptr];
+            qos_max = qos_lat > qos_max ? qos_lat : qos_max;
+            qos_cnt = qos_cnt + 1;
+        end
+        if (qos_beat == qos_req_len[qos_rptr]) begin
+            qos_beat = 0;
+            qos_rptr = (qos_rptr + 1) % QOS_OST;
+        end
+        else begin
+            qos_beat = qos_beat + 1;
+        end
+    end
+    if (`DEV.bus_dev_i_req_vld && `DEV.bus_dev_i_req_rdy) begin
+        qos_req_cyc[qos_wptr] = qos_cyc;
+        qos_req_len[qos_wptr] = `DEV.bus_dev_i_req_len;
+        qos_wptr = (qos_wptr + 1) % QOS_OST;
+    end
+    if (`LSU.ls2mem_req_vld && `LSU.ls2mem_req_rdy && (!`LSU.ls2mem_req_read)
+        && (`LSU.ls2mem_req_addr == PRINT_ADDR) && (`LSU.ls2mem_req_mask == 4'hf)
+        && (`LSU.ls2mem_req_data == QOS_MARK)) begin
+        $display("> QoS: worst-case fetch latency %0d cycles in %0d fetches.", qos_max, qos_cnt);
+        qos_max = 0;
+        qos_cnt = 0;
+    end
+end
+
+//-----------------------------------------------------------
+// UART: a BFM echoes bytes back in real time. When BAUD_MARK
+// is written to PRINT_ADDR, the next word is the baud rate
+// of the BFM from then on.
+`ifdef UART_FAST
+localparam UART_BAUD_RATE = 921600;
+`else
 localparam UART_BAUD_RATE = 115200;
-localparam UART_CFG_ADDR  = 12'h0;
-localparam UART_RD_ADDR   = 12'h20;
-localparam UART_WR_ADDR   = 12'h10;
-
-reg                     uart_psel;
-reg                     uart_penable;
-reg  [2:0]              uart_pprot;
-reg  [11:0]             uart_paddr;
-reg  [3:0]              uart_pstrb;
-reg                     uart_pwrite;
-reg  [31:0]             uart_pwdata;
-wire [31:0]             uart_prdata;
-wire                    uart_pready;
-wire                    uart_pslverr;
+`endif
+localparam UART_BAUD_MARK = 32'hcafe0042;
 
 // Serial ports.
 wire                    uart_tx;
 wire                    uart_rx;
 
-// UART data buffer.
-reg  [31:0]             uart_loop_data;
-
-// UART clock divider.
-integer                 uart_clk_div;
+reg                     uart_baud_nxt;
 
 // Connect UART to GPIO.
 assign gpio_in[0]       = uart_tx;
@@ -128,113 +173,49 @@ assign uart_rx          = gpio_out[1];
 wire [2:0] uart_pr      = `SLC.irq_pr_r[0];
 wire [1:0] uart_tg      = `SLC.irq_tg_r[0];
 
-// UART configs.
-wire       uart_tx_en   = 1'b1;
-wire       uart_rx_en   = 1'b1;
-wire [1:0] uart_nbits   = 2'b11;
-
-// APB operations.
-task uart_apb_read;
-    input  [11:0]       addr;
-    output [31:0]       data;
-begin
-    uart_psel           = 1'b1;
-    uart_penable        = 1'b0;
-    uart_paddr          = addr;
-    uart_pprot          = 3'b0;
-    uart_pstrb          = 4'hf;
-    uart_pwrite         = 1'b0;
-    @(posedge clk);
-    uart_penable        = 1'b1;
-    @(posedge clk);
-    while (!uart_pready) begin
-        @(posedge clk);
-    end
-    data                = uart_prdata;
-    #UDLY;
-    uart_psel           = 1'b0;
-end
-endtask
-
-task uart_apb_write;
-    input  [11:0]       addr;
-    input  [31:0]       data;
-begin
-    uart_psel           = 1'b1;
-    uart_penable        = 1'b0;
-    uart_paddr          = addr;
-    uart_pprot          = 3'b0;
-    uart_pstrb          = 4'hf;
-    uart_pwrite         = 1'b1;
-    uart_pwdata         = data;
-    @(posedge clk);
-    uart_penable        = 1'b1;
-    @(posedge clk);
-    while (!uart_pready) begin
-        @(posedge clk);
-    end
-    #UDLY;
-    uart_psel           = 1'b0;
+initial begin
+    uart_baud_nxt = 1'b0;
 end
-endtask
 
-initial begin
-    wait (rst_done);
-    uart_psel    = 1'b1;
-    uart_penable = 1'b0;
-    uart_paddr   = 12'b0;
-    uart_pprot   = 3'b0;
-    uart_pstrb   = 4'hf;
-    uart_pwrite  = 1'b1;
-    uart_pwdata  = 32'b0;
-    uart_clk_div = 1000000000 / CLK_PERIOD / UART_BAUD_RATE;
-    uart_apb_write(UART_CFG_ADDR, {uart_clk_div, 12'b0, uart_nbits, uart_rx_en, uart_tx_en});
-    forever begin
-        @(posedge clk);
-        if (u_uart_adaptor.rx_deq_rdy) begin
-            uart_apb_read (UART_RD_ADDR, uart_loop_data);
-            uart_apb_write(UART_WR_ADDR, uart_loop_data);
+always @(posedge clk) begin
+    if (`LSU.ls2mem_req_vld && `LSU.ls2mem_req_rdy && (!`LSU.ls2mem_req_read)
+        && (`LSU.ls2mem_req_addr == PRINT_ADDR) && (`LSU.ls2mem_req_mask == 4'hf)) begin
+        if (uart_baud_nxt) begin
+            u_uart_bfm.set_baud(`LSU.ls2mem_req_data);
+            uart_baud_nxt = 1'b0;
+        end
+        else if (`LSU.ls2mem_req_data == UART_BAUD_MARK) begin
+            uart_baud_nxt = 1'b1;
         end
     end
 end
 
-// UART Adaptor.
-// FIXME: It's better to use 3rd-party impl for cross verification.
-uv_uart_apb u_uart_adaptor
+tb_uart_bfm
+#(
+    .BAUD_RATE          ( UART_BAUD_RATE    )
+)
+u_uart_bfm
 (
-    .clk                ( clk           ),
-    .rst_n              ( rst_n         ),
-
-    .uart_psel          ( uart_psel     ),
-    .uart_penable       ( uart_penable  ),
-    .uart_pprot         ( uart_pprot    ),
-    .uart_paddr         ( uart_paddr    ),
-    .uart_pstrb         ( uart_pstrb    ),
-    .uart_pwrite        ( uart_pwrite   ),
-    .uart_pwdata        ( uart_pwdata   ),
-    .uart_prdata        ( uart_prdata   ),
-    .uart_pready        ( uart_pready   ),
-    .uart_pslverr       ( uart_pslverr  ),
-
-    .uart_tx            ( uart_tx       ),
-    .uart_rx            ( uart_rx       ),
-
-    .uart_irq           ( uart_irq      )
+    .uart_rx            ( uart_rx           ),
+    .uart_tx            ( uart_tx           )
 );
 
 //-----------------------------------------------------------
-// SPI Slave.
+// SPI Slave: data are looped back to master, and a display
+// listens on the bus with GPIO 10 as its D/C line.
 // Serial ports.
 wire                    spi_cs;
 wire                    spi_sck;
 wire                    spi_mosi;
 wire                    spi_miso;
+wire                    spi_dc;
 
 // Connect SPI to GPIO.
 assign spi_cs           = gpio_out[2];
 assign spi_sck          = gpio_out[3];
 assign spi_mosi         = gpio_out[4];
 assign gpio_in[5]       = spi_miso;
+assign spi_dc           = gpio_out[10];
 
 // IRQ info.
 wire [2:0] spi_pr       = `SLC.irq_pr_r[1];
@@ -243,7 +224,62 @@ wire [1:0] spi_tg       = `SLC.irq_tg_r[1];
 // Loop data to master.
 assign spi_miso         = spi_mosi;
 
+tb_spi_lcd u_spi_lcd
+(
+    .spi_cs             ( spi_cs            ),
+    .spi_sck            ( spi_sck           ),
+    .spi_mosi           ( spi_mosi          ),
+    .spi_dc             ( spi_dc            )
+);
+
+//-----------------------------------------------------------
+// I2C: an EEPROM on the open-drain bus with pull-ups, which
+// stretches SCL at address ACK.
+wire                    i2c_scl;
+wire                    i2c_sda;
+wire                    i2c_scl_low;
+wire                    i2c_sda_low;
+
+assign i2c_scl          = ~((~i2c_scl_oen) & (~i2c_scl_out)) & (~i2c_scl_low);
+assign i2c_sda          = ~((~i2c_sda_oen) & (~i2c_sda_out)) & (~i2c_sda_low);
+
+always @(*) begin
+    i2c_scl_in = i2c_scl;
+    i2c_sda_in = i2c_sda;
+end
+
+tb_i2c_eeprom u_i2c_eeprom
+(
+    .i2c_scl            ( i2c_scl           ),
+    .i2c_sda            ( i2c_sda           ),
+    .scl_low            ( i2c_scl_low       ),
+    .sda_low            ( i2c_sda_low       )
+);
+
+//-----------------------------------------------------------
+// Loop GPIO 12 back to GPIO 11, to raise GPIO IRQs by software.
+assign gpio_in[11]      = gpio_out[12];
+
+//-----------------------------------------------------------
+// PWM outputs on GPIO 16 ~ 23 with P & N of a channel paired,
+// and capture inputs on GPIO 24 & 25, looped back from PWM 0 P
+// & the software PWM on GPIO 13.
+tb_pwm_mon
+#(
+    .PWM_CH             ( 4                 )
+)
+u_pwm_mon
+(
+    .pwm_p              ( {gpio_out[22], gpio_out[20], gpio_out[18], gpio_out[16]} ),
+    .pwm_n              ( {gpio_out[23], gpio_out[21], gpio_out[19], gpio_out[17]} )
+);
+
+assign gpio_in[24]      = gpio_out[16];
+assign gpio_in[25]      = gpio_out[13];
+
 //-----------------------------------------------------------
 // Tie unused IOs.
-assign gpio_in[4:1]        = 4'b0;
-assign gpio_in[IO_NUM-1:6] = {(IO_NUM-6){1'b0}};
+assign gpio_in[4:1]         = 4'b0;
+assign gpio_in[10:6]        = 5'b0;
+assign gpio_in[23:12]       = 12'b0;
+assign gpio_in[IO_NUM-1:26] = {(IO_NUM-26){1'b0}};